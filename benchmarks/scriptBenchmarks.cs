@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// Script VM benchmarks.  Each function takes an iteration count and performs
+// a typical mix of script work.  They are executed by "runScriptBenchmarks()"
+// once with bytecode optimization disabled and once with it enabled.
+
+//-----------------------------------------------------------------------------
+
+function scriptBenchmarkArithmetic( %iterations )
+{
+    %total = 0;
+
+    for ( %index = 0; %index < %iterations; %index++ )
+    {
+        // Constant sub-expressions fold at compile time.
+        %total = %total + 2 * 3.5 - 1 / 4;
+        %total = %total - ( 60 * 60 * 24 ) / 86400;
+        %mask = %index & ( 1 << 4 | 1 << 2 );
+        %negative = -1 * -%index;
+    }
+
+    return %total;
+}
+
+//-----------------------------------------------------------------------------
+
+function scriptBenchmarkLocalVariables( %iterations )
+{
+    %a = 1;
+    %b = 2;
+    %c = 3;
+
+    for ( %index = 0; %index < %iterations; %index++ )
+    {
+        %d = %a + %b;
+        %e = %d * %c;
+        %a = %b;
+        %b = %c;
+        %c = %e - %d;
+    }
+
+    return %c;
+}
+
+//-----------------------------------------------------------------------------
+
+function scriptBenchmarkBranches( %iterations )
+{
+    %even = 0;
+    %odd = 0;
+
+    for ( %index = 0; %index < %iterations; %index++ )
+    {
+        if ( %index % 2 == 0 )
+        {
+            %even++;
+            continue;
+        }
+        else if ( %index % 3 == 0 )
+        {
+            %odd++;
+        }
+        else
+        {
+            while ( true )
+            {
+                %odd += 2;
+                break;
+            }
+        }
+    }
+
+    return %even SPC %odd;
+}
+
+//-----------------------------------------------------------------------------
+
+function scriptBenchmarkStrings( %iterations )
+{
+    %count = 0;
+
+    for ( %index = 0; %index < %iterations; %index++ )
+    {
+        %name = "object" @ %index;
+        %list = %name SPC %index TAB "tail";
+
+        if ( %name $= "object10" )
+            %count++;
+
+        %count += getWordCount( %list );
+    }
+
+    return %count;
+}
+
+//-----------------------------------------------------------------------------
+
+function scriptBenchmarkCalleeAdd( %a, %b )
+{
+    return %a + %b;
+}
+
+function scriptBenchmarkCalls( %iterations )
+{
+    %total = 0;
+
+    for ( %index = 0; %index < %iterations; %index++ )
+        %total = scriptBenchmarkCalleeAdd( %total, %index );
+
+    return %total;
+}
@@ -864,6 +864,53 @@ void ImageAsset::initializeAsset( void )
 
 //------------------------------------------------------------------------------
 
+void ImageAsset::preloadAsset( void )
+{
+    // Call parent.
+    Parent::preloadAsset();
+
+    // Ensure the image-file is expanded.
+    mImageFile = expandAssetFilePath( mImageFile );
+
+    // Finish if the texture is already loaded.
+    if ( TextureDictionary::find( mImageFile ) != NULL )
+        return;
+
+    // Load the texture in the background so initializing the asset only has to reference it.
+    // NOTE: The asset is referred to by Id in case it is deleted before the load finishes.
+    if ( TextureManager::loadTextureAsync( mImageFile, true, getForce16Bit(), textureLoadCallback, (void*)(size_t)getId() ) )
+        beginPreload();
+}
+
+//------------------------------------------------------------------------------
+
+U32 ImageAsset::getAssetMemorySize( void ) const
+{
+    // Fetch the texture object.
+    TextureObject* pTextureObject = const_cast<TextureHandle&>( mImageTextureHandle );
+
+    // Finish if there is no texture.
+    if ( pTextureObject == NULL )
+        return 0;
+
+    // NOTE: The texture may be shared with other images but is only released once all of them are.
+    return (U32)(pTextureObject->getTextureResidentSize() + pTextureObject->getBitmapResidentSize());
+}
+
+//------------------------------------------------------------------------------
+
+void ImageAsset::textureLoadCallback( StringTableEntry textureKey, const bool loaded, void* userData )
+{
+    // Find the asset.
+    ImageAsset* pImageAsset = dynamic_cast<ImageAsset*>( Sim::findObject( (SimObjectId)(size_t)userData ) );
+
+    // End the preload if it still exists.  This initializes the asset which references the texture.
+    if ( pImageAsset != NULL )
+        pImageAsset->endPreload();
+}
+
+//------------------------------------------------------------------------------
+
 void ImageAsset::onAssetRefresh( void ) 
 {
     // Ignore if not yet added to the sim.
@@ -215,6 +215,7 @@ public:
     inline const void       bindImageTexture( void)                         { glBindTexture( GL_TEXTURE_2D, getImageTexture().getGLName() ); };
     
     virtual bool            isAssetValid( void ) const                      { return !mImageTextureHandle.IsNull(); }
+    virtual U32             getAssetMemorySize( void ) const;
 
     /// Explicit cell control.
     bool                    clearExplicitCells( void );
@@ -240,6 +241,7 @@ private:
 protected:
     virtual void initializeAsset( void );
     virtual void onAssetRefresh( void );
+    virtual void preloadAsset( void );
 
     /// Taml callbacks.
     virtual void onTamlPreWrite( void );
@@ -250,6 +252,7 @@ protected:
 
 protected:
     static void textureEventCallback( const U32 eventCode, void *userData );
+    static void textureLoadCallback( StringTableEntry textureKey, const bool loaded, void* userData );
 
     static bool setImageFile( void* obj, const char* data )                 { static_cast<ImageAsset*>(obj)->setImageFile(data); return false; }
     static const char* getImageFile(void* obj, const char* data)            { return static_cast<ImageAsset*>(obj)->getImageFile(); }
@@ -680,7 +680,7 @@ void ParticleAssetField::onTamlCustomRead( const TamlCustomNode* pCustomNode )
     setRepeatTime( repeatTime );
 
     // Set the data keys.
-    mDataKeys = keys;
+    mDataKeys.swap( keys );
 }
 
 //-----------------------------------------------------------------------------
@@ -55,7 +55,7 @@
 
 class ImageFrameProviderCore :
     public virtual Tickable,
-    public IFactoryObjectReset,
+    public virtual IFactoryObjectReset,
     protected AssetPtrCallback
 {
 protected:
@@ -22,12 +22,35 @@
 
 #include "2d/core/particleSystem.h"
 
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+#ifndef _FRAME_COUNTERS_H_
+#include "debug/frameCounters.h"
+#endif
+
 //------------------------------------------------------------------------------
 
 ParticleSystem* ParticleSystem::Instance = NULL;
 
 //------------------------------------------------------------------------------
 
+static F32 sampleActiveParticles( void )
+{
+    return ParticleSystem::Instance == NULL ? 0.0f : (F32)ParticleSystem::Instance->getActiveParticleCount();
+}
+
+static F32 sampleAllocatedParticles( void )
+{
+    return ParticleSystem::Instance == NULL ? 0.0f : (F32)ParticleSystem::Instance->getAllocatedParticleCount();
+}
+
+static FrameCounter sActiveParticlesCounter( "particles.active", sampleActiveParticles );
+static FrameCounter sAllocatedParticlesCounter( "particles.allocated", sampleAllocatedParticles );
+
+//------------------------------------------------------------------------------
+
 void ParticleSystem::Init( void )
 {
     // Create the particle system.
@@ -61,7 +84,14 @@ ParticleSystem::~ParticleSystem()
 {
     // Destroy all the particle pool blocks.
     for ( U32 n = 0; n < (U32)mParticlePool.size(); n++ )
-        delete [] mParticlePool[n];
+    {
+        ParticleNode* pPoolBlock = mParticlePool[n];
+
+        for ( U32 i = 0; i < mParticlePoolBlockSize; i++ )
+            destructInPlace( pPoolBlock+i );
+
+        MemoryAllocator::free( pPoolBlock );
+    }
 
     // Clear the particle pool.
     mParticlePool.clear();
@@ -77,8 +107,11 @@ ParticleSystem::ParticleNode* ParticleSystem::createParticle( void )
     // Have we got any free particle nodes?
     if ( mpFreeParticleNodes == NULL )
     {
-        // No, so generate a new free pool block.
-        ParticleNode* pFreePoolBlock = new ParticleNode[mParticlePoolBlockSize];
+        // No, so generate a new free pool block from the particles arena.
+        ParticleNode* pFreePoolBlock = (ParticleNode*)MemoryAllocator::allocate( sizeof(ParticleNode) * mParticlePoolBlockSize, MemoryAllocator::ParticlesTag );
+
+        for ( U32 n = 0; n < mParticlePoolBlockSize; n++ )
+            constructInPlace( pFreePoolBlock+n );
 
         // Store new free pool block.
         mParticlePool.push_back( pFreePoolBlock );
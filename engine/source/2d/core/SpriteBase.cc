@@ -96,6 +96,18 @@ void SpriteBase::copyTo(SimObject* object)
 
 //------------------------------------------------------------------------------
 
+void SpriteBase::resetState( void )
+{
+    // Call parent.
+    Parent::resetState();
+
+    // Reset image frame provider as its allocation does.
+    ImageFrameProvider::resetState();
+    mStaticProvider = mImageAsset.notNull();
+}
+
+//------------------------------------------------------------------------------
+
 void SpriteBase::onAnimationEnd( void )
 {
     // Do script callback.
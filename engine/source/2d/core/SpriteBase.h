@@ -49,6 +49,7 @@ public:
     virtual bool shouldRender( void ) const { return true; }
 
     virtual void copyTo(SimObject* object);
+    virtual void resetState( void );
 
     /// Declare Console Object.
     DECLARE_CONOBJECT( SpriteBase );
@@ -56,6 +56,18 @@
 #include "2d/core/particleSystem.h"
 #endif
 
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+#ifndef _FRAME_COUNTERS_H_
+#include "debug/frameCounters.h"
+#endif
+
+#ifndef _SMALL_VECTOR_H_
+#include "collection/smallVector.h"
+#endif
+
 // Script bindings.
 #include "Scene_ScriptBinding.h"
 
@@ -74,6 +86,25 @@ static ContactFilter mContactFilter;
 static U32 sSceneCount = 0;
 static U32 sSceneMasterIndex = 0;
 
+// Frame counters.
+static FrameCounter sPhysicsStepCounter( "physics.stepMs" );
+static FrameCounter sPhysicsCollideCounter( "physics.collideMs" );
+static FrameCounter sPhysicsSolveCounter( "physics.solveMs" );
+static FrameCounter sPhysicsSolveTOICounter( "physics.solveTOIMs" );
+static FrameCounter sPhysicsBroadphaseCounter( "physics.broadphaseMs" );
+static FrameCounter sPhysicsBodiesCounter( "physics.bodies", FrameCounter::Gauge );
+static FrameCounter sPhysicsContactsCounter( "physics.contacts", FrameCounter::Gauge );
+static FrameCounter sSceneObjectsCounter( "scene.objects", FrameCounter::Gauge );
+static FrameCounter sSceneDeletesCounter( "scene.deletes" );
+static FrameCounter sSceneDeletesPendingCounter( "scene.deletesPending", FrameCounter::Gauge );
+static FrameCounter sRenderRequestsCounter( "render.requests" );
+static FrameCounter sBatchTrianglesCounter( "batch.triangles" );
+static FrameCounter sBatchDrawCallsCounter( "batch.drawCalls" );
+static FrameCounter sBatchFlushesCounter( "batch.flushes" );
+static FrameCounter sBatchTextureFlushesCounter( "batch.textureFlushes" );
+static FrameCounter sBatchStateFlushesCounter( "batch.stateFlushes" );
+static FrameCounter sBatchBufferFullFlushesCounter( "batch.bufferFullFlushes" );
+
 // Joint custom node names.
 static StringTableEntry jointCustomNodeName               = StringTable->insert( "Joints" );
 static StringTableEntry jointCollideConnectedName         = StringTable->insert( "CollideConnected" );
@@ -129,6 +160,10 @@ static StringTableEntry jointTargetMaxForceName           = StringTable->insert(
 static StringTableEntry jointTargetFrequencyName          = jointDistanceFrequencyName;
 static StringTableEntry jointTargetDampingRatioName       = jointDistanceDampingRatioName;
 
+// Contact callback names.
+static ConstStringTableEntry sceneCollisionCallbackName    ( "onSceneCollision" );
+static ConstStringTableEntry sceneEndCollisionCallbackName ( "onSceneEndCollision" );
+
 static StringTableEntry jointMotorNodeName                = StringTable->insert( "Motor" );
 static StringTableEntry jointMotorLinearOffsetName        = StringTable->insert( "LinearOffset" );
 static StringTableEntry jointMotorAngularOffsetName       = StringTable->insert( "AngularOffset" );
@@ -166,6 +201,13 @@ Scene::Scene() :
 
     /// Window rendering.
     mpCurrentRenderWindow(NULL),
+
+    /// Scene occupancy.
+    mEmptySceneObjectSlots(0),
+    mDeferSceneObjectCompaction(false),
+
+    /// Delete requests.
+    mDeleteBudget(0),
     
     /// Miscellaneous.
     mIsEditorScene(0),
@@ -537,7 +579,7 @@ void Scene::dispatchBeginContactCallbacks( void )
 
         // Does the scene handle the collision callback?
         Namespace* pNamespace = getNamespace();
-        if ( pNamespace != NULL && pNamespace->lookup( StringTable->insert( "onSceneCollision" ) ) != NULL )
+        if ( pNamespace != NULL && pNamespace->lookup( sceneCollisionCallbackName ) != NULL )
         {
             // Yes, so perform script callback on the Scene.
             Con::executef( this, 4, "onSceneCollision",
@@ -649,7 +691,7 @@ void Scene::dispatchEndContactCallbacks( void )
 
         // Does the scene handle the collision callback?
         Namespace* pNamespace = getNamespace();
-        if ( pNamespace != NULL && pNamespace->lookup( StringTable->insert( "onSceneEndCollision" ) ) != NULL )
+        if ( pNamespace != NULL && pNamespace->lookup( sceneEndCollisionCallbackName ) != NULL )
         {
             // Yes, so does the scene handle the collision callback?
             Con::executef( this, 4, "onSceneEndCollision",
@@ -713,6 +755,9 @@ void Scene::processTick( void )
     // Debug Profiling.
     PROFILE_SCOPE(Scene_ProcessTick);
 
+    // Account allocations made while ticking to the scene.
+    MemoryTagScope memoryTagScope( MemoryAllocator::SceneTag );
+
     // Finish if the Scene is not added to the simulation.
     if ( !isProperlyAdded() )
         return;
@@ -730,6 +775,17 @@ void Scene::processTick( void )
     mDebugStats.objectsCount  = (U32)mSceneObjects.size();
     mDebugStats.worldProfile  = mpWorld->GetProfile();
 
+    // Publish frame counters.  The profile is for the last step so the times add up over the frame.
+    sPhysicsStepCounter.add( mDebugStats.worldProfile.step );
+    sPhysicsCollideCounter.add( mDebugStats.worldProfile.collide );
+    sPhysicsSolveCounter.add( mDebugStats.worldProfile.solve );
+    sPhysicsSolveTOICounter.add( mDebugStats.worldProfile.solveTOI );
+    sPhysicsBroadphaseCounter.add( mDebugStats.worldProfile.broadphase );
+    sPhysicsBodiesCounter.set( (F32)mDebugStats.bodyCount );
+    sPhysicsContactsCounter.set( (F32)mDebugStats.contactCount );
+    sSceneObjectsCounter.set( (F32)mDebugStats.objectsCount );
+    sSceneDeletesPendingCounter.set( (F32)mDeleteRequests.size() );
+
     // Set particle stats.
     mDebugStats.particlesAlloc = ParticleSystem::Instance->getAllocatedParticleCount();
     mDebugStats.particlesUsed = ParticleSystem::Instance->getActiveParticleCount();
@@ -978,6 +1034,10 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     b2AABB cameraAABB;
     CoreMath::mRotateAABB( pSceneRenderState->mRenderAABB, pSceneRenderState->mRenderAngle, cameraAABB );
 
+    // Stream in the assets the view is about to need.
+    if ( mAssetStreamer.getRegionCount() > 0 )
+        mAssetStreamer.updateView( pSceneRenderState->mpRenderHost, cameraAABB, Platform::getRealMilliseconds() );
+
     // Rotate the world matrix by the camera angle.
     const Vector2& cameraPosition = pSceneRenderState->mRenderPosition;
     glTranslatef( cameraPosition.x, cameraPosition.y, 0.0f );
@@ -1261,6 +1321,15 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     // Update debug stat ranges.
     mDebugStats.updateRanges();
 
+    // Publish frame counters.
+    sRenderRequestsCounter.add( (F32)pDebugStats->renderRequests );
+    sBatchTrianglesCounter.add( (F32)pDebugStats->batchTrianglesSubmitted );
+    sBatchDrawCallsCounter.add( (F32)(pDebugStats->batchDrawCallsStrictSingle + pDebugStats->batchDrawCallsStrictMultiple + pDebugStats->batchDrawCallsSorted) );
+    sBatchFlushesCounter.add( (F32)pDebugStats->batchFlushes );
+    sBatchTextureFlushesCounter.add( (F32)pDebugStats->batchTextureChangeFlush );
+    sBatchStateFlushesCounter.add( (F32)(pDebugStats->batchBlendStateFlush + pDebugStats->batchColorStateFlush + pDebugStats->batchAlphaStateFlush) );
+    sBatchBufferFullFlushesCounter.add( (F32)pDebugStats->batchBufferFullFlush );
+
     // Are we using the render callback?
     if( mRenderCallback )
     {
@@ -1276,17 +1345,34 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
 
 void Scene::clearScene( bool deleteObjects )
 {
-    while( mSceneObjects.size() > 0 )
+    // NOTE:-   Callbacks can add objects to the scene so repeat until it's empty.
+    while( getSceneObjectCount() > 0 )
     {
-        // Fetch first scene object.
-        SceneObject* pSceneObject = mSceneObjects[0];
-
-        // Remove Object from Scene.
-        removeFromScene( pSceneObject );
+        // Fetch the objects to remove.
+        typeSceneObjectVector sceneObjects( mSceneObjects );
 
-        // Queue Object for deletion.
+        // Fetch the objects to delete.
+        // NOTE:-   Callbacks can delete objects so we'll look them up again by their Id.
+        Vector<SimObjectId> sceneObjectIds;
         if ( deleteObjects )
-            pSceneObject->safeDelete();
+        {
+            sceneObjectIds.reserve( sceneObjects.size() );
+            for ( S32 n = 0; n < sceneObjects.size(); ++n )
+                sceneObjectIds.push_back( sceneObjects[n]->getId() );
+        }
+
+        // Remove all the objects from the scene in a single batch.
+        removeFromScene( sceneObjects );
+
+        // Delete the objects.
+        for ( S32 n = 0; n < sceneObjectIds.size(); ++n )
+        {
+            // Objects not registered with the simulation cannot be found by Id.
+            SceneObject* pSceneObject = sceneObjectIds[n] == 0 ? sceneObjects[n] : dynamic_cast<SceneObject*>( Sim::findObject( sceneObjectIds[n] ) );
+
+            if ( pSceneObject != NULL )
+                pSceneObject->safeDelete();
+        }
     }
 
     // Fetch the controller set.
@@ -1302,6 +1388,9 @@ void Scene::clearScene( bool deleteObjects )
 
     // Clear asset preloads.
     clearAssetPreloads();
+
+    // Clear asset stream regions.
+    mAssetStreamer.clearRegions();
 }
 
 //-----------------------------------------------------------------------------
@@ -1334,6 +1423,7 @@ void Scene::addToScene( SceneObject* pSceneObject )
     }
 
     // Add scene object.
+    pSceneObject->mSceneObjectIndex = mSceneObjects.size();
     mSceneObjects.push_back( pSceneObject );
 
     // Register with the scene.
@@ -1365,6 +1455,141 @@ void Scene::removeFromScene( SceneObject* pSceneObject )
         return;
     }
 
+    // Remove scene object.
+    eraseSceneObject( pSceneObject );
+
+    // Unregister from scene.
+    unregisterSceneObject( pSceneObject );
+
+    // Perform callback.
+    Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::removeFromScene( SceneObject* const* pSceneObjects, const U32 objectCount )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_RemoveFromSceneBatch);
+
+    // Fetch the objects that are in this scene, clearing their slots.
+    // NOTE:-   Callbacks can delete objects so we'll look them up again by their Id.
+    SmallVector<SimObjectId, DeleteBatchSize> removedIds;
+    SmallVector<SceneObject*, DeleteBatchSize> removedObjects;
+    removedIds.reserve( objectCount );
+    removedObjects.reserve( objectCount );
+    for ( U32 n = 0; n < objectCount; ++n )
+    {
+        SceneObject* pSceneObject = pSceneObjects[n];
+
+        // Skip if not in this scene or already removed.
+        if ( pSceneObject == NULL || pSceneObject->getScene() != this || pSceneObject->mSceneObjectIndex < 0 )
+            continue;
+
+        mSceneObjects[pSceneObject->mSceneObjectIndex] = NULL;
+        pSceneObject->mSceneObjectIndex = -1;
+
+        removedIds.push_back( pSceneObject->getId() );
+        removedObjects.push_back( pSceneObject );
+    }
+
+    // Finish if nothing to remove.
+    if ( removedObjects.size() == 0 )
+        return;
+
+    // Compact the remaining scene objects unless processing delete requests which does it once at the end.
+    mEmptySceneObjectSlots += (U32)removedObjects.size();
+    if ( !mDeferSceneObjectCompaction )
+        compactSceneObjects();
+
+    // Unregister the removed objects.
+    for ( S32 n = 0; n < removedObjects.size(); ++n )
+    {
+        // Fetch the object.
+        // NOTE:- Objects not registered with the simulation cannot be found by Id.
+        SceneObject* pSceneObject = removedIds[n] == 0 ? removedObjects[n] : dynamic_cast<SceneObject*>( Sim::findObject( removedIds[n] ) );
+
+        // Skip if it was deleted or removed by a previous callback.
+        if ( pSceneObject == NULL || pSceneObject->getScene() != this || pSceneObject->mSceneObjectIndex >= 0 )
+            continue;
+
+        // Unregister from scene.
+        unregisterSceneObject( pSceneObject );
+
+        // Perform callback.
+        Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::eraseSceneObject( SceneObject* pSceneObject )
+{
+    // Fetch the scene object index.
+    const S32 objectIndex = pSceneObject->mSceneObjectIndex;
+
+    // Finish if already erased by a batch removal.
+    if ( objectIndex < 0 )
+        return;
+
+    // Sanity!
+    AssertFatal( objectIndex < mSceneObjects.size() && mSceneObjects[objectIndex] == pSceneObject, "Scene::eraseSceneObject() - The scene object index has become corrupt." );
+
+    // Leave an empty slot if compaction is deferred as the last slot may be empty.
+    if ( mDeferSceneObjectCompaction )
+    {
+        mSceneObjects[objectIndex] = NULL;
+        pSceneObject->mSceneObjectIndex = -1;
+        mEmptySceneObjectSlots++;
+        return;
+    }
+
+    // Move the last scene object into the slot.
+    SceneObject* pLastSceneObject = mSceneObjects.last();
+    mSceneObjects[objectIndex] = pLastSceneObject;
+    pLastSceneObject->mSceneObjectIndex = objectIndex;
+    mSceneObjects.pop_back();
+
+    pSceneObject->mSceneObjectIndex = -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::compactSceneObjects( void ) const
+{
+    // Finish if there are no empty slots.
+    if ( mEmptySceneObjectSlots == 0 )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_CompactSceneObjects);
+
+    // NOTE:-   Compacting does not change which objects are in the scene, only where they are held,
+    //          so it is done on demand from the accessors.
+    Scene* pScene = const_cast<Scene*>( this );
+    typeSceneObjectVector& sceneObjects = pScene->mSceneObjects;
+
+    // Compact the remaining scene objects in a single pass.
+    S32 compactCount = 0;
+    for ( S32 n = 0; n < sceneObjects.size(); ++n )
+    {
+        SceneObject* pSceneObject = sceneObjects[n];
+
+        if ( pSceneObject == NULL )
+            continue;
+
+        pSceneObject->mSceneObjectIndex = compactCount;
+        sceneObjects[compactCount++] = pSceneObject;
+    }
+    sceneObjects.setSize( compactCount );
+
+    pScene->mEmptySceneObjectSlots = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::unregisterSceneObject( SceneObject* pSceneObject )
+{
     // Remove as debug-object if set.
     if ( pSceneObject == getDebugSceneObject() )
         setDebugSceneObject( NULL );
@@ -1383,19 +1608,6 @@ void Scene::removeFromScene( SceneObject* pSceneObject )
 
     // Unregister from scene.
     pSceneObject->OnUnregisterScene( this );
-
-    // Find scene object and remove it quickly.
-    for ( S32 n = 0; n < mSceneObjects.size(); ++n )
-    {
-        if ( mSceneObjects[n] == pSceneObject )
-        {
-            mSceneObjects.erase_fast( n );
-            break;
-        }
-    }
-
-    // Perform callback.
-    Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
 }
 
 //-----------------------------------------------------------------------------
@@ -1405,6 +1617,9 @@ SceneObject* Scene::getSceneObject( const U32 objectIndex ) const
     // Sanity!
     AssertFatal( objectIndex < getSceneObjectCount(), "Scene::getSceneObject() - Invalid object index." );
 
+    // Compact any empty slots.
+    compactSceneObjects();
+
     return mSceneObjects[objectIndex];
 }
 
@@ -3660,9 +3875,16 @@ void Scene::processDeleteRequests( const bool forceImmediate )
     if ( mDeleteRequests.size() == 0 )
         return;
 
-    // Validate All Delete Requests.
-    U32 safeDeleteReadyCount = 0;
-    for ( U32 requestIndex = 0; requestIndex < (U32)mDeleteRequests.size(); )
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_ProcessDeleteRequests);
+
+    // Transfer safe-ready delete-requests to the temporary list.
+    // NOTE:-   We do this because we may delete objects which have dependencies.  This would
+    //          cause objects to be added to the safe-delete list.  We don't want to work on
+    //          the list whilst this is happening so we'll transfer it to a temporary list.
+    mDeleteRequestsTemp.clear();
+    U32 pendingCount = 0;
+    for ( U32 requestIndex = 0; requestIndex < (U32)mDeleteRequests.size(); ++requestIndex )
     {
         // Fetch Reference to Delete Request.
         tDeleteRequest& deleteRequest = mDeleteRequests[requestIndex];
@@ -3671,96 +3893,103 @@ void Scene::processDeleteRequests( const bool forceImmediate )
         // NOTE:- Let's be safer and check that it's definitely a scene-object.
         SceneObject* pSceneObject = dynamic_cast<SceneObject*>( Sim::findObject( deleteRequest.mObjectId ) );
 
-        // Does this object exist?
-        if ( pSceneObject )
-        {
-            // Yes, so write object.
-            deleteRequest.mpSceneObject = pSceneObject;
+        // Skip the request if it looks like the object got deleted prematurely.
+        if ( !pSceneObject )
+            continue;
 
-            // Calculate Safe-Ready Flag.
-            deleteRequest.mSafeDeleteReady = forceImmediate || pSceneObject->getSafeDelete();
+        // Write object.
+        deleteRequest.mpSceneObject = pSceneObject;
 
-            // Is it ready to safe-delete?
-            if ( deleteRequest.mSafeDeleteReady )
-            {
-                // Yes, so increase safe-ready count.
-                ++safeDeleteReadyCount;
-            }         
+        // Calculate Safe-Ready Flag.
+        deleteRequest.mSafeDeleteReady = forceImmediate || pSceneObject->getSafeDelete();
+
+        // Is it ready to safe-delete?
+        if ( deleteRequest.mSafeDeleteReady )
+        {
+            // Yes, so transfer the delete-request.
+            mDeleteRequestsTemp.push_back( deleteRequest );
         }
         else
         {
-            // No, so it looks like the object got deleted prematurely; let's just remove
-            // the request instead.
-            mDeleteRequests.erase_fast( requestIndex );
-            
-            // Repeat this item.
-            continue;
+            // No, so keep the delete-request.
+            mDeleteRequests[pendingCount++] = deleteRequest;
         }
-
-        // Skip to next request index.
-        ++requestIndex;
     }
+    mDeleteRequests.setSize( pendingCount );
+
+    // Fetch the delete budget.
+    // NOTE:-   A forced delete ignores the budget as the objects must be gone when we return.
+    const U32 deleteBudget = forceImmediate ? 0 : mDeleteBudget;
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    // Defer compacting the scene objects until all the batches are removed.
+    // NOTE:- Callbacks can process delete requests again so restore the previous state at the end.
+    const bool deferCompaction = mDeferSceneObjectCompaction;
+    mDeferSceneObjectCompaction = true;
+
+    // Process the safe-ready delete-requests in batches.
+    U32 processedCount = 0;
+    SmallVector<SceneObject*, DeleteBatchSize> deleteBatch;
+    while ( processedCount < (U32)mDeleteRequestsTemp.size() )
+    {
+        const U32 batchEnd = getMin( processedCount + (U32)DeleteBatchSize, (U32)mDeleteRequestsTemp.size() );
 
-    // Stop if there's no delete requests!
-    if ( mDeleteRequests.size() == 0 )
-        return;
+        // Do script callbacks whilst the objects are still in the scene.
+        for ( U32 requestIndex = processedCount; requestIndex < batchEnd; ++requestIndex )
+        {
+            SceneObject* pSceneObject = dynamic_cast<SceneObject*>( Sim::findObject( mDeleteRequestsTemp[requestIndex].mObjectId ) );
 
-    // Transfer Delete-Requests to Temporary version.
-    // NOTE:-   We do this because we may delete objects which have dependencies.  This would
-    //          cause objects to be added to the safe-delete list.  We don't want to work on
-    //          the list whilst this is happening so we'll transfer it to a temporary list.
-    mDeleteRequestsTemp = mDeleteRequests;
+            if ( pSceneObject )
+                Con::executef(this, 2, "onSafeDelete", pSceneObject->getIdString() );
+        }
 
-    // Can we process all remaining delete-requests?
-    if ( safeDeleteReadyCount == (U32)mDeleteRequestsTemp.size() )
-    {
-        // Yes, so process ALL safe-ready delete-requests.
-        for ( U32 requestIndex = 0; requestIndex < (U32)mDeleteRequestsTemp.size(); ++requestIndex )
+        // Remove the objects from the scene in a single batch.
+        deleteBatch.clear();
+        for ( U32 requestIndex = processedCount; requestIndex < batchEnd; ++requestIndex )
         {
-            // Yes, so fetch object.
-            SceneObject* pSceneObject = mDeleteRequestsTemp[requestIndex].mpSceneObject;
-
-            // Do script callback.
-            Con::executef(this, 2, "onSafeDelete", pSceneObject->getIdString() );
+            SceneObject* pSceneObject = dynamic_cast<SceneObject*>( Sim::findObject( mDeleteRequestsTemp[requestIndex].mObjectId ) );
 
-            // Destroy the object.
-            pSceneObject->deleteObject();
+            if ( pSceneObject )
+                deleteBatch.push_back( pSceneObject );
         }
+        removeFromScene( deleteBatch.address(), (U32)deleteBatch.size() );
 
-        // Remove All delete-requests.
-        mDeleteRequestsTemp.clear();
-    }
-    else
-    {
-        // No, so process only safe-ready delete-requests.
-        for ( U32 requestIndex = 0; requestIndex <(U32) mDeleteRequestsTemp.size(); )
+        // Destroy the objects, returning them to their pools if they have one.
+        for ( U32 requestIndex = processedCount; requestIndex < batchEnd; ++requestIndex )
         {
-            // Fetch Reference to Delete Request.
-            tDeleteRequest& deleteRequest = mDeleteRequestsTemp[requestIndex];
+            SceneObject* pSceneObject = dynamic_cast<SceneObject*>( Sim::findObject( mDeleteRequestsTemp[requestIndex].mObjectId ) );
 
-            // Is the Object Safe-Ready?
-            if ( deleteRequest.mSafeDeleteReady )
-            {
-                // Yes, so fetch object.
-                SceneObject* pSceneObject = deleteRequest.mpSceneObject;
+            if ( pSceneObject )
+                pSceneObject->recycleObject();
+        }
 
-                // Do script callback.
-                Con::executef(this, 2, "onSafeDelete", pSceneObject->getIdString() );
+        sSceneDeletesCounter.add( (F32)(batchEnd - processedCount) );
+        processedCount = batchEnd;
 
-                // Destroy the object.
-                pSceneObject->deleteObject();
+        // Stop if we've used the delete budget.
+        if ( deleteBudget > 0 && Platform::getRealMilliseconds() - startTime >= deleteBudget )
+            break;
+    }
 
-                // Quickly remove delete-request.
-                mDeleteRequestsTemp.erase_fast( requestIndex );
+    // Compact the scene objects once for all the batches.
+    mDeferSceneObjectCompaction = deferCompaction;
+    if ( !mDeferSceneObjectCompaction )
+        compactSceneObjects();
 
-                // Repeat this item.
-                continue;
-            }
+    // Queue any remaining delete-requests ahead of the ones that were not ready.
+    // NOTE:- Their objects are still flagged as being deleted so they are neither ticked nor rendered.
+    if ( processedCount < (U32)mDeleteRequestsTemp.size() )
+    {
+        for ( U32 requestIndex = 0; requestIndex < (U32)mDeleteRequests.size(); ++requestIndex )
+            mDeleteRequestsTemp.push_back( mDeleteRequests[requestIndex] );
 
-            // Skip to next request index.
-            ++requestIndex;
-        }
+        mDeleteRequests.clear();
+        for ( U32 requestIndex = processedCount; requestIndex < (U32)mDeleteRequestsTemp.size(); ++requestIndex )
+            mDeleteRequests.push_back( mDeleteRequestsTemp[requestIndex] );
     }
+
+    // Remove All delete-requests.
+    mDeleteRequestsTemp.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -5228,6 +5457,9 @@ SceneRenderRequest* Scene::createDefaultRenderRequest( SceneRenderQueue* pSceneR
 
 SimObject* Scene::getTamlChild( const U32 childIndex ) const
 {
+    // Compact any empty slots.
+    compactSceneObjects();
+
     // Sanity!
     AssertFatal( childIndex < (U32)mSceneObjects.size(), "Scene::getTamlChild() - Child index is out of range." );
 
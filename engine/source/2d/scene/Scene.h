@@ -75,6 +75,10 @@
 #include "assets/assetPtr.h"
 #endif
 
+#ifndef _SCENE_ASSET_STREAMER_H_
+#include "2d/scene/SceneAssetStreamer.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 extern EnumTable jointTypeTable;
@@ -173,6 +177,9 @@ public:
     typedef HashMap<b2Contact*, TickContact>    typeContactHash;
     typedef Vector<AssetPtr<AssetBase>*>        typeAssetPtrVector;
 
+    /// The number of delete requests processed between checks of the delete budget.
+    enum { DeleteBatchSize = 64 };
+
     /// Scene Debug Options.
     enum DebugOption
     {
@@ -220,8 +227,12 @@ private:
     b2Body*                     mpGroundBody;
 
     /// Scene occupancy.
+    /// NOTE:-  Removals whilst processing delete requests leave empty slots which are
+    ///         compacted once at the end or whenever the scene objects are accessed.
     typeSceneObjectVector       mSceneObjects;
     typeSceneObjectVector       mTickedSceneObjects;
+    U32                         mEmptySceneObjectSlots;
+    bool                        mDeferSceneObjectCompaction;
 
     /// Joint access.
     typeJointHash               mJoints;
@@ -234,6 +245,9 @@ private:
     /// Asset pre-loads.
     typeAssetPtrVector          mAssetPreloads;
 
+    /// Asset streaming.
+    SceneAssetStreamer          mAssetStreamer;
+
     /// Scene time.
     F32                         mSceneTime;
     bool                        mScenePause;
@@ -258,6 +272,7 @@ private:
     /// Delete requests.
     typeDeleteVector            mDeleteRequests;
     typeDeleteVector            mDeleteRequestsTemp;
+    U32                         mDeleteBudget;
   
     /// Miscellaneous.
     S32                         mIsEditorScene;
@@ -273,6 +288,11 @@ private:
     void                        dispatchBeginContactCallbacks( void );
     void                        dispatchEndContactCallbacks( void );
 
+    /// Scene occupancy.
+    void                        eraseSceneObject( SceneObject* pSceneObject );
+    void                        compactSceneObjects( void ) const;
+    void                        unregisterSceneObject( SceneObject* pSceneObject );
+
     /// Joint definition.
     struct CommonJointDefinition
     {
@@ -344,9 +364,11 @@ public:
     void                    clearScene( bool deleteObjects = true );
     void                    addToScene( SceneObject* pSceneObject );
     void                    removeFromScene( SceneObject* pSceneObject );
+    void                    removeFromScene( SceneObject* const* pSceneObjects, const U32 objectCount );
+    inline void             removeFromScene( const typeSceneObjectVector& sceneObjects ) { removeFromScene( sceneObjects.address(), (U32)sceneObjects.size() ); }
 
-    inline typeSceneObjectVectorConstRef getSceneObjects( void ) const  { return mSceneObjects; }
-    inline U32              getSceneObjectCount( void ) const           { return mSceneObjects.size(); }
+    inline typeSceneObjectVectorConstRef getSceneObjects( void ) const  { compactSceneObjects(); return mSceneObjects; }
+    inline U32              getSceneObjectCount( void ) const           { compactSceneObjects(); return mSceneObjects.size(); }
     SceneObject*            getSceneObject( const U32 objectIndex ) const;
     U32                     getSceneObjects( typeSceneObjectVector& objects ) const;
     U32                     getSceneObjects( typeSceneObjectVector& objects, const U32 sceneLayer ) const;
@@ -361,6 +383,8 @@ public:
     void                    removeAssetPreload( const char* pAssetId );
     void                    clearAssetPreloads( void );
 
+    inline SceneAssetStreamer& getAssetStreamer( void )                 { return mAssetStreamer; }
+
     /// Scene time.
     inline F32              getSceneTime( void ) const                  { return mSceneTime; };
     inline void             setScenePause( bool status )                { mScenePause = status; }
@@ -646,6 +670,9 @@ public:
     /// Delete requests.
     void                    addDeleteRequest( SceneObject* pSceneObject );
     void                    processDeleteRequests( const bool forceImmediate );
+    inline void             setDeleteBudget( const U32 budgetMs )       { mDeleteBudget = budgetMs; }
+    inline U32              getDeleteBudget( void ) const               { return mDeleteBudget; }
+    inline U32              getDeleteRequestCount( void ) const         { return (U32)mDeleteRequests.size(); }
 
     /// Destruction listeners.
     virtual                 void SayGoodbye( b2Joint* pJoint );
@@ -667,7 +694,7 @@ public:
     static SceneRenderRequest* createDefaultRenderRequest( SceneRenderQueue* pSceneRenderQueue, SceneObject* pSceneObject  );
 
     /// Taml children.
-    virtual U32 getTamlChildCount( void ) const                         { return (U32)mSceneObjects.size(); }
+    virtual U32 getTamlChildCount( void ) const                         { compactSceneObjects(); return (U32)mSceneObjects.size(); }
     virtual SimObject* getTamlChild( const U32 childIndex ) const;
     virtual void addTamlChild( SimObject* pSimObject );
 
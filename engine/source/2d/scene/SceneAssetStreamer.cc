@@ -0,0 +1,346 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_ASSET_STREAMER_H_
+#include "2d/scene/SceneAssetStreamer.h"
+#endif
+
+#ifndef _ASSET_MANAGER_H_
+#include "assets/assetManager.h"
+#endif
+
+#ifndef _UTILITY_H_
+#include "2d/core/Utility.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+/// Views that have not rendered for this long are forgotten.
+static const U32 sViewExpiryMs = 5000;
+
+/// Views that have not rendered for this long restart with no velocity.
+static const U32 sViewVelocityResetMs = 250;
+
+//-----------------------------------------------------------------------------
+
+/// Receives an asset acquired for a region.
+/// The callback is detached when the region is released before the asset arrives, in which case the asset is released again.
+class SceneAssetStreamer::StreamLoadCallback : public AssetLoadCallback
+{
+public:
+    StreamLoadCallback( StreamRegion* pRegion ) : mpRegion( pRegion ) {}
+
+    inline void detach( void ) { mpRegion = NULL; }
+
+    virtual void onAssetLoaded( StringTableEntry assetId, AssetBase* pAssetBase )
+    {
+        // Is the callback still attached to the region?
+        if ( mpRegion != NULL )
+        {
+            // Yes, so the load is no longer pending.
+            const S32 index = mpRegion->mPendingLoads.find_next( this );
+            if ( index >= 0 )
+                mpRegion->mPendingLoads.erase_fast( index );
+
+            // Hold the asset for the region.
+            if ( pAssetBase != NULL )
+                mpRegion->mAcquiredAssets.push_back( assetId );
+        }
+        else if ( pAssetBase != NULL )
+        {
+            // No, so release the asset.
+            AssetDatabase.releaseAsset( assetId );
+        }
+
+        delete this;
+    }
+
+private:
+    StreamRegion* mpRegion;
+};
+
+//-----------------------------------------------------------------------------
+
+SceneAssetStreamer::SceneAssetStreamer() :
+    mNextRegionId( 1 ),
+    mLookAheadTime( 1.0f ),
+    mMargin( 0.0f ),
+    mReleaseTime( 2.0f ),
+    mQueryTime( 0 )
+{
+    resetStats();
+}
+
+//-----------------------------------------------------------------------------
+
+SceneAssetStreamer::~SceneAssetStreamer()
+{
+    clearRegions();
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneAssetStreamer::addRegion( const b2AABB& area, const char* pAssetIds )
+{
+    // Finish if there are no asset Ids.
+    const U32 assetCount = Utility::mGetStringElementCount( pAssetIds );
+    if ( assetCount == 0 )
+        return 0;
+
+    // Create the region.
+    StreamRegion* pRegion = new StreamRegion();
+    pRegion->mId = mNextRegionId++;
+    pRegion->mArea = area;
+    pRegion->mLastWantedTime = 0;
+    pRegion->mActive = false;
+    pRegion->mSeen = false;
+
+    for ( U32 index = 0; index < assetCount; ++index )
+        pRegion->mAssetIds.push_back( StringTable->insert( Utility::mGetStringElement( pAssetIds, index ) ) );
+
+    // Add the region.
+    pRegion->mProxyId = mRegionTree.CreateProxy( area, pRegion );
+    mRegions.insert( pRegion->mId, pRegion );
+
+    return pRegion->mId;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneAssetStreamer::removeRegion( const U32 regionId )
+{
+    // Find the region.
+    typeRegionHash::iterator regionItr = mRegions.find( regionId );
+    if ( regionItr == mRegions.end() )
+        return false;
+
+    StreamRegion* pRegion = regionItr->value;
+
+    // Release the region if it is active.
+    if ( pRegion->mActive )
+        deactivateRegion( pRegion );
+
+    // Remove the region.
+    mRegionTree.DestroyProxy( pRegion->mProxyId );
+    mRegions.erase( regionItr );
+    delete pRegion;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneAssetStreamer::clearRegions( void )
+{
+    for ( typeRegionHash::iterator regionItr = mRegions.begin(); regionItr != mRegions.end(); ++regionItr )
+    {
+        StreamRegion* pRegion = regionItr->value;
+
+        // Release the region if it is active.
+        if ( pRegion->mActive )
+            deactivateRegion( pRegion );
+
+        mRegionTree.DestroyProxy( pRegion->mProxyId );
+        delete pRegion;
+    }
+
+    mRegions.clear();
+    mViews.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneAssetStreamer::updateView( SimObject* pRenderHost, const b2AABB& viewAABB, const U32 timeMs )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneAssetStreamer_UpdateView);
+
+    // Track the view movement.
+    StreamView& view = findView( pRenderHost, viewAABB.GetCenter(), timeMs );
+
+    // Predict the area the view covers over the look-ahead time.
+    const Vector2 lookAhead = view.mVelocity * mLookAheadTime;
+    b2AABB predictedAABB;
+    predictedAABB.lowerBound.Set( viewAABB.lowerBound.x + getMin( lookAhead.x, 0.0f ) - mMargin, viewAABB.lowerBound.y + getMin( lookAhead.y, 0.0f ) - mMargin );
+    predictedAABB.upperBound.Set( viewAABB.upperBound.x + getMax( lookAhead.x, 0.0f ) + mMargin, viewAABB.upperBound.y + getMax( lookAhead.y, 0.0f ) + mMargin );
+
+    // Prefetch the regions in the predicted area.
+    mQueryAABB = predictedAABB;
+    mQueryViewAABB = viewAABB;
+    mQueryTime = timeMs;
+    mRegionTree.Query( this, predictedAABB );
+
+    // Release the regions no view has wanted for the release time.
+    const U32 releaseMs = (U32)(mReleaseTime * 1000.0f);
+    for ( S32 index = mActiveRegions.size() - 1; index >= 0; --index )
+    {
+        StreamRegion* pRegion = mActiveRegions[index];
+
+        if ( timeMs - pRegion->mLastWantedTime > releaseMs )
+            deactivateRegion( pRegion );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneAssetStreamer::resetStats( void )
+{
+    mStats.mPrefetches = 0;
+    mStats.mReleases = 0;
+    mStats.mHits = 0;
+    mStats.mMisses = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneAssetStreamer::QueryCallback( S32 proxyId )
+{
+    // Fetch the region.
+    StreamRegion* pRegion = static_cast<StreamRegion*>( mRegionTree.GetUserData( proxyId ) );
+
+    // Ignore if only the fattened region overlaps.
+    if ( !b2TestOverlap( pRegion->mArea, mQueryAABB ) )
+        return true;
+
+    pRegion->mLastWantedTime = mQueryTime;
+
+    // Prefetch the region if it is not active.
+    if ( !pRegion->mActive )
+        activateRegion( pRegion );
+
+    // Is the region seen by the view for the first time since it was activated?
+    if ( !pRegion->mSeen && b2TestOverlap( pRegion->mArea, mQueryViewAABB ) )
+    {
+        // Yes, so count whether it was loaded in time.
+        pRegion->mSeen = true;
+
+        if ( pRegion->mPendingLoads.size() == 0 )
+            mStats.mHits++;
+        else
+            mStats.mMisses++;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneAssetStreamer::activateRegion( StreamRegion* pRegion )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneAssetStreamer_ActivateRegion);
+
+    pRegion->mActive = true;
+    pRegion->mSeen = false;
+    mActiveRegions.push_back( pRegion );
+    mStats.mPrefetches++;
+
+    // Acquire the region assets.
+    for ( S32 index = 0; index < pRegion->mAssetIds.size(); ++index )
+    {
+        StreamLoadCallback* pCallback = new StreamLoadCallback( pRegion );
+        pRegion->mPendingLoads.push_back( pCallback );
+
+        // NOTE: The callback is called immediately if the asset is already loaded.
+        if ( !AssetDatabase.acquireAssetAsync( pRegion->mAssetIds[index], pCallback ) )
+        {
+            // The asset does not exist so the callback is never called.
+            pRegion->mPendingLoads.erase_fast( pRegion->mPendingLoads.find_next( pCallback ) );
+            delete pCallback;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneAssetStreamer::deactivateRegion( StreamRegion* pRegion )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneAssetStreamer_DeactivateRegion);
+
+    // Assets still loading are released as they arrive.
+    for ( S32 index = 0; index < pRegion->mPendingLoads.size(); ++index )
+        pRegion->mPendingLoads[index]->detach();
+    pRegion->mPendingLoads.clear();
+
+    // Release the acquired assets.
+    for ( S32 index = 0; index < pRegion->mAcquiredAssets.size(); ++index )
+        AssetDatabase.releaseAsset( pRegion->mAcquiredAssets[index] );
+    pRegion->mAcquiredAssets.clear();
+
+    pRegion->mActive = false;
+    mActiveRegions.erase_fast( mActiveRegions.find_next( pRegion ) );
+    mStats.mReleases++;
+}
+
+//-----------------------------------------------------------------------------
+
+SceneAssetStreamer::StreamView& SceneAssetStreamer::findView( SimObject* pRenderHost, const Vector2& center, const U32 timeMs )
+{
+    const SimObjectId renderHostId = pRenderHost == NULL ? 0 : pRenderHost->getId();
+
+    // Forget any views that have stopped rendering.
+    for ( S32 index = mViews.size() - 1; index >= 0; --index )
+    {
+        if ( mViews[index].mRenderHostId != renderHostId && timeMs - mViews[index].mLastTime > sViewExpiryMs )
+            mViews.erase_fast( index );
+    }
+
+    // Find the view.
+    for ( S32 index = 0; index < mViews.size(); ++index )
+    {
+        StreamView& view = mViews[index];
+
+        if ( view.mRenderHostId != renderHostId )
+            continue;
+
+        // Update the view velocity.
+        const U32 elapsedMs = timeMs - view.mLastTime;
+        if ( elapsedMs > sViewVelocityResetMs )
+        {
+            view.mVelocity.SetZero();
+        }
+        else if ( elapsedMs > 0 )
+        {
+            // Smooth the velocity so a single uneven frame does not throw the prediction.
+            const Vector2 velocity = (center - view.mCenter) / (elapsedMs / 1000.0f);
+            view.mVelocity = (view.mVelocity + velocity) * 0.5f;
+        }
+
+        view.mCenter = center;
+        view.mLastTime = timeMs;
+        return view;
+    }
+
+    // Add the view.
+    StreamView view;
+    view.mRenderHostId = renderHostId;
+    view.mCenter = center;
+    view.mVelocity.SetZero();
+    view.mLastTime = timeMs;
+    mViews.push_back( view );
+
+    return mViews.last();
+}
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_ASSET_STREAMER_H_
+#define _SCENE_ASSET_STREAMER_H_
+
+#ifndef BOX2D_H
+#include "box2d/Box2D.h"
+#endif
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// Streams the assets of scene regions in and out as the views move.
+///
+/// Each region is an area of the scene along with the assets it needs.
+/// Every time a view renders the scene its movement is tracked and the area
+/// it will cover soon is predicted from its velocity.  Regions overlapping
+/// that area are acquired asynchronously ahead of time.  Regions no view has
+/// wanted for the release time are released, which leaves their assets to
+/// the idle asset cache of the asset manager to evict under its budget.
+class SceneAssetStreamer
+{
+public:
+    /// Streaming statistics.
+    /// A hit is a region that was loaded when first seen by a view, a miss one that was still loading.
+    struct StreamStats
+    {
+        U32 mPrefetches;
+        U32 mReleases;
+        U32 mHits;
+        U32 mMisses;
+    };
+
+    SceneAssetStreamer();
+    ~SceneAssetStreamer();
+
+    /// Regions.
+    /// @param pAssetIds The asset Ids separated by whitespace.
+    /// @return The region Id or zero if no asset Ids were specified.
+    U32                     addRegion( const b2AABB& area, const char* pAssetIds );
+    bool                    removeRegion( const U32 regionId );
+    void                    clearRegions( void );
+    inline U32              getRegionCount( void ) const                { return (U32)mRegions.size(); }
+    inline U32              getActiveRegionCount( void ) const          { return (U32)mActiveRegions.size(); }
+
+    /// Prediction.
+    inline void             setLookAheadTime( const F32 seconds )       { mLookAheadTime = getMax( seconds, 0.0f ); }
+    inline F32              getLookAheadTime( void ) const              { return mLookAheadTime; }
+    inline void             setMargin( const F32 margin )               { mMargin = getMax( margin, 0.0f ); }
+    inline F32              getMargin( void ) const                     { return mMargin; }
+    inline void             setReleaseTime( const F32 seconds )         { mReleaseTime = getMax( seconds, 0.0f ); }
+    inline F32              getReleaseTime( void ) const                { return mReleaseTime; }
+
+    /// Called by the scene each time a view renders it.
+    void                    updateView( SimObject* pRenderHost, const b2AABB& viewAABB, const U32 timeMs );
+
+    /// Statistics.
+    inline const StreamStats& getStats( void ) const                    { return mStats; }
+    void                    resetStats( void );
+
+    /// Region queries.
+    bool                    QueryCallback( S32 proxyId );
+
+private:
+    class StreamLoadCallback;
+
+    struct StreamRegion
+    {
+        U32                             mId;
+        b2AABB                          mArea;
+        S32                             mProxyId;
+        Vector<StringTableEntry>        mAssetIds;
+        Vector<StringTableEntry>        mAcquiredAssets;
+        Vector<StreamLoadCallback*>     mPendingLoads;
+        U32                             mLastWantedTime;
+        bool                            mActive;
+        bool                            mSeen;
+    };
+
+    struct StreamView
+    {
+        SimObjectId                     mRenderHostId;
+        Vector2                         mCenter;
+        Vector2                         mVelocity;
+        U32                             mLastTime;
+    };
+
+    typedef HashMap<U32, StreamRegion*> typeRegionHash;
+
+    void                    activateRegion( StreamRegion* pRegion );
+    void                    deactivateRegion( StreamRegion* pRegion );
+    StreamView&             findView( SimObject* pRenderHost, const Vector2& center, const U32 timeMs );
+
+    b2DynamicTree           mRegionTree;
+    typeRegionHash          mRegions;
+    Vector<StreamRegion*>   mActiveRegions;
+    Vector<StreamView>      mViews;
+    U32                     mNextRegionId;
+
+    F32                     mLookAheadTime;
+    F32                     mMargin;
+    F32                     mReleaseTime;
+
+    /// Region query state.
+    b2AABB                  mQueryAABB;
+    b2AABB                  mQueryViewAABB;
+    U32                     mQueryTime;
+
+    StreamStats             mStats;
+};
+
+#endif // _SCENE_ASSET_STREAMER_H_
@@ -160,6 +160,34 @@ ConsoleMethod(Scene, clear, void, 2, 3, "([deleteObjects]) Clear the scene of al
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(Scene, setDeleteBudget, void, 3, 3,   "(budgetMs) Sets the time budget for processing safe-delete requests each tick.\n"
+                                                    "Requests that don't fit in the budget are processed on the following ticks.  Their objects are neither ticked nor rendered whilst they wait.\n"
+                                                    "@param budgetMs The budget in milliseconds.  Zero processes all ready requests each tick (the default).\n"
+                                                    "@return No return value.")
+{
+    const S32 budget = dAtoi(argv[2]);
+
+    object->setDeleteBudget( budget > 0 ? (U32)budget : 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getDeleteBudget, S32, 2, 2,    "() Gets the time budget for processing safe-delete requests each tick.\n"
+                                                    "@return The budget in milliseconds.")
+{
+    return (S32)object->getDeleteBudget();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getDeleteRequestCount, S32, 2, 2,  "() Gets the number of pending safe-delete requests.\n"
+                                                        "@return The number of pending safe-delete requests.")
+{
+    return (S32)object->getDeleteRequestCount();
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Scene, getCount, S32, 2, 2,   "() Gets the count of scene objects in the scnee.\n"
                                             "@return Returns the number of scene objects in current scene as an integer.")
 {
@@ -310,6 +338,129 @@ ConsoleMethod(Scene, clearAssetPreloads, void, 2, 2,    "() Clears all assets ad
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(Scene, addAssetStreamRegion, S32, 5, 5,   "(startx/y, endx/y, assetIds) Adds an area of the scene whose assets are streamed in as views approach it.\n"
+                                                        "The assets are acquired asynchronously once a view is predicted to reach the area and released once no view has for the release time.\n"
+                                                        "@param startx/y The coordinates of one corner of the area as (\"x y\").\n"
+                                                        "@param endx/y The coordinates of the opposite corner of the area as (\"x y\").\n"
+                                                        "@param assetIds The asset Ids needed by the area separated by spaces.\n"
+                                                        "@return The region Id or zero if no asset Ids were specified.")
+{
+    // Fetch the area.
+    const Vector2 v1 = Utility::mGetStringElementVector( argv[2] );
+    const Vector2 v2 = Utility::mGetStringElementVector( argv[3] );
+
+    b2AABB area;
+    area.lowerBound.Set( getMin( v1.x, v2.x ), getMin( v1.y, v2.y ) );
+    area.upperBound.Set( getMax( v1.x, v2.x ), getMax( v1.y, v2.y ) );
+
+    // Add the region.
+    return object->getAssetStreamer().addRegion( area, argv[4] );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, removeAssetStreamRegion, bool, 3, 3, "(regionId) Removes an asset stream region, releasing its assets if they are acquired.\n"
+                                                        "@param regionId The region Id returned when the region was added.\n"
+                                                        "@return Whether the region was removed or not.")
+{
+    return object->getAssetStreamer().removeRegion( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, clearAssetStreamRegions, void, 2, 2, "() Removes all the asset stream regions, releasing their assets.\n"
+                                                        "@return No return value.")
+{
+    object->getAssetStreamer().clearRegions();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getAssetStreamRegionCount, S32, 2, 3, "([active?]) Gets the number of asset stream regions.\n"
+                                                        "@param active Whether to only count the regions whose assets are acquired or not.  Optional: Defaults to false.\n"
+                                                        "@return The number of asset stream regions.")
+{
+    const bool active = argc > 2 ? dAtob(argv[2]) : false;
+
+    return active ? object->getAssetStreamer().getActiveRegionCount() : object->getAssetStreamer().getRegionCount();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, setAssetStreamLookAhead, void, 3, 3, "(seconds) Sets how far ahead the view movement is predicted when streaming assets.\n"
+                                                        "@param seconds The time to predict the view movement over.\n"
+                                                        "@return No return value.")
+{
+    object->getAssetStreamer().setLookAheadTime( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getAssetStreamLookAhead, F32, 2, 2, "() Gets how far ahead the view movement is predicted when streaming assets.\n"
+                                                        "@return The time the view movement is predicted over.")
+{
+    return object->getAssetStreamer().getLookAheadTime();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, setAssetStreamMargin, void, 3, 3,  "(margin) Sets the distance around the views that asset stream regions are acquired within.\n"
+                                                        "@param margin The distance around the views.\n"
+                                                        "@return No return value.")
+{
+    object->getAssetStreamer().setMargin( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getAssetStreamMargin, F32, 2, 2,   "() Gets the distance around the views that asset stream regions are acquired within.\n"
+                                                        "@return The distance around the views.")
+{
+    return object->getAssetStreamer().getMargin();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, setAssetStreamReleaseTime, void, 3, 3, "(seconds) Sets how long an asset stream region is kept once no view needs it.\n"
+                                                        "@param seconds The time to keep the region assets acquired.\n"
+                                                        "@return No return value.")
+{
+    object->getAssetStreamer().setReleaseTime( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getAssetStreamReleaseTime, F32, 2, 2, "() Gets how long an asset stream region is kept once no view needs it.\n"
+                                                        "@return The time the region assets are kept acquired.")
+{
+    return object->getAssetStreamer().getReleaseTime();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getAssetStreamStats, const char*, 2, 3, "([reset?]) Gets the asset streaming statistics.\n"
+                                                        "A hit is a region whose assets were loaded when a view first reached it, a miss one whose assets were still loading.\n"
+                                                        "@param reset Whether to reset the statistics afterwards or not.  Optional: Defaults to false.\n"
+                                                        "@return The prefetches, releases, hits and misses as 'prefetches releases hits misses'.")
+{
+    const SceneAssetStreamer::StreamStats& stats = object->getAssetStreamer().getStats();
+
+    // Create Returnable Buffer.
+    char* pBuffer = Con::getReturnBuffer(64);
+
+    // Format Buffer.
+    dSprintf( pBuffer, 64, "%d %d %d %d", stats.mPrefetches, stats.mReleases, stats.mHits, stats.mMisses );
+
+    // Reset the statistics if requested.
+    if ( argc > 2 && dAtob(argv[2]) )
+        object->getAssetStreamer().resetStats();
+
+    // Return buffer.
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Scene, mergeScene, void, 3, 3,    "(scene) Merges the specified scene into this scene by cloning the scenes contents.")
 {
     // Find the specified scene.
@@ -22,6 +22,14 @@
 
 #include "2d/sceneobject/particlePlayer.h"
 
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+#ifndef _SIM_OBJECT_POOL_H_
+#include "sim/simObjectPool.h"
+#endif
+
 // Script bindings.
 #include "2d/sceneobject/particlePlayer_ScriptBinding.h"
 
@@ -83,6 +91,7 @@ void ParticlePlayer::EmitterNode::freeAllParticles( void )
 //------------------------------------------------------------------------------
 
 IMPLEMENT_CONOBJECT(ParticlePlayer);
+IMPLEMENT_SIMOBJECT_POOL(ParticlePlayer);
 
 //------------------------------------------------------------------------------
 
@@ -155,6 +164,35 @@ void ParticlePlayer::copyTo(SimObject* object)
 
 //------------------------------------------------------------------------------
 
+void ParticlePlayer::resetState( void )
+{
+    // Call parent.
+    Parent::resetState();
+
+    // Restore the constructed defaults.
+    // NOTE: The player is stopped first so destroying the asset does not perform callbacks.
+    mPlaying = false;
+    mPaused = false;
+    mAge = 0.0f;
+    mParticleInterpolation = false;
+    mCameraIdleDistance = 0.0f;
+    mCameraIdle = false;
+    mWaitingForParticles = false;
+    mWaitingForDelete = false;
+
+    // Fetch the particle player scales.
+    mEmissionRateScale = Con::getFloatVariable( PARTICLE_PLAYER_EMISSION_RATE_SCALE, 1.0f );
+    mSizeScale         = Con::getFloatVariable( PARTICLE_PLAYER_SIZE_SCALE, 1.0f );
+    mForceScale        = Con::getFloatVariable( PARTICLE_PLAYER_FORCE_SCALE, 1.0f );
+    mTimeScale         = Con::getFloatVariable( PARTICLE_PLAYER_TIME_SCALE, 1.0f );
+
+    // Destroy the particle asset.
+    destroyParticleAsset();
+    mParticleAsset.clear();
+}
+
+//------------------------------------------------------------------------------
+
 void ParticlePlayer::onAssetRefreshed( AssetPtrBase* pAssetPtrBase )
 {
     // Initialize the particle asset.
@@ -265,6 +303,9 @@ void ParticlePlayer::integrateObject( const F32 totalTime, const F32 elapsedTime
     // Call parent.
     Parent::integrateObject( totalTime, elapsedTime, pDebugStats );
 
+    // Account allocations made by the emitters to the particles.
+    MemoryTagScope memoryTagScope( MemoryAllocator::ParticlesTag );
+
     // Finish if no need to integrate.
     if (    !mPlaying ||
             mPaused ||
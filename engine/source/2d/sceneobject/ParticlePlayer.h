@@ -137,6 +137,7 @@ public:
 
     static void initPersistFields();
     virtual void copyTo(SimObject* object);
+    virtual void resetState( void );
     virtual void safeDelete( void );
 
     virtual void preIntegrate( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
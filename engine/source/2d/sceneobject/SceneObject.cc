@@ -68,6 +68,14 @@
 #include "string/stringUnit.h"
 #endif
 
+#ifndef _SIM_OBJECT_POOL_H_
+#include "sim/simObjectPool.h"
+#endif
+
+#ifndef _SMALL_VECTOR_H_
+#include "collection/smallVector.h"
+#endif
+
 // Script bindings.
 #include "SceneObject_ScriptBinding.h"
 
@@ -104,6 +112,7 @@ static StringTableEntry edgeTypeName            = StringTable->insert( "Edge" );
 SceneObject::SceneObject() :
     /// Scene.
     mpScene(NULL),
+    mSceneObjectIndex(-1),
     mpTargetScene(NULL),
 
     /// Lifetime.
@@ -196,6 +205,36 @@ SceneObject::SceneObject() :
     mSerialId = ++sSceneObjectMasterSerialId;
     sGlobalSceneObjectCount++;
 
+    // Initialize the physics definitions.
+    initializeDefinitions();
+
+    // Turn-off auto-sizing.
+    mAutoSizing = false;
+
+    // Set size.
+    setSize( Vector2::getOne() );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObject::~SceneObject()
+{
+    // Are we in a Scene?
+    if ( mpScene )
+    {
+        // Yes, so remove from Scene.
+        mpScene->removeFromScene( this );
+    }
+
+    // Decrease scene-object count if not idle in an object pool.
+    if ( mSerialId != 0 )
+        --sGlobalSceneObjectCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::initializeDefinitions( void )
+{
     // Initialize the body definition.
     // Important: If these defaults are changed then modify the associated "write" field protected methods to ensure
     // that the associated field is persisted if not the default.
@@ -226,27 +265,6 @@ SceneObject::SceneObject() :
 
     // Set last awake state.
     mLastAwakeState = !mBodyDefinition.allowSleep || mBodyDefinition.awake;
-
-    // Turn-off auto-sizing.
-    mAutoSizing = false;
-
-    // Set size.
-    setSize( Vector2::getOne() );
-}
-
-//-----------------------------------------------------------------------------
-
-SceneObject::~SceneObject()
-{
-    // Are we in a Scene?
-    if ( mpScene )
-    {
-        // Yes, so remove from Scene.
-        mpScene->removeFromScene( this );
-    }
-
-    // Decrease scene-object count.
-    --sGlobalSceneObjectCount;
 }
 
 //-----------------------------------------------------------------------------
@@ -371,6 +389,121 @@ void SceneObject::onDestroyNotify( SceneObject* pSceneObject )
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::onPoolRecycle()
+{
+    // Idle pooled objects have no scene-object index and are not counted.
+    mSerialId = 0;
+    --sGlobalSceneObjectCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::onPoolReuse()
+{
+    // Call parent.
+    Parent::onPoolReuse();
+
+    // Assign a new scene-object index as it is the render sort tie-break.
+    mSerialId = ++sSceneObjectMasterSerialId;
+    sGlobalSceneObjectCount++;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::resetState( void )
+{
+    // Sanity!
+    AssertFatal( mpScene == NULL, "SceneObject::resetState() - Object is still in a scene." );
+    AssertFatal( mpBody == NULL, "SceneObject::resetState() - Object still has a physics body." );
+
+    // Reset the parent state.
+    Parent::resetObjectState();
+
+    // Delete any offline collision shapes.
+    clearCollisionShapes();
+
+    // Restore the constructed defaults.
+    // Important: These must match the constructor.
+    mpTargetScene = NULL;
+    mSceneObjectIndex = -1;
+
+    mLifetime = 0.0f;
+    mLifetimeActive = false;
+
+    mSceneLayer = 0;
+    mSceneLayerMask = BIT(mSceneLayer);
+    mSceneLayerDepth = 0.0f;
+
+    mSceneGroup = 0;
+    mSceneGroupMask = BIT(mSceneGroup);
+
+    mWorldProxyId = -1;
+
+    mPreTickPosition.SetZero();
+    mPreTickAngle = 0.0f;
+    mRenderPosition.SetZero();
+    mRenderAngle = 0.0f;
+    mSpatialDirty = true;
+
+    mWorldQueryKey = 0;
+
+    mCollisionLayerMask = MASK_ALL;
+    mCollisionGroupMask = MASK_ALL;
+    mCollisionSuppress = false;
+    mGatherContacts = false;
+    delete mpCurrentContacts;
+    mpCurrentContacts = NULL;
+
+    mVisible = true;
+
+    mBlendMode = true;
+    mSrcBlendFactor = GL_SRC_ALPHA;
+    mDstBlendFactor = GL_ONE_MINUS_SRC_ALPHA;
+    mBlendColor.set( 1.0f, 1.0f, 1.0f, 1.0f );
+    mAlphaTest = -1.0f;
+
+    mSortPoint.SetZero();
+
+    mUseInputEvents = false;
+
+    mUpdateCallback = false;
+    mCollisionCallback = false;
+    mSleepingCallback = false;
+
+    mDebugMask = 0X00000000;
+
+    mpAttachedCamera = NULL;
+
+    mAttachedGuiSizeControl = false;
+    mpAttachedGui = NULL;
+    mpAttachedGuiSceneWindow = NULL;
+
+    mBeingSafeDeleted = false;
+    mSafeDeleteReady = true;
+
+    mDestroyNotifyList.clear();
+
+    mBatchIsolated = false;
+    mSerialiseKey = 0;
+    mEditorTickAllowed = true;
+    mPickingAllowed = true;
+    mAlwaysInScope = false;
+    mMoveToEventId = 0;
+    mRotateToEventId = 0;
+    mRenderGroup = StringTable->EmptyString;
+
+    // Initialize the physics definitions.
+    initializeDefinitions();
+
+    // Turn-off auto-sizing.
+    mAutoSizing = false;
+
+    // Set size.
+    setSize( Vector2::getOne() );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::OnRegisterScene( Scene* pScene )
 {
     // Sanity!
@@ -3151,7 +3284,7 @@ void SceneObject::safeDelete( void )
     else
     {
         // No, so use standard SimObject helper.
-        deleteObject();
+        recycleObject();
     }
 }
 
@@ -3640,7 +3773,7 @@ void SceneObject::onTamlCustomRead( const TamlCustomNodes& customNodes )
         else if ( shapeName == chainTypeName )
         {
             // Yes, so ready fields.
-            Vector<b2Vec2> points;
+            SmallVector<b2Vec2, 64> points;
             bool hasAdjacentStartPoint = false;
             bool hasAdjacentEndPoint = false;
             b2Vec2 adjacentStartPoint;
@@ -4470,3 +4603,4 @@ static void WriteCustomTamlSchema( const AbstractClassRep* pClassRep, TiXmlEleme
 //-----------------------------------------------------------------------------
 
 IMPLEMENT_CONOBJECT_SCHEMA(SceneObject, WriteCustomTamlSchema);
+IMPLEMENT_SIMOBJECT_POOL(SceneObject);
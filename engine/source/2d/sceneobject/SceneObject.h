@@ -67,6 +67,10 @@
 #include "component/behaviors/behaviorInstance.h"
 #endif
 
+#ifndef _FACTORY_CACHE_H_
+#include "memory/factoryCache.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 struct tDestroyNotification
@@ -97,7 +101,8 @@ extern EnumTable dstBlendFactorTable;
 class SceneObject :
     public BehaviorComponent,
     public SceneRenderObject,
-    public PhysicsProxy
+    public PhysicsProxy,
+    public virtual IFactoryObjectReset
 {
 
 private:
@@ -115,6 +120,7 @@ public:
 protected:
     /// Scene.
     SimObjectPtr<Scene>  mpScene;
+    S32                     mSceneObjectIndex;
 
     /// Target Scene.
     /// NOTE:   Unfortunately this is required as the scene can be set via a field which
@@ -235,6 +241,9 @@ protected:
     /// Contact processing.
     void                    initializeContactGathering( void );
 
+    /// Physics definitions.
+    void                    initializeDefinitions( void );
+
     /// Taml callbacks.
     virtual void            onTamlCustomWrite( TamlCustomNodes& customNodes );
     virtual void            onTamlCustomRead( const TamlCustomNodes& customNodes );
@@ -247,6 +256,9 @@ public:
     virtual bool            onAdd();
     virtual void            onRemove();
     virtual void            onDestroyNotify( SceneObject* pSceneObject );
+    virtual void            onPoolRecycle();
+    virtual void            onPoolReuse();
+    virtual void            resetState( void );
     static void             initPersistFields();
 
     /// Integration.
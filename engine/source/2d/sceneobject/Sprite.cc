@@ -32,12 +32,17 @@
 #include "string/stringBuffer.h"
 #endif
 
+#ifndef _SIM_OBJECT_POOL_H_
+#include "sim/simObjectPool.h"
+#endif
+
 // Script bindings.
 #include "Sprite_ScriptBinding.h"
 
 //------------------------------------------------------------------------------
 
 IMPLEMENT_CONOBJECT(Sprite);
+IMPLEMENT_SIMOBJECT_POOL(Sprite);
 
 //------------------------------------------------------------------------------
 
@@ -72,6 +77,18 @@ void Sprite::copyTo(SimObject* object)
 
 //------------------------------------------------------------------------------
 
+void Sprite::resetState( void )
+{
+    // Call parent.
+    Parent::resetState();
+
+    /// Render flipping.
+    mFlipX = false;
+    mFlipY = false;
+}
+
+//------------------------------------------------------------------------------
+
 void Sprite::initPersistFields()
 {
     // Call parent.
@@ -44,6 +44,7 @@ public:
 
     static void initPersistFields();
     virtual void copyTo(SimObject* object);
+    virtual void resetState( void );
 
     /// Render flipping.
     void setFlip( const bool flipX, const bool flipY )  { mFlipX = flipX; mFlipY = flipY; }
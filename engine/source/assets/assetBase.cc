@@ -45,9 +45,10 @@ IMPLEMENT_CONOBJECT( AssetBase );
 //-----------------------------------------------------------------------------
 
 AssetBase::AssetBase() :
-    mAcquireReferenceCount( 0 ),
     mpOwningAssetManager( NULL ),
-    mAssetInitialized( false )
+    mAssetInitialized( false ),
+    mAcquireReferenceCount( 0 ),
+    mPreloadCount( 0 )
 {
     // Generate an asset definition.
     mpAssetDefinition = new AssetDefinition();
@@ -311,7 +312,7 @@ bool AssetBase::releaseAssetReference( void )
 
 //-----------------------------------------------------------------------------
 
-void AssetBase::setOwned( AssetManager* pAssetManager, AssetDefinition* pAssetDefinition )
+void AssetBase::setOwned( AssetManager* pAssetManager, AssetDefinition* pAssetDefinition, const bool initialize )
 {  
     // Debug Profiling.
     PROFILE_SCOPE(AssetBase_setOwned);
@@ -335,9 +336,37 @@ void AssetBase::setOwned( AssetManager* pAssetManager, AssetDefinition* pAssetDe
     // NOTE: This must be done prior to initializing the asset so any initialization can assume ownership.
     mpOwningAssetManager = pAssetManager;
 
+    // Finish if initialization is deferred.
+    if ( !initialize )
+        return;
+
+    // Initialize the asset.
+    initializeOwnedAsset();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetBase::initializeOwnedAsset( void )
+{
+    // Sanity!
+    AssertFatal( mpOwningAssetManager != NULL, "Cannot initialize an asset that is not owned." );
+    AssertFatal( !mAssetInitialized, "Cannot initialize an asset that is already initialized." );
+
     // Initialize the asset.
     initializeAsset();
 
     // Flag asset as initialized.
     mAssetInitialized = true;
 }
+
+//-----------------------------------------------------------------------------
+
+void AssetBase::endPreload( void )
+{
+    // Sanity!
+    AssertFatal( mPreloadCount > 0, "Asset preload ended without being started." );
+
+    // Notify the asset manager once the last preload has ended.
+    if ( --mPreloadCount == 0 && mpOwningAssetManager != NULL )
+        mpOwningAssetManager->onAssetPreloaded( this );
+}
@@ -60,6 +60,7 @@ class AssetBase : public SimObject
     bool                    mAssetInitialized;
     AssetDefinition*        mpAssetDefinition;
     U32                     mAcquireReferenceCount;
+    U32                     mPreloadCount;
 
 public:
     AssetBase();
@@ -95,6 +96,9 @@ public:
 
     virtual bool            isAssetValid( void ) const                          { return true; }
 
+    /// An estimate of the memory held by the loaded asset, used to budget idle assets.
+    virtual U32             getAssetMemorySize( void ) const                    { return 0; }
+
     void                    refreshAsset( void );
 
     /// Declare Console Object.
@@ -104,6 +108,14 @@ protected:
     virtual void            initializeAsset( void ) {}
     virtual void            onAssetRefresh( void ) {}
 
+    /// Called when the asset is acquired asynchronously, once it is owned but before it is initialized.
+    /// Each piece of work the asset starts on the thread pool must be counted with beginPreload()
+    /// and reported with endPreload() on the main thread.  Initialization waits for all of it.
+    virtual void            preloadAsset( void ) {}
+    inline void             beginPreload( void )                                { mPreloadCount++; }
+    void                    endPreload( void );
+    inline bool             isPreloading( void ) const                          { return mPreloadCount > 0; }
+
 protected:
     static bool             setAssetName(void* obj, const char* data)           { static_cast<AssetBase*>(obj)->setAssetName( data ); return false; }
     static const char*      getAssetName(void* obj, const char* data)           { return static_cast<AssetBase*>(obj)->getAssetName(); }
@@ -132,7 +144,9 @@ private:
     bool                    releaseAssetReference( void );
 
     /// Set asset manager ownership.
-    void                    setOwned( AssetManager* pAssetManager, AssetDefinition* pAssetDefinition );
+    /// Initialization can be deferred, as it is when the asset is preloaded, with initializeOwnedAsset().
+    void                    setOwned( AssetManager* pAssetManager, AssetDefinition* pAssetDefinition, const bool initialize = true );
+    void                    initializeOwnedAsset( void );
 };
 
 #endif // _ASSET_BASE_H_
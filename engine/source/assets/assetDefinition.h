@@ -51,6 +51,7 @@ public:
     virtual void reset( void )
     {
         mAssetLoading = false;
+        mAssetIdle = false;
         mpModuleDefinition = NULL;
         mpAssetBase = NULL;
         mAssetBaseFilePath = StringTable->EmptyString;
@@ -86,6 +87,7 @@ public:
     bool                        mAssetInternal; 
     bool                        mAssetPrivate;
     bool                        mAssetLoading;
+    bool                        mAssetIdle;
     StringTableEntry            mAssetType;
     StringTableEntry            mAssetCategory;
 };
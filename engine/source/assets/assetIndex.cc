@@ -0,0 +1,325 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _ASSET_INDEX_H_
+#include "assets/assetIndex.h"
+#endif
+
+#ifndef _TAML_ASSET_DECLARED_VISITOR_H_
+#include "assets/tamlAssetDeclaredVisitor.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+/// The longest string stored in the index, which covers file paths and descriptions.
+static const U32 sMaxIndexStringLength = 1023;
+
+//-----------------------------------------------------------------------------
+
+static StringTableEntry readIndexString( Stream& stream )
+{
+    char stringBuffer[sMaxIndexStringLength + 1];
+    stringBuffer[0] = 0;
+    stream.readLongString( sMaxIndexStringLength, stringBuffer );
+    return StringTable->insert( stringBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+static void writeIndexString( Stream& stream, const char* pString )
+{
+    stream.writeLongString( sMaxIndexStringLength, pString );
+}
+
+//-----------------------------------------------------------------------------
+
+AssetIndex::AssetIndex() :
+    mRestoredCount( 0 ),
+    mStoredCount( 0 ),
+    mDirty( false )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+AssetIndex::~AssetIndex()
+{
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetIndex::clear( void )
+{
+    for ( typeEntryHash::iterator entryItr = mEntries.begin(); entryItr != mEntries.end(); ++entryItr )
+        delete entryItr->value;
+
+    mEntries.clear();
+    mRestoredCount = 0;
+    mStoredCount = 0;
+    mDirty = false;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetIndex::load( const char* pIndexFilePath )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetIndex_Load);
+
+    // Discard any existing entries.
+    clear();
+
+    // Open the index.
+    FileStream stream;
+    if ( !stream.open( pIndexFilePath, FileStream::Read ) )
+        return false;
+
+    // Check the signature, version and the platform file time size.
+    StringTableEntry indexSignature = stream.readSTString();
+    U32 versionId = 0;
+    U32 fileTimeSize = 0;
+    stream.read( &versionId );
+    stream.read( &fileTimeSize );
+
+    if ( indexSignature != StringTable->insert( ASSET_INDEX_SIGNATURE ) || versionId != IndexVersion || fileTimeSize != sizeof(FileTime) )
+    {
+        stream.close();
+        return false;
+    }
+
+    // Read the entries.
+    U32 entryCount = 0;
+    stream.read( &entryCount );
+
+    for ( U32 entryIndex = 0; entryIndex < entryCount && stream.getStatus() == Stream::Ok; ++entryIndex )
+    {
+        Entry* pEntry = new Entry();
+        pEntry->mUsed = false;
+        pEntry->mAssetFilePath = readIndexString( stream );
+        stream.read( &pEntry->mFileSize );
+        stream.read( sizeof(FileTime), &pEntry->mModifyTime );
+        pEntry->mAssetName = readIndexString( stream );
+        pEntry->mAssetDescription = readIndexString( stream );
+        pEntry->mAssetCategory = readIndexString( stream );
+        pEntry->mAssetType = readIndexString( stream );
+        stream.read( &pEntry->mAssetAutoUnload );
+        stream.read( &pEntry->mAssetInternal );
+
+        U32 dependencyCount = 0;
+        stream.read( &dependencyCount );
+        for ( U32 index = 0; index < dependencyCount && stream.getStatus() == Stream::Ok; ++index )
+            pEntry->mAssetDependencies.push_back( readIndexString( stream ) );
+
+        U32 looseFileCount = 0;
+        stream.read( &looseFileCount );
+        for ( U32 index = 0; index < looseFileCount && stream.getStatus() == Stream::Ok; ++index )
+            pEntry->mAssetLooseFiles.push_back( readIndexString( stream ) );
+
+        // Replace any duplicate.
+        typeEntryHash::iterator entryItr = mEntries.find( pEntry->mAssetFilePath );
+        if ( entryItr != mEntries.end() )
+        {
+            delete entryItr->value;
+            mEntries.erase( entryItr );
+        }
+
+        mEntries.insert( pEntry->mAssetFilePath, pEntry );
+    }
+
+    // Was the index truncated or corrupt?
+    const bool loaded = stream.getStatus() == Stream::Ok || stream.getStatus() == Stream::EOS;
+    stream.close();
+
+    if ( !loaded )
+    {
+        // Yes, so discard it.
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetIndex::save( const char* pIndexFilePath )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetIndex_Save);
+
+    // Drop the entries for files that have gone.
+    for ( typeEntryHash::iterator entryItr = mEntries.begin(); entryItr != mEntries.end(); )
+    {
+        typeEntryHash::iterator currentItr = entryItr++;
+
+        if ( currentItr->value->mUsed )
+            continue;
+
+        delete currentItr->value;
+        mEntries.erase( currentItr );
+        mDirty = true;
+    }
+
+    // Finish if nothing changed.
+    if ( !mDirty )
+        return true;
+
+    // Create the index directory.
+    if ( !Platform::createPath( pIndexFilePath ) )
+        return false;
+
+    // Open the index.
+    FileStream stream;
+    if ( !stream.open( pIndexFilePath, FileStream::Write ) )
+        return false;
+
+    // Write the signature, version and the platform file time size.
+    stream.writeString( ASSET_INDEX_SIGNATURE );
+    stream.write( (U32)IndexVersion );
+    stream.write( (U32)sizeof(FileTime) );
+
+    // Write the entries.
+    stream.write( (U32)mEntries.size() );
+
+    for ( typeEntryHash::iterator entryItr = mEntries.begin(); entryItr != mEntries.end(); ++entryItr )
+    {
+        const Entry* pEntry = entryItr->value;
+
+        writeIndexString( stream, pEntry->mAssetFilePath );
+        stream.write( pEntry->mFileSize );
+        stream.write( sizeof(FileTime), &pEntry->mModifyTime );
+        writeIndexString( stream, pEntry->mAssetName );
+        writeIndexString( stream, pEntry->mAssetDescription );
+        writeIndexString( stream, pEntry->mAssetCategory );
+        writeIndexString( stream, pEntry->mAssetType );
+        stream.write( pEntry->mAssetAutoUnload );
+        stream.write( pEntry->mAssetInternal );
+
+        stream.write( (U32)pEntry->mAssetDependencies.size() );
+        for ( S32 index = 0; index < pEntry->mAssetDependencies.size(); ++index )
+            writeIndexString( stream, pEntry->mAssetDependencies[index] );
+
+        stream.write( (U32)pEntry->mAssetLooseFiles.size() );
+        for ( S32 index = 0; index < pEntry->mAssetLooseFiles.size(); ++index )
+            writeIndexString( stream, pEntry->mAssetLooseFiles[index] );
+    }
+
+    const bool saved = stream.getStatus() == Stream::Ok;
+    stream.close();
+
+    mDirty = !saved;
+
+    return saved;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetIndex::restore( const char* pAssetFilePath, const U32 fileSize, TamlAssetDeclaredVisitor& assetDeclaredVisitor )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetIndex_Restore);
+
+    // Find the entry.
+    typeEntryHash::iterator entryItr = mEntries.find( StringTable->insert( pAssetFilePath ) );
+    if ( entryItr == mEntries.end() )
+        return false;
+
+    Entry* pEntry = entryItr->value;
+
+    // Finish if the file has changed.
+    FileTime modifyTime;
+    if ( pEntry->mFileSize != fileSize ||
+        !Platform::getFileTimes( pAssetFilePath, NULL, &modifyTime ) ||
+        Platform::compareFileTimes( pEntry->mModifyTime, modifyTime ) != 0 )
+        return false;
+
+    // Restore the declaration.
+    AssetDefinition& assetDefinition = assetDeclaredVisitor.getAssetDefinition();
+    assetDefinition.mAssetBaseFilePath = pEntry->mAssetFilePath;
+    assetDefinition.mAssetName = pEntry->mAssetName;
+    assetDefinition.mAssetDescription = pEntry->mAssetDescription;
+    assetDefinition.mAssetCategory = pEntry->mAssetCategory;
+    assetDefinition.mAssetType = pEntry->mAssetType;
+    assetDefinition.mAssetAutoUnload = pEntry->mAssetAutoUnload;
+    assetDefinition.mAssetInternal = pEntry->mAssetInternal;
+    assetDeclaredVisitor.getAssetDependencies() = pEntry->mAssetDependencies;
+    assetDeclaredVisitor.getAssetLooseFiles() = pEntry->mAssetLooseFiles;
+
+    pEntry->mUsed = true;
+    mRestoredCount++;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetIndex::store( const char* pAssetFilePath, const U32 fileSize, TamlAssetDeclaredVisitor& assetDeclaredVisitor )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetIndex_Store);
+
+    // Fetch the file time.
+    // NOTE: The file is not indexed if its time is unavailable as it could never be restored.
+    FileTime modifyTime;
+    if ( !Platform::getFileTimes( pAssetFilePath, NULL, &modifyTime ) )
+        return;
+
+    // Find or create the entry.
+    StringTableEntry assetFilePath = StringTable->insert( pAssetFilePath );
+    Entry* pEntry;
+    typeEntryHash::iterator entryItr = mEntries.find( assetFilePath );
+    if ( entryItr != mEntries.end() )
+    {
+        pEntry = entryItr->value;
+    }
+    else
+    {
+        pEntry = new Entry();
+        pEntry->mAssetFilePath = assetFilePath;
+        mEntries.insert( assetFilePath, pEntry );
+    }
+
+    // Store the declaration.
+    const AssetDefinition& assetDefinition = assetDeclaredVisitor.getAssetDefinition();
+    pEntry->mFileSize = fileSize;
+    pEntry->mModifyTime = modifyTime;
+    pEntry->mUsed = true;
+    pEntry->mAssetName = assetDefinition.mAssetName;
+    pEntry->mAssetDescription = assetDefinition.mAssetDescription;
+    pEntry->mAssetCategory = assetDefinition.mAssetCategory;
+    pEntry->mAssetType = assetDefinition.mAssetType;
+    pEntry->mAssetAutoUnload = assetDefinition.mAssetAutoUnload;
+    pEntry->mAssetInternal = assetDefinition.mAssetInternal;
+    pEntry->mAssetDependencies = assetDeclaredVisitor.getAssetDependencies();
+    pEntry->mAssetLooseFiles = assetDeclaredVisitor.getAssetLooseFiles();
+
+    mStoredCount++;
+    mDirty = true;
+}
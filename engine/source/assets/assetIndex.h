@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _ASSET_INDEX_H_
+#define _ASSET_INDEX_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class TamlAssetDeclaredVisitor;
+
+//-----------------------------------------------------------------------------
+
+#define ASSET_INDEX_SIGNATURE       "AssetIndex"
+#define ASSET_INDEX_EXTENSION       "index"
+
+//-----------------------------------------------------------------------------
+
+/// A persistent index of the asset declarations found in a declared assets path.
+///
+/// Each entry holds what TamlAssetDeclaredVisitor parsed from an asset file
+/// along with the size and modified time the file had at the time.  When the
+/// path is scanned again an unchanged file is restored from its entry instead
+/// of being parsed.  Entries for files that were not restored or stored during
+/// the scan are dropped when the index is saved.
+class AssetIndex
+{
+public:
+    /// The index format version.  Indexes with any other version are ignored.
+    enum { IndexVersion = 1 };
+
+    AssetIndex();
+    ~AssetIndex();
+
+    /// Loads the index, discarding any entries already present.
+    /// @return Whether the index was loaded or not.  A missing or outdated index is not an error.
+    bool load( const char* pIndexFilePath );
+
+    /// Saves the entries used since the index was loaded.  Nothing is written if they are unchanged.
+    bool save( const char* pIndexFilePath );
+
+    /// Restores the asset declaration of the file into the visitor if the file is unchanged.
+    /// @return Whether the declaration was restored or not.
+    bool restore( const char* pAssetFilePath, const U32 fileSize, TamlAssetDeclaredVisitor& assetDeclaredVisitor );
+
+    /// Stores the asset declaration the visitor parsed from the file.
+    void store( const char* pAssetFilePath, const U32 fileSize, TamlAssetDeclaredVisitor& assetDeclaredVisitor );
+
+    void clear( void );
+
+    inline U32 getEntryCount( void ) const      { return (U32)mEntries.size(); }
+    inline U32 getRestoredCount( void ) const   { return mRestoredCount; }
+    inline U32 getStoredCount( void ) const     { return mStoredCount; }
+
+private:
+    struct Entry
+    {
+        StringTableEntry            mAssetFilePath;
+        U32                         mFileSize;
+        FileTime                    mModifyTime;
+        bool                        mUsed;
+
+        StringTableEntry            mAssetName;
+        StringTableEntry            mAssetDescription;
+        StringTableEntry            mAssetCategory;
+        StringTableEntry            mAssetType;
+        bool                        mAssetAutoUnload;
+        bool                        mAssetInternal;
+        Vector<StringTableEntry>    mAssetDependencies;
+        Vector<StringTableEntry>    mAssetLooseFiles;
+    };
+
+    typedef HashMap<StringTableEntry, Entry*> typeEntryHash;
+
+    typeEntryHash   mEntries;
+    U32             mRestoredCount;
+    U32             mStoredCount;
+    bool            mDirty;
+};
+
+#endif // _ASSET_INDEX_H_
@@ -54,6 +54,26 @@
 #include "console/consoleTypes.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+#ifndef _FRAME_COUNTERS_H_
+#include "debug/frameCounters.h"
+#endif
+
+#ifndef _ASSET_INDEX_H_
+#include "assets/assetIndex.h"
+#endif
+
+#ifndef _DECLARED_ASSETS_SCAN_H_
+#include "assets/declaredAssetsScan.h"
+#endif
+
+#ifndef _TEXTURE_MANAGER_H_
+#include "graphics/TextureManager.h"
+#endif
+
 // Script bindings.
 #include "assetManager_ScriptBinding.h"
 
@@ -67,16 +87,51 @@ AssetManager AssetDatabase;
 
 //-----------------------------------------------------------------------------
 
+static F32 sampleIdleAssetCount( void ) { return (F32)AssetDatabase.getIdleAssetCount(); }
+static F32 sampleIdleAssetKB( void ) { return AssetDatabase.getIdleAssetMemory() / 1024.0f; }
+
+static FrameCounter sIdleAssetCounter( "assets.idle", sampleIdleAssetCount );
+static FrameCounter sIdleAssetKBCounter( "assets.idleKB", sampleIdleAssetKB );
+static FrameCounter sAssetCacheHitsCounter( "assets.cacheHits" );
+static FrameCounter sAssetCacheMissesCounter( "assets.cacheMisses" );
+static FrameCounter sAssetCacheEvictionsCounter( "assets.cacheEvictions" );
+
+//-----------------------------------------------------------------------------
+
+/// Completes all work on the thread pool along with the texture uploads it queues.
+/// Uploads can start more work so both are repeated until neither has any left.
+static void flushBackgroundWork( void )
+{
+    if ( ThreadPool::getGlobal() == NULL )
+        return;
+
+    do
+    {
+        ThreadPool::getGlobal()->flush();
+    }
+    while ( TextureManager::flushUploads() > 0 );
+}
+
+//-----------------------------------------------------------------------------
+
 AssetManager::AssetManager() :
+    mAsyncAssetLoadsStarted( 0 ),
+    mAsyncAssetLoadsFinished( 0 ),
+    mIdleAssetBudget( 0 ),
+    mIdleAssetMemory( 0 ),
+    mAssetCacheHits( 0 ),
+    mAssetCacheMisses( 0 ),
+    mAssetCacheEvictions( 0 ),
+    mEchoInfo( false ),
+    mIgnoreAutoUnload( false ),
+    mUseAssetIndex( true ),
     mLoadedInternalAssetsCount( 0 ),
     mLoadedExternalAssetsCount( 0 ),
     mLoadedPrivateAssetsCount( 0 ),
+    mAcquiredReferenceCount( 0 ),
     mMaxLoadedInternalAssetsCount( 0 ),
     mMaxLoadedExternalAssetsCount( 0 ),
-    mMaxLoadedPrivateAssetsCount( 0 ),
-    mAcquiredReferenceCount( 0 ),
-    mEchoInfo( false ),
-    mIgnoreAutoUnload( false )
+    mMaxLoadedPrivateAssetsCount( 0 )
 {
 }
 
@@ -95,6 +150,16 @@ bool AssetManager::onAdd()
 
 void AssetManager::onRemove()
 {
+    // Finish any asynchronous loads so their callbacks are not lost.
+    if ( mAsyncAssetLoads.size() > 0 )
+        flushBackgroundWork();
+
+    // Discard any declared assets scanned ahead of their module loading.
+    cancelDeclaredAssetsPrefetches( NULL );
+
+    // Unload any idle assets.
+    setIdleAssetBudget( 0 );
+
     // Do we have an asset tags manifest?
     if ( !mAssetTagsManifest.isNull() )
     {
@@ -115,6 +180,7 @@ void AssetManager::initPersistFields()
 
     addField( "EchoInfo", TypeBool, Offset(mEchoInfo, AssetManager), "Whether the asset manager echos extra information to the console or not." );
     addField( "IgnoreAutoUnload", TypeBool, Offset(mIgnoreAutoUnload, AssetManager), "Whether the asset manager should ignore unloading of auto-unload assets or not." );
+    addField( "UseAssetIndex", TypeBool, Offset(mUseAssetIndex, AssetManager), "Whether the asset manager keeps an index of the declared assets of each module so unchanged asset files are not parsed when the module is loaded again." );
 }
 
 //-----------------------------------------------------------------------------
@@ -170,6 +236,9 @@ bool AssetManager::addModuleDeclaredAssets( ModuleDefinition* pModuleDefinition
     {
         // Yes, so warn.
         Con::warnf( "Asset Manager: Cannot add declared assets to module '%s' as it already has existing assets.", pModuleDefinition->getSignature() );
+
+        // Discard any declared assets scanned ahead.
+        cancelDeclaredAssetsPrefetches( pModuleDefinition );
         return false;
     }
 
@@ -187,8 +256,35 @@ bool AssetManager::addModuleDeclaredAssets( ModuleDefinition* pModuleDefinition
         char filePathBuffer[1024];
         dSprintf( filePathBuffer, sizeof(filePathBuffer), "%s/%s", pModuleDefinition->getModulePath(), pDeclaredAssets->getPath() );
 
+        // Was the location scanned ahead of the module loading?
+        const S32 prefetchIndex = findDeclaredAssetsPrefetch( pModuleDefinition, pDeclaredAssets );
+        if ( prefetchIndex >= 0 )
+        {
+            // Yes, so take the prefetch.
+            DeclaredAssetsPrefetch* pDeclaredAssetsPrefetch = mDeclaredAssetsPrefetches[prefetchIndex];
+            mDeclaredAssetsPrefetches.erase( prefetchIndex );
+
+            // Wait for the scan to finish.
+            finishDeclaredAssetsPrefetch( pDeclaredAssetsPrefetch );
+            const bool scanComplete = pDeclaredAssetsPrefetch->mScanComplete;
+
+            // Add the scanned declared assets.
+            if ( scanComplete && !addScannedDeclaredAssets( *pDeclaredAssetsPrefetch->mpDeclaredAssetsScan, pModuleDefinition ) )
+            {
+                // Warn.
+                Con::warnf( "AssetManager::addModuleDeclaredAssets() - Could not scan for declared assets at location '%s' with extension '%s'.", filePathBuffer, pDeclaredAssets->getExtension() );
+            }
+
+            delete pDeclaredAssetsPrefetch->mpDeclaredAssetsScan;
+            delete pDeclaredAssetsPrefetch;
+
+            // Skip the scan below if it was done ahead.
+            if ( scanComplete )
+                continue;
+        }
+
         // Scan declared assets at location.
-        if ( !scanDeclaredAssets( filePathBuffer, pDeclaredAssets->getExtension(), pDeclaredAssets->getRecurse(), pModuleDefinition ) )
+        if ( !scanDeclaredAssets( filePathBuffer, pDeclaredAssets->getExtension(), pDeclaredAssets->getRecurse(), pModuleDefinition, mUseAssetIndex ) )
         {
             // Warn.
             Con::warnf( "AssetManager::addModuleDeclaredAssets() - Could not scan for declared assets at location '%s' with extension '%s'.", filePathBuffer, pDeclaredAssets->getExtension() );
@@ -383,6 +479,13 @@ bool AssetManager::removeDeclaredAsset( const char* pAssetId )
         removeAssetDependencies( pAssetId );
     }
 
+    // Is the asset idle?
+    if ( pAssetDefinition->mAssetIdle )
+    {
+        // Yes, so remove it from the idle assets.
+        removeIdleAsset( pAssetDefinition );
+    }
+
     // Do we have an asset loaded?
     if ( pAssetDefinition->mpAssetBase.notNull() )
     {
@@ -931,6 +1034,18 @@ bool AssetManager::releaseAsset( const char* pAssetId )
                 Con::printf( "Asset Manager: > Releasing to idle state." );
             }
         }
+        // Can the asset be cached as idle?
+        else if ( mIdleAssetBudget > 0 && !pAssetDefinition->mAssetPrivate )
+        {
+            // Yes, so info.
+            if ( mEchoInfo )
+            {
+                Con::printf( "Asset Manager: > Releasing to the idle asset cache." );
+            }
+
+            // Cache the asset.
+            addIdleAsset( pAssetDefinition );
+        }
         else
         {
             // No, so info.
@@ -961,6 +1076,409 @@ bool AssetManager::releaseAsset( const char* pAssetId )
 
 //-----------------------------------------------------------------------------
 
+void AssetManager::setIdleAssetBudget( const U32 budget )
+{
+    mIdleAssetBudget = budget;
+
+    // Unload any idle assets that no longer fit.
+    evictIdleAssets();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::resetAssetCacheStats( void )
+{
+    mAssetCacheHits = 0;
+    mAssetCacheMisses = 0;
+    mAssetCacheEvictions = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::addIdleAsset( AssetDefinition* pAssetDefinition )
+{
+    // Finish if the asset is already idle.
+    if ( pAssetDefinition->mAssetIdle )
+        return;
+
+    // Add as the most recently used.
+    IdleAsset idleAsset;
+    idleAsset.mpAssetDefinition = pAssetDefinition;
+    idleAsset.mMemorySize = pAssetDefinition->mpAssetBase->getAssetMemorySize();
+    mIdleAssets.push_back( idleAsset );
+    mIdleAssetMemory += idleAsset.mMemorySize;
+    pAssetDefinition->mAssetIdle = true;
+
+    // Unload the least recently used if over the budget.
+    evictIdleAssets();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::removeIdleAsset( AssetDefinition* pAssetDefinition )
+{
+    for ( typeIdleAssetVector::iterator idleItr = mIdleAssets.begin(); idleItr != mIdleAssets.end(); ++idleItr )
+    {
+        if ( idleItr->mpAssetDefinition != pAssetDefinition )
+            continue;
+
+        mIdleAssetMemory -= idleItr->mMemorySize;
+        mIdleAssets.erase( idleItr );
+        break;
+    }
+
+    pAssetDefinition->mAssetIdle = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::evictIdleAssets( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_EvictIdleAssets);
+
+    while ( mIdleAssets.size() > 0 && (mIdleAssetBudget == 0 || mIdleAssetMemory > mIdleAssetBudget) )
+    {
+        // Fetch the least recently used.
+        AssetDefinition* pAssetDefinition = mIdleAssets.first().mpAssetDefinition;
+
+        // Info.
+        if ( mEchoInfo )
+        {
+            Con::printf( "Asset Manager: Evicting idle Asset Id '%s'.", pAssetDefinition->mAssetId );
+        }
+
+        // Unload the asset.  This removes it from the idle assets.
+        unloadAsset( pAssetDefinition );
+
+        mAssetCacheEvictions++;
+        sAssetCacheEvictionsCounter.increment();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::onAssetCacheMiss( void )
+{
+    mAssetCacheMisses++;
+    sAssetCacheMissesCounter.increment();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::onAssetCacheHit( void )
+{
+    mAssetCacheHits++;
+    sAssetCacheHitsCounter.increment();
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetManager::acquireAssetAsync( const char* pAssetId, AssetLoadCallback* pCallback )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_AcquireAssetAsync);
+
+    // Sanity!
+    AssertFatal( pAssetId != NULL, "Cannot acquire NULL asset Id." );
+    AssertFatal( pCallback != NULL, "Cannot acquire an asset asynchronously without a callback." );
+
+    // Find asset.
+    AssetDefinition* pAssetDefinition = findAsset( pAssetId );
+
+    // Did we find the asset?
+    if ( pAssetDefinition == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Asset Manager: Failed to acquire asset Id '%s' asynchronously as it does not exist.", pAssetId );
+        return false;
+    }
+
+    // Queue the asset and any dependencies that are not loaded.
+    Vector<typeAssetId> resolvingAssets;
+    Vector<typeAssetId> queuedAssets;
+    AsyncAssetLoad* pAsyncAssetLoad = queueAsyncAssetLoad( pAssetDefinition, resolvingAssets, queuedAssets );
+
+    // Is the asset already loaded?
+    if ( pAsyncAssetLoad == NULL )
+    {
+        // Yes, so acquire it now.
+        pCallback->onAssetLoaded( pAssetDefinition->mAssetId, acquireAsset<AssetBase>( pAssetId ) );
+        return true;
+    }
+
+    pAsyncAssetLoad->mCallbacks.push_back( pCallback );
+
+    // Start the queued loads that are not waiting for dependencies.
+    // NOTE: Starting a load can finish it and start its dependents so each is looked up again.
+    for ( S32 index = 0; index < queuedAssets.size(); ++index )
+    {
+        typeAsyncAssetLoadHash::iterator loadItr = mAsyncAssetLoads.find( queuedAssets[index] );
+
+        if ( loadItr != mAsyncAssetLoads.end() && !loadItr->value->mStarted && loadItr->value->mPendingDependencies == 0 )
+            startAsyncAssetLoad( loadItr->value );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+F32 AssetManager::getAsyncAssetLoadProgress( void ) const
+{
+    // Finish if nothing is loading.
+    if ( mAsyncAssetLoadsStarted == 0 )
+        return 1.0f;
+
+    return (F32)mAsyncAssetLoadsFinished / (F32)mAsyncAssetLoadsStarted;
+}
+
+//-----------------------------------------------------------------------------
+
+AssetManager::AsyncAssetLoad* AssetManager::queueAsyncAssetLoad( AssetDefinition* pAssetDefinition, Vector<typeAssetId>& resolvingAssets, Vector<typeAssetId>& queuedAssets )
+{
+    // Fetch asset Id.
+    StringTableEntry assetId = pAssetDefinition->mAssetId;
+
+    // Is the asset already being loaded?
+    typeAsyncAssetLoadHash::iterator loadItr = mAsyncAssetLoads.find( assetId );
+    if ( loadItr != mAsyncAssetLoads.end() )
+        return loadItr->value;
+
+    // Finish if the asset is already loaded.
+    if ( pAssetDefinition->mpAssetBase != NULL )
+        return NULL;
+
+    // Create the load.
+    AsyncAssetLoad* pAsyncAssetLoad = new AsyncAssetLoad();
+    pAsyncAssetLoad->mAssetId = assetId;
+    pAsyncAssetLoad->mpAssetDefinition = pAssetDefinition;
+    pAsyncAssetLoad->mPendingDependencies = 0;
+    pAsyncAssetLoad->mStarted = false;
+    mAsyncAssetLoads.insert( assetId, pAsyncAssetLoad );
+    queuedAssets.push_back( assetId );
+    mAsyncAssetLoadsStarted++;
+
+    // Flag asset as loading.
+    pAssetDefinition->mAssetLoading = true;
+
+    // Queue the asset dependencies so they are loaded first.
+    resolvingAssets.push_back( assetId );
+
+    for( typeAssetDependsOnHash::iterator assetDependenciesItr = mAssetDependsOn.find( assetId ); assetDependenciesItr != mAssetDependsOn.end() && assetDependenciesItr->key == assetId; ++assetDependenciesItr )
+    {
+        // Skip cyclic dependencies.  Acquiring the asset will report them.
+        if ( resolvingAssets.contains( assetDependenciesItr->value ) )
+            continue;
+
+        // Skip dependencies that do not exist.
+        AssetDefinition* pDependencyDefinition = findAsset( assetDependenciesItr->value );
+        if ( pDependencyDefinition == NULL )
+            continue;
+
+        // Queue the dependency and wait for it unless it is already loaded.
+        AsyncAssetLoad* pDependencyLoad = queueAsyncAssetLoad( pDependencyDefinition, resolvingAssets, queuedAssets );
+        if ( pDependencyLoad == NULL )
+            continue;
+
+        pDependencyLoad->mDependents.push_back( pAsyncAssetLoad );
+        pAsyncAssetLoad->mPendingDependencies++;
+    }
+
+    resolvingAssets.pop_back();
+
+    return pAsyncAssetLoad;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::startAsyncAssetLoad( AsyncAssetLoad* pAsyncAssetLoad )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_StartAsyncAssetLoad);
+
+    // Sanity!
+    AssertFatal( !pAsyncAssetLoad->mStarted, "Asynchronous asset load has already started." );
+    AssertFatal( pAsyncAssetLoad->mPendingDependencies == 0, "Asynchronous asset load is still waiting for dependencies." );
+
+    pAsyncAssetLoad->mStarted = true;
+
+    // Fetch asset definition.
+    AssetDefinition* pAssetDefinition = pAsyncAssetLoad->mpAssetDefinition;
+
+    // Count the load.
+    onAssetCacheMiss();
+
+    // Info.
+    if ( mEchoInfo )
+    {
+        Con::printSeparator();
+        Con::printf( "Asset Manager: Started acquiring Asset Id '%s' asynchronously...", pAsyncAssetLoad->mAssetId );
+    }
+
+    // Generate primary asset.
+    // NOTE: The dependencies are loaded by now so any the asset acquires are found immediately.
+    AssetBase* pAssetBase = mTaml.read<AssetBase>( pAssetDefinition->mAssetBaseFilePath );
+
+    // Release the dependencies held for the asset now it has acquired them itself.
+    for ( S32 index = 0; index < pAsyncAssetLoad->mHeldDependencies.size(); ++index )
+        releaseAsset( pAsyncAssetLoad->mHeldDependencies[index] );
+    pAsyncAssetLoad->mHeldDependencies.clear();
+
+    // Did we generate the asset?
+    if ( pAssetBase == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Asset Manager: > Failed to acquire asset Id '%s' as loading the asset file failed to return the asset or the correct asset type: '%s'.",
+            pAsyncAssetLoad->mAssetId, pAssetDefinition->mAssetBaseFilePath );
+
+        completeAsyncAssetLoad( pAsyncAssetLoad, NULL );
+        return;
+    }
+
+    pAssetDefinition->mpAssetBase = pAssetBase;
+
+    // Increase loaded count.
+    pAssetDefinition->mAssetLoadedCount++;
+
+    // Info.
+    if ( mEchoInfo )
+    {
+        Con::printf( "Asset Manager: > Loading asset into memory as object Id '%d' from file '%s'.",
+            pAssetBase->getId(), pAssetDefinition->mAssetBaseFilePath );
+    }
+
+    // Set ownership by asset manager but defer the initialization until the asset has preloaded.
+    pAssetBase->setOwned( this, pAssetDefinition, false );
+
+    // Is the asset internal?
+    if ( pAssetDefinition->mAssetInternal )
+    {
+        // Yes, so increase internal loaded asset count.
+        if ( ++mLoadedInternalAssetsCount > mMaxLoadedInternalAssetsCount )
+            mMaxLoadedInternalAssetsCount = mLoadedInternalAssetsCount;
+    }
+    else
+    {
+        // No, so increase external loaded assets count.
+        if ( ++mLoadedExternalAssetsCount > mMaxLoadedExternalAssetsCount )
+            mMaxLoadedExternalAssetsCount = mLoadedExternalAssetsCount;
+    }
+
+    // Hold the asset while it loads.
+    pAssetBase->acquireAssetReference();
+
+    // Start any work the asset can do on the thread pool.
+    pAssetBase->preloadAsset();
+
+    // Finish now if the asset has nothing to wait for.
+    if ( !pAssetBase->isPreloading() )
+        completeAsyncAssetLoad( pAsyncAssetLoad, pAssetBase );
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::completeAsyncAssetLoad( AsyncAssetLoad* pAsyncAssetLoad, AssetBase* pAssetBase )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_CompleteAsyncAssetLoad);
+
+    // Fetch asset Id.
+    StringTableEntry assetId = pAsyncAssetLoad->mAssetId;
+
+    // Flag asset as finished loading.
+    pAsyncAssetLoad->mpAssetDefinition->mAssetLoading = false;
+    mAsyncAssetLoads.erase( assetId );
+    mAsyncAssetLoadsFinished++;
+
+    // Did we generate the asset?
+    if ( pAssetBase != NULL )
+    {
+        // Yes, so initialize it.  Only the upload of anything it preloaded is left to do.
+        pAssetBase->initializeOwnedAsset();
+
+        // Acquire a reference for each callback and dependent before any of them can release the asset.
+        for ( S32 index = 0; index < pAsyncAssetLoad->mCallbacks.size() + pAsyncAssetLoad->mDependents.size(); ++index )
+            pAssetBase->acquireAssetReference();
+
+        // Info.
+        if ( mEchoInfo )
+        {
+            Con::printf( "Asset Manager: > Finished acquiring asset asynchronously.  Reference count now '%d'.", pAssetBase->getAcquiredReferenceCount() );
+            Con::printSeparator();
+        }
+    }
+
+    // Notify the callbacks.
+    for ( S32 index = 0; index < pAsyncAssetLoad->mCallbacks.size(); ++index )
+        pAsyncAssetLoad->mCallbacks[index]->onAssetLoaded( assetId, pAssetBase );
+
+    // Start any dependents that were waiting only for this asset.
+    for ( S32 index = 0; index < pAsyncAssetLoad->mDependents.size(); ++index )
+    {
+        AsyncAssetLoad* pDependentLoad = pAsyncAssetLoad->mDependents[index];
+
+        if ( pAssetBase != NULL )
+            pDependentLoad->mHeldDependencies.push_back( assetId );
+
+        if ( --pDependentLoad->mPendingDependencies == 0 )
+            startAsyncAssetLoad( pDependentLoad );
+    }
+
+    delete pAsyncAssetLoad;
+
+    // Release the hold taken while loading.
+    if ( pAssetBase != NULL )
+        releaseAsset( assetId );
+
+    // Reset the progress once everything has loaded.
+    if ( mAsyncAssetLoads.size() == 0 )
+    {
+        mAsyncAssetLoadsStarted = 0;
+        mAsyncAssetLoadsFinished = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::onAssetPreloaded( AssetBase* pAssetBase )
+{
+    // Find the load for the asset.
+    typeAsyncAssetLoadHash::iterator loadItr = mAsyncAssetLoads.find( pAssetBase->getAssetId() );
+
+    // Finish if the asset was not acquired asynchronously.
+    if ( loadItr == mAsyncAssetLoads.end() )
+        return;
+
+    completeAsyncAssetLoad( loadItr->value, pAssetBase );
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetManager::isAsyncAssetLoad( StringTableEntry assetId ) const
+{
+    return mAsyncAssetLoads.find( assetId ) != mAsyncAssetLoads.end();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::finishAsyncAssetLoad( StringTableEntry assetId )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_FinishAsyncAssetLoad);
+
+    // Info.
+    if ( mEchoInfo )
+    {
+        Con::printf( "Asset Manager: Finishing the asynchronous load of asset Id '%s' immediately.", assetId );
+    }
+
+    // Complete the outstanding work.  This finishes every load that is not waiting on the asset itself.
+    flushBackgroundWork();
+}
+
+//-----------------------------------------------------------------------------
+
 void AssetManager::purgeAssets( void )
 {
     // Debug Profiling.
@@ -2306,7 +2824,7 @@ S32 AssetManager::findAssetLooseFile( AssetQuery* pAssetQuery, const char* pLoos
 
 //-----------------------------------------------------------------------------
 
-bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition )
+bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition, const bool useAssetIndex )
 {
     // Debug Profiling.
     PROFILE_SCOPE(AssetManager_ScanDeclaredAssets);
@@ -2319,9 +2837,27 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
     char pathBuffer[1024];
     Con::expandPath( pathBuffer, sizeof(pathBuffer), pPath );
 
-    // Find files.
-    Vector<Platform::FileInfo> files;
-    if ( !Platform::dumpPath( pathBuffer, files, recurse ? -1 : 0 ) )
+    // Scan the files.
+    DeclaredAssetsScan declaredAssetsScan( pathBuffer, pExtension, recurse, useAssetIndex );
+    declaredAssetsScan.scan( false );
+
+    // Add the declared assets.
+    return addScannedDeclaredAssets( declaredAssetsScan, pModuleDefinition );
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetManager::addScannedDeclaredAssets( DeclaredAssetsScan& declaredAssetsScan, ModuleDefinition* pModuleDefinition )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_AddScannedDeclaredAssets);
+
+    // Fetch the scanned path and extension.
+    const char* pathBuffer = declaredAssetsScan.getPath();
+    const char* pExtension = declaredAssetsScan.getExtension();
+
+    // Did we find the files?
+    if ( !declaredAssetsScan.getPathScanned() )
     {
         // Failed so warn.
         Con::warnf( "Asset Manager: Failed to scan declared assets in directory '%s'.", pathBuffer );
@@ -2345,49 +2881,39 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         Con::printf( "Asset Manager: Scanning for declared assets in path '%s' for files with extension '%s'...", pathBuffer, pExtension );
     }
 
-    // Fetch extension length.
-    const U32 extensionLength = dStrlen( pExtension );
-
     // Fetch module assets.
     ModuleDefinition::typeModuleAssetsVector& moduleAssets = pModuleDefinition->getModuleAssets();
 
-    TamlAssetDeclaredVisitor assetDeclaredVisitor;
+    // Expand any loose-file paths the scan could not.
+    declaredAssetsScan.expandLooseFiles();
 
-    // Iterate files.
-    for ( Vector<Platform::FileInfo>::iterator fileItr = files.begin(); fileItr != files.end(); ++fileItr )
-    {
-        // Fetch file info.
-        Platform::FileInfo& fileInfo = *fileItr;
-
-        // Fetch filename.
-        const char* pFilename = fileInfo.pFileName;
+    // Fetch the asset index.
+    const bool useAssetIndex = declaredAssetsScan.getUseAssetIndex();
+    AssetIndex& assetIndex = declaredAssetsScan.getAssetIndex();
+    const char* indexFileBuffer = declaredAssetsScan.getAssetIndexPath();
 
-        // Find filename length.
-        const U32 filenameLength = dStrlen( pFilename );
-
-        // Skip if extension is longer than filename.
-        if ( extensionLength > filenameLength )
-            continue;
-
-        // Skip if extension not found.
-        if ( dStricmp( pFilename + filenameLength - extensionLength, pExtension ) != 0 )
-            continue;
-
-        // Clear declared assets.
-        assetDeclaredVisitor.clear();
-
-        // Format full file-path.
-        char assetFileBuffer[1024];
-        dSprintf( assetFileBuffer, sizeof(assetFileBuffer), "%s/%s", fileInfo.pFullPath, fileInfo.pFileName );
+    // Iterate scanned files.
+    DeclaredAssetsScan::typeScannedFileVector& scannedFiles = declaredAssetsScan.getScannedFiles();
+    for ( DeclaredAssetsScan::typeScannedFileVector::iterator scannedFileItr = scannedFiles.begin(); scannedFileItr != scannedFiles.end(); ++scannedFileItr )
+    {
+        // Fetch the scanned file.
+        const char* assetFileBuffer = scannedFileItr->mFilePath;
 
-        // Parse the filename.
-        if ( !assetDeclaredVisitor.parse( assetFileBuffer ) )
+        // Was the file parsed?
+        if ( scannedFileItr->mpAssetDeclaredVisitor == NULL )
         {
-            // Warn.
+            // No, so warn.
             Con::warnf( "Asset Manager: Failed to parse file containing asset declaration: '%s'.", assetFileBuffer );
             continue;
         }
 
+        // Fetch the declaration.
+        TamlAssetDeclaredVisitor& assetDeclaredVisitor = *scannedFileItr->mpAssetDeclaredVisitor;
+
+        // Index the asset file if it was parsed and declares an asset.
+        if ( useAssetIndex && !scannedFileItr->mRestored && assetDeclaredVisitor.getAssetDefinition().mAssetName != StringTable->EmptyString )
+            assetIndex.store( assetFileBuffer, scannedFileItr->mFileSize, assetDeclaredVisitor );
+
         // Fetch asset definition.
         AssetDefinition& foundAssetDefinition = assetDeclaredVisitor.getAssetDefinition();
 
@@ -2496,6 +3022,22 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         }
     }
 
+    // Save any changes to the asset index.
+    if ( useAssetIndex )
+    {
+        // Info.
+        if ( mEchoInfo )
+        {
+            Con::printf( "Asset Manager: Restored %d and parsed %d asset declarations using the asset index '%s'.", assetIndex.getRestoredCount(), assetIndex.getStoredCount(), indexFileBuffer );
+        }
+
+        // NOTE: The preferences may not be writable in which case the index is simply rebuilt next time.
+        if ( !assetIndex.save( indexFileBuffer ) && mEchoInfo )
+        {
+            Con::printf( "Asset Manager: Could not save the asset index '%s'.", indexFileBuffer );
+        }
+    }
+
     // Info.
     if ( mEchoInfo )
     {
@@ -2931,6 +3473,13 @@ void AssetManager::unloadAsset( AssetDefinition* pAssetDefinition )
     // Debug Profiling.
     PROFILE_SCOPE(AssetManager_UnloadAsset);
 
+    // Is the asset idle?
+    if ( pAssetDefinition->mAssetIdle )
+    {
+        // Yes, so remove it from the idle assets.
+        removeIdleAsset( pAssetDefinition );
+    }
+
     // Destroy the asset.
     pAssetDefinition->mpAssetBase->deleteObject();
 
@@ -2962,6 +3511,150 @@ void AssetManager::unloadAsset( AssetDefinition* pAssetDefinition )
 
 //-----------------------------------------------------------------------------
 
+/// Scans a declared assets location on the thread pool.
+class DeclaredAssetsScanWorkItem : public ThreadPool::WorkItem
+{
+public:
+    DeclaredAssetsScanWorkItem( DeclaredAssetsScan* pDeclaredAssetsScan, bool* pScanComplete ) :
+        mpDeclaredAssetsScan( pDeclaredAssetsScan ),
+        mpScanComplete( pScanComplete )
+    {
+    }
+
+    virtual void execute( void )
+    {
+        // Path expandos cannot be used away from the main thread.
+        mpDeclaredAssetsScan->scan( true );
+    }
+
+    virtual void onCompleted( void )
+    {
+        *mpScanComplete = true;
+    }
+
+private:
+    DeclaredAssetsScan* mpDeclaredAssetsScan;
+    bool*               mpScanComplete;
+};
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::prefetchModuleDeclaredAssets( ModuleDefinition* pModuleDefinition )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_PrefetchModuleDeclaredAssets);
+
+    // Sanity!
+    AssertFatal( pModuleDefinition != NULL, "Cannot prefetch declared assets using a NULL module definition" );
+
+    // Fetch the thread pool.
+    ThreadPool* pThreadPool = ThreadPool::getGlobal();
+
+    // Finish if there are no workers to scan ahead on.
+    if ( pThreadPool == NULL || pThreadPool->getWorkerCount() == 0 )
+        return;
+
+    // Finish if the module already has assets as they will not be added.
+    if ( pModuleDefinition->getModuleAssets().size() > 0 )
+        return;
+
+    // Iterate the module definition children.
+    for( SimSet::iterator itr = pModuleDefinition->begin(); itr != pModuleDefinition->end(); ++itr )
+    {
+        // Fetch the declared assets.
+        DeclaredAssets* pDeclaredAssets = dynamic_cast<DeclaredAssets*>( *itr );
+
+        // Skip if it's not a declared assets location or it is already being scanned.
+        if ( pDeclaredAssets == NULL || findDeclaredAssetsPrefetch( pModuleDefinition, pDeclaredAssets ) >= 0 )
+            continue;
+
+        // Expand asset manifest location.
+        char filePathBuffer[1024];
+        char pathBuffer[1024];
+        dSprintf( filePathBuffer, sizeof(filePathBuffer), "%s/%s", pModuleDefinition->getModulePath(), pDeclaredAssets->getPath() );
+        Con::expandPath( pathBuffer, sizeof(pathBuffer), filePathBuffer );
+
+        // Queue the scan.
+        DeclaredAssetsPrefetch* pDeclaredAssetsPrefetch = new DeclaredAssetsPrefetch();
+        pDeclaredAssetsPrefetch->mpModuleDefinition = pModuleDefinition;
+        pDeclaredAssetsPrefetch->mpDeclaredAssets = pDeclaredAssets;
+        pDeclaredAssetsPrefetch->mpDeclaredAssetsScan = new DeclaredAssetsScan( pathBuffer, pDeclaredAssets->getExtension(), pDeclaredAssets->getRecurse(), mUseAssetIndex );
+        pDeclaredAssetsPrefetch->mScanComplete = false;
+        mDeclaredAssetsPrefetches.push_back( pDeclaredAssetsPrefetch );
+
+        pThreadPool->queueWorkItem( new DeclaredAssetsScanWorkItem( pDeclaredAssetsPrefetch->mpDeclaredAssetsScan, &pDeclaredAssetsPrefetch->mScanComplete ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+S32 AssetManager::findDeclaredAssetsPrefetch( ModuleDefinition* pModuleDefinition, DeclaredAssets* pDeclaredAssets ) const
+{
+    // Find the prefetch.
+    for ( S32 index = 0; index < mDeclaredAssetsPrefetches.size(); ++index )
+    {
+        const DeclaredAssetsPrefetch* pDeclaredAssetsPrefetch = mDeclaredAssetsPrefetches[index];
+
+        if ( pDeclaredAssetsPrefetch->mpModuleDefinition == pModuleDefinition && pDeclaredAssetsPrefetch->mpDeclaredAssets == pDeclaredAssets )
+            return index;
+    }
+
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::finishDeclaredAssetsPrefetch( DeclaredAssetsPrefetch* pDeclaredAssetsPrefetch )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_FinishDeclaredAssetsPrefetch);
+
+    // Finish if the scan is already complete or the pool, and with it the scan, has gone.
+    if ( pDeclaredAssetsPrefetch->mScanComplete || ThreadPool::getGlobal() == NULL )
+        return;
+
+    // Help the pool until the scan is complete.
+    ThreadPool::getGlobal()->waitUntil( pDeclaredAssetsPrefetch->mScanComplete );
+
+    // Sanity!
+    AssertFatal( pDeclaredAssetsPrefetch->mScanComplete, "AssetManager::finishDeclaredAssetsPrefetch() - The declared assets scan did not complete." );
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::cancelDeclaredAssetsPrefetches( ModuleDefinition* pModuleDefinition )
+{
+    // Iterate the prefetches backwards so they can be removed.
+    for ( S32 index = mDeclaredAssetsPrefetches.size() - 1; index >= 0; --index )
+    {
+        DeclaredAssetsPrefetch* pDeclaredAssetsPrefetch = mDeclaredAssetsPrefetches[index];
+
+        // Skip if it's for another module.
+        if ( pModuleDefinition != NULL && pDeclaredAssetsPrefetch->mpModuleDefinition != pModuleDefinition )
+            continue;
+
+        mDeclaredAssetsPrefetches.erase( index );
+
+        // The scan cannot be deleted while a worker is using it.
+        finishDeclaredAssetsPrefetch( pDeclaredAssetsPrefetch );
+        delete pDeclaredAssetsPrefetch->mpDeclaredAssetsScan;
+        delete pDeclaredAssetsPrefetch;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::onModulePrefetch( ModuleDefinition* pModuleDefinition )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_OnModulePrefetch);
+
+    // Scan the module declared assets ahead of the module loading.
+    prefetchModuleDeclaredAssets( pModuleDefinition );
+}
+
+//-----------------------------------------------------------------------------
+
 void AssetManager::onModulePreLoad( ModuleDefinition* pModuleDefinition )
 {
     // Debug Profiling.
@@ -3008,6 +3701,9 @@ void AssetManager::onModulePostUnload( ModuleDefinition* pModuleDefinition )
     // Debug Profiling.
     PROFILE_SCOPE(AssetManager_OnModulePostUnload);
 
+    // Discard any declared assets scanned ahead of the module loading.
+    cancelDeclaredAssetsPrefetches( pModuleDefinition );
+
     // Remove declared assets.
     removeDeclaredAssets( pModuleDefinition );
 }
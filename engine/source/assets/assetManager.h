@@ -66,6 +66,21 @@
 
 class AssetPtrCallback;
 class AssetPtrBase;
+class DeclaredAssets;
+class DeclaredAssetsScan;
+
+//-----------------------------------------------------------------------------
+
+/// Notified on the main thread when an asynchronous asset acquisition finishes.
+class AssetLoadCallback
+{
+public:
+    virtual ~AssetLoadCallback() {}
+
+    /// The asset has been acquired on behalf of the callback and must be released as normal.
+    /// @param pAssetBase The acquired asset or NULL if the asset could not be loaded.
+    virtual void onAssetLoaded( StringTableEntry assetId, AssetBase* pAssetBase ) = 0;
+};
 
 //-----------------------------------------------------------------------------
 
@@ -82,6 +97,37 @@ private:
     typedef HashTable<typeAssetId, typeAssetId> typeAssetIsDependedOnHash;
     typedef HashMap<AssetPtrBase*, AssetPtrCallback*> typeAssetPtrRefreshHash;
 
+    /// An asset being acquired asynchronously.
+    struct AsyncAssetLoad
+    {
+        typeAssetId                 mAssetId;
+        AssetDefinition*            mpAssetDefinition;
+        U32                         mPendingDependencies;
+        bool                        mStarted;
+        Vector<AsyncAssetLoad*>     mDependents;
+        Vector<typeAssetId>         mHeldDependencies;
+        Vector<AssetLoadCallback*>  mCallbacks;
+    };
+    typedef HashMap<typeAssetId, AsyncAssetLoad*> typeAsyncAssetLoadHash;
+
+    /// A loaded asset with no acquisitions kept in memory in case it is acquired again.
+    struct IdleAsset
+    {
+        AssetDefinition*            mpAssetDefinition;
+        U32                         mMemorySize;
+    };
+    typedef Vector<IdleAsset> typeIdleAssetVector;
+
+    /// A declared assets location of a module being scanned ahead of the module loading.
+    struct DeclaredAssetsPrefetch
+    {
+        ModuleDefinition*           mpModuleDefinition;
+        DeclaredAssets*             mpDeclaredAssets;
+        DeclaredAssetsScan*         mpDeclaredAssetsScan;
+        bool                        mScanComplete;
+    };
+    typedef Vector<DeclaredAssetsPrefetch*> typeDeclaredAssetsPrefetchVector;
+
     /// Declared assets.
     typeDeclaredAssetsHash              mDeclaredAssets;
 
@@ -99,9 +145,26 @@ private:
     /// Asset pointer refresh notifications.
     typeAssetPtrRefreshHash             mAssetPtrRefreshNotifications;
 
+    /// Asynchronous asset loads.
+    typeAsyncAssetLoadHash              mAsyncAssetLoads;
+    U32                                 mAsyncAssetLoadsStarted;
+    U32                                 mAsyncAssetLoadsFinished;
+
+    /// Idle assets, least recently used first.
+    typeIdleAssetVector                 mIdleAssets;
+    U32                                 mIdleAssetBudget;
+    U32                                 mIdleAssetMemory;
+    U32                                 mAssetCacheHits;
+    U32                                 mAssetCacheMisses;
+    U32                                 mAssetCacheEvictions;
+
+    /// Declared assets being scanned on the thread pool.
+    typeDeclaredAssetsPrefetchVector    mDeclaredAssetsPrefetches;
+
     /// Miscellaneous.
     bool                                mEchoInfo;
     bool                                mIgnoreAutoUnload;
+    bool                                mUseAssetIndex;
     U32                                 mLoadedInternalAssetsCount;
     U32                                 mLoadedExternalAssetsCount;
     U32                                 mLoadedPrivateAssetsCount;
@@ -171,6 +234,13 @@ public:
             return NULL;
         }
 
+        // Is the asset being acquired asynchronously?
+        if ( pAssetDefinition->mAssetLoading == true && isAsyncAssetLoad( pAssetDefinition->mAssetId ) )
+        {
+            // Yes, so finish loading it now.
+            finishAsyncAssetLoad( pAssetDefinition->mAssetId );
+        }
+
         // Is asset loading?
         if ( pAssetDefinition->mAssetLoading == true )
         {
@@ -216,6 +286,9 @@ public:
                 }
             }
 
+            // Count the load.
+            onAssetCacheMiss();
+
             // Flag asset as loading.
             pAssetDefinition->mAssetLoading = true;
 
@@ -268,6 +341,9 @@ public:
             {
                 Con::printf( "Asset Manager: > Acquiring from idle state." );
             }
+
+            // Count the load avoided.
+            onAssetCacheHit();
         }
 
         // Set acquired asset.
@@ -284,6 +360,13 @@ public:
         // Acquire asset reference.
         pAcquiredAsset->acquireAssetReference();
 
+        // Is the asset cached as idle?
+        if ( pAssetDefinition->mAssetIdle )
+        {
+            // Yes, so it is no longer idle.
+            removeIdleAsset( pAssetDefinition );
+        }
+
         // Info.
         if ( mEchoInfo )
         {
@@ -319,9 +402,33 @@ public:
         return pAssetClone;
     }
 
+    /// Asynchronous asset acquisition.
+    /// The asset dependencies are acquired first and images are decoded on the thread pool.
+    /// The callback is called once the asset is acquired, immediately if it is already loaded.
+    /// @return Whether the asset exists.  The callback is not called if it does not.
+    bool acquireAssetAsync( const char* pAssetId, AssetLoadCallback* pCallback );
+    inline U32 getAsyncAssetLoadCount( void ) const { return (U32)mAsyncAssetLoads.size(); }
+
+    /// The fraction of asynchronous loads finished since the manager was last idle.
+    F32 getAsyncAssetLoadProgress( void ) const;
+
     bool releaseAsset( const char* pAssetId );
     void purgeAssets( void );
 
+    /// Idle asset caching.
+    /// Auto-unload assets released to no acquisitions are kept loaded while the memory they hold fits the budget.
+    /// Once over the budget the least recently used are unloaded.  A budget of zero unloads them immediately.
+    void setIdleAssetBudget( const U32 budget );
+    inline U32 getIdleAssetBudget( void ) const { return mIdleAssetBudget; }
+    inline U32 getIdleAssetCount( void ) const { return (U32)mIdleAssets.size(); }
+    inline U32 getIdleAssetMemory( void ) const { return mIdleAssetMemory; }
+
+    /// Acquisitions of an unacquired asset count as a hit if it was still loaded and a miss if it had to be loaded.
+    inline U32 getAssetCacheHits( void ) const { return mAssetCacheHits; }
+    inline U32 getAssetCacheMisses( void ) const { return mAssetCacheMisses; }
+    inline U32 getAssetCacheEvictions( void ) const { return mAssetCacheEvictions; }
+    void resetAssetCacheStats( void );
+
     /// Asset deletion.
     bool deleteAsset( const char* pAssetId, const bool deleteLooseFiles, const bool deleteDependencies );
 
@@ -371,7 +478,8 @@ public:
     DECLARE_CONOBJECT( AssetManager );
 
 private:
-    bool scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition );
+    bool scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition, const bool useAssetIndex = false );
+    bool addScannedDeclaredAssets( DeclaredAssetsScan& declaredAssetsScan, ModuleDefinition* pModuleDefinition );
     bool scanReferencedAssets( const char* pPath, const char* pExtension, const bool recurse );
     AssetDefinition* findAsset( const char* pAssetId );
     void addReferencedAsset( StringTableEntry assetId, StringTableEntry referenceFilePath );
@@ -382,7 +490,30 @@ private:
     void removeAssetLooseFiles( const char* pAssetId );
     void unloadAsset( AssetDefinition* pAssetDefinition );
 
+    /// Idle asset caching.
+    void addIdleAsset( AssetDefinition* pAssetDefinition );
+    void removeIdleAsset( AssetDefinition* pAssetDefinition );
+    void evictIdleAssets( void );
+    void onAssetCacheMiss( void );
+    void onAssetCacheHit( void );
+
+    /// Asynchronous asset acquisition.
+    friend class AssetBase;
+    AsyncAssetLoad* queueAsyncAssetLoad( AssetDefinition* pAssetDefinition, Vector<typeAssetId>& resolvingAssets, Vector<typeAssetId>& queuedAssets );
+    void startAsyncAssetLoad( AsyncAssetLoad* pAsyncAssetLoad );
+    void completeAsyncAssetLoad( AsyncAssetLoad* pAsyncAssetLoad, AssetBase* pAssetBase );
+    void onAssetPreloaded( AssetBase* pAssetBase );
+    bool isAsyncAssetLoad( StringTableEntry assetId ) const;
+    void finishAsyncAssetLoad( StringTableEntry assetId );
+
+    /// Declared assets prefetching.
+    void prefetchModuleDeclaredAssets( ModuleDefinition* pModuleDefinition );
+    S32 findDeclaredAssetsPrefetch( ModuleDefinition* pModuleDefinition, DeclaredAssets* pDeclaredAssets ) const;
+    void finishDeclaredAssetsPrefetch( DeclaredAssetsPrefetch* pDeclaredAssetsPrefetch );
+    void cancelDeclaredAssetsPrefetches( ModuleDefinition* pModuleDefinition );
+
     /// Module callbacks.
+    virtual void onModulePrefetch( ModuleDefinition* pModuleDefinition );
     virtual void onModulePreLoad( ModuleDefinition* pModuleDefinition );
     virtual void onModulePreUnload( ModuleDefinition* pModuleDefinition );
     virtual void onModulePostUnload( ModuleDefinition* pModuleDefinition );
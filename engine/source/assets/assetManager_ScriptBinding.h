@@ -310,6 +310,88 @@ ConsoleMethod( AssetManager, acquireAsset, const char*, 3, 4,   "(assetId, [asPr
 
 //-----------------------------------------------------------------------------
 
+/// Calls "onAssetAcquired" on a script object when an asynchronous acquisition finishes.
+class ScriptAssetLoadCallback : public AssetLoadCallback
+{
+public:
+    ScriptAssetLoadCallback( AssetManager* pAssetManager, SimObject* pCallbackObject ) :
+        mpAssetManager( pAssetManager ),
+        mCallbackObject( pCallbackObject )
+    {
+    }
+
+    virtual void onAssetLoaded( StringTableEntry assetId, AssetBase* pAssetBase )
+    {
+        // Is the callback object still around?
+        if ( !mCallbackObject.isNull() )
+        {
+            // Yes, so notify it.
+            Con::executef( mCallbackObject, 3, "onAssetAcquired", assetId, pAssetBase != NULL ? pAssetBase->getIdString() : StringTable->EmptyString );
+        }
+        else if ( pAssetBase != NULL )
+        {
+            // No, so nobody can release the asset.
+            mpAssetManager->releaseAsset( assetId );
+        }
+
+        delete this;
+    }
+
+private:
+    AssetManager*               mpAssetManager;
+    SimObjectPtr<SimObject>     mCallbackObject;
+};
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, acquireAssetAsync, bool, 4, 4,     "(assetId, callbackObject) - Acquire the specified asset Id asynchronously.\n"
+                                                                "Dependencies are acquired first and images are decoded in the background.\n"
+                                                                "Once acquired, 'onAssetAcquired(assetId, asset)' is called on the callback object with an empty asset if the acquisition failed.\n"
+                                                                "You must release the asset once you're finish with it using 'releaseAsset'.\n"
+                                                                "@param assetId The selected asset Id.\n"
+                                                                "@param callbackObject The object to notify when the asset is acquired.\n"
+                                                                "@return Whether the asset Id exists or not.")
+{
+    // Fetch callback object.
+    SimObject* pCallbackObject = Sim::findObject( argv[3] );
+
+    // Did we find the callback object?
+    if ( pCallbackObject == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "AssetManager::acquireAssetAsync() - Could not find the callback object '%s'.", argv[3] );
+        return false;
+    }
+
+    // Acquire the asset.
+    ScriptAssetLoadCallback* pCallback = new ScriptAssetLoadCallback( object, pCallbackObject );
+    if ( !object->acquireAssetAsync( argv[2], pCallback ) )
+    {
+        delete pCallback;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, getAsyncAssetLoadCount, S32, 2, 2, "() - Gets the number of assets being acquired asynchronously.\n"
+                                                                "@return The number of assets being acquired asynchronously including their dependencies.")
+{
+    return object->getAsyncAssetLoadCount();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, getAsyncAssetLoadProgress, F32, 2, 2, "() - Gets the progress of the asynchronous acquisitions, suitable for a loading screen.\n"
+                                                                "@return The fraction of assets acquired since the asset manager was last idle, from zero to one.")
+{
+    return object->getAsyncAssetLoadProgress();
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod( AssetManager, releaseAsset, bool, 3, 3,          "(assetId) - Release the specified asset Id.\n"
                                                                 "The asset should have been acquired using 'acquireAsset'.\n"
                                                                 "@param assetId The selected asset Id.\n"
@@ -331,6 +413,64 @@ ConsoleMethod( AssetManager, purgeAssets, void, 2, 2,           "() - Purge all
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod( AssetManager, setIdleAssetBudget, void, 3, 3,    "(budget) - Sets the memory, in bytes, that released auto-unload assets can hold while idle.\n"
+                                                                "Idle assets are unloaded least recently used first once over the budget.  A budget of zero unloads them immediately.\n"
+                                                                "@param budget The idle asset memory budget in bytes.\n"
+                                                                "@return No return value.")
+{
+    object->setIdleAssetBudget( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, getIdleAssetBudget, S32, 2, 2,     "() - Gets the memory, in bytes, that released auto-unload assets can hold while idle.\n"
+                                                                "@return The idle asset memory budget in bytes.")
+{
+    return object->getIdleAssetBudget();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, getIdleAssetCount, S32, 2, 2,      "() - Gets the number of idle assets kept loaded.\n"
+                                                                "@return The number of idle assets kept loaded.")
+{
+    return object->getIdleAssetCount();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, getIdleAssetMemory, S32, 2, 2,     "() - Gets the memory, in bytes, held by idle assets.\n"
+                                                                "@return The memory held by idle assets in bytes.")
+{
+    return object->getIdleAssetMemory();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, getAssetCacheStats, const char*, 2, 2, "() - Gets the idle asset cache statistics.\n"
+                                                                "A hit is an acquisition of an unacquired asset that was still loaded, a miss one that had to be loaded.\n"
+                                                                "@return The hits, misses and evictions as 'hits misses evictions'.")
+{
+    // Create Returnable Buffer.
+    char* pBuffer = Con::getReturnBuffer(64);
+
+    // Format Buffer.
+    dSprintf( pBuffer, 64, "%d %d %d", object->getAssetCacheHits(), object->getAssetCacheMisses(), object->getAssetCacheEvictions() );
+
+    // Return buffer.
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod( AssetManager, resetAssetCacheStats, void, 2, 2,  "() - Resets the idle asset cache statistics.\n"
+                                                                "@return No return value.")
+{
+    object->resetAssetCacheStats();
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod( AssetManager, deleteAsset, bool, 5, 5,   "(assetId, deleteLooseFiles, deleteDependencies) Deletes the specified asset Id and optionally its loose files and asset dependencies.\n"
                                                         "@param assetId The selected asset Id.\n"
                                                         "@param deleteLooseFiles Whether to delete an assets loose files or not.\n"
@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _DECLARED_ASSETS_SCAN_H_
+#include "assets/declaredAssetsScan.h"
+#endif
+
+#ifndef _TAML_ASSET_DECLARED_VISITOR_H_
+#include "assets/tamlAssetDeclaredVisitor.h"
+#endif
+
+#ifndef _CRC_H_
+#include "algorithm/crc.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+DeclaredAssetsScan::DeclaredAssetsScan( const char* pPath, const char* pExtension, const bool recurse, const bool useAssetIndex ) :
+    mPath( StringTable->insert( pPath ) ),
+    mExtension( StringTable->insert( pExtension ) ),
+    mRecurse( recurse ),
+    mUseAssetIndex( useAssetIndex ),
+    mPathScanned( false ),
+    mLooseFileExpansionDeferred( false )
+{
+    // Format the asset index path.  The index is kept with the preferences rather than
+    // in the scanned path as module locations are often read-only or under source control.
+    char scanBuffer[1024];
+    dSprintf( scanBuffer, sizeof(scanBuffer), "%s/%s", pPath, pExtension );
+    const U32 scanHash = calculateCRC( scanBuffer, dStrlen(scanBuffer) );
+    dSprintf( mAssetIndexPath, sizeof(mAssetIndexPath), "%s/%08x.%s", Platform::getPrefsPath( "assetIndex" ), scanHash, ASSET_INDEX_EXTENSION );
+}
+
+//-----------------------------------------------------------------------------
+
+DeclaredAssetsScan::~DeclaredAssetsScan()
+{
+    // Delete the declarations.
+    for ( typeScannedFileVector::iterator scannedFileItr = mScannedFiles.begin(); scannedFileItr != mScannedFiles.end(); ++scannedFileItr )
+    {
+        delete scannedFileItr->mpAssetDeclaredVisitor;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool DeclaredAssetsScan::scan( const bool deferLooseFileExpansion )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(DeclaredAssetsScan_Scan);
+
+    // Sanity!
+    AssertFatal( !mPathScanned && mScannedFiles.size() == 0, "DeclaredAssetsScan::scan() - The path has already been scanned." );
+
+    mLooseFileExpansionDeferred = deferLooseFileExpansion;
+
+    // Find files.
+    Vector<Platform::FileInfo> files;
+    if ( !Platform::dumpPath( mPath, files, mRecurse ? -1 : 0 ) )
+        return false;
+
+    mPathScanned = true;
+
+    // Load the asset index so unchanged asset files need not be parsed.
+    if ( mUseAssetIndex )
+        mAssetIndex.load( mAssetIndexPath );
+
+    // Fetch extension length.
+    const U32 extensionLength = dStrlen( mExtension );
+
+    // Iterate files.
+    for ( Vector<Platform::FileInfo>::iterator fileItr = files.begin(); fileItr != files.end(); ++fileItr )
+    {
+        // Fetch file info.
+        Platform::FileInfo& fileInfo = *fileItr;
+
+        // Fetch filename.
+        const char* pFilename = fileInfo.pFileName;
+
+        // Find filename length.
+        const U32 filenameLength = dStrlen( pFilename );
+
+        // Skip if extension is longer than filename.
+        if ( extensionLength > filenameLength )
+            continue;
+
+        // Skip if extension not found.
+        if ( dStricmp( pFilename + filenameLength - extensionLength, mExtension ) != 0 )
+            continue;
+
+        // Format full file-path.
+        char assetFileBuffer[1024];
+        dSprintf( assetFileBuffer, sizeof(assetFileBuffer), "%s/%s", fileInfo.pFullPath, fileInfo.pFileName );
+
+        ScannedFile scannedFile;
+        scannedFile.mFilePath = StringTable->insert( assetFileBuffer );
+        scannedFile.mFileSize = fileInfo.fileSize;
+        scannedFile.mRestored = false;
+        scannedFile.mpAssetDeclaredVisitor = new TamlAssetDeclaredVisitor();
+        scannedFile.mpAssetDeclaredVisitor->setDeferLooseFileExpansion( deferLooseFileExpansion );
+
+        // Is the asset file unchanged since it was indexed?
+        if ( mUseAssetIndex && mAssetIndex.restore( assetFileBuffer, fileInfo.fileSize, *scannedFile.mpAssetDeclaredVisitor ) )
+        {
+            // Yes, so the declaration is restored.
+            scannedFile.mRestored = true;
+        }
+        // No, so parse the file.
+        else if ( !scannedFile.mpAssetDeclaredVisitor->parse( assetFileBuffer ) )
+        {
+            // Failed so discard the declaration.
+            delete scannedFile.mpAssetDeclaredVisitor;
+            scannedFile.mpAssetDeclaredVisitor = NULL;
+        }
+
+        mScannedFiles.push_back( scannedFile );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void DeclaredAssetsScan::expandLooseFiles( void )
+{
+    // Finish if the expansion was not deferred.
+    if ( !mLooseFileExpansionDeferred )
+        return;
+
+    // Iterate the parsed declarations.  Restored declarations were expanded when they were indexed.
+    for ( typeScannedFileVector::iterator scannedFileItr = mScannedFiles.begin(); scannedFileItr != mScannedFiles.end(); ++scannedFileItr )
+    {
+        if ( scannedFileItr->mpAssetDeclaredVisitor != NULL && !scannedFileItr->mRestored )
+            scannedFileItr->mpAssetDeclaredVisitor->expandLooseFiles();
+    }
+
+    mLooseFileExpansionDeferred = false;
+}
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _DECLARED_ASSETS_SCAN_H_
+#define _DECLARED_ASSETS_SCAN_H_
+
+#ifndef _ASSET_INDEX_H_
+#include "assets/assetIndex.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class TamlAssetDeclaredVisitor;
+
+//-----------------------------------------------------------------------------
+
+/// The asset declarations found in the files of a declared assets path.
+///
+/// Scanning lists the files with the extension, restores the declarations of
+/// unchanged files from the asset index and parses the rest.  It only uses the
+/// file system and the string table so it can run on a worker thread, leaving
+/// the asset manager to add the declarations on the main thread.
+class DeclaredAssetsScan
+{
+public:
+    struct ScannedFile
+    {
+        StringTableEntry            mFilePath;
+        U32                         mFileSize;
+        bool                        mRestored;
+
+        /// The parsed or restored declaration or NULL if the file could not be parsed.
+        TamlAssetDeclaredVisitor*   mpAssetDeclaredVisitor;
+    };
+    typedef Vector<ScannedFile> typeScannedFileVector;
+
+    /// @param pPath The expanded path to scan.
+    DeclaredAssetsScan( const char* pPath, const char* pExtension, const bool recurse, const bool useAssetIndex );
+    ~DeclaredAssetsScan();
+
+    /// Scans the path.  Off the main thread the expansion of loose-file paths
+    /// must be deferred and finished with expandLooseFiles() on the main thread.
+    /// @return Whether the path could be listed or not.
+    bool scan( const bool deferLooseFileExpansion );
+
+    /// Expands any loose-file paths deferred by the scan.
+    void expandLooseFiles( void );
+
+    inline StringTableEntry getPath( void ) const               { return mPath; }
+    inline StringTableEntry getExtension( void ) const          { return mExtension; }
+    inline bool getUseAssetIndex( void ) const                  { return mUseAssetIndex; }
+    inline const char* getAssetIndexPath( void ) const          { return mAssetIndexPath; }
+    inline AssetIndex& getAssetIndex( void )                    { return mAssetIndex; }
+    inline bool getPathScanned( void ) const                    { return mPathScanned; }
+    inline typeScannedFileVector& getScannedFiles( void )       { return mScannedFiles; }
+
+private:
+    StringTableEntry        mPath;
+    StringTableEntry        mExtension;
+    bool                    mRecurse;
+    bool                    mUseAssetIndex;
+    char                    mAssetIndexPath[1024];
+    AssetIndex              mAssetIndex;
+    bool                    mPathScanned;
+    bool                    mLooseFileExpansionDeferred;
+    typeScannedFileVector   mScannedFiles;
+};
+
+#endif // _DECLARED_ASSETS_SCAN_H_
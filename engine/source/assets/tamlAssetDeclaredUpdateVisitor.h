@@ -47,41 +47,45 @@
 class TamlAssetDeclaredUpdateVisitor : public TamlXmlVisitor
 {
 protected:
-    virtual bool visit( TiXmlElement* pXmlElement, TamlXmlParser& xmlParser )
+    virtual bool visit( TamlXmlElement* pXmlElement, TamlXmlParser& xmlParser )
     {
         // Debug Profiling.
         PROFILE_SCOPE(TamlAssetDeclaredUpdateVisitor_VisitElement);
 
         // Finish if this is not the root element.
-        if ( pXmlElement != pXmlElement->GetDocument()->RootElement() )
+        if ( !pXmlElement->isRootElement() )
             return true;
 
         // Fetch asset field names.
         StringTableEntry assetNameField = StringTable->insert( ASSET_BASE_ASSETNAME_FIELD );
 
         // Iterate attributes.
-        for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
+        const U32 attributeCount = pXmlElement->getAttributeCount();
+        for ( U32 attributeIndex = 0; attributeIndex < attributeCount; ++attributeIndex )
         {
+            // Fetch attribute.
+            TamlXmlAttribute* pAttribute = &pXmlElement->getAttribute( attributeIndex );
+
             // Insert attribute name.
-            StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
+            StringTableEntry attributeName = StringTable->insert( pAttribute->getName() );
 
             // Asset name?
             if ( attributeName != assetNameField )
                 continue;
 
             // Is this the asset Id we're looking for?
-            if ( dStricmp( pAttribute->Value(), mAssetNameFrom ) != 0 )
+            if ( dStricmp( pAttribute->getValue(), mAssetNameFrom ) != 0 )
             {
                 // No, so warn.
                 Con::warnf("Cannot rename asset Name '%s' to asset Name '%s' as the declared asset Name was %s",
-                    mAssetNameFrom, mAssetNameTo, pAttribute->Value() );
+                    mAssetNameFrom, mAssetNameTo, pAttribute->getValue() );
 
                 // Stop processing!
                 return false;
             }
 
             // Assign new value.
-            pAttribute->SetValue( mAssetNameTo );
+            pAttribute->setValue( mAssetNameTo );
 
             // Stop processing!
             return false;
@@ -90,7 +94,7 @@ protected:
         return true;
     }
 
-    virtual bool visit( TiXmlAttribute* pAttribute, TamlXmlParser& xmlParser ) { return true; }
+    virtual bool visit( TamlXmlAttribute* pAttribute, TamlXmlParser& xmlParser ) { return true; }
 
 public:
     TamlAssetDeclaredUpdateVisitor() {}
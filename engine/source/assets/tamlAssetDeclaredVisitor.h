@@ -47,13 +47,13 @@
 class TamlAssetDeclaredVisitor : public TamlXmlVisitor
 {
 protected:
-    virtual bool visit( TiXmlElement* pXmlElement, TamlXmlParser& xmlParser )
+    virtual bool visit( TamlXmlElement* pXmlElement, TamlXmlParser& xmlParser )
     {
         // Debug Profiling.
         PROFILE_SCOPE(TamlAssetDeclaredVisitor_VisitElement);
 
         // Finish if this is not the root element.
-        if ( pXmlElement != pXmlElement->GetDocument()->RootElement() )
+        if ( !pXmlElement->isRootElement() )
             return true;
 
         // Fetch asset field names.
@@ -64,44 +64,48 @@ protected:
         StringTableEntry assetInternalField = StringTable->insert( ASSET_BASE_ASSETINTERNAL_FIELD );
 
         // Iterate attributes.
-        for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
+        const U32 attributeCount = pXmlElement->getAttributeCount();
+        for ( U32 attributeIndex = 0; attributeIndex < attributeCount; ++attributeIndex )
         {
+            // Fetch attribute.
+            TamlXmlAttribute* pAttribute = &pXmlElement->getAttribute( attributeIndex );
+
             // Insert attribute name.
-            StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
+            StringTableEntry attributeName = StringTable->insert( pAttribute->getName() );
 
             // Asset name?
             if ( attributeName == assetNameField )
             {
                 // Yes, so assign it.
-                mAssetDefinition.mAssetName = StringTable->insert( pAttribute->Value() );
+                mAssetDefinition.mAssetName = StringTable->insert( pAttribute->getValue() );
                 continue;
             }
             // Asset description?
             else if ( attributeName == assetDescriptionField )
             {
                 // Yes, so assign it.
-                mAssetDefinition.mAssetDescription = StringTable->insert( pAttribute->Value() );
+                mAssetDefinition.mAssetDescription = StringTable->insert( pAttribute->getValue() );
                 continue;
             }
             // Asset description?
             else if ( attributeName == assetCategoryField )
             {
                 // Yes, so assign it.
-                mAssetDefinition.mAssetCategory = StringTable->insert( pAttribute->Value() );
+                mAssetDefinition.mAssetCategory = StringTable->insert( pAttribute->getValue() );
                 continue;
             }
             // Asset auto-unload?
             else if ( attributeName == assetAutoUnloadField )
             {
                 // Yes, so assign it.
-                mAssetDefinition.mAssetAutoUnload = dAtob( pAttribute->Value() );
+                mAssetDefinition.mAssetAutoUnload = dAtob( pAttribute->getValue() );
                 continue;
             }
             // Asset internal?
             else if ( attributeName == assetInternalField )
             {
                 // Yes, so assign it.
-                mAssetDefinition.mAssetInternal = dAtob( pAttribute->Value() );
+                mAssetDefinition.mAssetInternal = dAtob( pAttribute->getValue() );
                 continue;
             }
         }
@@ -120,12 +124,12 @@ protected:
         mAssetDefinition.mAssetBaseFilePath = StringTable->insert( xmlParser.getParsingFilename() );
 
         // Set asset type.
-        mAssetDefinition.mAssetType = StringTable->insert( pXmlElement->Value() );
+        mAssetDefinition.mAssetType = StringTable->insert( pXmlElement->getName() );
 
         return true;
     }
 
-    virtual bool visit( TiXmlAttribute* pAttribute, TamlXmlParser& xmlParser )
+    virtual bool visit( TamlXmlAttribute* pAttribute, TamlXmlParser& xmlParser )
     {
         // Debug Profiling.
         PROFILE_SCOPE(TamlAssetDeclaredVisitor_VisitAttribute);
@@ -134,7 +138,7 @@ protected:
         AssertFatal( mAssetDefinition.mAssetName != StringTable->EmptyString, "Cannot generate asset dependencies without asset name." );
 
         // Fetch asset reference.
-        const char* pAssetReference = pAttribute->Value();
+        const char* pAssetReference = pAttribute->getValue();
 
         // Fetch field word count.
         const U32 fieldWordCount = StringUnit::getUnitCount( pAssetReference, ASSET_ASSIGNMENT_TOKEN );
@@ -199,6 +203,11 @@ protected:
                 // Format expanded path taking into account any missing slash.
                 dSprintf( assetFilePathBuffer, sizeof(assetFilePathBuffer), "%s/%s", parsingFileBuffer, pAssetLooseFile + (pAssetLooseFile[1] == '/' ? 2 : 1 ) );               
             }
+            else if ( mDeferLooseFileExpansion )
+            {
+                // No, but expanding it needs the console so keep it as it is until expandLooseFiles() is called.
+                dStrcpy( assetFilePathBuffer, pAssetLooseFile );
+            }
             else
             {
                 // No, so expand the path in the usual way.
@@ -213,7 +222,7 @@ protected:
     }
 
 public:
-    TamlAssetDeclaredVisitor() { mAssetDefinition.reset(); }
+    TamlAssetDeclaredVisitor() : mDeferLooseFileExpansion( false ) { mAssetDefinition.reset(); }
     virtual ~TamlAssetDeclaredVisitor() {}
 
     bool parse( const char* pFilename )
@@ -232,7 +241,25 @@ public:
 
     void clear( void ) { mAssetDefinition.reset(); mAssetDependencies.clear(); mAssetLooseFiles.clear(); }
 
+    /// Loose-file paths relying on path expandos cannot be expanded away from the main thread.
+    /// When deferred they are kept as written until expandLooseFiles() is called on the main thread.
+    inline void setDeferLooseFileExpansion( const bool deferExpansion ) { mDeferLooseFileExpansion = deferExpansion; }
+    inline bool getDeferLooseFileExpansion( void ) const { return mDeferLooseFileExpansion; }
+
+    void expandLooseFiles( void )
+    {
+        // Iterate loose files.
+        for( typeLooseFileVector::iterator looseFileItr = mAssetLooseFiles.begin(); looseFileItr != mAssetLooseFiles.end(); ++looseFileItr )
+        {
+            // Expand the loose-file.  Paths already expanded are unchanged by this.
+            char assetFilePathBuffer[1024];
+            Con::expandPath( assetFilePathBuffer, sizeof(assetFilePathBuffer), *looseFileItr );
+            *looseFileItr = StringTable->insert( assetFilePathBuffer );
+        }
+    }
+
 private:
+    bool                    mDeferLooseFileExpansion;
     AssetDefinition         mAssetDefinition;
     typeAssetIdVector       mAssetDependencies;
     typeLooseFileVector     mAssetLooseFiles;
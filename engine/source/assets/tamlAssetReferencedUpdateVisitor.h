@@ -47,15 +47,15 @@
 class TamlAssetReferencedUpdateVisitor : public TamlXmlVisitor
 {
 protected:
-    virtual bool visit( TiXmlElement* pXmlElement, TamlXmlParser& xmlParser ) { return true; }
+    virtual bool visit( TamlXmlElement* pXmlElement, TamlXmlParser& xmlParser ) { return true; }
 
-    virtual bool visit( TiXmlAttribute* pAttribute, TamlXmlParser& xmlParser )
+    virtual bool visit( TamlXmlAttribute* pAttribute, TamlXmlParser& xmlParser )
     {
         // Debug Profiling.
         PROFILE_SCOPE(TamlAssetReferencedUpdateVisitor_VisitAttribute);
 
         // Fetch attribute value.
-        const char* pAttributeValue = pAttribute->Value();
+        const char* pAttributeValue = pAttribute->getValue();
 
         // Fetch attribute value word count.
         const U32 valueWordCount = StringUnit::getUnitCount( pAttributeValue, ASSET_ASSIGNMENT_TOKEN );
@@ -79,7 +79,7 @@ protected:
         if ( mAssetIdTo == StringTable->EmptyString )
         {
             // Yes, so set the attribute as empty.
-            pAttribute->SetValue( StringTable->EmptyString );
+            pAttribute->setValue( StringTable->EmptyString );
             return true;
         }
 
@@ -88,7 +88,7 @@ protected:
         dSprintf( assetBuffer, sizeof(assetBuffer), "%s%s%s", ASSET_ID_SIGNATURE, ASSET_ASSIGNMENT_TOKEN, mAssetIdTo );
 
         // Assign new value.
-        pAttribute->SetValue( assetBuffer );
+        pAttribute->setValue( assetBuffer );
 
         return true;
     }
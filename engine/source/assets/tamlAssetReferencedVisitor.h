@@ -39,15 +39,15 @@
 class TamlAssetReferencedVisitor : public TamlXmlVisitor
 {
 protected:
-    virtual bool visit( TiXmlElement* pXmlElement, TamlXmlParser& xmlParser ) { return true; }
+    virtual bool visit( TamlXmlElement* pXmlElement, TamlXmlParser& xmlParser ) { return true; }
 
-    virtual bool visit( TiXmlAttribute* pAttribute, TamlXmlParser& xmlParser )
+    virtual bool visit( TamlXmlAttribute* pAttribute, TamlXmlParser& xmlParser )
     {
         // Debug Profiling.
         PROFILE_SCOPE(TamlAssetReferencedVisitor_VisitAttribute);
 
         // Fetch asset reference.
-        const char* pAssetReference = pAttribute->Value();
+        const char* pAssetReference = pAttribute->getValue();
 
         // Fetch field word count.
         const U32 fieldWordCount = StringUnit::getUnitCount( pAssetReference, ASSET_ASSIGNMENT_TOKEN );
@@ -17,6 +17,7 @@
 */
 
 #include <Box2D/Common/b2Settings.h>
+#include "memory/memoryAllocator.h"
 #include <cstdlib>
 #include <cstdio>
 #include <cstdarg>
@@ -26,12 +27,12 @@ b2Version b2_version = {2, 3, 0};
 // Memory allocators. Modify these to use your own allocator.
 void* b2Alloc(int32 size)
 {
-	return malloc(size);
+	return MemoryAllocator::allocate(size, MemoryAllocator::Box2DTag);
 }
 
 void b2Free(void* mem)
 {
-	free(mem);
+	MemoryAllocator::free(mem);
 }
 
 // You can modify this to use your logging facility.
@@ -0,0 +1,361 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _FLAT_HASH_MAP_H_
+#define _FLAT_HASH_MAP_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//-----------------------------------------------------------------------------
+/// An open addressing hash map for keys that are compared by value, such as
+/// StringTableEntry or SimObject pointers.
+///
+/// Keys and values are stored inline in a single power of two sized array and
+/// collisions are resolved by linear probing.  Erasing shifts the following
+/// entries back so no tombstones are left behind and lookups never degrade
+/// after many adds and removes.  The table grows once it is three quarters
+/// full and does not allocate anything until the first insert.
+///
+/// <b>***WARNING***</b>
+///
+/// Like Vector, this template does not construct or destruct keys or values
+/// so they must be simple types.  A key with all bits zero marks an empty slot
+/// and can't be inserted.  Inserting or erasing invalidates iterators and
+/// pointers to values.
+template<typename Key, typename Value>
+class FlatHashMap
+{
+public:
+   struct Pair
+   {
+      Key key;
+      Value value;
+   };
+
+   /// Iterates the occupied slots in table order.
+   class iterator
+   {
+      friend class FlatHashMap;
+
+      Pair* mSlot;
+      Pair* mEnd;
+
+      iterator( Pair* slot, Pair* end ) : mSlot( slot ), mEnd( end ) { skipEmpty(); }
+
+      void skipEmpty()
+      {
+         while ( mSlot != mEnd && mSlot->key == Key(0) )
+            mSlot++;
+      }
+
+   public:
+      iterator() : mSlot( NULL ), mEnd( NULL ) {}
+
+      iterator& operator++() { mSlot++; skipEmpty(); return *this; }
+      Pair& operator*() const { return *mSlot; }
+      Pair* operator->() const { return mSlot; }
+      bool operator==( const iterator& other ) const { return mSlot == other.mSlot; }
+      bool operator!=( const iterator& other ) const { return mSlot != other.mSlot; }
+   };
+
+private:
+   Pair* mTable;
+   U32   mTableSize;
+   U32   mCount;
+   U32   mShift;
+
+   /// Fibonacci hashing spreads aligned pointers over the high bits which we
+   /// then use as the home slot.
+   U32 getHomeSlot( const Key& key ) const
+   {
+      const U32 hash = U32( (size_t)key ) ^ U32( ((size_t)key) >> 16 );
+      return (hash * 2654435769u) >> mShift;
+   }
+
+   void rehash( const U32 newSize );
+
+public:
+   FlatHashMap() : mTable( NULL ), mTableSize( 0 ), mCount( 0 ), mShift( 32 ) {}
+   FlatHashMap( const FlatHashMap& other );
+   ~FlatHashMap() { reset(); }
+
+   FlatHashMap& operator=( const FlatHashMap& other );
+
+   /// @name Lookup
+   /// @{
+
+   /// Find the value stored for a key.
+   /// @return A pointer to the value or NULL if the key is not present.
+   Value* find( const Key& key ) const;
+
+   bool contains( const Key& key ) const { return find( key ) != NULL; }
+
+   /// @}
+
+   /// @name Modification
+   /// @{
+
+   /// Find the value for a key, adding an uninitialized value if the key is not present.
+   /// @param key The key to find or add.
+   /// @param pInserted Set to whether the key was added.
+   /// @return The value stored for the key.
+   Value& findOrInsert( const Key& key, bool* pInserted = NULL );
+
+   /// Set the value for a key, adding it if it is not present.
+   void insert( const Key& key, const Value& value ) { findOrInsert( key ) = value; }
+
+   /// Remove a key.
+   /// @return Whether the key was present.
+   bool erase( const Key& key );
+
+   /// Remove all keys but keep the table allocated.
+   void clear();
+
+   /// Remove all keys and release the table.
+   void reset();
+
+   /// Make room for the specified number of keys without growing.
+   void reserve( const U32 count );
+
+   /// @}
+
+   /// @name Iteration
+   /// @{
+
+   iterator begin() const { return iterator( mTable, mTable + mTableSize ); }
+   iterator end() const { return iterator( mTable + mTableSize, mTable + mTableSize ); }
+
+   /// @}
+
+   U32 size() const { return mCount; }
+   bool isEmpty() const { return mCount == 0; }
+   U32 getTableSize() const { return mTableSize; }
+};
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+FlatHashMap<Key,Value>::FlatHashMap( const FlatHashMap& other ) : mTable( NULL ), mTableSize( 0 ), mCount( 0 ), mShift( 32 )
+{
+   *this = other;
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+FlatHashMap<Key,Value>& FlatHashMap<Key,Value>::operator=( const FlatHashMap& other )
+{
+   if ( this == &other )
+      return *this;
+
+   reset();
+
+   if ( other.mTableSize > 0 )
+   {
+      mTable = (Pair*)dMalloc( other.mTableSize * sizeof(Pair) );
+      dMemcpy( mTable, other.mTable, other.mTableSize * sizeof(Pair) );
+      mTableSize = other.mTableSize;
+      mCount = other.mCount;
+      mShift = other.mShift;
+   }
+
+   return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+Value* FlatHashMap<Key,Value>::find( const Key& key ) const
+{
+   if ( mCount == 0 )
+      return NULL;
+
+   const U32 mask = mTableSize - 1;
+   for ( U32 index = getHomeSlot( key ); ; index = (index + 1) & mask )
+   {
+      Pair& slot = mTable[index];
+
+      if ( slot.key == key )
+         return &slot.value;
+
+      if ( slot.key == Key(0) )
+         return NULL;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+Value& FlatHashMap<Key,Value>::findOrInsert( const Key& key, bool* pInserted )
+{
+   AssertFatal( key != Key(0), "FlatHashMap::findOrInsert() - The empty key cannot be inserted." );
+
+   // Grow when three quarters full.
+   if ( (mCount + 1) * 4 > mTableSize * 3 )
+   {
+      // Check the key is not already present before growing.
+      Value* pValue = find( key );
+      if ( pValue != NULL )
+      {
+         if ( pInserted != NULL )
+            *pInserted = false;
+         return *pValue;
+      }
+
+      rehash( mTableSize == 0 ? 8 : mTableSize * 2 );
+   }
+
+   const U32 mask = mTableSize - 1;
+   for ( U32 index = getHomeSlot( key ); ; index = (index + 1) & mask )
+   {
+      Pair& slot = mTable[index];
+
+      if ( slot.key == key )
+      {
+         if ( pInserted != NULL )
+            *pInserted = false;
+         return slot.value;
+      }
+
+      if ( slot.key == Key(0) )
+      {
+         slot.key = key;
+         mCount++;
+         if ( pInserted != NULL )
+            *pInserted = true;
+         return slot.value;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+bool FlatHashMap<Key,Value>::erase( const Key& key )
+{
+   if ( mCount == 0 )
+      return false;
+
+   const U32 mask = mTableSize - 1;
+   U32 index = getHomeSlot( key );
+   while ( mTable[index].key != key )
+   {
+      if ( mTable[index].key == Key(0) )
+         return false;
+
+      index = (index + 1) & mask;
+   }
+
+   // Shift following entries back into the hole unless doing so would move
+   // them in front of their home slot.
+   U32 hole = index;
+   for ( U32 next = (hole + 1) & mask; mTable[next].key != Key(0); next = (next + 1) & mask )
+   {
+      const U32 home = getHomeSlot( mTable[next].key );
+      if ( ((next - home) & mask) >= ((next - hole) & mask) )
+      {
+         mTable[hole] = mTable[next];
+         hole = next;
+      }
+   }
+
+   mTable[hole].key = Key(0);
+   mCount--;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::clear()
+{
+   if ( mTable != NULL )
+      dMemset( mTable, 0, mTableSize * sizeof(Pair) );
+
+   mCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::reset()
+{
+   if ( mTable != NULL )
+      dFree( mTable );
+
+   mTable = NULL;
+   mTableSize = 0;
+   mCount = 0;
+   mShift = 32;
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::reserve( const U32 count )
+{
+   U32 newSize = mTableSize == 0 ? 8 : mTableSize;
+   while ( count * 4 > newSize * 3 )
+      newSize *= 2;
+
+   if ( newSize != mTableSize )
+      rehash( newSize );
+}
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::rehash( const U32 newSize )
+{
+   Pair* pOldTable = mTable;
+   const U32 oldSize = mTableSize;
+
+   mTable = (Pair*)dMalloc( newSize * sizeof(Pair) );
+   dMemset( mTable, 0, newSize * sizeof(Pair) );
+   mTableSize = newSize;
+
+   mShift = 32;
+   for ( U32 size = newSize; size > 1; size >>= 1 )
+      mShift--;
+
+   const U32 mask = newSize - 1;
+   for ( U32 oldIndex = 0; oldIndex < oldSize; ++oldIndex )
+   {
+      const Pair& pair = pOldTable[oldIndex];
+      if ( pair.key == Key(0) )
+         continue;
+
+      U32 index = getHomeSlot( pair.key );
+      while ( mTable[index].key != Key(0) )
+         index = (index + 1) & mask;
+
+      mTable[index] = pair;
+   }
+
+   if ( pOldTable != NULL )
+      dFree( pOldTable );
+}
+
+#endif // _FLAT_HASH_MAP_H_
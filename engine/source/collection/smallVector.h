@@ -0,0 +1,418 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SMALL_VECTOR_H_
+#define _SMALL_VECTOR_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//-----------------------------------------------------------------------------
+/// A dynamic array that keeps its first N elements inside the object.
+///
+/// Use it for short lived lists that usually hold a handful of elements,
+/// such as a function's temporary results.  Nothing is allocated until the
+/// list outgrows its inline storage, after which the elements move to the
+/// heap and the capacity doubles as it grows.
+///
+/// Unlike Vector, elements are properly constructed, copied and destructed
+/// so the template can hold classes with constructors and destructors.  When
+/// the compiler supports rvalue references elements are moved rather than
+/// copied when the storage grows.  Like Vector, the pushing or erasing of
+/// elements invalidates iterators and pointers to elements.
+///
+/// The inline storage is aligned for doubles and pointers only.
+///
+/// @nosubgrouping
+template<class T, U32 N>
+class SmallVector
+{
+  protected:
+   U32 mElementCount;
+   U32 mArraySize;
+   T*  mArray;
+
+   union InlineStorage
+   {
+      U8    mBytes[N * sizeof(T)];
+      F64   mAlignDouble;
+      void* mAlignPointer;
+   };
+   InlineStorage mInlineStorage;
+
+   inline T* getInlineArray() { return (T*)mInlineStorage.mBytes; }
+
+   void grow(U32 size);
+   void relocate(T* dst, T* src, U32 count);
+   void destroy(U32 start, U32 end);
+
+  public:
+   SmallVector();
+   SmallVector(const SmallVector&);
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+   SmallVector(SmallVector&&);
+#endif
+   ~SmallVector();
+
+   SmallVector& operator=(const SmallVector& p);
+
+   /// @name STL interface
+   /// @{
+
+   typedef T        value_type;
+   typedef T&       reference;
+   typedef const T& const_reference;
+
+   typedef T*       iterator;
+   typedef const T* const_iterator;
+   typedef S32      difference_type;
+   typedef U32      size_type;
+
+   iterator       begin()          { return mArray; }
+   const_iterator begin() const    { return mArray; }
+   iterator       end()            { return mArray + mElementCount; }
+   const_iterator end() const      { return mArray + mElementCount; }
+
+   S32  size() const               { return (S32)mElementCount; }
+   bool empty() const              { return mElementCount == 0; }
+   bool contains(const T&) const;
+
+   T&       front();
+   const T& front() const;
+   T&       back();
+   const T& back() const;
+
+   void push_back(const T&);
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+   void push_back(T&&);
+#endif
+   void pop_back();
+
+   T& operator[](U32);
+   const T& operator[](U32) const;
+
+   T& operator[](S32 i)              { return operator[](U32(i)); }
+   const T& operator[](S32 i ) const { return operator[](U32(i)); }
+
+   void reserve(U32);
+   U32  capacity() const           { return mArraySize; }
+
+   /// @}
+
+   /// @name Extended interface
+   /// @{
+
+   T*   address() const            { return mArray; }
+
+   /// Resizes the list, default constructing any new elements.
+   void setSize(U32);
+
+   void insert(U32, const T&);
+   void erase(U32);
+   void erase_fast(U32);
+   void clear();
+   S32  find_next(const T&, U32 start = 0) const;
+   T&       first()                { return front(); }
+   T&       last()                 { return back(); }
+   const T& first() const          { return front(); }
+   const T& last() const           { return back(); }
+
+   /// Returns true while the elements are held in the inline storage.
+   bool isInline() const           { return mArray == (const T*)mInlineStorage.mBytes; }
+
+   /// @}
+};
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 N> inline SmallVector<T,N>::SmallVector()
+{
+   mElementCount = 0;
+   mArraySize    = N;
+   mArray        = getInlineArray();
+}
+
+template<class T, U32 N> inline SmallVector<T,N>::SmallVector(const SmallVector& p)
+{
+   mElementCount = 0;
+   mArraySize    = N;
+   mArray        = getInlineArray();
+
+   reserve(p.mElementCount);
+   for (U32 i = 0; i < p.mElementCount; i++)
+      constructInPlace(&mArray[i], &p.mArray[i]);
+   mElementCount = p.mElementCount;
+}
+
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+template<class T, U32 N> inline SmallVector<T,N>::SmallVector(SmallVector&& p)
+{
+   mElementCount = 0;
+   mArraySize    = N;
+   mArray        = getInlineArray();
+
+   if (p.isInline())
+   {
+      // Inline elements can't be stolen so move them one by one.
+      relocate(mArray, p.mArray, p.mElementCount);
+      mElementCount = p.mElementCount;
+      p.mElementCount = 0;
+   }
+   else
+   {
+      mArray        = p.mArray;
+      mArraySize    = p.mArraySize;
+      mElementCount = p.mElementCount;
+
+      p.mElementCount = 0;
+      p.mArraySize    = N;
+      p.mArray        = p.getInlineArray();
+   }
+}
+#endif
+
+template<class T, U32 N> inline SmallVector<T,N>::~SmallVector()
+{
+   destroy(0, mElementCount);
+   if (!isInline())
+      dFree(mArray);
+}
+
+template<class T, U32 N> inline SmallVector<T,N>& SmallVector<T,N>::operator=(const SmallVector& p)
+{
+   if (this == &p)
+      return *this;
+
+   clear();
+   reserve(p.mElementCount);
+   for (U32 i = 0; i < p.mElementCount; i++)
+      constructInPlace(&mArray[i], &p.mArray[i]);
+   mElementCount = p.mElementCount;
+
+   return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 N> inline void SmallVector<T,N>::destroy(U32 start, U32 end)
+{
+   while (start < end)
+      destructInPlace(&mArray[start++]);
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::relocate(T* dst, T* src, U32 count)
+{
+   // Moves elements to storage that does not overlap and destructs the originals.
+   for (U32 i = 0; i < count; i++)
+   {
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+      new (&dst[i]) T(static_cast<T&&>(src[i]));
+#else
+      constructInPlace(&dst[i], &src[i]);
+#endif
+      destructInPlace(&src[i]);
+   }
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::grow(U32 size)
+{
+   U32 newSize = mArraySize * 2;
+   if (newSize < size)
+      newSize = size;
+
+   T* newArray = (T*)dMalloc(newSize * sizeof(T));
+   relocate(newArray, mArray, mElementCount);
+
+   if (!isInline())
+      dFree(mArray);
+
+   mArray     = newArray;
+   mArraySize = newSize;
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::reserve(U32 size)
+{
+   if (size > mArraySize)
+      grow(size);
+}
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 N> inline bool SmallVector<T,N>::contains(const T& x) const
+{
+   return find_next(x) != -1;
+}
+
+template<class T, U32 N> inline S32 SmallVector<T,N>::find_next(const T& x, U32 start) const
+{
+   for (U32 i = start; i < mElementCount; i++)
+   {
+      if (mArray[i] == x)
+         return (S32)i;
+   }
+
+   return -1;
+}
+
+template<class T, U32 N> inline T& SmallVector<T,N>::front()
+{
+   AssertFatal(mElementCount != 0, "SmallVector<T,N>::front - Error, no first element of a zero sized array!");
+   return mArray[0];
+}
+
+template<class T, U32 N> inline const T& SmallVector<T,N>::front() const
+{
+   AssertFatal(mElementCount != 0, "SmallVector<T,N>::front - Error, no first element of a zero sized array! (const)");
+   return mArray[0];
+}
+
+template<class T, U32 N> inline T& SmallVector<T,N>::back()
+{
+   AssertFatal(mElementCount != 0, "SmallVector<T,N>::back - Error, no last element of a zero sized array!");
+   return mArray[mElementCount - 1];
+}
+
+template<class T, U32 N> inline const T& SmallVector<T,N>::back() const
+{
+   AssertFatal(mElementCount != 0, "SmallVector<T,N>::back - Error, no last element of a zero sized array! (const)");
+   return mArray[mElementCount - 1];
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::push_back(const T& x)
+{
+   if (mElementCount == mArraySize)
+   {
+      // The element may live in this vector so copy it before growing.
+      T copy(x);
+      grow(mElementCount + 1);
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+      new (&mArray[mElementCount]) T(static_cast<T&&>(copy));
+#else
+      constructInPlace(&mArray[mElementCount], &copy);
+#endif
+   }
+   else
+   {
+      constructInPlace(&mArray[mElementCount], &x);
+   }
+
+   mElementCount++;
+}
+
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+template<class T, U32 N> inline void SmallVector<T,N>::push_back(T&& x)
+{
+   if (mElementCount == mArraySize)
+   {
+      T copy(static_cast<T&&>(x));
+      grow(mElementCount + 1);
+      new (&mArray[mElementCount]) T(static_cast<T&&>(copy));
+   }
+   else
+   {
+      new (&mArray[mElementCount]) T(static_cast<T&&>(x));
+   }
+
+   mElementCount++;
+}
+#endif
+
+template<class T, U32 N> inline void SmallVector<T,N>::pop_back()
+{
+   AssertFatal(mElementCount != 0, "SmallVector<T,N>::pop_back - cannot pop the back of a zero-length vector.");
+   destructInPlace(&mArray[--mElementCount]);
+}
+
+template<class T, U32 N> inline T& SmallVector<T,N>::operator[](U32 index)
+{
+   AssertFatal(index < mElementCount, "SmallVector<T,N>::operator[] - out of bounds array access!");
+   return mArray[index];
+}
+
+template<class T, U32 N> inline const T& SmallVector<T,N>::operator[](U32 index) const
+{
+   AssertFatal(index < mElementCount, "SmallVector<T,N>::operator[] - out of bounds array access!");
+   return mArray[index];
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::setSize(U32 size)
+{
+   if (size < mElementCount)
+   {
+      destroy(size, mElementCount);
+   }
+   else
+   {
+      reserve(size);
+      for (U32 i = mElementCount; i < size; i++)
+         constructInPlace(&mArray[i]);
+   }
+
+   mElementCount = size;
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::insert(U32 index, const T& x)
+{
+   AssertFatal(index <= mElementCount, "SmallVector<T,N>::insert - out of bounds index!");
+
+   if (index == mElementCount)
+   {
+      push_back(x);
+      return;
+   }
+
+   // Shift the tail up by assignment, constructing the new last element.
+   T copy(x);
+   push_back(mArray[mElementCount - 1]);
+   for (U32 i = mElementCount - 2; i > index; i--)
+      mArray[i] = mArray[i - 1];
+   mArray[index] = copy;
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::erase(U32 index)
+{
+   AssertFatal(index < mElementCount, "SmallVector<T,N>::erase - out of bounds index!");
+
+   for (U32 i = index + 1; i < mElementCount; i++)
+      mArray[i - 1] = mArray[i];
+   pop_back();
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::erase_fast(U32 index)
+{
+   AssertFatal(index < mElementCount, "SmallVector<T,N>::erase_fast - out of bounds index.");
+
+   // CAUTION: this operator does NOT maintain list order
+   // Copy the last element into the deleted 'hole' and shrink the list.
+   if (index < (mElementCount - 1))
+      mArray[index] = mArray[mElementCount - 1];
+   pop_back();
+}
+
+template<class T, U32 N> inline void SmallVector<T,N>::clear()
+{
+   destroy(0, mElementCount);
+   mElementCount = 0;
+}
+
+#endif // _SMALL_VECTOR_H_
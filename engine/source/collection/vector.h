@@ -88,6 +88,9 @@ class Vector
    Vector(const U32 initialSize, const char* fileName, const U32 lineNum);
    Vector(const char* fileName, const U32 lineNum);
    Vector(const Vector&);
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+   Vector(Vector&&);
+#endif
    ~Vector();
 
 #ifdef TORQUE_DEBUG
@@ -109,6 +112,9 @@ class Vector
    typedef difference_type (QSORT_CALLBACK *compare_func)(const T *a, const T *b);
 
    Vector<T>& operator=(const Vector<T>& p);
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+   Vector<T>& operator=(Vector<T>&& p);
+#endif
 
    iterator       begin();
    const_iterator begin() const;
@@ -160,6 +166,7 @@ class Vector
    void decrement(U32 = 1);
    void insert(U32);
    void erase(U32);
+   void erase(U32 index, U32 count);
    void erase_fast(U32);
    void erase_fast(iterator);
    void clear();
@@ -174,6 +181,10 @@ class Vector
 
    void merge(const Vector& p);
 
+   /// Exchanges the elements of two vectors without copying or allocating.
+   /// This is the cheap way to hand a temporary vector to its owner.
+   void swap(Vector& p);
+
    /// @}
 };
 
@@ -246,6 +257,24 @@ template<class T> inline Vector<T>::Vector(const Vector& p)
       dMemcpy(mArray,p.mArray,mElementCount * sizeof(value_type));
 }
 
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+template<class T> inline Vector<T>::Vector(Vector&& p)
+{
+#ifdef TORQUE_DEBUG
+   mFileAssociation = p.mFileAssociation;
+   mLineAssociation = p.mLineAssociation;
+#endif
+
+   mArray        = p.mArray;
+   mElementCount = p.mElementCount;
+   mArraySize    = p.mArraySize;
+
+   p.mArray        = 0;
+   p.mElementCount = 0;
+   p.mArraySize    = 0;
+}
+#endif
+
 
 #ifdef TORQUE_DEBUG
 template<class T> inline void Vector<T>::setFileAssociation(const char* file,
@@ -361,6 +390,20 @@ template<class T> inline void Vector<T>::erase(U32 index)
    mElementCount--;
 }
 
+template<class T> inline void Vector<T>::erase(U32 index, U32 count)
+{
+   AssertFatal(index + count <= mElementCount, "Vector<T>::erase - out of bounds range!");
+
+   if (index + count < mElementCount)
+   {
+      dMemmove(&mArray[index],
+         &mArray[index + count],
+         (mElementCount - index - count) * sizeof(value_type));
+   }
+
+   mElementCount -= count;
+}
+
 template<class T> inline void Vector<T>::erase_fast(U32 index)
 {
    AssertFatal(index < mElementCount, "Vector<T>::erase_fast - out of bounds index.");
@@ -426,6 +469,26 @@ template<class T> inline Vector<T>& Vector<T>::operator=(const Vector<T>& p)
    return *this;
 }
 
+#ifdef TORQUE_SUPPORTS_RVALUE_REFERENCES
+template<class T> inline Vector<T>& Vector<T>::operator=(Vector<T>&& p)
+{
+   if (this != &p)
+   {
+      dFree(mArray);
+
+      mArray        = p.mArray;
+      mElementCount = p.mElementCount;
+      mArraySize    = p.mArraySize;
+
+      p.mArray        = 0;
+      p.mElementCount = 0;
+      p.mArraySize    = 0;
+   }
+
+   return *this;
+}
+#endif
+
 template<class T> inline typename Vector<T>::iterator Vector<T>::begin()
 {
    return mArray;
@@ -634,6 +697,21 @@ template<class T> inline void Vector<T>::merge(const Vector& p)
    dMemcpy( &mArray[oldsize], p.address(), p.size() * sizeof(T) );
 }
 
+template<class T> inline void Vector<T>::swap(Vector& p)
+{
+   T* array = mArray;
+   mArray = p.mArray;
+   p.mArray = array;
+
+   const U32 elementCount = mElementCount;
+   mElementCount = p.mElementCount;
+   p.mElementCount = elementCount;
+
+   const U32 arraySize = mArraySize;
+   mArraySize = p.mArraySize;
+   p.mArraySize = arraySize;
+}
+
 //-----------------------------------------------------------------------------
 /// Template for vectors of pointers.
 template <class T>
@@ -80,6 +80,20 @@ void BehaviorComponent::onRemove()
 
 //-----------------------------------------------------------------------------
 
+void BehaviorComponent::resetObjectState( void )
+{
+    // Sanity!
+    AssertFatal( mBehaviors.size() == 0, "BehaviorComponent::resetObjectState() - Behaviors were not removed." );
+
+    // Reset the master behavior Id.
+    mMasterBehaviorId = 1;
+
+    // Call parent.
+    Parent::resetObjectState();
+}
+
+//-----------------------------------------------------------------------------
+
 void BehaviorComponent::onDeleteNotify( SimObject *object )
 {
     // Cast to a behavior instance.
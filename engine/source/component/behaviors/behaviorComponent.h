@@ -84,6 +84,9 @@ protected:
     virtual void onTamlCustomWrite( TamlCustomNodes& customNodes );
     virtual void onTamlCustomRead( const TamlCustomNodes& customNodes );
 
+    /// Object pool support.
+    void resetObjectState( void );
+
 private:
     void destroyBehaviorOutputConnections( BehaviorInstance* pOutputBehavior );
     void destroyBehaviorInputConnections( BehaviorInstance* pInputBehavior );
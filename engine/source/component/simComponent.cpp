@@ -108,6 +108,16 @@ void SimComponent::_unregisterComponents()
    unlockComponentList();
 }
 
+void SimComponent::resetObjectState()
+{
+   AssertFatal( mComponentList.empty(), "SimComponent::resetObjectState() - Components were not removed." );
+
+   mOwner = NULL;
+   mEnabled = true;
+
+   Parent::resetObjectState();
+}
+
 void SimComponent::onRemove()
 {
    _unregisterComponents();
@@ -100,6 +100,8 @@ protected:
       mOwner = NULL;
    }
 
+   /// Object pool support.
+   void resetObjectState();
 
 public:
    DECLARE_CONOBJECT(SimComponent);
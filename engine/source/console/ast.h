@@ -158,7 +158,7 @@ struct BinaryExprNode : ExprNode
 
 struct FloatBinaryExprNode : BinaryExprNode
 {
-   static FloatBinaryExprNode *alloc(S32 op, ExprNode *left, ExprNode *right);
+   static ExprNode *alloc(S32 op, ExprNode *left, ExprNode *right);
    U32 precompile(TypeReq type);
    U32 compile(U32 *codeStream, U32 ip, TypeReq type);
    TypeReq getPreferredType();
@@ -181,7 +181,7 @@ struct IntBinaryExprNode : BinaryExprNode
    TypeReq subType;
    U32 operand;
 
-   static IntBinaryExprNode *alloc(S32 op, ExprNode *left, ExprNode *right);
+   static ExprNode *alloc(S32 op, ExprNode *left, ExprNode *right);
 
    void getSubTypeOperand();
    U32 precompile(TypeReq type);
@@ -222,7 +222,7 @@ struct IntUnaryExprNode : ExprNode
    ExprNode *expr;
    bool integer;
 
-   static IntUnaryExprNode *alloc(S32 op, ExprNode *expr);
+   static ExprNode *alloc(S32 op, ExprNode *expr);
    U32 precompile(TypeReq type);
    U32 compile(U32 *codeStream, U32 ip, TypeReq type);
    TypeReq getPreferredType();
@@ -233,7 +233,7 @@ struct FloatUnaryExprNode : ExprNode
    S32 op;
    ExprNode *expr;
 
-   static FloatUnaryExprNode *alloc(S32 op, ExprNode *expr);
+   static ExprNode *alloc(S32 op, ExprNode *expr);
    U32 precompile(TypeReq type);
    U32 compile(U32 *codeStream, U32 ip, TypeReq type);
    TypeReq getPreferredType();
@@ -23,6 +23,7 @@
 #include "console/console.h"
 #include "console/compiler.h"
 #include "console/consoleInternal.h"
+#include "math/mMathFn.h"
 
 using namespace Compiler;
 
@@ -34,6 +35,10 @@ using namespace Compiler;
 /// all allocate memory from the consoleAllocator for efficiency, and often take
 /// arguments relating to the state of the nodes. They are called from gram.y
 /// (really gram.c) as the lexer analyzes the script code.
+///
+/// The arithmetic, comparison and unary expression allocators fold their
+/// operands when they are all numeric literals, returning a literal node in
+/// place of the expression.
 
 //------------------------------------------------------------
 
@@ -93,8 +98,85 @@ LoopStmtNode *LoopStmtNode::alloc(S32 lineNumber, ExprNode *initExpr, ExprNode *
    return ret;
 }
 
-FloatBinaryExprNode *FloatBinaryExprNode::alloc(S32 op, ExprNode *left, ExprNode *right)
+//------------------------------------------------------------
+
+/// Fetches the value of a numeric literal, or of a negated numeric literal,
+/// so that it can take part in constant folding.
+static bool getNumericConstant(ExprNode *expr, F64 &value)
+{
+   if(IntNode *intNode = dynamic_cast<IntNode *>(expr))
+   {
+      // Large hex constants wrap to negative values and convert differently
+      // depending on the requested type so leave them alone.
+      if(intNode->value < 0)
+         return false;
+      value = intNode->value;
+      return true;
+   }
+   if(FloatNode *floatNode = dynamic_cast<FloatNode *>(expr))
+   {
+      value = floatNode->value;
+      return true;
+   }
+   if(FloatUnaryExprNode *negateNode = dynamic_cast<FloatUnaryExprNode *>(expr))
+   {
+      if(!getNumericConstant(negateNode->expr, value))
+         return false;
+      value = -value;
+      return true;
+   }
+   return false;
+}
+
+/// Returns true if a folded value behaves identically whether the VM loads
+/// it as an integer immediate or converts it from a float.
+static bool isFoldableInteger(F64 value)
+{
+   return value >= 0 && value < 2147483648.0 && value == mFloorD(value);
+}
+
+/// Allocates the literal for a folded float expression or returns NULL if
+/// the value cannot be represented without changing its behavior.
+static ExprNode *allocFoldedFloat(F64 value)
 {
+   // Integer immediates are zero-extended by the VM so keep the value within
+   // a signed 32-bit range and let negative values keep their OP_NEG.  This
+   // also rejects NaN and infinities.
+   if(!(value > -2147483648.0 && value < 2147483648.0))
+      return NULL;
+
+   if(value < 0)
+      return FloatUnaryExprNode::alloc('-', FloatNode::alloc(-value));
+
+   return FloatNode::alloc(value);
+}
+
+ExprNode *FloatBinaryExprNode::alloc(S32 op, ExprNode *left, ExprNode *right)
+{
+   F64 leftValue, rightValue;
+   if(gOptimizeBytecode && getNumericConstant(left, leftValue) && getNumericConstant(right, rightValue))
+   {
+      ExprNode *folded = NULL;
+      switch(op)
+      {
+      case '+':
+         folded = allocFoldedFloat(leftValue + rightValue);
+         break;
+      case '-':
+         folded = allocFoldedFloat(leftValue - rightValue);
+         break;
+      case '*':
+         folded = allocFoldedFloat(leftValue * rightValue);
+         break;
+      case '/':
+         if(rightValue != 0)
+            folded = allocFoldedFloat(leftValue / rightValue);
+         break;
+      }
+      if(folded)
+         return folded;
+   }
+
    FloatBinaryExprNode *ret = (FloatBinaryExprNode *) consoleAlloc(sizeof(FloatBinaryExprNode));
    constructInPlace(ret);
 
@@ -105,8 +187,68 @@ FloatBinaryExprNode *FloatBinaryExprNode::alloc(S32 op, ExprNode *left, ExprNode
    return ret;
 }
 
-IntBinaryExprNode *IntBinaryExprNode::alloc(S32 op, ExprNode *left, ExprNode *right)
+ExprNode *IntBinaryExprNode::alloc(S32 op, ExprNode *left, ExprNode *right)
 {
+   F64 leftValue, rightValue;
+   if(gOptimizeBytecode && getNumericConstant(left, leftValue) && getNumericConstant(right, rightValue))
+   {
+      // Comparisons are evaluated on the float stack.
+      switch(op)
+      {
+      case '<':
+         return IntNode::alloc(leftValue < rightValue);
+      case '>':
+         return IntNode::alloc(leftValue > rightValue);
+      case opGE:
+         return IntNode::alloc(leftValue >= rightValue);
+      case opLE:
+         return IntNode::alloc(leftValue <= rightValue);
+      case opEQ:
+         return IntNode::alloc(leftValue == rightValue);
+      case opNE:
+         return IntNode::alloc(leftValue != rightValue);
+      }
+
+      // Everything else is evaluated on the integer stack.
+      if(isFoldableInteger(leftValue) && isFoldableInteger(rightValue))
+      {
+         const S64 a = S64(leftValue);
+         const S64 b = S64(rightValue);
+         S64 result = -1;
+         switch(op)
+         {
+         case '^':
+            result = a ^ b;
+            break;
+         case '%':
+            result = b ? a % b : 0;
+            break;
+         case '&':
+            result = a & b;
+            break;
+         case '|':
+            result = a | b;
+            break;
+         case opOR:
+            result = a || b;
+            break;
+         case opAND:
+            result = a && b;
+            break;
+         case opSHR:
+            if(b < 32)
+               result = a >> b;
+            break;
+         case opSHL:
+            if(b < 32)
+               result = a << b;
+            break;
+         }
+         if(result >= 0 && result <= S64(S32_MAX))
+            return IntNode::alloc(S32(result));
+      }
+   }
+
    IntBinaryExprNode *ret = (IntBinaryExprNode *) consoleAlloc(sizeof(IntBinaryExprNode));
    constructInPlace(ret);
 
@@ -149,8 +291,12 @@ CommaCatExprNode *CommaCatExprNode::alloc(ExprNode *left, ExprNode *right)
    return ret;
 }
 
-IntUnaryExprNode *IntUnaryExprNode::alloc(S32 op, ExprNode *expr)
+ExprNode *IntUnaryExprNode::alloc(S32 op, ExprNode *expr)
 {
+   F64 value;
+   if(gOptimizeBytecode && op == '!' && getNumericConstant(expr, value))
+      return IntNode::alloc(value == 0);
+
    IntUnaryExprNode *ret = (IntUnaryExprNode *) consoleAlloc(sizeof(IntUnaryExprNode));
    constructInPlace(ret);
    ret->op = op;
@@ -158,8 +304,14 @@ IntUnaryExprNode *IntUnaryExprNode::alloc(S32 op, ExprNode *expr)
    return ret;
 }
 
-FloatUnaryExprNode *FloatUnaryExprNode::alloc(S32 op, ExprNode *expr)
+ExprNode *FloatUnaryExprNode::alloc(S32 op, ExprNode *expr)
 {
+   // Only a double negation folds; a negated literal is already as compact
+   // as a negative literal can be.
+   F64 value;
+   if(gOptimizeBytecode && getNumericConstant(expr, value) && value < 0)
+      return FloatNode::alloc(-value);
+
    FloatUnaryExprNode *ret = (FloatUnaryExprNode *) consoleAlloc(sizeof(FloatUnaryExprNode));
    constructInPlace(ret);
    ret->op = op;
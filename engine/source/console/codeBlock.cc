@@ -255,6 +255,110 @@ const char *CodeBlock::getFileLine(U32 ip)
    return nameBuffer;
 }
 
+void CodeBlock::dumpInstructions(U32 startIp, U32 endIp)
+{
+   if(!code)
+      return;
+
+   if(!endIp || endIp > codeSize)
+      endIp = codeSize;
+
+   // The break pairs are packed with the original opcode once the break
+   // list has been calculated.
+   const bool packedBreaks = breakList != NULL;
+
+   char operands[1024];
+   U32 functionEnd = 0;
+
+   for(U32 ip = startIp; ip < endIp;)
+   {
+      U32 opcode = code[ip];
+
+      // Report the line and recover any instruction hidden by a breakpoint.
+      for(U32 i = 0; i < lineBreakPairCount; i++)
+      {
+         const U32 *p = lineBreakPairs + i * 2;
+         if(p[1] != ip)
+            continue;
+
+         Con::printf("   %s (%d):", name ? name : "<input>", packedBreaks ? (p[0] >> 8) : p[0]);
+         if(opcode == OP_BREAK && packedBreaks)
+            opcode = p[0] & 0xFF;
+         break;
+      }
+
+      const U32 size = getInstructionSize(opcode, code, ip);
+      const bool inFunction = ip < functionEnd;
+      const char *strings = inFunction ? functionStrings : globalStrings;
+      const F64 *floats = inFunction ? functionFloats : globalFloats;
+
+      operands[0] = 0;
+      switch(opcode)
+      {
+      case OP_FUNC_DECL:
+         {
+            StringTableEntry fnName = U32toSTE(code[ip + 1]);
+            StringTableEntry fnNamespace = U32toSTE(code[ip + 2]);
+            dSprintf(operands, sizeof(operands), "%s%s%s end=%d argc=%d",
+               fnNamespace ? fnNamespace : "", fnNamespace ? "::" : "", fnName, code[ip + 5], code[ip + 6]);
+            if(code[ip + 4])
+               functionEnd = code[ip + 5];
+         }
+         break;
+
+      case OP_SETCURVAR:
+      case OP_SETCURVAR_CREATE:
+      case OP_SETCURFIELD:
+      case OP_LOADIMMED_IDENT:
+      case OP_SETCURVAR_LOADVAR_UINT:
+      case OP_SETCURVAR_LOADVAR_FLT:
+      case OP_SETCURVAR_LOADVAR_STR:
+      case OP_SETCURVAR_CREATE_SAVEVAR_UINT:
+      case OP_SETCURVAR_CREATE_SAVEVAR_FLT:
+      case OP_SETCURVAR_CREATE_SAVEVAR_STR:
+         {
+            StringTableEntry ident = U32toSTE(code[ip + 1]);
+            dSprintf(operands, sizeof(operands), "%s", ident ? ident : "");
+         }
+         break;
+
+      case OP_CREATE_OBJECT:
+         {
+            StringTableEntry parent = U32toSTE(code[ip + 1]);
+            dSprintf(operands, sizeof(operands), "parent=%s fail=%d", parent ? parent : "", code[ip + 5]);
+         }
+         break;
+
+      case OP_CALLFUNC_RESOLVE:
+      case OP_CALLFUNC:
+         dSprintf(operands, sizeof(operands), "%s callType=%d", U32toSTE(code[ip + 1]), code[ip + 3]);
+         break;
+
+      case OP_LOADIMMED_FLT:
+         dSprintf(operands, sizeof(operands), "%g", floats ? floats[code[ip + 1]] : 0.0);
+         break;
+
+      case OP_LOADIMMED_STR:
+      case OP_TAG_TO_STR:
+      case OP_DOCBLOCK_STR:
+         dSprintf(operands, sizeof(operands), "\"%.64s\"", strings ? strings + code[ip + 1] : "");
+         break;
+
+      default:
+         // Print any remaining operands verbatim.
+         for(U32 i = 1; i < size; i++)
+         {
+            const U32 length = dStrlen(operands);
+            dSprintf(operands + length, sizeof(operands) - length, "%s%d", i > 1 ? " " : "", code[ip + i]);
+         }
+         break;
+      }
+
+      Con::printf("      %6d: %s %s", ip, getInstructionName(opcode), operands);
+      ip += size;
+   }
+}
+
 void CodeBlock::removeFromCodeList()
 {
    for(CodeBlock **walk = &smCodeBlockList; *walk; walk = &((*walk)->nextFile))
@@ -535,6 +639,8 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
       Con::errorf(ConsoleLogEntry::General, "CodeBlock::compile - precompile size mismatch, a precompile/compile function pair is probably mismatched.");
 
    code[lastIp++] = OP_RETURN;
+   optimizeCodeStream(code, codeSize, lineBreakPairs, lineBreakPairCount);
+
    U32 totSize = codeSize + smBreakLineCount * 2;
    st.write(codeSize);
    st.write(lineBreakPairCount);
@@ -636,6 +742,7 @@ const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string
    smBreakLineCount = 0;
    U32 lastIp = compileBlock(statementList, code, 0, 0, 0);
    code[lastIp++] = OP_RETURN;
+   optimizeCodeStream(code, codeSize, lineBreakPairs, lineBreakPairCount);
    
    consoleAllocReset();
 
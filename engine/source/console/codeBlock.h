@@ -104,6 +104,11 @@ public:
    void getFunctionArgs(char buffer[1024], U32 offset);
    const char *getFileLine(U32 ip);
 
+   /// Prints a disassembly of the code to the console.
+   /// @param startIp The ip of the first instruction to print.
+   /// @param endIp The ip to stop printing at or zero for the end of the code.
+   void dumpInstructions(U32 startIp = 0, U32 endIp = 0);
+
    bool read(StringTableEntry fileName, Stream &st);
    bool compile(const char *dsoName, StringTableEntry fileName, const char *script);
 
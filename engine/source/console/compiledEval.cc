@@ -32,6 +32,8 @@
 #include "console/consoleInternal.h"
 #include "io/fileStream.h"
 #include "console/compiler.h"
+#include "console/scriptTask.h"
+#include "console/scriptProfiler.h"
 
 #include "sim/simBase.h"
 #include "network/netStringTable.h"
@@ -39,6 +41,8 @@
 #include "string/stringStack.h"
 #include "messaging/message.h"
 #include "memory/frameAllocator.h"
+#include "memory/memoryAllocator.h"
+#include "debug/frameCounters.h"
 
 #include "debug/telnetDebugger.h"
 
@@ -69,6 +73,9 @@ StringStack STR;
 U32 FLT = 0;
 U32 UINT = 0;
 
+// Script functions called each frame.
+static FrameCounter sgScriptCallCounter("script.calls");
+
 static const char *getNamespaceList(Namespace *ns)
 {
    U32 size = 1;
@@ -456,13 +463,40 @@ const char *CodeBlock::exec(U32 ip, const char *functionName, Namespace *thisNam
    static char traceBuffer[1024];
    U32 i;
 
+   // Account everything the script allocates to the console.
+   MemoryTagScope memoryTagScope(MemoryAllocator::ConsoleTag);
+
    incRefCount();
    F64 *curFloatTable;
    char *curStringTable;
    STR.clearFunctionOffset();
    StringTableEntry thisFunctionName = NULL;
    bool popFrame = false;
+
+   // Only the call made by the task scheduler sees the task; any functions
+   // the task calls run as normal.
+   ScriptTask *task = gEvalState.pendingTask;
+   gEvalState.pendingTask = NULL;
+
+   // Decided once so enter and leave stay balanced if the profiler is toggled.
+   const bool profileCall = argv && ScriptProfiler::isEnabled();
+   if(profileCall)
+      ScriptProfiler::enterFunction(this, ip, thisNamespace, U32toSTE(code[ip]), packageName);
+
    if(argv)
+      sgScriptCallCounter.increment();
+
+   if(argv && task && task->isSuspended())
+   {
+      // Resume a yielded task with its saved locals.
+      thisFunctionName = U32toSTE(code[ip]);
+      gEvalState.stack.push_back(task->resume(ip));
+      task->setFrameDepth(gEvalState.stack.size());
+      popFrame = true;
+      curFloatTable = functionFloats;
+      curStringTable = functionStrings;
+   }
+   else if(argv)
    {
       // assume this points into a function decl:
       U32 fnArgc = code[ip + 5];
@@ -499,6 +533,8 @@ const char *CodeBlock::exec(U32 ip, const char *functionName, Namespace *thisNam
       }
       gEvalState.pushFrame(thisFunctionName, thisNamespace);
       popFrame = true;
+      if(task)
+         task->setFrameDepth(gEvalState.stack.size());
       for(i = 0; i < argc; i++)
       {
          StringTableEntry var = U32toSTE(code[ip + i + 6]);
@@ -583,6 +619,15 @@ const char *CodeBlock::exec(U32 ip, const char *functionName, Namespace *thisNam
    for(;;)
    {
       U32 instruction = code[ip++];
+      if(--gEvalState.sampleCountdown == 0)
+      {
+         if(!gEvalState.stack.empty())
+         {
+            gEvalState.stack.last()->code = this;
+            gEvalState.stack.last()->ip = ip - 1;
+         }
+         ScriptProfiler::checkSample();
+      }
 breakContinue:
       switch(instruction)
       {
@@ -1622,6 +1667,26 @@ breakContinue:
                         
                         STR.popFrame();
                         STR.setStringValue("");
+
+                        // yield() was called by the top level function of a task.  The
+                        // stacks are empty at a statement boundary so only the ip and the
+                        // locals need to be kept.
+                        if(task && task->isYieldRequested())
+                        {
+                           if(code[ip] == OP_STR_TO_NONE)
+                           {
+                              if(callType == FuncCallExprNode::MethodCall)
+                                 gEvalState.thisObject = saveObject;
+
+                              task->suspend(ip + 1, gEvalState.stack.last());
+                              gEvalState.stack.pop_back();
+                              popFrame = false;
+                              goto execFinished;
+                           }
+
+                           Con::warnf(ConsoleLogEntry::General, "%s: yield() in %s must be called as a statement.", getFileLine(ip-4), functionName);
+                           task->clearYieldRequest();
+                        }
                         break;
                      case Namespace::Entry::BoolCallbackType:
                      {
@@ -1686,6 +1751,87 @@ breakContinue:
          case OP_PUSH_FRAME:
             STR.pushFrame();
             break;
+
+         // The superinstructions below behave exactly like the pair of
+         // instructions they replace.  See optimizeCodeStream().
+         case OP_SETCURVAR_LOADVAR_UINT:
+         case OP_SETCURVAR_LOADVAR_FLT:
+         case OP_SETCURVAR_LOADVAR_STR:
+            var = U32toSTE(code[ip]);
+            ip += 2;
+
+            // See OP_SETCURVAR
+            prevField = NULL;
+            prevObject = NULL;
+            curObject = NULL;
+
+            gEvalState.setCurVarName(var);
+
+            // See OP_SETCURVAR for why we do this.
+            curFNDocBlock = NULL;
+            curNSDocBlock = NULL;
+
+            if(instruction == OP_SETCURVAR_LOADVAR_UINT)
+            {
+               intStack[UINT+1] = gEvalState.getIntVariable();
+               UINT++;
+            }
+            else if(instruction == OP_SETCURVAR_LOADVAR_FLT)
+            {
+               floatStack[FLT+1] = gEvalState.getFloatVariable();
+               FLT++;
+            }
+            else
+            {
+               val = gEvalState.getStringVariable();
+               STR.setStringValue(val);
+            }
+            break;
+
+         case OP_SETCURVAR_CREATE_SAVEVAR_UINT:
+         case OP_SETCURVAR_CREATE_SAVEVAR_FLT:
+         case OP_SETCURVAR_CREATE_SAVEVAR_STR:
+            var = U32toSTE(code[ip]);
+            ip += 2;
+
+            // See OP_SETCURVAR
+            prevField = NULL;
+            prevObject = NULL;
+            curObject = NULL;
+
+            gEvalState.setCurVarNameCreate(var);
+
+            // See OP_SETCURVAR for why we do this.
+            curFNDocBlock = NULL;
+            curNSDocBlock = NULL;
+
+            if(instruction == OP_SETCURVAR_CREATE_SAVEVAR_UINT)
+               gEvalState.setIntVariable((S32)intStack[UINT]);
+            else if(instruction == OP_SETCURVAR_CREATE_SAVEVAR_FLT)
+               gEvalState.setFloatVariable(floatStack[FLT]);
+            else
+               gEvalState.setStringVariable(STR.getStringValue());
+            break;
+
+         case OP_UINT_TO_STR_TO_UINT:
+            // The padding word held OP_STR_TO_UINT.
+            ip++;
+            STR.setIntValue((U32)intStack[UINT]);
+            intStack[UINT] = (U32)intStack[UINT];
+            break;
+
+         case OP_FLT_TO_STR_TO_FLT:
+            // The padding word held OP_STR_TO_FLT.  The string is parsed back
+            // so that the value is rounded exactly as before.
+            ip++;
+            STR.setFloatValue(floatStack[FLT]);
+            floatStack[FLT] = STR.getFloatValue();
+            break;
+
+         case OP_STR_TO_NONE_PAIR:
+            ip++;
+            break;
+
          case OP_BREAK:
          {
             //append the ip and codeptr before managing the breakpoint!
@@ -1714,6 +1860,9 @@ breakContinue:
    }
 execFinished:
 
+   if(profileCall)
+      ScriptProfiler::leaveFunction();
+
    if ( telDebuggerOn && setFrame < 0 )
       TelDebugger->popStackFrame();
 
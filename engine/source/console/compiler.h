@@ -139,6 +139,23 @@ namespace Compiler
       OP_PUSH,
       OP_PUSH_FRAME,
 
+      // Superinstructions produced by optimizeCodeStream().  Each one replaces
+      // a pair of adjacent instructions in place; the word that held the second
+      // opcode is kept as padding and skipped by the VM.
+      OP_SETCURVAR_LOADVAR_UINT,
+      OP_SETCURVAR_LOADVAR_FLT,
+      OP_SETCURVAR_LOADVAR_STR,
+      OP_SETCURVAR_CREATE_SAVEVAR_UINT,
+      OP_SETCURVAR_CREATE_SAVEVAR_FLT,
+      OP_SETCURVAR_CREATE_SAVEVAR_STR,
+
+      // Redundant conversion pairs rewritten by optimizeCodeStream(), padded
+      // in the same way.  A value converted to a string and straight back
+      // still leaves the string behind as a bare return can observe it.
+      OP_UINT_TO_STR_TO_UINT,
+      OP_FLT_TO_STR_TO_FLT,
+      OP_STR_TO_NONE_PAIR,
+
       OP_BREAK,
 
       OP_INVALID
@@ -249,6 +266,33 @@ namespace Compiler
    void consoleAllocReset();
 
    extern bool gSyntaxError;
+
+   //------------------------------------------------------------
+
+   /// Controls whether constant folding and optimizeCodeStream() are applied
+   /// to newly compiled script.
+   extern bool gOptimizeBytecode;
+
+   /// Returns the number of code words, including the opcode itself, used
+   /// by the instruction at the specified ip.  The opcode is passed in
+   /// separately so that instructions hidden behind an OP_BREAK can be sized.
+   U32 getInstructionSize(U32 opcode, const U32 *code, U32 ip);
+
+   /// Returns the human readable name of an opcode.
+   const char *getInstructionName(U32 opcode);
+
+   /// Performs a peephole pass over a compiled code stream.  Jumps to
+   /// unconditional jumps are threaded to their final destination and
+   /// common instruction pairs are replaced with superinstructions.  The
+   /// pass never moves or resizes instructions so jump targets, line
+   /// break pairs and identifier fix-ups all remain valid.
+   ///
+   /// @param code The code stream to optimize.
+   /// @param codeSize The number of words in the code stream.
+   /// @param lineBreakPairs The line/ip break pairs or NULL.
+   /// @param lineBreakPairCount The number of line/ip break pairs.
+   /// @return The number of instructions that were rewritten.
+   U32 optimizeCodeStream(U32 *code, U32 codeSize, const U32 *lineBreakPairs, U32 lineBreakPairCount);
 };
 
 #endif
@@ -0,0 +1,365 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "console/console.h"
+#include "console/compiler.h"
+#include "collection/vector.h"
+
+//-----------------------------------------------------------------------------
+
+namespace Compiler
+{
+   bool gOptimizeBytecode = true;
+
+   //------------------------------------------------------------
+
+   U32 getInstructionSize(U32 opcode, const U32 *code, U32 ip)
+   {
+      switch(opcode)
+      {
+      case OP_FUNC_DECL:
+         // name, namespace, package, has body, end ip, argc then the arguments.
+         return 7 + code[ip + 6];
+
+      case OP_CREATE_OBJECT:
+         // parent, is datablock, is internal, is message, fail ip.
+         return 6;
+
+      case OP_CALLFUNC_RESOLVE:
+      case OP_CALLFUNC:
+         // function, namespace, call type.
+         return 4;
+
+      case OP_SETCURVAR_LOADVAR_UINT:
+      case OP_SETCURVAR_LOADVAR_FLT:
+      case OP_SETCURVAR_LOADVAR_STR:
+      case OP_SETCURVAR_CREATE_SAVEVAR_UINT:
+      case OP_SETCURVAR_CREATE_SAVEVAR_FLT:
+      case OP_SETCURVAR_CREATE_SAVEVAR_STR:
+         // variable then the padding word.
+         return 3;
+
+      case OP_UINT_TO_STR_TO_UINT:
+      case OP_FLT_TO_STR_TO_FLT:
+      case OP_STR_TO_NONE_PAIR:
+         // just the padding word.
+         return 2;
+
+      case OP_ADD_OBJECT:
+      case OP_END_OBJECT:
+      case OP_JMPIFFNOT:
+      case OP_JMPIFNOT:
+      case OP_JMPIFF:
+      case OP_JMPIF:
+      case OP_JMPIFNOT_NP:
+      case OP_JMPIF_NP:
+      case OP_JMP:
+      case OP_SETCURVAR:
+      case OP_SETCURVAR_CREATE:
+      case OP_SETCUROBJECT_INTERNAL:
+      case OP_SETCURFIELD:
+      case OP_LOADIMMED_UINT:
+      case OP_LOADIMMED_FLT:
+      case OP_TAG_TO_STR:
+      case OP_LOADIMMED_STR:
+      case OP_DOCBLOCK_STR:
+      case OP_LOADIMMED_IDENT:
+      case OP_ADVANCE_STR_APPENDCHAR:
+         return 2;
+
+      default:
+         return 1;
+      }
+   }
+
+   //------------------------------------------------------------
+
+   const char *getInstructionName(U32 opcode)
+   {
+      switch(opcode)
+      {
+      case OP_FUNC_DECL:                     return "OP_FUNC_DECL";
+      case OP_CREATE_OBJECT:                 return "OP_CREATE_OBJECT";
+      case OP_ADD_OBJECT:                    return "OP_ADD_OBJECT";
+      case OP_END_OBJECT:                    return "OP_END_OBJECT";
+      case OP_JMPIFFNOT:                     return "OP_JMPIFFNOT";
+      case OP_JMPIFNOT:                      return "OP_JMPIFNOT";
+      case OP_JMPIFF:                        return "OP_JMPIFF";
+      case OP_JMPIF:                         return "OP_JMPIF";
+      case OP_JMPIFNOT_NP:                   return "OP_JMPIFNOT_NP";
+      case OP_JMPIF_NP:                      return "OP_JMPIF_NP";
+      case OP_JMP:                           return "OP_JMP";
+      case OP_RETURN:                        return "OP_RETURN";
+      case OP_CMPEQ:                         return "OP_CMPEQ";
+      case OP_CMPGR:                         return "OP_CMPGR";
+      case OP_CMPGE:                         return "OP_CMPGE";
+      case OP_CMPLT:                         return "OP_CMPLT";
+      case OP_CMPLE:                         return "OP_CMPLE";
+      case OP_CMPNE:                         return "OP_CMPNE";
+      case OP_XOR:                           return "OP_XOR";
+      case OP_MOD:                           return "OP_MOD";
+      case OP_BITAND:                        return "OP_BITAND";
+      case OP_BITOR:                         return "OP_BITOR";
+      case OP_NOT:                           return "OP_NOT";
+      case OP_NOTF:                          return "OP_NOTF";
+      case OP_ONESCOMPLEMENT:                return "OP_ONESCOMPLEMENT";
+      case OP_SHR:                           return "OP_SHR";
+      case OP_SHL:                           return "OP_SHL";
+      case OP_AND:                           return "OP_AND";
+      case OP_OR:                            return "OP_OR";
+      case OP_ADD:                           return "OP_ADD";
+      case OP_SUB:                           return "OP_SUB";
+      case OP_MUL:                           return "OP_MUL";
+      case OP_DIV:                           return "OP_DIV";
+      case OP_NEG:                           return "OP_NEG";
+      case OP_SETCURVAR:                     return "OP_SETCURVAR";
+      case OP_SETCURVAR_CREATE:              return "OP_SETCURVAR_CREATE";
+      case OP_SETCURVAR_ARRAY:               return "OP_SETCURVAR_ARRAY";
+      case OP_SETCURVAR_ARRAY_CREATE:        return "OP_SETCURVAR_ARRAY_CREATE";
+      case OP_LOADVAR_UINT:                  return "OP_LOADVAR_UINT";
+      case OP_LOADVAR_FLT:                   return "OP_LOADVAR_FLT";
+      case OP_LOADVAR_STR:                   return "OP_LOADVAR_STR";
+      case OP_SAVEVAR_UINT:                  return "OP_SAVEVAR_UINT";
+      case OP_SAVEVAR_FLT:                   return "OP_SAVEVAR_FLT";
+      case OP_SAVEVAR_STR:                   return "OP_SAVEVAR_STR";
+      case OP_SETCUROBJECT:                  return "OP_SETCUROBJECT";
+      case OP_SETCUROBJECT_NEW:              return "OP_SETCUROBJECT_NEW";
+      case OP_SETCUROBJECT_INTERNAL:         return "OP_SETCUROBJECT_INTERNAL";
+      case OP_SETCURFIELD:                   return "OP_SETCURFIELD";
+      case OP_SETCURFIELD_ARRAY:             return "OP_SETCURFIELD_ARRAY";
+      case OP_LOADFIELD_UINT:                return "OP_LOADFIELD_UINT";
+      case OP_LOADFIELD_FLT:                 return "OP_LOADFIELD_FLT";
+      case OP_LOADFIELD_STR:                 return "OP_LOADFIELD_STR";
+      case OP_SAVEFIELD_UINT:                return "OP_SAVEFIELD_UINT";
+      case OP_SAVEFIELD_FLT:                 return "OP_SAVEFIELD_FLT";
+      case OP_SAVEFIELD_STR:                 return "OP_SAVEFIELD_STR";
+      case OP_STR_TO_UINT:                   return "OP_STR_TO_UINT";
+      case OP_STR_TO_FLT:                    return "OP_STR_TO_FLT";
+      case OP_STR_TO_NONE:                   return "OP_STR_TO_NONE";
+      case OP_FLT_TO_UINT:                   return "OP_FLT_TO_UINT";
+      case OP_FLT_TO_STR:                    return "OP_FLT_TO_STR";
+      case OP_FLT_TO_NONE:                   return "OP_FLT_TO_NONE";
+      case OP_UINT_TO_FLT:                   return "OP_UINT_TO_FLT";
+      case OP_UINT_TO_STR:                   return "OP_UINT_TO_STR";
+      case OP_UINT_TO_NONE:                  return "OP_UINT_TO_NONE";
+      case OP_LOADIMMED_UINT:                return "OP_LOADIMMED_UINT";
+      case OP_LOADIMMED_FLT:                 return "OP_LOADIMMED_FLT";
+      case OP_TAG_TO_STR:                    return "OP_TAG_TO_STR";
+      case OP_LOADIMMED_STR:                 return "OP_LOADIMMED_STR";
+      case OP_DOCBLOCK_STR:                  return "OP_DOCBLOCK_STR";
+      case OP_LOADIMMED_IDENT:               return "OP_LOADIMMED_IDENT";
+      case OP_CALLFUNC_RESOLVE:              return "OP_CALLFUNC_RESOLVE";
+      case OP_CALLFUNC:                      return "OP_CALLFUNC";
+      case OP_ADVANCE_STR:                   return "OP_ADVANCE_STR";
+      case OP_ADVANCE_STR_APPENDCHAR:        return "OP_ADVANCE_STR_APPENDCHAR";
+      case OP_ADVANCE_STR_COMMA:             return "OP_ADVANCE_STR_COMMA";
+      case OP_ADVANCE_STR_NUL:               return "OP_ADVANCE_STR_NUL";
+      case OP_REWIND_STR:                    return "OP_REWIND_STR";
+      case OP_TERMINATE_REWIND_STR:          return "OP_TERMINATE_REWIND_STR";
+      case OP_COMPARE_STR:                   return "OP_COMPARE_STR";
+      case OP_PUSH:                          return "OP_PUSH";
+      case OP_PUSH_FRAME:                    return "OP_PUSH_FRAME";
+      case OP_SETCURVAR_LOADVAR_UINT:        return "OP_SETCURVAR_LOADVAR_UINT";
+      case OP_SETCURVAR_LOADVAR_FLT:         return "OP_SETCURVAR_LOADVAR_FLT";
+      case OP_SETCURVAR_LOADVAR_STR:         return "OP_SETCURVAR_LOADVAR_STR";
+      case OP_SETCURVAR_CREATE_SAVEVAR_UINT: return "OP_SETCURVAR_CREATE_SAVEVAR_UINT";
+      case OP_SETCURVAR_CREATE_SAVEVAR_FLT:  return "OP_SETCURVAR_CREATE_SAVEVAR_FLT";
+      case OP_SETCURVAR_CREATE_SAVEVAR_STR:  return "OP_SETCURVAR_CREATE_SAVEVAR_STR";
+      case OP_UINT_TO_STR_TO_UINT:           return "OP_UINT_TO_STR_TO_UINT";
+      case OP_FLT_TO_STR_TO_FLT:             return "OP_FLT_TO_STR_TO_FLT";
+      case OP_STR_TO_NONE_PAIR:              return "OP_STR_TO_NONE_PAIR";
+      case OP_BREAK:                         return "OP_BREAK";
+      default:                               return "OP_INVALID";
+      }
+   }
+
+   //------------------------------------------------------------
+
+   static bool isJumpInstruction(U32 opcode)
+   {
+      switch(opcode)
+      {
+      case OP_JMPIFFNOT:
+      case OP_JMPIFNOT:
+      case OP_JMPIFF:
+      case OP_JMPIF:
+      case OP_JMPIFNOT_NP:
+      case OP_JMPIF_NP:
+      case OP_JMP:
+         return true;
+      default:
+         return false;
+      }
+   }
+
+   /// Returns the superinstruction for an adjacent pair, including redundant
+   /// conversion pairs, or OP_INVALID.
+   static U32 getSuperInstruction(U32 first, U32 second)
+   {
+      if(first == OP_SETCURVAR)
+      {
+         switch(second)
+         {
+         case OP_LOADVAR_UINT: return OP_SETCURVAR_LOADVAR_UINT;
+         case OP_LOADVAR_FLT:  return OP_SETCURVAR_LOADVAR_FLT;
+         case OP_LOADVAR_STR:  return OP_SETCURVAR_LOADVAR_STR;
+         default:              break;
+         }
+      }
+      else if(first == OP_SETCURVAR_CREATE)
+      {
+         switch(second)
+         {
+         case OP_SAVEVAR_UINT: return OP_SETCURVAR_CREATE_SAVEVAR_UINT;
+         case OP_SAVEVAR_FLT:  return OP_SETCURVAR_CREATE_SAVEVAR_FLT;
+         case OP_SAVEVAR_STR:  return OP_SETCURVAR_CREATE_SAVEVAR_STR;
+         default:              break;
+         }
+      }
+      else if(first == OP_UINT_TO_STR && second == OP_STR_TO_UINT)
+      {
+         // The string does not need to be parsed back to the number.
+         return OP_UINT_TO_STR_TO_UINT;
+      }
+      else if(first == OP_FLT_TO_STR && second == OP_STR_TO_FLT)
+         return OP_FLT_TO_STR_TO_FLT;
+      else if((first == OP_STR_TO_UINT && second == OP_UINT_TO_NONE) ||
+              (first == OP_STR_TO_FLT && second == OP_FLT_TO_NONE))
+      {
+         // Converting a string only to discard the number does nothing.
+         return OP_STR_TO_NONE_PAIR;
+      }
+      return OP_INVALID;
+   }
+
+   //------------------------------------------------------------
+
+   U32 optimizeCodeStream(U32 *code, U32 codeSize, const U32 *lineBreakPairs, U32 lineBreakPairCount)
+   {
+      if(!gOptimizeBytecode || !codeSize)
+         return 0;
+
+      enum
+      {
+         JumpTarget = BIT(0),
+         BreakLine  = BIT(1)
+      };
+
+      // Flag every ip that control can arrive at from somewhere other than
+      // the preceding instruction.  These must remain instruction boundaries.
+      Vector<U8> flags;
+      flags.setSize(codeSize);
+      dMemset(flags.address(), 0, codeSize);
+
+      U32 ip;
+      for(ip = 0; ip < codeSize;)
+      {
+         const U32 opcode = code[ip];
+         if(opcode >= OP_BREAK)
+         {
+            // Either the stream is already being debugged or it is malformed.
+            return 0;
+         }
+
+         const U32 size = getInstructionSize(opcode, code, ip);
+         if(ip + size > codeSize)
+            return 0;
+
+         U32 target = codeSize;
+         if(isJumpInstruction(opcode))
+            target = code[ip + 1];
+         else if(opcode == OP_FUNC_DECL)
+         {
+            target = code[ip + 5];
+
+            // The function body is entered directly by CodeBlock::exec().
+            if(ip + size < codeSize)
+               flags[ip + size] |= JumpTarget;
+         }
+         else if(opcode == OP_CREATE_OBJECT)
+            target = code[ip + 5];
+
+         if(target < codeSize)
+            flags[target] |= JumpTarget;
+
+         ip += size;
+      }
+
+      for(U32 i = 0; i < lineBreakPairCount; i++)
+      {
+         const U32 breakIp = lineBreakPairs[i * 2 + 1];
+         if(breakIp < codeSize)
+            flags[breakIp] |= BreakLine;
+      }
+
+      U32 rewriteCount = 0;
+
+      for(ip = 0; ip < codeSize;)
+      {
+         const U32 opcode = code[ip];
+         const U32 size = getInstructionSize(opcode, code, ip);
+
+         if(isJumpInstruction(opcode))
+         {
+            // Thread jumps that land on an unconditional jump straight through
+            // to its destination.  Jumps that are break lines are left alone so
+            // that breakpoints on them are still hit.
+            U32 target = code[ip + 1];
+            for(U32 hops = 0; hops < 16; hops++)
+            {
+               if(target + 1 >= codeSize || code[target] != OP_JMP || (flags[target] & BreakLine))
+                  break;
+
+               const U32 next = code[target + 1];
+               if(next == target)
+                  break;
+               target = next;
+            }
+
+            if(target != code[ip + 1])
+            {
+               code[ip + 1] = target;
+               rewriteCount++;
+            }
+         }
+         else if(ip + size < codeSize && !flags[ip + size])
+         {
+            // Fuse the pair.  The second opcode stays where it was as padding
+            // which keeps every other ip in the stream unchanged.
+            const U32 superInstruction = getSuperInstruction(opcode, code[ip + size]);
+            if(superInstruction != OP_INVALID)
+            {
+               code[ip] = superInstruction;
+               rewriteCount++;
+               ip += getInstructionSize(superInstruction, code, ip);
+               continue;
+            }
+         }
+
+         ip += size;
+      }
+
+      return rewriteCount;
+   }
+};
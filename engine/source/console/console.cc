@@ -33,6 +33,8 @@
 #include "debug/telnetDebugger.h"
 #include "sim/simBase.h"
 #include "console/compiler.h"
+#include "console/scriptTask.h"
+#include "console/scriptProfiler.h"
 #include "string/stringStack.h"
 #include "component/dynamicConsoleMethodComponent.h"
 #include "memory/safeDelete.h"
@@ -281,11 +283,15 @@ void init()
    addVariable("Con::logBufferEnabled", TypeBool, &logBufferEnabled);
    addVariable("Con::printLevel", TypeS32, &printLevel);
    addVariable("Con::warnUndefinedVariables", TypeBool, &gWarnUndefinedScriptVariables);
+   addVariable("Con::optimizeBytecode", TypeBool, &Compiler::gOptimizeBytecode);
 
    // Current script file name and root
    Con::addVariable( "Con::File", TypeString, &gCurrentFile );
    Con::addVariable( "Con::Root", TypeString, &gCurrentRoot );
 
+   // Script tasks
+   ScriptTaskScheduler::init();
+
    // Setup the console types.
    ConsoleBaseType::initialize();
 
@@ -301,6 +307,8 @@ void shutdown()
    active = false;
 
    consoleLogFile.close();
+   ScriptTaskScheduler::shutdown();
+   ScriptProfiler::shutdown();
    Namespace::shutdown();
 
    SAFE_DELETE( sLogMutex );
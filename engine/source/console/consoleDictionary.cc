@@ -35,7 +35,6 @@
 #include "console/compiler.h"
 
 static char scratchBuffer[1024];
-#define ST_INIT_SIZE 15
 
 
 struct StringValue
@@ -83,16 +82,11 @@ void Dictionary::exportVariables(const char *varString, const char *fileName, bo
    const char *searchStr = varString;
    Vector<Entry *> sortList(__FILE__, __LINE__);
 
-   for(S32 i = 0; i < hashTable->size;i ++)
+   for(EntryMap::iterator itr = hashTable->entries.begin(); itr != hashTable->entries.end(); ++itr)
    {
-      Entry *walk = hashTable->data[i];
-      while(walk)
-      {
-         if(FindMatch::isMatch((char *) searchStr, (char *) walk->name))
-            sortList.push_back(walk);
-
-         walk = walk->nextEntry;
-      }
+      Entry *walk = itr->value;
+      if(FindMatch::isMatch((char *) searchStr, (char *) walk->name))
+         sortList.push_back(walk);
    }
 
    if(!sortList.size())
@@ -145,18 +139,17 @@ void Dictionary::exportVariables(const char *varString, const char *fileName, bo
 void Dictionary::deleteVariables(const char *varString)
 {
    const char *searchStr = varString;
+   Vector<Entry *> removeList(__FILE__, __LINE__);
 
-   for(S32 i = 0; i < hashTable->size; i++)
+   // Removing reorders the table so gather the matches first.
+   for(EntryMap::iterator itr = hashTable->entries.begin(); itr != hashTable->entries.end(); ++itr)
    {
-      Entry *walk = hashTable->data[i];
-      while(walk)
-      {
-         Entry *matchedEntry = (FindMatch::isMatch((char *) searchStr, (char *) walk->name)) ? walk : NULL;
-         walk = walk->nextEntry;
-         if (matchedEntry)
-            remove(matchedEntry); // assumes remove() is a stable remove (will not reorder entries on remove)
-      }
+      if(FindMatch::isMatch((char *) searchStr, (char *) itr->value->name))
+         removeList.push_back(itr->value);
    }
+
+   for(Vector<Entry *>::iterator itr = removeList.begin(); itr != removeList.end(); itr++)
+      remove(*itr);
 }
 
 S32 HashPointer(StringTableEntry ptr)
@@ -166,76 +159,24 @@ S32 HashPointer(StringTableEntry ptr)
 
 Dictionary::Entry *Dictionary::lookup(StringTableEntry name)
 {
-   Entry *walk = hashTable->data[HashPointer(name) % hashTable->size];
-   while(walk)
-   {
-      if(walk->name == name)
-         return walk;
-      else
-         walk = walk->nextEntry;
-   }
-
-   return NULL;
+   Entry **ent = hashTable->entries.find(name);
+   return ent ? *ent : NULL;
 }
 
 Dictionary::Entry *Dictionary::add(StringTableEntry name)
 {
-   Entry *walk = hashTable->data[HashPointer(name) % hashTable->size];
-   while(walk)
-   {
-      if(walk->name == name)
-         return walk;
-      else
-         walk = walk->nextEntry;
-   }
-   Entry *ret;
-   hashTable->count++;
+   bool inserted;
+   Entry *&ent = hashTable->entries.findOrInsert(name, &inserted);
+   if(inserted)
+      ent = new Entry(name);
 
-   if(hashTable->count > hashTable->size * 2)
-   {
-    Entry head(NULL), *walk;
-    S32 i;
-    walk = &head;
-    walk->nextEntry = 0;
-    for(i = 0; i < hashTable->size; i++) {
-        while(walk->nextEntry) {
-            walk = walk->nextEntry;
-        }
-        walk->nextEntry = hashTable->data[i];
-    }
-      delete[] hashTable->data;
-      hashTable->size = hashTable->size * 4 - 1;
-      hashTable->data = new Entry *[hashTable->size];
-      for(i = 0; i < hashTable->size; i++)
-         hashTable->data[i] = NULL;
-      walk = head.nextEntry;
-      while(walk)
-      {
-         Entry *temp = walk->nextEntry;
-         S32 idx = HashPointer(walk->name) % hashTable->size;
-         walk->nextEntry = hashTable->data[idx];
-         hashTable->data[idx] = walk;
-         walk = temp;
-      }
-   }
-
-   ret = new Entry(name);
-   S32 idx = HashPointer(name) % hashTable->size;
-   ret->nextEntry = hashTable->data[idx];
-   hashTable->data[idx] = ret;
-   return ret;
+   return ent;
 }
 
-// deleteVariables() assumes remove() is a stable remove (will not reorder entries on remove)
 void Dictionary::remove(Dictionary::Entry *ent)
 {
-   Entry **walk = &hashTable->data[HashPointer(ent->name) % hashTable->size];
-   while(*walk != ent)
-      walk = &((*walk)->nextEntry);
-
-   *walk = (ent->nextEntry);
+   hashTable->entries.erase(ent->name);
    delete ent;
-   hashTable->count--;
 }
 
 Dictionary::Dictionary()
@@ -269,12 +210,6 @@ void Dictionary::setState(ExprEvalState *state, Dictionary* ref)
    {
       hashTable = new HashTableData;
       hashTable->owner = this;
-      hashTable->count = 0;
-      hashTable->size = ST_INIT_SIZE;
-      hashTable->data = new Entry *[hashTable->size];
-   
-      for(S32 i = 0; i < hashTable->size; i++)
-         hashTable->data[i] = NULL;
    }
 }
 
@@ -283,29 +218,16 @@ Dictionary::~Dictionary()
    if ( hashTable->owner == this ) 
    {
       reset();
-      delete [] hashTable->data;
       delete hashTable;
    }
 }
 
 void Dictionary::reset()
 {
-   S32 i;
-   Entry *walk, *temp;
+   for(EntryMap::iterator itr = hashTable->entries.begin(); itr != hashTable->entries.end(); ++itr)
+      delete itr->value;
 
-   for(i = 0; i < hashTable->size; i++)
-   {
-      walk = hashTable->data[i];
-      while(walk)
-      {
-         temp = walk->nextEntry;
-         delete walk;
-         walk = temp;
-      }
-      hashTable->data[i] = NULL;
-   }
-   hashTable->size = ST_INIT_SIZE;
-   hashTable->count = 0;
+   hashTable->entries.reset();
 }
 
 
@@ -313,18 +235,11 @@ void Dictionary::reset()
 
 const char *Dictionary::tabComplete(const char *prevText, S32 baseLen, bool fForward)
 {
-   S32 i;
-
    const char *bestMatch = NULL;
-   for(i = 0; i < hashTable->size; i++)
+   for(EntryMap::iterator itr = hashTable->entries.begin(); itr != hashTable->entries.end(); ++itr)
    {
-      Entry *walk = hashTable->data[i];
-      while(walk)
-      {
-         if(Namespace::canTabComplete(prevText, bestMatch, walk->name, baseLen, fForward))
-            bestMatch = walk->name;
-         walk = walk->nextEntry;
-      }
+      if(Namespace::canTabComplete(prevText, bestMatch, itr->value->name, baseLen, fForward))
+         bestMatch = itr->value->name;
    }
    return bestMatch;
 }
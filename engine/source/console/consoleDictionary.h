@@ -29,6 +29,9 @@
 #ifndef _VECTOR_H_
 #include "collection/vector.h"
 #endif
+#ifndef _FLAT_HASH_MAP_H_
+#include "collection/flatHashMap.h"
+#endif
 #ifndef _CONSOLETYPES_H_
 #include "console/consoleTypes.h"
 #endif
@@ -55,7 +58,6 @@ public:
         };
 
         StringTableEntry name;
-        Entry *nextEntry;
         S32 type;
         char *sval;
         U32 ival;  // doubles as strlen when type = -1
@@ -135,12 +137,12 @@ public:
     };
 
 private:
+    typedef FlatHashMap<StringTableEntry, Entry*> EntryMap;
+
     struct HashTableData
     {
         Dictionary* owner;
-        S32 size;
-        S32 count;
-        Entry **data;
+        EntryMap entries;
     };
 
     HashTableData *hashTable;
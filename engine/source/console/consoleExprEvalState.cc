@@ -64,6 +64,9 @@ ExprEvalState::ExprEvalState()
    globalVars.setState(this);
    thisObject = NULL;
    traceOn = false;
+   instructionCountBase = 0;
+   sampleCountdown = sampleCountdownStart = U32_MAX;
+   pendingTask = NULL;
 }
 
 ExprEvalState::~ExprEvalState()
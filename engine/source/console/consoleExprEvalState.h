@@ -29,6 +29,11 @@
 
 //-----------------------------------------------------------------------------
 
+
+class ScriptTask;
+
+//-----------------------------------------------------------------------------
+
 class ExprEvalState
 {
 public:
@@ -40,6 +45,32 @@ public:
     Dictionary::Entry *currentVariable;
     bool traceOn;
 
+    /// Instructions left before the VM calls ScriptProfiler::checkSample().
+    /// The VM decrements this in every build so that sampling can be switched
+    /// on at runtime.  It is only reloaded through setSampleCountdown().
+    U32 sampleCountdown;
+
+    /// The value the countdown was last loaded with and the number of
+    /// instructions executed before then.
+    U32 sampleCountdownStart;
+    U32 instructionCountBase;
+
+    /// The number of VM instructions executed.  This is a free running
+    /// counter used to compare script benchmarks.  It is worked out from the
+    /// sample countdown so the VM does not have to keep a second counter.
+    inline U32 getInstructionCount() const { return instructionCountBase + (sampleCountdownStart - sampleCountdown); }
+
+    /// Reloads the sample countdown without losing the instruction count.
+    inline void setSampleCountdown(const U32 count)
+    {
+       instructionCountBase = getInstructionCount();
+       sampleCountdownStart = sampleCountdown = count;
+    }
+
+    /// The script task whose top level function is about to be executed.
+    /// This is claimed and cleared by the next call to CodeBlock::exec().
+    ScriptTask *pendingTask;
+
     ExprEvalState();
     ~ExprEvalState();
 
@@ -1515,6 +1515,36 @@ ConsoleFunction(trace, void, 2, 2, "( enable ) Use the trace function to enable
    Con::printf("Console trace is %s", gEvalState.traceOn ? "on." : "off.");
 }
 
+ConsoleFunction(dumpBytecode, void, 2, 3, "( functionName [ , namespace ] ) Use the dumpBytecode function to print the compiled bytecode of a script function to the console.\n"
+                                                                "@param functionName The name of the script function to dump.\n"
+                                                                "@param namespace The namespace the function belongs to. If omitted the global namespace is used.\n"
+                                                                "@return No return value")
+{
+   Namespace* ns = argc > 2 ? Namespace::find( StringTable->insert( argv[2] ) ) : Namespace::global();
+   Namespace::Entry* nse = ns->lookup( StringTable->insert( argv[1] ) );
+   if ( !nse || !nse->mCode || !nse->mFunctionOffset )
+   {
+      Con::warnf( "dumpBytecode() - '%s' is not a script function.", argv[1] );
+      return;
+   }
+
+   // The function offset points just past the OP_FUNC_DECL opcode.
+   const U32 declIp = nse->mFunctionOffset - 1;
+   const U32 endIp = nse->mCode->code[nse->mFunctionOffset + 4];
+
+   Con::printf( "Bytecode for '%s' (%s):", argv[1], nse->mCode->name ? nse->mCode->name : "<input>" );
+   nse->mCode->dumpInstructions( declIp, endIp );
+}
+
+ConsoleFunction(getScriptInstructionCount, S32, 1, 1, "() Use the getScriptInstructionCount function to get the number of script instructions executed so far.\n"
+                                                                "The count is free running and wraps so only the difference between two calls is meaningful.\n"
+                                                                "@return Returns the number of script instructions executed.")
+{
+   TORQUE_UNUSED( argc );
+   TORQUE_UNUSED( argv );
+   return (S32)gEvalState.getInstructionCount();
+}
+
 //----------------------------------------------------------------
 
 #if defined(TORQUE_DEBUG) || defined(INTERNAL_RELEASE)
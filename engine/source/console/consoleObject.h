@@ -197,11 +197,25 @@ public:
     /// Allows the writing of a custom TAML schema.
     typedef void (*WriteCustomTamlSchema)( const AbstractClassRep* pClassRep, TiXmlElement* pParentElement );
 
+    /// Recycles instances of a class.  When a class has a pool, create() takes
+    /// its instances from the pool.  See SimObjectPool.
+    class ObjectPool
+    {
+    public:
+        virtual ~ObjectPool() {}
+        virtual ConsoleObject* createObject( void ) = 0;
+
+        /// Takes back an unregistered instance of the class.
+        /// @return False if the pool is full and the caller must delete the object.
+        virtual bool recycleObject( ConsoleObject* pObject ) = 0;
+    };
+
 protected:
     const char *       mClassName;
     AbstractClassRep * nextClass;
     AbstractClassRep * parentClass;
     Namespace *        mNamespace;
+    ObjectPool *       mpObjectPool;
 
     static AbstractClassRep ** classTable[NetClassGroupsCount][NetClassTypesCount];
     static AbstractClassRep *  classLinkList;
@@ -256,6 +270,7 @@ public:
     {
         VECTOR_SET_ASSOCIATION(mFieldList);
         parentClass  = NULL;
+        mpObjectPool = NULL;
     }
     virtual ~AbstractClassRep() { }
 
@@ -271,6 +286,8 @@ public:
     Namespace*                   getNameSpace();
     AbstractClassRep*            getNextClass();
     AbstractClassRep*            getParentClass();
+    ObjectPool*                  getObjectPool() const              { return mpObjectPool; }
+    void                         setObjectPool( ObjectPool* pPool ) { mpObjectPool = pPool; }
     virtual AbstractClassRep*    getContainerChildClass( const bool recurse ) = 0;
     virtual WriteCustomTamlSchema getCustomTamlSchema( void ) = 0;
 
@@ -415,7 +432,7 @@ public:
     }
 
     /// Wrap constructor.
-    ConsoleObject* create() const { return new T; }
+    ConsoleObject* create() const { return mpObjectPool != NULL ? mpObjectPool->createObject() : new T; }
 };
 
 //-----------------------------------------------------------------------------
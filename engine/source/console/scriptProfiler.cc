@@ -0,0 +1,404 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "console/scriptProfiler.h"
+
+#include "platform/platform.h"
+#include "console/console.h"
+#include "console/consoleInternal.h"
+#include "console/codeBlock.h"
+#include "console/ast.h"
+#include "io/fileStream.h"
+#include "memory/dataChunker.h"
+
+//-----------------------------------------------------------------------------
+
+bool                                ScriptProfiler::smEnabled = false;
+bool                                ScriptProfiler::smSampling = false;
+U64                                 ScriptProfiler::smSampleIntervalTicks = 0;
+U64                                 ScriptProfiler::smLastSampleTicks = 0;
+U32                                 ScriptProfiler::smSampleCount = 0;
+
+ScriptProfiler::FunctionMap         ScriptProfiler::smFunctionMap;
+Vector<ScriptProfiler::FunctionStats*> ScriptProfiler::smFunctions;
+Vector<ScriptProfiler::CallRecord>  ScriptProfiler::smCallStack;
+ScriptProfiler::SampleMap           ScriptProfiler::smSamples;
+Vector<ScriptProfiler::StackSample> ScriptProfiler::smStackSamples;
+DataChunker*                        ScriptProfiler::smpStackChunker = NULL;
+
+//-----------------------------------------------------------------------------
+
+static inline F64 ticksToMilliseconds( const U64 ticks )
+{
+    return F64( ticks ) * 1000.0 / F64( Platform::getPerformanceCounterFrequency() );
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK compareExclusiveTime( const void* a, const void* b )
+{
+    const ScriptProfiler::FunctionStats* pStatsA = *(const ScriptProfiler::FunctionStats**)a;
+    const ScriptProfiler::FunctionStats* pStatsB = *(const ScriptProfiler::FunctionStats**)b;
+
+    if ( pStatsA->mExclusiveTicks == pStatsB->mExclusiveTicks )
+        return 0;
+
+    return pStatsA->mExclusiveTicks < pStatsB->mExclusiveTicks ? 1 : -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::shutdown( void )
+{
+    smEnabled = false;
+    smSampling = false;
+
+    for ( S32 i = 0; i < smFunctions.size(); ++i )
+        delete smFunctions[i];
+
+    smFunctions.clear();
+    smFunctionMap.reset();
+    smCallStack.clear();
+    clearSamples();
+    smSamples.reset();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::clearSamples( void )
+{
+    // The collapsed stacks are owned by the profiler so that long sessions
+    // release them rather than keeping them in the string table.
+    delete smpStackChunker;
+    smpStackChunker = NULL;
+
+    smStackSamples.clear();
+    smSamples.clear();
+    smSampleCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::setEnabled( const bool enabled )
+{
+    smEnabled = enabled;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::setSampling( const bool sampling, const U32 intervalMicroseconds )
+{
+    smSampling = sampling;
+    smSampleIntervalTicks = ( Platform::getPerformanceCounterFrequency() * getMax( intervalMicroseconds, (U32)1 ) ) / 1000000;
+    smLastSampleTicks = Platform::getPerformanceCounter();
+
+    // The VM only calls back once its countdown reaches zero.
+    if ( smSampling )
+        gEvalState.setSampleCountdown( SampleCheckInstructions );
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::reset( void )
+{
+    for ( S32 i = 0; i < smFunctions.size(); ++i )
+    {
+        FunctionStats* pStats = smFunctions[i];
+        pStats->mCallCount = 0;
+        pStats->mInclusiveTicks = 0;
+        pStats->mExclusiveTicks = 0;
+    }
+
+    // Restart the timing of any functions that are still executing.
+    const U64 now = Platform::getPerformanceCounter();
+    for ( S32 i = 0; i < smCallStack.size(); ++i )
+    {
+        smCallStack[i].mStartTicks = now;
+        smCallStack[i].mChildTicks = 0;
+    }
+
+    clearSamples();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::dump( void )
+{
+    Vector<FunctionStats*> sorted;
+
+    for ( S32 i = 0; i < smFunctions.size(); ++i )
+    {
+        if ( smFunctions[i]->mCallCount > 0 )
+            sorted.push_back( smFunctions[i] );
+    }
+
+    dQsort( sorted.address(), sorted.size(), sizeof(FunctionStats*), compareExclusiveTime );
+
+    Con::printSeparator();
+    Con::printf( "Script Profile: %d functions, %d samples.", sorted.size(), smSampleCount );
+    Con::printf( "  Excl ms   Incl ms     Calls  Function" );
+
+    for ( S32 i = 0; i < sorted.size(); ++i )
+    {
+        const FunctionStats* pStats = sorted[i];
+
+        Con::printf( "%9.3f %9.3f %9d  %s%s%s (%s)",
+            ticksToMilliseconds( pStats->mExclusiveTicks ),
+            ticksToMilliseconds( pStats->mInclusiveTicks ),
+            pStats->mCallCount,
+            pStats->mNamespaceName ? pStats->mNamespaceName : "",
+            pStats->mNamespaceName ? "::" : "",
+            pStats->mFunctionName,
+            pStats->mFileName ? pStats->mFileName : "<input>" );
+    }
+
+    Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptProfiler::dumpCollapsedStacks( const char* pFileName )
+{
+    char pathBuffer[1024];
+    Con::expandPath( pathBuffer, sizeof(pathBuffer), pFileName );
+
+    FileStream stream;
+    if ( !stream.open( pathBuffer, FileStream::Write ) )
+    {
+        Con::warnf( "ScriptProfiler::dumpCollapsedStacks() - Could not open '%s' for writing.", pathBuffer );
+        return false;
+    }
+
+    char countBuffer[32];
+
+    for ( S32 i = 0; i < smStackSamples.size(); ++i )
+    {
+        const StackSample& sample = smStackSamples[i];
+        stream.write( dStrlen( sample.mStack ), sample.mStack );
+        dSprintf( countBuffer, sizeof(countBuffer), " %d\n", sample.mCount );
+        stream.write( dStrlen( countBuffer ), countBuffer );
+    }
+
+    stream.close();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::enterFunction( CodeBlock* pCode, const U32 functionIp, Namespace* pNamespace, StringTableEntry functionName, StringTableEntry packageName )
+{
+    const U32* pFunction = pCode->code + functionIp;
+    StringTableEntry namespaceName = pNamespace ? pNamespace->mName : NULL;
+
+    FunctionStats** ppStats = smFunctionMap.find( pFunction );
+    FunctionStats* pStats = ppStats ? *ppStats : NULL;
+
+    // A code block that has been freed can be replaced by another at the same
+    // address so make sure the function still matches.
+    if ( pStats == NULL || pStats->mFunctionName != functionName || pStats->mNamespaceName != namespaceName )
+    {
+        pStats = new FunctionStats;
+        pStats->mNamespaceName = namespaceName;
+        pStats->mFunctionName = functionName;
+        pStats->mPackageName = packageName;
+        pStats->mFileName = pCode->name;
+        pStats->mCallCount = 0;
+        pStats->mActiveCount = 0;
+        pStats->mInclusiveTicks = 0;
+        pStats->mExclusiveTicks = 0;
+
+        smFunctions.push_back( pStats );
+        smFunctionMap.insert( pFunction, pStats );
+    }
+
+    pStats->mCallCount++;
+    pStats->mActiveCount++;
+
+    CallRecord record;
+    record.mpStats = pStats;
+    record.mChildTicks = 0;
+    record.mStartTicks = Platform::getPerformanceCounter();
+    smCallStack.push_back( record );
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::leaveFunction( void )
+{
+    if ( smCallStack.empty() )
+        return;
+
+    const U64 now = Platform::getPerformanceCounter();
+    const CallRecord& record = smCallStack.last();
+    const U64 elapsed = now - record.mStartTicks;
+
+    FunctionStats* pStats = record.mpStats;
+    pStats->mExclusiveTicks += elapsed > record.mChildTicks ? elapsed - record.mChildTicks : 0;
+
+    // Only the outermost call of a recursive function counts towards the inclusive time.
+    if ( --pStats->mActiveCount == 0 )
+        pStats->mInclusiveTicks += elapsed;
+
+    smCallStack.pop_back();
+
+    if ( !smCallStack.empty() )
+        smCallStack.last().mChildTicks += elapsed;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::checkSample( void )
+{
+    if ( !smSampling )
+    {
+        // Push the next check as far away as the countdown allows.
+        gEvalState.setSampleCountdown( U32_MAX );
+        return;
+    }
+
+    gEvalState.setSampleCountdown( SampleCheckInstructions );
+
+    // There is no script call stack to sample outside of functions.
+    if ( gEvalState.stack.empty() )
+        return;
+
+    const U64 now = Platform::getPerformanceCounter();
+    if ( now - smLastSampleTicks < smSampleIntervalTicks )
+        return;
+
+    smLastSampleTicks = now;
+    takeSample();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptProfiler::takeSample( void )
+{
+    char stackBuffer[4096];
+    U32 length = 0;
+    stackBuffer[0] = 0;
+
+    // Collapsed stacks list the outermost frame first.
+    for ( S32 i = 0; i < gEvalState.stack.size() && length < sizeof(stackBuffer) - 1; ++i )
+    {
+        const Dictionary* pFrame = gEvalState.stack[i];
+        CodeBlock* pCode = pFrame->code;
+
+        U32 line = 0;
+        U32 instruction;
+        if ( pCode )
+            pCode->findBreakLine( pFrame->ip, line, instruction );
+
+        const Namespace* pNamespace = pFrame->scopeNamespace;
+        const bool hasNamespace = pNamespace && pNamespace->mName;
+
+        const S32 written = dSprintf( stackBuffer + length, sizeof(stackBuffer) - length, "%s%s%s%s (%s:%d)",
+            i > 0 ? ";" : "",
+            hasNamespace ? pNamespace->mName : "",
+            hasNamespace ? "::" : "",
+            pFrame->scopeName ? pFrame->scopeName : "<global>",
+            pCode && pCode->name ? pCode->name : "<input>",
+            line );
+
+        if ( written > 0 )
+            length = getMin( length + (U32)written, (U32)sizeof(stackBuffer) - 1 );
+    }
+
+    if ( length == 0 )
+        return;
+
+    smSampleCount++;
+
+    // A zero key marks an empty slot in the map.
+    U32 hash = _StringTable::hashString( stackBuffer );
+    if ( hash == 0 )
+        hash = 1;
+
+    bool inserted;
+    S32& firstIndex = smSamples.findOrInsert( hash, &inserted );
+    if ( inserted )
+        firstIndex = -1;
+
+    for ( S32 index = firstIndex; index != -1; index = smStackSamples[index].mNext )
+    {
+        if ( dStrcmp( smStackSamples[index].mStack, stackBuffer ) == 0 )
+        {
+            smStackSamples[index].mCount++;
+            return;
+        }
+    }
+
+    if ( smpStackChunker == NULL )
+        smpStackChunker = new DataChunker;
+
+    char* pStack = (char*)smpStackChunker->alloc( length + 1 );
+    dMemcpy( pStack, stackBuffer, length + 1 );
+
+    StackSample sample;
+    sample.mStack = pStack;
+    sample.mCount = 1;
+    sample.mNext = firstIndex;
+    smStackSamples.push_back( sample );
+
+    firstIndex = smStackSamples.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunctionGroupBegin( ScriptProfiler, "Functions for profiling script execution.");
+
+ConsoleFunction(scriptProfilerEnable, void, 2, 2, "(bool enable) - Enables or disables timing of every script function call.\n"
+                                                  "@param enable Whether to time script function calls.\n"
+                                                  "@return No return value.")
+{
+    ScriptProfiler::setEnabled( dAtob(argv[1]) );
+}
+
+ConsoleFunction(scriptProfilerSample, void, 2, 3, "(bool enable, [intervalUs]) - Enables or disables sampling of the script call stack.\n"
+                                                  "@param enable Whether to sample the script call stack.\n"
+                                                  "@param intervalUs The minimum time between samples in microseconds.  Defaults to 1000.\n"
+                                                  "@return No return value.")
+{
+    ScriptProfiler::setSampling( dAtob(argv[1]), argc > 2 ? dAtoi(argv[2]) : 1000 );
+}
+
+ConsoleFunction(scriptProfilerReset, void, 1, 1, "() - Clears all script function timings and samples.\n"
+                                                 "@return No return value.")
+{
+    ScriptProfiler::reset();
+}
+
+ConsoleFunction(scriptProfilerDump, void, 1, 1, "() - Prints the script function timings ordered by exclusive time.\n"
+                                                "@return No return value.")
+{
+    ScriptProfiler::dump();
+}
+
+ConsoleFunction(scriptProfilerDumpCollapsed, bool, 2, 2, "(fileName) - Writes the script call stack samples as collapsed stacks for flamegraph tools.\n"
+                                                         "@param fileName The file to write.\n"
+                                                         "@return Whether the file was written.")
+{
+    return ScriptProfiler::dumpCollapsedStacks( argv[1] );
+}
+
+ConsoleFunctionGroupEnd( ScriptProfiler );
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCRIPT_PROFILER_H_
+#define _SCRIPT_PROFILER_H_
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _FLAT_HASH_MAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class CodeBlock;
+class Namespace;
+class DataChunker;
+
+//-----------------------------------------------------------------------------
+
+/// Profiles TorqueScript execution in the VM.
+///
+/// The profiler has two independent modes.  Instrumentation is driven by
+/// CodeBlock::exec() and records the call count along with inclusive and
+/// exclusive time for every script function.  Sampling is driven by the VM
+/// instruction loop which periodically checks the clock and, once the sample
+/// interval has passed, records the script call stack with the current
+/// file and line of each frame.  Samples are written as collapsed stacks
+/// which can be fed directly to flamegraph tools.
+class ScriptProfiler
+{
+public:
+    struct FunctionStats
+    {
+        StringTableEntry    mNamespaceName;
+        StringTableEntry    mFunctionName;
+        StringTableEntry    mPackageName;
+        StringTableEntry    mFileName;
+        U32                 mCallCount;
+        U32                 mActiveCount;
+        U64                 mInclusiveTicks;
+        U64                 mExclusiveTicks;
+    };
+
+    /// The number of VM instructions between checks of the sample clock.
+    enum { SampleCheckInstructions = 256 };
+
+    static void shutdown( void );
+
+    static inline bool isEnabled( void )                { return smEnabled; }
+    static void setEnabled( const bool enabled );
+
+    static inline bool isSampling( void )               { return smSampling; }
+    static void setSampling( const bool sampling, const U32 intervalMicroseconds );
+
+    /// Clears all timings and samples.  Functions currently executing are
+    /// still timed correctly when they return.
+    static void reset( void );
+
+    /// Prints the function statistics ordered by exclusive time.
+    static void dump( void );
+
+    /// Writes the recorded samples as collapsed stacks.
+    static bool dumpCollapsedStacks( const char* pFileName );
+
+    /// @name VM Hooks
+    /// @{
+
+    /// Called by CodeBlock::exec() when a script function starts or resumes.
+    /// @param pCode The code block that holds the function.
+    /// @param functionIp The ip of the function declaration.
+    static void enterFunction( CodeBlock* pCode, const U32 functionIp, Namespace* pNamespace, StringTableEntry functionName, StringTableEntry packageName );
+
+    /// Called by CodeBlock::exec() for each call to enterFunction().
+    static void leaveFunction( void );
+
+    /// Called by the VM when ExprEvalState::sampleCountdown reaches zero.
+    /// The stack frames must have their code and ip set for the current instruction.
+    static void checkSample( void );
+
+    /// @}
+
+private:
+    struct CallRecord
+    {
+        FunctionStats*  mpStats;
+        U64             mStartTicks;
+        U64             mChildTicks;
+    };
+
+    /// A distinct collapsed stack and the number of times it was sampled.
+    /// Samples with the same hash are chained through their indices.
+    struct StackSample
+    {
+        const char*     mStack;
+        U32             mCount;
+        S32             mNext;
+    };
+
+    typedef FlatHashMap<const U32*, FunctionStats*> FunctionMap;
+    typedef FlatHashMap<U32, S32> SampleMap;
+
+    static void takeSample( void );
+    static void clearSamples( void );
+
+    static bool                     smEnabled;
+    static bool                     smSampling;
+    static U64                      smSampleIntervalTicks;
+    static U64                      smLastSampleTicks;
+    static U32                      smSampleCount;
+    static FunctionMap              smFunctionMap;
+    static Vector<FunctionStats*>   smFunctions;
+    static Vector<CallRecord>       smCallStack;
+    static SampleMap                smSamples;
+    static Vector<StackSample>      smStackSamples;
+    static DataChunker*             smpStackChunker;
+};
+
+#endif // _SCRIPT_PROFILER_H_
@@ -0,0 +1,379 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "console/scriptTask.h"
+
+#include "platform/platform.h"
+#include "console/console.h"
+#include "console/consoleInternal.h"
+#include "console/codeBlock.h"
+#include "console/ast.h"
+#include "string/stringStack.h"
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+extern StringStack STR;
+
+Vector<ScriptTask*>                 ScriptTaskScheduler::smTasks;
+ScriptTask*                         ScriptTaskScheduler::smCurrentTask = NULL;
+U32                                 ScriptTaskScheduler::smNextTaskId = 1;
+U32                                 ScriptTaskScheduler::smNextTaskIndex = 0;
+S32                                 ScriptTaskScheduler::smFrameBudget = 2;
+bool                                ScriptTaskScheduler::smProcessing = false;
+ScriptTaskScheduler::FrameStats     ScriptTaskScheduler::smFrameStats = { 0, 0, 0, 0, 0 };
+
+//-----------------------------------------------------------------------------
+
+ScriptTask::ScriptTask( const U32 id, StringTableEntry functionName, CodeBlock* pCode, const U32 functionOffset, Namespace* pNamespace, StringTableEntry packageName, const S32 argc, const char** argv ) :
+    mId( id ),
+    mFunctionName( functionName ),
+    mCode( pCode ),
+    mFunctionOffset( functionOffset ),
+    mNamespace( pNamespace ),
+    mPackageName( packageName ),
+    mArgBuffer( NULL ),
+    mFrame( NULL ),
+    mResumeIp( 0 ),
+    mFrameDepth( 0 ),
+    mSliceCount( 0 ),
+    mYieldRequested( false ),
+    mCancelled( false )
+{
+    // Keep the code alive even if the script file is recompiled while the task is pending.
+    mCode->incRefCount();
+
+    // Copy the arguments as the originals live on the string stack.
+    U32 bufferSize = 0;
+    for ( S32 i = 0; i < argc; ++i )
+        bufferSize += dStrlen( argv[i] ) + 1;
+
+    mArgBuffer = new char[bufferSize];
+    mArgv.setSize( argc );
+
+    char* pArg = mArgBuffer;
+    for ( S32 i = 0; i < argc; ++i )
+    {
+        const U32 length = dStrlen( argv[i] ) + 1;
+        dMemcpy( pArg, argv[i], length );
+        mArgv[i] = pArg;
+        pArg += length;
+    }
+
+    // The function is always called by name.
+    mArgv[0] = mFunctionName;
+}
+
+//-----------------------------------------------------------------------------
+
+ScriptTask::~ScriptTask()
+{
+    delete mFrame;
+    delete [] mArgBuffer;
+    mCode->decRefCount();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptTask::suspend( const U32 resumeIp, Dictionary* pFrame )
+{
+    AssertFatal( mFrame == NULL, "ScriptTask::suspend() - Task is already suspended." );
+
+    mResumeIp = resumeIp;
+    mFrame = pFrame;
+    mYieldRequested = false;
+}
+
+//-----------------------------------------------------------------------------
+
+Dictionary* ScriptTask::resume( U32& resumeIp )
+{
+    AssertFatal( mFrame != NULL, "ScriptTask::resume() - Task is not suspended." );
+
+    Dictionary* pFrame = mFrame;
+    mFrame = NULL;
+    resumeIp = mResumeIp;
+    return pFrame;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptTaskScheduler::init( void )
+{
+    Con::addVariable( "Con::scriptTaskBudget", TypeS32, &smFrameBudget );
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptTaskScheduler::shutdown( void )
+{
+    AssertFatal( !smProcessing, "ScriptTaskScheduler::shutdown() - Cannot shutdown while processing tasks." );
+
+    for ( S32 i = 0; i < smTasks.size(); ++i )
+        delete smTasks[i];
+
+    smTasks.clear();
+    smNextTaskIndex = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ScriptTaskScheduler::startTask( const S32 argc, const char** argv )
+{
+    StringTableEntry functionName = StringTable->insert( argv[0] );
+    Namespace::Entry* pEntry = Namespace::global()->lookup( functionName );
+
+    if ( pEntry == NULL || pEntry->mType != Namespace::Entry::ScriptFunctionType || pEntry->mFunctionOffset == 0 )
+    {
+        Con::warnf( "ScriptTaskScheduler::startTask() - '%s' is not a script function.", argv[0] );
+        return 0;
+    }
+
+    ScriptTask* pTask = new ScriptTask( smNextTaskId++, functionName, pEntry->mCode, pEntry->mFunctionOffset, pEntry->mNamespace, pEntry->mPackage, argc, argv );
+    smTasks.push_back( pTask );
+
+    return pTask->getId();
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptTaskScheduler::cancelTask( const U32 taskId )
+{
+    const S32 index = findTask( taskId );
+
+    if ( index < 0 )
+        return false;
+
+    ScriptTask* pTask = smTasks[index];
+
+    // Tasks are only flagged while processing and swept once the frame is done.
+    if ( smProcessing )
+    {
+        pTask->mCancelled = true;
+        return true;
+    }
+
+    smTasks.erase( index );
+    delete pTask;
+
+    if ( smNextTaskIndex > (U32)index )
+        smNextTaskIndex--;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptTaskScheduler::isTaskPending( const U32 taskId )
+{
+    return findTask( taskId ) >= 0;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ScriptTaskScheduler::getTaskCount( void )
+{
+    U32 count = 0;
+
+    for ( S32 i = 0; i < smTasks.size(); ++i )
+    {
+        if ( !smTasks[i]->mCancelled )
+            count++;
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptTaskScheduler::process( void )
+{
+    const U32 budget = smFrameBudget > 0 ? (U32)smFrameBudget : 0;
+
+    smFrameStats.mBudgetMs = budget;
+    smFrameStats.mUsedMs = 0;
+    smFrameStats.mSliceCount = 0;
+    smFrameStats.mFinishedCount = 0;
+
+    if ( smProcessing || smTasks.size() == 0 )
+    {
+        smFrameStats.mPendingCount = getTaskCount();
+        return;
+    }
+
+    PROFILE_SCOPE(ScriptTaskScheduler_Process);
+
+    smProcessing = true;
+
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    // Each task queued at the start of the frame is visited at most once so a
+    // task that yields immediately cannot use the whole budget on its own.
+    U32 visitCount = smTasks.size();
+
+    while ( visitCount-- > 0 )
+    {
+        if ( smNextTaskIndex >= (U32)smTasks.size() )
+            smNextTaskIndex = 0;
+
+        ScriptTask* pTask = smTasks[smNextTaskIndex];
+
+        if ( !pTask->mCancelled )
+        {
+            smFrameStats.mSliceCount++;
+
+            if ( runSlice( pTask ) )
+            {
+                pTask->mCancelled = true;
+                smFrameStats.mFinishedCount++;
+            }
+        }
+
+        smNextTaskIndex++;
+
+        if ( Platform::getRealMilliseconds() - startTime >= budget )
+            break;
+    }
+
+    smFrameStats.mUsedMs = Platform::getRealMilliseconds() - startTime;
+
+    smProcessing = false;
+
+    // Sweep finished and cancelled tasks.
+    for ( S32 i = 0; i < smTasks.size(); )
+    {
+        ScriptTask* pTask = smTasks[i];
+
+        if ( !pTask->mCancelled )
+        {
+            i++;
+            continue;
+        }
+
+        smTasks.erase( i );
+        delete pTask;
+
+        if ( smNextTaskIndex > (U32)i )
+            smNextTaskIndex--;
+    }
+
+    smFrameStats.mPendingCount = smTasks.size();
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptTaskScheduler::runSlice( ScriptTask* pTask )
+{
+    smCurrentTask = pTask;
+    pTask->clearYieldRequest();
+    pTask->mSliceCount++;
+
+    // The exec call for the function claims the pending task.  It either
+    // resumes the saved frame or starts the function from the beginning.
+    gEvalState.pendingTask = pTask;
+    pTask->mCode->exec( pTask->mFunctionOffset, pTask->mFunctionName, pTask->mNamespace, pTask->mArgv.size(), pTask->mArgv.address(), false, pTask->mPackageName );
+    gEvalState.pendingTask = NULL;
+
+    STR.clearFunctionOffset();
+    smCurrentTask = NULL;
+
+    return !pTask->isSuspended();
+}
+
+//-----------------------------------------------------------------------------
+
+S32 ScriptTaskScheduler::findTask( const U32 taskId )
+{
+    for ( S32 i = 0; i < smTasks.size(); ++i )
+    {
+        if ( smTasks[i]->getId() == taskId && !smTasks[i]->mCancelled )
+            return i;
+    }
+
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunctionGroupBegin( ScriptTasks, "Functions for running script functions cooperatively across frames.");
+
+ConsoleFunction(startScriptTask, S32, 2, 0, "(functionName, [args]*) - Queues a script function to run as a task.\n"
+                                            "The function runs over several frames if it calls yield().  Tasks share the frame budget set by $Con::scriptTaskBudget (in milliseconds).\n"
+                                            "@param functionName The name of a global script function.\n"
+                                            "@param args Any arguments to pass to the function.\n"
+                                            "@return The task id or zero if the function could not be found.")
+{
+    return ScriptTaskScheduler::startTask( argc - 1, argv + 1 );
+}
+
+ConsoleFunction(yield, void, 1, 1, "() - Suspends the current script task until the next frame.\n"
+                                   "Must be called as a statement from the function that was passed to startScriptTask().\n"
+                                   "@return No return value.")
+{
+    ScriptTask* pTask = ScriptTaskScheduler::getCurrentTask();
+
+    if ( pTask == NULL )
+    {
+        Con::warnf( "yield() - Can only be called from within a script task." );
+        return;
+    }
+
+    if ( (U32)gEvalState.stack.size() != pTask->getFrameDepth() )
+    {
+        Con::warnf( "yield() - Can only be called from the top level function '%s' of a script task.", pTask->getFunctionName() );
+        return;
+    }
+
+    pTask->requestYield();
+}
+
+ConsoleFunction(cancelScriptTask, bool, 2, 2, "(taskId) - Cancels a queued or suspended script task.\n"
+                                              "@param taskId The id returned by startScriptTask().\n"
+                                              "@return Whether the task was found.")
+{
+    return ScriptTaskScheduler::cancelTask( dAtoi(argv[1]) );
+}
+
+ConsoleFunction(isScriptTaskPending, bool, 2, 2, "(taskId) - Checks whether a script task has not finished yet.\n"
+                                                 "@param taskId The id returned by startScriptTask().\n"
+                                                 "@return Whether the task is queued or suspended.")
+{
+    return ScriptTaskScheduler::isTaskPending( dAtoi(argv[1]) );
+}
+
+ConsoleFunction(getScriptTaskCount, S32, 1, 1, "() - Gets the number of pending script tasks.\n"
+                                               "@return The number of pending script tasks.")
+{
+    return ScriptTaskScheduler::getTaskCount();
+}
+
+ConsoleFunction(getScriptTaskBudgetUsage, const char*, 1, 1, "() - Gets the budget usage of the script task scheduler for the last frame.\n"
+                                                              "@return A string formatted as \"usedMs budgetMs slices finished pending\".")
+{
+    const ScriptTaskScheduler::FrameStats& stats = ScriptTaskScheduler::getFrameStats();
+
+    char* pBuffer = Con::getReturnBuffer( 64 );
+    dSprintf( pBuffer, 64, "%d %d %d %d %d", stats.mUsedMs, stats.mBudgetMs, stats.mSliceCount, stats.mFinishedCount, stats.mPendingCount );
+    return pBuffer;
+}
+
+ConsoleFunctionGroupEnd( ScriptTasks );
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCRIPT_TASK_H_
+#define _SCRIPT_TASK_H_
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class CodeBlock;
+class Dictionary;
+class Namespace;
+
+//-----------------------------------------------------------------------------
+
+/// A script function that runs cooperatively across several frames.
+///
+/// A task is started with a script function and its arguments.  Each time
+/// the scheduler runs the task, CodeBlock::exec() executes the function
+/// until it returns or until it calls yield().  On a yield the instruction
+/// pointer and the local variable frame are saved here and the next slice
+/// resumes the function at the statement following the yield.
+///
+/// Only the top level function of a task can yield, and only as a stand
+/// alone statement.  Any functions it calls run to completion as normal.
+class ScriptTask
+{
+    friend class ScriptTaskScheduler;
+
+public:
+    inline U32 getId( void ) const                      { return mId; }
+    inline StringTableEntry getFunctionName( void ) const { return mFunctionName; }
+    inline U32 getSliceCount( void ) const              { return mSliceCount; }
+
+    /// Returns true if the task has yielded at least once and has a saved frame.
+    inline bool isSuspended( void ) const               { return mFrame != NULL; }
+
+    /// The number of evaluation frames, including the task frame, present
+    /// while the top level function of the task is executing.
+    inline U32 getFrameDepth( void ) const              { return mFrameDepth; }
+    inline void setFrameDepth( const U32 depth )        { mFrameDepth = depth; }
+
+    inline bool isYieldRequested( void ) const          { return mYieldRequested; }
+    inline void requestYield( void )                    { mYieldRequested = true; }
+    inline void clearYieldRequest( void )               { mYieldRequested = false; }
+
+    /// Saves the resume point and takes ownership of the local variable frame.
+    void suspend( const U32 resumeIp, Dictionary* pFrame );
+
+    /// Hands the saved frame back to the caller and returns the resume point.
+    Dictionary* resume( U32& resumeIp );
+
+private:
+    ScriptTask( const U32 id, StringTableEntry functionName, CodeBlock* pCode, const U32 functionOffset, Namespace* pNamespace, StringTableEntry packageName, const S32 argc, const char** argv );
+    ~ScriptTask();
+
+    U32                 mId;
+    StringTableEntry    mFunctionName;
+    CodeBlock*          mCode;
+    U32                 mFunctionOffset;
+    Namespace*          mNamespace;
+    StringTableEntry    mPackageName;
+
+    char*               mArgBuffer;
+    Vector<const char*> mArgv;
+
+    Dictionary*         mFrame;
+    U32                 mResumeIp;
+    U32                 mFrameDepth;
+    U32                 mSliceCount;
+    bool                mYieldRequested;
+    bool                mCancelled;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Runs queued script tasks under a per-frame time budget.
+///
+/// process() is called once per frame.  It visits each queued task at most
+/// once, in round-robin order, and stops visiting as soon as the time used
+/// reaches the budget.  At least one slice is always run so that a task
+/// can make progress even when the budget is zero.
+class ScriptTaskScheduler
+{
+public:
+    /// Budget usage for the most recent call to process().
+    struct FrameStats
+    {
+        U32 mBudgetMs;
+        U32 mUsedMs;
+        U32 mSliceCount;
+        U32 mFinishedCount;
+        U32 mPendingCount;
+    };
+
+    static void init( void );
+    static void shutdown( void );
+
+    /// Queues a script function as a task.  argv[0] is the function name.
+    /// @return The task id or zero if the function is not a script function.
+    static U32 startTask( const S32 argc, const char** argv );
+
+    /// Cancels a queued or suspended task.
+    static bool cancelTask( const U32 taskId );
+
+    static bool isTaskPending( const U32 taskId );
+    static U32 getTaskCount( void );
+
+    /// Returns the task currently executing or NULL.
+    static ScriptTask* getCurrentTask( void )           { return smCurrentTask; }
+
+    /// Runs task slices until the frame budget is used.
+    static void process( void );
+
+    static const FrameStats& getFrameStats( void )      { return smFrameStats; }
+
+private:
+    static bool runSlice( ScriptTask* pTask );
+    static S32 findTask( const U32 taskId );
+
+    static Vector<ScriptTask*>  smTasks;
+    static ScriptTask*          smCurrentTask;
+    static U32                  smNextTaskId;
+    static U32                  smNextTaskIndex;
+    static S32                  smFrameBudget;
+    static bool                 smProcessing;
+    static FrameStats           smFrameStats;
+};
+
+#endif // _SCRIPT_TASK_H_
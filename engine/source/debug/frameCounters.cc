@@ -0,0 +1,528 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "debug/frameCounters.h"
+#include "debug/profiler.h"
+#include "console/console.h"
+#include "io/fileStream.h"
+#include "string/stringTable.h"
+#include "math/mMathFn.h"
+
+//-----------------------------------------------------------------------------
+
+FrameCounter*                    FrameCounters::smFirstCounter = NULL;
+U32                              FrameCounters::smFrameCount = 0;
+U32                              FrameCounters::smHistoryLength = FrameCounters::DefaultHistoryLength;
+U64                              FrameCounters::smLastFrameTime = 0;
+F32                              FrameCounters::smSpikeThresholdMs = 0.0f;
+U32                              FrameCounters::smLastSpikeFrame = 0;
+char                             FrameCounters::smSpikeFilePrefix[SpikeFilePrefixLength] = "";
+Vector<FrameCounters::Spike*>    FrameCounters::smSpikes;
+
+static FrameCounter sgFrameTimeCounter( "frame.ms", FrameCounter::Gauge );
+
+//-----------------------------------------------------------------------------
+
+FrameCounter::FrameCounter( const char* pName, const Type type )
+{
+   registerCounter( pName, type, NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+FrameCounter::FrameCounter( const char* pName, SampleCallback callback )
+{
+   registerCounter( pName, Gauge, callback );
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounter::registerCounter( const char* pName, const Type type, SampleCallback callback )
+{
+   mName = pName;
+   mType = type;
+   mSampleCallback = callback;
+   mValue = 0.0f;
+   mpHistory = NULL;
+   mOwned = false;
+   mpNext = NULL;
+
+   FrameCounters::addCounter( this );
+}
+
+//-----------------------------------------------------------------------------
+
+F32 FrameCounter::getHistory( const U32 framesAgo ) const
+{
+   if ( mpHistory == NULL || framesAgo >= FrameCounters::getHistoryCount() )
+      return 0.0f;
+
+   const U32 frame = FrameCounters::smFrameCount - 1 - framesAgo;
+   return mpHistory[frame % FrameCounters::smHistoryLength];
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::addCounter( FrameCounter* pCounter )
+{
+   // Keep the counters in registration order.
+   FrameCounter** ppCounter = &smFirstCounter;
+   while ( *ppCounter != NULL )
+      ppCounter = &(*ppCounter)->mpNext;
+
+   *ppCounter = pCounter;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::shutdown( void )
+{
+   clearSpikes();
+
+   FrameCounter** ppCounter = &smFirstCounter;
+   while ( *ppCounter != NULL )
+   {
+      FrameCounter* pCounter = *ppCounter;
+
+      delete [] pCounter->mpHistory;
+      pCounter->mpHistory = NULL;
+
+      // Remove counters created for script.
+      if ( pCounter->mOwned )
+      {
+         *ppCounter = pCounter->mpNext;
+         delete pCounter;
+         continue;
+      }
+
+      ppCounter = &pCounter->mpNext;
+   }
+
+   smFrameCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::endFrame( void )
+{
+   // Time the frame.
+   const U64 now = Platform::getPerformanceCounter();
+   const F32 frameMs = smLastFrameTime == 0 ? 0.0f : F32( F64( now - smLastFrameTime ) * 1000.0 / F64( Platform::getPerformanceCounterFrequency() ) );
+   smLastFrameTime = now;
+   sgFrameTimeCounter.set( frameMs );
+
+   const U32 slot = smFrameCount % smHistoryLength;
+
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      if ( pCounter->mSampleCallback != NULL )
+         pCounter->mValue = pCounter->mSampleCallback();
+
+      // Counters registered after the history started have nothing for earlier frames.
+      if ( pCounter->mpHistory == NULL )
+      {
+         pCounter->mpHistory = new F32[smHistoryLength];
+         dMemset( pCounter->mpHistory, 0, sizeof(F32) * smHistoryLength );
+      }
+
+      pCounter->mpHistory[slot] = pCounter->mValue;
+   }
+
+   smFrameCount++;
+
+   // Capture a spike before the accumulating counters are cleared.
+   if ( smSpikeThresholdMs > 0.0f && frameMs > smSpikeThresholdMs &&
+      ( smLastSpikeFrame == 0 || smFrameCount - smLastSpikeFrame >= SpikeCooldownFrames ) )
+   {
+      captureSpike( frameMs );
+   }
+
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      if ( pCounter->mType == FrameCounter::Accumulate )
+         pCounter->mValue = 0.0f;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+FrameCounter* FrameCounters::findCounter( const char* pName )
+{
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      if ( dStricmp( pCounter->mName, pName ) == 0 )
+         return pCounter;
+   }
+
+   return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+FrameCounter* FrameCounters::findOrCreateCounter( const char* pName, const FrameCounter::Type type )
+{
+   FrameCounter* pCounter = findCounter( pName );
+   if ( pCounter != NULL )
+      return pCounter;
+
+   pCounter = new FrameCounter( StringTable->insert( pName ), type );
+   pCounter->mOwned = true;
+   return pCounter;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::setHistoryLength( const U32 frames )
+{
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      delete [] pCounter->mpHistory;
+      pCounter->mpHistory = NULL;
+   }
+
+   smHistoryLength = getMax( frames, (U32)1 );
+   smFrameCount = 0;
+   smLastSpikeFrame = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::getRange( const FrameCounter* pCounter, F32& minimum, F32& average, F32& maximum )
+{
+   const U32 count = getHistoryCount();
+   if ( count == 0 )
+   {
+      minimum = average = maximum = 0.0f;
+      return;
+   }
+
+   minimum = maximum = pCounter->getHistory( 0 );
+   F64 total = 0.0;
+   for ( U32 index = 0; index < count; ++index )
+   {
+      const F32 value = pCounter->getHistory( index );
+      minimum = getMin( minimum, value );
+      maximum = getMax( maximum, value );
+      total += value;
+   }
+
+   average = F32( total / count );
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::setSpikeCapture( const F32 thresholdMs, const char* pFilePrefix )
+{
+   smSpikeThresholdMs = getMax( thresholdMs, 0.0f );
+   smLastSpikeFrame = 0;
+
+   if ( pFilePrefix == NULL || *pFilePrefix == 0 )
+      smSpikeFilePrefix[0] = 0;
+   else
+      Con::expandPath( smSpikeFilePrefix, sizeof(smSpikeFilePrefix), pFilePrefix );
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::captureSpike( const F32 frameMs )
+{
+   smLastSpikeFrame = smFrameCount;
+
+   // Drop the oldest spike when full.
+   if ( smSpikes.size() >= MaxSpikes )
+   {
+      delete smSpikes.first();
+      smSpikes.pop_front();
+   }
+
+   Spike* pSpike = new Spike;
+   pSpike->mFrame = smFrameCount - 1;
+   pSpike->mFrameMs = frameMs;
+
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      Spike::Sample sample;
+      sample.mName = pCounter->mName;
+      sample.mValue = pCounter->mValue;
+      pSpike->mSamples.push_back( sample );
+   }
+
+   smSpikes.push_back( pSpike );
+
+   Con::warnf( "Frame %d took %.2fms which exceeds the spike threshold of %.2fms.", pSpike->mFrame, frameMs, smSpikeThresholdMs );
+
+#ifdef TORQUE_ENABLE_PROFILER
+   // Write out the profiler state.
+   if ( gProfiler == NULL || smSpikeFilePrefix[0] == 0 )
+      return;
+
+   char fileName[SpikeFilePrefixLength + 32];
+   if ( gProfiler->isCapturing() )
+   {
+      // The capture holds the frames leading up to the spike so export it and carry on capturing.
+      dSprintf( fileName, sizeof(fileName), "%s_%d.json", smSpikeFilePrefix, pSpike->mFrame );
+      const U32 captureEvents = gProfiler->getCaptureEvents();
+      gProfiler->exportChromeTrace( fileName );
+      gProfiler->startCapture( captureEvents );
+   }
+   else if ( gProfiler->isEnabled() )
+   {
+      dSprintf( fileName, sizeof(fileName), "%s_%d.txt", smSpikeFilePrefix, pSpike->mFrame );
+      gProfiler->dumpToFile( fileName );
+   }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::clearSpikes( void )
+{
+   for ( S32 index = 0; index < smSpikes.size(); ++index )
+      delete smSpikes[index];
+
+   smSpikes.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::dump( void )
+{
+   Con::printSeparator();
+   Con::printf( "Frame Counters (%d of %d frames):", getHistoryCount(), smHistoryLength );
+   Con::printf( "Counter                    Last         Min          Average      Max" );
+   Con::printSeparator();
+
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      F32 minimum, average, maximum;
+      getRange( pCounter, minimum, average, maximum );
+
+      Con::printf( "%-26s %-12.2f %-12.2f %-12.2f %-12.2f", pCounter->mName,
+         pCounter->getHistory( 0 ), minimum, average, maximum );
+   }
+
+   Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameCounters::dumpSpikes( void )
+{
+   Con::printSeparator();
+   Con::printf( "Frame Spikes (threshold %.2fms):", smSpikeThresholdMs );
+
+   for ( S32 index = 0; index < smSpikes.size(); ++index )
+   {
+      const Spike* pSpike = smSpikes[index];
+
+      Con::printSeparator();
+      Con::printf( "Frame %d: %.2fms", pSpike->mFrame, pSpike->mFrameMs );
+
+      for ( S32 sampleIndex = 0; sampleIndex < pSpike->mSamples.size(); ++sampleIndex )
+         Con::printf( "  %-26s %.2f", pSpike->mSamples[sampleIndex].mName, pSpike->mSamples[sampleIndex].mValue );
+   }
+
+   Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameCounters::dumpCsv( const char* pFileName )
+{
+   char pathBuffer[1024];
+   Con::expandPath( pathBuffer, sizeof(pathBuffer), pFileName );
+
+   FileStream stream;
+   if ( !stream.open( pathBuffer, FileStream::Write ) )
+   {
+      Con::warnf( "FrameCounters::dumpCsv() - Could not open '%s' for writing.", pathBuffer );
+      return false;
+   }
+
+   char buffer[256];
+
+   // Header.
+   dStrcpy( buffer, "frame" );
+   stream.write( dStrlen( buffer ), buffer );
+   for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+   {
+      dSprintf( buffer, sizeof(buffer), ",%s", pCounter->mName );
+      stream.write( dStrlen( buffer ), buffer );
+   }
+   stream.write( 1, "\n" );
+
+   // Frames, oldest first.
+   const U32 count = getHistoryCount();
+   for ( U32 framesAgo = count; framesAgo > 0; --framesAgo )
+   {
+      dSprintf( buffer, sizeof(buffer), "%d", smFrameCount - framesAgo );
+      stream.write( dStrlen( buffer ), buffer );
+
+      for ( FrameCounter* pCounter = smFirstCounter; pCounter != NULL; pCounter = pCounter->mpNext )
+      {
+         dSprintf( buffer, sizeof(buffer), ",%g", pCounter->getHistory( framesAgo - 1 ) );
+         stream.write( dStrlen( buffer ), buffer );
+      }
+      stream.write( 1, "\n" );
+   }
+
+   stream.close();
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunctionGroupBegin( FrameCounters, "Per-frame performance counters.");
+
+ConsoleFunction( getFrameCounter, F32, 2, 3,    "(counterName, [framesAgo]) Gets a recorded frame counter value.\n"
+                                                "@param counterName The name of the counter.\n"
+                                                "@param framesAgo How many frames back to look where zero is the last finished frame (default 0).\n"
+                                                "@return The counter value or zero if there is no such counter.")
+{
+   FrameCounter* pCounter = FrameCounters::findCounter( argv[1] );
+   if ( pCounter == NULL )
+   {
+      Con::warnf( "getFrameCounter() - Could not find counter '%s'.", argv[1] );
+      return 0.0f;
+   }
+
+   return pCounter->getHistory( argc > 2 ? getMax( dAtoi(argv[2]), 0 ) : 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( getFrameCounterRange, const char*, 2, 2,   "(counterName) Gets the range of a frame counter over the history.\n"
+                                                            "@param counterName The name of the counter.\n"
+                                                            "@return The minimum, average and maximum separated by spaces.")
+{
+   FrameCounter* pCounter = FrameCounters::findCounter( argv[1] );
+   if ( pCounter == NULL )
+   {
+      Con::warnf( "getFrameCounterRange() - Could not find counter '%s'.", argv[1] );
+      return StringTable->EmptyString;
+   }
+
+   F32 minimum, average, maximum;
+   FrameCounters::getRange( pCounter, minimum, average, maximum );
+
+   char* pBuffer = Con::getReturnBuffer( 64 );
+   dSprintf( pBuffer, 64, "%g %g %g", minimum, average, maximum );
+   return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( getFrameCounterNames, const char*, 1, 1,   "() Gets the names of all frame counters.\n"
+                                                            "@return The counter names separated by spaces.")
+{
+   U32 length = 0;
+   for ( FrameCounter* pCounter = FrameCounters::getFirstCounter(); pCounter != NULL; pCounter = pCounter->getNext() )
+      length += dStrlen( pCounter->getName() ) + 1;
+
+   char* pBuffer = Con::getReturnBuffer( length + 1 );
+   pBuffer[0] = 0;
+   for ( FrameCounter* pCounter = FrameCounters::getFirstCounter(); pCounter != NULL; pCounter = pCounter->getNext() )
+   {
+      if ( pBuffer[0] != 0 )
+         dStrcat( pBuffer, " " );
+      dStrcat( pBuffer, pCounter->getName() );
+   }
+
+   return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( setFrameCounter, void, 3, 3,   "(counterName, value) Publishes a gauge from script, creating it if needed.\n"
+                                                "@param counterName The name of the counter.\n"
+                                                "@param value The value for this frame onwards.\n"
+                                                "@return No return value.")
+{
+   FrameCounters::findOrCreateCounter( argv[1], FrameCounter::Gauge )->set( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( addFrameCounter, void, 3, 3,   "(counterName, value) Adds to an accumulating counter from script, creating it if needed.\n"
+                                                "@param counterName The name of the counter.\n"
+                                                "@param value The amount to add this frame.\n"
+                                                "@return No return value.")
+{
+   FrameCounters::findOrCreateCounter( argv[1], FrameCounter::Accumulate )->add( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( setFrameCounterHistory, void, 2, 2,    "(frames) Sets how many frames of history are kept, discarding the current history.\n"
+                                                        "@param frames The number of frames.\n"
+                                                        "@return No return value.")
+{
+   FrameCounters::setHistoryLength( getMax( dAtoi(argv[1]), 1 ) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( setFrameSpikeCapture, void, 2, 3,  "(thresholdMs, [filePrefix]) Captures the counters of any frame slower than the threshold.\n"
+                                                    "When a file prefix is given the profiler state is also written for each spike: the captured "
+                                                    "timeline if a profiler capture is running, otherwise the aggregate profile if the profiler is enabled.\n"
+                                                    "@param thresholdMs The frame time in milliseconds that counts as a spike or zero to disable.\n"
+                                                    "@param filePrefix The path the frame number and extension are appended to.\n"
+                                                    "@return No return value.")
+{
+   FrameCounters::setSpikeCapture( dAtof(argv[1]), argc > 2 ? argv[2] : NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( clearFrameSpikes, void, 1, 1,  "() Discards the captured spikes.\n"
+                                                "@return No return value.")
+{
+   FrameCounters::clearSpikes();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( dumpFrameCounters, void, 1, 1, "() Prints the last value and range of every frame counter.\n"
+                                                "@return No return value.")
+{
+   FrameCounters::dump();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( dumpFrameSpikes, void, 1, 1,   "() Prints the counters of each captured spike.\n"
+                                                "@return No return value.")
+{
+   FrameCounters::dumpSpikes();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( dumpFrameCountersToCsv, bool, 2, 2,    "(fileName) Writes the frame counter history as comma separated values.\n"
+                                                        "@param fileName The file to write.\n"
+                                                        "@return Whether the file was written or not.")
+{
+   return FrameCounters::dumpCsv( argv[1] );
+}
+
+ConsoleFunctionGroupEnd( FrameCounters );
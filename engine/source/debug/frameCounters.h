@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _FRAME_COUNTERS_H_
+#define _FRAME_COUNTERS_H_
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A named value published once per frame.
+///
+/// Counters are normally declared as statics next to the code that publishes
+/// them, for example:
+/// @code
+/// static FrameCounter sgFlushCounter( "batch.flushes" );
+/// ...
+/// sgFlushCounter.increment();
+/// @endcode
+///
+/// An accumulating counter sums everything added during a frame and starts
+/// the next frame at zero.  A gauge keeps its value until it is set again.
+/// A gauge can also be given a sample callback which is called at the end
+/// of every frame to fetch its value.
+///
+/// Counters must only be published from the main thread.
+class FrameCounter
+{
+   friend class FrameCounters;
+
+public:
+   enum Type
+   {
+      Accumulate,
+      Gauge
+   };
+
+   typedef F32 (*SampleCallback)( void );
+
+   FrameCounter( const char* pName, const Type type = Accumulate );
+   FrameCounter( const char* pName, SampleCallback callback );
+
+   inline const char* getName( void ) const             { return mName; }
+   inline Type getType( void ) const                    { return mType; }
+   inline FrameCounter* getNext( void ) const           { return mpNext; }
+
+   /// The value published so far this frame.
+   inline F32 getValue( void ) const                    { return mValue; }
+   inline void set( const F32 value )                   { mValue = value; }
+   inline void add( const F32 value )                   { mValue += value; }
+   inline void increment( void )                        { mValue += 1.0f; }
+
+   /// Gets a recorded value where zero is the most recently finished frame.
+   /// Frames older than the history return zero.
+   F32 getHistory( const U32 framesAgo ) const;
+
+private:
+   void registerCounter( const char* pName, const Type type, SampleCallback callback );
+
+   const char*       mName;
+   Type              mType;
+   SampleCallback    mSampleCallback;
+   F32               mValue;
+   F32*              mpHistory;
+   bool              mOwned;
+   FrameCounter*     mpNext;
+};
+
+//-----------------------------------------------------------------------------
+
+/// The registry of frame counters.
+///
+/// endFrame() is called once per frame by the main loop.  It records every
+/// counter into a ring history and, when the frame took longer than the
+/// spike threshold, keeps a snapshot of the counters for that frame and
+/// writes out the profiler state: the captured timeline if a profiler
+/// capture is running, otherwise the aggregate profile if the profiler is
+/// enabled.
+class FrameCounters
+{
+public:
+   /// The counters of a frame that exceeded the spike threshold.
+   struct Spike
+   {
+      struct Sample
+      {
+         const char* mName;
+         F32         mValue;
+      };
+
+      U32            mFrame;
+      F32            mFrameMs;
+      Vector<Sample> mSamples;
+   };
+
+   enum
+   {
+      DefaultHistoryLength = 300,
+      MaxSpikes = 16,
+      SpikeCooldownFrames = 60,
+      SpikeFilePrefixLength = 256
+   };
+
+   static void shutdown( void );
+
+   /// Records the counters for the frame that has just finished.
+   static void endFrame( void );
+
+   static FrameCounter* findCounter( const char* pName );
+
+   /// Finds a counter or creates it for publishing from script.
+   static FrameCounter* findOrCreateCounter( const char* pName, const FrameCounter::Type type );
+
+   static inline FrameCounter* getFirstCounter( void )  { return smFirstCounter; }
+
+   /// The number of frames recorded so far.
+   static inline U32 getFrameCount( void )              { return smFrameCount; }
+
+   /// The number of frames currently held in the history.
+   static inline U32 getHistoryCount( void )            { return smFrameCount < smHistoryLength ? smFrameCount : smHistoryLength; }
+
+   static inline U32 getHistoryLength( void )           { return smHistoryLength; }
+
+   /// Resizes the history, discarding everything recorded so far.
+   static void setHistoryLength( const U32 frames );
+
+   /// Gets the minimum, average and maximum of a counter over the history.
+   static void getRange( const FrameCounter* pCounter, F32& minimum, F32& average, F32& maximum );
+
+   /// Sets the frame time above which a spike is captured.  Zero disables spike capture.
+   /// @param pFilePrefix Where to write the profiler state, with the frame number appended, or NULL for counters only.
+   static void setSpikeCapture( const F32 thresholdMs, const char* pFilePrefix );
+   static inline F32 getSpikeThreshold( void )          { return smSpikeThresholdMs; }
+
+   static inline const Vector<Spike*>& getSpikes( void ) { return smSpikes; }
+   static void clearSpikes( void );
+
+   static void dump( void );
+   static void dumpSpikes( void );
+
+   /// Writes the history as comma separated values, one row per frame.
+   static bool dumpCsv( const char* pFileName );
+
+private:
+   friend class FrameCounter;
+
+   static void addCounter( FrameCounter* pCounter );
+   static void captureSpike( const F32 frameMs );
+
+   static FrameCounter*    smFirstCounter;
+   static U32              smFrameCount;
+   static U32              smHistoryLength;
+   static U64              smLastFrameTime;
+   static F32              smSpikeThresholdMs;
+   static U32              smLastSpikeFrame;
+   static char             smSpikeFilePrefix[SpikeFilePrefixLength];
+   static Vector<Spike*>   smSpikes;
+};
+
+#endif // _FRAME_COUNTERS_H_
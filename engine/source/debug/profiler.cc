@@ -29,6 +29,9 @@
 #include "collection/vector.h"
 #include "io/fileStream.h"
 #include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
+#include "platform/platformIntrinsics.h"
+#include "math/mMathFn.h"
 
 #ifdef TORQUE_ENABLE_PROFILER
 ProfilerRootData *ProfilerRootData::sRootList = NULL;
@@ -38,124 +41,54 @@ Profiler *gProfiler = NULL;
 U32 gMainThread = 0;
 #endif
 
-#if defined(TORQUE_SUPPORTS_VC_INLINE_X86_ASM)
-// platform specific get hires times...
-void startHighResolutionTimer(U32 time[2])
-{
-   //time[0] = Platform::getRealMilliseconds();
-
-   __asm
-   {
-      push eax
-      push edx
-      push ecx
-      rdtsc
-      mov ecx, time
-      mov DWORD PTR [ecx], eax
-      mov DWORD PTR [ecx + 4], edx
-      pop ecx
-      pop edx
-      pop eax
-   }
-}
-
-U32 endHighResolutionTimer(U32 time[2])
-{
-   U32 ticks;
-   //ticks = Platform::getRealMilliseconds() - time[0];
-   //return ticks;
-
-   __asm
-   {
-      push  eax
-      push  edx
-      push  ecx
-      //db    0fh, 31h
-      rdtsc
-      mov   ecx, time
-      sub   edx, DWORD PTR [ecx+4]
-      sbb   eax, DWORD PTR [ecx]
-      mov   DWORD PTR ticks, eax
-      pop   ecx
-      pop   edx
-      pop   eax
-   }
-   return ticks;
-}
-
-#elif defined(TORQUE_SUPPORTS_GCC_INLINE_X86_ASM)
+//-----------------------------------------------------------------------------
 
-// platform specific get hires times...
-void startHighResolutionTimer(U32 time[2])
+/// An event recorded in a thread capture buffer.
+struct ProfilerEvent
 {
-   __asm__ __volatile__(
-      "rdtsc\n"
-      : "=a" (time[0]), "=d" (time[1])
-      );
-}
-
-U32 endHighResolutionTimer(U32 time[2])
+   enum Type {
+      Begin,
+      End,
+      Frame
+   };
+
+   ProfilerRootData *mRoot;
+   U64 mTime;
+   U32 mType;
+};
+
+/// The capture ring buffer of a single thread.
+///
+/// Only the owning thread writes to a buffer so recording needs no locks.
+/// Buffers are never freed while the profiler exists; once a thread exits
+/// its buffer keeps its events for export and can then be claimed by a new
+/// thread when a later capture starts.
+struct ProfilerThreadBuffer
 {
-   U32 ticks;
-   __asm__ __volatile__(
-      "rdtsc\n"
-      "sub  0x4(%%ecx),  %%edx\n"
-      "sbb  (%%ecx),  %%eax\n"
-      : "=a" (ticks) : "c" (time)
-      );
-   return ticks;
-}
-
-#elif defined(TORQUE_OS_MAC_CARB)
-
-#include <Timer.h>
-#include <Math64.h>
-
-void startHighResolutionTimer(U32 time[2]) {
-    UnsignedWide t;
-    Microseconds(&t);
-    time[0] = t.lo;
-    time[1] = t.hi;
-}
-
-U32 endHighResolutionTimer(U32 time[2])  {
-   UnsignedWide t;
-   Microseconds(&t);
-   return t.lo - time[0]; 
-   // given that we're returning a 32 bit integer, and this is unsigned subtraction... 
-   // it will just wrap around, we don't need the upper word of the time.
-   // NOTE: the code assumes that more than 3 hrs will not go by between calls to startHighResolutionTimer() and endHighResolutionTimer().
-   // I mean... that damn well better not happen anyway.
-}
-
-#elif defined(TORQUE_OS_IOS)
-
-//-Mat added high resolution iPhone timer 
-#import <mach/mach_time.h>
-#include <Math64.h>
-
-void startHighResolutionTimer(U32 time[2]) {
-    time[0] = mach_absolute_time();
-}
-
-U32 endHighResolutionTimer(U32 time[2])  {
-    return mach_absolute_time() - time[0];
-}
-
-
+   enum {
+      MaxStackDepth = 256
+   };
+
+   U32 mThreadId;
+   U32 mOwned;             ///< Guarded by the buffer mutex of the profiler.
+   U32 mGeneration;        ///< Capture the events belong to.
+   ProfilerEvent *mEvents;
+   U32 mCapacity;          ///< Always a power of two.
+   volatile U32 mWriteCount;  ///< Total events written, the ring index is this masked by the capacity.
+   U32 mDepth;
+   ProfilerRootData *mStack[MaxStackDepth];  ///< Open scopes, NULL for scopes that were not recorded.
+   ProfilerThreadBuffer *mNext;
+};
+
+#ifdef TORQUE_THREAD_LOCAL
+static TORQUE_THREAD_LOCAL ProfilerThreadBuffer *sgThreadBuffer = NULL;
 #else
-
-void startHighResolutionTimer(U32 time[2])
-{
-}
-
-U32 endHighResolutionTimer(U32 time[2])
-{
-   return 1;
-}
-
+// No thread local storage so only the main thread is captured.
+static ProfilerThreadBuffer *sgThreadBuffer = NULL;
 #endif
 
+//-----------------------------------------------------------------------------
+
 Profiler::Profiler()
 {
    mMaxStackDepth = MaxStackDepth;
@@ -190,6 +123,15 @@ Profiler::Profiler()
    mDumpToFile      = false;
    mDumpFileName[0] = '\0';
 
+   mCapturing = false;
+   mCaptureGeneration = 0;
+   mCaptureEvents = 0;
+   mCaptureStartTime = 0;
+   mCaptureStopTime = 0;
+   mCaptureFrameCount = 0;
+   mThreadBufferList = NULL;
+   mThreadBufferMutex = Mutex::createMutex();
+
 #ifdef TORQUE_MULTITHREAD
    gMainThread = ThreadManager::getCurrentThreadId();
 #endif
@@ -197,6 +139,18 @@ Profiler::Profiler()
 
 Profiler::~Profiler()
 {
+   mCapturing = false;
+   while(mThreadBufferList)
+   {
+      ProfilerThreadBuffer *buffer = mThreadBufferList;
+      mThreadBufferList = buffer->mNext;
+      free(buffer->mEvents);
+      free(buffer);
+   }
+   sgThreadBuffer = NULL;
+   Mutex::destroyMutex(mThreadBufferMutex);
+   mThreadBufferMutex = NULL;
+
    reset();
    free(mRootProfilerData);
    gProfiler = NULL;
@@ -274,6 +228,17 @@ void Profiler::validate()
 
 void Profiler::hashPush(ProfilerRootData *root)
 {
+   // Record the event in the capture of the calling thread.  The aggregate
+   // data below is timed with the same timestamp.
+   U64 time = 0;
+   bool timed = false;
+   if(mCapturing)
+   {
+      time = Platform::getPerformanceCounter();
+      timed = true;
+      captureBegin(root, time);
+   }
+
 #ifdef TORQUE_MULTITHREAD
    // Ignore non-main-thread profiler activity.
    if(! ThreadManager::isCurrentThread(gMainThread) )
@@ -338,7 +303,7 @@ void Profiler::hashPush(ProfilerRootData *root)
    }
    root->mTotalInvokeCount++;
    nextProfiler->mInvokeCount++;
-   startHighResolutionTimer(nextProfiler->mStartTime);
+   nextProfiler->mStartTime = timed ? time : Platform::getPerformanceCounter();
    mCurrentProfilerData->mLastSeenProfiler = nextProfiler;
    mCurrentProfilerData = nextProfiler;
 }
@@ -370,6 +335,15 @@ void Profiler::dumpToFile(const char* fileName)
 
 void Profiler::hashPop()
 {
+   U64 time = 0;
+   bool timed = false;
+   if(mCapturing)
+   {
+      time = Platform::getPerformanceCounter();
+      timed = true;
+      captureEnd(time);
+   }
+
 #ifdef TORQUE_MULTITHREAD
    // Ignore non-main-thread profiler activity.
    if(! ThreadManager::isCurrentThread(gMainThread) )
@@ -385,7 +359,9 @@ void Profiler::hashPop()
          mCurrentProfilerData->mSubDepth--;
          return;
       }
-      F64 fElapsed = endHighResolutionTimer(mCurrentProfilerData->mStartTime);
+      if(!timed)
+         time = Platform::getPerformanceCounter();
+      F64 fElapsed = F64(time - mCurrentProfilerData->mStartTime);
       mCurrentProfilerData->mTotalTime += fElapsed;
       mCurrentProfilerData->mParent->mSubTime += fElapsed; // mark it in the parent as well...
       mCurrentProfilerData->mRoot->mTotalTime += fElapsed;
@@ -395,14 +371,18 @@ void Profiler::hashPop()
    }
    if(mStackDepth == 0)
    {
+      // the main loop has finished a frame...
+      if(mCapturing)
+         captureFrame(timed ? time : Platform::getPerformanceCounter());
+
       // apply the next enable...
       if(mDumpToConsole || mDumpToFile)
       {
          dump();
-         startHighResolutionTimer(mCurrentProfilerData->mStartTime);
+         mCurrentProfilerData->mStartTime = Platform::getPerformanceCounter();
       }
       if(!mEnabled && mNextEnable)
-         startHighResolutionTimer(mCurrentProfilerData->mStartTime);
+         mCurrentProfilerData->mStartTime = Platform::getPerformanceCounter();
       mEnabled = mNextEnable;
    }
 }
@@ -530,7 +510,7 @@ void Profiler::dump()
       Con::printf("Ordered by stack trace total time -");
       Con::printf("%% Time  %% NSTime  Invoke #  Name");
 
-      mCurrentProfilerData->mTotalTime = endHighResolutionTimer(mCurrentProfilerData->mStartTime);
+      mCurrentProfilerData->mTotalTime = F64(Platform::getPerformanceCounter() - mCurrentProfilerData->mStartTime);
 
       char depthBuffer[MaxStackDepth * 2 + 1];
       depthBuffer[0] = 0;
@@ -570,7 +550,7 @@ void Profiler::dump()
          dStrcpy(buffer, "%%NSTime  %% Time  Invoke #  Name\n");
          fws.write(dStrlen(buffer), buffer);
 
-      mCurrentProfilerData->mTotalTime = endHighResolutionTimer(mCurrentProfilerData->mStartTime);
+      mCurrentProfilerData->mTotalTime = F64(Platform::getPerformanceCounter() - mCurrentProfilerData->mStartTime);
 
       char depthBuffer[MaxStackDepth * 2 + 1];
       depthBuffer[0] = 0;
@@ -609,6 +589,276 @@ void Profiler::enableMarker(const char *marker, bool enable)
    }
 }
 
+//-----------------------------------------------------------------------------
+
+static inline void recordEvent(ProfilerThreadBuffer *buffer, ProfilerRootData *root, const U32 type, const U64 time)
+{
+   ProfilerEvent &event = buffer->mEvents[buffer->mWriteCount & (buffer->mCapacity - 1)];
+   event.mRoot = root;
+   event.mTime = time;
+   event.mType = type;
+
+   // Publish the event only once it is complete so an export never reads a partial one.
+   dAtomicWrite(buffer->mWriteCount, buffer->mWriteCount + 1);
+}
+
+ProfilerThreadBuffer *Profiler::acquireThreadBuffer()
+{
+   MutexHandle handle;
+   handle.lock(mThreadBufferMutex, true);
+
+   const U32 generation = dAtomicRead(mCaptureGeneration);
+
+   // Take over the buffer of a thread that has exited unless it holds the current capture.
+   for(ProfilerThreadBuffer *walk = mThreadBufferList; walk; walk = walk->mNext)
+   {
+      if(walk->mGeneration != generation && walk->mOwned == 0)
+      {
+         walk->mOwned = 1;
+         return walk;
+      }
+   }
+
+   ProfilerThreadBuffer *buffer = (ProfilerThreadBuffer *) malloc(sizeof(ProfilerThreadBuffer));
+   buffer->mThreadId = ThreadManager::getCurrentThreadId();
+   buffer->mOwned = 1;
+   buffer->mGeneration = 0;
+   buffer->mEvents = NULL;
+   buffer->mCapacity = 0;
+   buffer->mWriteCount = 0;
+   buffer->mDepth = 0;
+
+   // Link it into the buffer list.
+   buffer->mNext = mThreadBufferList;
+   mThreadBufferList = buffer;
+
+   return buffer;
+}
+
+ProfilerThreadBuffer *Profiler::getThreadBuffer()
+{
+#if !defined(TORQUE_THREAD_LOCAL) && defined(TORQUE_MULTITHREAD)
+   if(! ThreadManager::isCurrentThread(gMainThread) )
+      return NULL;
+#endif
+
+   ProfilerThreadBuffer *buffer = sgThreadBuffer;
+   if(!buffer)
+   {
+      buffer = acquireThreadBuffer();
+      sgThreadBuffer = buffer;
+   }
+
+   // Start afresh if the buffer holds an earlier capture.
+   const U32 generation = dAtomicRead(mCaptureGeneration);
+   if(buffer->mGeneration != generation)
+   {
+      if(buffer->mCapacity != mCaptureEvents)
+      {
+         free(buffer->mEvents);
+         buffer->mEvents = (ProfilerEvent *) malloc(sizeof(ProfilerEvent) * mCaptureEvents);
+         buffer->mCapacity = mCaptureEvents;
+      }
+      buffer->mThreadId = ThreadManager::getCurrentThreadId();
+      buffer->mWriteCount = 0;
+      buffer->mDepth = 0;
+      buffer->mGeneration = generation;
+   }
+
+   return buffer;
+}
+
+void Profiler::captureBegin(ProfilerRootData *root, const U64 time)
+{
+   ProfilerThreadBuffer *buffer = getThreadBuffer();
+   if(!buffer)
+      return;
+
+   // Scopes too deep to remember are not recorded at all so their ends are skipped too.
+   ProfilerRootData *recorded = root->mEnabled && buffer->mDepth < ProfilerThreadBuffer::MaxStackDepth ? root : NULL;
+   if(buffer->mDepth < ProfilerThreadBuffer::MaxStackDepth)
+      buffer->mStack[buffer->mDepth] = recorded;
+   buffer->mDepth++;
+
+   if(recorded)
+      recordEvent(buffer, root, ProfilerEvent::Begin, time);
+}
+
+void Profiler::captureEnd(const U64 time)
+{
+   ProfilerThreadBuffer *buffer = getThreadBuffer();
+
+   // Ignore scopes that were opened before the capture started.
+   if(!buffer || buffer->mDepth == 0)
+      return;
+
+   buffer->mDepth--;
+   if(buffer->mDepth < ProfilerThreadBuffer::MaxStackDepth && buffer->mStack[buffer->mDepth])
+      recordEvent(buffer, buffer->mStack[buffer->mDepth], ProfilerEvent::End, time);
+}
+
+void Profiler::captureFrame(const U64 time)
+{
+   ProfilerThreadBuffer *buffer = getThreadBuffer();
+   if(!buffer)
+      return;
+
+   recordEvent(buffer, NULL, ProfilerEvent::Frame, time);
+   mCaptureFrameCount++;
+}
+
+void Profiler::startCapture(const U32 eventsPerThread)
+{
+   mCapturing = false;
+   mCaptureEvents = getNextPow2(getMax(eventsPerThread, (U32)MinCaptureEvents));
+   mCaptureFrameCount = 0;
+   mCaptureStartTime = Platform::getPerformanceCounter();
+   mCaptureStopTime = mCaptureStartTime;
+
+   // Threads reset their buffers when they see the new capture.
+   dFetchAndAdd(mCaptureGeneration, 1);
+   mCapturing = true;
+
+   Con::printf("Profiler capture started (%d events per thread).", mCaptureEvents);
+}
+
+void Profiler::stopCapture()
+{
+   if(!mCapturing)
+      return;
+
+   mCapturing = false;
+   mCaptureStopTime = Platform::getPerformanceCounter();
+
+   Con::printf("Profiler capture stopped after %d frames.", mCaptureFrameCount);
+}
+
+void Profiler::releaseThread()
+{
+   ProfilerThreadBuffer *buffer = sgThreadBuffer;
+   if(!buffer || !gProfiler)
+      return;
+
+   MutexHandle handle;
+   handle.lock(gProfiler->mThreadBufferMutex, true);
+
+   // The events stay available for export until a new thread claims the buffer.
+   sgThreadBuffer = NULL;
+   buffer->mOwned = 0;
+}
+
+bool Profiler::exportChromeTrace(const char *fileName)
+{
+   stopCapture();
+
+   const U32 generation = dAtomicRead(mCaptureGeneration);
+   if(generation == 0)
+   {
+      Con::warnf("Profiler::exportChromeTrace() - Nothing has been captured.");
+      return false;
+   }
+
+   char pathBuffer[1024];
+   Con::expandPath(pathBuffer, sizeof(pathBuffer), fileName);
+
+   FileStream fws;
+   if(!fws.open(pathBuffer, FileStream::Write))
+   {
+      Con::warnf("Profiler::exportChromeTrace() - Could not open '%s' for writing.", pathBuffer);
+      return false;
+   }
+
+   const F64 ticksToMicroseconds = 1000000.0 / F64(Platform::getPerformanceCounterFrequency());
+   char buffer[512];
+   bool first = true;
+
+   dStrcpy(buffer, "{\"traceEvents\":[\n");
+   fws.write(dStrlen(buffer), buffer);
+
+   // Keep threads from claiming or linking buffers while they are read.
+   MutexHandle handle;
+   handle.lock(mThreadBufferMutex, true);
+
+   for(ProfilerThreadBuffer *walk = mThreadBufferList; walk; walk = walk->mNext)
+   {
+      // Other threads may still be finishing events so only read up to the
+      // count seen here, every event before it is complete.
+      const U32 count = dAtomicRead(walk->mWriteCount);
+      if(walk->mGeneration != generation || count == 0)
+         continue;
+
+#ifdef TORQUE_MULTITHREAD
+      const bool mainThread = ThreadManager::compare(walk->mThreadId, gMainThread);
+#else
+      const bool mainThread = true;
+#endif
+      char threadName[64];
+      if(mainThread)
+         dStrcpy(threadName, "Main Thread");
+      else
+         dSprintf(threadName, sizeof(threadName), "Thread %u", walk->mThreadId);
+
+      dSprintf(buffer, sizeof(buffer), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+         first ? "" : ",\n", walk->mThreadId, threadName);
+      fws.write(dStrlen(buffer), buffer);
+      first = false;
+
+      // Only the newest events remain once the ring has wrapped and the
+      // scopes they close may have been overwritten.
+      const U32 oldest = count > walk->mCapacity ? count - walk->mCapacity : 0;
+      U32 depth = 0;
+      U64 lastTime = mCaptureStartTime;
+
+      for(U32 i = oldest; i < count; i++)
+      {
+         const ProfilerEvent &event = walk->mEvents[i & (walk->mCapacity - 1)];
+         const F64 timestamp = F64(event.mTime - mCaptureStartTime) * ticksToMicroseconds;
+         lastTime = event.mTime;
+
+         switch(event.mType)
+         {
+         case ProfilerEvent::Begin:
+            dSprintf(buffer, sizeof(buffer), ",\n{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+               event.mRoot->mName, timestamp, walk->mThreadId);
+            depth++;
+            break;
+
+         case ProfilerEvent::End:
+            if(depth == 0)
+               continue;
+            dSprintf(buffer, sizeof(buffer), ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+               timestamp, walk->mThreadId);
+            depth--;
+            break;
+
+         default:
+            dSprintf(buffer, sizeof(buffer), ",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+               timestamp, walk->mThreadId);
+            break;
+         }
+         fws.write(dStrlen(buffer), buffer);
+      }
+
+      // Close any scopes still open when the capture stopped.
+      const F64 closeTimestamp = F64((mCaptureStopTime > lastTime ? mCaptureStopTime : lastTime) - mCaptureStartTime) * ticksToMicroseconds;
+      for(; depth > 0; depth--)
+      {
+         dSprintf(buffer, sizeof(buffer), ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+            closeTimestamp, walk->mThreadId);
+         fws.write(dStrlen(buffer), buffer);
+      }
+   }
+
+   handle.unlock();
+
+   dStrcpy(buffer, "\n],\"displayTimeUnit\":\"ms\"}\n");
+   fws.write(dStrlen(buffer), buffer);
+   fws.close();
+
+   Con::printf("Profiler capture exported to '%s'.", pathBuffer);
+   return true;
+}
+
 ConsoleFunctionGroupBegin( Profiler, "Profiler functionality.");
 
 ConsoleFunction(profilerMarkerEnable, void, 3, 3, "(string markerName, bool enable) Enables (or disables) a marker for the profiler\n"
@@ -647,6 +897,32 @@ ConsoleFunction(profilerReset, void, 1, 1, "Resets the profiler, clearing all of
       gProfiler->reset();
 }
 
+ConsoleFunction(profilerCaptureStart, void, 1, 2, "([eventsPerThread]) Starts capturing a timeline of profiler events from every thread.\n"
+                "Each thread keeps only its most recent events.\n"
+                "@param eventsPerThread The size of the event ring buffer of each thread (default 65536).\n"
+                "@return No return value.")
+{
+   if(gProfiler)
+      gProfiler->startCapture(argc > 1 ? dAtoi(argv[1]) : Profiler::DefaultCaptureEvents);
+}
+
+ConsoleFunction(profilerCaptureStop, void, 1, 1, "() Stops capturing the profiler timeline.\n"
+                "@return No return value.")
+{
+   if(gProfiler)
+      gProfiler->stopCapture();
+}
+
+ConsoleFunction(profilerExportChromeTrace, bool, 2, 2, "(string filename) Stops any capture and writes the captured timeline as Chrome trace-event JSON.\n"
+                "The file can be opened with chrome://tracing or Perfetto.\n"
+                "@param filename The file to write.\n"
+                "@return Whether the timeline was written or not.")
+{
+   if(gProfiler)
+      return gProfiler->exportChromeTrace(argv[1]);
+   return false;
+}
+
 ConsoleFunctionGroupEnd( Profiler );
 
 #endif
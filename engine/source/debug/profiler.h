@@ -29,6 +29,7 @@
 
 struct ProfilerData;
 struct ProfilerRootData;
+struct ProfilerThreadBuffer;
 /// The Profiler is used to see how long a specific chunk of code takes to execute.
 /// All values outputted by the profiler are percentages of the time that it takes
 /// to run entire main loop.
@@ -41,8 +42,17 @@ struct ProfilerRootData;
 /// profilerDump();                                         //dumps all profiler data to the console
 /// profilerDumpToFile(string filename);                    //dumps all profiler data to a given file
 /// profilerMarkerEnable((string markerName, bool enable);  //enables or disables a given profile tag
+/// profilerCaptureStart([eventsPerThread]);                 //starts capturing a timeline from every thread
+/// profilerCaptureStop();                                  //stops capturing the timeline
+/// profilerExportChromeTrace(string filename);             //writes the timeline as Chrome trace-event JSON
 /// @endcode
 ///
+/// The aggregate data is only gathered on the main thread.  A capture records
+/// a timestamped event for every marker on every thread, along with a frame
+/// marker each time the main loop finishes, into a ring buffer owned by the
+/// thread so no locks are taken.  When the main thread is profiled, the
+/// aggregate data is timed with the same timestamps as the captured events.
+///
 /// The C++ code side of the profiler uses pairs of PROFILE_START() and PROFILE_END().
 ///
 /// When using these macros, make sure there is a PROFILE_END() for every PROFILE_START
@@ -84,9 +94,30 @@ class Profiler
    bool mDumpToConsole;
    bool mDumpToFile;
    char mDumpFileName[DumpFileNameLength];
+
+   volatile bool mCapturing;
+   volatile U32 mCaptureGeneration;
+   U32 mCaptureEvents;
+   U64 mCaptureStartTime;
+   U64 mCaptureStopTime;
+   U32 mCaptureFrameCount;
+   ProfilerThreadBuffer * volatile mThreadBufferList;
+   void *mThreadBufferMutex;  ///< Guards the buffer list and which thread owns each buffer.
+
    void dump();
    void validate();
+
+   ProfilerThreadBuffer *acquireThreadBuffer();
+   ProfilerThreadBuffer *getThreadBuffer();
+   void captureBegin(ProfilerRootData *root, const U64 time);
+   void captureEnd(const U64 time);
+   void captureFrame(const U64 time);
 public:
+   enum {
+      MinCaptureEvents = 1024,
+      DefaultCaptureEvents = 65536
+   };
+
    Profiler();
    ~Profiler();
 
@@ -99,12 +130,27 @@ public:
    void dumpToFile(const char *fileName);
    /// Enable profiling
    void enable(bool enabled);
+   bool isEnabled() const { return mEnabled; }
    /// Helper function for macro definition PROFILE_START
    void hashPush(ProfilerRootData *data);
    /// Helper function for macro definition PROFILE_END
    void hashPop();
    /// Enable a profiler marker
    void enableMarker(const char *marker, bool enabled);
+
+   /// Starts capturing a timeline of events from every thread, discarding any earlier capture
+   /// @param eventsPerThread size of the ring buffer of each thread, rounded up to a power of two
+   void startCapture(const U32 eventsPerThread);
+   /// Stops capturing, the captured events are kept until the next capture starts
+   void stopCapture();
+   bool isCapturing() const { return mCapturing; }
+   /// The ring buffer size of each thread in the current or last capture
+   U32 getCaptureEvents() const { return mCaptureEvents; }
+   /// Writes the captured events as Chrome trace-event JSON, stopping the capture first
+   /// @param fileName filename to write the trace to
+   bool exportChromeTrace(const char *fileName);
+   /// Called when a thread exits so its capture buffer can be reused by a later thread
+   static void releaseThread();
 };
 
 extern Profiler *gProfiler;
@@ -143,7 +189,7 @@ struct ProfilerData
    U32 mHash;
    U32 mSubDepth;
    U32 mInvokeCount;
-   U32 mStartTime[2];
+   U64 mStartTime;
    F64 mTotalTime;
    F64 mSubTime;
 };
@@ -37,6 +37,7 @@
 #include "io/fileStream.h"
 #include "graphics/TextureManager.h"
 #include "console/console.h"
+#include "console/scriptTask.h"
 #include "sim/simBase.h"
 #include "gui/guiCanvas.h"
 #include "input/actionMap.h"
@@ -53,6 +54,8 @@
 #include "memory/frameAllocator.h"
 #include "game/version.h"
 #include "debug/profiler.h"
+#include "debug/frameCounters.h"
+#include "platform/threads/threadPool.h"
 #include "network/serverQuery.h"
 #include "game/defaultGame.h"
 #include "platform/nativeDialogs/msgBox.h"
@@ -137,6 +140,9 @@ bool initializeLibraries()
     FrameAllocator::init(3 << 20);      // 3 meg frame allocator buffer
 #endif	//TORQUE_OS_IOS
 
+    // Start the worker threads used for background loading.
+    ThreadPool::init();
+
     TextureManager::create();
     ResManager::create();
 
@@ -175,6 +181,9 @@ bool initializeLibraries()
 
 void shutdownLibraries()
 {
+    // Stop the worker threads before anything they use is destroyed.
+    ThreadPool::shutdown();
+
     // Purge any resources on the timeout list...
     if (ResourceManager)
         ResourceManager->purge();
@@ -194,6 +203,8 @@ void shutdownLibraries()
     // Destroy the stock colors.
     StockColor::destroy();
 
+    FrameCounters::shutdown();
+
     _StringTable::destroy();
 
     // asserts should be destroyed LAST
@@ -594,6 +605,20 @@ iPhoneProfilerStart("SERVER_PROC");
 #endif
     PROFILE_END();
 
+   PROFILE_START(ScriptTaskProcess);
+   ScriptTaskScheduler::process();
+   PROFILE_END();
+
+   // Finish any background work, such as asset loads, on the main thread.
+   PROFILE_START(ThreadPoolProcess);
+   ThreadPool::getGlobal()->processCompleted();
+   PROFILE_END();
+
+   // Upload textures loaded in the background within the frame budget.
+   PROFILE_START(TextureUploadProcess);
+   TextureManager::processUploads();
+   PROFILE_END();
+
    PROFILE_START(ClientProcess);
 #ifdef TORQUE_OS_IOS_PROFILE
     iPhoneProfilerStart("CLIENT_PROC");
@@ -646,6 +671,10 @@ iPhoneProfilerEnd("GL_RENDER");
 #endif
    }
    GNet->checkTimeouts();
+
+   // Release any frame allocator overflow and close the frame statistics.
+   FrameAllocator::endFrame();
+   FrameCounters::endFrame();
     
 #ifdef TORQUE_ALLOW_MUSICPLAYER
     updateVolume();
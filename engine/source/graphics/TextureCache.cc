@@ -0,0 +1,289 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "graphics/TextureCache.h"
+#include "graphics/TextureManager.h"
+#include "graphics/gBitmap.h"
+#include "io/fileStream.h"
+#include "algorithm/crc.h"
+#include "memory/memoryAllocator.h"
+#include "memory/safeDelete.h"
+#include "platform/threads/mutex.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+extern bool sgForcePalletedPNGsTo16Bit;
+extern bool sgForcePalletedBMPsTo16Bit;
+
+bool TextureCache::smEnabled = true;
+char TextureCache::smCachePath[1024] = "";
+Mutex* TextureCache::smpCreatePathMutex = NULL;
+
+/// The longest source path stored in a cache file.
+static const U32 sMaxCachePathLength = 1023;
+
+//-----------------------------------------------------------------------------
+
+static U32 getDecodeOptions( void )
+{
+    // The bitmap readers decode differently depending on these so a cached
+    // bitmap is only valid for the options it was decoded with.
+    return (sgForcePalletedPNGsTo16Bit ? BIT(0) : 0) | (sgForcePalletedBMPsTo16Bit ? BIT(1) : 0);
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 getBytesPerPixel( const GBitmap::BitmapFormat format )
+{
+    switch( format )
+    {
+        case GBitmap::Alpha:
+        case GBitmap::Luminance:
+        case GBitmap::Intensity:
+            return 1;
+
+        case GBitmap::RGB565:
+        case GBitmap::RGB5551:
+            return 2;
+
+        case GBitmap::RGB:
+            return 3;
+
+        case GBitmap::RGBA:
+            return 4;
+
+        default:
+            // Palettized and compressed formats are not cached.
+            return 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::create( void )
+{
+    AssertFatal( smpCreatePathMutex == NULL, "TextureCache::create() - Already created." );
+
+    smpCreatePathMutex = new Mutex;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::destroy( void )
+{
+    SAFE_DELETE( smpCreatePathMutex );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::setCachePath( const char* pCachePath )
+{
+    dStrncpy( smCachePath, pCachePath != NULL ? pCachePath : "", sizeof(smCachePath) );
+    smCachePath[sizeof(smCachePath)-1] = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::getCacheFilePath( const char* pSourceFilePath, char* pBuffer, const U32 bufferSize )
+{
+    const char* pCachePath = smCachePath[0] != 0 ? smCachePath : Platform::getPrefsPath( "textureCache" );
+    const U32 pathHash = calculateCRC( pSourceFilePath, dStrlen(pSourceFilePath) );
+    dSprintf( pBuffer, bufferSize, "%s/%08x.%s", pCachePath, pathHash, TEXTURE_CACHE_EXTENSION );
+}
+
+//-----------------------------------------------------------------------------
+
+GBitmap* TextureCache::load( const char* pSourceFilePath, const char* pCacheFilePath )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureCache_Load);
+
+    if ( !smEnabled )
+        return NULL;
+
+    // Fetch the source file state.
+    FileTime modifyTime;
+    if ( !Platform::getFileTimes( pSourceFilePath, NULL, &modifyTime ) )
+        return NULL;
+    const S32 fileSize = Platform::getFileSize( pSourceFilePath );
+
+    // Open the cache file.
+    FileStream stream;
+    if ( !stream.open( pCacheFilePath, FileStream::Read ) )
+        return NULL;
+
+    // Check the signature, version and the platform file time size.
+    StringTableEntry cacheSignature = stream.readSTString();
+    U32 versionId = 0;
+    U32 fileTimeSize = 0;
+    stream.read( &versionId );
+    stream.read( &fileTimeSize );
+
+    if ( cacheSignature != StringTable->insert( TEXTURE_CACHE_SIGNATURE ) || versionId != CacheVersion || fileTimeSize != sizeof(FileTime) )
+    {
+        stream.close();
+        return NULL;
+    }
+
+    // Check the cache file is for this source, as it was decoded.
+    char sourcePathBuffer[sMaxCachePathLength + 1];
+    sourcePathBuffer[0] = 0;
+    stream.readLongString( sMaxCachePathLength, sourcePathBuffer );
+
+    S32 cachedFileSize = -1;
+    FileTime cachedModifyTime;
+    U32 decodeOptions = 0;
+    stream.read( &cachedFileSize );
+    stream.read( sizeof(FileTime), &cachedModifyTime );
+    stream.read( &decodeOptions );
+
+    if ( stream.getStatus() != Stream::Ok ||
+        dStrcmp( sourcePathBuffer, pSourceFilePath ) != 0 ||
+        cachedFileSize != fileSize ||
+        Platform::compareFileTimes( cachedModifyTime, modifyTime ) != 0 ||
+        decodeOptions != getDecodeOptions() )
+    {
+        stream.close();
+        return NULL;
+    }
+
+    // Read the bitmap layout.
+    U32 format = 0;
+    U32 width = 0;
+    U32 height = 0;
+    U32 numMipLevels = 0;
+    U32 byteSize = 0;
+    U32 mipLevelOffsets[GBitmap::c_maxMipLevels];
+    stream.read( &format );
+    stream.read( &width );
+    stream.read( &height );
+    stream.read( &numMipLevels );
+    for ( U32 index = 0; index < GBitmap::c_maxMipLevels; ++index )
+        stream.read( &mipLevelOffsets[index] );
+    stream.read( &byteSize );
+
+    // Check the layout is sane before trusting the sizes in it.
+    const U32 bytesPerPixel = getBytesPerPixel( (GBitmap::BitmapFormat)format );
+    bool validLayout =
+        stream.getStatus() == Stream::Ok &&
+        bytesPerPixel != 0 &&
+        width != 0 && width <= MaximumProductSupportedTextureWidth &&
+        height != 0 && height <= MaximumProductSupportedTextureHeight &&
+        numMipLevels != 0 && numMipLevels <= GBitmap::c_maxMipLevels &&
+        byteSize >= width * height * bytesPerPixel && byteSize <= width * height * bytesPerPixel * 2;
+
+    for ( U32 index = 0; validLayout && index < numMipLevels; ++index )
+        validLayout = mipLevelOffsets[index] < byteSize;
+
+    if ( !validLayout )
+    {
+        stream.close();
+        return NULL;
+    }
+
+    // Read the texels straight into the bitmap.
+    GBitmap* pBitmap = new GBitmap();
+    pBitmap->internalFormat = (GBitmap::BitmapFormat)format;
+    pBitmap->bytesPerPixel = bytesPerPixel;
+    pBitmap->width = width;
+    pBitmap->height = height;
+    pBitmap->numMipLevels = numMipLevels;
+    for ( U32 index = 0; index < GBitmap::c_maxMipLevels; ++index )
+        pBitmap->mipLevelOffsets[index] = mipLevelOffsets[index];
+    pBitmap->byteSize = byteSize;
+    pBitmap->pBits = (U8*)MemoryAllocator::allocate( byteSize, MemoryAllocator::TexturesTag );
+
+    const bool loaded = stream.read( byteSize, pBitmap->pBits );
+    stream.close();
+
+    if ( !loaded )
+    {
+        delete pBitmap;
+        return NULL;
+    }
+
+    return pBitmap;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureCache::store( const char* pSourceFilePath, const char* pCacheFilePath, const GBitmap* pBitmap )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureCache_Store);
+
+    if ( !smEnabled || pBitmap == NULL || getBytesPerPixel( pBitmap->getFormat() ) == 0 || dStrlen(pSourceFilePath) > sMaxCachePathLength )
+        return false;
+
+    // Fetch the source file state.
+    FileTime modifyTime;
+    if ( !Platform::getFileTimes( pSourceFilePath, NULL, &modifyTime ) )
+        return false;
+    const S32 fileSize = Platform::getFileSize( pSourceFilePath );
+
+    // Create the cache directory.  Loads on the thread pool store their
+    // bitmaps too so only one thread creates directories at a time.
+    {
+        MutexHandle mutex;
+        if ( smpCreatePathMutex != NULL )
+            mutex.lock( smpCreatePathMutex, true );
+
+        if ( !Platform::createPath( pCacheFilePath ) )
+            return false;
+    }
+
+    // Open the cache file.
+
+    FileStream stream;
+    if ( !stream.open( pCacheFilePath, FileStream::Write ) )
+        return false;
+
+    // Write the signature, version and the platform file time size.
+    stream.writeString( TEXTURE_CACHE_SIGNATURE );
+    stream.write( (U32)CacheVersion );
+    stream.write( (U32)sizeof(FileTime) );
+
+    // Write the source state.
+    stream.writeLongString( sMaxCachePathLength, pSourceFilePath );
+    stream.write( fileSize );
+    stream.write( sizeof(FileTime), &modifyTime );
+    stream.write( getDecodeOptions() );
+
+    // Write the bitmap.
+    stream.write( (U32)pBitmap->getFormat() );
+    stream.write( pBitmap->width );
+    stream.write( pBitmap->height );
+    stream.write( pBitmap->numMipLevels );
+    for ( U32 index = 0; index < GBitmap::c_maxMipLevels; ++index )
+        stream.write( pBitmap->mipLevelOffsets[index] );
+    stream.write( pBitmap->byteSize );
+    stream.write( pBitmap->byteSize, pBitmap->pBits );
+
+    const bool stored = stream.getStatus() == Stream::Ok;
+    stream.close();
+
+    return stored;
+}
@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TEXTURE_CACHE_H_
+#define _TEXTURE_CACHE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class GBitmap;
+class Mutex;
+
+//-----------------------------------------------------------------------------
+
+#define TEXTURE_CACHE_SIGNATURE     "TextureCache"
+#define TEXTURE_CACHE_EXTENSION     "tcache"
+
+//-----------------------------------------------------------------------------
+
+/// An on-disk cache of decoded bitmaps.
+///
+/// Each cached bitmap is stored in its own file, named from a hash of the full
+/// path of the source image, along with the size and modified time the source
+/// had when it was decoded.  Loading a cached bitmap reads the texels straight
+/// into the bitmap so no image decoding is done.  A cache file is ignored if the
+/// source has changed since, or if it was written by a different cache version.
+class TextureCache
+{
+public:
+    /// The cache format version.  Cache files with any other version are ignored.
+    enum { CacheVersion = 1 };
+
+    /// Whether bitmaps are loaded from and stored to the cache.
+    static bool smEnabled;
+
+    /// Creates and destroys the lock that serializes creating the cache directory.
+    /// These are called by the texture manager.
+    static void create( void );
+    static void destroy( void );
+
+    /// Sets the directory the cache files are kept in.  If empty then the
+    /// "textureCache" directory in the preferences path is used.
+    static void setCachePath( const char* pCachePath );
+
+    /// Gets the path of the cache file for a source image.  This reads the
+    /// preferences so it must be called on the main thread.
+    static void getCacheFilePath( const char* pSourceFilePath, char* pBuffer, const U32 bufferSize );
+
+    /// Loads the cached bitmap for a source image if the source is unchanged.
+    /// This can be called on any thread.
+    /// @return The bitmap or NULL if there is no usable cache file.
+    static GBitmap* load( const char* pSourceFilePath, const char* pCacheFilePath );
+
+    /// Stores the bitmap decoded from a source image.
+    /// This can be called on any thread.
+    /// @return Whether the bitmap was stored or not.  Bitmaps with palettes or compressed formats are not cached.
+    static bool store( const char* pSourceFilePath, const char* pCacheFilePath, const GBitmap* pBitmap );
+
+private:
+    static char smCachePath[1024];
+    static Mutex* smpCreatePathMutex;
+};
+
+#endif // _TEXTURE_CACHE_H_
@@ -27,12 +27,18 @@
 #include "platform/platform.h"
 #include "collection/vector.h"
 #include "io/resource/resourceManager.h"
+#include "io/fileStream.h"
 #include "graphics/gBitmap.h"
+#include "graphics/TextureCache.h"
 #include "console/console.h"
 #include "console/consoleInternal.h"
 #include "console/consoleTypes.h"
 #include "memory/safeDelete.h"
+#include "memory/memoryAllocator.h"
 #include "math/mMath.h"
+#include "debug/frameCounters.h"
+#include "collection/flatHashMap.h"
+#include "platform/threads/threadPool.h"
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -47,6 +53,25 @@ S32 TextureManager::mBitmapResidentSize = 0;
 S32 TextureManager::mTextureResidentSize = 0;
 S32 TextureManager::mTextureResidentWasteSize = 0;
 S32 TextureManager::mTextureResidentCount = 0;
+S32 TextureManager::mTextureUploadBudget = 4 * 1024 * 1024;
+U32 TextureManager::mFrameUploadSize = 0;
+
+extern bool sgForcePalletedPNGsTo16Bit;
+extern bool sgForcePalletedBMPsTo16Bit;
+
+//---------------------------------------------------------------------------------------------------------------------
+
+static F32 sampleTextureResidentCount( void ) { return (F32)TextureManager::getTextureResidentCount(); }
+static F32 sampleTextureResidentKB( void ) { return TextureManager::getTextureResidentSize() / 1024.0f; }
+static F32 sampleBitmapResidentKB( void ) { return TextureManager::getBitmapResidentSize() / 1024.0f; }
+static F32 sampleTextureUploadKB( void ) { return TextureManager::getFrameUploadSize() / 1024.0f; }
+static F32 sampleTextureUploadsPending( void ) { return (F32)TextureManager::getPendingUploadCount(); }
+
+static FrameCounter sTextureResidentCounter( "textures.resident", sampleTextureResidentCount );
+static FrameCounter sTextureResidentKBCounter( "textures.residentKB", sampleTextureResidentKB );
+static FrameCounter sBitmapResidentKBCounter( "textures.bitmapKB", sampleBitmapResidentKB );
+static FrameCounter sTextureUploadKBCounter( "textures.uploadKB", sampleTextureUploadKB );
+static FrameCounter sTextureUploadsPendingCounter( "textures.uploadsPending", sampleTextureUploadsPending );
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -112,6 +137,224 @@ static U32                        sgCurrCallbackKey = 0;
 
 static Vector<EventCallbackEntry> sgEventCallbacks(__FILE__, __LINE__);
 
+/// The bitmap file each texture key was last found as, keyed by the full path of the texture key.
+static FlatHashMap<StringTableEntry, StringTableEntry> sgResolvedBitmapFiles;
+
+/// A texture requested from a bitmap file being loaded on the thread pool.
+struct TextureLoadRequest
+{
+    StringTableEntry                        mTextureKey;
+    bool                                    mClamp;
+    bool                                    mForce16Bit;
+    TextureManager::TextureLoadCallback     mCallback;
+    void*                                   mUserData;
+};
+
+/// A callback waiting on the upload of a texture requested more than once while it was loading.
+struct TextureLoadWaiter
+{
+    TextureManager::TextureLoadCallback     mCallback;
+    void*                                   mUserData;
+    TextureLoadWaiter*                      mpNext;
+};
+
+/// A texture loaded on the thread pool waiting to be uploaded.
+struct TextureUpload
+{
+    StringTableEntry                        mTextureKey;
+    GBitmap*                                mpBitmap;
+    U32                                     mBitmapWidth;
+    U32                                     mBitmapHeight;
+    bool                                    mClamp;
+    bool                                    mForce16Bit;
+    TextureManager::TextureLoadCallback     mCallback;
+    void*                                   mUserData;
+    TextureLoadWaiter*                      mpWaiters;
+};
+
+static Vector<TextureUpload> sgTextureUploads(__FILE__, __LINE__);
+
+class TextureLoadWorkItem;
+
+/// The loads running on the thread pool, keyed by the full path of their bitmap file.
+/// Only used on the main thread.
+static FlatHashMap<StringTableEntry, TextureLoadWorkItem*> sgTextureLoadsInFlight;
+
+//--------------------------------------------------------------------------------------------------------------------
+
+static void addTextureLoadWaiter( TextureUpload& upload, TextureManager::TextureLoadCallback callback, void* userData )
+{
+    if ( callback == NULL )
+        return;
+
+    TextureLoadWaiter* pWaiter = new TextureLoadWaiter;
+    pWaiter->mCallback = callback;
+    pWaiter->mUserData = userData;
+    pWaiter->mpNext = NULL;
+
+    // Waiters are called in the order they were requested.
+    TextureLoadWaiter** ppTail = &upload.mpWaiters;
+    while ( *ppTail != NULL )
+        ppTail = &(*ppTail)->mpNext;
+
+    *ppTail = pWaiter;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+static void notifyTextureLoad( TextureUpload& upload, const bool loaded )
+{
+    if ( upload.mCallback != NULL )
+        upload.mCallback( upload.mTextureKey, loaded, upload.mUserData );
+
+    while ( upload.mpWaiters != NULL )
+    {
+        TextureLoadWaiter* pWaiter = upload.mpWaiters;
+        upload.mpWaiters = pWaiter->mpNext;
+
+        pWaiter->mCallback( upload.mTextureKey, loaded, pWaiter->mUserData );
+        delete pWaiter;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+class TextureLoadWorkItem : public ThreadPool::WorkItem
+{
+public:
+    TextureLoadWorkItem( StringTableEntry filePath, RESOURCE_CREATE_FN createFn ) :
+        mFilePath( filePath ),
+        mCreateFn( createFn ),
+        mpBitmap( NULL ),
+        mpUploadBitmap( NULL ),
+        mCached( false )
+    {
+        if ( TextureCache::smEnabled )
+            TextureCache::getCacheFilePath( mFilePath, mCacheFilePath, sizeof(mCacheFilePath) );
+        else
+            mCacheFilePath[0] = 0;
+    }
+
+    virtual ~TextureLoadWorkItem()
+    {
+        // Stop further requests waiting on a load that never completed.
+        TextureLoadWorkItem** ppInFlight = sgTextureLoadsInFlight.find( mFilePath );
+        if ( ppInFlight != NULL && *ppInFlight == this )
+            sgTextureLoadsInFlight.erase( mFilePath );
+
+        if ( mpUploadBitmap != mpBitmap )
+            delete mpUploadBitmap;
+
+        delete mpBitmap;
+    }
+
+    /// Adds a texture to create from the bitmap once it has loaded.
+    void addRequest( StringTableEntry textureKey, const bool clampToEdge, const bool force16Bit, TextureManager::TextureLoadCallback callback, void* userData )
+    {
+        mRequests.increment();
+        TextureLoadRequest& request = mRequests.last();
+        request.mTextureKey = textureKey;
+        request.mClamp = clampToEdge;
+        request.mForce16Bit = force16Bit;
+        request.mCallback = callback;
+        request.mUserData = userData;
+    }
+
+    virtual void execute( void )
+    {
+        MemoryTagScope memoryTagScope( MemoryAllocator::TexturesTag );
+
+        // Use the cached bitmap if the file has not changed.
+        if ( mCacheFilePath[0] != 0 )
+        {
+            mpBitmap = TextureCache::load( mFilePath, mCacheFilePath );
+            mCached = mpBitmap != NULL;
+        }
+
+        if ( mpBitmap == NULL )
+        {
+            FileStream stream;
+            if ( !stream.open( mFilePath, FileStream::Read ) )
+                return;
+
+            mpBitmap = static_cast<GBitmap*>( mCreateFn( stream ) );
+            stream.close();
+        }
+
+        if ( mpBitmap == NULL || mpBitmap->getWidth() > MaximumProductSupportedTextureWidth || mpBitmap->getHeight() > MaximumProductSupportedTextureHeight )
+            return;
+
+        // Store the decoded bitmap here so the disk write stays off the main thread.
+        if ( !mCached && mCacheFilePath[0] != 0 )
+            TextureCache::store( mFilePath, mCacheFilePath, mpBitmap );
+
+        // Pad the bitmap here so that the upload does not have to.
+        // Paletted bitmaps cannot be uploaded so are left for the upload to reject.
+        mpUploadBitmap = mpBitmap->getFormat() == GBitmap::Palettized ? mpBitmap : TextureManager::createPowerOfTwoBitmap( mpBitmap );
+    }
+
+    virtual void onCompleted( void )
+    {
+        // Requests from now on start a new load.
+        sgTextureLoadsInFlight.erase( mFilePath );
+
+        if ( mpBitmap != NULL && mpUploadBitmap == NULL )
+            Con::warnf( "TextureManager::loadTextureAsync() - Cannot load bitmap '%s' as its dimensions exceed the maximum product-supported texture dimension.", mFilePath );
+
+        // Finish if there is nothing to upload.
+        if ( mpUploadBitmap == NULL || TextureManager::getManagerState() == TextureManager::NotInitialized )
+        {
+            for ( S32 i = 0; i < mRequests.size(); i++ )
+            {
+                if ( mRequests[i].mCallback != NULL )
+                    mRequests[i].mCallback( mRequests[i].mTextureKey, false, mRequests[i].mUserData );
+            }
+            return;
+        }
+
+        const U32 bitmapWidth = mpBitmap->getWidth();
+        const U32 bitmapHeight = mpBitmap->getHeight();
+
+        // Only the padded bitmap is needed for the upload.
+        if ( mpUploadBitmap != mpBitmap )
+            delete mpBitmap;
+
+        mpBitmap = NULL;
+
+        // Queue one upload per texture.  Further requests for a texture wait on its upload
+        // and any other texture made from the same file is given a copy of the bitmap.
+        const S32 firstUpload = sgTextureUploads.size();
+        for ( S32 i = 0; i < mRequests.size(); i++ )
+        {
+            const TextureLoadRequest& request = mRequests[i];
+
+            S32 uploadIndex = firstUpload;
+            while ( uploadIndex < sgTextureUploads.size() && ( sgTextureUploads[uploadIndex].mTextureKey != request.mTextureKey || sgTextureUploads[uploadIndex].mClamp != request.mClamp ) )
+                uploadIndex++;
+
+            if ( uploadIndex < sgTextureUploads.size() )
+            {
+                addTextureLoadWaiter( sgTextureUploads[uploadIndex], request.mCallback, request.mUserData );
+                continue;
+            }
+
+            GBitmap* pUploadBitmap = mpUploadBitmap != NULL ? mpUploadBitmap : new GBitmap( *sgTextureUploads[firstUpload].mpBitmap );
+            mpUploadBitmap = NULL;
+
+            TextureManager::queueUpload( request.mTextureKey, pUploadBitmap, bitmapWidth, bitmapHeight, request.mClamp, request.mForce16Bit, request.mCallback, request.mUserData );
+        }
+    }
+
+private:
+    StringTableEntry                        mFilePath;
+    char                                    mCacheFilePath[1024];
+    RESOURCE_CREATE_FN                      mCreateFn;
+    Vector<TextureLoadRequest>              mRequests;
+    GBitmap*                                mpBitmap;
+    GBitmap*                                mpUploadBitmap;
+    bool                                    mCached;
+};
+
 //--------------------------------------------------------------------------------------------------------------------
 
 U32 TextureManager::registerEventCallback(TextureEventCallback callback, void *userData)
@@ -155,10 +398,17 @@ void TextureManager::create()
     AssertISV(mManagerState == NotInitialized, "TextureManager::create() - already created!");
 
     TextureDictionary::create();
+    TextureCache::create();
 
     Con::addVariable("$pref::OpenGL::force16BitTexture", TypeBool, &TextureManager::mForce16BitTexture);
     Con::addVariable("$pref::OpenGL::allowTextureCompression", TypeBool, &TextureManager::mAllowTextureCompression);
     Con::addVariable("$pref::OpenGL::disableTextureSubImageUpdates", TypeBool, &TextureManager::mDisableTextureSubImageUpdates);
+    Con::addVariable("$pref::OpenGL::useTextureCache", TypeBool, &TextureCache::smEnabled);
+    Con::addVariable("$pref::OpenGL::textureUploadBudget", TypeS32, &TextureManager::mTextureUploadBudget);
+
+    // The bitmap readers check these while decoding so they must not need the console.
+    Con::addVariable("$pref::iPhone::ForcePalletedPNGsTo16Bit", TypeBool, &sgForcePalletedPNGsTo16Bit);
+    Con::addVariable("$pref::iPhone::ForcePalletedBMPsTo16Bit", TypeBool, &sgForcePalletedBMPsTo16Bit);
 
     // Flag as alive.
     mManagerState = Alive;
@@ -170,8 +420,29 @@ void TextureManager::destroy()
 {
     AssertISV(mManagerState != NotInitialized, "TextureManager::destroy - nothing to destroy!");
 
+    // Finish loads still running on the thread pool so none of them uses the cache afterwards.
+    if ( ThreadPool::getGlobal() != NULL )
+        ThreadPool::getGlobal()->flush();
+
     // Destroy the texture dictionary.
     TextureDictionary::destroy();
+    TextureCache::destroy();
+
+    // Delete any textures that were loaded but never uploaded.
+    for ( S32 i = 0; i < sgTextureUploads.size(); i++ )
+    {
+        delete sgTextureUploads[i].mpBitmap;
+
+        while ( sgTextureUploads[i].mpWaiters != NULL )
+        {
+            TextureLoadWaiter* pWaiter = sgTextureUploads[i].mpWaiters;
+            sgTextureUploads[i].mpWaiters = pWaiter->mpNext;
+            delete pWaiter;
+        }
+    }
+
+    sgTextureUploads.clear();
+    sgResolvedBitmapFiles.reset();
 
     // Reset state.
     mBitmapResidentSize = 0;
@@ -179,6 +450,7 @@ void TextureManager::destroy()
     mTextureResidentWasteSize = 0;
     mTextureResidentCount = 0;
     mMasterTextureKeyIndex = 0;
+    mFrameUploadSize = 0;
 
     // Flag as not initialized.
     mManagerState = NotInitialized;
@@ -292,6 +564,9 @@ void TextureManager::resurrectManager( void )
 
 void TextureManager::flush()
 {
+    // Find the bitmap files again in case any have been added or removed.
+    sgResolvedBitmapFiles.clear();
+
     killManager();
     resurrectManager();
 }
@@ -705,6 +980,11 @@ void TextureManager::refresh( const char *textureName )
     if ( pTextureObject->getHandleType() == TextureHandle::BitmapKeepTexture )
         return;
 
+    // Find the bitmap file again in case it has been replaced.
+    char fileNameBuffer[512];
+    Platform::makeFullPathName( pTextureObject->mTextureKey, fileNameBuffer, sizeof(fileNameBuffer) );
+    sgResolvedBitmapFiles.erase( StringTable->insert( fileNameBuffer ) );
+
     // Load the bitmap.
     GBitmap* pBitmap = loadBitmap( pTextureObject->mTextureKey );
 
@@ -752,7 +1032,7 @@ void TextureManager::createGLName( TextureObject* pTextureObject )
 
 //--------------------------------------------------------------------------------------------------------------------
 
-TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge)
+TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge, const U32 bitmapWidth, const U32 bitmapHeight)
 {
     // Sanity!
     AssertISV( type != TextureHandle::InvalidTexture, "Invalid texture type." );
@@ -811,9 +1091,10 @@ TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap*
         mBitmapResidentSize += pTextureObject->mBitmapResidentSize;
     }
 
+    // A bitmap already padded to a power-of-two is given with the dimensions of the image it holds.
     pTextureObject->mpBitmap           = pNewBitmap;
-    pTextureObject->mBitmapWidth       = pNewBitmap->getWidth();
-    pTextureObject->mBitmapHeight      = pNewBitmap->getHeight();
+    pTextureObject->mBitmapWidth       = bitmapWidth != 0 ? bitmapWidth : pNewBitmap->getWidth();
+    pTextureObject->mBitmapHeight      = bitmapHeight != 0 ? bitmapHeight : pNewBitmap->getHeight();
     pTextureObject->mTextureWidth      = getNextPow2(pNewBitmap->getWidth());
     pTextureObject->mTextureHeight     = getNextPow2(pNewBitmap->getHeight());
     pTextureObject->mClamp             = clampToEdge;
@@ -845,6 +1126,9 @@ TextureObject *TextureManager::loadTexture(const char* pTextureKey, TextureHandl
     if( pTextureKey == NULL || *pTextureKey == 0)
         return NULL;
 
+    // Account allocations made while loading to the textures.
+    MemoryTagScope memoryTagScope( MemoryAllocator::TexturesTag );
+
     // Fetch texture key.
     StringTableEntry textureKey = StringTable->insert(pTextureKey);
 
@@ -873,30 +1157,74 @@ TextureObject *TextureManager::loadTexture(const char* pTextureKey, TextureHandl
     if(checkOnly)
         return NULL;
 
-    // Ok, no success so let's try actually loading a texture.
-    bmp = loadBitmap(textureKey);
+    // The bitmap was not found with any of the supported extensions.  Probing
+    // them again would not find it either.
+    Con::warnf("Could not locate texture: %s", textureKey);
+    return NULL;
+}
 
-    if(!bmp)
+//--------------------------------------------------------------------------------------------------------------------
+
+GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool nocompression )
+{
+    ResourceObject* pResourceObject = findBitmapResource( pTextureKey, nocompression );
+    if ( pResourceObject == NULL )
+        return NULL;
+
+    GBitmap *bmp = NULL;
+
+    // Loose files can be loaded from the texture cache rather than decoded.
+    char filePathBuffer[1024];
+    char cacheFilePathBuffer[1024];
+    const bool useCache = TextureCache::smEnabled && (pResourceObject->flags & ResourceObject::File) != 0;
+    if ( useCache )
     {
-        Con::warnf("Could not locate texture: %s", textureKey);
+        Platform::makeFullPathName( pResourceObject->name, filePathBuffer, sizeof(filePathBuffer), pResourceObject->path );
+        TextureCache::getCacheFilePath( filePathBuffer, cacheFilePathBuffer, sizeof(cacheFilePathBuffer) );
+        bmp = TextureCache::load( filePathBuffer, cacheFilePathBuffer );
+        if ( bmp != NULL )
+            return bmp;
+    }
+
+    bmp = (GBitmap*)ResourceManager->loadInstance(pResourceObject);
+
+    if ( bmp != NULL && (bmp->getWidth() > MaximumProductSupportedTextureWidth || bmp->getHeight() > MaximumProductSupportedTextureHeight) )
+    {
+        Con::warnf( "TextureManager::loadBitmap() - Cannot load bitmap '%s/%s' as its dimensions exceed the maximum product-supported texture dimension.", pResourceObject->path, pResourceObject->name );
+        delete bmp;
         return NULL;
     }
-    bmp->mForce16Bit = force16Bit;
 
-    return registerTexture(textureKey, bmp, type, clampToEdge);
+    if ( bmp != NULL && useCache )
+        TextureCache::store( filePathBuffer, cacheFilePathBuffer, bmp );
+
+    return bmp;
 }
 
 //--------------------------------------------------------------------------------------------------------------------
 
-GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool nocompression )
+ResourceObject* TextureManager::findBitmapResource( const char* pTextureKey, const bool nocompression )
 {
     char fileNameBuffer[512];
-    Platform::makeFullPathName( pTextureKey, fileNameBuffer, 512 );
-    GBitmap *bmp = NULL;
+    Platform::makeFullPathName( pTextureKey, fileNameBuffer, sizeof(fileNameBuffer) );
+
+    // Use the file the texture key was found as last time if it is still there.
+    // Without compression the file may differ so the extensions are always probed.
+    StringTableEntry fullPath = StringTable->insert( fileNameBuffer );
+    StringTableEntry* pResolvedFile = nocompression ? NULL : sgResolvedBitmapFiles.find( fullPath );
+    if ( pResolvedFile != NULL )
+    {
+        ResourceObject* pResourceObject = ResourceManager->find( *pResolvedFile );
+        if ( pResourceObject != NULL )
+            return pResourceObject;
+
+        sgResolvedBitmapFiles.erase( fullPath );
+    }
 
     // Loop through the supported extensions to find the file.
+    ResourceObject* pResourceObject = NULL;
     U32 len = dStrlen(fileNameBuffer);
-    for (U32 i = 0; i < EXT_ARRAY_SIZE && bmp == NULL; i++)
+    for (U32 i = 0; i < EXT_ARRAY_SIZE && pResourceObject == NULL; i++)
     {
 #if defined(TORQUE_OS_IOS)
         // check to see if requested no-compression...
@@ -906,17 +1234,184 @@ GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool
 #endif
         dStrcpy(fileNameBuffer + len, extArray[i]);
 
-        bmp = (GBitmap*)ResourceManager->loadInstance(fileNameBuffer);
+        pResourceObject = ResourceManager->find(fileNameBuffer);
+
+        // Skip files that are not bitmaps.
+        if ( pResourceObject != NULL && ResourceManager->getCreateFunction( pResourceObject->name ) == NULL )
+            pResourceObject = NULL;
+    }
+
+    if ( pResourceObject != NULL && !nocompression )
+        sgResolvedBitmapFiles.insert( fullPath, StringTable->insert( fileNameBuffer ) );
+
+    return pResourceObject;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+bool TextureManager::loadTextureAsync( const char* pTextureKey, const bool clampToEdge, const bool force16Bit, TextureLoadCallback callback, void* userData )
+{
+    // Finish if texture key is invalid.
+    if( pTextureKey == NULL || *pTextureKey == 0 || ThreadPool::getGlobal() == NULL )
+        return false;
+
+    StringTableEntry textureKey = StringTable->insert(pTextureKey);
+
+    // Finish if the texture is already loaded.
+    if ( TextureDictionary::find( textureKey, TextureHandle::BitmapTexture, clampToEdge ) != NULL )
+        return false;
+
+    // Resolve the file on the main thread so that the resolved file is remembered.
+    ResourceObject* pResourceObject = findBitmapResource( textureKey, false );
+
+    // Only loose files are read on the thread pool.
+    if ( pResourceObject == NULL || (pResourceObject->flags & ResourceObject::File) == 0 )
+        return false;
+
+    RESOURCE_CREATE_FN createFn = ResourceManager->getCreateFunction( pResourceObject->name );
+    if ( createFn == NULL )
+        return false;
+
+    char filePathBuffer[1024];
+    Platform::makeFullPathName( pResourceObject->name, filePathBuffer, sizeof(filePathBuffer), pResourceObject->path );
+    StringTableEntry filePath = StringTable->insert( filePathBuffer );
+
+    // Wait on a load of the same file that is already running so that the file is only
+    // read, decoded and stored in the texture cache by one worker at a time.
+    TextureLoadWorkItem** ppInFlight = sgTextureLoadsInFlight.find( filePath );
+    if ( ppInFlight != NULL )
+    {
+        (*ppInFlight)->addRequest( textureKey, clampToEdge, force16Bit, callback, userData );
+        return true;
+    }
+
+    TextureLoadWorkItem* pWorkItem = new TextureLoadWorkItem( filePath, createFn );
+    pWorkItem->addRequest( textureKey, clampToEdge, force16Bit, callback, userData );
+    sgTextureLoadsInFlight.insert( filePath, pWorkItem );
+
+    ThreadPool::getGlobal()->queueWorkItem( pWorkItem );
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::queueUpload( const char* pTextureKey, GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight, const bool clampToEdge, const bool force16Bit, TextureLoadCallback callback, void* userData )
+{
+    AssertFatal( pBitmap != NULL, "TextureManager::queueUpload() - Cannot queue a NULL bitmap." );
+
+    sgTextureUploads.increment();
+    TextureUpload& upload = sgTextureUploads.last();
+    upload.mTextureKey = StringTable->insert( pTextureKey );
+    upload.mpBitmap = pBitmap;
+    upload.mBitmapWidth = bitmapWidth;
+    upload.mBitmapHeight = bitmapHeight;
+    upload.mClamp = clampToEdge;
+    upload.mForce16Bit = force16Bit;
+    upload.mCallback = callback;
+    upload.mUserData = userData;
+    upload.mpWaiters = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::uploadTexture( TextureUpload& upload )
+{
+    // Another load may have created the texture while this one was queued.
+    TextureObject* pTextureObject = TextureDictionary::find( upload.mTextureKey, TextureHandle::BitmapTexture, upload.mClamp );
+
+    if ( pTextureObject == NULL )
+    {
+        upload.mpBitmap->mForce16Bit = upload.mForce16Bit;
+        pTextureObject = registerTexture( upload.mTextureKey, upload.mpBitmap, TextureHandle::BitmapTexture, upload.mClamp, upload.mBitmapWidth, upload.mBitmapHeight );
+    }
+    else
+    {
+        delete upload.mpBitmap;
+    }
+
+    upload.mpBitmap = NULL;
+
+    // Hold the texture while the callbacks run.  It is freed afterwards unless a callback referenced it.
+    TextureHandle textureHandle( pTextureObject );
+
+    notifyTextureLoad( upload, pTextureObject != NULL );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::processUploads( void )
+{
+    mFrameUploadSize = 0;
+
+    // Textures cannot be uploaded while the manager is dead.
+    if ( sgTextureUploads.size() == 0 || mManagerState != Alive )
+        return;
+
+    // Account allocations made while uploading to the textures.
+    MemoryTagScope memoryTagScope( MemoryAllocator::TexturesTag );
 
-        if ( bmp != NULL && (bmp->getWidth() > MaximumProductSupportedTextureWidth || bmp->getHeight() > MaximumProductSupportedTextureHeight) )
+    const U32 uploadBudget = (U32)getMax( mTextureUploadBudget, 0 );
+
+    U32 uploadCount = 0;
+    while ( uploadCount < (U32)sgTextureUploads.size() )
+    {
+        const U32 uploadSize = sgTextureUploads[uploadCount].mpBitmap->byteSize;
+
+        // Stop once the next upload would exceed the budget.
+        if ( uploadCount > 0 && mFrameUploadSize + uploadSize > uploadBudget )
+            break;
+
+        mFrameUploadSize += uploadSize;
+        uploadCount++;
+    }
+
+    // Dequeue the uploads first as the callbacks can load more textures.
+    Vector<TextureUpload> uploads;
+    uploads.increment( sgTextureUploads.address(), uploadCount );
+    sgTextureUploads.erase( 0, uploadCount );
+
+    for ( U32 i = 0; i < uploadCount; i++ )
+        uploadTexture( uploads[i] );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+U32 TextureManager::flushUploads( void )
+{
+    // Account allocations made while uploading to the textures.
+    MemoryTagScope memoryTagScope( MemoryAllocator::TexturesTag );
+
+    U32 uploadCount = 0;
+    while ( sgTextureUploads.size() > 0 )
+    {
+        // Dequeue the uploads first as the callbacks can load more textures.
+        Vector<TextureUpload> uploads;
+        uploads.swap( sgTextureUploads );
+        uploadCount += uploads.size();
+
+        for ( S32 i = 0; i < uploads.size(); i++ )
         {
-            Con::warnf( "TextureManager::loadBitmap() - Cannot load bitmap '%s' as its dimensions exceed the maximum product-supported texture dimension.", fileNameBuffer );
-            delete bmp;
-            return NULL;
+            if ( mManagerState == Alive )
+            {
+                uploadTexture( uploads[i] );
+                continue;
+            }
+
+            // The texture cannot be uploaded now so the caller has to load it when it is needed.
+            delete uploads[i].mpBitmap;
+            notifyTextureLoad( uploads[i], false );
         }
     }
 
-    return bmp;
+    return uploadCount;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+U32 TextureManager::getPendingUploadCount( void )
+{
+    return sgTextureUploads.size();
 }
 
 //--------------------------------------------------------------------------------------------------------------------
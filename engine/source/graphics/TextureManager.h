@@ -45,10 +45,13 @@
 #define MaximumProductSupportedTextureWidth 2048
 #define MaximumProductSupportedTextureHeight MaximumProductSupportedTextureWidth
 
+struct TextureUpload;
+
 class TextureManager
 {
    friend class TextureHandle;
    friend class TextureDictionary;
+   friend class TextureLoadWorkItem;
 
 public:
     /// Texture manager event codes.
@@ -60,6 +63,7 @@ public:
     };
 
     typedef void (*TextureEventCallback)(const TextureEventCode eventCode, void *userData);
+    typedef void (*TextureLoadCallback)(StringTableEntry textureKey, const bool loaded, void *userData);
 
     /// Textrue manager state.
     enum ManagerState
@@ -80,6 +84,8 @@ private:
     static bool mForce16BitTexture;
     static bool mAllowTextureCompression;
     static bool mDisableTextureSubImageUpdates;
+    static S32 mTextureUploadBudget;
+    static U32 mFrameUploadSize;
 
 public:
     static bool mDGLRender;
@@ -98,6 +104,7 @@ public:
     static S32 getTextureResidentSize( void ) { return mTextureResidentSize; }
     static S32 getTextureResidentWasteSize( void ) { return mTextureResidentWasteSize; }
     static S32 getTextureResidentCount( void ) { return mTextureResidentCount; }
+    static U32 getFrameUploadSize( void ) { return mFrameUploadSize; }
 
     static U32  registerEventCallback(TextureEventCallback, void *userData);
     static void unregisterEventCallback(const U32 callbackKey);
@@ -106,16 +113,38 @@ public:
 
     static void dumpMetrics( void );
 
+    /// Loads a bitmap texture in the background.  The bitmap is read, decoded and padded
+    /// to a power-of-two on the thread pool then queued for upload on the main thread.
+    /// The callback is called once the texture has been uploaded and must reference the
+    /// texture, typically by loading it with the same key and clamping, for it to be kept.
+    /// @return Whether the load was queued.  Bitmaps held in zip archives are not loaded asynchronously.
+    static bool loadTextureAsync( const char* pTextureKey, const bool clampToEdge, const bool force16Bit, TextureLoadCallback callback, void* userData );
+
+    /// Queues a bitmap already padded to a power-of-two for upload on the main thread.  The queue owns
+    /// the bitmap.  The bitmap dimensions are those before padding.  The callback is called as for loadTextureAsync().
+    static void queueUpload( const char* pTextureKey, GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight, const bool clampToEdge, const bool force16Bit, TextureLoadCallback callback, void* userData );
+
+    /// Uploads queued textures until the per-frame upload budget is used.  At least one
+    /// texture is always uploaded so that the queue drains even with a zero budget.
+    static void processUploads( void );
+
+    /// Uploads all queued textures regardless of the budget.
+    /// @return The number of textures that were dequeued.
+    static U32 flushUploads( void );
+    static U32 getPendingUploadCount( void );
+
 private:
     static void postTextureEvent(const TextureEventCode eventCode);
 
     static void createGLName( TextureObject* pTextureObject );
-    static TextureObject* registerTexture(const char *textureName, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge);
+    static TextureObject* registerTexture(const char *textureName, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge, const U32 bitmapWidth = 0, const U32 bitmapHeight = 0);
     static TextureObject* loadTexture(const char *textureName, TextureHandle::TextureHandleType type, bool clampToEdge, bool checkOnly = false, bool force16Bit = false );
     static void freeTexture( TextureObject* pTextureObject );
     static void refresh(TextureObject* pTextureObject);
+    static void uploadTexture( TextureUpload& upload );
 
     static GBitmap* loadBitmap(const char *textureName, bool recurse = true, bool nocompression = false);
+    static ResourceObject* findBitmapResource( const char* pTextureKey, const bool nocompression );
     static GBitmap* createPowerOfTwoBitmap( GBitmap* pBitmap );
     static U16* create16BitBitmap( GBitmap *pDL, U8 *in_source8, GBitmap::BitmapFormat alpha_info, GLint *GLformat, GLint *GLdata_type, U32 width, U32 height );
     static void getSourceDestByteFormat(GBitmap *pBitmap, U32 *sourceFormat, U32 *destFormat, U32 *byteFormat, U32* texelSize);
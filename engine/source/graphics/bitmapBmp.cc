@@ -25,8 +25,9 @@
 #include "io/stream.h"
 #include "platform/platform.h"
 
-//-Mat used when checking for palleted textures
-#include "console/console.h"
+//-Mat used when checking for palleted textures.  Bound to
+//     $pref::iPhone::ForcePalletedBMPsTo16Bit by the texture manager so it
+//     can be read while decoding on a worker thread.
 //Luma: Moved this here from bm8
 bool sgForcePalletedBMPsTo16Bit = false;
 
@@ -138,7 +139,6 @@ bool GBitmap::readMSBmp(Stream& stream)
    delete[] rowBuffer;
 
    //-Mat set the mForce16Bit to true for these, if the script variable is set
-   sgForcePalletedBMPsTo16Bit = Con::getVariable("$pref::iPhone::ForcePalletedBMPsTo16Bit");
    if( bi.biBitCount == 8 && sgForcePalletedBMPsTo16Bit ) {
        mForce16Bit = true;
    }
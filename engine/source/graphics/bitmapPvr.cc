@@ -24,6 +24,7 @@
 #include "graphics/gPalette.h"
 #include "io/stream.h"
 #include "platform/platform.h"
+#include "memory/memoryAllocator.h"
 
 // PVR definitions stolen from CPVRTextureHeader.h, which is distributed as part of the PowerVR SDK.
 // ---------------------------------------------------------------------------------------------
@@ -274,7 +275,7 @@ bool GBitmap::readPvr(Stream& stream)
 	stream.read( sizeof(PVRTextureHeaderV2), &bi );
 
 	byteSize = bi.dwDataSize;
-	pBits = new U8[byteSize];
+	pBits = (U8*)MemoryAllocator::allocate(byteSize, MemoryAllocator::TexturesTag);
 	stream.read( byteSize, pBits );
 	
 	width = bi.dwHeight;
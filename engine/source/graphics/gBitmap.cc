@@ -27,6 +27,7 @@
 #include "io/resource/resourceManager.h"
 #include "platform/platform.h"
 #include "memory/safeDelete.h"
+#include "memory/memoryAllocator.h"
 #include "math/mRect.h"
 #include "console/console.h"
 
@@ -73,7 +74,7 @@ GBitmap::GBitmap(const GBitmap& rCopy)
    mForce16Bit = rCopy.mForce16Bit;
 
    byteSize = rCopy.byteSize;
-   pBits    = new U8[byteSize];
+   pBits    = (U8*)MemoryAllocator::allocate(byteSize, MemoryAllocator::TexturesTag);
    dMemcpy(pBits, rCopy.pBits, byteSize);
 
    width        = rCopy.width;
@@ -110,7 +111,7 @@ GBitmap::~GBitmap()
 //--------------------------------------------------------------------------
 void GBitmap::deleteImage()
 {
-   delete [] pBits;
+   MemoryAllocator::free(pBits);
    pBits    = NULL;
    byteSize = 0;
 
@@ -220,13 +221,13 @@ void GBitmap::allocateBitmap(const U32 in_width, const U32 in_height, const bool
 
    // Set up the memory...
    byteSize = allocPixels;
-   pBits    = new U8[byteSize];
+   pBits    = (U8*)MemoryAllocator::allocate(byteSize, MemoryAllocator::TexturesTag);
     dMemset(pBits, 0xFF, byteSize);
     
    if(svBits != NULL)
    {
       dMemcpy(pBits, svBits, getMin(byteSize, svByteSize));
-      delete[] svBits;
+      MemoryAllocator::free(svBits);
    }
 }
 
@@ -831,7 +832,7 @@ bool GBitmap::read(Stream& io_rStream)
 
    io_rStream.read(&byteSize);
 
-   pBits = new U8[byteSize];
+   pBits = (U8*)MemoryAllocator::allocate(byteSize, MemoryAllocator::TexturesTag);
    io_rStream.read(byteSize, pBits);
 
    io_rStream.read(&width);
@@ -20,21 +20,65 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+
 #include "platform/platform.h"
+#include "platform/platformIntrinsics.h"
 #include "io/resource/resourceManager.h"
 #include "collection/findIterator.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
+template<class T> ResDictionary::SlotArray<T>* ResDictionary::allocSlotArray(const U32 size)
+{
+   AssertFatal(isPow2(size), "ResDictionary::allocSlotArray: Size must be a power of two.");
+
+   const U32 bytes = sizeof(SlotArray<T>) + (size - 1) * sizeof(T *);
+   SlotArray<T> *table = (SlotArray<T> *) dMalloc(bytes);
+   dMemset(table, 0, bytes);
+   table->mask = size - 1;
+   return table;
+}
+
+template<class T> void ResDictionary::freeSlotArrays(SlotArray<T>* table)
+{
+   while(table)
+   {
+      SlotArray<T> *retired = table->retired;
+      dFree(table);
+      table = retired;
+   }
+}
+
+template<class T> ResDictionary::SlotArray<T>* ResDictionary::growSlotArray(SlotArray<T>* table)
+{
+   SlotArray<T> *newTable = allocSlotArray<T>((table->mask + 1) * 2);
+   for(U32 i = 0; i <= table->mask; i++)
+   {
+      T *slot = table->slots[i];
+      if(!slot)
+         continue;
+
+      U32 index = slot->hash & newTable->mask;
+      while(newTable->slots[index] != NULL)
+         index = (index + 1) & newTable->mask;
+      newTable->slots[index] = slot;
+   }
+
+   // The old array stays readable until the dictionary is destroyed.
+   newTable->retired = table;
+   return newTable;
+}
+
+//----------------------------------------------------------------------------
+
 ResDictionary::ResDictionary()
 {
    entryCount = 0;
-   hashTableSize = 1023; //DefaultTableSize;
-   hashTable = new ResourceObject *[hashTableSize];
-   S32 i;
-   for(i = 0; i < hashTableSize; i++)
-      hashTable[i] = NULL;
+   pathCount = 0;
+   readerCount = 0;
+   hashTable = allocSlotArray<Entry>(DefaultTableSize);
+   pathTable = allocSlotArray<PathEntry>(DefaultTableSize);
 }
 
 ResDictionary::~ResDictionary()
@@ -42,132 +86,256 @@ ResDictionary::~ResDictionary()
    // we assume the resources are purged before we destroy
    // the dictionary
 
-   delete[] hashTable;
+   for(S32 i = 0; i < retiredObjects.size(); i++)
+      delete retiredObjects[i];
+
+   freeSlotArrays(hashTable);
+   freeSlotArrays(pathTable);
 }
 
-S32 ResDictionary::hash(StringTableEntry path, StringTableEntry file)
+U32 ResDictionary::hash(StringTableEntry path, StringTableEntry file)
 {
-   return ((S32)((((dsize_t)path) >> 2) + (((dsize_t)file) >> 2) )) % hashTableSize;
+   // Keys are string table entries so the pointers are hashed rather than
+   // the strings.  The low bits of the pointers are mostly alignment so the
+   // result is mixed before it is masked down to a table index.
+   U32 key = (U32)(((dsize_t)path) >> 2) * 0x9E3779B1 + (U32)(((dsize_t)file) >> 2);
+   key ^= key >> 16;
+   key *= 0x85EBCA6B;
+   key ^= key >> 13;
+   return key;
 }
 
-void ResDictionary::insert(ResourceObject *obj, StringTableEntry path, StringTableEntry file)
+//----------------------------------------------------------------------------
+
+StringTableEntry ResDictionary::resolvePath(StringTableEntry path)
 {
-   if(path)
+   if(!path)
+      return NULL;
+
+   // Relative paths depend on the current directory and are resolved
+   // every time.
+   char fullPath[1024];
+   if(!Platform::isFullPath(path))
    {
-      char fullPath[1024];
       Platform::makeFullPathName(path, fullPath, sizeof(fullPath));
-      path = StringTable->insert(fullPath);
+      return StringTable->insert(fullPath);
    }
 
-   obj->name = file;
-   obj->path = path;
+   // Full paths always resolve to the same name so it is cached.  Like the
+   // hash table, cache entries are never removed and can be probed without
+   // holding the lock.
+   const U32 pathHash = hash(path, NULL);
+   SlotArray<PathEntry> *table = dAtomicReadPtr(pathTable);
+   U32 index = pathHash & table->mask;
+   PathEntry *walk;
+   while((walk = dAtomicReadPtr(table->slots[index])) != NULL)
+   {
+      if(walk->path == path)
+         return walk->fullPath;
+      index = (index + 1) & table->mask;
+   }
 
-   S32 idx = hash(path, file);
-   obj->nextEntry = hashTable[idx];
-   hashTable[idx] = obj;
-   entryCount++;
-
-   if(entryCount > hashTableSize) {
-      ResourceObject *head = NULL, *temp, *walk;
-      for(idx = 0; idx < hashTableSize;idx++) {
-         walk = hashTable[idx];
-         while(walk)
-         {
-            temp = walk->nextEntry;
-            walk->nextEntry = head;
-            head = walk;
-            walk = temp;
-         }
-      }
-      delete[] hashTable;
-      hashTableSize = 2 * hashTableSize - 1;
-      hashTable = new ResourceObject *[hashTableSize];
-      for(idx = 0; idx < hashTableSize; idx++)
-         hashTable[idx] = NULL;
-      walk = head;
-      while(walk)
-      {
-         temp = walk->nextEntry;
-         idx = hash(walk);
-         walk->nextEntry = hashTable[idx];
-         hashTable[idx] = walk;
-         walk = temp;
-      }
+   Platform::makeFullPathName(path, fullPath, sizeof(fullPath));
+   StringTableEntry resolved = StringTable->insert(fullPath);
+
+   MutexHandle handle;
+   handle.lock(&mutex, true);
+
+   // Another thread may have cached the path since the unlocked probe.
+   table = pathTable;
+   index = pathHash & table->mask;
+   while((walk = table->slots[index]) != NULL)
+   {
+      if(walk->path == path)
+         return walk->fullPath;
+      index = (index + 1) & table->mask;
+   }
+
+   PathEntry *entry = (PathEntry *) memPool.alloc(sizeof(PathEntry));
+   entry->hash = pathHash;
+   entry->path = path;
+   entry->fullPath = resolved;
+
+   // Keep the load factor at or below one half.
+   if(++pathCount * 2 > table->mask + 1)
+   {
+      table->slots[index] = entry;
+      dAtomicWritePtr(pathTable, growSlotArray(table));
    }
+   else
+      dAtomicWritePtr(table->slots[index], entry);
+
+   return resolved;
 }
 
-ResourceObject* ResDictionary::find(StringTableEntry path, StringTableEntry name)
+ResDictionary::Entry* ResDictionary::findEntry(StringTableEntry path, StringTableEntry name, const U32 keyHash)
 {
-   if(path)
+   SlotArray<Entry> *table = dAtomicReadPtr(hashTable);
+   U32 index = keyHash & table->mask;
+   Entry *walk;
+   while((walk = dAtomicReadPtr(table->slots[index])) != NULL)
    {
-      char fullPath[1024];
-      Platform::makeFullPathName(path, fullPath, sizeof(fullPath));
-      path = StringTable->insert(fullPath);
+      if(walk->name == name && walk->path == path)
+         return walk;
+      index = (index + 1) & table->mask;
    }
+   return NULL;
+}
 
-   for(ResourceObject *walk = hashTable[hash(path, name)]; walk; walk = walk->nextEntry)
+ResDictionary::Entry* ResDictionary::insertEntry(StringTableEntry path, StringTableEntry name)
+{
+   const U32 keyHash = hash(path, name);
+
+   SlotArray<Entry> *table = hashTable;
+   U32 index = keyHash & table->mask;
+   Entry *walk;
+   while((walk = table->slots[index]) != NULL)
+   {
       if(walk->name == name && walk->path == path)
          return walk;
-   return NULL;
+      index = (index + 1) & table->mask;
+   }
+
+   Entry *entry = (Entry *) memPool.alloc(sizeof(Entry));
+   entry->hash = keyHash;
+   entry->path = path;
+   entry->name = name;
+   entry->head = NULL;
+
+   // Keep the load factor at or below one half.
+   if(++entryCount * 2 > table->mask + 1)
+   {
+      table->slots[index] = entry;
+      dAtomicWritePtr(hashTable, growSlotArray(table));
+   }
+   else
+      dAtomicWritePtr(table->slots[index], entry);
+
+   return entry;
 }
 
-ResourceObject* ResDictionary::find(StringTableEntry path, StringTableEntry name, StringTableEntry zipPath, StringTableEntry zipName)
+bool ResDictionary::unlinkObject(Entry *entry, ResourceObject *obj)
 {
-   if(path)
+   // The object keeps its nextEntry so that a lookup standing on it can
+   // carry on down the chain.
+   for(ResourceObject * volatile *walk = &entry->head; *walk; walk = &(*walk)->nextEntry)
    {
-      char fullPath[1024];
-      Platform::makeFullPathName(path, fullPath, sizeof(fullPath));
-      path = StringTable->insert(fullPath);
+      if(*walk == obj)
+      {
+         dAtomicWritePtr(*walk, (ResourceObject *) obj->nextEntry);
+         return true;
+      }
    }
+   return false;
+}
 
-   for(ResourceObject *walk = hashTable[hash(path, name)]; walk; walk = walk->nextEntry)
-      if(walk->name == name && walk->path == path && walk->zipName == zipName && walk->zipPath == zipPath)
-         return walk;
-   return NULL;
+//----------------------------------------------------------------------------
+
+void ResDictionary::insert(ResourceObject *obj, StringTableEntry path, StringTableEntry file)
+{
+   path = resolvePath(path);
+
+   MutexHandle handle;
+   handle.lock(&mutex, true);
+
+   obj->name = file;
+   obj->path = path;
+
+   Entry *entry = insertEntry(path, file);
+   obj->nextEntry = entry->head;
+   dAtomicWritePtr(entry->head, obj);
 }
 
-ResourceObject* ResDictionary::find(StringTableEntry path, StringTableEntry name, U32 flags)
+ResourceObject* ResDictionary::find(StringTableEntry path, StringTableEntry name)
+{
+   path = resolvePath(path);
+
+   dFetchAndAdd(readerCount, 1);
+   ResourceObject *walk = NULL;
+   Entry *entry = findEntry(path, name, hash(path, name));
+   if(entry)
+      walk = dAtomicReadPtr(entry->head);
+   dFetchAndAdd(readerCount, (U32)-1);
+   return walk;
+}
+
+ResourceObject* ResDictionary::find(StringTableEntry path, StringTableEntry name, StringTableEntry zipPath, StringTableEntry zipName)
 {
-   if(path)
+   path = resolvePath(path);
+
+   dFetchAndAdd(readerCount, 1);
+   ResourceObject *walk = NULL;
+   Entry *entry = findEntry(path, name, hash(path, name));
+   if(entry)
    {
-      char fullPath[1024];
-      Platform::makeFullPathName(path, fullPath, sizeof(fullPath));
-      path = StringTable->insert(fullPath);
+      for(walk = dAtomicReadPtr(entry->head); walk; walk = dAtomicReadPtr(walk->nextEntry))
+         if(walk->zipName == zipName && walk->zipPath == zipPath)
+            break;
    }
+   dFetchAndAdd(readerCount, (U32)-1);
+   return walk;
+}
 
-   for(ResourceObject *walk = hashTable[hash(path, name)]; walk; walk = walk->nextEntry)
-      if(walk->name == name && walk->path == path && U32(walk->flags) == flags)
-         return walk;
-   return NULL;
+ResourceObject* ResDictionary::find(StringTableEntry path, StringTableEntry name, U32 flags)
+{
+   path = resolvePath(path);
+
+   dFetchAndAdd(readerCount, 1);
+   ResourceObject *walk = NULL;
+   Entry *entry = findEntry(path, name, hash(path, name));
+   if(entry)
+   {
+      for(walk = dAtomicReadPtr(entry->head); walk; walk = dAtomicReadPtr(walk->nextEntry))
+         if(U32(walk->flags) == flags)
+            break;
+   }
+   dFetchAndAdd(readerCount, (U32)-1);
+   return walk;
 }
 
 void ResDictionary::pushBehind(ResourceObject *resObj, S32 flagMask)
 {
-   remove(resObj);
-   entryCount++;
-   ResourceObject **walk = &hashTable[hash(resObj)];
+   MutexHandle handle;
+   handle.lock(&mutex, true);
+
+   Entry *entry = insertEntry(resObj->path, resObj->name);
+   unlinkObject(entry, resObj);
+
+   ResourceObject * volatile *walk = &entry->head;
    for(; *walk; walk = &(*walk)->nextEntry)
    {
       if(!((*walk)->flags & flagMask))
-      {
-         resObj->nextEntry = *walk;
-         *walk = resObj;
-         return;
-      }
+         break;
    }
-   resObj->nextEntry = NULL;
-   *walk = resObj;
+   dAtomicWritePtr(resObj->nextEntry, (ResourceObject *) *walk);
+   dAtomicWritePtr(*walk, resObj);
 }
 
 void ResDictionary::remove(ResourceObject *resObj)
 {
-   for(ResourceObject **walk = &hashTable[hash(resObj)]; *walk; walk = &(*walk)->nextEntry)
-   {
-      if(*walk == resObj)
-      {
-         entryCount--;
-         *walk = resObj->nextEntry;
-         return;
-      }
-   }
+   MutexHandle handle;
+   handle.lock(&mutex, true);
+
+   Entry *entry = findEntry(resObj->path, resObj->name, hash(resObj->path, resObj->name));
+   if(entry)
+      unlinkObject(entry, resObj);
+}
+
+void ResDictionary::retire(ResourceObject *resObj)
+{
+   MutexHandle handle;
+   handle.lock(&mutex, true);
+
+   retiredObjects.push_back(resObj);
+
+   // Lookups that were running when the objects were removed may still be
+   // walking past them so they are only deleted once no lookup is running.
+   // Objects a lookup returned are protected by the caller holding a lock.
+   dMemoryBarrier();
+   if(dAtomicRead(readerCount) != 0)
+      return;
+
+   for(S32 i = 0; i < retiredObjects.size(); i++)
+      delete retiredObjects[i];
+   retiredObjects.clear();
 }
@@ -108,6 +108,9 @@ void ResManager::setMissingFileLogging(bool logging)
 
 void ResManager::clearMissingFileList()
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    while(mMissingFileList.size())
    {
       dFree(mMissingFileList[0]);
@@ -118,6 +121,9 @@ void ResManager::clearMissingFileList()
 
 bool ResManager::getMissingFileList(Vector<char *> &list)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    if(!mMissingFileList.size())
       return false;
 
@@ -297,22 +303,30 @@ void ResManager::setWriteablePath (const char *path)
 
 //------------------------------------------------------------------------------
 
-static const char * buildPath (StringTableEntry path, StringTableEntry file)
+static const char * buildPath (StringTableEntry path, StringTableEntry file, char *buf, U32 bufSize)
 {
-   static char buf[1024];
    if (path)
-      Platform::makeFullPathName(file, buf, sizeof(buf), path);
+      Platform::makeFullPathName(file, buf, bufSize, path);
    else
-      dStrcpy (buf, file);
+   {
+      dStrncpy (buf, file, bufSize);
+      buf[bufSize - 1] = 0;
+   }
    return buf;
 }
 
+static const char * buildPath (StringTableEntry path, StringTableEntry file)
+{
+   static char buf[1024];
+   return buildPath (path, file, buf, sizeof (buf));
+}
+
 //------------------------------------------------------------------------------
 
 static void getPaths (const char *fullPath, StringTableEntry & path,
    StringTableEntry & fileName)
 {
-   static char buf[1024];
+   char buf[1024];
    char *ptr = (char *) dStrrchr (fullPath, '/');
    if (!ptr)
    {
@@ -333,6 +347,9 @@ static void getPaths (const char *fullPath, StringTableEntry & path,
 
 bool ResManager::addVFSRoot(Zip::ZipArchive *vfs)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    ResourceObject *ro = createResource (StringTable->EmptyString, StringTable->EmptyString);
    dictionary.pushBehind (ro, ResourceObject::File);
 
@@ -538,6 +555,9 @@ void ResManager::initExcludedDirectories()
 
 void ResManager::addPath(const char *path, bool ignoreZips )
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    searchPath(path, true, ignoreZips );
 }
 
@@ -551,11 +571,17 @@ ConsoleFunction(addResPath, void, 2, 3, "(path, [ignoreZips=false]) Add a path t
 
 void ResManager::removePath(const char *path)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    ResourceObject *rwalk = resourceList.nextResource, *rtemp;
    while (rwalk != NULL)
    {
-      const char *fname = buildPath(rwalk->path, rwalk->name);
-      if(!rwalk->mInstance && FindMatch::isMatch(path, fname, false))
+      char fname[1024];
+      buildPath(rwalk->path, rwalk->name, fname, sizeof(fname));
+
+      // Objects that are locked but not loaded are being loaded by another thread.
+      if(!rwalk->mInstance && !rwalk->lockCount && FindMatch::isMatch(path, fname, false))
       {
          rwalk->unlink ();
          dictionary.remove (rwalk);
@@ -575,6 +601,9 @@ ConsoleFunction(removeResPath, void, 2, 2, "(pathExpression) Remove a path from
 
 void ResManager::setModPaths (U32 numPaths, const char **paths)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    // [tom, 10/28/2006] If we're using a VFS, we don't want to do this
    // since it'll remove all the stuff we've already added.
    if(usingVFS)
@@ -623,7 +652,7 @@ void ResManager::setModPaths (U32 numPaths, const char **paths)
    ResourceObject *rwalk = resourceList.nextResource, *rtemp;
    while (rwalk != NULL)
    {
-      if ((rwalk->flags & ResourceObject::Added) && !rwalk->mInstance)
+      if ((rwalk->flags & ResourceObject::Added) && !rwalk->mInstance && !rwalk->lockCount)
       {
          rwalk->unlink ();
          dictionary.remove (rwalk);
@@ -797,6 +826,19 @@ RESOURCE_CREATE_FN ResManager::getCreateFunction (const char *name)
 }
 
 
+//------------------------------------------------------------------------------
+
+void ResManager::lock (ResourceObject * obj)
+{
+   if (!obj)
+      return;
+
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
+   obj->lockCount++;
+}
+
 //------------------------------------------------------------------------------
 
 void ResManager::unlock (ResourceObject * obj)
@@ -804,6 +846,9 @@ void ResManager::unlock (ResourceObject * obj)
    if (!obj)
       return;
 
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    AssertFatal (obj->lockCount > 0,
           "ResourceManager::unlock: lock count is zero.");
 
@@ -819,6 +864,9 @@ void ResManager::unlock (ResourceObject * obj)
 bool ResManager::getCrc (const char *fileName, U32 & crcVal,
    const U32 crcInitialVal)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    ResourceObject *obj = find (fileName);
    if (!obj)
       return (false);
@@ -870,6 +918,9 @@ bool ResManager::getCrc (const char *fileName, U32 & crcVal,
 
 ResourceObject *ResManager::load (const char *fileName, bool computeCRC)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    // if filename is not known, exit now
    ResourceObject *obj = find (fileName);
    if (!obj)
@@ -885,8 +936,21 @@ ResourceObject *ResManager::load (const char *fileName, bool computeCRC)
 
    if (!obj->mInstance)
    {
-      obj->mInstance = loadInstance (obj, computeCRC);
-      if (!obj->mInstance)
+      // Construct the instance without holding the lock so that other threads
+      // are not held up while this one reads the file.  The lock count taken
+      // above keeps the object from being purged or freed meanwhile.
+      mutex.unlock ();
+      ResourceInstance *instance = constructInstance (obj, computeCRC);
+      mutex.lock(&mMutex, true);
+
+      if (obj->mInstance)
+      {
+         // Another thread finished loading the same resource first.
+         delete instance;
+      }
+      else if (instance)
+         obj->mInstance = instance;
+      else
       {
          obj->lockCount--;
          return NULL;
@@ -907,11 +971,34 @@ ResourceInstance * ResManager::loadInstance (const char *fileName, bool computeC
    return loadInstance (obj, computeCRC);
 }
 
+
 //------------------------------------------------------------------------------
 
 static const char *alwaysCRCList = ".ter.dif.dts";
 
 ResourceInstance * ResManager::loadInstance (ResourceObject * obj, bool computeCRC)
+{
+   // Lock the object so that another thread cannot purge or free it while
+   // the instance is constructed.  An object that was waiting in the timeout
+   // list goes back there afterwards.
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+   const bool queued = obj->prev != NULL;
+   obj->lockCount++;
+   obj->unlink ();
+   mutex.unlock ();
+
+   ResourceInstance *ret = constructInstance (obj, computeCRC);
+
+   mutex.lock(&mMutex, true);
+   if (--obj->lockCount == 0 && queued)
+      obj->linkAfter (&timeoutList);
+   return ret;
+}
+
+//------------------------------------------------------------------------------
+
+ResourceInstance * ResManager::constructInstance (ResourceObject * obj, bool computeCRC)
 {
    Stream *stream = openStream (obj);
    if (!stream)
@@ -972,8 +1059,9 @@ Stream * ResManager::openStream (ResourceObject * obj)
    // if disk file
    if (obj->flags & (ResourceObject::File))
    {
+      char fileName[1024];
       diskStream = new FileStream;
-      if( !diskStream->open (buildPath (obj->path, obj->name), FileStream::Read) )
+      if( !diskStream->open (buildPath (obj->path, obj->name, fileName, sizeof (fileName)), FileStream::Read) )
       {
          delete diskStream;
          return NULL;
@@ -1037,16 +1125,25 @@ ResourceObject *ResManager::find (const char *fileName)
       return NULL;
    StringTableEntry path, file;
    getPaths (fileName, path, file);
+
+   // Known resources are found without taking the lock.
    ResourceObject *ret = dictionary.find (path, file);
+   if (ret)
+      return ret;
+
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
+   // Another thread may have added the file since the unlocked lookup.
+   ret = dictionary.find (path, file);
    if(!ret)
    {
       // If we couldn't find the file in the resource list (generated
       // by setting the modPaths) then try to load it directly
       if (Platform::isFile(fileName))
       {
-         ret = createResource (path, file);
-         dictionary.pushBehind (ret, ResourceObject::File);
-
+         // Fill in the object before lookups on other threads can see it.
+         ret = allocResource (path, file);
          ret->flags = ResourceObject::File;
          ret->fileOffset = 0;
 
@@ -1054,6 +1151,10 @@ ResourceObject *ResManager::find (const char *fileName)
          ret->fileSize = fileSize;
          ret->compressedFileSize = fileSize;
 
+         dMemoryBarrier();
+         dictionary.insert (ret, path, file);
+         dictionary.pushBehind (ret, ResourceObject::File);
+
          return ret;
       }
 
@@ -1070,6 +1171,13 @@ ResourceObject *ResManager::find (const char *fileName, U32 flags)
       return NULL;
    StringTableEntry path, file;
    getPaths (fileName, path, file);
+   ResourceObject *ret = dictionary.find (path, file, flags);
+   if (ret)
+      return ret;
+
+   // Repeat a miss in case it raced with another thread moving the object.
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
    return dictionary.find (path, file, flags);
 }
 
@@ -1080,6 +1188,9 @@ ResourceObject *ResManager::find (const char *fileName, U32 flags)
 bool ResManager::add (const char *name, ResourceInstance * addInstance,
    bool extraLock)
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    StringTableEntry path, file;
    getPaths (name, path, file);
 
@@ -1104,6 +1215,9 @@ bool ResManager::add (const char *name, ResourceInstance * addInstance,
 
 void ResManager::purge ()
 {
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    bool found;
    do
    {
@@ -1134,9 +1248,14 @@ ConsoleFunction( purgeResources, void, 1, 1, "() Use the purgeResources function
 
 void ResManager::purge (ResourceObject * obj)
 {
-   AssertFatal (obj->lockCount == 0,
-          "ResourceManager::purge: handle lock count is not ZERO.") obj->
-   unlink ();
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
+   // Another thread may have locked the object again since it was released.
+   if (obj->lockCount != 0)
+      return;
+
+   obj->unlink ();
    obj->destruct ();
 }
 
@@ -1264,7 +1383,17 @@ ResourceObject * ResManager::createResource (StringTableEntry path, StringTableE
    if (newRO)
       return newRO;
 
-   newRO = new ResourceObject;
+   newRO = allocResource (path, file);
+   dictionary.insert (newRO, path, file);
+
+   return newRO;
+}
+
+//------------------------------------------------------------------------------
+
+ResourceObject * ResManager::allocResource (StringTableEntry path, StringTableEntry file)
+{
+   ResourceObject *newRO = new ResourceObject;
    newRO->path = path;
    newRO->name = file;
    newRO->lockCount = 0;
@@ -1276,11 +1405,12 @@ ResourceObject * ResManager::createResource (StringTableEntry path, StringTableE
    newRO->prevResource = &resourceList;
    if (newRO->nextResource)
       newRO->nextResource->prevResource = newRO;
-   dictionary.insert (newRO, path, file);
    newRO->fileSize = newRO->fileOffset = newRO->compressedFileSize = 0;
    newRO->zipPath = NULL;
    newRO->zipName = NULL;
    newRO->crc = InvalidCRC;
+   newRO->mZipArchive = NULL;
+   newRO->mCentralDir = NULL;
 
    return newRO;
 }
@@ -1295,25 +1425,10 @@ ResourceObject * ResManager::createZipResource (StringTableEntry path, StringTab
    if (newRO)
       return newRO;
 
-   newRO = new ResourceObject;
-   newRO->path = path;
-   newRO->name = file;
-   newRO->lockCount = 0;
-   newRO->mInstance = NULL;
-   newRO->flags = ResourceObject::Added;
-   newRO->next = newRO->prev = NULL;
-   newRO->nextResource = resourceList.nextResource;
-   resourceList.nextResource = newRO;
-   newRO->prevResource = &resourceList;
-   if (newRO->nextResource)
-      newRO->nextResource->prevResource = newRO;
-   dictionary.insert (newRO, path, file);
-   newRO->fileSize = newRO->fileOffset = newRO->compressedFileSize = 0;
+   newRO = allocResource (path, file);
    newRO->zipPath = zipPath;
    newRO->zipName = zipName;
-   newRO->crc = InvalidCRC;
-   newRO->mZipArchive = NULL;
-   newRO->mCentralDir = NULL;
+   dictionary.insert (newRO, path, file);
 
    return newRO;
 }
@@ -1333,7 +1448,9 @@ void ResManager::freeResource (ResourceObject * ro)
    if (ro->nextResource)
       ro->nextResource->prevResource = ro->prevResource;
    dictionary.remove (ro);
-   delete ro;
+
+   // Lookups on other threads may still be walking past the object.
+   dictionary.retire (ro);
 }
 
 //------------------------------------------------------------------------------
@@ -1356,6 +1473,9 @@ bool ResManager::openFileForWrite (FileStream & stream, const char *fileName, U3
    if (!stream.open (fileName, (FileStream::AccessMode) accessMode))
       return false;
 
+   MutexHandle mutex;
+   mutex.lock(&mMutex, true);
+
    // create a resource for the file.
    ResourceObject *ro = createResource (StringTable->insert (path), StringTable->insert (file));
    ro->flags = ResourceObject::File;
@@ -39,6 +39,9 @@
 #ifndef _CRC_H_
 #include "algorithm/crc.h"
 #endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
 
 class Stream;
 class FileStream;
@@ -133,7 +136,7 @@ class ResourceObject
    ///
    ResourceObject *prev, *next;
 
-   ResourceObject *nextEntry;    ///< This is used by ResDictionary for its hash table.
+   ResourceObject * volatile nextEntry;   ///< This is used by ResDictionary for its hash table.
 
    ResourceObject *nextResource;
    ResourceObject *prevResource;
@@ -235,9 +238,6 @@ template <class T> class Resource
 private:
    ResourceObject *obj;  ///< Actual resource object
 
-   // ***WARNING***
-   // Using a faster lock that bypasses the resource manger.
-   // void _lock() { if (obj) obj->rm->lockResource( obj ); }
    void _lock();   ///< Increments the lock count on this object
    void _unlock(); ///< Decrements the lock count on this object
 
@@ -275,10 +275,15 @@ public:
 //----------------------------------------------------------------------------
 /// Resource Dictionary.
 ///
-/// Maps of names and object IDs to objects.
+/// Maps a path and file name to the resource objects for that file.
 ///
-/// Provides fast lookup for name->object, id->object and
-/// for fast removal of an object given a pointer to it.
+/// Lookups do not take a lock and may run on any thread while another thread
+/// changes the dictionary.  Changes are serialized by the dictionary itself.
+/// A removed object must be handed to retire() rather than deleted so that
+/// lookups which are still walking past it can finish.  That does not cover
+/// the object a lookup returns: the caller must have it locked, or be
+/// serialized with the ResManager functions that free objects, for as long
+/// as it uses it.
 ///
 /// @see ResManager
 class ResDictionary
@@ -286,14 +291,61 @@ class ResDictionary
    /// @name Hash Table
    /// @{
 
-   enum { DefaultTableSize = 1029 };
+   /// A path and file name key.
+   ///
+   /// Entries are never modified or removed once published so they can be
+   /// probed without holding a lock.  The objects for the key are chained,
+   /// in lookup order, through ResourceObject::nextEntry.
+   struct Entry
+   {
+      U32 hash;
+      StringTableEntry path;
+      StringTableEntry name;
+      ResourceObject * volatile head;
+   };
+
+   /// Maps a full path, as given, to the full path name it resolves to.
+   struct PathEntry
+   {
+      U32 hash;
+      StringTableEntry path;
+      StringTableEntry fullPath;
+   };
+
+   /// Open addressing slot array.
+   ///
+   /// A table that grows swaps in a larger slot array but the old array is
+   /// retired rather than freed so that concurrent lookups can finish
+   /// probing it.
+   template<class T> struct SlotArray
+   {
+      U32 mask;
+      SlotArray *retired;
+      T * volatile slots[1];
+   };
+
+   enum { DefaultTableSize = 1024 };
 
-   ResourceObject **hashTable;
-   S32 entryCount;
-   S32 hashTableSize;
+   SlotArray<Entry> * volatile hashTable;
+   SlotArray<PathEntry> * volatile pathTable;
+   U32 entryCount;
+   U32 pathCount;
+   volatile U32 readerCount;           ///< Number of lookups currently running.
+   Vector<ResourceObject*> retiredObjects;
    DataChunker memPool;
-   S32 hash(StringTableEntry path, StringTableEntry name);
-   S32 hash(ResourceObject *obj) { return hash(obj->path, obj->name); }
+   Mutex mutex;
+
+   static U32 hash(StringTableEntry path, StringTableEntry name);
+   template<class T> static SlotArray<T>* allocSlotArray(const U32 size);
+   template<class T> static SlotArray<T>* growSlotArray(SlotArray<T>* table);
+   template<class T> static void freeSlotArrays(SlotArray<T>* table);
+
+   /// Returns the full path name used as the key for a path.
+   StringTableEntry resolvePath(StringTableEntry path);
+
+   Entry* findEntry(StringTableEntry path, StringTableEntry name, const U32 keyHash);
+   Entry* insertEntry(StringTableEntry path, StringTableEntry name);
+   bool unlinkObject(Entry *entry, ResourceObject *obj);
    /// @}
 
 public:
@@ -307,6 +359,9 @@ public:
    /// These functions search the hash table for an individual resource.  If the resource has
    /// already been loaded, it will find the resource and return its object.  If not,
    /// it will return NULL.
+   ///
+   /// A lookup that runs while another thread moves an object of the same file may miss it.
+   /// Callers that need a definite answer repeat the lookup while serialized with the changes.
    /// @{
 
    ResourceObject* find(StringTableEntry path, StringTableEntry file);
@@ -319,6 +374,9 @@ public:
 
    /// Remove a resource object from the dictionary.
    void remove(ResourceObject *obj);
+
+   /// Delete a removed resource object once no running lookup is walking past it.
+   void retire(ResourceObject *obj);
 };
 
 
@@ -357,6 +415,10 @@ private:
 
    ResDictionary dictionary;
 
+   /// Serializes changes to the resource lists, lock counts and dictionary.
+   /// Lookups of known resources do not take it.
+   Mutex mMutex;
+
    bool echoFileNames;
 
    bool usingVFS;
@@ -369,6 +431,12 @@ private:
    /// Create a ResourceObject from the given file.
    ResourceObject* createResource(StringTableEntry path, StringTableEntry file);
 
+   /// Create a ResourceObject and add it to the resource list but not the dictionary.
+   ResourceObject* allocResource(StringTableEntry path, StringTableEntry file);
+
+   /// Construct the instance of a ResourceObject from its file.
+   ResourceInstance* constructInstance(ResourceObject *object, bool computeCRC);
+
    /// Create a ResourceObject from the given file in a zip file.
    ResourceObject* createZipResource(StringTableEntry path, StringTableEntry file, StringTableEntry zipPath, StringTableEntry zipFle);
 
@@ -432,6 +500,9 @@ public:
    Stream*  openStream(ResourceObject *object);       ///< Opens a stream for an object
    void     closeStream(Stream *stream);              ///< Closes the stream
 
+   /// Increments the lock count of an object that is already locked.
+   void lock( ResourceObject* );
+
    /// Decrements the lock count of an object.  If the lock count is zero post-decrement,
    /// the object is added to the timeoutList for deletion upon call of flush.
    void unlock( ResourceObject* );
@@ -440,6 +511,9 @@ public:
    bool add(const char* name, ResourceInstance *addInstance, bool extraLock = false);
 
    /// Searches the hash list for the filename and returns it's object if found, otherwise NULL
+   ///
+   /// The object is only guaranteed to stay valid while it is locked or while
+   /// the caller is serialized with the functions that free resources.
    ResourceObject* find(const char * fileName);
    /// Loads a new instance of an object by means of a filename
    ResourceInstance* loadInstance(const char *fileName, bool computeCRC = false);
@@ -502,7 +576,7 @@ template<class T> inline void Resource<T>::purge()
 template <class T> inline void Resource<T>::_lock()
 {
    if (obj)
-      obj->lockCount++;
+      ResourceManager->lock( obj );
 }
 
 template <class T> inline void Resource<T>::_unlock()
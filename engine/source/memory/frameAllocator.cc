@@ -22,16 +22,268 @@
 
 #include "frameAllocator.h"
 #include "console/console.h"
+#include "platform/threads/thread.h"
+#include "math/mMathFn.h"
 
-U8*   FrameAllocator::smBuffer = NULL;
-U32   FrameAllocator::smWaterMark = 0;
-U32   FrameAllocator::smHighWaterMark = 0;
+U32            FrameAllocator::smFrameSize = 0;
+volatile U32   FrameAllocator::smFrameNumber = 0;
+FrameAllocator::Arena* FrameAllocator::smArenas = NULL;
+volatile U32   FrameAllocator::smArenasLock = 0;
+
+#ifdef TORQUE_THREAD_LOCAL
+TORQUE_THREAD_LOCAL FrameAllocator::Arena* FrameAllocator::smArena = NULL;
+#else
+FrameAllocator::Arena* FrameAllocator::smArena = NULL;
+#endif
+
+/// Overflow blocks are at least this fraction of the frame size.
+static const U32 sgOverflowBlockDivisor = 4;
+
+//-----------------------------------------------------------------------------
+
+static inline void lockArenas(volatile U32& lock)
+{
+   while(!dCompareAndSwap(lock, 0, 1))
+   {
+      while(dAtomicRead(lock) != 0)
+      {
+      }
+   }
+}
+
+static inline void unlockArenas(volatile U32& lock)
+{
+   dAtomicWrite(lock, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::init(const U32 frameSize)
+{
+   AssertFatal(smFrameSize == 0, "Error, already initialized");
+   AssertFatal(frameSize > 0, "Error, invalid frame size");
+   smFrameSize = frameSize;
+
+   // The calling thread gets its arena straight away.
+   getArena();
+}
+
+void FrameAllocator::destroy()
+{
+   AssertFatal(smFrameSize != 0, "Error, not initialized");
+
+   // Any worker threads must have finished with their arenas by now.
+   lockArenas(smArenasLock);
+   Arena* pArena = smArenas;
+   smArenas = NULL;
+   unlockArenas(smArenasLock);
+
+   while(pArena != NULL)
+   {
+      Arena* pNext = pArena->mNext;
+      releaseArena(pArena);
+      pArena = pNext;
+   }
+
+   smArena = NULL;
+   smFrameSize = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+FrameAllocator::Arena* FrameAllocator::createArena()
+{
+   AssertFatal(smFrameSize != 0, "Error, no buffer!");
+
+   Block* pFirst = (Block*)dMalloc(sizeof(Block) + smFrameSize);
+   pFirst->mPrev = NULL;
+   pFirst->mNext = NULL;
+   pFirst->mStart = 0;
+   pFirst->mSize = smFrameSize;
+
+   Arena* pArena = new Arena;
+   dMemset(pArena, 0, sizeof(Arena));
+   pArena->mFirst = pFirst;
+   pArena->mCurrent = pFirst;
+   pArena->mFrameNumber = dAtomicRead(smFrameNumber);
+   pArena->mStats.mThreadId = ThreadManager::getCurrentThreadId();
+   pArena->mStats.mBufferSize = smFrameSize;
+
+   lockArenas(smArenasLock);
+   pArena->mNext = smArenas;
+   smArenas = pArena;
+   unlockArenas(smArenasLock);
+
+   smArena = pArena;
+   return pArena;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::releaseArena(Arena* pArena)
+{
+   Block* pBlock = pArena->mFirst;
+   while(pBlock != NULL)
+   {
+      Block* pNext = pBlock->mNext;
+      dFree(pBlock);
+      pBlock = pNext;
+   }
+
+   delete pArena;
+}
+
+//-----------------------------------------------------------------------------
+
+FrameAllocator::Block* FrameAllocator::chainBlock(Arena* pArena, const U32 allocSize)
+{
+   Block* pBlock = pArena->mCurrent;
+   Block* pNext = pBlock->mNext;
+
+   // Blocks after the current one are unused so a block too small for the
+   // allocation is dropped along with the rest of the chain.
+   if(pNext != NULL && pNext->mSize < allocSize)
+   {
+      while(pNext != NULL)
+      {
+         Block* pFree = pNext;
+         pNext = pNext->mNext;
+         dFree(pFree);
+      }
+      pBlock->mNext = NULL;
+   }
+
+   if(pBlock->mNext == NULL)
+   {
+      U32 size = getMax(allocSize, pArena->mFirst->mSize / sgOverflowBlockDivisor);
+      size = (size + (TORQUE_BYTE_ALIGNMENT - 1)) & (~(TORQUE_BYTE_ALIGNMENT - 1));
+
+      Block* pOverflow = (Block*)dMalloc(sizeof(Block) + size);
+      pOverflow->mPrev = pBlock;
+      pOverflow->mNext = NULL;
+      pOverflow->mStart = pBlock->mStart + pBlock->mSize;
+      pOverflow->mSize = size;
+      pBlock->mNext = pOverflow;
+
+      pArena->mFrameOverflowBlocks++;
+      pArena->mFrameOverflowBytes += size;
+   }
+
+   pArena->mCurrent = pBlock->mNext;
+   return pArena->mCurrent;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::closeFrame(Arena* pArena)
+{
+   ArenaStats& stats = pArena->mStats;
+   stats.mFramePeak = pArena->mFramePeak;
+   stats.mPeak = getMax(stats.mPeak, pArena->mFramePeak);
+   stats.mOverflowBlocks = pArena->mFrameOverflowBlocks;
+   stats.mOverflowBytes = pArena->mFrameOverflowBytes;
+
+   pArena->mFramePeak = pArena->mWaterMark;
+   pArena->mFrameOverflowBlocks = 0;
+   pArena->mFrameOverflowBytes = 0;
+   pArena->mFrameNumber = dAtomicRead(smFrameNumber);
+
+   // Release the overflow blocks that are no longer in use.
+   Block* pNext = pArena->mCurrent->mNext;
+   pArena->mCurrent->mNext = NULL;
+   while(pNext != NULL)
+   {
+      Block* pFree = pNext;
+      pNext = pNext->mNext;
+      dFree(pFree);
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::endFrame()
+{
+   dFetchAndAdd(smFrameNumber, 1);
+
+   Arena* pArena = smArena;
+   if(pArena != NULL)
+      closeFrame(pArena);
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::releaseThread()
+{
+#ifdef TORQUE_THREAD_LOCAL
+   Arena* pArena = smArena;
+   if(pArena == NULL)
+      return;
+
+   lockArenas(smArenasLock);
+   Arena** ppLink = &smArenas;
+   while(*ppLink != NULL && *ppLink != pArena)
+      ppLink = &(*ppLink)->mNext;
+   if(*ppLink != NULL)
+      *ppLink = pArena->mNext;
+   unlockArenas(smArenasLock);
+
+   releaseArena(pArena);
+   smArena = NULL;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::getStats(Vector<ArenaStats>& stats)
+{
+   stats.clear();
+
+   lockArenas(smArenasLock);
+   for(Arena* pArena = smArenas; pArena != NULL; pArena = pArena->mNext)
+      stats.push_back(pArena->mStats);
+   unlockArenas(smArenasLock);
+}
+
+//-----------------------------------------------------------------------------
 
 #if defined(TORQUE_DEBUG)
 
 ConsoleFunction(getMaxFrameAllocation, S32, 1,1, "getMaxFrameAllocation();")
 {
-   return sgMaxFrameAllocation;
+   // The largest watermark reached by the calling thread in a completed frame.
+   Vector<FrameAllocator::ArenaStats> stats;
+   FrameAllocator::getStats(stats);
+
+   const U32 threadId = ThreadManager::getCurrentThreadId();
+   for(S32 i = 0; i < stats.size(); i++)
+   {
+      if(ThreadManager::compare(stats[i].mThreadId, threadId))
+         return stats[i].mPeak;
+   }
+
+   return 0;
 }
 
 #endif
+
+ConsoleFunction(dumpFrameAllocatorStats, void, 1, 1, "() Prints the frame allocator usage of each thread for the last frame.\n"
+                                                      "@return No return value.")
+{
+   Vector<FrameAllocator::ArenaStats> stats;
+   FrameAllocator::getStats(stats);
+
+   Con::printSeparator();
+   Con::printf("Frame Allocator Statistics:");
+   Con::printf("Thread       Buffer KB    Frame Peak KB  Peak KB      Overflows    Overflow KB");
+   Con::printSeparator();
+
+   for(S32 i = 0; i < stats.size(); i++)
+   {
+      const FrameAllocator::ArenaStats& arena = stats[i];
+      Con::printf("%-12u %-12.1f %-14.1f %-12.1f %-12d %-12.1f", arena.mThreadId,
+         arena.mBufferSize / 1024.0f, arena.mFramePeak / 1024.0f, arena.mPeak / 1024.0f,
+         arena.mOverflowBlocks, arena.mOverflowBytes / 1024.0f);
+   }
+
+   Con::printSeparator();
+}
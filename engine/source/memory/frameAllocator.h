@@ -27,6 +27,14 @@
 #include "platform/platform.h"
 #endif
 
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _PLATFORM_INTRINSICS_H_
+#include "platform/platformIntrinsics.h"
+#endif
+
 /// Temporary memory pool for per-frame allocations.
 ///
 /// In the course of rendering a frame, it is often necessary to allocate
@@ -43,44 +51,101 @@
 ///   // Free frameAllocator memory
 ///   FrameAllocator::setWaterMark(waterMark);
 /// @endcode
+///
+/// Each thread has its own arena so the allocator, FrameAllocatorMarker and
+/// FrameTemp can be used from worker threads.  An arena is created with the
+/// frame size given to init() the first time its thread allocates from it.
+///
+/// When an allocation does not fit, an overflow block is chained to the arena
+/// rather than asserting.  Watermarks count bytes across the whole chain so
+/// they keep working as before.  Overflow blocks are released at the end of
+/// the frame, or for a worker thread, the next time its watermark returns to
+/// zero after the frame has ended.
+///
+/// @note Platforms without thread local storage share a single arena which
+/// must only be used from the main thread.
 class FrameAllocator
 {
-   static U8*   smBuffer;
-   static U32   smHighWaterMark;
-   static U32   smWaterMark;
-
   public:
-   inline static void init(const U32 frameSize);
-   inline static void destroy();
+   /// Usage of an arena for the last completed frame and its lifetime peak.
+   struct ArenaStats
+   {
+      U32 mThreadId;
+      U32 mBufferSize;
+      U32 mFramePeak;
+      U32 mPeak;
+      U32 mOverflowBlocks;
+      U32 mOverflowBytes;
+   };
+
+   static void init(const U32 frameSize);
+   static void destroy();
 
    inline static void* alloc(const U32 allocSize);
 
    inline static void setWaterMark(const U32);
    inline static U32  getWaterMark();
+
+   /// The watermark at which the block currently being allocated from is full.
    inline static U32  getHighWaterMark();
-};
 
-#if defined(TORQUE_DEBUG)
-static U32 sgMaxFrameAllocation = 0;
-#endif
+   /// Called by the main loop once per frame.  Releases the overflow blocks of
+   /// the calling thread and closes the frame for the statistics.
+   static void endFrame();
 
-void FrameAllocator::init(const U32 frameSize)
-{
-   AssertFatal(smBuffer == NULL, "Error, already initialized");
-   smBuffer = new U8[frameSize];
-   smWaterMark = 0;
-   smHighWaterMark = frameSize;
-}
+   /// Releases the arena of the calling thread.  Called when a thread exits.
+   static void releaseThread();
 
-void FrameAllocator::destroy()
-{
-   AssertFatal(smBuffer != NULL, "Error, not initialized");
+   /// Fetches the statistics of every arena.
+   static void getStats(Vector<ArenaStats>& stats);
 
-   delete [] smBuffer;
-   smBuffer = NULL;
-   smWaterMark = 0;
-   smHighWaterMark = 0;
-}
+  private:
+   /// A buffer in the chain of an arena.  Its data follows the header.
+   struct Block
+   {
+      Block*   mPrev;
+      Block*   mNext;
+      U32      mStart;        ///< The watermark at the start of the block.
+      U32      mSize;
+
+      inline U8* getData() { return (U8*)(this + 1); }
+   };
+
+   struct Arena
+   {
+      Block*      mFirst;
+      Block*      mCurrent;
+      U32         mWaterMark;
+      U32         mFrameNumber;
+      U32         mFramePeak;
+      U32         mFrameOverflowBlocks;
+      U32         mFrameOverflowBytes;
+      ArenaStats  mStats;
+      Arena*      mNext;
+   };
+
+   static inline Arena* getArena()
+   {
+      Arena* pArena = smArena;
+      return pArena != NULL ? pArena : createArena();
+   }
+
+   static Arena* createArena();
+   static Block* chainBlock(Arena* pArena, const U32 allocSize);
+   static void   closeFrame(Arena* pArena);
+   static void   releaseArena(Arena* pArena);
+
+   static U32           smFrameSize;
+   static volatile U32  smFrameNumber;
+   static Arena*        smArenas;
+   static volatile U32  smArenasLock;
+
+#ifdef TORQUE_THREAD_LOCAL
+   static TORQUE_THREAD_LOCAL Arena* smArena;
+#else
+   static Arena* smArena;
+#endif
+};
 
 /// This #define is used by the FrameAllocator to align starting addresses to
 /// be byte aligned to this value. This is important on the 360 and possibly
@@ -91,63 +156,83 @@ void FrameAllocator::destroy()
 /// memory which is allocated and expected to be contiguous.
 #define TORQUE_BYTE_ALIGNMENT 4
 
-
-void* FrameAllocator::alloc(const U32 allocSize)
+inline void* FrameAllocator::alloc(const U32 allocSize)
 {
    U32 _allocSize = allocSize;
 #ifdef TORQUE_DEBUG
    _allocSize+=4;
 #endif
-   AssertFatal(smBuffer != NULL, "Error, no buffer!");
-   AssertFatal(smWaterMark + _allocSize <= smHighWaterMark, "Error alloc too large, increase frame size!");
+   Arena* pArena = getArena();
 
    // Keep all frame allocator allocations aligned to DWORD boundries on the 360
    // Add 3, mask out the lower 3 bits.
-   smWaterMark = ( smWaterMark + ( TORQUE_BYTE_ALIGNMENT - 1 ) ) & (~( TORQUE_BYTE_ALIGNMENT - 1 ));
+   U32 waterMark = ( pArena->mWaterMark + ( TORQUE_BYTE_ALIGNMENT - 1 ) ) & (~( TORQUE_BYTE_ALIGNMENT - 1 ));
+
+   // Chain another block when this one is full.
+   Block* pBlock = pArena->mCurrent;
+   if ( waterMark + _allocSize > pBlock->mStart + pBlock->mSize )
+   {
+      pBlock = chainBlock( pArena, _allocSize );
+      waterMark = pBlock->mStart;
+   }
 
    // Sanity check.
-   AssertFatal( !( smWaterMark & ( TORQUE_BYTE_ALIGNMENT - 1 ) ), "Frame allocation is not on a 4-byte boundry." );
+   AssertFatal( !( waterMark & ( TORQUE_BYTE_ALIGNMENT - 1 ) ), "Frame allocation is not on a 4-byte boundry." );
 
-   U8* p = &smBuffer[smWaterMark];
-   smWaterMark += _allocSize;
+   U8* p = pBlock->getData() + ( waterMark - pBlock->mStart );
+   pArena->mWaterMark = waterMark + _allocSize;
 
-#if defined(TORQUE_DEBUG)
-   if (smWaterMark > sgMaxFrameAllocation)
-      sgMaxFrameAllocation = smWaterMark;
-#endif
+   if ( pArena->mWaterMark > pArena->mFramePeak )
+      pArena->mFramePeak = pArena->mWaterMark;
 
 #ifdef TORQUE_DEBUG
-   U32 *flag = (U32*) &smBuffer[smWaterMark-4];
-   *flag = 0xdeadbeef ^ smWaterMark;
+   U32 *flag = (U32*) &p[_allocSize-4];
+   *flag = 0xdeadbeef ^ pArena->mWaterMark;
 #endif
    return p;
 }
 
 
-void FrameAllocator::setWaterMark(const U32 waterMark)
+inline void FrameAllocator::setWaterMark(const U32 waterMark)
 {
-   AssertFatal(waterMark < smHighWaterMark, "Error, invalid waterMark");
+   Arena* pArena = getArena();
+   AssertFatal(waterMark <= pArena->mWaterMark, "Error, invalid waterMark");
+
+   Block* pBlock = pArena->mCurrent;
 
 #ifdef TORQUE_DEBUG
-   if(smWaterMark >= 4 )
+   if(pArena->mWaterMark - pBlock->mStart >= 4 )
    {
-      U32 *flag = (U32*) &smBuffer[smWaterMark-4];
-      AssertFatal( *flag == (0xdeadbeef ^ smWaterMark), "FrameAllocator guard overwritten!");
+      U32 *flag = (U32*) &pBlock->getData()[pArena->mWaterMark - pBlock->mStart - 4];
+      AssertFatal( *flag == (0xdeadbeef ^ pArena->mWaterMark), "FrameAllocator guard overwritten!");
    }
 #endif
-   smWaterMark = waterMark;
+
+   // Step back to the block holding the watermark.  The blocks after it stay
+   // chained so they can be reused until the end of the frame.
+   while ( waterMark <= pBlock->mStart && pBlock->mPrev != NULL )
+      pBlock = pBlock->mPrev;
+
+   pArena->mCurrent = pBlock;
+   pArena->mWaterMark = waterMark;
+
+   // A thread that is idle after the frame has ended closes it.
+   if ( waterMark == 0 && pArena->mFrameNumber != dAtomicRead( smFrameNumber ) )
+      closeFrame( pArena );
 }
 
-U32 FrameAllocator::getWaterMark()
+inline U32 FrameAllocator::getWaterMark()
 {
-   return smWaterMark;
+   return getArena()->mWaterMark;
 }
 
-U32 FrameAllocator::getHighWaterMark()
+inline U32 FrameAllocator::getHighWaterMark()
 {
-   return smHighWaterMark;
+   Block* pBlock = getArena()->mCurrent;
+   return pBlock->mStart + pBlock->mSize;
 }
 
+
 /// Helper class to deal with FrameAllocator usage.
 ///
 /// The purpose of this class is to make it simpler and more reliable to use the
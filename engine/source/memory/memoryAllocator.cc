@@ -0,0 +1,578 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "memory/memoryAllocator.h"
+#include "platform/platformIntrinsics.h"
+#include "console/console.h"
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+
+static inline void lockSpin( volatile U32& lock )
+{
+   while ( !dCompareAndSwap( lock, 0, 1 ) )
+   {
+      while ( dAtomicRead( lock ) != 0 )
+      {
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+static inline void unlockSpin( volatile U32& lock )
+{
+   dAtomicWrite( lock, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+// The C runtime only aligns blocks to eight bytes on some platforms so blocks
+// taken from it are over-allocated and aligned by hand.  The byte before an
+// aligned block holds how far it was moved from the start of the allocation.
+
+static inline U32 getAlignmentOffset( const U8* pRaw )
+{
+   return MemoryAllocator::Alignment - (U32)( (size_t)pRaw & ( MemoryAllocator::Alignment - 1 ) );
+}
+
+static void* alignedMalloc( const dsize_t size )
+{
+   U8* pRaw = (U8*)malloc( size + MemoryAllocator::Alignment );
+   if ( pRaw == NULL )
+      return NULL;
+
+   const U32 offset = getAlignmentOffset( pRaw );
+   pRaw[offset - 1] = (U8)offset;
+   return pRaw + offset;
+}
+
+static void* alignedRealloc( void* pBlock, const dsize_t oldSize, const dsize_t newSize )
+{
+   if ( pBlock == NULL )
+      return alignedMalloc( newSize );
+
+   const U32 oldOffset = ((U8*)pBlock)[-1];
+   U8* pRaw = (U8*)realloc( (U8*)pBlock - oldOffset, newSize + MemoryAllocator::Alignment );
+   if ( pRaw == NULL )
+      return NULL;
+
+   // The runtime may have moved the block to an address with a different misalignment.
+   const U32 offset = getAlignmentOffset( pRaw );
+   if ( offset != oldOffset )
+      dMemmove( pRaw + offset, pRaw + oldOffset, oldSize < newSize ? oldSize : newSize );
+
+   pRaw[offset - 1] = (U8)offset;
+   return pRaw + offset;
+}
+
+static void alignedFree( void* pBlock )
+{
+   if ( pBlock != NULL )
+      ::free( (U8*)pBlock - ((U8*)pBlock)[-1] );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Forwards every block to the C runtime heap.
+class SystemMemoryBackend : public MemoryBackend
+{
+public:
+   virtual const char* getName( void ) const
+   {
+      return "System";
+   }
+
+   virtual void* allocate( const dsize_t size, const U32 arena )
+   {
+      return alignedMalloc( size );
+   }
+
+   virtual void* reallocate( void* pBlock, const dsize_t oldSize, const dsize_t newSize, const U32 arena )
+   {
+      return alignedRealloc( pBlock, oldSize, newSize );
+   }
+
+   virtual void free( void* pBlock, const dsize_t size, const U32 arena )
+   {
+      alignedFree( pBlock );
+   }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Serves small blocks from size classes carved out of large pages.
+///
+/// Each arena has its own pages and free lists so blocks of different
+/// subsystems never share a page.  Each thread keeps a short free list per
+/// arena and size class which it refills from, and spills back to, the
+/// arena in batches so most allocations and frees take no lock at all.
+/// Blocks cached by a thread that exits are not returned to the arena.
+///
+/// Blocks larger than the biggest size class go straight to the C runtime.
+class SmallBlockMemoryBackend : public MemoryBackend
+{
+public:
+   enum
+   {
+      ClassCount      = 20,
+      MaxSmallSize    = 1024,
+      PageSize        = 64 * 1024,
+      BatchCount      = 32,
+      MaxCachedBlocks = 64,
+   };
+
+   SmallBlockMemoryBackend()
+   {
+      // Sixteen byte steps up to 128 bytes then four classes per doubling.
+      U32 classSize = 0;
+      for ( U32 index = 0; index < ClassCount; ++index )
+      {
+         classSize += classSize < 128 ? 16 : classSize < 256 ? 32 : classSize < 512 ? 64 : 128;
+         mClassSizes[index] = classSize;
+      }
+
+      U32 classIndex = 0;
+      for ( U32 slot = 0; slot <= MaxSmallSize / 16; ++slot )
+      {
+         while ( mClassSizes[classIndex] < slot * 16 )
+            ++classIndex;
+
+         mSizeToClass[slot] = (U8)classIndex;
+      }
+
+      dMemset( mArenas, 0, sizeof(mArenas) );
+   }
+
+   virtual const char* getName( void ) const
+   {
+      return "Small Block";
+   }
+
+   virtual void* allocate( const dsize_t size, const U32 arena )
+   {
+      if ( size > MaxSmallSize )
+         return alignedMalloc( size );
+
+      const U32 classIndex = mSizeToClass[(size + 15) >> 4];
+
+#ifdef TORQUE_THREAD_LOCAL
+      FreeBlock*& head = smCache.mHeads[arena][classIndex];
+      if ( head == NULL )
+      {
+         smCache.mCounts[arena][classIndex] = takeBatch( arena, classIndex, head );
+      }
+
+      FreeBlock* pBlock = head;
+      head = pBlock->mNext;
+      smCache.mCounts[arena][classIndex]--;
+      return pBlock;
+#else
+      FreeBlock* pBlock;
+      takeBatch( arena, classIndex, pBlock, 1 );
+      return pBlock;
+#endif
+   }
+
+   virtual void* reallocate( void* pBlock, const dsize_t oldSize, const dsize_t newSize, const U32 arena )
+   {
+      if ( oldSize > MaxSmallSize && newSize > MaxSmallSize )
+         return alignedRealloc( pBlock, oldSize, newSize );
+
+      // The block is already big enough when both sizes share a size class.
+      if ( oldSize <= MaxSmallSize && newSize <= MaxSmallSize && mSizeToClass[(oldSize + 15) >> 4] == mSizeToClass[(newSize + 15) >> 4] )
+         return pBlock;
+
+      void* pNewBlock = allocate( newSize, arena );
+      if ( pNewBlock == NULL )
+         return NULL;
+
+      dMemcpy( pNewBlock, pBlock, oldSize < newSize ? oldSize : newSize );
+      free( pBlock, oldSize, arena );
+      return pNewBlock;
+   }
+
+   virtual void free( void* pBlock, const dsize_t size, const U32 arena )
+   {
+      if ( size > MaxSmallSize )
+      {
+         alignedFree( pBlock );
+         return;
+      }
+
+      const U32 classIndex = mSizeToClass[(size + 15) >> 4];
+      FreeBlock* pFree = (FreeBlock*)pBlock;
+
+#ifdef TORQUE_THREAD_LOCAL
+      FreeBlock*& head = smCache.mHeads[arena][classIndex];
+      pFree->mNext = head;
+      head = pFree;
+
+      if ( ++smCache.mCounts[arena][classIndex] > MaxCachedBlocks )
+      {
+         // Hand the most recently freed batch back to the arena.
+         FreeBlock* pLast = head;
+         for ( U32 count = 1; count < BatchCount; ++count )
+            pLast = pLast->mNext;
+
+         FreeBlock* pBatch = head;
+         head = pLast->mNext;
+         smCache.mCounts[arena][classIndex] -= BatchCount;
+         giveBatch( arena, classIndex, pBatch, pLast );
+      }
+#else
+      pFree->mNext = NULL;
+      giveBatch( arena, classIndex, pFree, pFree );
+#endif
+   }
+
+   virtual U32 getReservedBytes( const U32 arena ) const
+   {
+      return mArenas[arena].mReservedBytes;
+   }
+
+private:
+   struct FreeBlock
+   {
+      FreeBlock* mNext;
+   };
+
+   struct Arena
+   {
+      volatile U32    mLock;
+      U32             mReservedBytes;
+      FreeBlock*      mFreeBlocks[ClassCount];
+      U8*             mPageCursor[ClassCount];
+      U8*             mPageEnd[ClassCount];
+   };
+
+   struct ThreadCache
+   {
+      FreeBlock*      mHeads[MemoryAllocator::TagCount][ClassCount];
+      U32             mCounts[MemoryAllocator::TagCount][ClassCount];
+   };
+
+   /// Takes up to count blocks from the arena, carving a new page when it has none free.
+   /// @return The number of blocks linked from pHead.
+   U32 takeBatch( const U32 arena, const U32 classIndex, FreeBlock*& pHead, const U32 count = BatchCount )
+   {
+      Arena& owner = mArenas[arena];
+      lockSpin( owner.mLock );
+
+      U32 taken = 0;
+      pHead = owner.mFreeBlocks[classIndex];
+      if ( pHead != NULL )
+      {
+         FreeBlock* pLast = pHead;
+         taken = 1;
+         while ( taken < count && pLast->mNext != NULL )
+         {
+            pLast = pLast->mNext;
+            ++taken;
+         }
+
+         owner.mFreeBlocks[classIndex] = pLast->mNext;
+         pLast->mNext = NULL;
+      }
+      else
+      {
+         const U32 classSize = mClassSizes[classIndex];
+         FreeBlock* pTail = NULL;
+         while ( taken < count )
+         {
+            if ( owner.mPageCursor[classIndex] + classSize > owner.mPageEnd[classIndex] )
+            {
+               // Pages are never released.  Keep the C runtime alignment for the first block.
+               U8* pPage = (U8*)malloc( PageSize + MemoryAllocator::Alignment );
+               AssertFatal( pPage != NULL, "SmallBlockMemoryBackend - Out of memory." );
+               const U32 misalignment = (U32)( (size_t)pPage & ( MemoryAllocator::Alignment - 1 ) );
+               owner.mPageCursor[classIndex] = pPage + ( ( MemoryAllocator::Alignment - misalignment ) & ( MemoryAllocator::Alignment - 1 ) );
+               owner.mPageEnd[classIndex] = owner.mPageCursor[classIndex] + PageSize;
+               owner.mReservedBytes += PageSize;
+            }
+
+            FreeBlock* pBlock = (FreeBlock*)owner.mPageCursor[classIndex];
+            owner.mPageCursor[classIndex] += classSize;
+            pBlock->mNext = NULL;
+
+            if ( pTail == NULL )
+               pHead = pBlock;
+            else
+               pTail->mNext = pBlock;
+
+            pTail = pBlock;
+            ++taken;
+         }
+      }
+
+      unlockSpin( owner.mLock );
+      return taken;
+   }
+
+   void giveBatch( const U32 arena, const U32 classIndex, FreeBlock* pHead, FreeBlock* pLast )
+   {
+      Arena& owner = mArenas[arena];
+      lockSpin( owner.mLock );
+      pLast->mNext = owner.mFreeBlocks[classIndex];
+      owner.mFreeBlocks[classIndex] = pHead;
+      unlockSpin( owner.mLock );
+   }
+
+   U32     mClassSizes[ClassCount];
+   U8      mSizeToClass[MaxSmallSize / 16 + 1];
+   Arena   mArenas[MemoryAllocator::TagCount];
+
+#ifdef TORQUE_THREAD_LOCAL
+   static TORQUE_THREAD_LOCAL ThreadCache smCache;
+#endif
+};
+
+#ifdef TORQUE_THREAD_LOCAL
+TORQUE_THREAD_LOCAL SmallBlockMemoryBackend::ThreadCache SmallBlockMemoryBackend::smCache;
+#endif
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_SYSTEM_ALLOCATOR
+typedef SystemMemoryBackend DefaultMemoryBackend;
+#else
+typedef SmallBlockMemoryBackend DefaultMemoryBackend;
+#endif
+
+// The backend lives in static storage and is never destroyed so that blocks
+// can still be freed by destructors that run at exit.
+static MemoryBackend* sgBackend = NULL;
+static U64 sgBackendStorage[( sizeof(DefaultMemoryBackend) + sizeof(U64) - 1 ) / sizeof(U64)];
+
+#ifdef TORQUE_THREAD_LOCAL
+static TORQUE_THREAD_LOCAL U32 sgCurrentTag = MemoryAllocator::GeneralTag;
+#else
+// Without thread local storage every thread shares the same tag.
+static U32 sgCurrentTag = MemoryAllocator::GeneralTag;
+#endif
+
+static const char* sgTagNames[MemoryAllocator::TagCount] =
+{
+   "General",
+   "Console",
+   "Sim",
+   "Scene",
+   "Particles",
+   "Textures",
+   "Box2D",
+};
+
+MemoryAllocator::TagStats MemoryAllocator::smStats[MemoryAllocator::TagCount];
+
+//-----------------------------------------------------------------------------
+
+MemoryBackend* MemoryAllocator::getBackend( void )
+{
+   // The first allocation happens during static initialization on the main thread.
+   if ( sgBackend == NULL )
+      sgBackend = new( sgBackendStorage ) DefaultMemoryBackend;
+
+   return sgBackend;
+}
+
+//-----------------------------------------------------------------------------
+
+void* MemoryAllocator::allocate( const dsize_t size, const Tag tag )
+{
+   AssertFatal( tag < TagCount, "MemoryAllocator::allocate() - Invalid tag." );
+
+   BlockHeader* pHeader = (BlockHeader*)getBackend()->allocate( size + sizeof(BlockHeader), tag );
+   if ( pHeader == NULL )
+      return NULL;
+
+   pHeader->mSize = (U32)size;
+   pHeader->mTag = tag;
+   addStats( tag, (U32)size );
+
+   return pHeader + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void* MemoryAllocator::reallocate( void* pMemory, const dsize_t size )
+{
+   if ( pMemory == NULL )
+      return allocate( size );
+
+   BlockHeader* pHeader = getHeader( pMemory );
+   const Tag tag = (Tag)pHeader->mTag;
+   const U32 oldSize = pHeader->mSize;
+
+   pHeader = (BlockHeader*)getBackend()->reallocate( pHeader, oldSize + sizeof(BlockHeader), size + sizeof(BlockHeader), tag );
+   if ( pHeader == NULL )
+      return NULL;
+
+   pHeader->mSize = (U32)size;
+   removeStats( tag, oldSize );
+   addStats( tag, (U32)size );
+
+   // A reallocation is not a new block.
+   dFetchAndAdd( smStats[tag].mAllocations, (U32)-1 );
+
+   return pHeader + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void MemoryAllocator::free( void* pMemory )
+{
+   if ( pMemory == NULL )
+      return;
+
+   BlockHeader* pHeader = getHeader( pMemory );
+   const Tag tag = (Tag)pHeader->mTag;
+   const U32 size = pHeader->mSize;
+
+   removeStats( tag, size );
+   getBackend()->free( pHeader, size + sizeof(BlockHeader), tag );
+}
+
+//-----------------------------------------------------------------------------
+
+dsize_t MemoryAllocator::getSize( const void* pMemory )
+{
+   return pMemory != NULL ? getHeader( pMemory )->mSize : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+MemoryAllocator::Tag MemoryAllocator::getTag( const void* pMemory )
+{
+   return pMemory != NULL ? (Tag)getHeader( pMemory )->mTag : GeneralTag;
+}
+
+//-----------------------------------------------------------------------------
+
+MemoryAllocator::Tag MemoryAllocator::getCurrentTag( void )
+{
+   return (Tag)sgCurrentTag;
+}
+
+//-----------------------------------------------------------------------------
+
+void MemoryAllocator::setCurrentTag( const Tag tag )
+{
+   AssertFatal( tag < TagCount, "MemoryAllocator::setCurrentTag() - Invalid tag." );
+
+   sgCurrentTag = tag;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* MemoryAllocator::getTagName( const Tag tag )
+{
+   return tag < TagCount ? sgTagNames[tag] : "Unknown";
+}
+
+//-----------------------------------------------------------------------------
+
+void MemoryAllocator::resetPeak( const Tag tag )
+{
+   AssertFatal( tag < TagCount, "MemoryAllocator::resetPeak() - Invalid tag." );
+
+   TagStats& stats = smStats[tag];
+
+   U32 peakBytes = dAtomicRead( stats.mPeakBytes );
+   while ( !dCompareAndSwap( stats.mPeakBytes, peakBytes, dAtomicRead( stats.mLiveBytes ) ) )
+      peakBytes = dAtomicRead( stats.mPeakBytes );
+}
+
+//-----------------------------------------------------------------------------
+
+void MemoryAllocator::addStats( const Tag tag, const U32 size )
+{
+   TagStats& stats = smStats[tag];
+
+   const U32 liveBytes = dFetchAndAdd( stats.mLiveBytes, size ) + size;
+   dFetchAndAdd( stats.mLiveBlocks, 1 );
+   dFetchAndAdd( stats.mAllocations, 1 );
+
+   U32 peakBytes = dAtomicRead( stats.mPeakBytes );
+   while ( liveBytes > peakBytes && !dCompareAndSwap( stats.mPeakBytes, peakBytes, liveBytes ) )
+      peakBytes = dAtomicRead( stats.mPeakBytes );
+}
+
+//-----------------------------------------------------------------------------
+
+void MemoryAllocator::removeStats( const Tag tag, const U32 size )
+{
+   TagStats& stats = smStats[tag];
+
+   dFetchAndAdd( stats.mLiveBytes, (U32)-(S32)size );
+   dFetchAndAdd( stats.mLiveBlocks, (U32)-1 );
+}
+
+//-----------------------------------------------------------------------------
+
+void MemoryAllocator::dumpStats( void )
+{
+   MemoryBackend* pBackend = getBackend();
+
+   Con::printSeparator();
+   Con::printf( "Memory Statistics (%s backend):", pBackend->getName() );
+   Con::printf( "Tag          Live KB      Peak KB      Reserved KB  Live Blocks  Allocations" );
+   Con::printSeparator();
+
+   U32 totalLive = 0;
+   U32 totalPeak = 0;
+   U32 totalReserved = 0;
+   U32 totalBlocks = 0;
+   U32 totalAllocations = 0;
+
+   for ( U32 tag = 0; tag < TagCount; ++tag )
+   {
+      const TagStats& stats = smStats[tag];
+      const U32 reserved = pBackend->getReservedBytes( tag );
+
+      Con::printf( "%-12s %-12.1f %-12.1f %-12.1f %-12d %-12d", sgTagNames[tag],
+         stats.mLiveBytes / 1024.0f, stats.mPeakBytes / 1024.0f, reserved / 1024.0f,
+         stats.mLiveBlocks, stats.mAllocations );
+
+      totalLive += stats.mLiveBytes;
+      totalPeak += stats.mPeakBytes;
+      totalReserved += reserved;
+      totalBlocks += stats.mLiveBlocks;
+      totalAllocations += stats.mAllocations;
+   }
+
+   Con::printSeparator();
+
+   // The total peak is the sum of the peaks of each tag which may not have occurred together.
+   Con::printf( "%-12s %-12.1f %-12.1f %-12.1f %-12d %-12d", "Total",
+      totalLive / 1024.0f, totalPeak / 1024.0f, totalReserved / 1024.0f,
+      totalBlocks, totalAllocations );
+
+   Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( dumpMemoryStats, void, 1, 1,   "() Prints the live, peak and reserved memory of each engine subsystem.\n"
+                                                "@return No return value.")
+{
+   MemoryAllocator::dumpStats();
+}
@@ -0,0 +1,154 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _MEMORY_ALLOCATOR_H_
+#define _MEMORY_ALLOCATOR_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// Storage behind the MemoryAllocator.
+///
+/// A backend only hands out raw blocks.  The allocator adds its own block
+/// header and keeps the statistics so a backend never needs to remember the
+/// size or tag of a block; both are passed back in on reallocation and free.
+class MemoryBackend
+{
+public:
+   virtual ~MemoryBackend() {}
+
+   virtual const char* getName( void ) const = 0;
+
+   /// @param arena The tag the block is accounted to.  Backends may use it to keep subsystems apart.
+   virtual void* allocate( const dsize_t size, const U32 arena ) = 0;
+   virtual void* reallocate( void* pBlock, const dsize_t oldSize, const dsize_t newSize, const U32 arena ) = 0;
+   virtual void free( void* pBlock, const dsize_t size, const U32 arena ) = 0;
+
+   /// The bytes the backend holds for an arena including free blocks.
+   virtual U32 getReservedBytes( const U32 arena ) const { return 0; }
+};
+
+//-----------------------------------------------------------------------------
+
+/// The engine heap used by dMalloc(), dRealloc(), dFree() and Box2D.
+///
+/// Every block is accounted to a subsystem tag.  dMalloc() uses the tag
+/// of the calling thread which is set with a MemoryTagScope at the entry
+/// points of the console, sim, scene, particle and texture code.  A block
+/// keeps the tag it was allocated with for its whole life so it can be
+/// reallocated or freed from anywhere.
+///
+/// The backend is chosen at build time.  By default a small block allocator
+/// with an arena per tag and thread local caches is used.  Defining
+/// TORQUE_SYSTEM_ALLOCATOR routes everything through malloc() instead.
+class MemoryAllocator
+{
+public:
+   enum Tag
+   {
+      GeneralTag,
+      ConsoleTag,
+      SimTag,
+      SceneTag,
+      ParticlesTag,
+      TexturesTag,
+      Box2DTag,
+
+      TagCount
+   };
+
+   struct TagStats
+   {
+      volatile U32 mLiveBytes;
+      volatile U32 mPeakBytes;
+      volatile U32 mLiveBlocks;
+      volatile U32 mAllocations;
+   };
+
+   /// Blocks are aligned to this many bytes.
+   enum { Alignment = 16 };
+
+   static void* allocate( const dsize_t size, const Tag tag );
+   static inline void* allocate( const dsize_t size )  { return allocate( size, getCurrentTag() ); }
+
+   /// Resizes a block keeping its tag.  A NULL block is allocated with the current tag.
+   static void* reallocate( void* pMemory, const dsize_t size );
+
+   static void free( void* pMemory );
+
+   static dsize_t getSize( const void* pMemory );
+   static Tag getTag( const void* pMemory );
+
+   /// The tag used by allocate() for the calling thread.
+   static Tag getCurrentTag( void );
+   static void setCurrentTag( const Tag tag );
+
+   static const TagStats& getStats( const Tag tag )    { return smStats[tag]; }
+
+   /// Lowers the peak of a tag to its live bytes so the peak of a following operation can be measured.
+   static void resetPeak( const Tag tag );
+   static const char* getTagName( const Tag tag );
+   static MemoryBackend* getBackend( void );
+
+   /// Prints the statistics of every tag to the console.
+   static void dumpStats( void );
+
+private:
+   struct BlockHeader
+   {
+      U32 mSize;
+      U32 mTag;
+      U32 mReserved[2];
+   };
+
+   static inline BlockHeader* getHeader( const void* pMemory ) { return (BlockHeader*)pMemory - 1; }
+
+   static void addStats( const Tag tag, const U32 size );
+   static void removeStats( const Tag tag, const U32 size );
+
+   static TagStats smStats[TagCount];
+};
+
+//-----------------------------------------------------------------------------
+
+/// Sets the allocation tag of the calling thread for the lifetime of the scope.
+class MemoryTagScope
+{
+public:
+   explicit MemoryTagScope( const MemoryAllocator::Tag tag ) : mPrevious( MemoryAllocator::getCurrentTag() )
+   {
+      MemoryAllocator::setCurrentTag( tag );
+   }
+
+   ~MemoryTagScope()
+   {
+      MemoryAllocator::setCurrentTag( mPrevious );
+   }
+
+private:
+   MemoryAllocator::Tag mPrevious;
+};
+
+#endif // _MEMORY_ALLOCATOR_H_
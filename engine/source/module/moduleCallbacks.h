@@ -34,6 +34,10 @@ class ModuleCallbacks
     friend class ModuleManager;
 
 private:
+    // Called for each module about to be loaded, before any of them are, so work that does not
+    // depend on other modules having loaded, such as reading files, can be started on the thread pool.
+    virtual void onModulePrefetch( ModuleDefinition* pModuleDefinition ) {}
+
     // Called when a module is about to be loaded.
     virtual void onModulePreLoad( ModuleDefinition* pModuleDefinition ) {}
 
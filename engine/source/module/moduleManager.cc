@@ -38,6 +38,10 @@
 #include "console/consoleTypes.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
 // Script bindings.
 #include "moduleManager_ScriptBinding.h"
 
@@ -67,6 +71,42 @@ S32 QSORT_CALLBACK moduleDefinitionVersionIdSort( const void* a, const void* b )
 
 //-----------------------------------------------------------------------------
 
+/// The files found in a directory scanned for module definitions.
+struct ModuleDirectoryScan
+{
+    StringTableEntry            mPath;
+    Vector<Platform::FileInfo>  mFiles;
+    bool                        mScanned;
+    bool                        mComplete;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Lists the files of a directory on the thread pool.
+class ModuleDirectoryScanWorkItem : public ThreadPool::WorkItem
+{
+public:
+    ModuleDirectoryScanWorkItem( ModuleDirectoryScan* pDirectoryScan ) :
+        mpDirectoryScan( pDirectoryScan )
+    {
+    }
+
+    virtual void execute( void )
+    {
+        mpDirectoryScan->mScanned = Platform::dumpPath( mpDirectoryScan->mPath, mpDirectoryScan->mFiles, 0 );
+    }
+
+    virtual void onCompleted( void )
+    {
+        mpDirectoryScan->mComplete = true;
+    }
+
+private:
+    ModuleDirectoryScan* mpDirectoryScan;
+};
+
+//-----------------------------------------------------------------------------
+
 ModuleManager::ModuleManager() :
     mEnforceDependencies(true),
     mEchoInfo(true),
@@ -193,29 +233,55 @@ bool ModuleManager::scanModules( const char* pPath, const bool rootOnly )
     // Fetch extension length.
     const U32 extensionLength = dStrlen( mModuleExtension );
 
-    Vector<Platform::FileInfo> files;
+    // Fetch the number of directories to process, which is just the root if we're only processing the root.
+    const S32 directoryCount = rootOnly ? getMin( directories.size(), 1 ) : directories.size();
+
+    // Fetch the thread pool if there are workers to list the directories on.
+    ThreadPool* pThreadPool = ThreadPool::getGlobal();
+    if ( pThreadPool != NULL && ( pThreadPool->getWorkerCount() == 0 || directoryCount < 2 ) )
+        pThreadPool = NULL;
+
+    // Queue the directory listings.  Modules are registered from each listing as it arrives.
+    Vector<ModuleDirectoryScan*> directoryScans;
+    for ( S32 index = 0; index < directoryCount; ++index )
+    {
+        ModuleDirectoryScan* pDirectoryScan = new ModuleDirectoryScan();
+        pDirectoryScan->mPath = directories[index];
+        pDirectoryScan->mScanned = false;
+        pDirectoryScan->mComplete = pThreadPool == NULL;
+        directoryScans.push_back( pDirectoryScan );
+
+        if ( pThreadPool != NULL )
+            pThreadPool->queueWorkItem( new ModuleDirectoryScanWorkItem( pDirectoryScan ) );
+    }
+
+    bool scanned = true;
 
     // Iterate directories.
-    for( Vector<StringTableEntry>::iterator basePathItr = directories.begin(); basePathItr != directories.end(); ++basePathItr )
+    for( Vector<ModuleDirectoryScan*>::iterator directoryScanItr = directoryScans.begin(); directoryScanItr != directoryScans.end(); ++directoryScanItr )
     {
-        // Fetch base path.
-        StringTableEntry basePath = *basePathItr;
+        // Fetch directory scan.
+        ModuleDirectoryScan* pDirectoryScan = *directoryScanItr;
 
-        // Skip if we're only processing the root and this is not the root.
-        if ( rootOnly && basePathItr != directories.begin() )
-            continue;
+        // Fetch base path.
+        StringTableEntry basePath = pDirectoryScan->mPath;
 
         // Find files.
-        files.clear();
-        if ( !Platform::dumpPath( basePath, files, 0 ) )
+        if ( pThreadPool != NULL )
+            pThreadPool->waitUntil( pDirectoryScan->mComplete );
+        else
+            pDirectoryScan->mScanned = Platform::dumpPath( basePath, pDirectoryScan->mFiles, 0 );
+
+        if ( !pDirectoryScan->mScanned )
         {
             // Failed so warn.
             Con::warnf( "Module Manager: Failed to scan modules files in directory '%s'.", basePath );
-            return false;
+            scanned = false;
+            break;
         }
 
         // Iterate files.
-        for ( Vector<Platform::FileInfo>::iterator fileItr = files.begin(); fileItr != files.end(); ++fileItr )
+        for ( Vector<Platform::FileInfo>::iterator fileItr = pDirectoryScan->mFiles.begin(); fileItr != pDirectoryScan->mFiles.end(); ++fileItr )
         {
             // Fetch file info.
             Platform::FileInfo* pFileInfo = fileItr;
@@ -237,12 +303,21 @@ bool ModuleManager::scanModules( const char* pPath, const bool rootOnly )
             // Register module.
             registerModule( basePath, pFileInfo->pFileName );
         }
+    }
 
-        // Stop processing if we're only processing the root.
-        if ( rootOnly )
-            break;
+    // Delete the directory scans once any still being listed are complete.
+    for( Vector<ModuleDirectoryScan*>::iterator directoryScanItr = directoryScans.begin(); directoryScanItr != directoryScans.end(); ++directoryScanItr )
+    {
+        if ( pThreadPool != NULL )
+            pThreadPool->waitUntil( (*directoryScanItr)->mComplete );
+
+        delete *directoryScanItr;
     }
 
+    // Finish if a directory could not be scanned.
+    if ( !scanned )
+        return false;
+
     // Info.
     if ( mEchoInfo )
     {
@@ -355,9 +430,16 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
     // Add module group.
     mGroupsLoaded.push_back( moduleGroup );
 
+    // Start the work that does not depend on other modules so it overlaps the loading below.
+    prefetchModules( moduleReadyQueue );
+
     // Reset modules loaded count.
     U32 modulesLoadedCount = 0;
 
+    // Reset module load times.
+    typeModuleLoadTimeVector moduleLoadTimes;
+    const U32 loadStartTime = Platform::getRealMilliseconds();
+
     // Iterate the modules, executing their script files and call their create function.
     for ( typeModuleLoadEntryVector::iterator moduleReadyItr = moduleReadyQueue.begin(); moduleReadyItr != moduleReadyQueue.end(); ++moduleReadyItr )
     {
@@ -413,9 +495,17 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
         // Bump modules loaded count.
         modulesLoadedCount++;
 
+        // Time the module load.
+        ModuleLoadTime moduleLoadTime;
+        moduleLoadTime.mpModuleDefinition = pLoadReadyModuleDefinition;
+        U32 phaseStartTime = Platform::getRealMilliseconds();
+
         // Raise notifications.
         raiseModulePreLoadNotifications( pLoadReadyModuleDefinition );
 
+        moduleLoadTime.mPreLoadTime = Platform::getRealMilliseconds() - phaseStartTime;
+        phaseStartTime += moduleLoadTime.mPreLoadTime;
+
         // Do we have a script file-path specified?
         if ( pLoadReadyModuleDefinition->getModuleScriptFilePath() != StringTable->EmptyString )
         {
@@ -440,13 +530,20 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
             }
         }
 
+        moduleLoadTime.mScriptTime = Platform::getRealMilliseconds() - phaseStartTime;
+        phaseStartTime += moduleLoadTime.mScriptTime;
+
         // Raise notifications.
         raiseModulePostLoadNotifications( pLoadReadyModuleDefinition );
+
+        moduleLoadTime.mPostLoadTime = Platform::getRealMilliseconds() - phaseStartTime;
+        moduleLoadTimes.push_back( moduleLoadTime );
     }
 
     // Info.
     if ( mEchoInfo )
     {
+        echoModuleLoadTimes( moduleLoadTimes, Platform::getRealMilliseconds() - loadStartTime );
         Con::printSeparator();
         Con::printf( "Module Manager: Finish loading '%d' module(s) for group '%s'.", modulesLoadedCount, moduleGroup );
         Con::printSeparator();
@@ -718,9 +815,16 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
         }
     }
 
+    // Start the work that does not depend on other modules so it overlaps the loading below.
+    prefetchModules( moduleReadyQueue );
+
     // Reset modules loaded count.
     U32 modulesLoadedCount = 0;
 
+    // Reset module load times.
+    typeModuleLoadTimeVector moduleLoadTimes;
+    const U32 loadStartTime = Platform::getRealMilliseconds();
+
     // Iterate the modules, executing their script files and call their create function.
     for ( typeModuleLoadEntryVector::iterator moduleReadyItr = moduleReadyQueue.begin(); moduleReadyItr != moduleReadyQueue.end(); ++moduleReadyItr )
     {
@@ -776,9 +880,17 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
         // Bump modules loaded count.
         modulesLoadedCount++;
 
+        // Time the module load.
+        ModuleLoadTime moduleLoadTime;
+        moduleLoadTime.mpModuleDefinition = pLoadReadyModuleDefinition;
+        U32 phaseStartTime = Platform::getRealMilliseconds();
+
         // Raise notifications.
         raiseModulePreLoadNotifications( pLoadReadyModuleDefinition );
 
+        moduleLoadTime.mPreLoadTime = Platform::getRealMilliseconds() - phaseStartTime;
+        phaseStartTime += moduleLoadTime.mPreLoadTime;
+
         // Do we have a script file-path specified?
         if ( pLoadReadyModuleDefinition->getModuleScriptFilePath() != StringTable->EmptyString )
         {
@@ -803,13 +915,20 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
             }
         }
 
+        moduleLoadTime.mScriptTime = Platform::getRealMilliseconds() - phaseStartTime;
+        phaseStartTime += moduleLoadTime.mScriptTime;
+
         // Raise notifications.
         raiseModulePostLoadNotifications( pLoadReadyModuleDefinition );
+
+        moduleLoadTime.mPostLoadTime = Platform::getRealMilliseconds() - phaseStartTime;
+        moduleLoadTimes.push_back( moduleLoadTime );
     }
 
     // Info.
     if ( mEchoInfo )
     {
+        echoModuleLoadTimes( moduleLoadTimes, Platform::getRealMilliseconds() - loadStartTime );
         Con::printSeparator();
         Con::printf( "Module Manager: Finish loading '%d' explicit module(s).", modulesLoadedCount );
         Con::printSeparator();
@@ -2159,6 +2278,68 @@ bool ModuleManager::unregisterModule( const char* pModuleId, const U32 versionId
 
 //-----------------------------------------------------------------------------
 
+void ModuleManager::prefetchModules( typeModuleLoadEntryVector& moduleReadyQueue )
+{
+    // Iterate the modules in the order they will load so the earliest needed work is queued first.
+    for ( typeModuleLoadEntryVector::iterator moduleReadyItr = moduleReadyQueue.begin(); moduleReadyItr != moduleReadyQueue.end(); ++moduleReadyItr )
+    {
+        // Fetch load ready module definition.
+        ModuleDefinition* pLoadReadyModuleDefinition = moduleReadyItr->mpModuleDefinition;
+
+        // Skip if the module is already loaded.
+        if ( findModuleLoaded( pLoadReadyModuleDefinition->getModuleId() ) != NULL )
+            continue;
+
+        // Raise notifications.
+        raiseModulePrefetchNotifications( pLoadReadyModuleDefinition );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ModuleManager::echoModuleLoadTimes( const typeModuleLoadTimeVector& moduleLoadTimes, const U32 totalTime )
+{
+    // Finish if no modules were loaded.
+    if ( moduleLoadTimes.size() == 0 )
+        return;
+
+    // Info.
+    Con::printSeparator();
+    Con::printf( "Module Manager: Loaded '%d' module(s) in %dms:", moduleLoadTimes.size(), totalTime );
+
+    // Iterate the module load times.
+    for ( typeModuleLoadTimeVector::const_iterator loadTimeItr = moduleLoadTimes.begin(); loadTimeItr != moduleLoadTimes.end(); ++loadTimeItr )
+    {
+        // Fetch the module definition.
+        const ModuleDefinition* pModuleDefinition = loadTimeItr->mpModuleDefinition;
+
+        // Info.
+        Con::printf( "> module Id '%s' at version Id '%d' in %dms (pre-load %dms, script %dms, post-load %dms).",
+            pModuleDefinition->getModuleId(), pModuleDefinition->getVersionId(),
+            loadTimeItr->mPreLoadTime + loadTimeItr->mScriptTime + loadTimeItr->mPostLoadTime,
+            loadTimeItr->mPreLoadTime, loadTimeItr->mScriptTime, loadTimeItr->mPostLoadTime );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ModuleManager::raiseModulePrefetchNotifications( ModuleDefinition* pModuleDefinition )
+{
+    // Raise notifications.
+    for( SimSet::iterator notifyItr = mNotificationListeners.begin(); notifyItr != mNotificationListeners.end(); ++notifyItr )
+    {
+        // Fetch listener object.
+        SimObject* pListener = *notifyItr;
+
+        // Perform object callback.
+        ModuleCallbacks* pCallbacks = dynamic_cast<ModuleCallbacks*>( pListener );
+        if ( pCallbacks != NULL )
+            pCallbacks->onModulePrefetch( pModuleDefinition );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void ModuleManager::raiseModulePreLoadNotifications( ModuleDefinition* pModuleDefinition )
 {
     // Raise notifications.
@@ -96,6 +96,16 @@ private:
         bool                mStrictVersionId;
     };
 
+    /// Module load timing in milliseconds.
+    struct ModuleLoadTime
+    {
+        ModuleDefinition*   mpModuleDefinition;
+        U32                 mPreLoadTime;
+        U32                 mScriptTime;
+        U32                 mPostLoadTime;
+    };
+    typedef Vector<ModuleLoadTime> typeModuleLoadTimeVector;
+
     /// Module loading.
     typedef Vector<StringTableEntry> typeModuleIdVector;
     typedef Vector<StringTableEntry> typeGroupVector;
@@ -185,6 +195,10 @@ private:
     bool removeModuleDefinition( ModuleDefinition* pModuleDefinition );
     bool registerModule( const char* pModulePath, const char* pModuleFile );
 
+    void prefetchModules( typeModuleLoadEntryVector& moduleReadyQueue );
+    void echoModuleLoadTimes( const typeModuleLoadTimeVector& moduleLoadTimes, const U32 totalTime );
+
+    void raiseModulePrefetchNotifications( ModuleDefinition* pModuleDefinition );
     void raiseModulePreLoadNotifications( ModuleDefinition* pModuleDefinition );
     void raiseModulePostLoadNotifications( ModuleDefinition* pModuleDefinition );
     void raiseModulePreUnloadNotifications( ModuleDefinition* pModuleDefinition );
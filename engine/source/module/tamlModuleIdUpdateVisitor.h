@@ -40,13 +40,17 @@
 class TamlModuleIdUpdateVisitor : public TamlXmlVisitor
 {
 protected:
-    virtual bool visit( TiXmlElement* pXmlElement, TamlXmlParser& xmlParser )
+    virtual bool visit( TamlXmlElement* pXmlElement, TamlXmlParser& xmlParser )
     {
         // Iterate attributes.
-        for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
+        const U32 attributeCount = pXmlElement->getAttributeCount();
+        for ( U32 attributeIndex = 0; attributeIndex < attributeCount; ++attributeIndex )
         {
+            // Fetch attribute.
+            TamlXmlAttribute* pAttribute = &pXmlElement->getAttribute( attributeIndex );
+
             // Fetch attribute value.
-            const char* pAttributeValue = pAttribute->Value();
+            const char* pAttributeValue = pAttribute->getValue();
 
             // Fetch value length.
             const U32 valueLenth = dStrlen(pAttributeValue);
@@ -68,7 +72,7 @@ protected:
                         mModuleIdTo, pAttributeValue+1+mModuleIdLengthFrom );
 
                     // Assign new value.
-                    pAttribute->SetValue( newAttributeValueBuffer );
+                    pAttribute->setValue( newAttributeValueBuffer );
                 }
 
                 // Skip to next attribute.
@@ -83,14 +87,14 @@ protected:
                     mModuleIdTo, pAttributeValue+mModuleIdLengthFrom );
 
                 // Assign new value.
-                pAttribute->SetValue( newAttributeValueBuffer );
+                pAttribute->setValue( newAttributeValueBuffer );
             }
         }
 
         return true;
     }
 
-    virtual bool visit( TiXmlAttribute* pAttribute, TamlXmlParser& xmlParser ) { return true; }
+    virtual bool visit( TamlXmlAttribute* pAttribute, TamlXmlParser& xmlParser ) { return true; }
 
 public:
     TamlModuleIdUpdateVisitor() :
@@ -42,6 +42,10 @@
 #include "memory/frameAllocator.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
 #ifndef _CONSOLETYPES_H_
 #include "console/consoleTypes.h"
 #endif
@@ -139,7 +143,7 @@ const char* Taml::getFormatModeDescription(const Taml::TamlFormatMode formatMode
 // The string-table-entries are set to string literals below because Taml is used in a static scope and the string-table cannot currently be used like that.
 Taml::Taml() :
     mFormatMode(XmlFormat),
-    mBinaryCompression(true),
+    mBinaryCompression(false),
     mWriteDefaults(false),
     mProgenitorUpdate(true),    
     mAutoFormat(true),
@@ -158,7 +162,7 @@ void Taml::initPersistFields()
     Parent::initPersistFields();
 
     addField("Format", TypeEnum, Offset(mFormatMode, Taml), 1, &tamlFormatModeTable, "The read/write format that should be used.");
-    addField("BinaryCompression", TypeBool, Offset(mBinaryCompression, Taml), "Whether ZIP compression is used on binary formatting or not.\n");
+    addField("BinaryCompression", TypeBool, Offset(mBinaryCompression, Taml), "Whether ZIP compression is used on binary formatting or not.  Off by default as an uncompressed image is read in a single block without inflating it.\n");
     addField("WriteDefaults", TypeBool, Offset(mWriteDefaults, Taml), "Whether to write static fields that are at their default or not.\n");
     addField("ProgenitorUpdate", TypeBool, Offset(mProgenitorUpdate, Taml), "Whether to update each type instances file-progenitor or not.\n");
     addField("AutoFormat", TypeBool, Offset(mAutoFormat, Taml), "Whether the format type is automatically determined by the filename extension or not.\n");
@@ -210,6 +214,140 @@ bool Taml::write( SimObject* pSimObject, const char* pFilename )
 
 //-----------------------------------------------------------------------------
 
+/// Writes compiled nodes to a file on the thread pool.
+/// The nodes are a snapshot so the objects they came from can change or be deleted during the write.
+class TamlAsyncWriteWorkItem : public ThreadPool::WorkItem
+{
+public:
+    TamlAsyncWriteWorkItem( Taml* pTaml, const char* pFilePath, const Taml::TamlFormatMode formatMode, const bool compressed, const TamlWriteNode* pRootNode, const Vector<TamlWriteNode*>& compiledNodes ) :
+        mTaml( pTaml ),
+        mFormatMode( formatMode ),
+        mBinaryCompression( compressed ),
+        mpRootNode( pRootNode ),
+        mCompiledNodes( compiledNodes ),
+        mXmlWriter( pTaml ),
+        mBinaryWriter( pTaml ),
+        mExecuted( false ),
+        mStatus( false )
+    {
+        dStrcpy( mFilePathBuffer, pFilePath );
+    }
+
+    virtual ~TamlAsyncWriteWorkItem()
+    {
+        // Write now if the pool was shut down before the write was executed.
+        if ( !mExecuted )
+            execute();
+
+        // Delete the compiled nodes.
+        for( Vector<TamlWriteNode*>::iterator itr = mCompiledNodes.begin(); itr != mCompiledNodes.end(); ++itr )
+        {
+            (*itr)->resetNode();
+            delete (*itr);
+        }
+    }
+
+    virtual void execute( void )
+    {
+        mExecuted = true;
+
+        FileStream stream;
+
+        // Finish if the file could not be opened.
+        if ( !stream.open( mFilePathBuffer, FileStream::Write ) )
+            return;
+
+        // Write the nodes.
+        mStatus = mFormatMode == Taml::BinaryFormat ?
+            mBinaryWriter.write( stream, mpRootNode, mBinaryCompression ) :
+            mXmlWriter.write( stream, mpRootNode );
+
+        // Close file.
+        stream.close();
+    }
+
+    virtual void onCompleted( void )
+    {
+        // Did the write fail?
+        if ( !mStatus )
+        {
+            // Yes, so warn.
+            Con::warnf( "Taml::writeAsync() - Failed to write to filename '%s'.", mFilePathBuffer );
+        }
+
+        // Is the Taml object still around?
+        if ( !mTaml.isNull() && mTaml->isProperlyAdded() )
+        {
+            // Yes, so notify it.
+            Con::executef( mTaml, 3, "onWriteCompleted", mFilePathBuffer, mStatus ? "1" : "0" );
+        }
+    }
+
+private:
+    SimObjectPtr<Taml>      mTaml;
+    Taml::TamlFormatMode    mFormatMode;
+    bool                    mBinaryCompression;
+    const TamlWriteNode*    mpRootNode;
+    Vector<TamlWriteNode*>  mCompiledNodes;
+    TamlXmlWriter           mXmlWriter;
+    TamlBinaryWriter        mBinaryWriter;
+    char                    mFilePathBuffer[1024];
+    bool                    mExecuted;
+    bool                    mStatus;
+};
+
+//-----------------------------------------------------------------------------
+
+bool Taml::writeAsync( SimObject* pSimObject, const char* pFilename )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Taml_WriteAsync);
+
+    // Sanity!
+    AssertFatal( pSimObject != NULL, "Cannot write a NULL object." );
+    AssertFatal( pFilename != NULL, "Cannot write to a NULL filename." );
+
+    // Fetch the thread pool.
+    ThreadPool* pThreadPool = ThreadPool::getGlobal();
+
+    // Write immediately if there is no thread pool.
+    if ( pThreadPool == NULL )
+        return write( pSimObject, pFilename );
+
+    // Expand the file-name into the file-path buffer.
+    Con::expandPath( mFilePathBuffer, sizeof(mFilePathBuffer), pFilename );
+
+    // Get the file auto-format mode.
+    TamlFormatMode formatMode = getFileAutoFormatMode( mFilePathBuffer );
+
+    // Finish if the format is invalid.
+    if ( formatMode != XmlFormat && formatMode != BinaryFormat )
+    {
+        // Warn.
+        Con::warnf("Taml::writeAsync() - Cannot write, invalid format.");
+        return false;
+    }
+
+    // Reset the compilation.
+    resetCompilation();
+
+    // Compile nodes.
+    // NOTE: Compiling reads the object state so it must happen here and not on the worker.
+    TamlWriteNode* pRootNode = compileObject( pSimObject );
+
+    // Queue the write.
+    // NOTE: The work item takes ownership of the compiled nodes.
+    pThreadPool->queueWorkItem( new TamlAsyncWriteWorkItem( this, mFilePathBuffer, formatMode, mBinaryCompression, pRootNode, mCompiledNodes ) );
+    mCompiledNodes.clear();
+
+    // Reset the compilation.
+    resetCompilation();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
 SimObject* Taml::read( const char* pFilename )
 {
     // Debug Profiling.
@@ -232,12 +370,19 @@ SimObject* Taml::read( const char* pFilename )
     }
 
     // Get the file auto-format mode.
-    const TamlFormatMode formatMode = getFileAutoFormatMode( mFilePathBuffer );
+    TamlFormatMode formatMode = getFileAutoFormatMode( mFilePathBuffer );
+
+    // Is auto-format active?
+    if ( mAutoFormat )
+    {
+        // Yes, so the file content takes precedence over the extension.
+        formatMode = getStreamAutoFormatMode( stream, formatMode );
+    }
 
     // Reset the compilation.
     resetCompilation();
 
-    // Write object.
+    // Read object.
     SimObject* pSimObject = read( stream, formatMode );
 
     // Close file.
@@ -395,7 +540,7 @@ Taml::TamlFormatMode Taml::getFileAutoFormatMode( const char* pFilename )
             return Taml::XmlFormat;
 
         // Check for the Binary format.
-        if ( binaryExtensionLength <= filenameLength && dStricmp( pEndOfFilename - xmlExtensionLength, mAutoFormatBinaryExtension ) == 0 )
+        if ( binaryExtensionLength <= filenameLength && dStricmp( pEndOfFilename - binaryExtensionLength, mAutoFormatBinaryExtension ) == 0 )
             return Taml::BinaryFormat;  
     }
 
@@ -405,6 +550,51 @@ Taml::TamlFormatMode Taml::getFileAutoFormatMode( const char* pFilename )
 
 //-----------------------------------------------------------------------------
 
+Taml::TamlFormatMode Taml::getStreamAutoFormatMode( FileStream& stream, const TamlFormatMode formatMode )
+{
+    // Fetch the stream position.
+    const U32 streamPosition = stream.getPosition();
+
+    // Read the start of the stream.
+    // NOTE: The binary format starts with the length-prefixed signature.
+    const U32 signatureLength = sizeof(TAML_SIGNATURE) - 1;
+    U8 streamStart[signatureLength + 1];
+    const bool streamStartRead = stream.read( sizeof(streamStart), streamStart );
+
+    // Restore the stream position.
+    stream.setPosition( streamPosition );
+
+    // Finish if the stream is too short to identify.
+    if ( !streamStartRead )
+        return formatMode;
+
+    // Check for the Binary format.
+    if ( streamStart[0] == signatureLength && dMemcmp( streamStart + 1, TAML_SIGNATURE, signatureLength ) == 0 )
+        return Taml::BinaryFormat;
+
+    // Skip any UTF-8 byte-order-mark.
+    const U32 startIndex = streamStart[0] == 0xEF && streamStart[1] == 0xBB && streamStart[2] == 0xBF ? 3 : 0;
+
+    // Check for the XML format.
+    for ( U32 index = startIndex; index < sizeof(streamStart); ++index )
+    {
+        // Skip any whitespace.
+        if ( dIsspace( streamStart[index] ) )
+            continue;
+
+        // Is this an element or declaration?
+        if ( streamStart[index] == '<' )
+            return Taml::XmlFormat;
+
+        break;
+    }
+
+    // Use the specified format mode.
+    return formatMode;
+}
+
+//-----------------------------------------------------------------------------
+
 TamlWriteNode* Taml::compileObject( SimObject* pSimObject, const bool forceId )
 {
     // Debug Profiling.
@@ -614,28 +804,27 @@ void Taml::compileDynamicFields( TamlWriteNode* pTamlWriteNode )
     Vector<SimFieldDictionary::Entry*> dynamicFieldList(__FILE__, __LINE__);
 
     // Ensure the dynamic field doesn't conflict with static field.
-    for( U32 hashIndex = 0; hashIndex < SimFieldDictionary::HashTableSize; ++hashIndex )
+    for( SimFieldDictionaryIterator itr( pFieldDictionary ); *itr; ++itr )
     {
-        for( SimFieldDictionary::Entry* pEntry = pFieldDictionary->mHashTable[hashIndex]; pEntry; pEntry = pEntry->next )
+        SimFieldDictionary::Entry* pEntry = *itr;
+
+        // Iterate static fields.
+        U32 fieldIndex;
+        for( fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex )
         {
-            // Iterate static fields.
-            U32 fieldIndex;
-            for( fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex )
-            {
-                if( fieldList[fieldIndex].pFieldname == pEntry->slotName)
-                    break;
-            }
+            if( fieldList[fieldIndex].pFieldname == pEntry->slotName)
+                break;
+        }
 
-            // Skip if found.
-            if( fieldIndex != (U32)fieldList.size() )
-                continue;
+        // Skip if found.
+        if( fieldIndex != (U32)fieldList.size() )
+            continue;
 
-            // Skip if not writing field.
-            if ( !pSimObject->writeField( pEntry->slotName, pEntry->value) )
-                continue;
+        // Skip if not writing field.
+        if ( !pSimObject->writeField( pEntry->slotName, pEntry->value) )
+            continue;
 
-            dynamicFieldList.push_back( pEntry );
-        }
+        dynamicFieldList.push_back( pEntry );
     }
 
     // Sort Entries to prevent version control conflicts
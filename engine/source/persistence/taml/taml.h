@@ -61,6 +61,8 @@ extern StringTableEntry tamlNamedObjectName;
 
 #define TAML_SIGNATURE                  "Taml"
 #define TAML_SCHEMA_VARIABLE            "$pref::T2D::TAMLSchema"
+#define TAML_BINARY_TABLES_VERSION      3
+#define TAML_BINARY_NO_INDEX            U32_MAX
 
 //-----------------------------------------------------------------------------
 
@@ -173,11 +175,20 @@ public:
 
     TamlFormatMode getFileAutoFormatMode( const char* pFilename );
 
+    /// Identifies the format from the start of the stream, leaving the stream position unchanged.
+    /// @return The detected format or the specified format if the stream is not recognized.
+    TamlFormatMode getStreamAutoFormatMode( FileStream& stream, const TamlFormatMode formatMode );
+
     const char* getFilePathBuffer( void ) const { return mFilePathBuffer; }
 
     /// Write.
     bool write( SimObject* pSimObject, const char* pFilename );
 
+    /// Write asynchronously.
+    /// The object state is compiled immediately and the file is written on the thread pool.
+    /// Once written, 'onWriteCompleted(filename, success)' is called on this object.
+    bool writeAsync( SimObject* pSimObject, const char* pFilename );
+
     /// Read.
     template<typename T> inline T* read( const char* pFilename )
     {
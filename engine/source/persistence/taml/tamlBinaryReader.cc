@@ -55,6 +55,21 @@ SimObject* TamlBinaryReader::read( FileStream& stream )
     bool compressed;
     stream.read( &compressed );
 
+    // Is this the table revision?
+    if ( versionId >= TAML_BINARY_TABLES_VERSION )
+    {
+        // Yes, so is it a revision we know?
+        if ( versionId > TAML_BINARY_TABLES_VERSION )
+        {
+            // No, so warn.
+            Con::warnf("Taml: Cannot read binary file as version '%d' is not supported.", versionId );
+            return NULL;
+        }
+
+        // Read image.
+        return readImage( stream, compressed );
+    }
+
     SimObject* pSimObject = NULL;
 
     // Is the stream compressed?
@@ -426,4 +441,527 @@ void TamlBinaryReader::parseCustomNode( Stream& stream, TamlCustomNode* pCustomN
             pChildNode->addField( fieldName, valueBuffer );
         }
     }
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+
+SimObject* TamlBinaryReader::readImage( Stream& stream, const bool compressed )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ReadImage);
+
+    // Read image size.
+    stream.read( &mImageSize );
+
+    // Skip the image alignment.
+    while ( ( stream.getPosition() % sizeof(U32) ) != 0 )
+    {
+        U8 padding;
+        stream.read( &padding );
+    }
+
+    // Finish if the image cannot hold a header.
+    if ( mImageSize < 4 * sizeof(U32) )
+    {
+        // Warn.
+        Con::warnf("Taml: Cannot read binary file as the image is corrupt.");
+        return NULL;
+    }
+
+    // Allocate the image.
+    mImageWordCount = ( mImageSize + sizeof(U32) - 1 ) / sizeof(U32);
+    mpImageWords = new U32[mImageWordCount];
+    mpImageWords[mImageWordCount-1] = 0;
+
+    bool imageRead;
+
+    // Is the stream compressed?
+    if ( compressed )
+    {
+        // Yes, so attach zip stream.
+        ZipSubRStream zipStream;
+        zipStream.attachStream( &stream );
+        zipStream.setUncompressedSize( mImageSize );
+
+        // Read image.
+        imageRead = zipStream.read( mImageSize, mpImageWords );
+
+        // Detach zip stream.
+        zipStream.detachStream();
+    }
+    else
+    {
+        // No, so read image.
+        imageRead = stream.read( mImageSize, mpImageWords );
+    }
+
+    // Read header.
+    mStringCount = convertLEndianToHost( mpImageWords[0] );
+    const U32 stringOffsetsOffset = convertLEndianToHost( mpImageWords[1] );
+    mObjectCount = convertLEndianToHost( mpImageWords[2] );
+    const U32 objectOffsetsOffset = convertLEndianToHost( mpImageWords[3] );
+    mStringOffsetsIndex = stringOffsetsOffset / sizeof(U32);
+    mObjectOffsetsIndex = objectOffsetsOffset / sizeof(U32);
+
+    // Is the image valid?
+    // NOTE: The image must end with a terminator so that no string can run past it.
+    if (    !imageRead ||
+            mObjectCount == 0 ||
+            ( stringOffsetsOffset % sizeof(U32) ) != 0 ||
+            ( objectOffsetsOffset % sizeof(U32) ) != 0 ||
+            mStringCount > mImageWordCount || mStringOffsetsIndex > mImageWordCount - mStringCount ||
+            mObjectCount > mImageWordCount || mObjectOffsetsIndex > mImageWordCount - mObjectCount ||
+            ( mStringCount > 0 && ((const char*)mpImageWords)[mImageSize-1] != 0 ) )
+    {
+        // No, so warn.
+        Con::warnf("Taml: Cannot read binary file as the image is corrupt.");
+        resetImage();
+        return NULL;
+    }
+
+    // Reset the names and objects.
+    mImageNames.setSize( mStringCount );
+    dMemset( mImageNames.address(), 0, mStringCount * sizeof(StringTableEntry) );
+    mImageObjects.setSize( mObjectCount );
+    dMemset( mImageObjects.address(), 0, mObjectCount * sizeof(SimObject*) );
+
+    // Parse root element.
+    SimObject* pSimObject = parseImageElement( 0 );
+
+    // Is the image corrupt?
+    if ( mImageCorrupt )
+    {
+        // Yes, so warn.
+        Con::warnf("Taml: Binary file image is corrupt.");
+
+        // Discard the incomplete object.
+        if ( pSimObject != NULL )
+            pSimObject->deleteObject();
+
+        pSimObject = NULL;
+    }
+
+    // Reset image.
+    resetImage();
+
+    return pSimObject;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::resetImage( void )
+{
+    delete [] mpImageWords;
+    mpImageWords = NULL;
+    mImageSize = 0;
+    mImageWordCount = 0;
+    mStringCount = 0;
+    mObjectCount = 0;
+    mImageCorrupt = false;
+    mImageNames.clear();
+    mImageObjects.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+SimObject* TamlBinaryReader::parseImageElement( const U32 objectIndex )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseImageElement);
+
+    // Finish if the object index is invalid.
+    if ( objectIndex >= mObjectCount )
+    {
+        mImageCorrupt = true;
+        return NULL;
+    }
+
+    // Was the object already read?
+    if ( mImageObjects[objectIndex] != NULL )
+    {
+        // Yes, so this is a reference to it.
+        return mImageObjects[objectIndex];
+    }
+
+    // Fetch the object record.
+    const U32 recordOffset = convertLEndianToHost( mpImageWords[mObjectOffsetsIndex + objectIndex] );
+    if ( ( recordOffset % sizeof(U32) ) != 0 )
+    {
+        mImageCorrupt = true;
+        return NULL;
+    }
+    U32 wordIndex = recordOffset / sizeof(U32);
+
+#ifdef TORQUE_DEBUG
+    // Format the type location.
+    char typeLocationBuffer[64];
+    dSprintf( typeLocationBuffer, sizeof(typeLocationBuffer), "Taml [format='binary' object=%u]", objectIndex );
+#endif
+
+    // Fetch element name.
+    StringTableEntry typeName = getImageName( readImageWord( wordIndex ) );
+
+    // Fetch object name.
+    const U32 objectNameIndex = readImageWord( wordIndex );
+    StringTableEntry objectName = objectNameIndex == TAML_BINARY_NO_INDEX ? StringTable->EmptyString : getImageName( objectNameIndex );
+
+    // Finish if the record is corrupt.
+    if ( mImageCorrupt )
+        return NULL;
+
+    SimObject* pSimObject = NULL;
+
+#ifdef TORQUE_DEBUG
+    // Create type.
+    pSimObject = Taml::createType( typeName, mpTaml, typeLocationBuffer );
+#else
+    // Create type.
+    pSimObject = Taml::createType( typeName, mpTaml );
+#endif
+
+    // Finish if we couldn't create the type.
+    if ( pSimObject == NULL )
+        return NULL;
+
+    // Find Taml callbacks.
+    TamlCallbacks* pCallbacks = dynamic_cast<TamlCallbacks*>( pSimObject );
+
+    // Are there any Taml callbacks?
+    if ( pCallbacks != NULL )
+    {
+        // Yes, so call it.
+        mpTaml->tamlPreRead( pCallbacks );
+    }
+
+    // Parse attributes.
+    parseImageAttributes( wordIndex, pSimObject );
+
+    // Does the object require a name?
+    if ( objectName == StringTable->EmptyString )
+    {
+        // No, so just register anonymously.
+        pSimObject->registerObject();
+    }
+    else
+    {
+        // Yes, so register a named object.
+        pSimObject->registerObject( objectName );
+
+        // Was the name assigned?
+        if ( pSimObject->getName() != objectName )
+        {
+            // No, so warn that the name was rejected.
+#ifdef TORQUE_DEBUG
+            Con::warnf( "Taml::parseElement() - Registered an instance of type '%s' but a request to name it '%s' was rejected.  This is typically because an object of that name already exists.  '%s'", typeName, objectName, typeLocationBuffer );
+#else
+            Con::warnf( "Taml::parseElement() - Registered an instance of type '%s' but a request to name it '%s' was rejected.  This is typically because an object of that name already exists.", typeName, objectName );
+#endif
+        }
+    }
+
+    // Store the object so that references to it can find it.
+    mImageObjects[objectIndex] = pSimObject;
+
+    // Parse children.
+    parseImageChildren( wordIndex, pSimObject );
+
+    // Parse custom elements.
+    TamlCustomNodes customProperties;
+    parseImageCustomElements( wordIndex, pCallbacks, customProperties );
+
+    // Are there any Taml callbacks?
+    if ( pCallbacks != NULL )
+    {
+        // Yes, so call it.
+        mpTaml->tamlPostRead( pCallbacks, customProperties );
+    }
+
+    // Return object.
+    return pSimObject;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseImageAttributes( U32& wordIndex, SimObject* pSimObject )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseImageAttributes);
+
+    // Sanity!
+    AssertFatal( pSimObject != NULL, "Taml: Cannot parse attributes on a NULL object." );
+
+    // Fetch attribute count.
+    const U32 attributeCount = readImageWord( wordIndex );
+
+    // Iterate attributes.
+    for ( U32 index = 0; index < attributeCount && !mImageCorrupt; ++index )
+    {
+        // Fetch attribute.
+        StringTableEntry attributeName = getImageName( readImageWord( wordIndex ) );
+        const char* pAttributeValue = getImageString( readImageWord( wordIndex ) );
+
+        // Skip if the attribute is corrupt.
+        if ( attributeName == NULL || pAttributeValue == NULL )
+            continue;
+
+        // We can assume this is a field for now.
+        pSimObject->setPrefixedDataField( attributeName, NULL, pAttributeValue );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseImageChildren( U32& wordIndex, SimObject* pSimObject )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseImageChildren);
+
+    // Sanity!
+    AssertFatal( pSimObject != NULL, "Taml: Cannot parse children on a NULL object." );
+
+    // Fetch children count.
+    const U32 childrenCount = readImageWord( wordIndex );
+
+    // Finish if no children.
+    if ( childrenCount == 0 )
+        return;
+
+    // Fetch the Taml children.
+    TamlChildren* pChildren = dynamic_cast<TamlChildren*>( pSimObject );
+
+    // Is this a sim set?
+    if ( pChildren == NULL )
+    {
+        // No, so warn.
+        Con::warnf("Taml: Child element found under parent but object cannot have children." );
+
+        // Skip the children.
+        wordIndex += childrenCount;
+        return;
+    }
+
+    // Fetch any container child class specifier.
+    AbstractClassRep* pContainerChildClass = pSimObject->getClassRep()->getContainerChildClass( true );
+
+    // Iterate children.
+    for ( U32 index = 0; index < childrenCount && !mImageCorrupt; ++ index )
+    {
+        // Parse child element.
+        SimObject* pChildSimObject = parseImageElement( readImageWord( wordIndex ) );
+
+        // Skip if the child was not created.
+        if ( pChildSimObject == NULL )
+            continue;
+
+        // Do we have a container child class?
+        if ( pContainerChildClass != NULL )
+        {
+            // Yes, so is the child object the correctly derived type?
+            if ( !pChildSimObject->getClassRep()->isClass( pContainerChildClass ) )
+            {
+                // No, so warn.
+                Con::warnf("Taml: Child element '%s' found under parent '%s' but object is restricted to children of type '%s'.",
+                    pChildSimObject->getClassName(),
+                    pSimObject->getClassName(),
+                    pContainerChildClass->getClassName() );
+
+                // NOTE: We can't delete the object as it may be referenced elsewhere!
+                pChildSimObject = NULL;
+
+                // Skip.
+                continue;
+            }
+        }
+
+        // Add child.
+        pChildren->addTamlChild( pChildSimObject );
+
+        // Find Taml callbacks for child.
+        TamlCallbacks* pChildCallbacks = dynamic_cast<TamlCallbacks*>( pChildSimObject );
+
+        // Do we have callbacks on the child?
+        if ( pChildCallbacks != NULL )
+        {
+            // Yes, so perform callback.
+            mpTaml->tamlAddParent( pChildCallbacks, pSimObject );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseImageCustomElements( U32& wordIndex, TamlCallbacks* pCallbacks, TamlCustomNodes& customNodes )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseImageCustomElements);
+
+    // Read custom node count.
+    const U32 customNodeCount = readImageWord( wordIndex );
+
+    // Finish if no custom nodes.
+    if ( customNodeCount == 0 )
+        return;
+
+    // Iterate custom nodes.
+    for ( U32 nodeIndex = 0; nodeIndex < customNodeCount && !mImageCorrupt; ++nodeIndex )
+    {
+        // Read custom node name.
+        StringTableEntry nodeName = getImageName( readImageWord( wordIndex ) );
+
+        // Read child node count.
+        const U32 childNodeCount = readImageWord( wordIndex );
+
+        // Finish if the node is corrupt.
+        if ( nodeName == NULL )
+            return;
+
+        // Add custom node.
+        TamlCustomNode* pCustomNode = customNodes.addNode( nodeName );
+
+        // Parse the child nodes.
+        for ( U32 childIndex = 0; childIndex < childNodeCount && !mImageCorrupt; ++childIndex )
+        {
+            parseImageCustomNode( wordIndex, pCustomNode );
+        }
+    }
+
+    // Do we have callbacks?
+    if ( pCallbacks == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Taml: Encountered custom data but object does not support custom data." );
+        return;
+    }
+
+    // Custom read callback.
+    mpTaml->tamlCustomRead( pCallbacks, customNodes );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseImageCustomNode( U32& wordIndex, TamlCustomNode* pCustomNode )
+{
+    // Fetch any proxy object index.
+    const U32 proxyObjectIndex = readImageWord( wordIndex );
+
+    // Is this a proxy object?
+    if ( proxyObjectIndex != TAML_BINARY_NO_INDEX )
+    {
+        // Yes, so parse proxy object.
+        SimObject* pProxyObject = parseImageElement( proxyObjectIndex );
+
+        // Add child node.
+        pCustomNode->addNode( pProxyObject );
+
+        return;
+    }
+
+    // No, so read custom node name.
+    StringTableEntry nodeName = getImageName( readImageWord( wordIndex ) );
+
+    // Read custom node text.
+    const U32 nodeTextIndex = readImageWord( wordIndex );
+
+    // Finish if the node is corrupt.
+    if ( nodeName == NULL )
+        return;
+
+    // Add child node.
+    TamlCustomNode* pChildNode = pCustomNode->addNode( nodeName );
+
+    // Do we have any node text?
+    if ( nodeTextIndex != TAML_BINARY_NO_INDEX )
+    {
+        // Yes, so store it.
+        const char* pNodeText = getImageString( nodeTextIndex );
+        if ( pNodeText != NULL )
+            pChildNode->setNodeText( pNodeText );
+    }
+
+    // Read child field count.
+    const U32 childFieldCount = readImageWord( wordIndex );
+
+    // Parse child fields.
+    for( U32 childFieldIndex = 0; childFieldIndex < childFieldCount && !mImageCorrupt; ++childFieldIndex )
+    {
+        // Read field.
+        StringTableEntry fieldName = getImageName( readImageWord( wordIndex ) );
+        const char* pFieldValue = getImageString( readImageWord( wordIndex ) );
+
+        // Skip if the field is corrupt.
+        if ( fieldName == NULL || pFieldValue == NULL )
+            continue;
+
+        // Add field.
+        pChildNode->addField( fieldName, pFieldValue );
+    }
+
+    // Read child node count.
+    const U32 childNodeCount = readImageWord( wordIndex );
+
+    // Parse children nodes.
+    for( U32 childIndex = 0; childIndex < childNodeCount && !mImageCorrupt; ++childIndex )
+    {
+        // Parse child node.
+        parseImageCustomNode( wordIndex, pChildNode );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 TamlBinaryReader::readImageWord( U32& wordIndex )
+{
+    // Is the word past the end of the image?
+    if ( wordIndex >= mImageWordCount )
+    {
+        // Yes, so the image is corrupt.
+        mImageCorrupt = true;
+        return 0;
+    }
+
+    return convertLEndianToHost( mpImageWords[wordIndex++] );
+}
+
+//-----------------------------------------------------------------------------
+
+const char* TamlBinaryReader::getImageString( const U32 stringIndex )
+{
+    // Finish if the string index is invalid.
+    if ( stringIndex >= mStringCount )
+    {
+        mImageCorrupt = true;
+        return NULL;
+    }
+
+    // Fetch the string offset.
+    const U32 stringOffset = convertLEndianToHost( mpImageWords[mStringOffsetsIndex + stringIndex] );
+
+    // Finish if the string offset is invalid.
+    if ( stringOffset >= mImageSize )
+    {
+        mImageCorrupt = true;
+        return NULL;
+    }
+
+    // NOTE: The string is used directly from the image.
+    return (const char*)mpImageWords + stringOffset;
+}
+
+//-----------------------------------------------------------------------------
+
+StringTableEntry TamlBinaryReader::getImageName( const U32 stringIndex )
+{
+    // Fetch the string.
+    const char* pString = getImageString( stringIndex );
+
+    // Finish if the string is invalid.
+    if ( pString == NULL )
+        return NULL;
+
+    // Insert the name if it has not been already.
+    // NOTE: Each distinct name is only inserted into the string table once per file.
+    if ( mImageNames[stringIndex] == NULL )
+        mImageNames[stringIndex] = StringTable->insert( pString );
+
+    return mImageNames[stringIndex];
+}
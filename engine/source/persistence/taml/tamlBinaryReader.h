@@ -37,11 +37,19 @@ class TamlBinaryReader
 {
 public:
     TamlBinaryReader( Taml* pTaml ) :
-        mpTaml( pTaml )
+        mpTaml( pTaml ),
+        mpImageWords( NULL ),
+        mImageSize( 0 ),
+        mImageWordCount( 0 ),
+        mStringCount( 0 ),
+        mStringOffsetsIndex( 0 ),
+        mObjectCount( 0 ),
+        mObjectOffsetsIndex( 0 ),
+        mImageCorrupt( false )
     {
     }
 
-    virtual ~TamlBinaryReader() {}
+    virtual ~TamlBinaryReader() { delete [] mpImageWords; }
 
     /// Read.
     SimObject* read( FileStream& stream );
@@ -53,6 +61,18 @@ private:
 
     typeObjectReferenceHash mObjectReferenceMap;
 
+    /// The image of a table revision file.
+    U32*                        mpImageWords;
+    U32                         mImageSize;
+    U32                         mImageWordCount;
+    U32                         mStringCount;
+    U32                         mStringOffsetsIndex;
+    U32                         mObjectCount;
+    U32                         mObjectOffsetsIndex;
+    bool                        mImageCorrupt;
+    Vector<StringTableEntry>    mImageNames;
+    Vector<SimObject*>          mImageObjects;
+
 private:
     void resetParse( void );
 
@@ -61,6 +81,18 @@ private:
     void parseChildren( Stream& stream, TamlCallbacks* pCallbacks, SimObject* pSimObject, const U32 versionId );
     void parseCustomElements( Stream& stream, TamlCallbacks* pCallbacks, TamlCustomNodes& customNodes, const U32 versionId );
     void parseCustomNode( Stream& stream, TamlCustomNode* pCustomNode, const U32 versionId );
+
+    SimObject* readImage( Stream& stream, const bool compressed );
+    void resetImage( void );
+    SimObject* parseImageElement( const U32 objectIndex );
+    void parseImageAttributes( U32& wordIndex, SimObject* pSimObject );
+    void parseImageChildren( U32& wordIndex, SimObject* pSimObject );
+    void parseImageCustomElements( U32& wordIndex, TamlCallbacks* pCallbacks, TamlCustomNodes& customNodes );
+    void parseImageCustomNode( U32& wordIndex, TamlCustomNode* pCustomNode );
+
+    U32 readImageWord( U32& wordIndex );
+    const char* getImageString( const U32 stringIndex );
+    StringTableEntry getImageName( const U32 stringIndex );
 };
 
 #endif // _TAML_BINARYREADER_H_
\ No newline at end of file
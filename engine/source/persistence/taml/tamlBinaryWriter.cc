@@ -37,7 +37,7 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
     PROFILE_SCOPE(TamlBinaryWriter_Write);
  
     // Write Taml signature.
-    stream.writeString( StringTable->insert( TAML_SIGNATURE ) );
+    stream.writeString( TAML_SIGNATURE );
 
     // Write version Id.
     stream.write( mVersionId );
@@ -45,6 +45,24 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
     // Write compressed flag.
     stream.write( compressed );
 
+    // Add the root element.
+    getObjectIndex( pTamlWriteNode );
+
+    // Write the elements.
+    // NOTE: Writing an element adds any elements it references that have not been added.
+    for ( U32 objectIndex = 0; objectIndex < (U32)mObjectNodes.size(); ++objectIndex )
+    {
+        writeElement( mObjectNodes[objectIndex] );
+    }
+
+    // Write image size.
+    const U32 imageSize = (U32)( ( 4 + mStringOffsets.size() + mObjectOffsets.size() + mObjectWords.size() ) * sizeof(U32) + mStringPool.size() );
+    stream.write( imageSize );
+
+    // Align the image.
+    while ( ( stream.getPosition() % sizeof(U32) ) != 0 )
+        stream.write( (U8)0 );
+
     // Are we compressed?
     if ( compressed )
     {
@@ -52,16 +70,16 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
         ZipSubWStream zipStream;
         zipStream.attachStream( &stream );
 
-        // Write element.
-        writeElement( zipStream, pTamlWriteNode );
+        // Write image.
+        writeImage( zipStream );
 
         // Detach zip stream.
         zipStream.detachStream();
     }
     else
     {
-        // No, so write element.
-        writeElement( stream, pTamlWriteNode );
+        // No, so write image.
+        writeImage( stream );
     }
 
     return true;
@@ -69,64 +87,121 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
 
 //-----------------------------------------------------------------------------
 
-void TamlBinaryWriter::writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode )
+U32 TamlBinaryWriter::getObjectIndex( const TamlWriteNode* pTamlWriteNode )
 {
-    // Debug Profiling.
-    PROFILE_SCOPE(TamlBinaryWriter_WriteElement);
+    // Use the referenced node if this is a reference.
+    if ( pTamlWriteNode->mRefToNode != NULL )
+        pTamlWriteNode = pTamlWriteNode->mRefToNode;
 
-    // Fetch object.
-    SimObject* pSimObject = pTamlWriteNode->mpSimObject;
+    // Find the object index.
+    bool inserted;
+    U32& objectIndex = mObjectIndices.findOrInsert( pTamlWriteNode, &inserted );
 
-    // Fetch element name.
-    const char* pElementName = pSimObject->getClassName();
+    // Add the object if it is new.
+    if ( inserted )
+    {
+        objectIndex = (U32)mObjectNodes.size();
+        mObjectNodes.push_back( pTamlWriteNode );
+    }
 
-    // Write element name.
-    stream.writeString( pElementName );
+    return objectIndex;
+}
 
-    // Fetch object name.
-    const char* pObjectName = pTamlWriteNode->mpObjectName;
+//-----------------------------------------------------------------------------
 
-    // Write object name.
-    stream.writeString( pObjectName != NULL ? pObjectName : StringTable->EmptyString );
+U32 TamlBinaryWriter::getNameIndex( StringTableEntry name )
+{
+    // Find the string index.
+    bool inserted;
+    U32& stringIndex = mNameIndices.findOrInsert( name, &inserted );
 
-    // Fetch reference Id.
-    const U32 tamlRefId = pTamlWriteNode->mRefId;
+    // Add the string if it is new.
+    if ( inserted )
+        stringIndex = addString( name );
 
-    // Write reference Id.
-    stream.write( tamlRefId );
+    return stringIndex;
+}
 
-    // Do we have a reference to node?
-    if ( pTamlWriteNode->mRefToNode != NULL )
+//-----------------------------------------------------------------------------
+
+U32 TamlBinaryWriter::getValueIndex( const char* pValue )
+{
+    // Hash the value.
+    // NOTE: Zero is not a valid key so it is moved.
+    U32 valueHash = _StringTable::hashString( pValue );
+    if ( valueHash == 0 )
+        valueHash = 1;
+
+    // Search the values with the same hash.
+    U32* pStringIndex = mValueIndices.find( valueHash );
+    for ( U32 stringIndex = pStringIndex == NULL ? TAML_BINARY_NO_INDEX : *pStringIndex; stringIndex != TAML_BINARY_NO_INDEX; stringIndex = mNextValueIndices[stringIndex] )
     {
-        // Yes, so fetch reference to Id.
-        const U32 tamlRefToId = pTamlWriteNode->mRefToNode->mRefId;
+        if ( dStrcmp( mStringPool.address() + mStringOffsets[stringIndex], pValue ) == 0 )
+            return stringIndex;
+    }
 
-        // Sanity!
-        AssertFatal( tamlRefToId != 0, "Taml: Invalid reference to Id." );
+    // Add the value.
+    const U32 stringIndex = addString( pValue );
+    mNextValueIndices[stringIndex] = pStringIndex == NULL ? TAML_BINARY_NO_INDEX : *pStringIndex;
+    mValueIndices.insert( valueHash, stringIndex );
 
-        // Write reference to Id.
-        stream.write( tamlRefToId );
+    return stringIndex;
+}
 
-        // Finished.
-        return;
-    }
+//-----------------------------------------------------------------------------
+
+U32 TamlBinaryWriter::addString( const char* pString )
+{
+    // Fetch the string index.
+    const U32 stringIndex = (U32)mStringOffsets.size();
 
-    // No, so write no reference to Id.
-    stream.write( 0 );
+    // Add the string to the pool.
+    const U32 stringLength = dStrlen( pString ) + 1;
+    const U32 stringOffset = (U32)mStringPool.size();
+    mStringPool.setSize( stringOffset + stringLength );
+    dMemcpy( mStringPool.address() + stringOffset, pString, stringLength );
+
+    mStringOffsets.push_back( stringOffset );
+    mNextValueIndices.push_back( TAML_BINARY_NO_INDEX );
+
+    return stringIndex;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeElement( const TamlWriteNode* pTamlWriteNode )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_WriteElement);
+
+    // Sanity!
+    AssertFatal( pTamlWriteNode->mRefToNode == NULL, "Taml: Cannot write a reference as an element." );
+
+    // Set the object offset.
+    mObjectOffsets.push_back( (U32)mObjectWords.size() );
+
+    // Write element name.
+    mObjectWords.push_back( getValueIndex( pTamlWriteNode->mpTypeName ) );
+
+    // Fetch object name.
+    const char* pObjectName = pTamlWriteNode->mpObjectName;
+
+    // Write object name.
+    mObjectWords.push_back( pObjectName != NULL ? getValueIndex( pObjectName ) : TAML_BINARY_NO_INDEX );
 
     // Write attributes.
-    writeAttributes( stream, pTamlWriteNode );
+    writeAttributes( pTamlWriteNode );
 
     // Write children.
-    writeChildren( stream, pTamlWriteNode );
+    writeChildren( pTamlWriteNode );
 
     // Write custom elements.
-    writeCustomElements( stream, pTamlWriteNode );
+    writeCustomElements( pTamlWriteNode );
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlBinaryWriter::writeAttributes( Stream& stream, const TamlWriteNode* pTamlWriteNode )
+void TamlBinaryWriter::writeAttributes( const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlBinaryWriter_WriteAttributes);
@@ -134,12 +209,8 @@ void TamlBinaryWriter::writeAttributes( Stream& stream, const TamlWriteNode* pTa
     // Fetch fields.
     const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
 
-    // Write placeholder attribute count.
-    stream.write( (U32)fields.size() );
-
-    // Finish if no fields.
-    if ( fields.size() == 0 )
-        return;
+    // Write attribute count.
+    mObjectWords.push_back( (U32)fields.size() );
 
     // Iterate fields.
     for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
@@ -148,12 +219,14 @@ void TamlBinaryWriter::writeAttributes( Stream& stream, const TamlWriteNode* pTa
         TamlWriteNode::FieldValuePair* pFieldValue = (*itr);
 
         // Write attribute.
-        stream.writeString( pFieldValue->mName );
-        stream.writeLongString( 4096, pFieldValue->mpValue );
+        mObjectWords.push_back( getNameIndex( pFieldValue->mName ) );
+        mObjectWords.push_back( getValueIndex( pFieldValue->mpValue ) );
     }
 }
 
-void TamlBinaryWriter::writeChildren( Stream& stream, const TamlWriteNode* pTamlWriteNode )
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeChildren( const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlBinaryWriter_WriteChildren);
@@ -165,24 +238,24 @@ void TamlBinaryWriter::writeChildren( Stream& stream, const TamlWriteNode* pTaml
     if ( pChildren == NULL )
     {
         // No, so write no children.
-        stream.write( (U32)0 );
+        mObjectWords.push_back( 0 );
         return;
     }
 
     // Write children count.
-    stream.write( (U32)pChildren->size() );
+    mObjectWords.push_back( (U32)pChildren->size() );
 
     // Iterate children.
     for( Vector<TamlWriteNode*>::iterator itr = pChildren->begin(); itr != pChildren->end(); ++itr )
     {
-        // Write child.
-        writeElement( stream, (*itr) );
+        // Write child object index.
+        mObjectWords.push_back( getObjectIndex( *itr ) );
     }
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlBinaryWriter::writeCustomElements( Stream& stream, const TamlWriteNode* pTamlWriteNode )
+void TamlBinaryWriter::writeCustomElements( const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlBinaryWriter_WriteCustomElements);
@@ -193,12 +266,9 @@ void TamlBinaryWriter::writeCustomElements( Stream& stream, const TamlWriteNode*
     // Fetch custom nodes.
     const TamlCustomNodeVector& nodes = customNodes.getNodes();
 
-    // Write custom node count.
-    stream.write( (U32)nodes.size() );
-
-    // Finish if there are no nodes.
-    if ( nodes.size() == 0 )
-        return;
+    // Write placeholder custom node count.
+    const U32 nodeCountOffset = (U32)mObjectWords.size();
+    mObjectWords.push_back( 0 );
 
     // Iterate custom nodes.
     for( TamlCustomNodeVector::const_iterator customNodesItr = nodes.begin(); customNodesItr != nodes.end(); ++customNodesItr )
@@ -206,92 +276,151 @@ void TamlBinaryWriter::writeCustomElements( Stream& stream, const TamlWriteNode*
         // Fetch the custom node.
         TamlCustomNode* pCustomNode = *customNodesItr;
 
-        // Write custom node name.
-        stream.writeString( pCustomNode->getNodeName() );
+        // Write custom node name and placeholder child count.
+        const U32 nodeOffset = (U32)mObjectWords.size();
+        mObjectWords.push_back( getNameIndex( pCustomNode->getNodeName() ) );
+        mObjectWords.push_back( 0 );
 
         // Fetch node children.
         const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
 
         // Iterate children nodes.
+        U32 childNodeCount = 0;
         for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
         {
-            // Fetch child node.
-            const TamlCustomNode* pChildNode = *childNodeItr;
-
             // Write the custom node.
-            writeCustomNode( stream, pChildNode );
+            if ( writeCustomNode( *childNodeItr ) )
+                childNodeCount++;
+        }
+
+        // Is the node set to ignore if empty and it is empty?
+        if ( pCustomNode->getIgnoreEmpty() && childNodeCount == 0 )
+        {
+            // Yes, so remove it.
+            mObjectWords.setSize( nodeOffset );
+            continue;
         }
+
+        // Update the custom node counts.
+        mObjectWords[nodeOffset+1] = childNodeCount;
+        mObjectWords[nodeCountOffset]++;
     }
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlBinaryWriter::writeCustomNode( Stream& stream, const TamlCustomNode* pCustomNode )
+bool TamlBinaryWriter::writeCustomNode( const TamlCustomNode* pCustomNode )
 {
+    // Finish if the node is set to ignore if empty and it is empty.
+    if ( pCustomNode->getIgnoreEmpty() && pCustomNode->isEmpty() )
+        return false;
+
     // Is the node a proxy object?
     if ( pCustomNode->isProxyObject() )
     {
-        // Yes, so flag as proxy object.
-        stream.write( true );
-
-        // Write the element.
-        writeElement( stream, pCustomNode->getProxyWriteNode() );
-        return;
+        // Yes, so write the proxy object index.
+        mObjectWords.push_back( getObjectIndex( pCustomNode->getProxyWriteNode() ) );
+        return true;
     }
 
     // No, so flag as custom node.
-    stream.write( false );
+    const U32 nodeOffset = (U32)mObjectWords.size();
+    mObjectWords.push_back( TAML_BINARY_NO_INDEX );
 
     // Write custom node name.
-    stream.writeString( pCustomNode->getNodeName() );
+    mObjectWords.push_back( getNameIndex( pCustomNode->getNodeName() ) );
 
     // Write custom node text.
-    stream.writeString( pCustomNode->getNodeTextField().getFieldValue(), MAX_TAML_NODE_FIELDVALUE_LENGTH );
-
-    // Fetch node children.
-    const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+    const TamlCustomField& nodeText = pCustomNode->getNodeTextField();
+    mObjectWords.push_back( nodeText.isValueEmpty() ? TAML_BINARY_NO_INDEX : getValueIndex( nodeText.getFieldValue() ) );
 
-    // Fetch child node count.
-    const U32 childNodeCount = (U32)nodeChildren.size();
+    // Fetch fields.
+    const TamlCustomFieldVector& fields = pCustomNode->getFields();
 
-    // Write custom node count.
-    stream.write( childNodeCount );
+    // Write custom field count.
+    mObjectWords.push_back( (U32)fields.size() );
 
-    // Do we have any children nodes.
-    if ( childNodeCount > 0 )
+    // Iterate fields.
+    for ( TamlCustomFieldVector::const_iterator fieldItr = fields.begin(); fieldItr != fields.end(); ++fieldItr )
     {
-        // Yes, so iterate children nodes.
-        for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
-        {
-            // Fetch child node.
-            const TamlCustomNode* pChildNode = *childNodeItr;
+        // Fetch node field.
+        const TamlCustomField* pField = *fieldItr;
 
-            // Write the custom node.
-            writeCustomNode( stream, pChildNode );
-        }
+        // Write the node field.
+        mObjectWords.push_back( getNameIndex( pField->getFieldName() ) );
+        mObjectWords.push_back( getValueIndex( pField->getFieldValue() ) );
     }
 
-    // Fetch fields.
-    const TamlCustomFieldVector& fields = pCustomNode->getFields();
-
-    // Fetch child field count.
-    const U32 childFieldCount = (U32)fields.size();
+    // Write placeholder child node count.
+    const U32 childNodeCountOffset = (U32)mObjectWords.size();
+    mObjectWords.push_back( 0 );
 
-    // Write custom field count.
-    stream.write( childFieldCount );
+    // Fetch node children.
+    const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
 
-    // Do we have any child fields?
-    if ( childFieldCount > 0 )
+    // Iterate children nodes.
+    U32 childNodeCount = 0;
+    for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
     {
-        // Yes, so iterate  fields.
-        for ( TamlCustomFieldVector::const_iterator fieldItr = fields.begin(); fieldItr != fields.end(); ++fieldItr )
-        {
-            // Fetch node field.
-            const TamlCustomField* pField = *fieldItr;
+        // Write the custom node.
+        if ( writeCustomNode( *childNodeItr ) )
+            childNodeCount++;
+    }
 
-            // Write the node field.
-            stream.writeString( pField->getFieldName() );
-            stream.writeLongString( MAX_TAML_NODE_FIELDVALUE_LENGTH, pField->getFieldValue() );
-        }
+    // Is the node set to ignore if empty and it is empty once its children are ignored?
+    if ( pCustomNode->getIgnoreEmpty() && nodeText.isValueEmpty() && fields.size() == 0 && childNodeCount == 0 )
+    {
+        // Yes, so remove it.
+        mObjectWords.setSize( nodeOffset );
+        return false;
     }
-}
\ No newline at end of file
+
+    // Update the child node count.
+    mObjectWords[childNodeCountOffset] = childNodeCount;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeImage( Stream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_WriteImage);
+
+    // Fetch the counts.
+    const U32 stringCount = (U32)mStringOffsets.size();
+    const U32 objectCount = (U32)mObjectOffsets.size();
+
+    // Calculate the section offsets.
+    const U32 stringOffsetsOffset = 4 * sizeof(U32);
+    const U32 objectOffsetsOffset = stringOffsetsOffset + stringCount * sizeof(U32);
+    const U32 objectRecordsOffset = objectOffsetsOffset + objectCount * sizeof(U32);
+    const U32 stringPoolOffset = objectRecordsOffset + (U32)mObjectWords.size() * sizeof(U32);
+
+    // Build the header and offset tables.
+    Vector<U32> tableWords;
+    tableWords.reserve( 4 + stringCount + objectCount );
+    tableWords.push_back( stringCount );
+    tableWords.push_back( stringOffsetsOffset );
+    tableWords.push_back( objectCount );
+    tableWords.push_back( objectOffsetsOffset );
+
+    for ( U32 stringIndex = 0; stringIndex < stringCount; ++stringIndex )
+        tableWords.push_back( stringPoolOffset + mStringOffsets[stringIndex] );
+
+    for ( U32 objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+        tableWords.push_back( objectRecordsOffset + mObjectOffsets[objectIndex] * sizeof(U32) );
+
+    // Convert the words to little-endian.
+    for ( U32 index = 0; index < (U32)tableWords.size(); ++index )
+        tableWords[index] = convertHostToLEndian( tableWords[index] );
+
+    for ( U32 index = 0; index < (U32)mObjectWords.size(); ++index )
+        mObjectWords[index] = convertHostToLEndian( mObjectWords[index] );
+
+    // Write the image.
+    stream.write( tableWords.size() * sizeof(U32), tableWords.address() );
+    stream.write( mObjectWords.size() * sizeof(U32), mObjectWords.address() );
+    stream.write( mStringPool.size(), mStringPool.address() );
+}
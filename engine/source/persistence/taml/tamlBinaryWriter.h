@@ -27,14 +27,38 @@
 #include "persistence/taml/taml.h"
 #endif
 
+#ifndef _FLAT_HASH_MAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
+/// Writes the binary format.
+///
+/// Following the signature, version and compressed flag, the document is
+/// written as a single image of little-endian words.  The image starts on a
+/// four byte boundary in the file and is laid out as:
+///
+/// - A header of the string count, the string offset table offset, the object
+///   count and the object offset table offset.
+/// - The string offset table with the offset of each string.
+/// - The object offset table with the offset of each object record.
+/// - The object records.
+/// - The string pool of null terminated strings.
+///
+/// Type names, field names and field values are all strings in the pool and
+/// are referenced by index so each distinct string is only stored once.  An
+/// object record holds its type and name indices, its fields as name and value
+/// index pairs, its children as object indices and its custom nodes.  An object
+/// referenced more than once has a single record so references are simply its
+/// index.  All offsets are relative to the image so an uncompressed image can
+/// be used directly from a mapped file and any object can be found directly.
 class TamlBinaryWriter
 {
 public:
     TamlBinaryWriter( Taml* pTaml ) :
         mpTaml( pTaml ),
-        mVersionId(2)
+        mVersionId( TAML_BINARY_TABLES_VERSION )
     {
     }
     virtual ~TamlBinaryWriter() {}
@@ -46,12 +70,33 @@ private:
     Taml* mpTaml;
     const U32 mVersionId;
 
+    typedef FlatHashMap<const TamlWriteNode*, U32>  typeObjectIndexHash;
+    typedef FlatHashMap<StringTableEntry, U32>      typeNameIndexHash;
+    typedef FlatHashMap<U32, U32>                   typeValueIndexHash;
+
+    Vector<const TamlWriteNode*>    mObjectNodes;
+    typeObjectIndexHash             mObjectIndices;
+    Vector<U32>                     mObjectOffsets;
+    Vector<U32>                     mObjectWords;
+
+    Vector<U32>                     mStringOffsets;
+    Vector<char>                    mStringPool;
+    typeNameIndexHash               mNameIndices;
+    typeValueIndexHash              mValueIndices;
+    Vector<U32>                     mNextValueIndices;
+
 private:
-    void writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode );
-    void writeAttributes( Stream& stream, const TamlWriteNode* pTamlWriteNode );
-    void writeChildren( Stream& stream, const TamlWriteNode* pTamlWriteNode );
-    void writeCustomElements( Stream& stream, const TamlWriteNode* pTamlWriteNode );
-    void writeCustomNode( Stream& stream, const TamlCustomNode* pCustomNode );
+    U32 getObjectIndex( const TamlWriteNode* pTamlWriteNode );
+    U32 getNameIndex( StringTableEntry name );
+    U32 getValueIndex( const char* pValue );
+    U32 addString( const char* pString );
+
+    void writeElement( const TamlWriteNode* pTamlWriteNode );
+    void writeAttributes( const TamlWriteNode* pTamlWriteNode );
+    void writeChildren( const TamlWriteNode* pTamlWriteNode );
+    void writeCustomElements( const TamlWriteNode* pTamlWriteNode );
+    bool writeCustomNode( const TamlCustomNode* pCustomNode );
+    void writeImage( Stream& stream );
 };
 
 #endif // _TAML_BINARYWRITER_H_
\ No newline at end of file
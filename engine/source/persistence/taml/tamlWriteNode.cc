@@ -35,7 +35,8 @@ void TamlWriteNode::resetNode( void )
     // Clear fields.
     for( Vector<TamlWriteNode::FieldValuePair*>::iterator itr = mFields.begin(); itr != mFields.end(); ++itr )
     {
-        delete (*itr)->mpValue;
+        delete [] (*itr)->mpValue;
+        delete (*itr);
     }
     mFields.clear();
 
@@ -55,6 +56,7 @@ void TamlWriteNode::resetNode( void )
     mRefId = 0;
     mRefToNode = NULL;
     mChildren = NULL;
+    mpTypeName = NULL;
     mpObjectName = NULL;
     mpSimObject = NULL;
 
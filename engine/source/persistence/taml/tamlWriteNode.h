@@ -69,6 +69,7 @@ public:
         mRefToNode = NULL;
         mpSimObject = NULL;
         mpTamlCallbacks = NULL;
+        mpTypeName = NULL;
         mpObjectName = NULL;
         mChildren = NULL;
 
@@ -86,6 +87,10 @@ public:
         // Set sim object.
         mpSimObject = pSimObject;
 
+        // Fetch type name.
+        // NOTE: This is kept so that the node can be written without the object.
+        mpTypeName = pSimObject->getClassName();
+
         // Fetch name.
         const char* pObjectName = pSimObject->getName();
 
@@ -107,6 +112,7 @@ public:
     TamlWriteNode*              mRefToNode;
     SimObject*                  mpSimObject;
     TamlCallbacks*              mpTamlCallbacks;
+    const char*                 mpTypeName;
     const char*                 mpObjectName;
     Vector<TamlWriteNode::FieldValuePair*> mFields;
     Vector<TamlWriteNode*>*     mChildren;
@@ -22,11 +22,27 @@
 
 #include "persistence/taml/tamlXmlParser.h"
 
+#ifndef TINYXML_INCLUDED
+#include "persistence/tinyXML/tinyxml.h"
+#endif
+
 // Debug Profiling.
 #include "debug/profiler.h"
 
 //-----------------------------------------------------------------------------
 
+void TamlXmlAttribute::setValue( const char* pValue )
+{
+    // Sanity!
+    AssertFatal( mpXmlAttribute != NULL, "TamlXmlAttribute::setValue() - Attributes can only be changed when the document is being written." );
+
+    // Set the value.
+    mpXmlAttribute->SetValue( pValue );
+    mpValue = mpXmlAttribute->Value();
+}
+
+//-----------------------------------------------------------------------------
+
 bool TamlXmlParser::parse( const char* pFilename, TamlXmlVisitor& visitor, const bool writeDocument )
 {
     // Debug Profiling.
@@ -48,6 +64,52 @@ bool TamlXmlParser::parse( const char* pFilename, TamlXmlVisitor& visitor, const
         return false;
     }
 
+    // Are we writing the document?
+    if ( !writeDocument )
+    {
+        // No, so stream the document.
+        TamlXmlPullParser xmlParser;
+
+        // Load document from stream.
+        if ( !xmlParser.load( stream ) )
+        {
+            // Warn!
+            Con::warnf("TamlXmlParser: Could not load Taml XML file from stream.");
+            return false;
+        }
+
+        // Close the stream.
+        stream.close();
+
+        // Find the root element.
+        TamlXmlPullParser::TokenType tokenType;
+        do
+        {
+            tokenType = xmlParser.next();
+        }
+        while ( tokenType == TamlXmlPullParser::TextToken );
+
+        // Set parsing filename.
+        mpParsingFilename = filenameBuffer;
+
+        // Parse root element.
+        if ( tokenType == TamlXmlPullParser::StartElementToken )
+            parseElement( xmlParser, visitor, true );
+
+        // Reset parsing filename.
+        mpParsingFilename = NULL;
+
+        // Did parsing fail?
+        if ( xmlParser.getError() != NULL )
+        {
+            // Yes, so warn.
+            Con::warnf("TamlXmlParser: Could not parse Taml XML file '%s' at offset %d: %s", filenameBuffer, xmlParser.getOffset(), xmlParser.getError() );
+            return false;
+        }
+
+        return true;
+    }
+
     TiXmlDocument xmlDocument;
 
     // Load document from stream.
@@ -65,50 +127,114 @@ bool TamlXmlParser::parse( const char* pFilename, TamlXmlVisitor& visitor, const
     mpParsingFilename = filenameBuffer;
 
     // Parse root element.
-    parseElement( xmlDocument.RootElement(), visitor );
+    parseElement( xmlDocument.RootElement(), visitor, true );
 
     // Reset parsing filename.
     mpParsingFilename = NULL;
 
-    // Are we writing the document?
-    if ( writeDocument )
+    // File open for write?
+    if ( !stream.open( filenameBuffer, FileStream::Write ) )
     {
-        // Yes, so open for write?
-        if ( !stream.open( filenameBuffer, FileStream::Write ) )
-        {
-            // No, so warn.
-            Con::warnf("TamlXmlParser::parse() - Could not open filename '%s' for write.", filenameBuffer );
-            return false;
-        }
+        // No, so warn.
+        Con::warnf("TamlXmlParser::parse() - Could not open filename '%s' for write.", filenameBuffer );
+        return false;
+    }
 
-        // Yes, so save the document.
-        if ( !xmlDocument.SaveFile( stream ) )
-        {
-            // Warn!
-            Con::warnf("TamlXmlParser: Could not save Taml XML document.");
+    // Save the document.
+    if ( !xmlDocument.SaveFile( stream ) )
+    {
+        // Warn!
+        Con::warnf("TamlXmlParser: Could not save Taml XML document.");
+        return false;
+    }
+
+    // Close the stream.
+    stream.close();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlParser::parseElement( TamlXmlPullParser& xmlParser, TamlXmlVisitor& visitor, const bool rootElement )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlXmlParser_ParseStreamedElement);
+
+    // Present the element.
+    // NOTE: The element is not needed once its children are reached so it is reused.
+    mElement.mpName = xmlParser.getName();
+    mElement.mRootElement = rootElement;
+    mElement.mAttributes.clear();
+
+    const U32 attributeCount = xmlParser.getAttributeCount();
+    for ( U32 index = 0; index < attributeCount; ++index )
+    {
+        const TamlXmlPullParser::Attribute& xmlAttribute = xmlParser.getAttribute( index );
+        mElement.mAttributes.increment();
+        TamlXmlAttribute& attribute = mElement.mAttributes.last();
+        attribute.mpName = xmlAttribute.mpName;
+        attribute.mpValue = xmlAttribute.mpValue;
+        attribute.mpXmlAttribute = NULL;
+    }
+
+    // Visit this element (stop processing if instructed).
+    if ( !visitor.visit( &mElement, *this ) )
+        return false;
+
+    // Parse attributes (stop processing if instructed).
+    if ( !parseAttributes( visitor ) )
+        return false;
+
+    // Read the first child.
+    TamlXmlPullParser::TokenType tokenType = xmlParser.next();
+
+    // Skip the children unless the first is an element as the document object model does.
+    if ( tokenType == TamlXmlPullParser::TextToken )
+        return xmlParser.skipElement();
+
+    // Iterate children.
+    while ( tokenType == TamlXmlPullParser::StartElementToken || tokenType == TamlXmlPullParser::TextToken )
+    {
+        // Parse element (stop processing if instructed).
+        if ( tokenType == TamlXmlPullParser::StartElementToken && !parseElement( xmlParser, visitor, false ) )
             return false;
-        }
 
-        // Close the stream.
-        stream.close();
+        // Read the next child.
+        tokenType = xmlParser.next();
     }
 
-    return true;
+    return tokenType == TamlXmlPullParser::EndElementToken;
 }
 
 //-----------------------------------------------------------------------------
 
-bool TamlXmlParser::parseElement( TiXmlElement* pXmlElement, TamlXmlVisitor& visitor )
+bool TamlXmlParser::parseElement( TiXmlElement* pXmlElement, TamlXmlVisitor& visitor, const bool rootElement )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlParser_ParseElement);
 
+    // Present the element.
+    // NOTE: The element is not needed once its children are reached so it is reused.
+    mElement.mpName = pXmlElement->Value();
+    mElement.mRootElement = rootElement;
+    mElement.mAttributes.clear();
+
+    for ( TiXmlAttribute* pXmlAttribute = pXmlElement->FirstAttribute(); pXmlAttribute; pXmlAttribute = pXmlAttribute->Next() )
+    {
+        mElement.mAttributes.increment();
+        TamlXmlAttribute& attribute = mElement.mAttributes.last();
+        attribute.mpName = pXmlAttribute->Name();
+        attribute.mpValue = pXmlAttribute->Value();
+        attribute.mpXmlAttribute = pXmlAttribute;
+    }
+
     // Visit this element (stop processing if instructed).
-    if ( !visitor.visit( pXmlElement, *this ) )
+    if ( !visitor.visit( &mElement, *this ) )
         return false;
 
     // Parse attributes (stop processing if instructed).
-    if ( !parseAttributes( pXmlElement, visitor ) )
+    if ( !parseAttributes( visitor ) )
         return false;
 
     // Fetch any children.
@@ -121,7 +247,7 @@ bool TamlXmlParser::parseElement( TiXmlElement* pXmlElement, TamlXmlVisitor& vis
         for ( TiXmlElement* pChildXmlElement = dynamic_cast<TiXmlElement*>( pChildXmlNode ); pChildXmlElement; pChildXmlElement = pChildXmlElement->NextSiblingElement() )
         {
             // Parse element (stop processing if instructed).
-            if ( !parseElement( pChildXmlElement, visitor ) )
+            if ( !parseElement( pChildXmlElement, visitor, false ) )
                 return false;
         }
     }
@@ -131,16 +257,17 @@ bool TamlXmlParser::parseElement( TiXmlElement* pXmlElement, TamlXmlVisitor& vis
 
 //-----------------------------------------------------------------------------
 
-bool TamlXmlParser::parseAttributes( TiXmlElement* pXmlElement, TamlXmlVisitor& visitor )
+bool TamlXmlParser::parseAttributes( TamlXmlVisitor& visitor )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlParser_ParseAttribute);
 
     // Iterate attributes.
-    for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
+    const U32 attributeCount = mElement.getAttributeCount();
+    for ( U32 index = 0; index < attributeCount; ++index )
     {
         // Visit this attribute (stop processing if instructed).
-        if ( !visitor.visit( pAttribute, *this ) )
+        if ( !visitor.visit( &mElement.getAttribute( index ), *this ) )
             return false;
     }
 
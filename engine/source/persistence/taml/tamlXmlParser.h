@@ -31,8 +31,21 @@
 #include "persistence/taml/taml.h"
 #endif
 
+#ifndef _TAML_XML_PULL_PARSER_H_
+#include "persistence/taml/tamlXmlPullParser.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class TiXmlElement;
+
 //-----------------------------------------------------------------------------
 
+/// Parses a Taml XML file, presenting each element and attribute to a visitor.
+///
+/// A document that is only being read is streamed so no document object model
+/// is built.  A document that is being written is loaded into a TinyXML document
+/// so that the visitor can change attribute values before it is saved.
 class TamlXmlParser
 {
 public:
@@ -47,11 +60,13 @@ public:
     inline const char* getParsingFilename( void ) const { return mpParsingFilename; }
 
 private:
-    const char* mpParsingFilename;
+    const char*     mpParsingFilename;
+    TamlXmlElement  mElement;
 
 private:
-    bool parseElement( TiXmlElement* pXmlElement, TamlXmlVisitor& visitor );
-    bool parseAttributes( TiXmlElement* pXmlElement, TamlXmlVisitor& visitor );
+    bool parseElement( TamlXmlPullParser& xmlParser, TamlXmlVisitor& visitor, const bool rootElement );
+    bool parseElement( TiXmlElement* pXmlElement, TamlXmlVisitor& visitor, const bool rootElement );
+    bool parseAttributes( TamlXmlVisitor& visitor );
 };
 
 #endif // _TAML_XMLPARSER_H_
\ No newline at end of file
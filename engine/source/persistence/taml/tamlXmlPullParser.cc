@@ -0,0 +1,621 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TAML_XML_PULL_PARSER_H_
+#include "persistence/taml/tamlXmlPullParser.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+struct XmlEntity
+{
+    const char* mpEntity;
+    U32         mLength;
+    char        mCharacter;
+};
+
+static const XmlEntity sXmlEntities[] =
+{
+    { "&amp;",  5, '&' },
+    { "&lt;",   4, '<' },
+    { "&gt;",   4, '>' },
+    { "&quot;", 6, '\"' },
+    { "&apos;", 6, '\'' },
+};
+
+static const U32 sXmlEntityCount = sizeof(sXmlEntities) / sizeof(XmlEntity);
+
+//-----------------------------------------------------------------------------
+
+static inline bool isXmlWhiteSpace( const char character )
+{
+    return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+}
+
+//-----------------------------------------------------------------------------
+
+static char* writeUTF8( const U32 code, char* pOutput )
+{
+    if ( code < 0x80 )
+    {
+        *pOutput++ = (char)code;
+    }
+    else if ( code < 0x800 )
+    {
+        *pOutput++ = (char)( 0xC0 | ( code >> 6 ) );
+        *pOutput++ = (char)( 0x80 | ( code & 0x3F ) );
+    }
+    else if ( code < 0x10000 )
+    {
+        *pOutput++ = (char)( 0xE0 | ( code >> 12 ) );
+        *pOutput++ = (char)( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+        *pOutput++ = (char)( 0x80 | ( code & 0x3F ) );
+    }
+    else
+    {
+        *pOutput++ = (char)( 0xF0 | ( code >> 18 ) );
+        *pOutput++ = (char)( 0x80 | ( ( code >> 12 ) & 0x3F ) );
+        *pOutput++ = (char)( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+        *pOutput++ = (char)( 0x80 | ( code & 0x3F ) );
+    }
+
+    return pOutput;
+}
+
+//-----------------------------------------------------------------------------
+
+TamlXmlPullParser::TamlXmlPullParser() :
+    mpBuffer( NULL ),
+    mpCursor( NULL ),
+    mpTokenStart( NULL ),
+    mTagOpenConsumed( false ),
+    mEmptyElementPending( false ),
+    mpName( NULL ),
+    mpText( NULL ),
+    mpError( NULL )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+TamlXmlPullParser::~TamlXmlPullParser()
+{
+    delete [] mpBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlPullParser::load( FileStream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlXmlPullParser_Load);
+
+    // Reset the parser.
+    delete [] mpBuffer;
+    mpBuffer = NULL;
+    mpCursor = NULL;
+    mpTokenStart = NULL;
+    mTagOpenConsumed = false;
+    mEmptyElementPending = false;
+    mpName = NULL;
+    mpText = NULL;
+    mpError = NULL;
+    mAttributes.clear();
+    mOpenElements.clear();
+
+    // Fetch the document size.
+    const U32 size = stream.getStreamSize() - stream.getPosition();
+
+    // An empty document is an error as it is for TinyXML.
+    if ( size == 0 )
+        return false;
+
+    // Read the document in one go.
+    mpBuffer = new char[size + 1];
+    if ( !stream.read( size, mpBuffer ) )
+    {
+        delete [] mpBuffer;
+        mpBuffer = NULL;
+        return false;
+    }
+    mpBuffer[size] = 0;
+
+    mpCursor = mpBuffer;
+    mpTokenStart = mpBuffer;
+
+    // Skip any UTF-8 byte order mark.
+    if ( size >= 3 && (U8)mpBuffer[0] == 0xEF && (U8)mpBuffer[1] == 0xBB && (U8)mpBuffer[2] == 0xBF )
+        mpCursor += 3;
+
+#ifdef TORQUE_DEBUG
+    // Find the lines before parsing modifies the buffer.
+    mLineOffsets.clear();
+    mLineOffsets.push_back( 0 );
+    for ( U32 offset = 0; offset < size; ++offset )
+    {
+        if ( mpBuffer[offset] == '\n' )
+            mLineOffsets.push_back( offset + 1 );
+    }
+#endif
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+TamlXmlPullParser::TokenType TamlXmlPullParser::next( void )
+{
+    // Finish if there is no document.
+    if ( mpBuffer == NULL )
+        return setError( "No document is loaded." );
+
+    // Finish if parsing has already failed.
+    if ( mpError != NULL )
+        return ErrorToken;
+
+    // Is an empty element pending its end?
+    if ( mEmptyElementPending )
+    {
+        // Yes, so end it.
+        mEmptyElementPending = false;
+        mpName = mOpenElements.last();
+        mOpenElements.pop_back();
+        mAttributes.clear();
+        return EndElementToken;
+    }
+
+    while ( true )
+    {
+        // Note where the token starts.
+        mpTokenStart = mTagOpenConsumed ? mpCursor - 1 : mpCursor;
+
+        // Is this markup?
+        if ( mTagOpenConsumed || *mpCursor == '<' )
+        {
+            // Yes, so move past the opening bracket.
+            if ( !mTagOpenConsumed )
+                mpCursor++;
+            mTagOpenConsumed = false;
+
+            // Skip any declaration or processing instruction.
+            if ( *mpCursor == '?' )
+            {
+                if ( !skipPast( "?>" ) )
+                    return setError( "Unterminated declaration." );
+                continue;
+            }
+
+            if ( *mpCursor == '!' )
+            {
+                // Skip any comment.
+                if ( dStrncmp( mpCursor, "!--", 3 ) == 0 )
+                {
+                    if ( !skipPast( "-->" ) )
+                        return setError( "Unterminated comment." );
+                    continue;
+                }
+
+                // Read any CDATA section as text as it is.
+                if ( dStrncmp( mpCursor, "![CDATA[", 8 ) == 0 )
+                {
+                    char* pText = mpCursor + 8;
+                    char* pTextEnd = dStrstr( (const char*)pText, "]]>" );
+                    if ( pTextEnd == NULL )
+                        return setError( "Unterminated CDATA section." );
+
+                    *pTextEnd = 0;
+                    mpCursor = pTextEnd + 3;
+                    mpText = pText;
+                    return TextToken;
+                }
+
+                // Skip any other declaration such as a document type.
+                if ( !skipPast( ">" ) )
+                    return setError( "Unterminated declaration." );
+                continue;
+            }
+
+            // Read the element.
+            return *mpCursor == '/' ? readEndElement() : readStartElement();
+        }
+
+        // Finish at the end of the document.
+        if ( *mpCursor == 0 )
+        {
+            if ( mOpenElements.size() > 0 )
+                return setError( "Unexpected end of document." );
+
+            return EndDocumentToken;
+        }
+
+        // Read the text unless it is only whitespace.
+        if ( readText() )
+            return TextToken;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlPullParser::skipElement( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlXmlPullParser_SkipElement);
+
+    // Fetch the depth of the current element.
+    const U32 depth = getDepth();
+
+    while ( true )
+    {
+        const TokenType tokenType = next();
+
+        // Finish if the document ended first.
+        if ( tokenType == ErrorToken || tokenType == EndDocumentToken )
+            return false;
+
+        // Finish once the element has ended.
+        if ( tokenType == EndElementToken && getDepth() < depth )
+            return true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+const char* TamlXmlPullParser::findAttribute( const char* pName ) const
+{
+    for ( S32 index = 0; index < mAttributes.size(); ++index )
+    {
+        if ( dStrcmp( mAttributes[index].mpName, pName ) == 0 )
+            return mAttributes[index].mpValue;
+    }
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_DEBUG
+void TamlXmlPullParser::getPosition( U32& row, U32& column ) const
+{
+    // Fetch the token offset.
+    const U32 offset = getOffset();
+
+    // Find the line containing the token.
+    S32 low = 0;
+    S32 high = mLineOffsets.size() - 1;
+    while ( low < high )
+    {
+        const S32 middle = ( low + high + 1 ) / 2;
+        if ( mLineOffsets[middle] <= offset )
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    row = low + 1;
+    column = offset - mLineOffsets[low] + 1;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
+TamlXmlPullParser::TokenType TamlXmlPullParser::setError( const char* pError )
+{
+    mpError = pError;
+    return ErrorToken;
+}
+
+//-----------------------------------------------------------------------------
+
+TamlXmlPullParser::TokenType TamlXmlPullParser::readStartElement( void )
+{
+    // Reset the attributes.
+    mAttributes.clear();
+
+    // Read the element name.
+    char* pName = readName();
+    if ( pName == NULL )
+        return setError( "Expected an element name." );
+
+    // Fetch the character following the name then terminate the name.
+    char character = *mpCursor;
+    *mpCursor++ = 0;
+
+    // Read the attributes.
+    while ( true )
+    {
+        // Skip whitespace.
+        while ( isXmlWhiteSpace( character ) )
+            character = *mpCursor++;
+
+        // Finish at the end of the start element.
+        if ( character == '>' )
+            break;
+
+        // Finish at the end of an empty element.
+        if ( character == '/' )
+        {
+            if ( *mpCursor != '>' )
+                return setError( "Expected '>' to close an empty element." );
+
+            mpCursor++;
+            mEmptyElementPending = true;
+            break;
+        }
+
+        if ( character == 0 )
+            return setError( "Unterminated start element." );
+
+        // Read the attribute name.
+        mpCursor--;
+        char* pAttributeName = readName();
+        if ( pAttributeName == NULL )
+            return setError( "Expected an attribute name." );
+
+        // Terminate the attribute name.
+        character = *mpCursor;
+        *mpCursor++ = 0;
+
+        // Find the assignment.
+        while ( isXmlWhiteSpace( character ) )
+            character = *mpCursor++;
+        if ( character != '=' )
+            return setError( "Expected '=' following an attribute name." );
+
+        // Find the opening quote.
+        character = *mpCursor++;
+        while ( isXmlWhiteSpace( character ) )
+            character = *mpCursor++;
+        if ( character != '\"' && character != '\'' )
+            return setError( "Expected a quoted attribute value." );
+
+        // Find the closing quote.
+        char* pValue = mpCursor;
+        char* pValueEnd = dStrchr( pValue, character );
+        if ( pValueEnd == NULL )
+            return setError( "Unterminated attribute value." );
+
+        // Decode the value in place, keeping its whitespace as TinyXML does.
+        *decodeText( pValue, pValueEnd, false ) = 0;
+
+        // Add the attribute.
+        Attribute attribute;
+        attribute.mpName = pAttributeName;
+        attribute.mpValue = pValue;
+        mAttributes.push_back( attribute );
+
+        // Move past the closing quote.
+        mpCursor = pValueEnd + 1;
+        character = *mpCursor++;
+    }
+
+    // Open the element.
+    mpName = pName;
+    mOpenElements.push_back( pName );
+
+    return StartElementToken;
+}
+
+//-----------------------------------------------------------------------------
+
+TamlXmlPullParser::TokenType TamlXmlPullParser::readEndElement( void )
+{
+    // Move past the slash.
+    mpCursor++;
+
+    // Read the element name.
+    char* pName = readName();
+    if ( pName == NULL )
+        return setError( "Expected an element name." );
+
+    // Fetch the character following the name then terminate the name.
+    char character = *mpCursor;
+    *mpCursor++ = 0;
+
+    // Find the end of the element.
+    while ( isXmlWhiteSpace( character ) )
+        character = *mpCursor++;
+    if ( character != '>' )
+        return setError( "Expected '>' to close an end element." );
+
+    // Is this the element currently open?
+    if ( mOpenElements.size() == 0 || dStrcmp( mOpenElements.last(), pName ) != 0 )
+        return setError( "End element does not match the open element." );
+
+    // Close the element.
+    mOpenElements.pop_back();
+    mAttributes.clear();
+    mpName = pName;
+
+    return EndElementToken;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlPullParser::readText( void )
+{
+    // Find the end of the text.
+    char* pText = mpCursor;
+    char* pTextEnd = pText;
+    while ( *pTextEnd != 0 && *pTextEnd != '<' )
+        pTextEnd++;
+
+    // Move past the text.  The opening bracket of any markup that follows is
+    // about to be overwritten by the terminator so it is consumed here.
+    if ( *pTextEnd == '<' )
+    {
+        mTagOpenConsumed = true;
+        mpCursor = pTextEnd + 1;
+    }
+    else
+    {
+        mpCursor = pTextEnd;
+    }
+
+    // Decode and terminate the text.
+    char* pDecodedEnd = decodeText( pText, pTextEnd, true );
+    *pDecodedEnd = 0;
+
+    // Skip the text if it was only whitespace.
+    if ( pDecodedEnd == pText )
+        return false;
+
+    mpText = pText;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+char* TamlXmlPullParser::readName( void )
+{
+    char* pName = mpCursor;
+
+    while ( *mpCursor != 0 && !isXmlWhiteSpace( *mpCursor ) && *mpCursor != '=' && *mpCursor != '/' && *mpCursor != '>' )
+        mpCursor++;
+
+    return mpCursor == pName ? NULL : pName;
+}
+
+//-----------------------------------------------------------------------------
+
+char* TamlXmlPullParser::decodeText( char* pText, char* pTextEnd, const bool condenseWhiteSpace )
+{
+    // NOTE: Decoding never lengthens the text so it is written over itself.
+    char* pRead = pText;
+    char* pWrite = pText;
+    bool spacePending = false;
+
+    // Skip any leading whitespace when condensing.
+    if ( condenseWhiteSpace )
+    {
+        while ( pRead < pTextEnd && isXmlWhiteSpace( *pRead ) )
+            pRead++;
+    }
+
+    while ( pRead < pTextEnd )
+    {
+        const char character = *pRead;
+
+        // Condense any whitespace to a single space, dropping any trailing whitespace.
+        if ( condenseWhiteSpace && isXmlWhiteSpace( character ) )
+        {
+            spacePending = true;
+            pRead++;
+            continue;
+        }
+
+        if ( spacePending )
+        {
+            *pWrite++ = ' ';
+            spacePending = false;
+        }
+
+        // Normalize line breaks.
+        if ( character == '\r' )
+        {
+            *pWrite++ = '\n';
+            pRead++;
+            if ( pRead < pTextEnd && *pRead == '\n' )
+                pRead++;
+            continue;
+        }
+
+        // Decode any entity.
+        if ( character == '&' )
+        {
+            // Is this a character reference?
+            if ( pRead[1] == '#' )
+            {
+                // Yes, so read the code.
+                const bool hexadecimal = pRead[2] == 'x' || pRead[2] == 'X';
+                const char* pDigits = pRead + ( hexadecimal ? 3 : 2 );
+                const char* pDigitsEnd = pDigits;
+                U32 code = 0;
+                while ( pDigitsEnd < pTextEnd && code <= 0x10FFFF )
+                {
+                    const char digit = *pDigitsEnd;
+                    if ( digit >= '0' && digit <= '9' )
+                        code = code * ( hexadecimal ? 16 : 10 ) + ( digit - '0' );
+                    else if ( hexadecimal && digit >= 'a' && digit <= 'f' )
+                        code = code * 16 + ( digit - 'a' + 10 );
+                    else if ( hexadecimal && digit >= 'A' && digit <= 'F' )
+                        code = code * 16 + ( digit - 'A' + 10 );
+                    else
+                        break;
+
+                    pDigitsEnd++;
+                }
+
+                // Write the character if the reference is valid.
+                if ( pDigitsEnd > pDigits && pDigitsEnd < pTextEnd && *pDigitsEnd == ';' && code != 0 && code <= 0x10FFFF )
+                {
+                    pWrite = writeUTF8( code, pWrite );
+                    pRead = (char*)pDigitsEnd + 1;
+                    continue;
+                }
+            }
+            else
+            {
+                // No, so find the entity.
+                U32 entityIndex = 0;
+                while ( entityIndex < sXmlEntityCount &&
+                    ( pRead + sXmlEntities[entityIndex].mLength > pTextEnd || dStrncmp( pRead, sXmlEntities[entityIndex].mpEntity, sXmlEntities[entityIndex].mLength ) != 0 ) )
+                    entityIndex++;
+
+                // Write the character if the entity was found.
+                if ( entityIndex < sXmlEntityCount )
+                {
+                    *pWrite++ = sXmlEntities[entityIndex].mCharacter;
+                    pRead += sXmlEntities[entityIndex].mLength;
+                    continue;
+                }
+            }
+
+            // Drop the ampersand of an unknown entity as TinyXML does.
+            pRead++;
+            continue;
+        }
+
+        *pWrite++ = character;
+        pRead++;
+    }
+
+    return pWrite;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlPullParser::skipPast( const char* pTerminator )
+{
+    char* pFound = dStrstr( (const char*)mpCursor, pTerminator );
+    if ( pFound == NULL )
+        return false;
+
+    mpCursor = pFound + dStrlen( pTerminator );
+    return true;
+}
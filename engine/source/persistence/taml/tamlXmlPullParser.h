@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TAML_XML_PULL_PARSER_H_
+#define _TAML_XML_PULL_PARSER_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class FileStream;
+
+//-----------------------------------------------------------------------------
+
+/// A streaming XML parser that reads a document one token at a time.
+///
+/// The document is read into a single buffer which is then tokenized in
+/// place.  Names, attribute values and text are terminated and have their
+/// entities decoded inside the buffer so no memory is allocated per element
+/// or attribute.  The pointers it returns stay valid until the parser is
+/// destroyed or loads another document.
+///
+/// Whitespace is handled as TinyXML handles it by default so the results
+/// match those of a TiXmlDocument.  Text is trimmed with runs of whitespace
+/// condensed to a single space and whitespace only text is skipped.
+class TamlXmlPullParser
+{
+public:
+    enum TokenType
+    {
+        StartElementToken,
+        EndElementToken,
+        TextToken,
+        EndDocumentToken,
+        ErrorToken
+    };
+
+    struct Attribute
+    {
+        const char* mpName;
+        const char* mpValue;
+    };
+
+    TamlXmlPullParser();
+    ~TamlXmlPullParser();
+
+    /// Reads the remainder of the stream as the document.
+    bool load( FileStream& stream );
+
+    /// Reads the next token.
+    /// An empty element is read as a start element token followed by an end element token.
+    TokenType next( void );
+
+    /// Reads up to and including the end element token of the current start element.
+    bool skipElement( void );
+
+    /// The name of the current start or end element.
+    inline const char* getName( void ) const                        { return mpName; }
+
+    /// The text of the current text token.
+    inline const char* getText( void ) const                        { return mpText; }
+
+    /// The attributes of the current start element.
+    inline U32 getAttributeCount( void ) const                      { return (U32)mAttributes.size(); }
+    inline const Attribute& getAttribute( const U32 index ) const   { return mAttributes[index]; }
+    const char* findAttribute( const char* pName ) const;
+
+    /// The number of elements currently open, including the current start element.
+    inline U32 getDepth( void ) const                               { return (U32)mOpenElements.size(); }
+
+    /// The error for an error token.
+    inline const char* getError( void ) const                       { return mpError; }
+
+    /// The offset of the current token from the start of the document.
+    inline U32 getOffset( void ) const                              { return (U32)(mpTokenStart - mpBuffer); }
+
+#ifdef TORQUE_DEBUG
+    /// The one-based row and column of the current token.
+    void getPosition( U32& row, U32& column ) const;
+#endif
+
+private:
+    TokenType setError( const char* pError );
+    TokenType readStartElement( void );
+    TokenType readEndElement( void );
+    bool readText( void );
+    char* readName( void );
+    char* decodeText( char* pText, char* pTextEnd, const bool condenseWhiteSpace );
+    bool skipPast( const char* pTerminator );
+
+    char*                   mpBuffer;
+    char*                   mpCursor;
+    char*                   mpTokenStart;
+    bool                    mTagOpenConsumed;
+    bool                    mEmptyElementPending;
+
+    const char*             mpName;
+    const char*             mpText;
+    const char*             mpError;
+    Vector<Attribute>       mAttributes;
+    Vector<const char*>     mOpenElements;
+
+#ifdef TORQUE_DEBUG
+    /// The offset of the start of each line, found before the buffer is modified.
+    Vector<U32>             mLineOffsets;
+#endif
+};
+
+#endif // _TAML_XML_PULL_PARSER_H_
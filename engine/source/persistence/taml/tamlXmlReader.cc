@@ -27,24 +27,76 @@
 
 //-----------------------------------------------------------------------------
 
+static const char* findTamlAttribute( const TamlXmlPullParser& xmlParser, StringTableEntry attributeName )
+{
+    // Iterate attributes.
+    const U32 attributeCount = xmlParser.getAttributeCount();
+    for ( U32 index = 0; index < attributeCount; ++index )
+    {
+        const TamlXmlPullParser::Attribute& attribute = xmlParser.getAttribute( index );
+
+        // Skip if not the correct attribute.
+        // NOTE: Names are compared without case as they are by the string table.
+        if ( dStricmp( attribute.mpName, attributeName ) != 0 )
+            continue;
+
+        // Return it.
+        return attribute.mpValue;
+    }
+
+    // Not found.
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
 SimObject* TamlXmlReader::read( FileStream& stream )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_Read);
 
-    // Create document.
-    TiXmlDocument xmlDocument;
+    // Create parser.
+    TamlXmlPullParser xmlParser;
 
     // Load document from stream.
-    if ( !xmlDocument.LoadFile( stream ) )
+    if ( !xmlParser.load( stream ) )
     {
         // Warn!
         Con::warnf("Taml: Could not load Taml XML file from stream.");
         return NULL;
     }
 
+    // Find the root element.
+    TamlXmlPullParser::TokenType tokenType;
+    do
+    {
+        tokenType = xmlParser.next();
+    }
+    while ( tokenType == TamlXmlPullParser::TextToken );
+
+    // Finish if there is no root element.
+    if ( tokenType != TamlXmlPullParser::StartElementToken )
+    {
+        // Warn!
+        Con::warnf("Taml: Could not find a root element in Taml XML file from stream.");
+        return NULL;
+    }
+
     // Parse root element.
-    SimObject* pSimObject = parseElement( xmlDocument.RootElement() );
+    SimObject* pSimObject = parseElement( xmlParser );
+
+    // Did parsing fail part way through the document?
+    if ( xmlParser.getError() != NULL )
+    {
+        // Yes, so warn.
+        Con::warnf("Taml: Could not parse Taml XML file from stream at offset %d: %s", xmlParser.getOffset(), xmlParser.getError() );
+
+        // Discard the incomplete object.
+        if ( pSimObject != NULL )
+            pSimObject->deleteObject();
+
+        pSimObject = NULL;
+    }
 
     // Reset parse.
     resetParse();
@@ -65,7 +117,7 @@ void TamlXmlReader::resetParse( void )
 
 //-----------------------------------------------------------------------------
 
-SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
+SimObject* TamlXmlReader::parseElement( TamlXmlPullParser& xmlParser )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_ParseElement);
@@ -73,15 +125,19 @@ SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
     SimObject* pSimObject = NULL;
 
     // Fetch element name.
-    StringTableEntry typeName = StringTable->insert( pXmlElement->Value() );
+    const char* pElementName = xmlParser.getName();
+    StringTableEntry typeName = StringTable->insert( pElementName );
 
     // Fetch reference to Id.
-    const U32 tamlRefToId = getTamlRefToId( pXmlElement );
+    const U32 tamlRefToId = getTamlRefToId( xmlParser );
 
     // Do we have a reference to Id?
     if ( tamlRefToId != 0 )
     {
-        // Yes, so fetch reference.
+        // Yes, so skip the element.
+        xmlParser.skipElement();
+
+        // Fetch reference.
         typeObjectReferenceHash::iterator referenceItr = mObjectReferenceMap.find( tamlRefToId );
 
         // Did we find the reference?
@@ -97,12 +153,15 @@ SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
     }
 
     // No, so fetch reference Id.
-    const U32 tamlRefId = getTamlRefId( pXmlElement );
+    const U32 tamlRefId = getTamlRefId( xmlParser );
 
 #ifdef TORQUE_DEBUG
     // Format the type location.
+    U32 row;
+    U32 column;
+    xmlParser.getPosition( row, column );
     char typeLocationBuffer[64];
-    dSprintf( typeLocationBuffer, sizeof(typeLocationBuffer), "Taml [format='xml' row=%d column=%d]", pXmlElement->Row(), pXmlElement->Column() );    
+    dSprintf( typeLocationBuffer, sizeof(typeLocationBuffer), "Taml [format='xml' row=%d column=%d]", row, column );    
 
     // Create type.
     pSimObject = Taml::createType( typeName, mpTaml, typeLocationBuffer );
@@ -114,7 +173,11 @@ SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
 
     // Finish if we couldn't create the type.
     if ( pSimObject == NULL )
+    {
+        // Skip the element.
+        xmlParser.skipElement();
         return NULL;
+    }
 
     // Find Taml callbacks.
     TamlCallbacks* pCallbacks = dynamic_cast<TamlCallbacks*>( pSimObject );
@@ -127,10 +190,10 @@ SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
     }
 
     // Parse attributes.
-    parseAttributes( pXmlElement, pSimObject );
+    parseAttributes( xmlParser, pSimObject );
 
     // Fetch object name.
-    StringTableEntry objectName = StringTable->insert( getTamlObjectName( pXmlElement ) );
+    StringTableEntry objectName = StringTable->insert( getTamlObjectName( xmlParser ) );
 
     // Does the object require a name?
     if ( objectName == StringTable->EmptyString )
@@ -163,97 +226,108 @@ SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
         mObjectReferenceMap.insert( tamlRefId, pSimObject );
     }
 
-    // Fetch any children.
-    TiXmlNode* pChildXmlNode = pXmlElement->FirstChild();
-
     TamlCustomNodes customProperties;
 
-    // Do we have any element children?
-    if ( pChildXmlNode != NULL )
+    bool hasChildren = false;
+    TamlChildren* pChildren = NULL;
+    AbstractClassRep* pContainerChildClass = NULL;
+
+    // Iterate children.
+    while ( true )
     {
-        // Fetch the Taml children.
-        TamlChildren* pChildren = dynamic_cast<TamlChildren*>( pSimObject );
+        // Read the next child.
+        const TamlXmlPullParser::TokenType tokenType = xmlParser.next();
+
+        // Finish at the end of the element or if parsing failed.
+        if ( tokenType != TamlXmlPullParser::StartElementToken && tokenType != TamlXmlPullParser::TextToken )
+            break;
+
+        // Is this the first child?
+        if ( !hasChildren )
+        {
+            // Yes, so fetch the Taml children.
+            pChildren = dynamic_cast<TamlChildren*>( pSimObject );
+
+            // Fetch any container child class specifier.
+            pContainerChildClass = pSimObject->getClassRep()->getContainerChildClass( true );
+
+            hasChildren = true;
+        }
+
+        // Skip if this is not an element.
+        if ( tokenType != TamlXmlPullParser::StartElementToken )
+            continue;
 
-        // Fetch any container child class specifier.
-        AbstractClassRep* pContainerChildClass = pSimObject->getClassRep()->getContainerChildClass( true );
+        // Fetch child element name.
+        const char* pChildElementName = xmlParser.getName();
 
-        // Iterate siblings.
-        do
+        // Is this a standard child element?
+        if ( dStrchr( pChildElementName, '.' ) == NULL )
         {
-            // Fetch element.
-            TiXmlElement* pChildXmlElement = dynamic_cast<TiXmlElement*>( pChildXmlNode );
+            // Is this a Taml child?
+            if ( pChildren == NULL )
+            {
+                // No, so warn.
+                Con::warnf("Taml: Child element '%s' found under parent '%s' but object cannot have children.",
+                    pChildElementName,
+                    pElementName );
 
-            // Move to next sibling.
-            pChildXmlNode = pChildXmlNode->NextSibling();
+                // Skip.
+                xmlParser.skipElement();
+                continue;
+            }
+
+            // Yes, so parse child element.
+            SimObject* pChildSimObject = parseElement( xmlParser );
 
-            // Skip if this is not an element?
-            if ( pChildXmlElement == NULL )
+            // Skip if the child was not created.
+            if ( pChildSimObject == NULL )
                 continue;
 
-            // Is this a standard child element?
-            if ( dStrchr( pChildXmlElement->Value(), '.' ) == NULL )
+            // Do we have a container child class?
+            if ( pContainerChildClass != NULL )
             {
-                // Is this a Taml child?
-                if ( pChildren == NULL )
+                // Yes, so is the child object the correctly derived type?
+                if ( !pChildSimObject->getClassRep()->isClass( pContainerChildClass ) )
                 {
                     // No, so warn.
-                    Con::warnf("Taml: Child element '%s' found under parent '%s' but object cannot have children.",
-                        pChildXmlElement->Value(),
-                        pXmlElement->Value() );
-
-                    // Skip.
-                    continue;
-                }
+                    Con::warnf("Taml: Child element '%s' found under parent '%s' but object is restricted to children of type '%s'.",
+                        pChildSimObject->getClassName(),
+                        pSimObject->getClassName(),
+                        pContainerChildClass->getClassName() );
 
-                // Yes, so parse child element.
-                SimObject* pChildSimObject = parseElement( pChildXmlElement );
+                    // NOTE: We can't delete the object as it may be referenced elsewhere!
+                    pChildSimObject = NULL;
 
-                // Skip if the child was not created.
-                if ( pChildSimObject == NULL )
+                    // Skip.
                     continue;
-
-                // Do we have a container child class?
-                if ( pContainerChildClass != NULL )
-                {
-                    // Yes, so is the child object the correctly derived type?
-                    if ( !pChildSimObject->getClassRep()->isClass( pContainerChildClass ) )
-                    {
-                        // No, so warn.
-                        Con::warnf("Taml: Child element '%s' found under parent '%s' but object is restricted to children of type '%s'.",
-                            pChildSimObject->getClassName(),
-                            pSimObject->getClassName(),
-                            pContainerChildClass->getClassName() );
-
-                        // NOTE: We can't delete the object as it may be referenced elsewhere!
-                        pChildSimObject = NULL;
-
-                        // Skip.
-                        continue;
-                    }
                 }
+            }
 
-                // Add child.
-                pChildren->addTamlChild( pChildSimObject );
+            // Add child.
+            pChildren->addTamlChild( pChildSimObject );
 
-                // Find Taml callbacks for child.
-                TamlCallbacks* pChildCallbacks = dynamic_cast<TamlCallbacks*>( pChildSimObject );
+            // Find Taml callbacks for child.
+            TamlCallbacks* pChildCallbacks = dynamic_cast<TamlCallbacks*>( pChildSimObject );
 
-                // Do we have callbacks on the child?
-                if ( pChildCallbacks != NULL )
-                {
-                    // Yes, so perform callback.
-                    mpTaml->tamlAddParent( pChildCallbacks, pSimObject );
-                }
-            }
-            else
+            // Do we have callbacks on the child?
+            if ( pChildCallbacks != NULL )
             {
-                // No, so parse custom element.
-                parseCustomElement( pChildXmlElement, customProperties );
+                // Yes, so perform callback.
+                mpTaml->tamlAddParent( pChildCallbacks, pSimObject );
             }
         }
-        while( pChildXmlNode != NULL );
+        else
+        {
+            // No, so parse custom element.
+            parseCustomElement( xmlParser, customProperties );
+        }
+    }
 
-        // Call custom read.
+    // Did we have any children?
+    if ( hasChildren )
+    {
+        // Yes, so call custom read.
         mpTaml->tamlCustomRead( pCallbacks, customProperties );
     }
 
@@ -270,7 +344,7 @@ SimObject* TamlXmlReader::parseElement( TiXmlElement* pXmlElement )
 
 //-----------------------------------------------------------------------------
 
-void TamlXmlReader::parseAttributes( TiXmlElement* pXmlElement, SimObject* pSimObject )
+void TamlXmlReader::parseAttributes( TamlXmlPullParser& xmlParser, SimObject* pSimObject )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_ParseAttributes);
@@ -279,10 +353,13 @@ void TamlXmlReader::parseAttributes( TiXmlElement* pXmlElement, SimObject* pSimO
     AssertFatal( pSimObject != NULL, "Taml: Cannot parse attributes on a NULL object." );
 
     // Iterate attributes.
-    for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
+    const U32 attributeCount = xmlParser.getAttributeCount();
+    for ( U32 index = 0; index < attributeCount; ++index )
     {
+        const TamlXmlPullParser::Attribute& attribute = xmlParser.getAttribute( index );
+
         // Insert attribute name.
-        StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
+        StringTableEntry attributeName = StringTable->insert( attribute.mpName );
 
         // Ignore if this is a Taml attribute.
         if (    attributeName == tamlRefIdName ||
@@ -291,60 +368,58 @@ void TamlXmlReader::parseAttributes( TiXmlElement* pXmlElement, SimObject* pSimO
             continue;
 
         // We can assume this is a field for now.
-        pSimObject->setPrefixedDataField( attributeName, NULL, pAttribute->Value() );
+        pSimObject->setPrefixedDataField( attributeName, NULL, attribute.mpValue );
     }
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlXmlReader::parseCustomElement( TiXmlElement* pXmlElement, TamlCustomNodes& customNodes )
+void TamlXmlReader::parseCustomElement( TamlXmlPullParser& xmlParser, TamlCustomNodes& customNodes )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_ParseCustomElement);
 
     // Is this a standard child element?
-    const char* pPeriod = dStrchr( pXmlElement->Value(), '.' );
+    const char* pPeriod = dStrchr( xmlParser.getName(), '.' );
 
     // Sanity!
     AssertFatal( pPeriod != NULL, "Parsing extended element but no period character found." );
 
-    // Fetch any custom XML node.
-    TiXmlNode* pCustomXmlNode = pXmlElement->FirstChild();
-
-    // Finish is no XML node exists.
-    if ( pCustomXmlNode == NULL )
-        return;
-
-    // Yes, so add custom node.
-    TamlCustomNode* pCustomNode = customNodes.addNode( pPeriod+1 );
+    // The custom node is only added once the element is found to have children.
+    TamlCustomNode* pCustomNode = NULL;
 
-    do
+    // Iterate children.
+    while ( true )
     {
-        // Fetch element.
-        TiXmlElement* pCustomXmlElement = dynamic_cast<TiXmlElement*>( pCustomXmlNode );
+        // Read the next child.
+        const TamlXmlPullParser::TokenType tokenType = xmlParser.next();
+
+        // Finish at the end of the element or if parsing failed.
+        if ( tokenType != TamlXmlPullParser::StartElementToken && tokenType != TamlXmlPullParser::TextToken )
+            break;
 
-        // Move to next sibling.
-        pCustomXmlNode = pCustomXmlNode->NextSibling();
+        // Add custom node if not already added.
+        if ( pCustomNode == NULL )
+            pCustomNode = customNodes.addNode( pPeriod+1 );
 
         // Skip if this is not an element.
-        if ( pCustomXmlElement == NULL )
+        if ( tokenType != TamlXmlPullParser::StartElementToken )
             continue;
 
         // Parse custom node.
-        parseCustomNode( pCustomXmlElement, pCustomNode );
+        parseCustomNode( xmlParser, pCustomNode );
     }
-    while ( pCustomXmlNode != NULL );
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlXmlReader::parseCustomNode( TiXmlElement* pXmlElement, TamlCustomNode* pCustomNode )
+void TamlXmlReader::parseCustomNode( TamlXmlPullParser& xmlParser, TamlCustomNode* pCustomNode )
 {
     // Is the node a proxy object?
-    if (  getTamlRefId( pXmlElement ) != 0 || getTamlRefToId( pXmlElement ) != 0 )
+    if (  getTamlRefId( xmlParser ) != 0 || getTamlRefToId( xmlParser ) != 0 )
     {
         // Yes, so parse proxy object.
-        SimObject* pProxyObject = parseElement( pXmlElement );
+        SimObject* pProxyObject = parseElement( xmlParser );
 
         // Add child node.
         pCustomNode->addNode( pProxyObject );
@@ -353,131 +428,88 @@ void TamlXmlReader::parseCustomNode( TiXmlElement* pXmlElement, TamlCustomNode*
     }
 
     // Yes, so add child node.
-    TamlCustomNode* pChildNode = pCustomNode->addNode( pXmlElement->Value() );
+    TamlCustomNode* pChildNode = pCustomNode->addNode( xmlParser.getName() );
 
     // Iterate attributes.
-    for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
+    const U32 attributeCount = xmlParser.getAttributeCount();
+    for ( U32 index = 0; index < attributeCount; ++index )
     {
+        const TamlXmlPullParser::Attribute& attribute = xmlParser.getAttribute( index );
+
         // Insert attribute name.
-        StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
+        StringTableEntry attributeName = StringTable->insert( attribute.mpName );
 
         // Skip if a Taml reference attribute.
         if ( attributeName == tamlRefIdName || attributeName == tamlRefToIdName )
             continue;
 
         // Add node field.
-        pChildNode->addField( attributeName, pAttribute->Value() );
+        pChildNode->addField( attributeName, attribute.mpValue );
     }
 
-    // Fetch any element text.
-    const char* pElementText = pXmlElement->GetText();
+    bool firstChild = true;
 
-    // Do we have any element text?
-    if ( pElementText != NULL )
+    // Iterate children.
+    while ( true )
     {
-        // Yes, so store it.
-        pChildNode->setNodeText( pElementText );
-    }
+        // Read the next child.
+        const TamlXmlPullParser::TokenType tokenType = xmlParser.next();
 
-    // Fetch any children.
-    TiXmlNode* pChildXmlNode = pXmlElement->FirstChild();
+        // Finish at the end of the element or if parsing failed.
+        if ( tokenType != TamlXmlPullParser::StartElementToken && tokenType != TamlXmlPullParser::TextToken )
+            break;
 
-    // Do we have any element children?
-    if ( pChildXmlNode != NULL )
-    {
-        do
+        // Is this text?
+        if ( tokenType == TamlXmlPullParser::TextToken )
         {
-            // Yes, so fetch child element.
-            TiXmlElement* pChildXmlElement = dynamic_cast<TiXmlElement*>( pChildXmlNode );
+            // Yes, so store it if it is the first child.
+            if ( firstChild )
+                pChildNode->setNodeText( xmlParser.getText() );
 
-            // Move to next sibling.
-            pChildXmlNode = pChildXmlNode->NextSibling();
+            firstChild = false;
+            continue;
+        }
 
-            // Skip if this is not an element.
-            if ( pChildXmlElement == NULL )
-                continue;
+        firstChild = false;
 
-            // Parse custom node.
-            parseCustomNode( pChildXmlElement, pChildNode );
-        }
-        while( pChildXmlNode != NULL );
+        // Parse custom node.
+        parseCustomNode( xmlParser, pChildNode );
     }
 }
 
 //-----------------------------------------------------------------------------
 
-U32 TamlXmlReader::getTamlRefId( TiXmlElement* pXmlElement )
+U32 TamlXmlReader::getTamlRefId( const TamlXmlPullParser& xmlParser )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_GetTamlRefId);
 
-    // Iterate attributes.
-    for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
-    {
-        // Insert attribute name.
-        StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
-
-        // Skip if not the correct attribute.
-        if ( attributeName != tamlRefIdName )
-            continue;
-
-        // Return it.
-        return dAtoi( pAttribute->Value() );
-    }
+    // Find the attribute.
+    const char* pValue = findTamlAttribute( xmlParser, tamlRefIdName );
 
-    // Not found.
-    return 0;
+    return pValue == NULL ? 0 : dAtoi( pValue );
 }
 
 //-----------------------------------------------------------------------------
 
-U32 TamlXmlReader::getTamlRefToId( TiXmlElement* pXmlElement )
+U32 TamlXmlReader::getTamlRefToId( const TamlXmlPullParser& xmlParser )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_GetTamlRefToId);
 
-    // Iterate attributes.
-    for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
-    {
-        // Insert attribute name.
-        StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
-
-        // Skip if not the correct attribute.
-        if ( attributeName != tamlRefToIdName )
-            continue;
+    // Find the attribute.
+    const char* pValue = findTamlAttribute( xmlParser, tamlRefToIdName );
 
-        // Return it.
-        return dAtoi( pAttribute->Value() );
-    }
-
-    // Not found.
-    return 0;
+    return pValue == NULL ? 0 : dAtoi( pValue );
 }
 
 //-----------------------------------------------------------------------------
 
-const char* TamlXmlReader::getTamlObjectName( TiXmlElement* pXmlElement )
+const char* TamlXmlReader::getTamlObjectName( const TamlXmlPullParser& xmlParser )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlXmlReader_GetTamlObjectName);
 
-    // Iterate attributes.
-    for ( TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next() )
-    {
-        // Insert attribute name.
-        StringTableEntry attributeName = StringTable->insert( pAttribute->Name() );
-
-        // Skip if not the correct attribute.
-        if ( attributeName != tamlNamedObjectName )
-            continue;
-
-        // Return it.
-        return pAttribute->Value();
-    }
-
-    // Not found.
-    return NULL;
+    // Find the attribute.
+    return findTamlAttribute( xmlParser, tamlNamedObjectName );
 }
-
-
-
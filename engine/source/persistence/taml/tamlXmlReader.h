@@ -31,8 +31,8 @@
 #include "persistence/taml/taml.h"
 #endif
 
-#ifndef TINYXML_INCLUDED
-#include "persistence/tinyXML/tinyxml.h"
+#ifndef _TAML_XML_PULL_PARSER_H_
+#include "persistence/taml/tamlXmlPullParser.h"
 #endif
 
 //-----------------------------------------------------------------------------
@@ -59,14 +59,14 @@ private:
 private:
     void resetParse( void );
 
-    SimObject* parseElement( TiXmlElement* pXmlElement );
-    void parseAttributes( TiXmlElement* pXmlElement, SimObject* pSimObject );
-    void parseCustomElement( TiXmlElement* pXmlElement, TamlCustomNodes& pCustomNode );
-    void parseCustomNode( TiXmlElement* pXmlElement, TamlCustomNode* pCustomNode );
+    SimObject* parseElement( TamlXmlPullParser& xmlParser );
+    void parseAttributes( TamlXmlPullParser& xmlParser, SimObject* pSimObject );
+    void parseCustomElement( TamlXmlPullParser& xmlParser, TamlCustomNodes& pCustomNode );
+    void parseCustomNode( TamlXmlPullParser& xmlParser, TamlCustomNode* pCustomNode );
 
-    U32 getTamlRefId( TiXmlElement* pXmlElement );
-    U32 getTamlRefToId( TiXmlElement* pXmlElement );
-    const char* getTamlObjectName( TiXmlElement* pXmlElement );   
+    U32 getTamlRefId( const TamlXmlPullParser& xmlParser );
+    U32 getTamlRefToId( const TamlXmlPullParser& xmlParser );
+    const char* getTamlObjectName( const TamlXmlPullParser& xmlParser );   
 };
 
 #endif // _TAML_XMLREADER_H_
\ No newline at end of file
@@ -20,16 +20,69 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+
 #ifndef _TAML_XML_VISITOR_H_
 #define _TAML_XML_VISITOR_H_
 
-#ifndef TINYXML_INCLUDED
-#include "persistence/tinyXML/tinyxml.h"
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
 #endif
 
 //-----------------------------------------------------------------------------
 
 class TamlXmlParser;
+class TiXmlAttribute;
+
+//-----------------------------------------------------------------------------
+
+/// An attribute presented to a visitor.
+class TamlXmlAttribute
+{
+private:
+    friend class TamlXmlParser;
+
+public:
+    TamlXmlAttribute() :
+        mpName( NULL ),
+        mpValue( NULL ),
+        mpXmlAttribute( NULL ) {}
+
+    inline const char* getName( void ) const { return mpName; }
+    inline const char* getValue( void ) const { return mpValue; }
+
+    /// Changes the value.  Only available when the document is being written.
+    void setValue( const char* pValue );
+
+private:
+    const char*     mpName;
+    const char*     mpValue;
+    TiXmlAttribute* mpXmlAttribute;
+};
+
+//-----------------------------------------------------------------------------
+
+/// An element presented to a visitor.
+class TamlXmlElement
+{
+private:
+    friend class TamlXmlParser;
+
+public:
+    TamlXmlElement() :
+        mpName( NULL ),
+        mRootElement( false ) {}
+
+    inline const char* getName( void ) const { return mpName; }
+    inline bool isRootElement( void ) const { return mRootElement; }
+
+    inline U32 getAttributeCount( void ) const { return (U32)mAttributes.size(); }
+    inline TamlXmlAttribute& getAttribute( const U32 index ) { return mAttributes[index]; }
+
+private:
+    const char*                 mpName;
+    bool                        mRootElement;
+    Vector<TamlXmlAttribute>    mAttributes;
+};
 
 //-----------------------------------------------------------------------------
 
@@ -46,8 +99,8 @@ public:
     virtual bool parse( const char* pFilename ) = 0;
 
 protected:
-    virtual bool visit( TiXmlElement* pXmlElement, TamlXmlParser& xmlParser ) = 0;
-    virtual bool visit( TiXmlAttribute* pAttribute, TamlXmlParser& xmlParser ) = 0;
+    virtual bool visit( TamlXmlElement* pXmlElement, TamlXmlParser& xmlParser ) = 0;
+    virtual bool visit( TamlXmlAttribute* pAttribute, TamlXmlParser& xmlParser ) = 0;
 };
 
-#endif // _TAML_XML_VISITOR_H_
\ No newline at end of file
+#endif // _TAML_XML_VISITOR_H_
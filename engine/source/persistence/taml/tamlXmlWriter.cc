@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+
 #include "persistence/taml/tamlXmlWriter.h"
 
 // Debug Profiling.
@@ -27,77 +28,87 @@
 
 //-----------------------------------------------------------------------------
 
-bool TamlXmlWriter::write( FileStream& stream, const TamlWriteNode* pTamlWriteNode )
-{
-    // Debug Profiling.
-    PROFILE_SCOPE(TamlXmlWriter_Write);
-
-    // Create document.
-    TiXmlDocument xmlDocument;
+#define TAML_XML_WRITER_BUFFER_SIZE     (64 * 1024)
 
-    // Compile the root element.
-    TiXmlElement* pRootElement = compileElement( pTamlWriteNode );
+//-----------------------------------------------------------------------------
 
+TamlXmlWriter::TamlXmlWriter( Taml* pTaml ) :
+    mpTaml( pTaml ),
+    mSchemaLocation( NULL ),
+    mpStream( NULL )
+{
     // Fetch any TAML Schema file reference.
     const char* pTamlSchemaFile = Con::getVariable( TAML_SCHEMA_VARIABLE );
 
-    // Do we have a schema file reference?
-    if ( pTamlSchemaFile != NULL && *pTamlSchemaFile != 0 )
-    {
-        // Yes, so add namespace attribute to root.
-        pRootElement->SetAttribute( "xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance" );
-
-        // Expand the file-path reference.
-        char schemaFilePathBuffer[1024];
-        Con::expandPath( schemaFilePathBuffer, sizeof(schemaFilePathBuffer), pTamlSchemaFile );
-
-        // Fetch the output path for the Taml file.
-        char outputFileBuffer[1024];
-        dSprintf( outputFileBuffer, sizeof(outputFileBuffer), "%s", mpTaml->getFilePathBuffer() );
-        char* pFileStart = dStrrchr( outputFileBuffer, '/' );
-        if ( pFileStart == NULL )
-            *outputFileBuffer = 0;
-        else
-            *pFileStart = 0;
-
-        // Fetch the schema file-path relative to the output file.
-        StringTableEntry relativeSchemaFilePath = Platform::makeRelativePathName( schemaFilePathBuffer, outputFileBuffer );
-
-        // Add schema location attribute to root.
-        pRootElement->SetAttribute( "xsi:noNamespaceSchemaLocation", relativeSchemaFilePath );
-    }
+    // Finish if we do not have a schema file reference.
+    if ( pTamlSchemaFile == NULL || *pTamlSchemaFile == 0 )
+        return;
+
+    // Expand the file-path reference.
+    char schemaFilePathBuffer[1024];
+    Con::expandPath( schemaFilePathBuffer, sizeof(schemaFilePathBuffer), pTamlSchemaFile );
 
-    // Link the root element.
-    xmlDocument.LinkEndChild( pRootElement );
+    // Fetch the output path for the Taml file.
+    char outputFileBuffer[1024];
+    dSprintf( outputFileBuffer, sizeof(outputFileBuffer), "%s", mpTaml->getFilePathBuffer() );
+    char* pFileStart = dStrrchr( outputFileBuffer, '/' );
+    if ( pFileStart == NULL )
+        *outputFileBuffer = 0;
+    else
+        *pFileStart = 0;
 
-    // Save document to stream.
-    return xmlDocument.SaveFile( stream );
+    // Fetch the schema file-path relative to the output file.
+    mSchemaLocation = Platform::makeRelativePathName( schemaFilePathBuffer, outputFileBuffer );
 }
 
 //-----------------------------------------------------------------------------
 
-TiXmlElement* TamlXmlWriter::compileElement( const TamlWriteNode* pTamlWriteNode )
+bool TamlXmlWriter::write( Stream& stream, const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
-    PROFILE_SCOPE(TamlXmlWriter_CompileElement);
+    PROFILE_SCOPE(TamlXmlWriter_Write);
+
+    // Set the output stream.
+    mpStream = &stream;
+    mBuffer.reserve( TAML_XML_WRITER_BUFFER_SIZE );
+
+    // Write the root element.
+    writeElement( pTamlWriteNode, 0 );
+    writeText( "\n" );
 
-    // Fetch object.
-    SimObject* pSimObject = pTamlWriteNode->mpSimObject;
+    // Flush the output.
+    flushBuffer();
+    mpStream = NULL;
+
+    return stream.getStatus() == Stream::Ok;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlXmlWriter::writeElement( const TamlWriteNode* pTamlWriteNode, const U32 depth )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlXmlWriter_WriteElement);
 
     // Fetch element name.
-    const char* pElementName = pSimObject->getClassName();
+    const char* pElementName = pTamlWriteNode->mpTypeName;
 
-    // Create element.
-    TiXmlElement* pElement = new TiXmlElement( pElementName );
+    // Write element start.
+    writeIndent( depth );
+    writeText( "<" );
+    writeText( pElementName );
 
     // Fetch reference Id.
     const U32 referenceId = pTamlWriteNode->mRefId;
 
+    char idBuffer[16];
+
     // Do we have a reference Id?
     if ( referenceId != 0 )
     {
-        // Yes, so set reference Id attribute.
-        pElement->SetAttribute( tamlRefIdName, referenceId );
+        // Yes, so write reference Id attribute.
+        dSprintf( idBuffer, sizeof(idBuffer), "%d", referenceId );
+        writeAttribute( tamlRefIdName, idBuffer, depth + 1 );
     }
 
     // Do we have a reference to node?
@@ -109,11 +120,13 @@ TiXmlElement* TamlXmlWriter::compileElement( const TamlWriteNode* pTamlWriteNode
         // Sanity!
         AssertFatal( referenceToId != 0, "Taml: Invalid reference to Id." );
 
-        // Set reference to Id attribute.
-        pElement->SetAttribute( tamlRefToIdName, referenceToId );
+        // Write reference to Id attribute.
+        dSprintf( idBuffer, sizeof(idBuffer), "%d", referenceToId );
+        writeAttribute( tamlRefToIdName, idBuffer, depth + 1 );
 
         // Finish because we're a reference to another object.
-        return pElement;
+        writeText( " />" );
+        return;
     }
 
     // Fetch object name.
@@ -122,142 +135,193 @@ TiXmlElement* TamlXmlWriter::compileElement( const TamlWriteNode* pTamlWriteNode
     // Do we have a name?
     if ( pObjectName != NULL )
     {
-        // Yes, so set name attribute.
-        pElement->SetAttribute( tamlNamedObjectName, pObjectName );
+        // Yes, so write name attribute.
+        writeAttribute( tamlNamedObjectName, pObjectName, depth + 1 );
     }
 
-    // Compile attributes.
-    compileAttributes( pElement, pTamlWriteNode );
+    // Fetch fields.
+    const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
 
-    // Fetch children.
-    Vector<TamlWriteNode*>* pChildren = pTamlWriteNode->mChildren;
+    // Iterate fields.
+    for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
+    {
+        // Fetch field/value pair.
+        TamlWriteNode::FieldValuePair* pFieldValue = (*itr);
 
-    // Do we have any children?
-    if ( pChildren )
+        // Write field attribute.
+        writeAttribute( pFieldValue->mName, pFieldValue->mpValue, depth + 1 );
+    }
+
+    // Is this the root element and do we have a schema location?
+    if ( depth == 0 && mSchemaLocation != NULL )
     {
-        // Yes, so iterate children.
-        for( Vector<TamlWriteNode*>::iterator itr = pChildren->begin(); itr != pChildren->end(); ++itr )
-        {
-            // Write child element.
-            pElement->LinkEndChild( compileElement( (*itr) ) );
-        }
+        // Yes, so write namespace and schema location attributes.
+        writeAttribute( "xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance", depth + 1 );
+        writeAttribute( "xsi:noNamespaceSchemaLocation", mSchemaLocation, depth + 1 );
     }
 
-    // Compile custom elements.
-    compileCustomElements( pElement, pTamlWriteNode );
+    // Fetch children.
+    Vector<TamlWriteNode*>* pChildren = pTamlWriteNode->mChildren;
+    const bool hasChildren = pChildren != NULL && pChildren->size() > 0;
 
-    return pElement;
-}
+    // Determine if any custom elements will be written.
+    bool hasCustomElements = false;
+    const TamlCustomNodeVector& customNodes = pTamlWriteNode->mCustomNodes.getNodes();
+    for( TamlCustomNodeVector::const_iterator customNodesItr = customNodes.begin(); customNodesItr != customNodes.end() && !hasCustomElements; ++customNodesItr )
+    {
+        // Fetch the custom node.
+        const TamlCustomNode* pCustomNode = *customNodesItr;
 
-//-----------------------------------------------------------------------------
+        // Is the custom element written?
+        if ( !pCustomNode->getIgnoreEmpty() )
+        {
+            // Yes, so flag it.
+            hasCustomElements = true;
+            break;
+        }
 
-void TamlXmlWriter::compileAttributes( TiXmlElement* pXmlElement, const TamlWriteNode* pTamlWriteNode )
-{
-    // Debug Profiling.
-    PROFILE_SCOPE(TamlXmlWriter_CompileAttributes);
+        // Fetch node children.
+        const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
 
-    // Fetch fields.
-    const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
+        // Iterate children nodes.
+        for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+        {
+            // Is the child node written?
+            if ( isCustomNodeWritten( *childNodeItr ) )
+            {
+                // Yes, so the custom element is written.
+                hasCustomElements = true;
+                break;
+            }
+        }
+    }
 
-    // Ignore if no fields.
-    if ( fields.size() == 0 )
+    // Finish if there are no child elements.
+    if ( !hasChildren && !hasCustomElements )
+    {
+        writeText( " />" );
         return;
+    }
 
-    // Iterate fields.
-    for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
-    {
-        // Fetch field/value pair.
-        TamlWriteNode::FieldValuePair* pFieldValue = (*itr);
+    writeText( ">" );
 
-        // Set field attribute.
-        pXmlElement->SetAttribute( pFieldValue->mName, pFieldValue->mpValue );
+    // Do we have any children?
+    if ( hasChildren )
+    {
+        // Yes, so iterate children.
+        for( Vector<TamlWriteNode*>::iterator itr = pChildren->begin(); itr != pChildren->end(); ++itr )
+        {
+            // Write child element.
+            writeText( "\n" );
+            writeElement( (*itr), depth + 1 );
+        }
     }
+
+    // Write custom elements.
+    if ( hasCustomElements )
+        writeCustomElements( pTamlWriteNode, depth + 1 );
+
+    // Write element end.
+    writeText( "\n" );
+    writeIndent( depth );
+    writeText( "</" );
+    writeText( pElementName );
+    writeText( ">" );
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlXmlWriter::compileCustomElements( TiXmlElement* pXmlElement, const TamlWriteNode* pTamlWriteNode )
+void TamlXmlWriter::writeCustomElements( const TamlWriteNode* pTamlWriteNode, const U32 depth )
 {
     // Debug Profiling.
-    PROFILE_SCOPE(TamlXmlWriter_CompileCustomElements);
-
-    // Fetch custom nodes.
-    const TamlCustomNodes& customNodes = pTamlWriteNode->mCustomNodes;
+    PROFILE_SCOPE(TamlXmlWriter_WriteCustomElements);
 
     // Fetch custom nodes.
-    const TamlCustomNodeVector& nodes = customNodes.getNodes();
-
-    // Finish if no custom nodes to process.
-    if ( nodes.size() == 0 )
-        return;
+    const TamlCustomNodeVector& nodes = pTamlWriteNode->mCustomNodes.getNodes();
 
     // Iterate custom nodes.
     for( TamlCustomNodeVector::const_iterator customNodesItr = nodes.begin(); customNodesItr != nodes.end(); ++customNodesItr )
     {
         // Fetch the custom node.
-        TamlCustomNode* pCustomNode = *customNodesItr;
-
-        // Format extended element name.
-        char extendedElementNameBuffer[256];
-        dSprintf( extendedElementNameBuffer, sizeof(extendedElementNameBuffer), "%s.%s", pXmlElement->Value(), pCustomNode->getNodeName() );
-        StringTableEntry extendedElementName = StringTable->insert( extendedElementNameBuffer );
-
-        // Create element.
-        TiXmlElement* pExtendedPropertyElement = new TiXmlElement( extendedElementName );
+        const TamlCustomNode* pCustomNode = *customNodesItr;
 
         // Fetch node children.
         const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
 
-        // Iterate children nodes.
+        // Determine if any children will be written.
+        bool hasChildren = false;
         for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
         {
-            // Fetch child node.
-            const TamlCustomNode* pChildNode = *childNodeItr;
-
-            // Compile the custom node.
-            compileCustomNode( pExtendedPropertyElement, pChildNode );
+            if ( isCustomNodeWritten( *childNodeItr ) )
+            {
+                hasChildren = true;
+                break;
+            }
         }
 
-        // Finish if the node is set to ignore if empty and it is empty.
-        if ( pCustomNode->getIgnoreEmpty() && pExtendedPropertyElement->NoChildren() )
+        // Skip if the node is set to ignore if empty and it is empty.
+        if ( pCustomNode->getIgnoreEmpty() && !hasChildren )
+            continue;
+
+        // Write extended element start.
+        writeText( "\n" );
+        writeIndent( depth );
+        writeText( "<" );
+        writeText( pTamlWriteNode->mpTypeName );
+        writeText( "." );
+        writeText( pCustomNode->getNodeName() );
+
+        // Finish if there are no children.
+        if ( !hasChildren )
         {
-            // Yes, so delete the extended element.
-            delete pExtendedPropertyElement;
-            pExtendedPropertyElement = NULL;
+            writeText( " />" );
+            continue;
         }
-        else
+
+        writeText( ">" );
+
+        // Iterate children nodes.
+        for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
         {
-            // No, so add elementt as child.
-            pXmlElement->LinkEndChild( pExtendedPropertyElement );
+            // Fetch child node.
+            const TamlCustomNode* pChildNode = *childNodeItr;
+
+            // Skip if the child node is not written.
+            if ( !isCustomNodeWritten( pChildNode ) )
+                continue;
+
+            // Write the custom node.
+            writeText( "\n" );
+            writeCustomNode( pChildNode, depth + 1 );
         }
+
+        // Write extended element end.
+        writeText( "\n" );
+        writeIndent( depth );
+        writeText( "</" );
+        writeText( pTamlWriteNode->mpTypeName );
+        writeText( "." );
+        writeText( pCustomNode->getNodeName() );
+        writeText( ">" );
     }
 }
 
 //-----------------------------------------------------------------------------
 
-void TamlXmlWriter::compileCustomNode( TiXmlElement* pXmlElement, const TamlCustomNode* pCustomNode )
+void TamlXmlWriter::writeCustomNode( const TamlCustomNode* pCustomNode, const U32 depth )
 {
-    // Finish if the node is set to ignore if empty and it is empty.
-    if ( pCustomNode->getIgnoreEmpty() && pCustomNode->isEmpty() )
-        return;
-
     // Is the node a proxy object?
     if ( pCustomNode->isProxyObject() )
     {
         // Yes, so write the proxy object.
-        pXmlElement->LinkEndChild( compileElement( pCustomNode->getProxyWriteNode() ) );
+        writeElement( pCustomNode->getProxyWriteNode(), depth );
         return;
     }
 
-    // Create element.
-    TiXmlElement* pNodeElement = new TiXmlElement( pCustomNode->getNodeName() );
-
-    // Is there any node text?
-    if ( !pCustomNode->getNodeTextField().isValueEmpty() )
-    {
-        // Yes, so add a text node.
-        pNodeElement->LinkEndChild( new TiXmlText( pCustomNode->getNodeTextField().getFieldValue() ) );
-    }
+    // Write element start.
+    writeIndent( depth );
+    writeText( "<" );
+    writeText( pCustomNode->getNodeName() );
 
     // Fetch fields.
     const TamlCustomFieldVector& fields = pCustomNode->getFields();
@@ -268,33 +332,213 @@ void TamlXmlWriter::compileCustomNode( TiXmlElement* pXmlElement, const TamlCust
         // Fetch field.
         const TamlCustomField* pField = *fieldItr;
 
-        // Set field.
-        pNodeElement->SetAttribute( pField->getFieldName(), pField->getFieldValue() );
+        // Write field.
+        writeAttribute( pField->getFieldName(), pField->getFieldValue(), depth + 1 );
     }
 
+    // Fetch any node text.
+    const bool hasNodeText = !pCustomNode->getNodeTextField().isValueEmpty();
+
     // Fetch node children.
     const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
 
+    // Determine if any children will be written.
+    bool hasChildren = false;
+    for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+    {
+        if ( isCustomNodeWritten( *childNodeItr ) )
+        {
+            hasChildren = true;
+            break;
+        }
+    }
+
+    // Finish if there is no content.
+    if ( !hasNodeText && !hasChildren )
+    {
+        writeText( " />" );
+        return;
+    }
+
+    writeText( ">" );
+
+    // Is there any node text?
+    if ( hasNodeText )
+    {
+        // Yes, so write it.
+        writeEncodedText( pCustomNode->getNodeTextField().getFieldValue() );
+
+        // Finish if the text is the only content.
+        if ( !hasChildren )
+        {
+            writeText( "</" );
+            writeText( pCustomNode->getNodeName() );
+            writeText( ">" );
+            return;
+        }
+    }
+
     // Iterate children nodes.
     for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
     {
         // Fetch child node.
         const TamlCustomNode* pChildNode = *childNodeItr;
 
-        // Compile the child node.
-        compileCustomNode( pNodeElement, pChildNode );
+        // Skip if the child node is not written.
+        if ( !isCustomNodeWritten( pChildNode ) )
+            continue;
+
+        // Write the child node.
+        writeText( "\n" );
+        writeCustomNode( pChildNode, depth + 1 );
     }
 
-    // Finish if the node is set to ignore if empty and it is empty (including fields).
-    if ( pCustomNode->getIgnoreEmpty() && fields.size() == 0 && pNodeElement->NoChildren() )
+    // Write element end.
+    writeText( "\n" );
+    writeIndent( depth );
+    writeText( "</" );
+    writeText( pCustomNode->getNodeName() );
+    writeText( ">" );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlWriter::isCustomNodeWritten( const TamlCustomNode* pCustomNode ) const
+{
+    // Is the node set to ignore if empty?
+    if ( !pCustomNode->getIgnoreEmpty() )
+        return true;
+
+    // Not written if it is empty.
+    if ( pCustomNode->isEmpty() )
+        return false;
+
+    // Proxy objects are always written.
+    if ( pCustomNode->isProxyObject() )
+        return true;
+
+    // Written if there are any fields or node text.
+    if ( pCustomNode->getFields().size() > 0 || !pCustomNode->getNodeTextField().isValueEmpty() )
+        return true;
+
+    // Written if any child node is written.
+    const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+    for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
     {
-        // Yes, so delete the extended element.
-        delete pNodeElement;
-        pNodeElement = NULL;
+        if ( isCustomNodeWritten( *childNodeItr ) )
+            return true;
     }
-    else
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlXmlWriter::writeAttribute( const char* pAttributeName, const char* pAttributeValue, const U32 depth )
+{
+    // Attributes are written on their own line.
+    writeText( "\n" );
+    writeIndent( depth );
+    writeEncodedText( pAttributeName );
+
+    // Quote with apostrophes if the value contains quotes.
+    const char* pQuote = dStrchr( pAttributeValue, '\"' ) == NULL ? "\"" : "'";
+
+    writeText( "=" );
+    writeText( pQuote );
+    writeEncodedText( pAttributeValue );
+    writeText( pQuote );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlXmlWriter::writeIndent( const U32 depth )
+{
+    for ( U32 index = 0; index < depth; ++index )
+        writeText( "    " );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlXmlWriter::writeText( const char* pText )
+{
+    // Append the text.
+    mBuffer.increment( pText, dStrlen( pText ) );
+
+    // Flush if the buffer is full.
+    if ( mBuffer.size() >= TAML_XML_WRITER_BUFFER_SIZE )
+        flushBuffer();
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlXmlWriter::writeEncodedText( const char* pText )
+{
+    // Encode the text.
+    const char* pSpan = pText;
+    while ( *pText != 0 )
     {
-        // Add node element as child.
-        pXmlElement->LinkEndChild( pNodeElement );
+        const U8 c = (U8)*pText;
+
+        // Pass hexadecimal character references through unchanged.
+        // NOTE: The terminating character is encoded as normal.
+        if ( c == '&' && pText[1] == '#' && pText[2] == 'x' )
+        {
+            while ( pText[1] != 0 )
+            {
+                ++pText;
+                if ( *pText == ';' )
+                    break;
+            }
+            continue;
+        }
+
+        const char* pEntity = NULL;
+        char characterBuffer[8];
+
+        switch( c )
+        {
+            case '&':   pEntity = "&amp;"; break;
+            case '<':   pEntity = "&lt;"; break;
+            case '>':   pEntity = "&gt;"; break;
+            case '\"':  pEntity = "&quot;"; break;
+            case '\'':  pEntity = "&apos;"; break;
+
+            default:
+                if ( c < 32 )
+                {
+                    dSprintf( characterBuffer, sizeof(characterBuffer), "&#x%02X;", c );
+                    pEntity = characterBuffer;
+                }
+                break;
+        }
+
+        // Skip if the character does not need encoding.
+        if ( pEntity == NULL )
+        {
+            ++pText;
+            continue;
+        }
+
+        // Write the span before the character then the entity.
+        mBuffer.increment( pSpan, (U32)(pText - pSpan) );
+        mBuffer.increment( pEntity, dStrlen( pEntity ) );
+        pSpan = ++pText;
     }
+
+    // Write the remaining span.
+    writeText( pSpan );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlXmlWriter::flushBuffer( void )
+{
+    // Finish if nothing to write.
+    if ( mBuffer.size() == 0 )
+        return;
+
+    // Write the buffer.
+    mpStream->write( mBuffer.size(), mBuffer.address() );
+    mBuffer.clear();
 }
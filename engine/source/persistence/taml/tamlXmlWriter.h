@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+
 #ifndef _TAML_XMLWRITER_H_
 #define _TAML_XMLWRITER_H_
 
@@ -27,31 +28,40 @@
 #include "persistence/taml/taml.h"
 #endif
 
-#ifndef TINYXML_INCLUDED
-#include "persistence/tinyXML/tinyxml.h"
-#endif
-
 //-----------------------------------------------------------------------------
 
+/// Writes Taml XML directly to a stream without building a document.
+///
+/// The output matches what the document writer produced previously.  Any
+/// schema location is resolved when the writer is constructed so that
+/// write() only touches the write nodes and the stream and can therefore
+/// run on a worker thread.
 class TamlXmlWriter
 {
 public:
-    TamlXmlWriter( Taml* pTaml ) :
-        mpTaml( pTaml )
-    {}
+    TamlXmlWriter( Taml* pTaml );
     virtual ~TamlXmlWriter() {}
 
     /// Write.
-    bool write( FileStream& stream, const TamlWriteNode* pTamlWriteNode );
+    bool write( Stream& stream, const TamlWriteNode* pTamlWriteNode );
 
 private:
-    Taml* mpTaml;
+    Taml*               mpTaml;
+    StringTableEntry    mSchemaLocation;
+    Stream*             mpStream;
+    Vector<char>        mBuffer;
 
 private:
-    TiXmlElement* compileElement( const TamlWriteNode* pTamlWriteNode );
-    void compileAttributes( TiXmlElement* pXmlElement, const TamlWriteNode* pTamlWriteNode );
-    void compileCustomElements( TiXmlElement* pXmlElement, const TamlWriteNode* pTamlWriteNode );
-    void compileCustomNode( TiXmlElement* pXmlElement, const TamlCustomNode* pCustomNode );
+    void writeElement( const TamlWriteNode* pTamlWriteNode, const U32 depth );
+    void writeCustomElements( const TamlWriteNode* pTamlWriteNode, const U32 depth );
+    void writeCustomNode( const TamlCustomNode* pCustomNode, const U32 depth );
+    bool isCustomNodeWritten( const TamlCustomNode* pCustomNode ) const;
+
+    void writeAttribute( const char* pAttributeName, const char* pAttributeValue, const U32 depth );
+    void writeIndent( const U32 depth );
+    void writeText( const char* pText );
+    void writeEncodedText( const char* pText );
+    void flushBuffer( void );
 };
 
 #endif // _TAML_XMLWRITER_H_
\ No newline at end of file
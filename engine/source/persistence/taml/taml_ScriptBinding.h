@@ -179,6 +179,32 @@ ConsoleMethod(Taml, write, bool, 4, 4,  "(object, filename) - Writes an object t
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(Taml, writeAsync, bool, 4, 4, "(object, filename) - Writes an object to a file using Taml without waiting for the file to be written.\n"
+                                            "The object state is captured immediately so the object can be changed or deleted straight away.\n"
+                                            "Once written, 'onWriteCompleted(filename, success)' is called on the Taml object.\n"
+                                            "@param object The object to write.\n"
+                                            "@param filename The filename to write to.\n"
+                                            "@return Whether the write was started or not.")
+{
+    // Fetch filename.
+    const char* pFilename = argv[3];
+
+    // Find object.
+    SimObject* pSimObject = Sim::findObject( argv[2] );
+
+    // Did we find the object?
+    if ( pSimObject == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Taml::writeAsync() - Could not find object '%s' to write to file '%s'.", argv[2], pFilename );
+        return false;
+    }
+
+    return object->writeAsync( pSimObject, pFilename );
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Taml, read, const char*, 3, 3,    "(filename) - Read an object from a file using Taml.\n"
                                                 "@param filename The filename to read from.\n"
                                                 "@return (Object) The object read from the file or an empty string if read failed.")
@@ -206,7 +232,7 @@ ConsoleFunction(TamlWrite, bool, 3, 5,  "(object, filename, [format], [compresse
                                         "@param object The object to write.\n"
                                         "@param filename The filename to write to.\n"
                                         "@param format The file format to use.  Optional: Defaults to 'xml'.  Can be set to 'binary'.\n"
-                                        "@param compressed Whether ZIP compression is used on binary formatting or not.  Optional: Defaults to 'true'.\n"
+                                        "@param compressed Whether ZIP compression is used on binary formatting or not.  Optional: Defaults to 'false'.\n"
                                         "@return Whether the write was successful or not.")
 {
     // Fetch filename.
@@ -167,6 +167,8 @@ struct Platform
     static U32 getTime( void );
     static U32 getVirtualMilliseconds( void );
     static U32 getRealMilliseconds( void );
+    static U64 getPerformanceCounter( void );
+    static U64 getPerformanceCounterFrequency( void );
     static void advanceTime(U32 delta);
     static S32 getBackgroundSleepTime();
     static void getLocalTime(LocalTime &);
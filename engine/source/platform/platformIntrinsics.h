@@ -0,0 +1,182 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _PLATFORM_INTRINSICS_H_
+#define _PLATFORM_INTRINSICS_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+#if defined(TORQUE_COMPILER_VISUALC)
+#include <intrin.h>
+#pragma intrinsic(_InterlockedCompareExchange)
+#pragma intrinsic(_InterlockedExchangeAdd)
+#pragma intrinsic(_ReadWriteBarrier)
+#endif
+
+//-----------------------------------------------------------------------------
+/// @name Atomic Operations
+///
+/// Minimal set of atomic primitives used by the lock-free parts of the engine.
+/// Reads have acquire semantics and writes have release semantics so that a
+/// pointer published with dAtomicWritePtr() can be safely followed by a reader
+/// that fetched it with dAtomicReadPtr().
+/// @{
+
+#if defined(TORQUE_COMPILER_VISUALC)
+
+/// Full memory barrier.
+inline void dMemoryBarrier()
+{
+   long barrier = 0;
+   _InterlockedExchangeAdd( &barrier, 0 );
+}
+
+inline U32 dAtomicRead( volatile U32& ref )
+{
+   const U32 value = ref;
+   _ReadWriteBarrier();
+   return value;
+}
+
+inline void dAtomicWrite( volatile U32& ref, const U32 value )
+{
+   _ReadWriteBarrier();
+   ref = value;
+}
+
+/// Atomically adds the value and returns the value prior to the addition.
+inline U32 dFetchAndAdd( volatile U32& ref, const U32 value )
+{
+   return (U32)_InterlockedExchangeAdd( (volatile long*)&ref, (long)value );
+}
+
+inline bool dCompareAndSwap( volatile U32& ref, const U32 oldValue, const U32 newValue )
+{
+   return (U32)_InterlockedCompareExchange( (volatile long*)&ref, (long)newValue, (long)oldValue ) == oldValue;
+}
+
+template< class T > inline T* dAtomicReadPtr( T* volatile& ref )
+{
+   T* value = ref;
+   _ReadWriteBarrier();
+   return value;
+}
+
+template< class T > inline void dAtomicWritePtr( T* volatile& ref, T* value )
+{
+   _ReadWriteBarrier();
+   ref = value;
+}
+
+template< class T > inline bool dCompareAndSwapPtr( T* volatile& ref, T* oldValue, T* newValue )
+{
+   return (T*)_InterlockedCompareExchange( (volatile long*)&ref, (long)newValue, (long)oldValue ) == oldValue;
+}
+
+#elif defined(TORQUE_COMPILER_GCC)
+
+/// Full memory barrier.
+inline void dMemoryBarrier()
+{
+   __sync_synchronize();
+}
+
+/// Barrier used to order plain loads and stores around an atomic read or
+/// write.  x86 never reorders loads with loads or stores with stores so only
+/// the compiler needs to be restrained there.
+inline void dAcquireReleaseBarrier()
+{
+#if defined(__i386__) || defined(__x86_64__)
+   __asm__ __volatile__( "" ::: "memory" );
+#else
+   __sync_synchronize();
+#endif
+}
+
+inline U32 dAtomicRead( volatile U32& ref )
+{
+   const U32 value = ref;
+   dAcquireReleaseBarrier();
+   return value;
+}
+
+inline void dAtomicWrite( volatile U32& ref, const U32 value )
+{
+   dAcquireReleaseBarrier();
+   ref = value;
+}
+
+/// Atomically adds the value and returns the value prior to the addition.
+inline U32 dFetchAndAdd( volatile U32& ref, const U32 value )
+{
+   return __sync_fetch_and_add( &ref, value );
+}
+
+inline bool dCompareAndSwap( volatile U32& ref, const U32 oldValue, const U32 newValue )
+{
+   return __sync_bool_compare_and_swap( &ref, oldValue, newValue );
+}
+
+template< class T > inline T* dAtomicReadPtr( T* volatile& ref )
+{
+   T* value = ref;
+   dAcquireReleaseBarrier();
+   return value;
+}
+
+template< class T > inline void dAtomicWritePtr( T* volatile& ref, T* value )
+{
+   dAcquireReleaseBarrier();
+   ref = value;
+}
+
+template< class T > inline bool dCompareAndSwapPtr( T* volatile& ref, T* oldValue, T* newValue )
+{
+   return __sync_bool_compare_and_swap( &ref, oldValue, newValue );
+}
+
+#else
+#  error "Atomic operations are not implemented for this compiler"
+#endif
+
+/// @}
+
+//-----------------------------------------------------------------------------
+/// @name Thread Local Storage
+///
+/// TORQUE_THREAD_LOCAL qualifies a static or global POD variable so that each
+/// thread gets its own copy.  It is left undefined on targets without
+/// compiler supported thread local storage so callers must provide a fallback.
+/// @{
+
+#if defined(TORQUE_COMPILER_VISUALC)
+#  define TORQUE_THREAD_LOCAL __declspec(thread)
+#elif defined(TORQUE_COMPILER_GCC) && !defined(TORQUE_OS_IOS)
+#  define TORQUE_THREAD_LOCAL __thread
+#endif
+
+/// @}
+
+#endif // _PLATFORM_INTRINSICS_H_
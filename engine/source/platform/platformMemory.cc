@@ -26,25 +26,26 @@
 #include "debug/profiler.h"
 #include "platform/threads/mutex.h"
 #include "math/mMath.h"
+#include "memory/memoryAllocator.h"
 #include <stdlib.h>
 
 //-----------------------------------------------------------------------------
 
 void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
 {
-   return malloc(in_size);
+   return MemoryAllocator::allocate(in_size);
 }
 
 //-----------------------------------------------------------------------------
 
 void dFree(void* in_pFree)
 {
-   free(in_pFree);
+   MemoryAllocator::free(in_pFree);
 }
 
 //-----------------------------------------------------------------------------
 
 void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
 {
-   return realloc(in_pResize,in_size);
+   return MemoryAllocator::reallocate(in_pResize,in_size);
 }
@@ -0,0 +1,244 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/threads/threadPool.h"
+#include "platform/threads/thread.h"
+#include "platform/platform.h"
+#include "memory/frameAllocator.h"
+
+//-----------------------------------------------------------------------------
+
+ThreadPool* ThreadPool::smGlobalPool = NULL;
+
+//-----------------------------------------------------------------------------
+
+ThreadPool::ThreadPool( const U32 workerCount ) :
+   mQueueHead( 0 ),
+   mExecutingCount( 0 ),
+   mWorkSemaphore( 0 ),
+   mShutdown( false )
+{
+   for ( U32 i = 0; i < workerCount; ++i )
+      mWorkers.push_back( new Thread( workerMain, this ) );
+}
+
+//-----------------------------------------------------------------------------
+
+ThreadPool::~ThreadPool()
+{
+   // Wake every worker so it sees the shutdown flag.
+   mMutex.lock();
+   mShutdown = true;
+   mMutex.unlock();
+
+   for ( S32 i = 0; i < mWorkers.size(); ++i )
+      mWorkSemaphore.release();
+
+   for ( S32 i = 0; i < mWorkers.size(); ++i )
+   {
+      mWorkers[i]->join();
+      delete mWorkers[i];
+   }
+   mWorkers.clear();
+
+   for ( U32 i = mQueueHead; i < (U32)mQueue.size(); ++i )
+      delete mQueue[i];
+   mQueue.clear();
+
+   for ( S32 i = 0; i < mCompleted.size(); ++i )
+      delete mCompleted[i];
+   mCompleted.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::queueWorkItem( WorkItem* pWorkItem )
+{
+   AssertFatal( pWorkItem != NULL, "ThreadPool::queueWorkItem() - Cannot queue a NULL work item." );
+
+   mMutex.lock();
+   mQueue.push_back( pWorkItem );
+   mMutex.unlock();
+
+   mWorkSemaphore.release();
+}
+
+//-----------------------------------------------------------------------------
+
+ThreadPool::WorkItem* ThreadPool::takeWorkItem( void )
+{
+   MutexHandle handle;
+   handle.lock( &mMutex, true );
+
+   if ( mQueueHead == (U32)mQueue.size() )
+      return NULL;
+
+   WorkItem* pWorkItem = mQueue[mQueueHead++];
+
+   // Reuse the queue storage once it has drained.
+   if ( mQueueHead == (U32)mQueue.size() )
+   {
+      mQueue.clear();
+      mQueueHead = 0;
+   }
+
+   mExecutingCount++;
+   return pWorkItem;
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::executeWorkItem( WorkItem* pWorkItem )
+{
+   pWorkItem->execute();
+
+   mMutex.lock();
+   mCompleted.push_back( pWorkItem );
+   mExecutingCount--;
+   mMutex.unlock();
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ThreadPool::processCompleted( void )
+{
+   // Without workers the main thread does the work.
+   if ( mWorkers.size() == 0 )
+   {
+      while ( mWorkSemaphore.acquire( false ) )
+      {
+         WorkItem* pWorkItem = takeWorkItem();
+         if ( pWorkItem != NULL )
+            executeWorkItem( pWorkItem );
+      }
+   }
+
+   mMutex.lock();
+   if ( mCompleted.size() == 0 )
+   {
+      mMutex.unlock();
+      return 0;
+   }
+   Vector<WorkItem*> completed;
+   completed.swap( mCompleted );
+   mMutex.unlock();
+
+   // Items completed here may queue more work.
+   for ( S32 i = 0; i < completed.size(); ++i )
+   {
+      completed[i]->onCompleted();
+      delete completed[i];
+   }
+
+   return (U32)completed.size();
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::flush( void )
+{
+   while ( getPendingCount() > 0 )
+   {
+      // Help with the queued work rather than waiting for it.
+      WorkItem* pWorkItem = takeWorkItem();
+      if ( pWorkItem != NULL )
+      {
+         executeWorkItem( pWorkItem );
+         continue;
+      }
+
+      if ( processCompleted() == 0 )
+         Platform::sleep( 0 );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::waitUntil( const bool& flag )
+{
+   while ( !flag && getPendingCount() > 0 )
+   {
+      // Help with the queued work rather than waiting for it.
+      WorkItem* pWorkItem = takeWorkItem();
+      if ( pWorkItem != NULL )
+      {
+         executeWorkItem( pWorkItem );
+         continue;
+      }
+
+      if ( processCompleted() == 0 )
+         Platform::sleep( 0 );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ThreadPool::getPendingCount( void )
+{
+   MutexHandle handle;
+   handle.lock( &mMutex, true );
+
+   return ( (U32)mQueue.size() - mQueueHead ) + mExecutingCount + (U32)mCompleted.size();
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::workerMain( void* pArg )
+{
+   ThreadPool* pPool = static_cast<ThreadPool*>( pArg );
+
+   while ( true )
+   {
+      pPool->mWorkSemaphore.acquire();
+
+      pPool->mMutex.lock();
+      const bool shutdown = pPool->mShutdown;
+      pPool->mMutex.unlock();
+
+      if ( shutdown )
+         break;
+
+      // The queue may already have been drained by flush().
+      WorkItem* pWorkItem = pPool->takeWorkItem();
+      if ( pWorkItem != NULL )
+         pPool->executeWorkItem( pWorkItem );
+   }
+
+   FrameAllocator::releaseThread();
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::init( const U32 workerCount )
+{
+   AssertFatal( smGlobalPool == NULL, "ThreadPool::init() - The global pool already exists." );
+
+   smGlobalPool = new ThreadPool( workerCount );
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadPool::shutdown( void )
+{
+   delete smGlobalPool;
+   smGlobalPool = NULL;
+}
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _PLATFORM_THREADS_THREADPOOL_H_
+#define _PLATFORM_THREADS_THREADPOOL_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+#ifndef _PLATFORM_INTRINSICS_H_
+#include "platform/platformIntrinsics.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class Thread;
+
+//-----------------------------------------------------------------------------
+
+/// A fixed set of worker threads that execute queued work items.
+///
+/// A work item is executed on a worker and then handed back to the main
+/// thread which calls onCompleted() from processCompleted() before deleting
+/// it.  Work that touches the console, the simulation or GL must therefore
+/// be done in onCompleted() rather than in execute().
+///
+/// A pool with no workers executes its queued items on the main thread
+/// from processCompleted() so callers never need a separate code path.
+class ThreadPool
+{
+public:
+   class WorkItem
+   {
+   public:
+      virtual ~WorkItem() {}
+
+      /// Called on a worker thread.
+      virtual void execute( void ) = 0;
+
+      /// Called on the main thread once execute() has returned.
+      virtual void onCompleted( void ) {}
+   };
+
+#ifdef TORQUE_THREAD_LOCAL
+   enum { DefaultWorkerCount = 2 };
+#else
+   /// Work items rely on each thread having its own frame allocator arena.
+   enum { DefaultWorkerCount = 0 };
+#endif
+
+   ThreadPool( const U32 workerCount );
+
+   /// Stops the workers.  Items still queued are deleted without being executed.
+   ~ThreadPool();
+
+   inline U32 getWorkerCount( void ) const     { return (U32)mWorkers.size(); }
+
+   /// Queues a work item.  The pool takes ownership of it.
+   void queueWorkItem( WorkItem* pWorkItem );
+
+   /// Calls onCompleted() for the items that have finished executing.
+   /// Must be called from the main thread.
+   /// @return The number of items completed.
+   U32 processCompleted( void );
+
+   /// Executes and completes every queued item before returning, including
+   /// any queued by onCompleted().  The calling thread helps with the work.
+   void flush( void );
+
+   /// Helps with the queued work and completes finished items until the flag
+   /// is set, typically by the onCompleted() of the item being waited for.
+   /// Returns early if the pool runs out of work with the flag still clear.
+   void waitUntil( const bool& flag );
+
+   /// The number of items queued, executing or awaiting completion.
+   U32 getPendingCount( void );
+
+   /// @name Global Pool
+   /// @{
+
+   static void init( const U32 workerCount = DefaultWorkerCount );
+   static void shutdown( void );
+   static inline ThreadPool* getGlobal( void ) { return smGlobalPool; }
+
+   /// @}
+
+private:
+   static void workerMain( void* pArg );
+
+   WorkItem* takeWorkItem( void );
+   void executeWorkItem( WorkItem* pWorkItem );
+
+   Vector<Thread*>      mWorkers;
+   Vector<WorkItem*>    mQueue;
+   U32                  mQueueHead;
+   Vector<WorkItem*>    mCompleted;
+   U32                  mExecutingCount;
+   Mutex                mMutex;
+   Semaphore            mWorkSemaphore;
+   bool                 mShutdown;
+
+   static ThreadPool*   smGlobalPool;
+};
+
+#endif // _PLATFORM_THREADS_THREADPOOL_H_
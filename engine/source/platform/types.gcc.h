@@ -52,6 +52,10 @@ typedef unsigned long long  U64;
 #  define TORQUE_COMPILER_STRING "GCC "
 #endif
 
+#if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__)
+#  define TORQUE_SUPPORTS_RVALUE_REFERENCES
+#endif
+
 
 //--------------------------------------
 // Identify the Operating System
@@ -49,6 +49,7 @@ typedef unsigned _int64 U64;
 #  define for if(false) {} else for   ///< Hack to work around Microsoft VC's non-C++ compliance on variable scoping
 #else
 #  define TORQUE_COMPILER_STRING "VisualC++"
+#  define TORQUE_SUPPORTS_RVALUE_REFERENCES  ///< Move constructors are available from VC++ 2010.
 #endif
 
 
@@ -24,6 +24,8 @@
 #import <stdlib.h>
 #import <errno.h>
 #import "memory/safeDelete.h"
+#import "memory/frameAllocator.h"
+#import "debug/profiler.h"
 #import "platform/threads/thread.h"
 #import "platform/platformSemaphore.h"
 #import "platform/threads/mutex.h"
@@ -61,6 +63,14 @@ static void *ThreadRunHandler( void* arg )
     thread->run(mData->mRunArg);
     [pool drain];
     
+    // Release the frame allocator arena of the thread.
+    FrameAllocator::releaseThread();
+    
+#ifdef TORQUE_ENABLE_PROFILER
+    // Release the profiler capture buffer of the thread.
+    Profiler::releaseThread();
+#endif
+    
     // Release the thread.
     mData->mGateway.release();
     
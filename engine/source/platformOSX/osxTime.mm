@@ -23,6 +23,7 @@
 #import "platformOSX/platformOSX.h"
 #import "platform/event.h"
 #import "game/gameInterface.h"
+#import <mach/mach_time.h>
 
 #pragma mark ---- TimeManager Class Methods ----
 
@@ -105,6 +106,29 @@ U32 Platform::getRealMilliseconds()
     return (U32)([NSDate timeIntervalSinceReferenceDate] * 1000);
 }
 
+//------------------------------------------------------------------------------
+// Gets a monotonic high resolution counter.
+U64 Platform::getPerformanceCounter()
+{
+    return mach_absolute_time();
+}
+
+//------------------------------------------------------------------------------
+// Gets the number of performance counter ticks per second.
+U64 Platform::getPerformanceCounterFrequency()
+{
+    static U64 frequency = 0;
+    
+    if (frequency == 0)
+    {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        frequency = (1000000000ULL * timebase.denom) / timebase.numer;
+    }
+    
+    return frequency;
+}
+
 //------------------------------------------------------------------------------
 // Gets the running time for this app in milliseconds
 U32 Platform::getVirtualMilliseconds()
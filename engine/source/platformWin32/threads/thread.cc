@@ -24,6 +24,8 @@
 #include "platform/threads/semaphore.h"
 #include "platformWin32/platformWin32.h"
 #include "memory/safeDelete.h"
+#include "memory/frameAllocator.h"
+#include "debug/profiler.h"
 
 #include <process.h> // [tom, 4/20/2006] for _beginthread()
 
@@ -67,6 +69,10 @@ static void ThreadRunHandler(void * arg)
    
    ThreadManager::addThread(mData->mThread);
    mData->mThread->run(mData->mRunArg);
+   FrameAllocator::releaseThread();
+#ifdef TORQUE_ENABLE_PROFILER
+   Profiler::releaseThread();
+#endif
    ThreadManager::removeThread(mData->mThread);
 
    // we could delete the Thread here, if it wants to be auto-deleted...
@@ -143,12 +143,13 @@ bool Platform::pathCopy(const char *fromName, const char *toName, bool nooverwri
       !toName || (dStrlen(toName) >= MAX_PATH))
       return(false);
 
-   static char filebuf[2048];
+   // NOTE: Files are copied and opened from worker threads so the path buffers must not be static.
+   char filebuf[MAX_PATH];
    dStrcpy(filebuf, fromName);
    backslash(filebuf);
    fromName = filebuf;
 
-   static char filebuf2[2048];
+   char filebuf2[MAX_PATH];
    dStrcpy(filebuf2, toName);
    backslash(filebuf2);
    toName = filebuf2;
@@ -283,8 +284,10 @@ File::~File()
 //-----------------------------------------------------------------------------
 File::Status File::open(const char *filename, const AccessMode openMode)
 {
-   static char filebuf[2048];
-   dStrcpy(filebuf, filename);
+   // NOTE: Files are opened from worker threads so the path buffer must not be static.
+   char filebuf[2048];
+   dStrncpy(filebuf, filename, sizeof(filebuf) - 1);
+   filebuf[sizeof(filebuf) - 1] = 0;
    backslash(filebuf);
 #ifdef UNICODE
    UTF16 fname[2048];
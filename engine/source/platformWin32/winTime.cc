@@ -56,6 +56,21 @@ U32 Platform::getTime()
 }
 
 
+U64 Platform::getPerformanceCounter()
+{
+   LARGE_INTEGER counter;
+   QueryPerformanceCounter( &counter );
+   return (U64)counter.QuadPart;
+}
+
+U64 Platform::getPerformanceCounterFrequency()
+{
+   static LARGE_INTEGER frequency = { 0 };
+   if ( frequency.QuadPart == 0 )
+      QueryPerformanceFrequency( &frequency );
+   return (U64)frequency.QuadPart;
+}
+
 U32 Platform::getRealMilliseconds()
 {
    return GetTickCount();
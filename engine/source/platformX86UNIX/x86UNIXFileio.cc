@@ -246,8 +246,9 @@ bool dPathCopy(const char *fromName, const char *toName, bool nooverwrite)
  // will be examined (everything before last /)
  bool DirExists(char* pathname, bool isFile)
  {
-    static char testpath[20000];
+    char testpath[MaxPath];
     dStrncpy(testpath, pathname, sizeof(testpath));
+    testpath[sizeof(testpath) - 1] = 0;
     if (isFile)
     {
        // find the last / and make it into null
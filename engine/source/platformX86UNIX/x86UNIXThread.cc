@@ -25,6 +25,8 @@
 #include "platform/platformThread.h"
 #include "platformX86UNIX/platformX86UNIX.h"
 #include "platform/platformSemaphore.h"
+#include "memory/frameAllocator.h"
+#include "debug/profiler.h"
 
 #include <SDL/SDL.h>
 #include <SDL/SDL_thread.h>
@@ -76,6 +78,10 @@ static int ThreadRunHandler(void * arg)
 {
    x86UNIXThreadData * threadData = reinterpret_cast<x86UNIXThreadData*>(arg);
    threadData->mThread->run(threadData->mRunArg);
+   FrameAllocator::releaseThread();
+#ifdef TORQUE_ENABLE_PROFILER
+   Profiler::releaseThread();
+#endif
    Semaphore::releaseSemaphore(threadData->mSemaphore);
    return 0;
 }
@@ -67,6 +67,18 @@ U32 Platform::getRealMilliseconds()
    return x86UNIXGetTickCount();
 }
 
+U64 Platform::getPerformanceCounter()
+{
+   struct timespec t;
+   clock_gettime( CLOCK_MONOTONIC, &t );
+   return (U64)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+U64 Platform::getPerformanceCounterFrequency()
+{
+   return 1000000000;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return x86UNIXState->currentTime;
@@ -26,6 +26,8 @@
 #include "platform/threads/mutex.h"
 #include "platform/platformTLS.h"
 #include "memory/safeDelete.h"
+#include "memory/frameAllocator.h"
+#include "debug/profiler.h"
 #include <stdlib.h>
 
 struct PlatformThreadData
@@ -51,6 +53,10 @@ static void *ThreadRunHandler(void * arg)
       mData->mThreadID = ThreadManager::getCurrentThreadId();
       ThreadManager::addThread(thread);
       thread->run(mData->mRunArg);
+      FrameAllocator::releaseThread();
+#ifdef TORQUE_ENABLE_PROFILER
+      Profiler::releaseThread();
+#endif
    	}
 	mData->mGateway.release();
    // we could delete the Thread here, if it wants to be auto-deleted...
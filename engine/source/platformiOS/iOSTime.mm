@@ -94,6 +94,18 @@ U32 Platform::getRealMilliseconds()
    return ret;
 }   
 
+/// Gets a monotonic high resolution counter.
+U64 Platform::getPerformanceCounter()
+{
+   return mach_absolute_time();
+}
+
+/// Gets the number of performance counter ticks per second.
+U64 Platform::getPerformanceCounterFrequency()
+{
+   return (1000000000ULL * timebase_info.denom) / timebase_info.numer;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return platState.currentTime;   
@@ -20,74 +20,251 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
-#include "simObjectList.h"
-#include "collection/findIterator.h"
-#include "simObject.h"
+#include "sim/SimObjectList.h"
+#include "sim/simObject.h"
+#include "memory/dataChunker.h"
 
 //-----------------------------------------------------------------------------
 
-void SimObjectList::pushBack(SimObject* obj)
+static Chunker<SimObjectList::Membership> membershipChunker(128000);
+SimObjectList::Membership* SimObjectList::smMembershipFreeList = NULL;
+
+//-----------------------------------------------------------------------------
+
+SimObjectList::SimObjectList() :
+   mOrdered(true)
 {
-   if (find(begin(),end(),obj) == end())
-      push_back(obj);
+   VECTOR_SET_ASSOCIATION(mMemberships);
+}
+
+//-----------------------------------------------------------------------------
+
+SimObjectList::~SimObjectList()
+{
+   clear();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SimObjectList::pushBack(SimObject* obj)
+{
+   if (findMembership(obj) != NULL)
+      return false;
+
+   push_back(obj);
+   addMembership(obj, size() - 1);
+   return true;
 }	
 
 //-----------------------------------------------------------------------------
 
-void SimObjectList::pushBackForce(SimObject* obj)
+bool SimObjectList::pushBackForce(SimObject* obj)
 {
-   iterator itr = find(begin(),end(),obj);
-   if (itr == end()) 
+   Membership* pMembership = findMembership(obj);
+   if (pMembership == NULL) 
    {
       push_back(obj);
+      addMembership(obj, size() - 1);
    }
-   else 
+   else if (pMembership->mIndex != (U32)size() - 1)
    {
       // Move to the back...
       //
-      SimObject* pBack = *itr;
-      removeStable(pBack);
-      push_back(pBack);
+      removeAt(pMembership->mIndex, true);
+      push_back(obj);
+      addMembership(obj, size() - 1);
    }
+
+   return true;
 }	
 
 //-----------------------------------------------------------------------------
 
-void SimObjectList::pushFront(SimObject* obj)
+bool SimObjectList::pushFront(SimObject* obj)
 {
-   if (find(begin(),end(),obj) == end())
-      push_front(obj);
+   return insertAt(0, obj);
 }	
 
 //-----------------------------------------------------------------------------
 
-void SimObjectList::remove(SimObject* obj)
+bool SimObjectList::insertAt(const U32 index, SimObject* obj)
 {
-   iterator ptr = find(begin(),end(),obj);
-   if (ptr != end()) 
-      erase(ptr);
+   if (findMembership(obj) != NULL)
+      return false;
+
+   if (index >= (U32)size())
+      return pushBack(obj);
+
+   Parent::insert(Parent::begin() + index, obj);
+   mMemberships.insert(index);
+   addMembership(obj, index);
+   reindex(index + 1);
+   return true;
 }
 
 //-----------------------------------------------------------------------------
 
-void SimObjectList::removeStable(SimObject* obj)
+bool SimObjectList::remove(SimObject* obj)
 {
-   iterator ptr = find(begin(),end(),obj);
-   if (ptr != end()) 
-      erase(ptr);
+   Membership* pMembership = findMembership(obj);
+   if (pMembership == NULL) 
+      return false;
+
+   removeAt(pMembership->mIndex, mOrdered);
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SimObjectList::removeStable(SimObject* obj)
+{
+   Membership* pMembership = findMembership(obj);
+   if (pMembership == NULL) 
+      return false;
+
+   removeAt(pMembership->mIndex, true);
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectList::clear()
+{
+   while (size() > 0)
+      removeAt(size() - 1, false);
 }
 
 //-----------------------------------------------------------------------------
 
 void SimObjectList::sortId()
 {
-   dQsort(address(),size(),sizeof(value_type),compareId);
+   sort(compareId);
+}	
+
+//-----------------------------------------------------------------------------
+
+void SimObjectList::sort(S32 (QSORT_CALLBACK *compare)(const void*, const void*))
+{
+   dQsort(address(),size(),sizeof(value_type),compare);
+
+   // The records still belong to the same objects so look them up again.
+   for (U32 i = 0; i < (U32)size(); i++)
+   {
+      Membership* pMembership = findMembership((*this)[i]);
+      pMembership->mIndex = i;
+      mMemberships[i] = pMembership;
+   }
 }	
 
 //-----------------------------------------------------------------------------
 
+void SimObjectList::removeFromAllLists(SimObject* obj)
+{
+   while (obj->mListMemberships != NULL)
+   {
+      Membership* pMembership = obj->mListMemberships;
+      pMembership->mList->removeAt(pMembership->mIndex, pMembership->mList->mOrdered);
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+SimObjectList::Membership* SimObjectList::findMembership(SimObject* obj) const
+{
+   for (Membership* pMembership = obj->mListMemberships; pMembership != NULL; pMembership = pMembership->mNext)
+   {
+      if (pMembership->mList == this)
+         return pMembership;
+   }
+
+   return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectList::addMembership(SimObject* obj, const U32 index)
+{
+   Membership* pMembership = allocMembership();
+   pMembership->mList = this;
+   pMembership->mIndex = index;
+   pMembership->mNext = obj->mListMemberships;
+   obj->mListMemberships = pMembership;
+
+   if (index == (U32)mMemberships.size())
+      mMemberships.push_back(pMembership);
+   else
+      mMemberships[index] = pMembership;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectList::removeAt(const U32 index, const bool stable)
+{
+   AssertFatal(index < (U32)size(), "SimObjectList::removeAt() - Index out of range.");
+
+   // Unlink the record from the object.
+   Membership* pMembership = mMemberships[index];
+   Membership** ppLink = &((*this)[index]->mListMemberships);
+   while (*ppLink != pMembership)
+      ppLink = &((*ppLink)->mNext);
+   *ppLink = pMembership->mNext;
+   freeMembership(pMembership);
+
+   const U32 lastIndex = size() - 1;
+   if (stable)
+   {
+      erase(Parent::begin() + index);
+      mMemberships.erase(index);
+      reindex(index);
+      return;
+   }
+
+   // Move the last object into the hole.
+   if (index != lastIndex)
+   {
+      Parent::operator[](index) = Parent::operator[](lastIndex);
+      mMemberships[index] = mMemberships[lastIndex];
+      mMemberships[index]->mIndex = index;
+   }
+   decrement();
+   mMemberships.decrement();
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectList::reindex(const U32 start)
+{
+   const U32 count = mMemberships.size();
+   for (U32 i = start; i < count; i++)
+      mMemberships[i]->mIndex = i;
+}
+
+//-----------------------------------------------------------------------------
+
+SimObjectList::Membership* SimObjectList::allocMembership()
+{
+   if (smMembershipFreeList)
+   {
+      Membership* pMembership = smMembershipFreeList;
+      smMembershipFreeList = pMembership->mNext;
+      return pMembership;
+   }
+   return membershipChunker.alloc();
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectList::freeMembership(Membership* pMembership)
+{
+   pMembership->mList = NULL;
+   pMembership->mNext = smMembershipFreeList;
+   smMembershipFreeList = pMembership;
+}
+
+//-----------------------------------------------------------------------------
+
 S32 QSORT_CALLBACK SimObjectList::compareId(const void* a,const void* b)
 {
    return (*reinterpret_cast<const SimObject* const*>(a))->getId() -
       (*reinterpret_cast<const SimObject* const*>(b))->getId();
-}
\ No newline at end of file
+}
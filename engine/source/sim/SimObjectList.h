@@ -33,22 +33,109 @@ class SimObject;
 
 //-----------------------------------------------------------------------------
 
-class SimObjectList : public VectorPtr<SimObject*>
+/// A list of SimObjects that knows the position of each of its members.
+///
+/// Every object carries a chain of membership records, one for each list
+/// it is in, holding its index in that list.  Finding, testing for and
+/// removing an object therefore only walks the (short) chain of lists the
+/// object belongs to rather than searching the list itself.
+///
+/// The list preserves the order of its members by default.  An unordered
+/// list removes an object by moving the last member into its place, which
+/// makes removal O(1) at the expense of the member order.
+///
+/// The list can only be modified through the methods declared here so
+/// that the membership records stay in step with the list.  The vector
+/// it is built on is private and only its read accessors are exposed.
+class SimObjectList : private VectorPtr<SimObject*>
 {
+   typedef VectorPtr<SimObject*> Parent;
+
    static S32 QSORT_CALLBACK compareId(const void* a,const void* b);
 
+   /// Disallowed as a copy would share the membership records of the list.
+   SimObjectList(const SimObjectList&);
+   SimObjectList& operator=(const SimObjectList&);
+
 public:
-   void pushBack(SimObject*);       ///< Add the SimObject* to the end of the list, unless it's already in the list.
-   void pushBackForce(SimObject*);  ///< Add the SimObject* to the end of the list, moving it there if it's already present in the list.
-   void pushFront(SimObject*);      ///< Add the SimObject* to the start of the list.
-   void remove(SimObject*);         ///< Remove the SimObject* from the list; may disrupt order of the list.
+   /// @name Read Access
+   /// @{
+
+   typedef Parent::value_type       value_type;
+   typedef Parent::const_iterator   iterator;
+   typedef Parent::const_iterator   const_iterator;
+
+   using Parent::size;
+   using Parent::empty;
+#ifdef TORQUE_DEBUG
+   using Parent::setFileAssociation;
+#endif
+
+   inline iterator begin() const { return Parent::begin(); }
+   inline iterator end() const { return Parent::end(); }
+   inline SimObject* operator[](U32 index) const { return Parent::operator[](index); }
+   inline SimObject* front() const { return Parent::operator[](0); }
+   inline SimObject* first() const { return Parent::operator[](0); }
+   inline SimObject* last() const { return Parent::operator[](size() - 1); }
+
+   /// @}
+
+   /// The position of an object in a list.
+   struct Membership
+   {
+      SimObjectList* mList;
+      U32            mIndex;
+      Membership*    mNext;   ///< Next membership of the same object.
+   };
+
+   SimObjectList();
+   ~SimObjectList();
+
+   bool pushBack(SimObject*);       ///< Add the SimObject* to the end of the list, unless it's already in the list.
+   bool pushBackForce(SimObject*);  ///< Add the SimObject* to the end of the list, moving it there if it's already present in the list.
+   bool pushFront(SimObject*);      ///< Add the SimObject* to the start of the list.
+   bool remove(SimObject*);         ///< Remove the SimObject* from the list; only preserves list order if the list is ordered.
+
+   /// Insert the SimObject* at the given index, unless it's already in the list.
+   bool insertAt(const U32 index, SimObject* pObject);
 
    inline SimObject* at(S32 index) const {  if(index >= 0 && index < size()) return (*this)[index]; return NULL; }
 
    /// Remove the SimObject* from the list; guaranteed to preserve list order.
-   void removeStable(SimObject* pObject);
+   bool removeStable(SimObject* pObject);
+
+   /// Remove all objects from the list.
+   void clear();
+
+   inline bool contains(SimObject* pObject) const { return findMembership(pObject) != NULL; }
+
+   /// Returns the index of the SimObject* in the list or -1 if it isn't in the list.
+   inline S32 indexOf(SimObject* pObject) const { const Membership* pMembership = findMembership(pObject); return pMembership ? (S32)pMembership->mIndex : -1; }
+
+   /// Sets whether removing an object preserves the order of the list.
+   inline void setOrdered(const bool ordered) { mOrdered = ordered; }
+   inline bool isOrdered() const { return mOrdered; }
 
    void sortId();                   ///< Sort the list by object ID.
+   void sort(S32 (QSORT_CALLBACK *compare)(const void*, const void*));   ///< Sort the list with a qsort callback.
+
+   /// Removes the object from every list it is in.  Used when an object is
+   /// destroyed while still a member of a list.
+   static void removeFromAllLists(SimObject* pObject);
+
+private:
+   Membership* findMembership(SimObject* pObject) const;
+   void addMembership(SimObject* pObject, const U32 index);
+   void removeAt(const U32 index, const bool stable);
+   void reindex(const U32 start);
+
+   static Membership* allocMembership();
+   static void freeMembership(Membership* pMembership);
+
+   Vector<Membership*> mMemberships;   ///< The membership record of each object, parallel to the list.
+   bool                mOrdered;
+
+   static Membership*  smMembershipFreeList;
 };
 
-#endif // _SIM_OBJECT_LIST_H_
\ No newline at end of file
+#endif // _SIM_OBJECT_LIST_H_
@@ -215,6 +215,7 @@ namespace Sim
    U32  getEventTimeLeft(U32 eventId);
    U32  getTimeSinceStart(U32 eventId);
    U32  getScheduleDuration(U32 eventId);
+   U32  getEventQueueSize();
 
    bool saveObject(SimObject *obj, Stream *stream);
    SimObject *loadObjectStream(Stream *stream);
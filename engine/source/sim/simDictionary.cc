@@ -22,231 +22,181 @@
 
 #include "sim/simDictionary.h"
 #include "sim/simBase.h"
+#include "platform/platformIntrinsics.h"
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
-extern S32 HashPointer(StringTableEntry e);
 
-SimNameDictionary::SimNameDictionary()
+SimNameTable::SimNameTable(const Link link, const U32 initialSize)
 {
-   hashTable = NULL;
+   VECTOR_SET_ASSOCIATION(mRetiredTables);
+
+   mLink = link;
+   mInitialSize = initialSize;
+   mTable = NULL;
+   mCount = 0;
    mutex = Mutex::createMutex();
 }
 
-SimNameDictionary::~SimNameDictionary()
+SimNameTable::~SimNameTable()
 {
-   delete[] hashTable;
+   dFree(mTable);
+   for(S32 i = 0; i < mRetiredTables.size(); i++)
+      dFree(mRetiredTables[i]);
    Mutex::destroyMutex(mutex);
 }
 
-void SimNameDictionary::insert(SimObject* obj)
+SimObject*& SimNameTable::getNext(SimObject* obj) const
 {
-   if(!obj->objectName)
-      return;
+   return mLink == NameLink ? obj->nextNameObject : obj->nextManagerNameObject;
+}
 
-   Mutex::lockMutex(mutex);
-   
-   if(!hashTable)
+U32 SimNameTable::getHomeSlot(const Table* pTable, StringTableEntry name)
+{
+   // Fibonacci hashing spreads the aligned string pointers over the high bits.
+   const U32 hash = U32((size_t)name) ^ U32(((size_t)name) >> 16);
+   return (hash * 2654435769u) >> pTable->mShift;
+}
+
+SimNameTable::Slot* SimNameTable::findSlot(Table* pTable, StringTableEntry name)
+{
+   // The table is never full so this finds the name or an empty slot.
+   const U32 mask = pTable->mSize - 1;
+   U32 index = getHomeSlot(pTable, name);
+   while(true)
    {
-      hashTable = new SimObject *[DefaultTableSize];
-      hashTableSize = DefaultTableSize;
-      hashEntryCount = 0;
-      S32 i;
-      for(i = 0; i < hashTableSize; i++)
-         hashTable[i] = NULL;
+      Slot* pSlot = &pTable->mSlots[index];
+      StringTableEntry slotName = dAtomicReadPtr(pSlot->mName);
+      if(slotName == name || slotName == NULL)
+         return pSlot;
+      index = (index + 1) & mask;
    }
-   S32 idx = HashPointer(obj->objectName) % hashTableSize;
-   obj->nextNameObject = hashTable[idx];
-   hashTable[idx] = obj;
-   hashEntryCount++;
-   if(hashEntryCount > hashTableSize)
-   {
-      // resize the hash table
-      S32 i;
-      SimObject *head = NULL, *walk, *temp;
-   	for(i = 0; i < hashTableSize; i++) {
-   		walk = hashTable[i];
-         while(walk)
-         {
-            temp = walk->nextNameObject;
-            walk->nextNameObject = head;
-            head = walk;
-            walk = temp;
-         }
-   	}
-      delete[] hashTable;
-      hashTableSize = hashTableSize * 2 + 1;
-      hashTable = new SimObject *[hashTableSize];
-
-      for(i = 0; i < hashTableSize;i++)
-         hashTable[i] = NULL;
-      while(head)
-      {
-         temp = head->nextNameObject;
-         idx = HashPointer(head->objectName) % hashTableSize;
-         head->nextNameObject = hashTable[idx];
-         hashTable[idx] = head;
-         head = temp;
-      }
-   }
-   Mutex::unlockMutex(mutex);
 }
 
-SimObject* SimNameDictionary::find(StringTableEntry name)
+void SimNameTable::grow()
 {
-   // NULL is a valid lookup - it will always return NULL
-   if(!hashTable)
-      return NULL;
-      
-   Mutex::lockMutex(mutex);
-
-   S32 idx = HashPointer(name) % hashTableSize;
-   SimObject *walk = hashTable[idx];
-   while(walk)
+   // Names without objects are dropped when the table is rebuilt.
+   U32 liveCount = 0;
+   if(mTable)
    {
-      if(walk->objectName == name)
+      for(U32 i = 0; i < mTable->mSize; i++)
       {
-         Mutex::unlockMutex(mutex);
-         return walk;
+         if(mTable->mSlots[i].mObject)
+            liveCount++;
       }
-      walk = walk->nextNameObject;
    }
 
-   Mutex::unlockMutex(mutex);
-   return NULL;
-}
+   U32 newSize = mTable ? mTable->mSize : mInitialSize;
+   while((liveCount + 1) * 2 > newSize)
+      newSize *= 2;
 
-void SimNameDictionary::remove(SimObject* obj)
-{
-   if(!obj->objectName)
-      return;
+   U32 shift = 32;
+   for(U32 size = newSize; size > 1; size >>= 1)
+      shift--;
 
-   Mutex::lockMutex(mutex);
+   Table* pNewTable = (Table*)dMalloc(sizeof(Table) + (newSize - 1) * sizeof(Slot));
+   pNewTable->mSize = newSize;
+   pNewTable->mShift = shift;
+   pNewTable->mUsed = liveCount;
+   dMemset(pNewTable->mSlots, 0, newSize * sizeof(Slot));
 
-   SimObject **walk = &hashTable[HashPointer(obj->objectName) % hashTableSize];
-   while(*walk)
+   if(mTable)
    {
-      if(*walk == obj)
+      for(U32 i = 0; i < mTable->mSize; i++)
       {
-         *walk = obj->nextNameObject;
-			obj->nextNameObject = (SimObject*)-1;
-         hashEntryCount--;
-
-         Mutex::unlockMutex(mutex);
-         return;
+         const Slot& slot = mTable->mSlots[i];
+         if(slot.mObject)
+         {
+            Slot* pSlot = findSlot(pNewTable, slot.mName);
+            pSlot->mName = slot.mName;
+            pSlot->mObject = slot.mObject;
+         }
       }
-      walk = &((*walk)->nextNameObject);
-   }
 
-   Mutex::unlockMutex(mutex);
-}	
-
-//----------------------------------------------------------------------------
-
-SimManagerNameDictionary::SimManagerNameDictionary()
-{
-   hashTable = new SimObject *[DefaultTableSize];
-   hashTableSize = DefaultTableSize;
-   hashEntryCount = 0;
-   S32 i;
-   for(i = 0; i < hashTableSize; i++)
-      hashTable[i] = NULL;
-   mutex = Mutex::createMutex();
-}
+      // Readers may still be probing the old table.
+      Table* pOldTable = mTable;
+      mRetiredTables.push_back(pOldTable);
+   }
 
-SimManagerNameDictionary::~SimManagerNameDictionary()
-{
-   delete[] hashTable;
-   Mutex::destroyMutex(mutex);
+   dAtomicWritePtr(mTable, pNewTable);
 }
 
-void SimManagerNameDictionary::insert(SimObject* obj)
+void SimNameTable::insert(SimObject* obj)
 {
    if(!obj->objectName)
       return;
 
    Mutex::lockMutex(mutex);
 
-   S32 idx = HashPointer(obj->objectName) % hashTableSize;
-   obj->nextManagerNameObject = hashTable[idx];
-   hashTable[idx] = obj;
-   hashEntryCount++;
-   if(hashEntryCount > hashTableSize)
+   if(!mTable || (mTable->mUsed + 1) * 4 > mTable->mSize * 3)
+      grow();
+
+   Slot* pSlot = findSlot(mTable, obj->objectName);
+   if(pSlot->mName == obj->objectName)
    {
-      // resize the hash table
-      S32 i;
-      SimObject *head = NULL, *walk, *temp;
-   	for(i = 0; i < hashTableSize; i++) {
-   		walk = hashTable[i];
-         while(walk)
-         {
-            temp = walk->nextManagerNameObject;
-            walk->nextManagerNameObject = head;
-            head = walk;
-            walk = temp;
-         }
-   	}
-      delete[] hashTable;
-      hashTableSize = hashTableSize * 2 + 1;
-      hashTable = new SimObject *[hashTableSize];
-
-      for(i = 0; i < hashTableSize;i++)
-         hashTable[i] = NULL;
-      while(head)
-      {
-         temp = head->nextManagerNameObject;
-         idx = HashPointer(head->objectName) % hashTableSize;
-         head->nextManagerNameObject = hashTable[idx];
-         hashTable[idx] = head;
-         head = temp;
-      }
+      // Shadow any object that already has the name.
+      getNext(obj) = pSlot->mObject;
+      dAtomicWritePtr(pSlot->mObject, obj);
    }
-   
+   else
+   {
+      // The object must be in place before the name makes the slot visible.
+      getNext(obj) = NULL;
+      pSlot->mObject = obj;
+      dAtomicWritePtr(pSlot->mName, obj->objectName);
+      mTable->mUsed++;
+   }
+   mCount++;
+
    Mutex::unlockMutex(mutex);
 }
 
-SimObject* SimManagerNameDictionary::find(StringTableEntry name)
+SimObject* SimNameTable::find(StringTableEntry name)
 {
    // NULL is a valid lookup - it will always return NULL
+   if(!name)
+      return NULL;
 
-   Mutex::lockMutex(mutex);
+   Table* pTable = dAtomicReadPtr(mTable);
+   if(!pTable)
+      return NULL;
 
-   S32 idx = HashPointer(name) % hashTableSize;
-   SimObject *walk = hashTable[idx];
-   while(walk)
-   {
-      if(walk->objectName == name)
-      {
-         Mutex::unlockMutex(mutex);
-         return walk;
-      }
-      walk = walk->nextManagerNameObject;
-   }
+   Slot* pSlot = findSlot(pTable, name);
+   if(dAtomicReadPtr(pSlot->mName) != name)
+      return NULL;
 
-   Mutex::unlockMutex(mutex);
-   return NULL;
+   return dAtomicReadPtr(pSlot->mObject);
 }
 
-void SimManagerNameDictionary::remove(SimObject* obj)
+void SimNameTable::remove(SimObject* obj)
 {
    if(!obj->objectName)
       return;
 
    Mutex::lockMutex(mutex);
 
-   SimObject **walk = &hashTable[HashPointer(obj->objectName) % hashTableSize];
-   while(*walk)
+   Slot* pSlot = mTable ? findSlot(mTable, obj->objectName) : NULL;
+   if(pSlot && pSlot->mName == obj->objectName)
    {
-      if(*walk == obj)
+      if(pSlot->mObject == obj)
       {
-         *walk = obj->nextManagerNameObject;
-			obj->nextManagerNameObject = (SimObject*)-1;
-         hashEntryCount--;
-
-         Mutex::unlockMutex(mutex);
-         return;
+         // Uncover the next object with the name, if any.
+         dAtomicWritePtr(pSlot->mObject, getNext(obj));
+         getNext(obj) = (SimObject*)-1;
+         mCount--;
+      }
+      else
+      {
+         SimObject *walk = pSlot->mObject;
+         while(walk && getNext(walk) != obj)
+            walk = getNext(walk);
+         if(walk)
+         {
+            getNext(walk) = getNext(obj);
+            getNext(obj) = (SimObject*)-1;
+            mCount--;
+         }
       }
-      walk = &((*walk)->nextManagerNameObject);
    }
 
    Mutex::unlockMutex(mutex);
@@ -257,58 +207,160 @@ void SimManagerNameDictionary::remove(SimObject* obj)
 
 SimIdDictionary::SimIdDictionary()
 {
-   for(S32 i = 0; i < DefaultTableSize; i++)
-      table[i] = NULL;
+   VECTOR_SET_ASSOCIATION(mRetiredDirectories);
+   VECTOR_SET_ASSOCIATION(mFreePages);
+
+   mDirectory = createDirectory(DefaultPageCount);
+   mCount = 0;
    mutex = Mutex::createMutex();
 }
 
 SimIdDictionary::~SimIdDictionary()
 {
+   for(U32 i = 0; i < mDirectory->mPageCount; i++)
+      delete mDirectory->mPages[i];
+   dFree(mDirectory);
+
+   for(S32 i = 0; i < mRetiredDirectories.size(); i++)
+      dFree(mRetiredDirectories[i]);
+   for(S32 i = 0; i < mFreePages.size(); i++)
+      delete mFreePages[i];
+
    Mutex::destroyMutex(mutex);
 }
 
+SimIdDictionary::Directory* SimIdDictionary::createDirectory(const U32 pageCount)
+{
+   Directory* pDirectory = (Directory*)dMalloc(sizeof(Directory) + (pageCount - 1) * sizeof(Page*));
+   pDirectory->mPageCount = pageCount;
+   for(U32 i = 0; i < pageCount; i++)
+      pDirectory->mPages[i] = NULL;
+   return pDirectory;
+}
+
+void SimIdDictionary::growDirectory(const U32 pageCount)
+{
+   U32 newPageCount = mDirectory->mPageCount;
+   while(newPageCount < pageCount)
+      newPageCount *= 2;
+
+   Directory* pDirectory = createDirectory(newPageCount);
+   for(U32 i = 0; i < mDirectory->mPageCount; i++)
+      pDirectory->mPages[i] = mDirectory->mPages[i];
+
+   // Readers may still be using the old directory.
+   Directory* pOldDirectory = mDirectory;
+   mRetiredDirectories.push_back(pOldDirectory);
+   dAtomicWritePtr(mDirectory, pDirectory);
+}
+
 void SimIdDictionary::insert(SimObject* obj)
 {
    Mutex::lockMutex(mutex);
 
-   S32 idx = obj->getId() & TableBitMask;
-   obj->nextIdObject = table[idx];
-   AssertFatal( obj->nextIdObject != obj, "SimIdDictionary::insert - Creating Infinite Loop linking to self!" );
-   table[idx] = obj;
+   const U32 id = obj->getId();
+   if(id >= MaxPagedId)
+   {
+      mUnpagedObjects.insert(id, obj);
+      mCount++;
+
+      Mutex::unlockMutex(mutex);
+      return;
+   }
+
+   const U32 pageIndex = id >> PageShift;
+   if(pageIndex >= mDirectory->mPageCount)
+      growDirectory(pageIndex + 1);
+
+   Page* pPage = mDirectory->mPages[pageIndex];
+   if(!pPage)
+   {
+      if(mFreePages.size())
+      {
+         pPage = mFreePages.last();
+         mFreePages.pop_back();
+      }
+      else
+      {
+         pPage = new Page;
+         dMemset(pPage, 0, sizeof(Page));
+      }
+      dAtomicWritePtr(mDirectory->mPages[pageIndex], pPage);
+   }
+
+   SimObject* volatile& slot = pPage->mSlots[id & PageMask];
+   AssertWarn(slot == NULL || slot == obj, "SimIdDictionary::insert - Id is already in use!");
+   if(slot == NULL)
+   {
+      pPage->mCount++;
+      mCount++;
+   }
+   dAtomicWritePtr(slot, obj);
 
    Mutex::unlockMutex(mutex);
 }
 
 SimObject* SimIdDictionary::find(S32 id)
 {
-   Mutex::lockMutex(mutex);
-
-   S32 idx = id & TableBitMask;
-   SimObject *walk = table[idx];
-   while(walk)
+   const U32 objectId = U32(id);
+   if(objectId < MaxPagedId)
    {
-      if(walk->getId() == U32(id))
-      {
-         Mutex::unlockMutex(mutex);
-         return walk;
-      }
-      walk = walk->nextIdObject;
+      Directory* pDirectory = dAtomicReadPtr(mDirectory);
+      const U32 pageIndex = objectId >> PageShift;
+      if(pageIndex >= pDirectory->mPageCount)
+         return NULL;
+
+      Page* pPage = dAtomicReadPtr(pDirectory->mPages[pageIndex]);
+      if(!pPage)
+         return NULL;
+
+      // The page may have been recycled for other ids since it was fetched.
+      SimObject* obj = dAtomicReadPtr(pPage->mSlots[objectId & PageMask]);
+      return obj && obj->getId() == objectId ? obj : NULL;
    }
 
+   Mutex::lockMutex(mutex);
+
+   SimObject** pObject = mUnpagedObjects.find(objectId);
+   SimObject* obj = pObject ? *pObject : NULL;
+
    Mutex::unlockMutex(mutex);
 
-   return NULL;
+   return obj;
 }
 
 void SimIdDictionary::remove(SimObject* obj)
 {
    Mutex::lockMutex(mutex);
 
-   SimObject **walk = &table[obj->getId() & TableBitMask];
-   while(*walk && *walk != obj)
-      walk = &((*walk)->nextIdObject);
-   if(*walk)
-      *walk = obj->nextIdObject;
+   const U32 id = obj->getId();
+   if(id >= MaxPagedId)
+   {
+      SimObject** pObject = mUnpagedObjects.find(id);
+      if(pObject && *pObject == obj)
+      {
+         mUnpagedObjects.erase(id);
+         mCount--;
+      }
+
+      Mutex::unlockMutex(mutex);
+      return;
+   }
+
+   const U32 pageIndex = id >> PageShift;
+   Page* pPage = pageIndex < mDirectory->mPageCount ? mDirectory->mPages[pageIndex] : NULL;
+   if(pPage && pPage->mSlots[id & PageMask] == obj)
+   {
+      dAtomicWritePtr(pPage->mSlots[id & PageMask], (SimObject*)NULL);
+      mCount--;
+
+      // Recycle the page once the range of ids it covers is unused.
+      if(--pPage->mCount == 0)
+      {
+         dAtomicWritePtr(mDirectory->mPages[pageIndex], (Page*)NULL);
+         mFreePages.push_back(pPage);
+      }
+   }
 
    Mutex::unlockMutex(mutex);
 }
@@ -33,78 +33,161 @@
 #include "platform/threads/mutex.h"
 #endif
 
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _FLAT_HASH_MAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
 class SimObject;
 
 //----------------------------------------------------------------------------
-/// Map of names to SimObjects
+/// Map of names to SimObjects shared by the name dictionaries.
 ///
-/// Provides fast lookup for name->object and
-/// for fast removal of an object given object*
-class SimNameDictionary
+/// An open addressing table where each slot holds a name and the most
+/// recently inserted object with that name.  Older objects with the same
+/// name are chained through the object so they become visible again when
+/// the newer ones are removed.
+///
+/// Lookups don't lock.  A slot keeps its name once it is used, so no slot
+/// is ever reused for another name, and a grown table is published with a
+/// single pointer write.  The tables it replaces are kept until the
+/// dictionary is destroyed because a reader may still be probing them.
+class SimNameTable
 {
-   enum
+public:
+   void insert(SimObject* obj);
+   void remove(SimObject* obj);
+   SimObject* find(StringTableEntry name);
+
+   /// The number of objects in the dictionary.
+   inline U32 getCount() const { return mCount; }
+
+protected:
+   /// The object field that chains objects with the same name.
+   enum Link
    {
-      DefaultTableSize = 29
+      NameLink,
+      ManagerNameLink
    };
 
-   SimObject **hashTable;  // hash the pointers of the names...
-   S32 hashTableSize;
-   S32 hashEntryCount;
+   SimNameTable(const Link link, const U32 initialSize);
+   ~SimNameTable();
 
-   void *mutex;
+private:
+   struct Slot
+   {
+      StringTableEntry volatile mName;
+      SimObject* volatile mObject;
+   };
 
-public:
-   void insert(SimObject* obj);
-   void remove(SimObject* obj);
-   SimObject* find(StringTableEntry name);
+   struct Table
+   {
+      U32 mSize;     ///< Power of two.
+      U32 mShift;
+      U32 mUsed;     ///< Slots with a name, including those without objects.
+      Slot mSlots[1];
+   };
 
-   SimNameDictionary();
-   ~SimNameDictionary();
+   SimObject*& getNext(SimObject* obj) const;
+   static U32 getHomeSlot(const Table* pTable, StringTableEntry name);
+   static Slot* findSlot(Table* pTable, StringTableEntry name);
+   void grow();
+
+   Link mLink;
+   U32 mInitialSize;
+   Table* volatile mTable;
+   Vector<Table*> mRetiredTables;
+   U32 mCount;
+
+   void *mutex;
 };
 
-class SimManagerNameDictionary
+//----------------------------------------------------------------------------
+/// Map of names to SimObjects
+///
+/// Provides fast lookup for name->object and
+/// for fast removal of an object given object*
+class SimNameDictionary : public SimNameTable
 {
    enum
    {
-      DefaultTableSize = 29
+      DefaultTableSize = 32
    };
 
-   SimObject **hashTable;  // hash the pointers of the names...
-   S32 hashTableSize;
-   S32 hashEntryCount;
+public:
+   SimNameDictionary() : SimNameTable(NameLink, DefaultTableSize) {}
+};
 
-   void *mutex;
+class SimManagerNameDictionary : public SimNameTable
+{
+   enum
+   {
+      DefaultTableSize = 1024
+   };
 
 public:
-   void insert(SimObject* obj);
-   void remove(SimObject* obj);
-   SimObject* find(StringTableEntry name);
-
-   SimManagerNameDictionary();
-   ~SimManagerNameDictionary();
+   SimManagerNameDictionary() : SimNameTable(ManagerNameLink, DefaultTableSize) {}
 };
 
 //----------------------------------------------------------------------------
 /// Map of ID's to SimObjects.
 ///
-/// Provides fast lookup for ID->object and
-/// for fast removal of an object given object*
+/// Dynamic ids are allocated sequentially so the objects are kept in a
+/// paged array indexed by id.  The directory of pages grows as ids are
+/// allocated and a page that empties is recycled for a later range of ids.
+/// Ids above MaxPagedId can only come from explicitly assigned ids and are
+/// kept in a hash map instead.
+///
+/// Lookups of paged ids don't lock.  The directory and pages are published
+/// with single pointer writes and a replaced directory is kept until the
+/// dictionary is destroyed.  Since a reader may still hold a page that has
+/// been recycled, the id of the object found is checked before it is
+/// returned.
 class SimIdDictionary
 {
    enum
    {
-      DefaultTableSize = 4096,
-      TableBitMask = 4095
+      PageShift = 10,
+      PageSize = 1 << PageShift,
+      PageMask = PageSize - 1,
+      DefaultPageCount = 64,
+      MaxPagedId = 1 << 26
+   };
+
+   struct Page
+   {
+      U32 mCount;
+      SimObject* volatile mSlots[PageSize];
    };
-   SimObject *table[DefaultTableSize];
+
+   struct Directory
+   {
+      U32 mPageCount;
+      Page* volatile mPages[1];
+   };
+
+   Directory* volatile mDirectory;
+   Vector<Directory*> mRetiredDirectories;
+   Vector<Page*> mFreePages;
+   FlatHashMap<U32, SimObject*> mUnpagedObjects;
+   U32 mCount;
 
    void *mutex;
 
+   static Directory* createDirectory(const U32 pageCount);
+   void growDirectory(const U32 pageCount);
+
 public:
    void insert(SimObject* obj);
    void remove(SimObject* obj);
    SimObject* find(S32 id);
 
+   /// The number of objects in the dictionary.
+   inline U32 getCount() const { return mCount; }
+
    SimIdDictionary();
    ~SimIdDictionary();
 };
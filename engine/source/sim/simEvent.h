@@ -53,14 +53,21 @@ typedef U32 SimTime;
 class SimEvent
 {
   public:
-   SimEvent *nextEvent;     ///< Linked list details - pointer to next item in the list.
    SimTime startTime;       ///< When the event was posted.
    SimTime time;            ///< When the event is scheduled to occur.
    U32 sequenceCount;       ///< Unique ID. These are assigned sequentially based on order
                             ///  of addition to the list.
    SimObject *destObject;   ///< Object on which this event will be applied.
 
-   SimEvent() { destObject = NULL; }
+   /// @name Event Queue
+   /// Bookkeeping owned by the Sim event queue.
+   /// @{
+   U32 queueIndex;               ///< Position of the event in the queue heap.
+   SimEvent *nextObjectEvent;    ///< Next pending event for the same destination object.
+   SimEvent *prevObjectEvent;    ///< Previous pending event for the same destination object.
+   /// @}
+
+   SimEvent() { destObject = NULL; queueIndex = 0; nextObjectEvent = NULL; prevObjectEvent = NULL; }
    virtual ~SimEvent() {}   ///< Destructor
                             ///
                             /// A dummy virtual destructor is required
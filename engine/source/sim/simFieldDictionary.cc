@@ -51,49 +51,38 @@ void SimFieldDictionary::freeEntry(SimFieldDictionary::Entry *ent)
 
 SimFieldDictionary::SimFieldDictionary()
 {
-   for(U32 i = 0; i < HashTableSize; i++)
-      mHashTable[i] = 0;
-
    mVersion = 0;
 }
 
 SimFieldDictionary::~SimFieldDictionary()
 {
-   for(U32 i = 0; i < HashTableSize; i++)
+   for(FieldMap::iterator itr = mFields.begin(); itr != mFields.end(); ++itr)
    {
-      for(Entry *walk = mHashTable[i]; walk;)
-      {
-         Entry *temp = walk;
-         walk = temp->next;
-
-         dFree(temp->value);
-         freeEntry(temp);
-      }
+      dFree(itr->value->value);
+      freeEntry(itr->value);
    }
 }
 
 void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *value)
 {
-   U32 bucket = HashPointer(slotName) % HashTableSize;
-   Entry **walk = &mHashTable[bucket];
-   while(*walk && (*walk)->slotName != slotName)
-      walk = &((*walk)->next);
-
-   Entry *field = *walk;
    if(!*value)
    {
+      Entry **field = mFields.find(slotName);
       if(field)
       {
          mVersion++;
 
-         dFree(field->value);
-         *walk = field->next;
-         freeEntry(field);
+         Entry *temp = *field;
+         mFields.erase(slotName);
+         dFree(temp->value);
+         freeEntry(temp);
       }
    }
    else
    {
-      if(field)
+      bool inserted;
+      Entry *&field = mFields.findOrInsert(slotName, &inserted);
+      if(!inserted)
       {
          dFree(field->value);
          field->value = dStrdup(value);
@@ -106,20 +95,14 @@ void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *va
          field->value = dStrdup(value);
          field->slotName = slotName;
          field->next = NULL;
-         *walk = field;
       }
    }
 }
 
 const char *SimFieldDictionary::getFieldValue(StringTableEntry slotName)
 {
-   U32 bucket = HashPointer(slotName) % HashTableSize;
-
-   for(Entry *walk = mHashTable[bucket];walk;walk = walk->next)
-      if(walk->slotName == slotName)
-         return walk->value;
-
-   return NULL;
+   Entry **field = mFields.find(slotName);
+   return field ? (*field)->value : NULL;
 }
 
 
@@ -127,9 +110,9 @@ void SimFieldDictionary::assignFrom(SimFieldDictionary *dict)
 {
    mVersion++;
 
-   for(U32 i = 0; i < HashTableSize; i++)
-      for(Entry *walk = dict->mHashTable[i];walk; walk = walk->next)
-         setFieldValue(walk->slotName, walk->value);
+   mFields.reserve(mFields.size() + dict->mFields.size());
+   for(FieldMap::iterator itr = dict->mFields.begin(); itr != dict->mFields.end(); ++itr)
+      setFieldValue(itr->key, itr->value->value);
 }
 
 static S32 QSORT_CALLBACK compareEntries(const void* a,const void* b)
@@ -145,25 +128,24 @@ void SimFieldDictionary::writeFields(SimObject *obj, Stream &stream, U32 tabStop
    const AbstractClassRep::FieldList &list = obj->getFieldList();
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for(U32 i = 0; i < HashTableSize; i++)
+   for(FieldMap::iterator itr = mFields.begin(); itr != mFields.end(); ++itr)
    {
-      for(Entry *walk = mHashTable[i];walk; walk = walk->next)
-      {
-         // make sure we haven't written this out yet:
-         U32 i;
-         for(i = 0; i < (U32)list.size(); i++)
-            if(list[i].pFieldname == walk->slotName)
-               break;
+      Entry *walk = itr->value;
 
-         if(i != list.size())
-            continue;
+      // make sure we haven't written this out yet:
+      S32 i;
+      for(i = 0; i < list.size(); i++)
+         if(list[i].pFieldname == walk->slotName)
+            break;
 
+      if(i != list.size())
+         continue;
 
-         if (!obj->writeField(walk->slotName, walk->value))
-            continue;
 
-         flist.push_back(walk);
-      }
+      if (!obj->writeField(walk->slotName, walk->value))
+         continue;
+
+      flist.push_back(walk);
    }
 
    // Sort Entries to prevent version control conflicts
@@ -191,21 +173,20 @@ void SimFieldDictionary::printFields(SimObject *obj)
    char expandedBuffer[4096];
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for(U32 i = 0; i < HashTableSize; i++)
+   for(FieldMap::iterator itr = mFields.begin(); itr != mFields.end(); ++itr)
    {
-      for(Entry *walk = mHashTable[i];walk; walk = walk->next)
-      {
-         // make sure we haven't written this out yet:
-         U32 i;
-         for(i = 0; i < (U32)list.size(); i++)
-            if(list[i].pFieldname == walk->slotName)
-               break;
+      Entry *walk = itr->value;
 
-         if(i != list.size())
-            continue;
+      // make sure we haven't written this out yet:
+      S32 i;
+      for(i = 0; i < list.size(); i++)
+         if(list[i].pFieldname == walk->slotName)
+            break;
 
-         flist.push_back(walk);
-      }
+      if(i != list.size())
+         continue;
+
+      flist.push_back(walk);
    }
    dQsort(flist.address(),flist.size(),sizeof(Entry *),compareEntries);
 
@@ -222,21 +203,23 @@ void SimFieldDictionary::printFields(SimObject *obj)
 SimFieldDictionaryIterator::SimFieldDictionaryIterator(SimFieldDictionary * dictionary)
 {
    mDictionary = dictionary;
-   mHashIndex = -1;
    mEntry = 0;
-   operator++();
+
+   if(mDictionary)
+   {
+      mIterator = mDictionary->mFields.begin();
+      if(mIterator != mDictionary->mFields.end())
+         mEntry = mIterator->value;
+   }
 }
 
 SimFieldDictionary::Entry* SimFieldDictionaryIterator::operator++()
 {
-   if(!mDictionary)
+   if(!mEntry)
       return(mEntry);
 
-   if(mEntry)
-      mEntry = mEntry->next;
-
-   while(!mEntry && (mHashIndex < (SimFieldDictionary::HashTableSize-1)))
-      mEntry = mDictionary->mHashTable[++mHashIndex];
+   ++mIterator;
+   mEntry = mIterator != mDictionary->mFields.end() ? mIterator->value : 0;
 
    return(mEntry);
 }
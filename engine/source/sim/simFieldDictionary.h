@@ -27,6 +27,10 @@
 #include "io/stream.h"
 #endif
 
+#ifndef _FLAT_HASH_MAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 class SimObject;
@@ -44,14 +48,15 @@ class SimFieldDictionary
    {
       StringTableEntry slotName;
       char *value;
-      Entry *next;
-   };
-   enum
-   {
-      HashTableSize = 19
+      Entry *next;   ///< Only used while on the free list.
    };
-   Entry *mHashTable[HashTableSize];
+
+   typedef FlatHashMap<StringTableEntry, Entry*> FieldMap;
+
   private:
+   /// Fields keyed by slot name.  The table grows with the number of fields
+   /// so objects with many dynamic fields keep constant time lookups.
+   FieldMap mFields;
 
    static Entry *mFreeList;
    static void freeEntry(Entry *entry);
@@ -64,6 +69,7 @@ class SimFieldDictionary
 
 public:
    const U32 getVersion() const { return mVersion; }
+   U32 getFieldCount() const { return mFields.size(); }
 
    SimFieldDictionary();
    ~SimFieldDictionary();
@@ -78,9 +84,9 @@ public:
 
 class SimFieldDictionaryIterator
 {
-   SimFieldDictionary *          mDictionary;
-   S32                           mHashIndex;
-   SimFieldDictionary::Entry *   mEntry;
+   SimFieldDictionary *                   mDictionary;
+   SimFieldDictionary::FieldMap::iterator mIterator;
+   SimFieldDictionary::Entry *            mEntry;
 
   public:
    SimFieldDictionaryIterator(SimFieldDictionary*);
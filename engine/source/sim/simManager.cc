@@ -30,6 +30,9 @@
 #include "io/fileObject.h"
 #include "console/consoleInternal.h"
 #include "memory/safeDelete.h"
+#include "collection/flatHashMap.h"
+#include "memory/memoryAllocator.h"
+#include "sim/simObjectPool.h"
 
 //---------------------------------------------------------------------------
 
@@ -48,9 +51,122 @@ SimTime gCurrentTime;
 SimTime gTargetTime;
 
 void *gEventQueueMutex;
-SimEvent *gEventQueue;
 U32 gEventSequence;
 
+// Pending events are kept in a binary min-heap ordered by time and then by
+// sequence so that events posted for the same time are processed in the
+// order they were posted.  The id index and the per object lists make
+// cancelling and querying an event independent of the queue length.
+static Vector<SimEvent*> gEventHeap;
+static FlatHashMap<U32, SimEvent*> gEventIndex;
+static FlatHashMap<SimObject*, SimEvent*> gObjectEvents;
+
+//---------------------------------------------------------------------------
+// event queue heap
+
+static inline bool isEventBefore(const SimEvent *a, const SimEvent *b)
+{
+   if(a->time != b->time)
+      return a->time < b->time;
+
+   // Sequence numbers wrap so compare them by distance.
+   return S32(a->sequenceCount - b->sequenceCount) < 0;
+}
+
+static inline void setEventSlot(U32 index, SimEvent *event)
+{
+   gEventHeap[index] = event;
+   event->queueIndex = index;
+}
+
+static void siftEventUp(U32 index)
+{
+   SimEvent *event = gEventHeap[index];
+   while(index > 0)
+   {
+      const U32 parent = (index - 1) >> 1;
+      if(!isEventBefore(event, gEventHeap[parent]))
+         break;
+
+      setEventSlot(index, gEventHeap[parent]);
+      index = parent;
+   }
+   setEventSlot(index, event);
+}
+
+static void siftEventDown(U32 index)
+{
+   const U32 count = gEventHeap.size();
+   SimEvent *event = gEventHeap[index];
+   for(;;)
+   {
+      U32 child = (index << 1) + 1;
+      if(child >= count)
+         break;
+
+      if(child + 1 < count && isEventBefore(gEventHeap[child + 1], gEventHeap[child]))
+         child++;
+
+      if(!isEventBefore(gEventHeap[child], event))
+         break;
+
+      setEventSlot(index, gEventHeap[child]);
+      index = child;
+   }
+   setEventSlot(index, event);
+}
+
+static void insertEvent(SimEvent *event)
+{
+   gEventHeap.push_back(event);
+   siftEventUp(gEventHeap.size() - 1);
+
+   gEventIndex.insert(event->sequenceCount, event);
+
+   // Link the event at the head of the destination object's pending list.
+   bool inserted;
+   SimEvent *&head = gObjectEvents.findOrInsert(event->destObject, &inserted);
+   event->prevObjectEvent = NULL;
+   event->nextObjectEvent = inserted ? NULL : head;
+   if(event->nextObjectEvent)
+      event->nextObjectEvent->prevObjectEvent = event;
+   head = event;
+}
+
+static void removeEvent(SimEvent *event)
+{
+   const U32 index = event->queueIndex;
+   SimEvent *last = gEventHeap.last();
+   gEventHeap.pop_back();
+
+   if(last != event)
+   {
+      setEventSlot(index, last);
+      if(index > 0 && isEventBefore(last, gEventHeap[(index - 1) >> 1]))
+         siftEventUp(index);
+      else
+         siftEventDown(index);
+   }
+
+   gEventIndex.erase(event->sequenceCount);
+
+   if(event->prevObjectEvent)
+      event->prevObjectEvent->nextObjectEvent = event->nextObjectEvent;
+   else if(event->nextObjectEvent)
+      gObjectEvents.insert(event->destObject, event->nextObjectEvent);
+   else
+      gObjectEvents.erase(event->destObject);
+
+   if(event->nextObjectEvent)
+      event->nextObjectEvent->prevObjectEvent = event->prevObjectEvent;
+}
+
+static inline SimEvent *findEvent(U32 eventSequence)
+{
+   SimEvent **event = gEventIndex.find(eventSequence);
+   return event ? *event : NULL;
+}
+
 //---------------------------------------------------------------------------
 // event queue init/shutdown
 
@@ -59,7 +175,6 @@ void initEventQueue()
    gCurrentTime = 0;
    gTargetTime = 0;
    gEventSequence = 1;
-   gEventQueue = NULL;
    gEventQueueMutex = Mutex::createMutex();
 }
 
@@ -67,13 +182,11 @@ void shutdownEventQueue()
 {
    // Delete all pending events
    Mutex::lockMutex(gEventQueueMutex);
-   SimEvent *walk = gEventQueue;
-   while(walk)
-   {
-      SimEvent *temp = walk->nextEvent;
-      delete walk;
-      walk = temp;
-   }
+   for(S32 i = 0; i < gEventHeap.size(); i++)
+      delete gEventHeap[i];
+   gEventHeap.clear();
+   gEventIndex.reset();
+   gObjectEvents.reset();
    Mutex::unlockMutex(gEventQueueMutex);
    Mutex::destroyMutex(gEventQueueMutex);
 }
@@ -105,19 +218,15 @@ U32 postEvent(SimObject *destObject, SimEvent* event,U32 time)
       return InvalidEventId;
    }
    event->sequenceCount = gEventSequence++;
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL && (current->time < event->time))
-      walk = &(current->nextEvent);
-   
-   // [tom, 6/24/2005] This ensures that SimEvents are dispatched in the same order that they are posted.
+
+   // Never hand out the invalid id when the sequence wraps.
+   if(gEventSequence == InvalidEventId)
+      gEventSequence++;
+
+   // [tom, 6/24/2005] SimEvents must be dispatched in the same order that they are posted.
    // This is needed to ensure Con::threadSafeExecute() executes script code in the correct order.
-   while((current = *walk) != NULL && (current->time == event->time))
-      walk = &(current->nextEvent);
-   
-   event->nextEvent = current;
-   *walk = event;
+   // The queue breaks ties between equal times with the sequence count.
+   insertEvent(event);
 
    U32 seqCount = event->sequenceCount;
 
@@ -133,20 +242,11 @@ void cancelEvent(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL)
+   SimEvent *event = findEvent(eventSequence);
+   if(event)
    {
-      if(current->sequenceCount == eventSequence)
-      {
-         *walk = current->nextEvent;
-         delete current;
-         Mutex::unlockMutex(gEventQueueMutex);
-         return;
-      }
-      else
-         walk = &(current->nextEvent);
+      removeEvent(event);
+      delete event;
    }
 
    Mutex::unlockMutex(gEventQueueMutex);
@@ -156,19 +256,14 @@ void cancelPendingEvents(SimObject *obj)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL)
+   SimEvent **head;
+   while((head = gObjectEvents.find(obj)) != NULL)
    {
-      if(current->destObject == obj)
-      {
-         *walk = current->nextEvent;
-         delete current;
-      }
-      else
-         walk = &(current->nextEvent);
+      SimEvent *event = *head;
+      removeEvent(event);
+      delete event;
    }
+
    Mutex::unlockMutex(gEventQueueMutex);
 }
 
@@ -178,48 +273,59 @@ void cancelPendingEvents(SimObject *obj)
 bool isEventPending(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
-
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-      {
-         Mutex::unlockMutex(gEventQueueMutex);
-         return true;
-      }
+   const bool pending = findEvent(eventSequence) != NULL;
    Mutex::unlockMutex(gEventQueueMutex);
-   return false;
+   return pending;
 }
 
 U32 getEventTimeLeft(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-      {
-         SimTime t = walk->time - getCurrentTime();
-         Mutex::unlockMutex(gEventQueueMutex);
-         return t;
-      }
+   SimTime t = 0;
+   SimEvent *event = findEvent(eventSequence);
+   if(event)
+      t = event->time - getCurrentTime();
 
    Mutex::unlockMutex(gEventQueueMutex);
 
-   return 0;   
+   return t;
 }
 
 U32 getScheduleDuration(U32 eventSequence)
 {
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-         return (walk->time-walk->startTime);
-   return 0;
+   Mutex::lockMutex(gEventQueueMutex);
+
+   SimTime t = 0;
+   SimEvent *event = findEvent(eventSequence);
+   if(event)
+      t = event->time - event->startTime;
+
+   Mutex::unlockMutex(gEventQueueMutex);
+
+   return t;
 }
 
 U32 getTimeSinceStart(U32 eventSequence)
 {
-   for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
-      if(walk->sequenceCount == eventSequence)
-         return (getCurrentTime()-walk->startTime);
-   return 0;
+   Mutex::lockMutex(gEventQueueMutex);
+
+   SimTime t = 0;
+   SimEvent *event = findEvent(eventSequence);
+   if(event)
+      t = getCurrentTime() - event->startTime;
+
+   Mutex::unlockMutex(gEventQueueMutex);
+
+   return t;
+}
+
+U32 getEventQueueSize()
+{
+   Mutex::lockMutex(gEventQueueMutex);
+   const U32 count = gEventHeap.size();
+   Mutex::unlockMutex(gEventQueueMutex);
+   return count;
 }
 
 //---------------------------------------------------------------------------
@@ -229,12 +335,14 @@ void advanceToTime(SimTime targetTime)
 {
    AssertFatal(targetTime >= getCurrentTime(), "EventQueue::process: cannot advance to time in the past.");
 
+   MemoryTagScope memoryTagScope(MemoryAllocator::SimTag);
+
    Mutex::lockMutex(gEventQueueMutex);
    gTargetTime = targetTime;
-   while(gEventQueue && gEventQueue->time <= targetTime)
+   while(gEventHeap.size() && gEventHeap[0]->time <= targetTime)
    {
-      SimEvent *event = gEventQueue;
-      gEventQueue = gEventQueue->nextEvent;
+      SimEvent *event = gEventHeap[0];
+      removeEvent(event);
       AssertFatal(event->time >= gCurrentTime,
             "SimEventQueue::pop: Cannot go back in time (flux capacitor not installed - BJG).");
       gCurrentTime = event->time;
@@ -287,6 +395,8 @@ void initRoot()
    gRootGroup = new SimGroup();
    gRootGroup->setId(RootGroupId);
    gRootGroup->assignName("RootGroup");
+   // Every object lands here so keep removal constant time.
+   gRootGroup->setOrdered(false);
    gRootGroup->registerObject();
 
    gNextObjectId = DynamicObjectIdFirst;
@@ -396,6 +506,9 @@ void shutdown()
 {
    shutdownRoot();
    shutdownEventQueue();
+
+   // Release any idle pooled objects.
+   SimObjectPoolBase::purgeAll();
 }
 
 } // Sim Namespace.
@@ -420,6 +533,6 @@ void SimDataBlockGroup::sort()
    if(mLastModifiedKey != SimDataBlock::getNextModifiedKey())
    {
       mLastModifiedKey = SimDataBlock::getNextModifiedKey();
-        dQsort(objectList.address(),objectList.size(),sizeof(SimObject *),compareModifiedKey);
+        objectList.sort(compareModifiedKey);
    }
 }
@@ -51,12 +51,12 @@ SimObject::SimObject( const U8 namespaceLinkMask ) : mNSLinkMask( namespaceLinkM
     mInternalName            = NULL;
     nextNameObject           = (SimObject*)-1;
     nextManagerNameObject    = (SimObject*)-1;
-    nextIdObject             = NULL;  
     mId                      = 0;
     mIdString                = StringTable->EmptyString;
     mGroup                   = 0;
     mNameSpace               = NULL;
     mNotifyList              = NULL;
+    mListMemberships         = NULL;
     mTypeMask                = 0;
     mScriptCallbackGuard     = 0;
     mFieldDictionary         = NULL;
@@ -158,6 +158,71 @@ void SimObject::deleteObject()
 
 //---------------------------------------------------------------------------
 
+void SimObject::recycleObject()
+{
+    // Sanity!
+    AssertISV( getScriptCallbackGuard() == 0, "SimObject::recycleObject: Object is being deleted whilst performing a script callback!" );
+
+    AssertFatal(mFlags.test(Added),
+        "SimObject::recycleObject: Object not registered.");
+    AssertFatal(!isDeleted(),"SimObject::recycleObject: "
+        "Object has already been deleted");
+    AssertFatal(!isRemoved(),"SimObject::recycleObject: "
+        "Object in the process of being removed");
+    mFlags.set(Deleted);
+
+    unregisterObject();
+
+    // Return the object to its class pool if there's room, otherwise free it.
+    // The pool resets the object so it is not referenced after this.
+    AbstractClassRep::ObjectPool* pPool = getClassRep()->getObjectPool();
+    if ( pPool == NULL || !pPool->recycleObject( this ) )
+        delete this;
+}
+
+//---------------------------------------------------------------------------
+
+void SimObject::resetObjectState( void )
+{
+    // Sanity!
+    AssertFatal( !isProperlyAdded(), "SimObject::resetObjectState() - Object is still registered." );
+    AssertFatal( nextNameObject == (SimObject*)-1 && nextManagerNameObject == (SimObject*)-1, "SimObject::resetObjectState() - Object is still in a name dictionary." );
+    AssertFatal( mNotifyList == NULL, "SimObject::resetObjectState() - Object still has notifications." );
+    AssertFatal( mGroup == NULL, "SimObject::resetObjectState() - Object is still in a group." );
+
+    // Objects may still be in a list.
+    if ( mListMemberships != NULL )
+        SimObjectList::removeFromAllLists( this );
+
+    // Discard dynamic fields.
+    delete mFieldDictionary;
+    mFieldDictionary = NULL;
+
+    mFlags.clear();
+    mFlags.set( ModStaticFields | ModDynamicFields );
+    objectName               = NULL;
+    mInternalName            = NULL;
+    mId                      = 0;
+    mIdString                = StringTable->EmptyString;
+    mNameSpace               = NULL;
+    mScriptCallbackGuard     = 0;
+    mCanSaveFieldDictionary  = true;
+    mClassName               = NULL;
+    mSuperClassName          = NULL;
+    mPeriodicTimerID         = 0;
+    mFieldFilter.clear();
+}
+
+//---------------------------------------------------------------------------
+
+void SimObject::onPoolReuse()
+{
+    // Attribute the object to the code creating it now.
+    mProgenitorFile = CodeBlock::getCurrentCodeBlockFullPath();
+}
+
+//---------------------------------------------------------------------------
+
 
 void SimObject::setId(SimObjectId newId)
 {
@@ -1156,23 +1221,30 @@ SimObject::~SimObject()
                   objectName,mId));
    AssertFatal(mFlags.test(Added) == 0, "SimObject::object "
                "missing call to SimObject::onRemove");
+
+   // Objects deleted directly may still be in a list.
+   if (mListMemberships != NULL)
+      SimObjectList::removeFromAllLists(this);
 }
 
 //---------------------------------------------------------------------------
 
+static ConstStringTableEntry lockedFieldName( "locked" );
+static ConstStringTableEntry hiddenFieldName( "hidden" );
+
 bool SimObject::isLocked()
 {
    if(!mFieldDictionary)
       return false;
 
-   const char * val = mFieldDictionary->getFieldValue( StringTable->insert( "locked", false ) );
+   const char * val = mFieldDictionary->getFieldValue( lockedFieldName );
 
    return( val ? dAtob(val) : false );
 }
 
 void SimObject::setLocked( bool b = true )
 {
-   setDataField(StringTable->insert("locked", false), NULL, b ? "true" : "false" );
+   setDataField(lockedFieldName, NULL, b ? "true" : "false" );
 }
 
 bool SimObject::isHidden()
@@ -1180,13 +1252,13 @@ bool SimObject::isHidden()
    if(!mFieldDictionary)
       return false;
 
-   const char * val = mFieldDictionary->getFieldValue( StringTable->insert( "hidden", false ) );
+   const char * val = mFieldDictionary->getFieldValue( hiddenFieldName );
    return( val ? dAtob(val) : false );
 }
 
 void SimObject::setHidden(bool b = true)
 {
-   setDataField(StringTable->insert("hidden", false), NULL, b ? "true" : "false" );
+   setDataField(hiddenFieldName, NULL, b ? "true" : "false" );
 }
 
 //---------------------------------------------------------------------------
@@ -1294,18 +1366,31 @@ void SimObject::freeNotify(SimObject::Notify* note)
 
 //------------------------------------------------------------------------------
 
+void SimObject::linkNotify(SimObject::Notify* note)
+{
+   note->next = mNotifyList;
+   note->prev = &mNotifyList;
+   if(mNotifyList)
+      mNotifyList->prev = &note->next;
+   mNotifyList = note;
+}
+
+void SimObject::unlinkNotify(SimObject::Notify* note)
+{
+   *note->prev = note->next;
+   if(note->next)
+      note->next->prev = note->prev;
+}
+
 SimObject::Notify* SimObject::removeNotify(void *ptr, SimObject::Notify::Type type)
 {
-   Notify **list = &mNotifyList;
-   while(*list)
+   for(Notify *note = mNotifyList; note; note = note->next)
    {
-      if((*list)->ptr == ptr && (*list)->type == type)
+      if(note->ptr == ptr && note->type == type)
       {
-         SimObject::Notify *ret = *list;
-         *list = ret->next;
-         return ret;
+         unlinkNotify(note);
+         return note;
       }
-      list = &((*list)->next);
    }
    return NULL;
 }
@@ -1316,27 +1401,27 @@ void SimObject::deleteNotify(SimObject* obj)
                "SimManager::deleteNotify: Object is being deleted");
    Notify *note = allocNotify();
    note->ptr = (void *) this;
-   note->next = obj->mNotifyList;
    note->type = Notify::DeleteNotify;
-   obj->mNotifyList = note;
+   obj->linkNotify(note);
 
-   note = allocNotify();
-   note->ptr = (void *) obj;
-   note->next = mNotifyList;
-   note->type = Notify::ClearNotify;
-   mNotifyList = note;
+   Notify *cnote = allocNotify();
+   cnote->ptr = (void *) obj;
+   cnote->type = Notify::ClearNotify;
+   linkNotify(cnote);
 
-   //obj->deleteNotifyList.pushBack(this);
-   //clearNotifyList.pushBack(obj);
+   // Pair the notes so that either can remove the other without
+   // searching the list it is in.
+   note->partner = cnote;
+   cnote->partner = note;
 }
 
 void SimObject::registerReference(SimObject **ptr)
 {
    Notify *note = allocNotify();
    note->ptr = (void *) ptr;
-   note->next = mNotifyList;
    note->type = Notify::ObjectRef;
-   mNotifyList = note;
+   note->partner = NULL;
+   linkNotify(note);
 }
 
 void SimObject::unregisterReference(SimObject **ptr)
@@ -1348,13 +1433,15 @@ void SimObject::unregisterReference(SimObject **ptr)
 
 void SimObject::clearNotify(SimObject* obj)
 {
+   // Search the list of the object being watched; it is usually far
+   // shorter than the list of a set watching many objects.
    Notify *note = obj->removeNotify((void *) this, Notify::DeleteNotify);
    if(note)
+   {
+      unlinkNotify(note->partner);
+      freeNotify(note->partner);
       freeNotify(note);
-
-   note = removeNotify((void *) obj, Notify::ClearNotify);
-   if(note)
-      freeNotify(note);
+   }
 }
 
 void SimObject::processDeleteNotifies()
@@ -1365,14 +1452,15 @@ void SimObject::processDeleteNotifies()
    while(mNotifyList)
    {
       Notify *note = mNotifyList;
-      mNotifyList = note->next;
+      unlinkNotify(note);
 
       AssertFatal(note->type != Notify::ClearNotify, "Clear notes should be all gone.");
 
       if(note->type == Notify::DeleteNotify)
       {
          SimObject *obj = (SimObject *) note->ptr;
-         Notify *cnote = obj->removeNotify((void *)this, Notify::ClearNotify);
+         Notify *cnote = note->partner;
+         unlinkNotify(cnote);
          obj->onDeleteNotify(this);
          freeNotify(cnote);
       }
@@ -1387,18 +1475,21 @@ void SimObject::processDeleteNotifies()
 
 void SimObject::clearAllNotifications()
 {
-   for(Notify **cnote = &mNotifyList; *cnote; )
+   Notify *cnote = mNotifyList;
+   while(cnote)
    {
-      Notify *temp = *cnote;
+      Notify *temp = cnote;
+      cnote = cnote->next;
       if(temp->type == Notify::ClearNotify)
       {
-         *cnote = temp->next;
-         Notify *note = ((SimObject *) temp->ptr)->removeNotify((void *) this, Notify::DeleteNotify);
+         // An object watching itself has both notes in this list.
+         if(cnote == temp->partner)
+            cnote = cnote->next;
+         unlinkNotify(temp);
+         unlinkNotify(temp->partner);
+         freeNotify(temp->partner);
          freeNotify(temp);
-         freeNotify(note);
       }
-      else
-         cnote = &(temp->next);
    }
 }
 
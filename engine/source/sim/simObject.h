@@ -35,6 +35,10 @@
 #include "persistence/taml/tamlCallbacks.h"
 #endif
 
+#ifndef _SIM_OBJECT_LIST_H_
+#include "sim/SimObjectList.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 typedef U32 SimObjectId;
@@ -236,6 +240,8 @@ class SimObject: public ConsoleObject, public TamlCallbacks
     friend class SimNameDictionary;
     friend class SimManagerNameDictionary;
     friend class SimIdDictionary;
+    friend class SimNameTable;
+    friend class SimObjectList;
 
     //-------------------------------------- Structures and enumerations
 private:
@@ -263,6 +269,8 @@ public:
         } type;
         void *ptr;        ///< Data (typically referencing or interested object).
         Notify *next;     ///< Next notification in the linked list.
+        Notify **prev;    ///< The list head or next pointer that points at this notification.
+        Notify *partner;  ///< The matching clear or delete notification in the other object's list.
     };
 
     /// @}
@@ -277,9 +285,9 @@ private:
     StringTableEntry objectName;
     SimObject*       nextNameObject;
     SimObject*       nextManagerNameObject;
-    SimObject*       nextIdObject;
 
     SimGroup*   mGroup;  ///< SimGroup we're contained in, if any.
+    SimObjectList::Membership* mListMemberships;   ///< Positions of this object in the SimObjectLists it is a member of.
     BitSet32    mFlags;
 
     StringTableEntry    mProgenitorFile;
@@ -310,6 +318,8 @@ protected:
     static SimObject::Notify *mNotifyFreeList;
     static SimObject::Notify *allocNotify();     ///< Get a free Notify structure.
     static void freeNotify(SimObject::Notify*);  ///< Mark a Notify structure as free.
+    void linkNotify(SimObject::Notify*);         ///< Add a Notify structure to the front of the list.
+    static void unlinkNotify(SimObject::Notify*);///< Remove a Notify structure from whichever list it is in.
 
     /// @}
 
@@ -325,6 +335,12 @@ protected:
     virtual void onTamlAddParent( SimObject* pParentObject ) {}
     virtual void onTamlCustomWrite( TamlCustomNodes& customNodes ) {}
     virtual void onTamlCustomRead( const TamlCustomNodes& customNodes ) {}
+
+    /// Object pool support.
+    /// Restores the constructed state of an unregistered object so that the object
+    /// pool of its class can hand it out again.  Pooled classes extend this with
+    /// their own state and call their parent.
+    void resetObjectState( void );
     
 protected:
     bool	mCanSaveFieldDictionary; ///< true if dynamic fields (added at runtime) should be saved, defaults to true
@@ -464,6 +480,8 @@ public:
     /// @{
     virtual bool onAdd();                                ///< Called when the object is added to the sim.
     virtual void onRemove();                             ///< Called when the object is removed from the sim.
+    virtual void onPoolRecycle() {}                      ///< Called when the object is kept by the object pool of its class.
+    virtual void onPoolReuse();                          ///< Called when the object pool of its class hands the object out again.
     virtual void onGroupAdd();                           ///< Called when the object is added to a SimGroup.
     virtual void onGroupRemove();                        ///< Called when the object is removed from a SimGroup.
     virtual void onNameChange(const char *name);         ///< Called when the object's name is changed.
@@ -600,6 +618,11 @@ public:
                             /// This helper function can be used when you're done with the object
                             /// and don't want to be bothered with the details of cleaning it up.
 
+    /// Unregister and mark as deleted like deleteObject() but hand the object
+    /// back to the object pool of its class, if it has one, instead of freeing it.
+    /// The object must not be referenced after this call.
+    void recycleObject();
+
     /// @}
 
     /// @name Accessors
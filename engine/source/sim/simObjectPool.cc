@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "sim/simObjectPool.h"
+#include "console/consoleInternal.h"
+#include "console/console.h"
+#include "math/mMathFn.h"
+
+//-----------------------------------------------------------------------------
+
+SimObjectPoolBase* SimObjectPoolBase::smFirstPool = NULL;
+
+//-----------------------------------------------------------------------------
+
+SimObjectPoolBase::SimObjectPoolBase( AbstractClassRep* pClassRep ) :
+   mpClassRep( pClassRep ),
+   mCapacity( 0 ),
+   mCachedCount( 0 ),
+   mCreatedCount( 0 ),
+   mReusedCount( 0 ),
+   mRecycledCount( 0 )
+{
+   AssertFatal( mpClassRep->getObjectPool() == NULL, "SimObjectPoolBase() - Class already has an object pool." );
+
+   // Take over object creation for the class.
+   mpClassRep->setObjectPool( this );
+
+   // Add to the pool list.
+   mpNextPool = smFirstPool;
+   smFirstPool = this;
+}
+
+//-----------------------------------------------------------------------------
+
+SimObjectPoolBase::~SimObjectPoolBase()
+{
+   mpClassRep->setObjectPool( NULL );
+
+   // Remove from the pool list.
+   for ( SimObjectPoolBase** ppPool = &smFirstPool; *ppPool != NULL; ppPool = &(*ppPool)->mpNextPool )
+   {
+      if ( *ppPool == this )
+      {
+         *ppPool = mpNextPool;
+         break;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectPoolBase::setCapacity( const U32 capacity )
+{
+   mCapacity = capacity;
+
+   // Delete any idle objects over the new capacity.
+   trim( mCapacity );
+}
+
+//-----------------------------------------------------------------------------
+
+
+SimObjectPoolBase* SimObjectPoolBase::findPool( const char* pClassName )
+{
+   for ( SimObjectPoolBase* pPool = smFirstPool; pPool != NULL; pPool = pPool->mpNextPool )
+   {
+      if ( dStricmp( pPool->mpClassRep->getClassName(), pClassName ) == 0 )
+         return pPool;
+   }
+
+   return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectPoolBase::purgeAll( void )
+{
+   for ( SimObjectPoolBase* pPool = smFirstPool; pPool != NULL; pPool = pPool->mpNextPool )
+      pPool->purge();
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObjectPoolBase::dumpAll( void )
+{
+   Con::printSeparator();
+   Con::printf( "Object Pools:" );
+   Con::printf( "Class                Capacity     Idle         Created      Reused       Recycled" );
+   Con::printSeparator();
+
+   for ( SimObjectPoolBase* pPool = smFirstPool; pPool != NULL; pPool = pPool->mpNextPool )
+   {
+      Con::printf( "%-20s %-12d %-12d %-12d %-12d %-12d", pPool->mpClassRep->getClassName(),
+         pPool->mCapacity, pPool->mCachedCount, pPool->mCreatedCount, pPool->mReusedCount, pPool->mRecycledCount );
+   }
+
+   Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( setObjectPoolCapacity, bool, 3, 3,    "(className, capacity) Sets how many idle objects of a class are kept for reuse.\n"
+                                                        "A capacity of zero disables the pool.\n"
+                                                        "@param className The class of the pool.\n"
+                                                        "@param capacity The maximum number of idle objects.\n"
+                                                        "@return Whether the class has an object pool or not.")
+{
+   SimObjectPoolBase* pPool = SimObjectPoolBase::findPool( argv[1] );
+   if ( pPool == NULL )
+   {
+      Con::warnf( "setObjectPoolCapacity() - Class '%s' does not have an object pool.", argv[1] );
+      return false;
+   }
+
+   pPool->setCapacity( getMax( dAtoi( argv[2] ), 0 ) );
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( getObjectPoolCapacity, S32, 2, 2,     "(className) Gets how many idle objects of a class are kept for reuse.\n"
+                                                        "@param className The class of the pool.\n"
+                                                        "@return The pool capacity or -1 if the class has no object pool.")
+{
+   SimObjectPoolBase* pPool = SimObjectPoolBase::findPool( argv[1] );
+   return pPool == NULL ? -1 : (S32)pPool->getCapacity();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( purgeObjectPools, void, 1, 1,          "() Deletes the idle objects held by all object pools.\n"
+                                                        "@return No return value.")
+{
+   SimObjectPoolBase::purgeAll();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( dumpObjectPools, void, 1, 1,           "() Prints the capacity and usage of each object pool.\n"
+                                                        "@return No return value.")
+{
+   SimObjectPoolBase::dumpAll();
+}
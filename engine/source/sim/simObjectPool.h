@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SIM_OBJECT_POOL_H_
+#define _SIM_OBJECT_POOL_H_
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _FACTORY_CACHE_H_
+#include "memory/factoryCache.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// The type independent part of SimObjectPool.
+///
+/// Pools register themselves with their class rep when they are
+/// constructed and are disabled until they are given a capacity.  The
+/// pools are kept in a global list so they can be found by class name
+/// and purged at shutdown.
+class SimObjectPoolBase : public AbstractClassRep::ObjectPool
+{
+public:
+   SimObjectPoolBase( AbstractClassRep* pClassRep );
+   virtual ~SimObjectPoolBase();
+
+   inline AbstractClassRep* getClassRep( void ) const    { return mpClassRep; }
+
+   /// The maximum number of idle objects the pool keeps.  A capacity of
+   /// zero disables the pool.  Lowering the capacity deletes the excess.
+   inline U32 getCapacity( void ) const                  { return mCapacity; }
+   void setCapacity( const U32 capacity );
+
+   inline U32 getCachedCount( void ) const               { return mCachedCount; }
+   inline U32 getCreatedCount( void ) const              { return mCreatedCount; }
+   inline U32 getReusedCount( void ) const               { return mReusedCount; }
+   inline U32 getRecycledCount( void ) const             { return mRecycledCount; }
+
+   /// Deletes all idle objects.
+   void purge( void )                                    { trim( 0 ); }
+
+   static SimObjectPoolBase* findPool( const char* pClassName );
+   static void purgeAll( void );
+   static void dumpAll( void );
+
+protected:
+   /// Frees idle objects until no more than the count remain.
+   virtual void trim( const U32 count ) = 0;
+
+   AbstractClassRep*    mpClassRep;
+   U32                  mCapacity;
+   U32                  mCachedCount;
+   U32                  mCreatedCount;
+   U32                  mReusedCount;
+   U32                  mRecycledCount;
+
+private:
+   SimObjectPoolBase*   mpNextPool;
+
+   static SimObjectPoolBase* smFirstPool;
+};
+
+//-----------------------------------------------------------------------------
+
+/// A pool of recycled instances of a SimObject class.
+///
+/// Once a class has a pool, ConsoleObject::create() takes idle objects from
+/// it before falling back to new, and SimObject::recycleObject() returns
+/// objects to it instead of deleting them.  Idle objects stay constructed
+/// in a FactoryCache which restores their constructed state with
+/// IFactoryObjectReset::resetState() when they are recycled so the class
+/// must implement it.  The object is told with SimObject::onPoolRecycle()
+/// and SimObject::onPoolReuse() when it goes idle and when it is handed
+/// out again.
+///
+/// Pools are declared with IMPLEMENT_SIMOBJECT_POOL next to the class
+/// IMPLEMENT_CONOBJECT.  Only objects of the exact class are pooled.
+template<class T>
+class SimObjectPool : public SimObjectPoolBase
+{
+public:
+   SimObjectPool() : SimObjectPoolBase( T::getStaticClassRep() )
+   {
+   }
+
+   virtual ~SimObjectPool()
+   {
+      purge();
+   }
+
+   virtual ConsoleObject* createObject( void )
+   {
+      // Create a new object if the pool is empty.
+      if ( mCachedCount == 0 )
+      {
+         ++mCreatedCount;
+         return mIdleObjects.createObject();
+      }
+
+      // Hand out an idle object.
+      --mCachedCount;
+      ++mReusedCount;
+      T* pObject = mIdleObjects.createObject();
+      pObject->onPoolReuse();
+      return pObject;
+   }
+
+   virtual bool recycleObject( ConsoleObject* pObject )
+   {
+      // Finish if the pool is full.
+      if ( mCachedCount >= mCapacity )
+         return false;
+
+      AssertFatal( pObject->getClassRep() == mpClassRep, "SimObjectPool::recycleObject() - Object is not of the pool class." );
+
+      // Keep the object and reset it.
+      T* pPoolObject = static_cast<T*>( pObject );
+      pPoolObject->onPoolRecycle();
+      mIdleObjects.cacheObject( pPoolObject );
+
+      ++mCachedCount;
+      ++mRecycledCount;
+      return true;
+   }
+
+protected:
+   virtual void trim( const U32 count )
+   {
+      // Take idle objects out of the cache and delete them.
+      while ( mCachedCount > count )
+      {
+         delete mIdleObjects.createObject();
+         --mCachedCount;
+      }
+   }
+
+private:
+   FactoryCache<T> mIdleObjects;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Declares the object pool of a class.  The pool is disabled until it is
+/// given a capacity with setObjectPoolCapacity().
+#define IMPLEMENT_SIMOBJECT_POOL(className) \
+   static SimObjectPool<className> g##className##ObjectPool
+
+#endif // _SIM_OBJECT_POOL_H_
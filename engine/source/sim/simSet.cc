@@ -40,8 +40,8 @@
 void SimSet::addObject(SimObject* obj)
 {
    lock();
-   objectList.pushBack(obj);
-   deleteNotify(obj);
+   if (objectList.pushBack(obj))
+      deleteNotify(obj);
    unlock();
 }
 
@@ -56,8 +56,10 @@ void SimSet::removeObject(SimObject* obj)
 void SimSet::pushObject(SimObject* pObj)
 {
    lock();
+   const bool added = !objectList.contains(pObj);
    objectList.pushBackForce(pObj);
-   deleteNotify(pObj);
+   if (added)
+      deleteNotify(pObj);
    unlock();
 }
 
@@ -110,8 +112,7 @@ bool SimSet::reOrder( SimObject *obj, SimObject *target )
    MutexHandle handle;
    handle.lock(mMutex);
 
-   iterator itrS, itrD;
-   if ( (itrS = find(begin(),end(),obj)) == end() )
+   if ( !objectList.contains(obj) )
    {
       return false;  // object must be in list
    }
@@ -123,22 +124,16 @@ bool SimSet::reOrder( SimObject *obj, SimObject *target )
 
    if ( !target )    // if no target, then put to back of list
    {
-      if ( itrS != (end()-1) )      // don't move if already last object
-      {
-         objectList.erase(itrS);    // remove object from its current location
-         objectList.push_back(obj); // push it to the back of the list
-      }
+      objectList.pushBackForce(obj);   // doesn't move if already last object
    }
    else              // if target, insert object in front of target
    {
-      if ( (itrD = find(begin(),end(),target)) == end() )
+      if ( !objectList.contains(target) )
          return false;              // target must be in list
 
-      objectList.erase(itrS);
-
-      //Tinman - once itrS has been erased, itrD won't be pointing at the same place anymore - re-find...
-      itrD = find(begin(),end(),target);
-      objectList.insert(itrD,obj);
+      // Once obj has been removed, the target may have moved - look it up afterwards.
+      objectList.removeStable(obj);
+      objectList.insertAt(objectList.indexOf(target), obj);
    }
 
    return true;
@@ -167,6 +162,9 @@ void SimSet::onRemove()
       }
    }
 
+   // Members are no longer tracked so drop them while they are known to exist.
+   objectList.clear();
+
    handle.unlock();
 
    Parent::onRemove();
@@ -209,7 +207,7 @@ void SimSet::deleteObjects( void )
     lock();
         while(size() > 0 )
         {
-            objectList[0]->deleteObject();
+            objectList.last()->deleteObject();
         }
     unlock();
 }
@@ -330,8 +328,9 @@ SimGroup::~SimGroup()
    objectList.sortId();
    while (!objectList.empty()) 
    {
-      delete objectList.last();
-      objectList.decrement();
+      SimObject* pObject = objectList.last();
+      objectList.remove(pObject);
+      delete pObject;
    }
 
    unlock();
@@ -359,7 +358,7 @@ void SimGroup::addObject(SimObject* obj)
          obj->mGroup->removeObject(obj);
       nameDictionary.insert(obj);
       obj->mGroup = this;
-      objectList.push_back(obj); // force it into the object list
+      objectList.pushBack(obj); // force it into the object list
       // doesn't get a delete notify
       obj->onGroupAdd();
    }
@@ -596,17 +595,23 @@ ConsoleMethod(SimSet, isMember, bool, 3, 3, "(object) @return Returns true if sp
    }
 
    object->lock();
-   for(SimSet::iterator i = object->begin(); i != object->end(); i++)
-   {
-      if(*i == testObject)
-      {
-         object->unlock();
-         return true;
-      }
-   }
+   const bool isMember = object->contains(testObject);
    object->unlock();
 
-   return false;
+   return isMember;
+}
+
+ConsoleMethod(SimSet, setOrdered, void, 3, 3, "(bool ordered) Sets whether removing objects preserves the order of the set.\n"
+              "An unordered set removes objects in constant time by moving the last object into the gap.\n"
+              "@param ordered Whether the set order is preserved.\n"
+              "@return No return value.")
+{
+   object->setOrdered(dAtob(argv[2]));
+}
+
+ConsoleMethod(SimSet, isOrdered, bool, 2, 2, "() @return Returns true if removing objects preserves the order of the set.")
+{
+   return object->isOrdered();
 }
 
 ConsoleMethod( SimSet, findObjectByInternalName, S32, 3, 4, "(string name, [bool searchChildren]) Returns the object with given internal name\n"
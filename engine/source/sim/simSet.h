@@ -138,7 +138,8 @@ public:
    value operator[] (S32 index) { return objectList[U32(index)]; }
 
    inline iterator find( iterator first, iterator last, SimObject *obj ) { return ::find(first, last, obj); }
-   inline iterator find( SimObject *obj ) { return ::find(begin(), end(), obj); }
+   inline iterator find( SimObject *obj ) { const S32 index = objectList.indexOf(obj); return index < 0 ? end() : begin() + index; }
+   inline bool contains( SimObject *obj ) const { return objectList.contains(obj); }
 
    template <typename T> inline bool containsType( void )
    {
@@ -156,6 +157,11 @@ public:
 
    void deleteObjects( void );
 
+   /// Sets whether removing an object preserves the order of the set.  An
+   /// unordered set removes objects in constant time.
+   void setOrdered( const bool ordered ) { objectList.setOrdered(ordered); }
+   bool isOrdered( void ) const { return objectList.isOrdered(); }
+
    void clear();
    /// @}
 
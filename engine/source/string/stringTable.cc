@@ -21,10 +21,12 @@
 //-----------------------------------------------------------------------------
 
 #include "platform/platform.h"
+#include "platform/platformIntrinsics.h"
 #include "stringTable.h"
 
 _StringTable *_gStringTable = NULL;
-const U32 _StringTable::csm_stInitSize = 29;
+const U32 _StringTable::csm_stInitSize = 64;
+U32 _StringTable::smGeneration = 0;
 StringTableEntry _StringTable::EmptyString;
 
 //---------------------------------------------------------------
@@ -36,17 +38,59 @@ StringTableEntry _StringTable::EmptyString;
 namespace {
 bool sgInitTable = true;
 U8   sgHashTable[256];
+U8   sgLowerTable[256];
 
 void initTolowerTable()
 {
    for (U32 i = 0; i < 256; i++) {
       U8 c = dTolower(i);
       sgHashTable[i] = c * c;
+      sgLowerTable[i] = c;
    }
 
    sgInitTable = false;
 }
 
+#ifdef TORQUE_THREAD_LOCAL
+
+/// Per-thread cache of recently inserted string pointers.  Hot call sites
+/// tend to pass the same literal or buffer over and over so remembering the
+/// pointer lets us skip hashing and probing.  Entries are validated against
+/// the string contents because buffers are reused with different strings.
+struct ThreadCacheEntry
+{
+   const char* key;
+   StringTableEntry value;
+   bool caseSens;
+};
+
+const U32 ThreadCacheSize = 256;
+
+TORQUE_THREAD_LOCAL ThreadCacheEntry sgThreadCache[ThreadCacheSize];
+TORQUE_THREAD_LOCAL U32 sgThreadCacheGeneration = 0;
+
+inline ThreadCacheEntry& getThreadCacheEntry(const char* string)
+{
+   // Flush the cache if the table was recreated.
+   if (sgThreadCacheGeneration != _StringTable::getGeneration()) {
+      dMemset(sgThreadCache, 0, sizeof(sgThreadCache));
+      sgThreadCacheGeneration = _StringTable::getGeneration();
+   }
+
+   const size_t key = (size_t)string;
+   return sgThreadCache[((key >> 2) ^ (key >> 10)) & (ThreadCacheSize - 1)];
+}
+
+inline bool isThreadCacheHit(const ThreadCacheEntry& entry, const char* string, const bool caseSens)
+{
+   // A case insensitive entry is the first string inserted that matches so any
+   // string matching it without case is resolved to the same entry.
+   return entry.key == string && entry.caseSens == caseSens &&
+      (caseSens ? !dStrcmp(entry.value, string) : !dStricmp(entry.value, string));
+}
+
+#endif
+
 } // namespace {}
 
 U32 _StringTable::hashString(const char* str)
@@ -77,16 +121,66 @@ U32 _StringTable::hashStringn(const char* str, S32 len)
    return ret;
 }
 
+//--------------------------------------
+U32 _StringTable::hashEntry(const char* str, S32 maxLength, U32& length)
+{
+   if (sgInitTable)
+      initTolowerTable();
+
+   // Case insensitive FNV-1a.  The length is measured in the same pass so
+   // that inserting a new string never has to walk it twice.
+   U32 hash = 2166136261u;
+   const char* walk = str;
+   while (*walk && maxLength-- != 0) {
+      hash ^= sgLowerTable[(U8)*walk++];
+      hash *= 16777619u;
+   }
+   length = (U32)(walk - str);
+
+   // Finalize so the high bits used to pick a shard are well mixed.
+   hash ^= hash >> 16;
+   hash *= 0x85ebca6b;
+   hash ^= hash >> 13;
+   hash *= 0xc2b2ae35;
+   hash ^= hash >> 16;
+   return hash;
+}
+
+//--------------------------------------
+_StringTable::SlotArray* _StringTable::allocSlotArray(const U32 size)
+{
+   AssertFatal(isPow2(size), "StringTable::allocSlotArray: Size must be a power of two.");
+
+   const U32 bytes = sizeof(SlotArray) + (size - 1) * sizeof(Node *);
+   SlotArray *table = (SlotArray *) dMalloc(bytes);
+   dMemset(table, 0, bytes);
+   table->mask = size - 1;
+   return table;
+}
+
+//--------------------------------------
+inline bool _StringTable::matches(const Node* node, const char* val, const U32 length, const bool caseSens)
+{
+   if (node->length != length)
+      return false;
+
+   return caseSens ? !dStrncmp(node->val, val, length) : !dStrnicmp(node->val, val, length);
+}
+
 //--------------------------------------
 _StringTable::_StringTable()
 {
-   buckets = (Node **) dMalloc(csm_stInitSize * sizeof(Node *));
-   for(U32 i = 0; i < csm_stInitSize; i++) {
-      buckets[i] = 0;
+   initTolowerTable();
+
+   for(U32 i = 0; i < ShardCount; i++) {
+      Shard &shard = mShards[i];
+      shard.table = allocSlotArray(csm_stInitSize);
+      shard.first = NULL;
+      shard.last = NULL;
+      shard.itemCount = 0;
    }
 
-   numBuckets = csm_stInitSize;
-   itemCount = 0;
+   smGeneration++;
 
    // Insert empty string.
    EmptyString = insert("");
@@ -95,7 +189,14 @@ _StringTable::_StringTable()
 //--------------------------------------
 _StringTable::~_StringTable()
 {
-   dFree(buckets);
+   for(U32 i = 0; i < ShardCount; i++) {
+      SlotArray *table = mShards[i].table;
+      while(table) {
+         SlotArray *retired = table->retired;
+         dFree(table);
+         table = retired;
+      }
+   }
 }
 
 
@@ -118,36 +219,106 @@ void _StringTable::destroy()
 }
 
 //--------------------------------------
-StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+StringTableEntry _StringTable::find(Shard& shard, const char* val, const U32 hash, const U32 length, const bool caseSens)
 {
-   if ( val == NULL )
-       return StringTable->EmptyString;
+   // No lock is required here.  Slots are only ever filled, never cleared,
+   // and a shard that grows leaves its old slot array intact for readers.
+   SlotArray *table = dAtomicReadPtr(shard.table);
+   U32 index = hash & table->mask;
+   Node *walk;
+   while((walk = dAtomicReadPtr(table->slots[index])) != NULL) {
+      if(walk->hash == hash && matches(walk, val, length, caseSens))
+         return walk->val;
+      index = (index + 1) & table->mask;
+   }
+   return NULL;
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insertEntry(const char* val, const U32 hash, const U32 length, const bool caseSens)
+{
+   Shard &shard = getShard(hash);
 
    MutexHandle mutex;
-   mutex.lock(&mMutex, true);
-
-   Node **walk, *temp;
-   U32 key = hashString(val);
-   walk = &buckets[key % numBuckets];
-   while((temp = *walk) != NULL)   {
-      if(caseSens && !dStrcmp(temp->val, val))
-         return temp->val;
-      else if(!caseSens && !dStricmp(temp->val, val))
-         return temp->val;
-      walk = &(temp->next);
+   mutex.lock(&shard.mutex, true);
+
+   // Another thread may have added the string since the unlocked probe.
+   // New strings are added at the end of their probe sequence so that case
+   // sens strings are always after their corresponding case insens strings.
+   SlotArray *table = shard.table;
+   U32 index = hash & table->mask;
+   Node *walk;
+   while((walk = table->slots[index]) != NULL) {
+      if(walk->hash == hash && matches(walk, val, length, caseSens))
+         return walk->val;
+      index = (index + 1) & table->mask;
    }
-   char *ret = 0;
-   if(!*walk) {
-      *walk = (Node *) mempool.alloc(sizeof(Node));
-      (*walk)->next = 0;
-      (*walk)->val = (char *) mempool.alloc(dStrlen(val) + 1);
-      dStrcpy((*walk)->val, val);
-      ret = (*walk)->val;
-      itemCount ++;
-   }
-   if(itemCount > 2 * numBuckets) {
-      resize(4 * numBuckets - 1);
+
+   Node *node = (Node *) shard.mempool.alloc(sizeof(Node) + length);
+   node->next = NULL;
+   node->hash = hash;
+   node->length = length;
+   dMemcpy(node->val, val, length);
+   node->val[length] = 0;
+
+   if(shard.last)
+      shard.last->next = node;
+   else
+      shard.first = node;
+   shard.last = node;
+   shard.itemCount++;
+
+   // Keep the load factor at or below one half.
+   if(shard.itemCount * 2 > table->mask + 1)
+      growShard(shard, (table->mask + 1) * 2);
+   else
+      dAtomicWritePtr(table->slots[index], node);
+
+   return node->val;
+}
+
+//--------------------------------------
+void _StringTable::growShard(Shard& shard, const U32 newSize)
+{
+   SlotArray *table = allocSlotArray(newSize);
+
+   // Re-insert in insertion order to preserve the probe order of strings
+   // that only differ by case.
+   for(Node *walk = shard.first; walk; walk = walk->next) {
+      U32 index = walk->hash & table->mask;
+      while(table->slots[index] != NULL)
+         index = (index + 1) & table->mask;
+      table->slots[index] = walk;
    }
+
+   table->retired = shard.table;
+   dAtomicWritePtr(shard.table, table);
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+{
+   if ( val == NULL )
+       return StringTable->EmptyString;
+
+#ifdef TORQUE_THREAD_LOCAL
+   ThreadCacheEntry &cacheEntry = getThreadCacheEntry(val);
+   if(isThreadCacheHit(cacheEntry, val, caseSens))
+      return cacheEntry.value;
+#endif
+
+   U32 length;
+   const U32 hash = hashEntry(val, -1, length);
+   StringTableEntry ret = find(getShard(hash), val, hash, length, caseSens);
+   if(ret == NULL)
+      ret = insertEntry(val, hash, length, caseSens);
+
+#ifdef TORQUE_THREAD_LOCAL
+   cacheEntry.key = val;
+   cacheEntry.value = ret;
+   cacheEntry.caseSens = caseSens;
+#endif
+
    return ret;
 }
 
@@ -157,14 +328,12 @@ StringTableEntry _StringTable::insertn(const char* src, S32 len, const bool  cas
    if ( src == NULL )
        return StringTable->EmptyString;
 
-   MutexHandle mutex;
-   mutex.lock(&mMutex, true);
-
-   char val[1024];
-   AssertFatal(len < sizeof(val), "Invalid string to insertn");
-   dStrncpy(val, src, len);
-   val[len] = 0;
-   return insert(val, caseSens);
+   U32 length;
+   const U32 hash = hashEntry(src, len, length);
+   StringTableEntry ret = find(getShard(hash), src, hash, length, caseSens);
+   if(ret == NULL)
+      ret = insertEntry(src, hash, length, caseSens);
+   return ret;
 }
 
 //--------------------------------------
@@ -173,20 +342,26 @@ StringTableEntry _StringTable::lookup(const char* val, const bool  caseSens)
    if ( val == NULL )
        return StringTable->EmptyString;
 
-   MutexHandle mutex;
-   mutex.lock(&mMutex, true);
-
-   Node **walk, *temp;
-   U32 key = hashString(val);
-   walk = &buckets[key % numBuckets];
-   while((temp = *walk) != NULL)   {
-      if(caseSens && !dStrcmp(temp->val, val))
-            return temp->val;
-      else if(!caseSens && !dStricmp(temp->val, val))
-         return temp->val;
-      walk = &(temp->next);
+#ifdef TORQUE_THREAD_LOCAL
+   ThreadCacheEntry &cacheEntry = getThreadCacheEntry(val);
+   if(isThreadCacheHit(cacheEntry, val, caseSens))
+      return cacheEntry.value;
+#endif
+
+   U32 length;
+   const U32 hash = hashEntry(val, -1, length);
+   StringTableEntry ret = find(getShard(hash), val, hash, length, caseSens);
+
+#ifdef TORQUE_THREAD_LOCAL
+   // Only hits are cached as a miss may be inserted later.
+   if(ret != NULL) {
+      cacheEntry.key = val;
+      cacheEntry.value = ret;
+      cacheEntry.caseSens = caseSens;
    }
-   return NULL;
+#endif
+
+   return ret;
 }
 
 //--------------------------------------
@@ -195,53 +370,33 @@ StringTableEntry _StringTable::lookupn(const char* val, S32 len, const bool  cas
    if ( val == NULL )
        return StringTable->EmptyString;
 
-   Node **walk, *temp;
-   U32 key = hashStringn(val, len);
-   walk = &buckets[key % numBuckets];
-   while((temp = *walk) != NULL) {
-      if(caseSens && !dStrncmp(temp->val, val, len) && temp->val[len] == 0)
-         return temp->val;
-      else if(!caseSens && !dStrnicmp(temp->val, val, len) && temp->val[len] == 0)
-         return temp->val;
-      walk = &(temp->next);
-   }
-   return NULL;
+   U32 length;
+   const U32 hash = hashEntry(val, len, length);
+   return find(getShard(hash), val, hash, length, caseSens);
 }
 
 //--------------------------------------
 void _StringTable::resize(const U32 newSize)
 {
-   Node *head = NULL, *walk, *temp;
-   U32 i;
-   // reverse individual bucket lists
-   // we do this because new strings are added at the end of bucket
-   // lists so that case sens strings are always after their
-   // corresponding case insens strings
-
-   for(i = 0; i < numBuckets; i++) {
-      walk = buckets[i];
-      while(walk)
-      {
-         temp = walk->next;
-         walk->next = head;
-         head = walk;
-         walk = temp;
-      }
-   }
-   buckets = (Node **) dRealloc(buckets, newSize * sizeof(Node));
-   for(i = 0; i < newSize; i++) {
-      buckets[i] = 0;
-   }
-   numBuckets = newSize;
-   walk = head;
-   while(walk) {
-      U32 key;
-      Node *temp = walk;
-
-      walk = walk->next;
-      key = hashString(temp->val);
-      temp->next = buckets[key % newSize];
-      buckets[key % newSize] = temp;
+   // Spread the requested capacity over the shards at a load factor of one half.
+   const U32 shardSize = getNextPow2(getMax(newSize * 2 / ShardCount, csm_stInitSize));
+
+   for(U32 i = 0; i < ShardCount; i++) {
+      Shard &shard = mShards[i];
+
+      MutexHandle mutex;
+      mutex.lock(&shard.mutex, true);
+
+      if(shardSize > shard.table->mask + 1)
+         growShard(shard, shardSize);
    }
 }
 
+//--------------------------------------
+U32 _StringTable::getItemCount()
+{
+   U32 count = 0;
+   for(U32 i = 0; i < ShardCount; i++)
+      count += dAtomicRead(mShards[i].itemCount);
+   return count;
+}
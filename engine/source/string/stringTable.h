@@ -82,18 +82,60 @@ private:
    /// @{
 
    /// This is internal to the _StringTable class.
+   ///
+   /// Nodes are never modified once they have been published to a shard so
+   /// they can be read without holding any lock.
    struct Node
    {
-      char *val;
       Node *next;
+      U32 hash;
+      U32 length;
+      char val[1];
+   };
+
+   /// Open addressing slot array for a shard.
+   ///
+   /// A shard swaps in a larger slot array when it grows but the old array
+   /// is retired rather than freed so that concurrent readers can finish
+   /// probing it.
+   struct SlotArray
+   {
+      U32 mask;
+      SlotArray *retired;
+      Node * volatile slots[1];
+   };
+
+   /// A shard owns a slice of the hash space with its own lock and memory pool.
+   struct Shard
+   {
+      SlotArray * volatile table;
+      Node *first;
+      Node *last;
+      volatile U32 itemCount;
+      DataChunker mempool;
+      Mutex mutex;
    };
 
-   Node**      buckets;
-   U32         numBuckets;
-   U32         itemCount;
-   DataChunker mempool;
+   enum
+   {
+      ShardBits = 4,
+      ShardCount = 1 << ShardBits,
+   };
+
+   Shard mShards[ShardCount];
+
+   /// Incremented whenever a table is created so that stale per-thread cache
+   /// entries from a destroyed table are never returned.
+   static U32 smGeneration;
 
-   Mutex mMutex;
+   static U32 hashEntry(const char* string, S32 maxLength, U32& length);
+   static SlotArray* allocSlotArray(const U32 size);
+   static bool matches(const Node* node, const char* string, const U32 length, const bool caseSens);
+
+   Shard& getShard(const U32 hash) { return mShards[hash >> (32 - ShardBits)]; }
+   StringTableEntry find(Shard& shard, const char* string, const U32 hash, const U32 length, const bool caseSens);
+   StringTableEntry insertEntry(const char* string, const U32 hash, const U32 length, const bool caseSens);
+   void growShard(Shard& shard, const U32 newSize);
 
   protected:
    static const U32 csm_stInitSize;
@@ -117,6 +159,10 @@ private:
    /// Get a pointer from the string table, adding the string to the table
    /// if it was not already present.
    ///
+   /// Strings that are already present are found without taking a lock and
+   /// repeated calls with the same string pointer are answered from a small
+   /// per-thread cache.
+   ///
    /// @param  string   String to check in the table (and add).
    /// @param  caseSens Determines whether case matters.
    StringTableEntry insert(const char *string, bool caseSens = false);
@@ -152,6 +198,13 @@ private:
    /// @param newSize   Number of new items to allocate space for.
    void             resize(const U32 newSize);
 
+   /// Get the number of strings held by the table.
+   U32              getItemCount();
+
+   /// Get the number of times the table has been created.  Cached entries
+   /// are only valid for the generation they were resolved in.
+   static U32 getGeneration() { return smGeneration; }
+
    /// Hash a string into a U32.
    static U32 hashString(const char* in_pString);
 
@@ -173,5 +226,51 @@ inline _StringTable* _getStringTable()
 
 #define StringTable _getStringTable()
 
+//--------------------------------------
+/// A string table entry for a string known at compile time.
+///
+/// The string is only inserted into the StringTable the first time the entry is
+/// used after which it is a plain pointer read.  This is intended for hot call
+/// sites that would otherwise hash the same literal every time they run.
+///
+/// @code
+/// static ConstStringTableEntry sOnCollision( "onCollision" );
+/// if ( pNamespace->lookup( sOnCollision ) != NULL ) ...
+/// @endcode
+class ConstStringTableEntry
+{
+private:
+   const char* mString;
+   bool mCaseSens;
+   mutable StringTableEntry mEntry;
+   mutable U32 mGeneration;
+
+public:
+   explicit ConstStringTableEntry( const char* string, const bool caseSens = false ) :
+      mString( string ),
+      mCaseSens( caseSens ),
+      mEntry( NULL ),
+      mGeneration( 0 )
+   {
+   }
+
+   /// Get the string table entry, inserting the string if required.
+   StringTableEntry get() const
+   {
+      _StringTable* pStringTable = StringTable;
+
+      // Re-resolve if the table has been recreated since we last resolved.
+      if ( mEntry == NULL || mGeneration != _StringTable::getGeneration() )
+      {
+         mEntry = pStringTable->insert( mString, mCaseSens );
+         mGeneration = _StringTable::getGeneration();
+      }
+
+      return mEntry;
+   }
+
+   operator StringTableEntry() const { return get(); }
+};
+
 #endif //_STRINGTABLE_H_
 
@@ -23,10 +23,16 @@
 #include "console/console.h"
 #include "string/stringUnit.h"
 #include "string/stringTable.h"
+#include "platform/platformIntrinsics.h"
 
 namespace StringUnit
 {
+#ifdef TORQUE_THREAD_LOCAL
+   // Each thread has its own buffer so units can be fetched off the main thread.
+   static TORQUE_THREAD_LOCAL char _returnBuffer[4096];
+#else
    static char _returnBuffer[4096];
+#endif
 
    StringTableEntry getStringTableUnit(const char* string, U32 index, const char* set)
    {
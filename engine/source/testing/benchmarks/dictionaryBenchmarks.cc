@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _CONSOLE_DICTIONARY_H_
+#include "console/consoleDictionary.h"
+#endif
+
+#ifndef _SIM_FIELD_DICTIONARY_H_
+#include "sim/simFieldDictionary.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define DICTIONARY_BENCHMARK_MAX_NAMES      1024
+
+//-----------------------------------------------------------------------------
+
+namespace DictionaryBenchmarks
+{
+    static StringTableEntry sNames[DICTIONARY_BENCHMARK_MAX_NAMES];
+
+    //-----------------------------------------------------------------------------
+
+    static void createNames( const char* pPrefix, const U32 nameCount )
+    {
+        char buffer[64];
+        for( U32 index = 0; index < nameCount; ++index )
+        {
+            dSprintf( buffer, sizeof(buffer), "%s%d", pPrefix, index );
+            sNames[index] = StringTable->insert( buffer );
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static void runGlobalVariables( const U32 nameCount, const U32 iterations )
+    {
+        Dictionary dictionary( NULL );
+        createNames( "$dictionaryBenchmark", nameCount );
+
+        // Set.
+        U32 startTime = Platform::getRealMilliseconds();
+        for( U32 iteration = 0; iteration < iterations; ++iteration )
+            dictionary.setVariable( sNames[iteration % nameCount], "1" );
+        const U32 setTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+        // Get.
+        startTime = Platform::getRealMilliseconds();
+        for( U32 iteration = 0; iteration < iterations; ++iteration )
+            dictionary.getVariable( sNames[iteration % nameCount] );
+        const U32 getTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+        Con::printf( "Global variables  %-8d %-13.0f %-13.0f", nameCount, F32(iterations) / F32(setTime), F32(iterations) / F32(getTime) );
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static void runDynamicFields( const U32 nameCount, const U32 iterations )
+    {
+        SimFieldDictionary dictionary;
+        createNames( "dictionaryBenchmarkField", nameCount );
+
+        // Set.
+        U32 startTime = Platform::getRealMilliseconds();
+        for( U32 iteration = 0; iteration < iterations; ++iteration )
+            dictionary.setFieldValue( sNames[iteration % nameCount], "1" );
+        const U32 setTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+        // Get.
+        startTime = Platform::getRealMilliseconds();
+        for( U32 iteration = 0; iteration < iterations; ++iteration )
+            dictionary.getFieldValue( sNames[iteration % nameCount] );
+        const U32 getTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+        Con::printf( "Dynamic fields    %-8d %-13.0f %-13.0f", nameCount, F32(iterations) / F32(setTime), F32(iterations) / F32(getTime) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runDictionaryBenchmarks, void, 1, 2,   "([iterations]) - Measures global variable and dynamic field get/set throughput.\n"
+                                                        "@param iterations The number of gets and sets performed for each test (default 1000000).\n"
+                                                        "@return No return value.")
+{
+    const U32 iterations = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 1000000;
+
+    Con::printSeparator();
+    Con::printf( "Dictionary benchmarks (%d operations, operations per millisecond):", iterations );
+    Con::printf( "Test              Names    Set           Get" );
+
+    for( U32 nameCount = 4; nameCount <= DICTIONARY_BENCHMARK_MAX_NAMES; nameCount *= 4 )
+        DictionaryBenchmarks::runGlobalVariables( nameCount, iterations );
+
+    for( U32 nameCount = 4; nameCount <= DICTIONARY_BENCHMARK_MAX_NAMES; nameCount *= 4 )
+        DictionaryBenchmarks::runDynamicFields( nameCount, iterations );
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BENCHMARKING_H_
+#include "testing/benchmarks/benchmarking.h"
+#endif
+
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+
+namespace MemoryBenchmarks
+{
+    using Benchmarking::getRate;
+
+    //-----------------------------------------------------------------------------
+
+    /// Allocates a window of small blocks then frees them, as a busy frame would.
+    static U32 runEngine( const U32 blockCount, const U32 passCount, void** pBlocks )
+    {
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 pass = 0; pass < passCount; ++pass )
+        {
+            for ( U32 index = 0; index < blockCount; ++index )
+                pBlocks[index] = MemoryAllocator::allocate( 16 + ( index * 24 ) % 240, MemoryAllocator::GeneralTag );
+
+            for ( U32 index = 0; index < blockCount; ++index )
+                MemoryAllocator::free( pBlocks[index] );
+        }
+        return Platform::getRealMilliseconds() - startTime;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static U32 runSystem( const U32 blockCount, const U32 passCount, void** pBlocks )
+    {
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 pass = 0; pass < passCount; ++pass )
+        {
+            for ( U32 index = 0; index < blockCount; ++index )
+                pBlocks[index] = malloc( 16 + ( index * 24 ) % 240 );
+
+            for ( U32 index = 0; index < blockCount; ++index )
+                free( pBlocks[index] );
+        }
+        return Platform::getRealMilliseconds() - startTime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runMemoryBenchmarks, void, 1, 2, "([blockCount]) - Measures allocating and freeing small blocks with the engine allocator and the C runtime.\n"
+                                                  "@param blockCount The number of blocks allocated before they are freed (default 1024).\n"
+                                                  "@return No return value.")
+{
+    using namespace MemoryBenchmarks;
+
+    const U32 blockCount = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 1024;
+    const U32 passCount = getMax( 4000000 / blockCount, (U32)1 );
+
+    void** pBlocks = (void**)malloc( sizeof(void*) * blockCount );
+
+    Con::printSeparator();
+    Con::printf( "Memory benchmarks (%d blocks, allocations and frees per millisecond):", blockCount );
+    Con::printf( "                %-13s%-13s", MemoryAllocator::getBackend()->getName(), "C Runtime" );
+
+    const U32 engineTime = runEngine( blockCount, passCount, pBlocks );
+    const U32 systemTime = runSystem( blockCount, passCount, pBlocks );
+
+    Con::printf( "  Alloc/Free      %-13.0f%-13.0f", getRate( blockCount * passCount, engineTime ), getRate( blockCount * passCount, systemTime ) );
+
+    free( pBlocks );
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#ifndef _SIM_OBJECT_POOL_H_
+#include "sim/simObjectPool.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SPRITE_H_
+#include "2d/sceneobject/Sprite.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BENCHMARKING_H_
+#include "testing/benchmarks/benchmarking.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace ObjectPoolBenchmarks
+{
+    using Benchmarking::getRate;
+
+    //-----------------------------------------------------------------------------
+
+    /// Spawns a wave of sprites into the scene then safe-deletes them, as a
+    /// burst of bullets or effects would.
+    static U32 runWaves( Scene* pScene, const U32 spriteCount, const U32 waveCount, Vector<SceneObject*>& sprites )
+    {
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 wave = 0; wave < waveCount; ++wave )
+        {
+            for ( U32 index = 0; index < spriteCount; ++index )
+            {
+                SceneObject* pSprite = static_cast<SceneObject*>( ConsoleObject::create( "Sprite" ) );
+                pSprite->registerObject();
+                pScene->addToScene( pSprite );
+                sprites[index] = pSprite;
+            }
+
+            for ( U32 index = 0; index < spriteCount; ++index )
+                sprites[index]->safeDelete();
+
+            pScene->processDeleteRequests( true );
+        }
+        return Platform::getRealMilliseconds() - startTime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runObjectPoolBenchmarks, void, 1, 2, "([spriteCount]) - Measures spawning and safe-deleting sprites in a scene with and without the sprite object pool.\n"
+                                                      "@param spriteCount The number of sprites spawned in each wave (default 256).\n"
+                                                      "@return No return value.")
+{
+    using namespace ObjectPoolBenchmarks;
+
+    const U32 spriteCount = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 256;
+    const U32 waveCount = getMax( 200000 / spriteCount, (U32)1 );
+
+    SimObjectPoolBase* pPool = SimObjectPoolBase::findPool( "Sprite" );
+    if ( pPool == NULL )
+    {
+        Con::warnf( "runObjectPoolBenchmarks() - Sprite does not have an object pool." );
+        return;
+    }
+
+    const U32 previousCapacity = pPool->getCapacity();
+
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    Vector<SceneObject*> sprites;
+    sprites.setSize( spriteCount );
+
+    Con::printSeparator();
+    Con::printf( "Object pool benchmarks (%d sprites per wave, spawns and deletes per millisecond):", spriteCount );
+    Con::printf( "                %-13s%-13s", "No Pool", "Pooled" );
+
+    pPool->setCapacity( 0 );
+    const U32 unpooledTime = runWaves( pScene, spriteCount, waveCount, sprites );
+
+    // Warm the pool so every wave is served from it.
+    pPool->setCapacity( spriteCount );
+    runWaves( pScene, spriteCount, 1, sprites );
+    const U32 pooledTime = runWaves( pScene, spriteCount, waveCount, sprites );
+
+    Con::printf( "  Spawn/Delete    %-13.0f%-13.0f", getRate( spriteCount * waveCount, unpooledTime ), getRate( spriteCount * waveCount, pooledTime ) );
+
+    pPool->setCapacity( previousCapacity );
+    pScene->deleteObject();
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BENCHMARKING_H_
+#include "testing/benchmarks/benchmarking.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace SimEventBenchmarks
+{
+    using Benchmarking::getRate;
+
+    static U32 sProcessedCount;
+    static U32 sLastSequence;
+    static bool sOrderValid;
+
+    //-----------------------------------------------------------------------------
+
+    class BenchmarkEvent : public SimEvent
+    {
+    public:
+        virtual void process( SimObject* object )
+        {
+            // Events due at the same time must be processed in the order they were posted.
+            if ( sProcessedCount > 0 && sequenceCount <= sLastSequence )
+                sOrderValid = false;
+
+            sLastSequence = sequenceCount;
+            sProcessedCount++;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+
+    static inline U32 nextRandom( U32& seed )
+    {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runSimEventBenchmarks, void, 1, 2, "([eventCount]) - Measures posting, querying, cancelling and dispatching Sim events.\n"
+                                                    "@param eventCount The number of pending events used for each test (default 100000).\n"
+                                                    "@return No return value.")
+{
+    using namespace SimEventBenchmarks;
+
+    const U32 eventCount = argc > 1 ? getMax( dAtoi(argv[1]), 2 ) : 100000;
+
+    SimObject* pObject = new SimObject();
+    pObject->registerObject();
+
+    Vector<U32> eventIds;
+    eventIds.setSize( eventCount );
+
+    Con::printSeparator();
+    Con::printf( "Sim event benchmarks (%d pending events, operations per millisecond):", eventCount );
+
+    // Post events spread over the next ten seconds.
+    U32 seed = 1;
+    const SimTime currentTime = Sim::getCurrentTime();
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < eventCount; ++index )
+        eventIds[index] = Sim::postEvent( pObject, new BenchmarkEvent(), currentTime + 1 + nextRandom( seed ) % 10000 );
+    Con::printf( "Post              %-13.0f", getRate( eventCount, Platform::getRealMilliseconds() - startTime ) );
+
+    // Query every event.
+    U32 pendingCount = 0;
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < eventCount; ++index )
+    {
+        if ( Sim::isEventPending( eventIds[index] ) )
+            pendingCount++;
+    }
+    Con::printf( "Is pending        %-13.0f", getRate( eventCount, Platform::getRealMilliseconds() - startTime ) );
+
+    // Cancel every other event.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < eventCount; index += 2 )
+        Sim::cancelEvent( eventIds[index] );
+    Con::printf( "Cancel            %-13.0f", getRate( eventCount / 2, Platform::getRealMilliseconds() - startTime ) );
+
+    // Dispatch events that are all due now on top of the pending ones.
+    sProcessedCount = 0;
+    sLastSequence = 0;
+    sOrderValid = true;
+    for ( U32 index = 0; index < eventCount; ++index )
+        Sim::postEvent( pObject, new BenchmarkEvent(), currentTime );
+    startTime = Platform::getRealMilliseconds();
+    Sim::advanceTime( 0 );
+    Con::printf( "Dispatch          %-13.0f", getRate( sProcessedCount, Platform::getRealMilliseconds() - startTime ) );
+
+    // Deleting the object cancels the remaining events.
+    const U32 remainingCount = Sim::getEventQueueSize();
+    startTime = Platform::getRealMilliseconds();
+    pObject->deleteObject();
+    Con::printf( "Cancel object     %-13.0f", getRate( remainingCount, Platform::getRealMilliseconds() - startTime ) );
+
+    if ( pendingCount != eventCount || sProcessedCount != eventCount || !sOrderValid )
+        Con::errorf( "Sim event benchmarks - Unexpected results: %d pending, %d processed, order %s.", pendingCount, sProcessedCount, sOrderValid ? "valid" : "invalid" );
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,207 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMLOOKUP_BENCHMARK_MAX_THREADS     8
+#define SIMLOOKUP_BENCHMARK_NAME_INTERVAL   8
+#define SIMLOOKUP_BENCHMARK_NAME_LENGTH     32
+
+//-----------------------------------------------------------------------------
+
+namespace SimLookupBenchmarks
+{
+    struct WorkerData
+    {
+        bool mByName;
+        U32 mIterations;
+        U32 mFirstId;
+        U32 mIdCount;
+        U32 mNameCount;
+        const char* mNames;
+        U32 mFoundCount;
+    };
+
+    //-----------------------------------------------------------------------------
+
+    static void worker( void* pData )
+    {
+        WorkerData* pWorkerData = (WorkerData*)pData;
+
+        // Step through the objects with a stride so that lookups don't just walk memory in order.
+        U32 foundCount = 0;
+        if ( pWorkerData->mByName )
+        {
+            for( U32 iteration = 0; iteration < pWorkerData->mIterations; ++iteration )
+            {
+                const U32 index = (iteration * 7919) % pWorkerData->mNameCount;
+                if ( Sim::findObject( pWorkerData->mNames + index * SIMLOOKUP_BENCHMARK_NAME_LENGTH ) != NULL )
+                    foundCount++;
+            }
+        }
+        else
+        {
+            for( U32 iteration = 0; iteration < pWorkerData->mIterations; ++iteration )
+            {
+                const U32 index = (iteration * 7919) % pWorkerData->mIdCount;
+                if ( Sim::findObject( (SimObjectId)(pWorkerData->mFirstId + index) ) != NULL )
+                    foundCount++;
+            }
+        }
+
+        pWorkerData->mFoundCount = foundCount;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static F32 run( WorkerData& templateData, const U32 threadCount, U32& foundCount )
+    {
+        WorkerData workerData[SIMLOOKUP_BENCHMARK_MAX_THREADS];
+        Thread* threads[SIMLOOKUP_BENCHMARK_MAX_THREADS];
+
+        const U32 startTime = Platform::getRealMilliseconds();
+
+        for( U32 threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+        {
+            workerData[threadIndex] = templateData;
+            threads[threadIndex] = new Thread( worker, &workerData[threadIndex] );
+        }
+
+        foundCount = 0;
+        for( U32 threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+        {
+            threads[threadIndex]->join();
+            delete threads[threadIndex];
+            foundCount += workerData[threadIndex].mFoundCount;
+        }
+
+        const U32 elapsedTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+        // Operations per millisecond across all threads.
+        return F32(threadCount * templateData.mIterations) / F32(elapsedTime);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runSimLookupBenchmarks, void, 1, 3,    "([objectCount], [iterations]) - Measures finding Sim objects by id and by name across thread counts.\n"
+                                                        "@param objectCount The number of objects to create, half of which are then deleted (default 200000).\n"
+                                                        "@param iterations The number of lookups each thread performs (default 1000000).\n"
+                                                        "@return No return value.")
+{
+    using namespace SimLookupBenchmarks;
+
+    const U32 objectCount = argc > 1 ? getMax( dAtoi(argv[1]), SIMLOOKUP_BENCHMARK_NAME_INTERVAL * 2 ) : 200000;
+    const U32 iterations = argc > 2 ? getMax( dAtoi(argv[2]), 1 ) : 1000000;
+
+    // Create the objects, naming some of them, then delete every other one
+    // so that half of the lookups miss.
+    const U32 nameCount = objectCount / SIMLOOKUP_BENCHMARK_NAME_INTERVAL;
+    char* pNames = new char[nameCount * SIMLOOKUP_BENCHMARK_NAME_LENGTH];
+    Vector<SimObject*> objects;
+    objects.setSize( objectCount );
+    for( U32 index = 0; index < objectCount; ++index )
+    {
+        SimObject* pObject = new SimObject();
+        if ( index % SIMLOOKUP_BENCHMARK_NAME_INTERVAL == 0 )
+        {
+            char* pName = pNames + (index / SIMLOOKUP_BENCHMARK_NAME_INTERVAL) * SIMLOOKUP_BENCHMARK_NAME_LENGTH;
+            dSprintf( pName, SIMLOOKUP_BENCHMARK_NAME_LENGTH, "simLookupBench_%d", index );
+            pObject->registerObject( pName );
+        }
+        else
+        {
+            pObject->registerObject();
+        }
+        objects[index] = pObject;
+    }
+
+    const U32 firstId = objects.first()->getId();
+    const U32 idCount = objects.last()->getId() - firstId + 1;
+    for( U32 index = 1; index < objectCount; index += 2 )
+    {
+        objects[index]->deleteObject();
+        objects[index] = NULL;
+    }
+
+    WorkerData templateData;
+    templateData.mIterations = iterations;
+    templateData.mFirstId = firstId;
+    templateData.mIdCount = idCount;
+    templateData.mNameCount = nameCount;
+    templateData.mNames = pNames;
+    templateData.mFoundCount = 0;
+
+    Con::printSeparator();
+    Con::printf( "Sim lookup benchmarks (%d live objects, %d lookups per thread, operations per millisecond):", objectCount - objectCount / 2, iterations );
+    Con::printf( "Threads   Id            Name" );
+
+    bool valid = true;
+    for( U32 threadCount = 1; threadCount <= SIMLOOKUP_BENCHMARK_MAX_THREADS; threadCount *= 2 )
+    {
+        U32 idFoundCount;
+        U32 nameFoundCount;
+
+        templateData.mByName = false;
+        const F32 byId = run( templateData, threadCount, idFoundCount );
+        templateData.mByName = true;
+        const F32 byName = run( templateData, threadCount, nameFoundCount );
+
+        // Only the even objects, which include every named object, remain.
+        if ( threadCount == 1 && (idFoundCount == 0 || idFoundCount == iterations || nameFoundCount != iterations) )
+            valid = false;
+
+        Con::printf( "%-9d %-13.0f %-13.0f", threadCount, byId, byName );
+    }
+
+    if ( !valid )
+        Con::errorf( "Sim lookup benchmarks - Unexpected lookup results." );
+
+    for( U32 index = 0; index < objectCount; index += 2 )
+        objects[index]->deleteObject();
+    delete [] pNames;
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
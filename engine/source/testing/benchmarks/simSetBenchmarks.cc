@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BENCHMARKING_H_
+#include "testing/benchmarks/benchmarking.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace SimSetBenchmarks
+{
+    using Benchmarking::getRate;
+
+    /// The order the objects are deleted in.
+    enum DeleteOrder
+    {
+        DeleteFromBack,
+        DeleteFromFront,
+        DeleteRandomly
+    };
+
+    /// Ordered lists close the gap left by a removal so deleting anywhere but
+    /// the back costs time proportional to the list size.  Those passes use
+    /// fewer objects so that they finish in reasonable time.
+    static const U32 MaxOrderedGapObjects = 10000;
+
+    //-----------------------------------------------------------------------------
+
+    static inline U32 nextRandom( U32& seed )
+    {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static bool runPass( const U32 objectCount, const bool ordered, const DeleteOrder deleteOrder )
+    {
+        // Each object is in a group and in a set, as it would be in a scene.
+        SimGroup* pGroup = new SimGroup();
+        pGroup->registerObject();
+        pGroup->setOrdered( ordered );
+
+        SimSet* pSet = new SimSet();
+        pSet->registerObject();
+        pSet->setOrdered( ordered );
+
+        Vector<SimObject*> objects;
+        objects.setSize( objectCount );
+
+        static const char* deleteOrderNames[] = { "from the back", "from the front", "randomly" };
+        Con::printf( "%s, deleting %s (%d objects):", ordered ? "Ordered" : "Unordered", deleteOrderNames[deleteOrder], objectCount );
+
+        // Create the objects.
+        U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 index = 0; index < objectCount; ++index )
+        {
+            SimObject* pObject = new SimObject();
+            pObject->registerObject();
+            pGroup->addObject( pObject );
+            pSet->addObject( pObject );
+            objects[index] = pObject;
+        }
+        Con::printf( "  Create          %-13.0f", getRate( objectCount, Platform::getRealMilliseconds() - startTime ) );
+
+        // Test membership.
+        U32 memberCount = 0;
+        startTime = Platform::getRealMilliseconds();
+        for ( U32 index = 0; index < objectCount; ++index )
+        {
+            if ( pGroup->contains( objects[index] ) && pSet->contains( objects[index] ) )
+                memberCount++;
+        }
+        Con::printf( "  Contains        %-13.0f", getRate( objectCount, Platform::getRealMilliseconds() - startTime ) );
+
+        // Arrange the objects in the order they are deleted.
+        Vector<SimObject*> deleteObjects;
+        deleteObjects.setSize( objectCount );
+        U32 seed = 1;
+        for ( U32 index = 0; index < objectCount; ++index )
+        {
+            if ( deleteOrder == DeleteFromBack )
+            {
+                deleteObjects[index] = objects[objectCount - 1 - index];
+            }
+            else if ( deleteOrder == DeleteFromFront )
+            {
+                deleteObjects[index] = objects[index];
+            }
+            else
+            {
+                // Shuffle as the objects are copied.
+                const U32 swapIndex = nextRandom( seed ) % ( index + 1 );
+                deleteObjects[index] = deleteObjects[swapIndex];
+                deleteObjects[swapIndex] = objects[index];
+            }
+        }
+
+        // Delete the objects.
+        startTime = Platform::getRealMilliseconds();
+        for ( U32 index = 0; index < objectCount; ++index )
+            deleteObjects[index]->deleteObject();
+        Con::printf( "  Delete          %-13.0f", getRate( objectCount, Platform::getRealMilliseconds() - startTime ) );
+
+        const bool valid = memberCount == objectCount && pGroup->size() == 0 && pSet->size() == 0;
+
+        pSet->deleteObject();
+        pGroup->deleteObject();
+
+        return valid;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runSimSetBenchmarks, void, 1, 2, "([objectCount]) - Measures creating objects in a group and a set, testing their membership and deleting them from the back, the front and at random.\n"
+                                                  "@param objectCount The number of objects used for each test (default 100000).\n"
+                                                  "@return No return value.")
+{
+    using namespace SimSetBenchmarks;
+
+    const U32 objectCount = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 100000;
+
+    Con::printSeparator();
+    Con::printf( "SimSet benchmarks (%d objects, operations per millisecond):", objectCount );
+
+    const U32 orderedGapCount = getMin( objectCount, MaxOrderedGapObjects );
+
+    bool valid = runPass( objectCount, true, DeleteFromBack );
+    valid &= runPass( orderedGapCount, true, DeleteFromFront );
+    valid &= runPass( orderedGapCount, true, DeleteRandomly );
+    valid &= runPass( objectCount, false, DeleteFromBack );
+    valid &= runPass( objectCount, false, DeleteFromFront );
+    valid &= runPass( objectCount, false, DeleteRandomly );
+
+    if ( !valid )
+        Con::errorf( "SimSet benchmarks - Objects were not removed from their group and set." );
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define STRINGTABLE_BENCHMARK_MAX_THREADS       8
+#define STRINGTABLE_BENCHMARK_STRING_COUNT      4096
+#define STRINGTABLE_BENCHMARK_STRING_LENGTH     32
+
+//-----------------------------------------------------------------------------
+
+namespace StringTableBenchmarks
+{
+    enum Mode
+    {
+        /// Insert strings that are already in the table from private buffers.
+        ExistingStrings,
+
+        /// Insert strings private to each thread.  The first pass over them adds
+        /// them to the table.
+        PrivateStrings,
+
+        /// Every thread inserts the same literal.
+        SameLiteral,
+    };
+
+    struct WorkerData
+    {
+        Mode mMode;
+        U32 mIterations;
+        char* mStrings;
+    };
+
+    static U32 sRunIndex = 0;
+
+    //-----------------------------------------------------------------------------
+
+    static void worker( void* pData )
+    {
+        WorkerData* pWorkerData = (WorkerData*)pData;
+
+        for( U32 iteration = 0; iteration < pWorkerData->mIterations; ++iteration )
+        {
+            switch( pWorkerData->mMode )
+            {
+            case SameLiteral:
+                StringTable->insert( "onSceneCollision" );
+                break;
+
+            default:
+                StringTable->insert( pWorkerData->mStrings + (iteration % STRINGTABLE_BENCHMARK_STRING_COUNT) * STRINGTABLE_BENCHMARK_STRING_LENGTH );
+                break;
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static F32 run( const Mode mode, const U32 threadCount, const U32 iterations )
+    {
+        WorkerData workerData[STRINGTABLE_BENCHMARK_MAX_THREADS];
+        Thread* threads[STRINGTABLE_BENCHMARK_MAX_THREADS];
+
+        // Build the strings up front so formatting is not measured.
+        const U32 runIndex = sRunIndex++;
+        for( U32 threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+        {
+            WorkerData& data = workerData[threadIndex];
+            data.mMode = mode;
+            data.mIterations = iterations;
+            data.mStrings = new char[STRINGTABLE_BENCHMARK_STRING_COUNT * STRINGTABLE_BENCHMARK_STRING_LENGTH];
+
+            for( U32 index = 0; index < STRINGTABLE_BENCHMARK_STRING_COUNT; ++index )
+            {
+                char* pString = data.mStrings + index * STRINGTABLE_BENCHMARK_STRING_LENGTH;
+
+                if ( mode == PrivateStrings )
+                    dSprintf( pString, STRINGTABLE_BENCHMARK_STRING_LENGTH, "stBenchPrivate_%d_%d_%d", runIndex, threadIndex, index );
+                else
+                    dSprintf( pString, STRINGTABLE_BENCHMARK_STRING_LENGTH, "stBenchExisting_%d", index );
+
+                if ( mode == ExistingStrings )
+                    StringTable->insert( pString );
+            }
+        }
+
+        const U32 startTime = Platform::getRealMilliseconds();
+
+        for( U32 threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+            threads[threadIndex] = new Thread( worker, &workerData[threadIndex] );
+
+        for( U32 threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+        {
+            threads[threadIndex]->join();
+            delete threads[threadIndex];
+        }
+
+        const U32 elapsedTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+        for( U32 threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+            delete [] workerData[threadIndex].mStrings;
+
+        // Operations per millisecond across all threads.
+        return F32(threadCount * iterations) / F32(elapsedTime);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runStringTableBenchmarks, void, 1, 2,  "([iterations]) - Measures StringTable insert throughput across thread counts.\n"
+                                                        "@param iterations The number of inserts each thread performs (default 1000000).\n"
+                                                        "@return No return value.")
+{
+    const U32 iterations = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 1000000;
+
+    Con::printSeparator();
+    Con::printf( "StringTable benchmarks (%d inserts per thread, operations per millisecond):", iterations );
+    Con::printf( "Threads   Existing      Private       SameLiteral" );
+
+    for( U32 threadCount = 1; threadCount <= STRINGTABLE_BENCHMARK_MAX_THREADS; threadCount *= 2 )
+    {
+        const F32 existing = StringTableBenchmarks::run( StringTableBenchmarks::ExistingStrings, threadCount, iterations );
+        const F32 isolated = StringTableBenchmarks::run( StringTableBenchmarks::PrivateStrings, threadCount, iterations );
+        const F32 literal = StringTableBenchmarks::run( StringTableBenchmarks::SameLiteral, threadCount, iterations );
+
+        Con::printf( "%-9d %-13.0f %-13.0f %-13.0f", threadCount, existing, isolated, literal );
+    }
+
+    Con::printf( "StringTable now holds %d strings.", StringTable->getItemCount() );
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
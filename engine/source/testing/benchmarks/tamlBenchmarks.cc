@@ -0,0 +1,424 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _TAML_XML_PULL_PARSER_H_
+#include "persistence/taml/tamlXmlPullParser.h"
+#endif
+
+#ifndef TINYXML_INCLUDED
+#include "persistence/tinyXML/tinyxml.h"
+#endif
+
+#ifndef _TAML_H_
+#include "persistence/taml/taml.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BENCHMARKING_H_
+#include "testing/benchmarks/benchmarking.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TAML_BENCHMARK_XML_FILE     "_benchmarkTamlXml_RemoveMe.taml"
+#define TAML_BENCHMARK_LOAD_FILE    "_benchmarkTamlLoad_RemoveMe"
+#define TAML_BENCHMARK_FIELD_COUNT  6
+
+//-----------------------------------------------------------------------------
+
+namespace TamlBenchmarks
+{
+    static U32 sgChecksum = 0;
+
+    using Benchmarking::getRate;
+
+    /// Writes a document shaped like a saved scene: objects with a handful of fields and a nested custom node.
+    static bool writeXmlDocument( const char* pFilePath, const U32 objectCount )
+    {
+        FileStream stream;
+        if ( !stream.open( pFilePath, FileStream::Write ) )
+            return false;
+
+        char buffer[512];
+        stream.writeStringBuffer( "<Scene Gravity=\"0 -9.8\" UpdateCallback=\"0\">\n" );
+        for ( U32 index = 0; index < objectCount; ++index )
+        {
+            dSprintf( buffer, sizeof(buffer),
+                "    <Sprite Name=\"Object%d\" SceneLayer=\"%d\" Position=\"%d.5 %d.25\" Size=\"2 2\" Angle=\"%d\" Image=\"@asset=BenchmarkModule:Image%d\" Frame=\"%d\" BodyType=\"Dynamic\">\n"
+                "        <Sprite.CollisionShapes>\n"
+                "            <Circle Radius=\"1\" Offset=\"0 0\" Density=\"1\" Friction=\"0.2\" />\n"
+                "        </Sprite.CollisionShapes>\n"
+                "    </Sprite>\n",
+                index, index % 32, index, index * 2, index % 360, index % 16, index % 4 );
+            stream.writeStringBuffer( buffer );
+        }
+        stream.writeStringBuffer( "</Scene>\n" );
+        stream.close();
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static U32 getAllocationCount( void )
+    {
+        U32 allocations = 0;
+        for ( U32 tag = 0; tag < MemoryAllocator::TagCount; ++tag )
+            allocations += MemoryAllocator::getStats( (MemoryAllocator::Tag)tag ).mAllocations;
+        return allocations;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    /// Reads every token and attribute with the pull parser, as TamlXmlParser does.
+    static bool parsePull( const char* pFilePath )
+    {
+        FileStream stream;
+        if ( !stream.open( pFilePath, FileStream::Read ) )
+            return false;
+
+        TamlXmlPullParser xmlParser;
+        if ( !xmlParser.load( stream ) )
+            return false;
+        stream.close();
+
+        for ( ;; )
+        {
+            const TamlXmlPullParser::TokenType tokenType = xmlParser.next();
+            if ( tokenType == TamlXmlPullParser::EndDocumentToken )
+                return true;
+            if ( tokenType == TamlXmlPullParser::ErrorToken )
+                return false;
+            if ( tokenType != TamlXmlPullParser::StartElementToken )
+                continue;
+
+            for ( U32 index = 0; index < xmlParser.getAttributeCount(); ++index )
+                sgChecksum += (U8)xmlParser.getAttribute( index ).mpValue[0];
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static void walkElement( const TiXmlElement* pXmlElement )
+    {
+        for ( const TiXmlAttribute* pXmlAttribute = pXmlElement->FirstAttribute(); pXmlAttribute; pXmlAttribute = pXmlAttribute->Next() )
+            sgChecksum += (U8)pXmlAttribute->Value()[0];
+
+        for ( const TiXmlElement* pChildXmlElement = pXmlElement->FirstChildElement(); pChildXmlElement; pChildXmlElement = pChildXmlElement->NextSiblingElement() )
+            walkElement( pChildXmlElement );
+    }
+
+    /// Loads the whole document then reads every attribute, as the document parser does.
+    static bool parseDocument( const char* pFilePath )
+    {
+        FileStream stream;
+        if ( !stream.open( pFilePath, FileStream::Read ) )
+            return false;
+
+        TiXmlDocument xmlDocument;
+        if ( !xmlDocument.LoadFile( stream ) )
+            return false;
+        stream.close();
+
+        walkElement( xmlDocument.RootElement() );
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    /// Times repeated parses, then measures the allocations and the peak memory of a single parse.
+    static U32 runParse( bool (*parse)( const char* ), const char* pFilePath, const U32 passCount, U32& allocations, U32& peakBytes )
+    {
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 pass = 0; pass < passCount; ++pass )
+            parse( pFilePath );
+        const U32 elapsedTime = Platform::getRealMilliseconds() - startTime;
+
+        // Parse with a known tag so its peak is not mixed up with the allocations of other tags.
+        MemoryTagScope tagScope( MemoryAllocator::GeneralTag );
+        const U32 startAllocations = getAllocationCount();
+        const U32 startBytes = MemoryAllocator::getStats( MemoryAllocator::GeneralTag ).mLiveBytes;
+        MemoryAllocator::resetPeak( MemoryAllocator::GeneralTag );
+        parse( pFilePath );
+        peakBytes = MemoryAllocator::getStats( MemoryAllocator::GeneralTag ).mPeakBytes - startBytes;
+        allocations = getAllocationCount() - startAllocations;
+
+        return elapsedTime;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static const char* sgFieldNames[TAML_BENCHMARK_FIELD_COUNT] = { "Position", "Size", "Angle", "Image", "Frame", "BodyType" };
+
+    /// The value of a field of an object in the load document.  Only a few values repeat, as in a saved scene.
+    static void formatFieldValue( char* pBuffer, const U32 bufferSize, const U32 objectIndex, const U32 fieldIndex )
+    {
+        switch( fieldIndex )
+        {
+            case 0: dSprintf( pBuffer, bufferSize, "%d.5 %d.25", objectIndex, objectIndex * 2 ); break;
+            case 1: dSprintf( pBuffer, bufferSize, "2 2" ); break;
+            case 2: dSprintf( pBuffer, bufferSize, "%d", objectIndex % 360 ); break;
+            case 3: dSprintf( pBuffer, bufferSize, "@asset=BenchmarkModule:Image%d", objectIndex % 16 ); break;
+            case 4: dSprintf( pBuffer, bufferSize, "%d", objectIndex % 4 ); break;
+            default: dSprintf( pBuffer, bufferSize, "Dynamic" ); break;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+
+    static SimSet* createLoadObjects( const U32 objectCount )
+    {
+        SimSet* pRoot = new SimSet();
+        pRoot->registerObject();
+
+        char valueBuffer[256];
+        for ( U32 objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+        {
+            SimObject* pObject = new SimObject();
+            pObject->registerObject();
+
+            for ( U32 fieldIndex = 0; fieldIndex < TAML_BENCHMARK_FIELD_COUNT; ++fieldIndex )
+            {
+                formatFieldValue( valueBuffer, sizeof(valueBuffer), objectIndex, fieldIndex );
+                pObject->setDataField( StringTable->insert( sgFieldNames[fieldIndex] ), NULL, valueBuffer );
+            }
+
+            pRoot->addObject( pObject );
+        }
+
+        return pRoot;
+    }
+
+    static void deleteLoadObjects( SimObject* pRootObject )
+    {
+        SimSet* pRoot = dynamic_cast<SimSet*>( pRootObject );
+        if ( pRoot != NULL )
+        {
+            while ( pRoot->size() > 0 )
+                pRoot->at( pRoot->size() - 1 )->deleteObject();
+        }
+
+        if ( pRootObject != NULL )
+            pRootObject->deleteObject();
+    }
+
+    //-----------------------------------------------------------------------------
+
+    /// Writes the load document in the version 2 stream format, which the writer no longer produces.
+    static bool writeStreamDocument( const char* pFilePath, const U32 objectCount )
+    {
+        FileStream stream;
+        if ( !stream.open( pFilePath, FileStream::Write ) )
+            return false;
+
+        stream.writeString( TAML_SIGNATURE );
+        stream.write( (U32)2 );
+        stream.write( false );
+
+        // The root set: type, name, reference Ids, fields and children.
+        stream.writeString( "SimSet" );
+        stream.writeString( "" );
+        stream.write( (U32)0 );
+        stream.write( (U32)0 );
+        stream.write( (U32)0 );
+        stream.write( objectCount );
+
+        char valueBuffer[256];
+        for ( U32 objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+        {
+            stream.writeString( "SimObject" );
+            stream.writeString( "" );
+            stream.write( (U32)0 );
+            stream.write( (U32)0 );
+            stream.write( (U32)TAML_BENCHMARK_FIELD_COUNT );
+            for ( U32 fieldIndex = 0; fieldIndex < TAML_BENCHMARK_FIELD_COUNT; ++fieldIndex )
+            {
+                formatFieldValue( valueBuffer, sizeof(valueBuffer), objectIndex, fieldIndex );
+                stream.writeString( sgFieldNames[fieldIndex] );
+                stream.writeLongString( 4096, valueBuffer );
+            }
+
+            // No children or custom nodes.
+            stream.write( (U32)0 );
+            stream.write( (U32)0 );
+        }
+
+        // No custom nodes on the root.
+        stream.write( (U32)0 );
+        stream.close();
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    /// Times repeated reads.  The objects read are deleted once timing has stopped.
+    static U32 runLoad( const char* pFilePath, const U32 passCount, bool& succeeded )
+    {
+        Taml taml;
+        Vector<SimObject*> roots;
+        roots.reserve( passCount );
+
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 pass = 0; pass < passCount; ++pass )
+            roots.push_back( taml.read( pFilePath ) );
+        const U32 elapsedTime = Platform::getRealMilliseconds() - startTime;
+
+        succeeded = true;
+        for ( U32 pass = 0; pass < passCount; ++pass )
+        {
+            succeeded &= roots[pass] != NULL;
+            deleteLoadObjects( roots[pass] );
+        }
+
+        return elapsedTime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runTamlXmlBenchmarks, void, 1, 2, "([objectCount]) - Measures parsing a TAML XML document with the pull parser and with the TinyXML document.\n"
+                                                   "@param objectCount The number of objects in the document (default 1000).\n"
+                                                   "@return No return value.")
+{
+    using namespace TamlBenchmarks;
+
+    const U32 objectCount = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 1000;
+    const U32 passCount = getMax( 200000 / objectCount, (U32)1 );
+
+    char filePathBuffer[1024];
+    Con::expandPath( filePathBuffer, sizeof(filePathBuffer), TAML_BENCHMARK_XML_FILE );
+    if ( !writeXmlDocument( filePathBuffer, objectCount ) )
+    {
+        Con::warnf( "runTamlXmlBenchmarks() - Could not write the document '%s'.", filePathBuffer );
+        return;
+    }
+
+    Con::printSeparator();
+    Con::printf( "TAML XML benchmarks (%d objects, %d bytes, parses per second, allocations and peak KB per parse):", objectCount, Platform::getFileSize( filePathBuffer ) );
+
+    U32 pullAllocations, pullPeakBytes;
+    U32 documentAllocations, documentPeakBytes;
+    const U32 pullTime = runParse( parsePull, filePathBuffer, passCount, pullAllocations, pullPeakBytes );
+    const U32 documentTime = runParse( parseDocument, filePathBuffer, passCount, documentAllocations, documentPeakBytes );
+
+    Con::printf( "                %-13s%-13s%-13s", "Parses", "Allocs", "Peak KB" );
+    Con::printf( "  Pull Parser   %-13.1f%-13u%-13.1f", getRate( passCount, pullTime ) * 1000.0f, pullAllocations, F32(pullPeakBytes) / 1024.0f );
+    Con::printf( "  TinyXML       %-13.1f%-13u%-13.1f", getRate( passCount, documentTime ) * 1000.0f, documentAllocations, F32(documentPeakBytes) / 1024.0f );
+    Con::printf( "  (checksum %u)", sgChecksum );
+
+    Platform::fileDelete( filePathBuffer );
+
+    Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runTamlLoadBenchmarks, void, 1, 2, "([objectCount]) - Measures reading the same objects from TAML XML, version 2 binary and version 3 binary files.\n"
+                                                    "@param objectCount The number of objects in the document (default 500).\n"
+                                                    "@return No return value.")
+{
+    using namespace TamlBenchmarks;
+
+    const U32 objectCount = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 500;
+    const U32 passCount = getMax( 20000 / objectCount, (U32)1 );
+
+    const char* pFormatNames[] = { "XML", "Binary v2", "Binary v3", "Binary v3 Zip" };
+    const char* pFormatExtensions[] = { "taml", "v2.baml", "v3.baml", "v3zip.baml" };
+    const U32 formatCount = sizeof(pFormatNames) / sizeof(const char*);
+
+    // Write the document in each format.
+    char filePathBuffer[4][1024];
+    bool written = true;
+    SimSet* pRoot = createLoadObjects( objectCount );
+    for ( U32 formatIndex = 0; formatIndex < formatCount; ++formatIndex )
+    {
+        char fileBuffer[256];
+        dSprintf( fileBuffer, sizeof(fileBuffer), "%s.%s", TAML_BENCHMARK_LOAD_FILE, pFormatExtensions[formatIndex] );
+        Con::expandPath( filePathBuffer[formatIndex], sizeof(filePathBuffer[formatIndex]), fileBuffer );
+
+        if ( formatIndex == 1 )
+        {
+            written &= writeStreamDocument( filePathBuffer[formatIndex], objectCount );
+            continue;
+        }
+
+        Taml taml;
+        taml.setAutoFormat( false );
+        taml.setFormatMode( formatIndex == 0 ? Taml::XmlFormat : Taml::BinaryFormat );
+        taml.setBinaryCompression( formatIndex == 3 );
+        written &= taml.write( pRoot, filePathBuffer[formatIndex] );
+    }
+    deleteLoadObjects( pRoot );
+
+    if ( written )
+    {
+        Con::printSeparator();
+        Con::printf( "TAML load benchmarks (%d objects, loads per second and file KB):", objectCount );
+        Con::printf( "                  %-13s%-13s", "Loads", "File KB" );
+
+        for ( U32 formatIndex = 0; formatIndex < formatCount; ++formatIndex )
+        {
+            bool succeeded;
+            const U32 loadTime = runLoad( filePathBuffer[formatIndex], passCount, succeeded );
+            if ( !succeeded )
+                Con::warnf( "runTamlLoadBenchmarks() - Could not read the document '%s'.", filePathBuffer[formatIndex] );
+
+            Con::printf( "  %-16s%-13.1f%-13.1f", pFormatNames[formatIndex], getRate( passCount, loadTime ) * 1000.0f, F32(Platform::getFileSize( filePathBuffer[formatIndex] )) / 1024.0f );
+        }
+
+        Con::printSeparator();
+    }
+    else
+    {
+        Con::warnf( "runTamlLoadBenchmarks() - Could not write the documents." );
+    }
+
+    for ( U32 formatIndex = 0; formatIndex < formatCount; ++formatIndex )
+        Platform::fileDelete( filePathBuffer[formatIndex] );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,158 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want benchmarks in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _SMALL_VECTOR_H_
+#include "collection/smallVector.h"
+#endif
+
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BENCHMARKING_H_
+#include "testing/benchmarks/benchmarking.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace VectorBenchmarks
+{
+    static U32 sgChecksum = 0;
+
+    using Benchmarking::getRate;
+
+    static U32 getAllocationCount( void )
+    {
+        U32 allocations = 0;
+        for ( U32 tag = 0; tag < MemoryAllocator::TagCount; ++tag )
+            allocations += MemoryAllocator::getStats( (MemoryAllocator::Tag)tag ).mAllocations;
+        return allocations;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    /// Fills a temporary list and walks it, as a query helper would.
+    template<class VectorType>
+    static U32 runTemporaryList( const U32 elementCount, const U32 passCount, U32& allocations )
+    {
+        const U32 startAllocations = getAllocationCount();
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 pass = 0; pass < passCount; ++pass )
+        {
+            VectorType list;
+            for ( U32 index = 0; index < elementCount; ++index )
+                list.push_back( pass + index );
+
+            for ( U32 index = 0; index < (U32)list.size(); ++index )
+                sgChecksum += list[index];
+        }
+        const U32 elapsedTime = Platform::getRealMilliseconds() - startTime;
+        allocations = getAllocationCount() - startAllocations;
+        return elapsedTime;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    /// Builds a list then hands it to its owner by copying or by swapping.
+    static U32 runHandOff( const U32 elementCount, const U32 passCount, const bool swap, U32& allocations )
+    {
+        Vector<U32> owner;
+
+        const U32 startAllocations = getAllocationCount();
+        const U32 startTime = Platform::getRealMilliseconds();
+        for ( U32 pass = 0; pass < passCount; ++pass )
+        {
+            Vector<U32> list;
+            for ( U32 index = 0; index < elementCount; ++index )
+                list.push_back( pass + index );
+
+            if ( swap )
+                owner.swap( list );
+            else
+                owner = list;
+
+            sgChecksum += owner[0];
+        }
+        const U32 elapsedTime = Platform::getRealMilliseconds() - startTime;
+        allocations = getAllocationCount() - startAllocations;
+        return elapsedTime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( runVectorBenchmarks, void, 1, 2, "([elementCount]) - Measures short lived lists built with Vector and SmallVector, and handing a list over by copy and by swap.\n"
+                                                  "@param elementCount The number of elements in each list (default 8).\n"
+                                                  "@return No return value.")
+{
+    using namespace VectorBenchmarks;
+
+    const U32 elementCount = argc > 1 ? getMax( dAtoi(argv[1]), 1 ) : 8;
+    const U32 passCount = getMax( 4000000 / elementCount, (U32)1 );
+
+    Con::printSeparator();
+    Con::printf( "Vector benchmarks (%d elements, lists per millisecond and allocations per 1000 lists):", elementCount );
+
+    U32 vectorAllocations, smallAllocations;
+    const U32 vectorTime = runTemporaryList< Vector<U32> >( elementCount, passCount, vectorAllocations );
+    const U32 smallTime = runTemporaryList< SmallVector<U32, 16> >( elementCount, passCount, smallAllocations );
+
+    Con::printf( "                  %-13s%-13s%-13s%-13s", "Vector", "Allocs", "SmallVector", "Allocs" );
+    Con::printf( "  Temporary List  %-13.0f%-13.1f%-13.0f%-13.1f",
+        getRate( passCount, vectorTime ), F32(vectorAllocations) * 1000.0f / F32(passCount),
+        getRate( passCount, smallTime ), F32(smallAllocations) * 1000.0f / F32(passCount) );
+
+    U32 copyAllocations, swapAllocations;
+    const U32 copyTime = runHandOff( elementCount, passCount, false, copyAllocations );
+    const U32 swapTime = runHandOff( elementCount, passCount, true, swapAllocations );
+
+    Con::printf( "                  %-13s%-13s%-13s%-13s", "Copy", "Allocs", "Swap", "Allocs" );
+    Con::printf( "  Hand Off        %-13.0f%-13.1f%-13.0f%-13.1f",
+        getRate( passCount, copyTime ), F32(copyAllocations) * 1000.0f / F32(passCount),
+        getRate( passCount, swapTime ), F32(swapAllocations) * 1000.0f / F32(passCount) );
+
+    Con::printf( "  (checksum %u)", sgChecksum );
+
+    Con::printSeparator();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,109 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _ASSET_INDEX_H_
+#include "assets/assetIndex.h"
+#endif
+
+#ifndef _TAML_ASSET_DECLARED_VISITOR_H_
+#include "assets/tamlAssetDeclaredVisitor.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define ASSET_INDEX_UNITTEST_ASSET_FILE     "_unitTestAssetIndex_RemoveMe.asset.taml"
+#define ASSET_INDEX_UNITTEST_INDEX_FILE     "_unitTestAssetIndex_RemoveMe.index"
+#define ASSET_INDEX_UNITTEST_ASSET          "<ImageAsset AssetName=\"IndexTest\" AssetCategory=\"test\" ImageFile=\"@assetFile=#indexTest.png\" Parent=\"@asset=IndexTestModule:parent\" />"
+
+//-----------------------------------------------------------------------------
+
+TEST( AssetIndexTests, StoreRestore )
+{
+    // Write the asset file.
+    char assetFileBuffer[1024];
+    char indexFileBuffer[1024];
+    Con::expandPath( assetFileBuffer, sizeof(assetFileBuffer), ASSET_INDEX_UNITTEST_ASSET_FILE );
+    Con::expandPath( indexFileBuffer, sizeof(indexFileBuffer), ASSET_INDEX_UNITTEST_INDEX_FILE );
+
+    FileStream assetStream;
+    ASSERT_TRUE( assetStream.open( assetFileBuffer, FileStream::Write ) ) << "Failed to open the asset file for write.";
+    assetStream.writeStringBuffer( ASSET_INDEX_UNITTEST_ASSET );
+    assetStream.close();
+
+    const U32 fileSize = (U32)Platform::getFileSize( assetFileBuffer );
+
+    // Parse and index the asset file.
+    TamlAssetDeclaredVisitor parsedVisitor;
+    ASSERT_TRUE( parsedVisitor.parse( assetFileBuffer ) ) << "Failed to parse the asset file.";
+
+    AssetIndex assetIndex;
+    ASSERT_FALSE( assetIndex.restore( assetFileBuffer, fileSize, parsedVisitor ) ) << "Restored an asset file that was never indexed.";
+    assetIndex.store( assetFileBuffer, fileSize, parsedVisitor );
+    ASSERT_TRUE( assetIndex.save( indexFileBuffer ) ) << "Failed to save the asset index.";
+
+    // Restore the asset file from a loaded index.
+    AssetIndex loadedIndex;
+    ASSERT_TRUE( loadedIndex.load( indexFileBuffer ) ) << "Failed to load the asset index.";
+    ASSERT_EQ( (U32)1, loadedIndex.getEntryCount() ) << "Unexpected asset index entry count.";
+
+    TamlAssetDeclaredVisitor restoredVisitor;
+    ASSERT_TRUE( loadedIndex.restore( assetFileBuffer, fileSize, restoredVisitor ) ) << "Failed to restore the unchanged asset file.";
+
+    const AssetDefinition& parsedDefinition = parsedVisitor.getAssetDefinition();
+    const AssetDefinition& restoredDefinition = restoredVisitor.getAssetDefinition();
+    ASSERT_EQ( parsedDefinition.mAssetName, restoredDefinition.mAssetName ) << "Asset name was not restored.";
+    ASSERT_EQ( parsedDefinition.mAssetType, restoredDefinition.mAssetType ) << "Asset type was not restored.";
+    ASSERT_EQ( parsedDefinition.mAssetCategory, restoredDefinition.mAssetCategory ) << "Asset category was not restored.";
+    ASSERT_EQ( parsedDefinition.mAssetBaseFilePath, restoredDefinition.mAssetBaseFilePath ) << "Asset file path was not restored.";
+    ASSERT_EQ( parsedVisitor.getAssetDependencies().size(), restoredVisitor.getAssetDependencies().size() ) << "Asset dependencies were not restored.";
+    ASSERT_EQ( parsedVisitor.getAssetLooseFiles().size(), restoredVisitor.getAssetLooseFiles().size() ) << "Asset loose files were not restored.";
+    ASSERT_EQ( 1, restoredVisitor.getAssetDependencies().size() ) << "Unexpected asset dependency count.";
+    ASSERT_EQ( parsedVisitor.getAssetDependencies()[0], restoredVisitor.getAssetDependencies()[0] ) << "Unexpected asset dependency.";
+
+    // A changed asset file is not restored.
+    TamlAssetDeclaredVisitor changedVisitor;
+    ASSERT_FALSE( loadedIndex.restore( assetFileBuffer, fileSize + 1, changedVisitor ) ) << "Restored an asset file whose size changed.";
+
+    // Entries not used when saving are dropped.
+    AssetIndex unusedIndex;
+    ASSERT_TRUE( unusedIndex.load( indexFileBuffer ) ) << "Failed to load the asset index.";
+    ASSERT_TRUE( unusedIndex.save( indexFileBuffer ) ) << "Failed to save the asset index.";
+    ASSERT_TRUE( unusedIndex.load( indexFileBuffer ) ) << "Failed to load the asset index.";
+    ASSERT_EQ( (U32)0, unusedIndex.getEntryCount() ) << "An unused asset index entry was kept.";
+
+    Platform::fileDelete( assetFileBuffer );
+    Platform::fileDelete( indexFileBuffer );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,194 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+#ifndef _ASSET_MANAGER_H_
+#include "assets/assetManager.h"
+#endif
+
+#ifndef _MODULE_DEFINITION_H
+#include "module/moduleDefinition.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define ASSET_MANAGER_UNITTEST_MODULE       "AssetManagerTest"
+#define ASSET_MANAGER_UNITTEST_ASSET_SIZE   100
+
+//-----------------------------------------------------------------------------
+
+/// An asset that reports a fixed memory size so the idle asset budget can be tested without loading real resources.
+class IdleCacheTestAsset : public AssetBase
+{
+    typedef AssetBase Parent;
+
+    S32 mMemorySize;
+
+public:
+    IdleCacheTestAsset() : mMemorySize( 0 ) {}
+
+    static void initPersistFields()
+    {
+        Parent::initPersistFields();
+
+        addField( "MemorySize", TypeS32, Offset(mMemorySize, IdleCacheTestAsset), "The memory the asset reports it holds." );
+    }
+
+    virtual U32 getAssetMemorySize( void ) const { return (U32)mMemorySize; }
+
+    DECLARE_CONOBJECT( IdleCacheTestAsset );
+};
+
+IMPLEMENT_CONOBJECT( IdleCacheTestAsset );
+
+//-----------------------------------------------------------------------------
+
+namespace AssetManagerTests
+{
+    static const char* sAssetNames[] = { "IdleA", "IdleB", "IdleC" };
+    static const U32 sAssetCount = sizeof(sAssetNames) / sizeof(const char*);
+
+    static void formatAssetFile( char* pBuffer, const U32 bufferSize, const char* pAssetName )
+    {
+        char fileBuffer[256];
+        dSprintf( fileBuffer, sizeof(fileBuffer), "_unitTestAssetManager_%s_RemoveMe.asset.taml", pAssetName );
+        Con::expandPath( pBuffer, bufferSize, fileBuffer );
+    }
+
+    static StringTableEntry formatAssetId( const char* pAssetName )
+    {
+        char assetIdBuffer[256];
+        dSprintf( assetIdBuffer, sizeof(assetIdBuffer), "%s:%s", ASSET_MANAGER_UNITTEST_MODULE, pAssetName );
+        return StringTable->insert( assetIdBuffer );
+    }
+
+    static void acquireRelease( AssetManager* pAssetManager, const char* pAssetId )
+    {
+        ASSERT_TRUE( pAssetManager->acquireAsset<IdleCacheTestAsset>( pAssetId ) != NULL ) << "Failed to acquire the asset.";
+        ASSERT_TRUE( pAssetManager->releaseAsset( pAssetId ) ) << "Failed to release the asset.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( AssetManager, idleAssetEvictionTest )
+{
+    using namespace AssetManagerTests;
+
+    // Write the asset files.
+    char assetFileBuffer[sAssetCount][1024];
+    for ( U32 n = 0; n < sAssetCount; ++n )
+    {
+        formatAssetFile( assetFileBuffer[n], sizeof(assetFileBuffer[n]), sAssetNames[n] );
+
+        char assetBuffer[256];
+        dSprintf( assetBuffer, sizeof(assetBuffer), "<IdleCacheTestAsset AssetName=\"%s\" MemorySize=\"%d\" />", sAssetNames[n], ASSET_MANAGER_UNITTEST_ASSET_SIZE );
+
+        FileStream assetStream;
+        ASSERT_TRUE( assetStream.open( assetFileBuffer[n], FileStream::Write ) ) << "Failed to open the asset file for write.";
+        assetStream.writeStringBuffer( assetBuffer );
+        assetStream.close();
+    }
+
+    // The module is located where the asset files are.
+    char modulePathBuffer[1024];
+    dStrcpy( modulePathBuffer, assetFileBuffer[0] );
+    *dStrrchr( modulePathBuffer, '/' ) = 0;
+
+    ModuleDefinition* pModuleDefinition = new ModuleDefinition();
+    pModuleDefinition->setModuleId( ASSET_MANAGER_UNITTEST_MODULE );
+    pModuleDefinition->setModulePath( modulePathBuffer );
+    pModuleDefinition->registerObject();
+
+    AssetManager* pAssetManager = new AssetManager();
+    pAssetManager->registerObject();
+
+    // Declare the assets.
+    StringTableEntry assetIds[sAssetCount];
+    for ( U32 n = 0; n < sAssetCount; ++n )
+    {
+        ASSERT_TRUE( pAssetManager->addDeclaredAsset( pModuleDefinition, assetFileBuffer[n] ) ) << "Failed to declare the asset.";
+        assetIds[n] = formatAssetId( sAssetNames[n] );
+        ASSERT_TRUE( pAssetManager->isDeclaredAsset( assetIds[n] ) ) << "The asset was not declared.";
+    }
+
+    // Room for two idle assets.
+    pAssetManager->setIdleAssetBudget( ASSET_MANAGER_UNITTEST_ASSET_SIZE * 2 + ASSET_MANAGER_UNITTEST_ASSET_SIZE / 2 );
+    pAssetManager->resetAssetCacheStats();
+
+    // Released assets are kept idle until the budget is exceeded, then the least recently used is unloaded.
+    acquireRelease( pAssetManager, assetIds[0] );
+    acquireRelease( pAssetManager, assetIds[1] );
+    ASSERT_EQ( (U32)2, pAssetManager->getIdleAssetCount() ) << "Released assets were not kept idle.";
+    ASSERT_EQ( (U32)ASSET_MANAGER_UNITTEST_ASSET_SIZE * 2, pAssetManager->getIdleAssetMemory() ) << "Unexpected idle asset memory.";
+    acquireRelease( pAssetManager, assetIds[2] );
+    ASSERT_EQ( (U32)2, pAssetManager->getIdleAssetCount() ) << "The idle assets exceeded the budget.";
+    ASSERT_FALSE( pAssetManager->isAssetLoaded( assetIds[0] ) ) << "The least recently used asset was not evicted.";
+    ASSERT_TRUE( pAssetManager->isAssetLoaded( assetIds[1] ) ) << "An idle asset was evicted out of order.";
+    ASSERT_TRUE( pAssetManager->isAssetLoaded( assetIds[2] ) ) << "An idle asset was evicted out of order.";
+    ASSERT_EQ( (U32)0, pAssetManager->getAssetCacheHits() ) << "Unexpected cache hit count.";
+    ASSERT_EQ( (U32)3, pAssetManager->getAssetCacheMisses() ) << "Unexpected cache miss count.";
+    ASSERT_EQ( (U32)1, pAssetManager->getAssetCacheEvictions() ) << "Unexpected cache eviction count.";
+
+    // Acquiring an idle asset is a hit and makes it the most recently used.
+    acquireRelease( pAssetManager, assetIds[1] );
+    ASSERT_EQ( (U32)1, pAssetManager->getAssetCacheHits() ) << "Acquiring an idle asset was not a hit.";
+
+    // Acquiring an evicted asset is a miss and evicts the now least recently used.
+    acquireRelease( pAssetManager, assetIds[0] );
+    ASSERT_EQ( (U32)4, pAssetManager->getAssetCacheMisses() ) << "Acquiring an evicted asset was not a miss.";
+    ASSERT_EQ( (U32)2, pAssetManager->getAssetCacheEvictions() ) << "Unexpected cache eviction count.";
+    ASSERT_FALSE( pAssetManager->isAssetLoaded( assetIds[2] ) ) << "The least recently used asset was not evicted.";
+    ASSERT_TRUE( pAssetManager->isAssetLoaded( assetIds[1] ) ) << "The most recently used idle asset was evicted.";
+    ASSERT_TRUE( pAssetManager->isAssetLoaded( assetIds[0] ) ) << "The released asset was not kept idle.";
+
+    // A budget of zero unloads all idle assets.
+    pAssetManager->setIdleAssetBudget( 0 );
+    ASSERT_EQ( (U32)0, pAssetManager->getIdleAssetCount() ) << "Idle assets were kept without a budget.";
+    ASSERT_EQ( (U32)0, pAssetManager->getIdleAssetMemory() ) << "Idle asset memory was kept without a budget.";
+    ASSERT_EQ( (U32)4, pAssetManager->getAssetCacheEvictions() ) << "Unexpected cache eviction count.";
+
+    pAssetManager->removeDeclaredAssets( pModuleDefinition );
+    pAssetManager->deleteObject();
+    pModuleDefinition->deleteObject();
+
+    for ( U32 n = 0; n < sAssetCount; ++n )
+        Platform::fileDelete( assetFileBuffer[n] );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,146 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _FLAT_HASH_MAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define FLATHASHMAP_UNITTEST_KEYCOUNT     1000
+
+//-----------------------------------------------------------------------------
+
+TEST( FlatHashMapTests, insertAndFindTest )
+{
+    static char keys[FLATHASHMAP_UNITTEST_KEYCOUNT];
+    FlatHashMap<const char*, U32> map;
+
+    // Insert enough keys to grow the table several times.
+    for( U32 index = 0; index < FLATHASHMAP_UNITTEST_KEYCOUNT; ++index )
+        map.insert( keys + index, index );
+
+    // Check.
+    ASSERT_EQ( (U32)FLATHASHMAP_UNITTEST_KEYCOUNT, map.size() ) << "Wrong number of keys.";
+    for( U32 index = 0; index < FLATHASHMAP_UNITTEST_KEYCOUNT; ++index )
+    {
+        U32* pValue = map.find( keys + index );
+        ASSERT_NE( (U32*)NULL, pValue ) << "Key not found.";
+        ASSERT_EQ( index, *pValue ) << "Wrong value for key.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FlatHashMapTests, findOrInsertTest )
+{
+    static char keys[2];
+    FlatHashMap<const char*, U32> map;
+    bool inserted;
+
+    // Insert a new key.
+    map.findOrInsert( keys, &inserted ) = 1;
+    ASSERT_TRUE( inserted ) << "New key was not inserted.";
+
+    // Find the existing key.
+    U32& value = map.findOrInsert( keys, &inserted );
+    ASSERT_FALSE( inserted ) << "Existing key was inserted again.";
+    ASSERT_EQ( (U32)1, value ) << "Existing value was lost.";
+
+    // Check a missing key.
+    ASSERT_EQ( (U32*)NULL, map.find( keys + 1 ) ) << "Missing key was found.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FlatHashMapTests, eraseTest )
+{
+    static char keys[FLATHASHMAP_UNITTEST_KEYCOUNT];
+    FlatHashMap<const char*, U32> map;
+
+    for( U32 index = 0; index < FLATHASHMAP_UNITTEST_KEYCOUNT; ++index )
+        map.insert( keys + index, index );
+
+    // Erase every other key.
+    for( U32 index = 0; index < FLATHASHMAP_UNITTEST_KEYCOUNT; index += 2 )
+        ASSERT_TRUE( map.erase( keys + index ) ) << "Key was not erased.";
+
+    ASSERT_FALSE( map.erase( keys ) ) << "Erased key was erased again.";
+    ASSERT_EQ( (U32)FLATHASHMAP_UNITTEST_KEYCOUNT / 2, map.size() ) << "Wrong number of keys after erase.";
+
+    // Check the remaining keys are still reachable.
+    for( U32 index = 0; index < FLATHASHMAP_UNITTEST_KEYCOUNT; ++index )
+    {
+        U32* pValue = map.find( keys + index );
+        if ( index % 2 == 0 )
+        {
+            ASSERT_EQ( (U32*)NULL, pValue ) << "Erased key was found.";
+        }
+        else
+        {
+            ASSERT_NE( (U32*)NULL, pValue ) << "Key lost after erase.";
+            ASSERT_EQ( index, *pValue ) << "Wrong value after erase.";
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FlatHashMapTests, iteratorTest )
+{
+    static char keys[FLATHASHMAP_UNITTEST_KEYCOUNT];
+    FlatHashMap<const char*, U32> map;
+
+    U32 expectedTotal = 0;
+    for( U32 index = 0; index < FLATHASHMAP_UNITTEST_KEYCOUNT; ++index )
+    {
+        map.insert( keys + index, index );
+        expectedTotal += index;
+    }
+
+    // Iterate.
+    U32 count = 0;
+    U32 total = 0;
+    for( FlatHashMap<const char*, U32>::iterator itr = map.begin(); itr != map.end(); ++itr )
+    {
+        count++;
+        total += itr->value;
+    }
+
+    // Check.
+    ASSERT_EQ( map.size(), count ) << "Iteration visited the wrong number of keys.";
+    ASSERT_EQ( expectedTotal, total ) << "Iteration visited the wrong keys.";
+
+    // Check clearing.
+    map.clear();
+    ASSERT_TRUE( map.begin() == map.end() ) << "Cleared map is not empty.";
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace FrameAllocatorTests
+{
+    static bool fillAndCheck( const U32 allocationCount, const U32 allocationSize )
+    {
+        FrameAllocatorMarker marker;
+
+        Vector<U8*> allocations;
+        for ( U32 index = 0; index < allocationCount; ++index )
+        {
+            U8* pMemory = (U8*)marker.alloc( allocationSize );
+            dMemset( pMemory, (U8)index, allocationSize );
+            allocations.push_back( pMemory );
+        }
+
+        for ( U32 index = 0; index < allocationCount; ++index )
+        {
+            for ( U32 offset = 0; offset < allocationSize; ++offset )
+            {
+                if ( allocations[index][offset] != (U8)index )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void threadFill( void* pResult )
+    {
+        // A fresh arena for this thread which overflows its buffer.
+        *(bool*)pResult = FrameAllocator::getWaterMark() == 0 && fillAndCheck( 64, 64 * 1024 ) && FrameAllocator::getWaterMark() == 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FrameAllocatorTests, overflowTest )
+{
+    const U32 waterMark = FrameAllocator::getWaterMark();
+
+    // Allocate more than the frame buffer so the arena has to chain overflow blocks.
+    const U32 allocationSize = 64 * 1024;
+    const U32 allocationCount = ( FrameAllocator::getHighWaterMark() - waterMark ) / allocationSize + 8;
+
+    ASSERT_TRUE( FrameAllocatorTests::fillAndCheck( allocationCount, allocationSize ) ) << "Overflow allocations overlap.";
+    ASSERT_EQ( waterMark, FrameAllocator::getWaterMark() ) << "The marker did not restore the watermark.";
+
+    // The chained blocks are reused until the end of the frame.
+    ASSERT_TRUE( FrameAllocatorTests::fillAndCheck( allocationCount, allocationSize ) ) << "Reused overflow allocations overlap.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FrameAllocatorTests, frameTempTest )
+{
+    const U32 waterMark = FrameAllocator::getWaterMark();
+
+    {
+        FrameTemp<char> buffer( 32 );
+        dStrcpy( buffer, "FrameTemp" );
+        ASSERT_EQ( 0, dStrcmp( ~buffer, "FrameTemp" ) ) << "FrameTemp memory is incorrect.";
+        ASSERT_LT( waterMark, FrameAllocator::getWaterMark() ) << "FrameTemp did not allocate.";
+    }
+
+    ASSERT_EQ( waterMark, FrameAllocator::getWaterMark() ) << "FrameTemp did not restore the watermark.";
+}
+
+//-----------------------------------------------------------------------------
+
+// Threads only have their own arenas with thread local storage.
+#ifdef TORQUE_THREAD_LOCAL
+
+TEST( FrameAllocatorTests, threadArenaTest )
+{
+    FrameAllocatorMarker marker;
+    marker.alloc( 1024 );
+    const U32 waterMark = FrameAllocator::getWaterMark();
+
+    bool result = false;
+    Thread* pThread = new Thread( FrameAllocatorTests::threadFill, &result );
+    pThread->join();
+    delete pThread;
+
+    ASSERT_TRUE( result ) << "Worker thread allocations failed.";
+    ASSERT_EQ( waterMark, FrameAllocator::getWaterMark() ) << "Worker thread changed the watermark of this thread.";
+}
+
+#endif // TORQUE_THREAD_LOCAL
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _FRAME_COUNTERS_H_
+#include "debug/frameCounters.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace FrameCountersTests
+{
+    static FrameCounter sAccumulateCounter( "tests.accumulate" );
+    static FrameCounter sGaugeCounter( "tests.gauge", FrameCounter::Gauge );
+
+    static U32 sSampleCount = 0;
+    static F32 sampleCounter( void )
+    {
+        return (F32)++sSampleCount;
+    }
+
+    static FrameCounter sSampledCounter( "tests.sampled", sampleCounter );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FrameCounters, historyTest )
+{
+    using namespace FrameCountersTests;
+
+    ASSERT_TRUE( FrameCounters::findCounter( "tests.accumulate" ) == &sAccumulateCounter ) << "Counter was not registered.";
+
+    const U32 previousLength = FrameCounters::getHistoryLength();
+    FrameCounters::setHistoryLength( 4 );
+
+    // Record six frames into a history of four.
+    for ( U32 frame = 0; frame < 6; ++frame )
+    {
+        sAccumulateCounter.add( 1.0f );
+        sAccumulateCounter.add( (F32)frame );
+
+        if ( frame == 0 )
+            sGaugeCounter.set( 5.0f );
+
+        FrameCounters::endFrame();
+    }
+
+    ASSERT_EQ( (U32)4, FrameCounters::getHistoryCount() ) << "History holds more frames than its length.";
+
+    // Accumulating counters start each frame at zero.
+    ASSERT_EQ( 0.0f, sAccumulateCounter.getValue() ) << "Accumulating counter was not cleared.";
+    for ( U32 framesAgo = 0; framesAgo < 4; ++framesAgo )
+    {
+        ASSERT_EQ( (F32)( 6 - framesAgo ), sAccumulateCounter.getHistory( framesAgo ) ) << "Wrong accumulated value recorded.";
+    }
+    ASSERT_EQ( 0.0f, sAccumulateCounter.getHistory( 4 ) ) << "Frames older than the history must read as zero.";
+
+    // Gauges keep their value.
+    ASSERT_EQ( 5.0f, sGaugeCounter.getHistory( 0 ) ) << "Gauge did not keep its value.";
+
+    // Sampled counters are fetched every frame.
+    ASSERT_EQ( sSampledCounter.getHistory( 1 ) + 1.0f, sSampledCounter.getHistory( 0 ) ) << "Sampled counter was not fetched each frame.";
+
+    F32 minimum, average, maximum;
+    FrameCounters::getRange( &sAccumulateCounter, minimum, average, maximum );
+    ASSERT_EQ( 3.0f, minimum ) << "Wrong minimum.";
+    ASSERT_EQ( 4.5f, average ) << "Wrong average.";
+    ASSERT_EQ( 6.0f, maximum ) << "Wrong maximum.";
+
+    FrameCounters::setHistoryLength( previousLength );
+}
+
+#endif // TORQUE_SHIPPING
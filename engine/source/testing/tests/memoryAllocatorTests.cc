@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _MEMORY_ALLOCATOR_H_
+#include "memory/memoryAllocator.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+TEST( MemoryAllocatorTests, tagStatsTest )
+{
+    const MemoryAllocator::TagStats& stats = MemoryAllocator::getStats( MemoryAllocator::ParticlesTag );
+    const U32 liveBytes = stats.mLiveBytes;
+    const U32 liveBlocks = stats.mLiveBlocks;
+
+    void* pSmall = MemoryAllocator::allocate( 100, MemoryAllocator::ParticlesTag );
+    void* pLarge = MemoryAllocator::allocate( 100000, MemoryAllocator::ParticlesTag );
+
+    ASSERT_TRUE( pSmall != NULL && pLarge != NULL ) << "Memory not allocated.";
+    ASSERT_EQ( MemoryAllocator::ParticlesTag, MemoryAllocator::getTag( pSmall ) ) << "Block has the wrong tag.";
+    ASSERT_EQ( (dsize_t)100, MemoryAllocator::getSize( pSmall ) ) << "Block has the wrong size.";
+    ASSERT_EQ( (U32)0, (U32)( (size_t)pSmall % MemoryAllocator::Alignment ) ) << "Small block is not aligned.";
+    ASSERT_EQ( (U32)0, (U32)( (size_t)pLarge % MemoryAllocator::Alignment ) ) << "Large block is not aligned.";
+    ASSERT_EQ( liveBytes + 100100, stats.mLiveBytes ) << "Live bytes were not counted.";
+    ASSERT_EQ( liveBlocks + 2, stats.mLiveBlocks ) << "Live blocks were not counted.";
+    ASSERT_LE( stats.mLiveBytes, stats.mPeakBytes ) << "Peak bytes are below the live bytes.";
+
+    MemoryAllocator::free( pLarge );
+    MemoryAllocator::free( pSmall );
+
+    ASSERT_EQ( liveBytes, stats.mLiveBytes ) << "Live bytes were not released.";
+    ASSERT_EQ( liveBlocks, stats.mLiveBlocks ) << "Live blocks were not released.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( MemoryAllocatorTests, reallocateTest )
+{
+    U8* pBlock = (U8*)MemoryAllocator::allocate( 20, MemoryAllocator::TexturesTag );
+    for ( U32 index = 0; index < 20; ++index )
+        pBlock[index] = (U8)index;
+
+    // Grow through the small sizes and into a large block.
+    const U32 sizes[] = { 24, 200, 1000, 5000, 20000, 64 };
+    for ( U32 n = 0; n < sizeof(sizes) / sizeof(U32); ++n )
+    {
+        pBlock = (U8*)MemoryAllocator::reallocate( pBlock, sizes[n] );
+
+        ASSERT_TRUE( pBlock != NULL ) << "Memory not reallocated.";
+        ASSERT_EQ( (U32)0, (U32)( (size_t)pBlock % MemoryAllocator::Alignment ) ) << "Reallocated block is not aligned.";
+        ASSERT_EQ( MemoryAllocator::TexturesTag, MemoryAllocator::getTag( pBlock ) ) << "Reallocation changed the tag.";
+
+        for ( U32 index = 0; index < 20; ++index )
+            ASSERT_EQ( (U8)index, pBlock[index] ) << "Reallocation lost the contents.";
+    }
+
+    MemoryAllocator::free( pBlock );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( MemoryAllocatorTests, tagScopeTest )
+{
+    const MemoryAllocator::Tag previousTag = MemoryAllocator::getCurrentTag();
+
+    {
+        MemoryTagScope sceneScope( MemoryAllocator::SceneTag );
+
+        void* pBlock = dMalloc( 32 );
+        ASSERT_EQ( MemoryAllocator::SceneTag, MemoryAllocator::getTag( pBlock ) ) << "dMalloc() did not use the current tag.";
+
+        {
+            MemoryTagScope simScope( MemoryAllocator::SimTag );
+            ASSERT_EQ( MemoryAllocator::SimTag, MemoryAllocator::getCurrentTag() ) << "Nested scope did not set the tag.";
+
+            // A reallocation keeps the tag the block was allocated with.
+            pBlock = dRealloc( pBlock, 4096 );
+            ASSERT_EQ( MemoryAllocator::SceneTag, MemoryAllocator::getTag( pBlock ) ) << "dRealloc() changed the tag.";
+        }
+
+        ASSERT_EQ( MemoryAllocator::SceneTag, MemoryAllocator::getCurrentTag() ) << "Nested scope did not restore the tag.";
+
+        dFree( pBlock );
+    }
+
+    ASSERT_EQ( previousTag, MemoryAllocator::getCurrentTag() ) << "Scope did not restore the tag.";
+}
+
+#endif // TORQUE_SHIPPING
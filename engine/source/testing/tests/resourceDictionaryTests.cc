@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _RESMANAGER_H_
+#include "io/resource/resourceManager.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+static ResourceObject* createTestResource( const S32 flags )
+{
+    ResourceObject* pObject = new ResourceObject;
+    pObject->flags = flags;
+    pObject->zipPath = NULL;
+    pObject->zipName = NULL;
+    return pObject;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ResourceDictionaryTests, insertAndFindTest )
+{
+    ResDictionary dictionary;
+
+    StringTableEntry path = StringTable->insert( "/resourceDictionaryTest/images" );
+    StringTableEntry name = StringTable->insert( "image.png" );
+
+    // Insert a resource.
+    ResourceObject* pObject = createTestResource( ResourceObject::File );
+    dictionary.insert( pObject, path, name );
+
+    // Check it is found by each kind of lookup.
+    ASSERT_EQ( pObject, dictionary.find( path, name ) ) << "Resource not found by name.";
+    ASSERT_EQ( pObject, dictionary.find( path, name, (U32)ResourceObject::File ) ) << "Resource not found by flags.";
+    ASSERT_EQ( (ResourceObject*)NULL, dictionary.find( path, name, (U32)ResourceObject::VolumeBlock ) ) << "Resource found with the wrong flags.";
+    ASSERT_EQ( (ResourceObject*)NULL, dictionary.find( path, StringTable->insert( "other.png" ) ) ) << "Missing resource was found.";
+
+    // Check an equivalent spelling of the path finds the same key.
+    ASSERT_EQ( pObject, dictionary.find( StringTable->insert( "\\resourceDictionaryTest\\images" ), name ) ) << "Resource not found by an equivalent path.";
+
+    dictionary.remove( pObject );
+    dictionary.retire( pObject );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ResourceDictionaryTests, pushBehindTest )
+{
+    ResDictionary dictionary;
+
+    StringTableEntry path = StringTable->insert( "/resourceDictionaryTest/scripts" );
+    StringTableEntry name = StringTable->insert( "main.cs" );
+
+    // Add a zip block and then a file with the same name.
+    ResourceObject* pBlock = createTestResource( ResourceObject::VolumeBlock );
+    dictionary.insert( pBlock, path, name );
+    ResourceObject* pFile = createTestResource( ResourceObject::File );
+    dictionary.insert( pFile, path, name );
+
+    // Check the zip block goes behind the file.
+    dictionary.pushBehind( pBlock, ResourceObject::File );
+    ASSERT_EQ( pFile, dictionary.find( path, name ) ) << "Zip block was not pushed behind the file.";
+    ASSERT_EQ( pBlock, dictionary.find( path, name, (U32)ResourceObject::VolumeBlock ) ) << "Zip block lost by pushBehind.";
+
+    // Check removing the file exposes the zip block.
+    dictionary.remove( pFile );
+    dictionary.retire( pFile );
+    ASSERT_EQ( pBlock, dictionary.find( path, name ) ) << "Zip block not found after removing the file.";
+
+    // Check a second remove is ignored.
+    dictionary.remove( pFile );
+    ASSERT_EQ( pBlock, dictionary.find( path, name ) ) << "Removing twice changed the dictionary.";
+
+    dictionary.remove( pBlock );
+    dictionary.retire( pBlock );
+    ASSERT_EQ( (ResourceObject*)NULL, dictionary.find( path, name ) ) << "Removed resource was found.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ResourceDictionaryTests, growTest )
+{
+    ResDictionary dictionary;
+    char buffer[32];
+
+    StringTableEntry path = StringTable->insert( "/resourceDictionaryTest/grow" );
+
+    // Insert enough resources to grow the table several times.
+    Vector<ResourceObject*> objects;
+    for( U32 index = 0; index < 4096; ++index )
+    {
+        dSprintf( buffer, sizeof(buffer), "file%d.png", index );
+        ResourceObject* pObject = createTestResource( ResourceObject::File );
+        dictionary.insert( pObject, path, StringTable->insert( buffer ) );
+        objects.push_back( pObject );
+    }
+
+    // Check all the resources are still found.
+    for( U32 index = 0; index < 4096; ++index )
+    {
+        dSprintf( buffer, sizeof(buffer), "file%d.png", index );
+        ASSERT_EQ( objects[index], dictionary.find( path, StringTable->insert( buffer ) ) ) << "Resource lost after growing the table.";
+    }
+
+    for( U32 index = 0; index < 4096; ++index )
+    {
+        dictionary.remove( objects[index] );
+        dictionary.retire( objects[index] );
+    }
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_ASSET_STREAMER_H_
+#include "2d/scene/SceneAssetStreamer.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace SceneAssetStreamerTests
+{
+    static b2AABB makeArea( const F32 x1, const F32 y1, const F32 x2, const F32 y2 )
+    {
+        b2AABB area;
+        area.lowerBound.Set( x1, y1 );
+        area.upperBound.Set( x2, y2 );
+        return area;
+    }
+
+    // NOTE: The asset Ids are not declared so the regions only track prefetching and never hold assets.
+    static const char* sAssetIds = "StreamerTest:missingA StreamerTest:missingB";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneAssetStreamer, predictionTest )
+{
+    using namespace SceneAssetStreamerTests;
+
+    SceneAssetStreamer streamer;
+    streamer.setLookAheadTime( 1.0f );
+    streamer.setMargin( 0.0f );
+
+    const U32 regionId = streamer.addRegion( makeArea( 15.0f, 0.0f, 25.0f, 10.0f ), sAssetIds );
+    ASSERT_NE( (U32)0, regionId ) << "Failed to add a region.";
+
+    // A stationary view does not reach the region.
+    U32 timeMs = 1000;
+    streamer.updateView( NULL, makeArea( 0.0f, 0.0f, 10.0f, 10.0f ), timeMs );
+    timeMs += 100;
+    streamer.updateView( NULL, makeArea( 0.0f, 0.0f, 10.0f, 10.0f ), timeMs );
+    ASSERT_EQ( (U32)0, streamer.getActiveRegionCount() ) << "A stationary view prefetched a region out of view.";
+
+    // A view moving towards the region prefetches it before reaching it.
+    F32 x = 0.0f;
+    for ( U32 n = 0; n < 4; ++n )
+    {
+        x += 1.0f;
+        timeMs += 100;
+        streamer.updateView( NULL, makeArea( x, 0.0f, x + 10.0f, 10.0f ), timeMs );
+    }
+    ASSERT_EQ( (U32)1, streamer.getActiveRegionCount() ) << "A view moving towards the region did not prefetch it.";
+    ASSERT_EQ( (U32)1, streamer.getStats().mPrefetches ) << "Unexpected prefetch count.";
+    ASSERT_EQ( (U32)0, streamer.getStats().mHits + streamer.getStats().mMisses ) << "The region was counted as seen before the view reached it.";
+
+    // Reaching the region counts it as seen once.
+    timeMs += 100;
+    streamer.updateView( NULL, makeArea( 16.0f, 0.0f, 26.0f, 10.0f ), timeMs );
+    timeMs += 100;
+    streamer.updateView( NULL, makeArea( 16.0f, 0.0f, 26.0f, 10.0f ), timeMs );
+    ASSERT_EQ( (U32)1, streamer.getStats().mHits ) << "The region should have been counted as a hit once.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneAssetStreamer, releaseTest )
+{
+    using namespace SceneAssetStreamerTests;
+
+    SceneAssetStreamer streamer;
+    streamer.setReleaseTime( 1.0f );
+
+    streamer.addRegion( makeArea( 0.0f, 0.0f, 10.0f, 10.0f ), sAssetIds );
+    streamer.addRegion( makeArea( 100.0f, 0.0f, 110.0f, 10.0f ), sAssetIds );
+
+    U32 timeMs = 1000;
+    streamer.updateView( NULL, makeArea( 0.0f, 0.0f, 10.0f, 10.0f ), timeMs );
+    ASSERT_EQ( (U32)1, streamer.getActiveRegionCount() ) << "The region in view was not activated.";
+
+    // Another view keeps its own region active.
+    SimObject* pOtherView = new SimObject();
+    pOtherView->registerObject();
+    streamer.updateView( pOtherView, makeArea( 100.0f, 0.0f, 110.0f, 10.0f ), timeMs );
+    ASSERT_EQ( (U32)2, streamer.getActiveRegionCount() ) << "The region in the other view was not activated.";
+
+    // The first region is kept until the release time has passed.
+    timeMs += 2000;
+    streamer.updateView( pOtherView, makeArea( 100.0f, 0.0f, 110.0f, 10.0f ), timeMs );
+    ASSERT_EQ( (U32)1, streamer.getActiveRegionCount() ) << "The region no view needs was not released.";
+    ASSERT_EQ( (U32)1, streamer.getStats().mReleases ) << "Unexpected release count.";
+
+    pOtherView->deleteObject();
+
+    streamer.clearRegions();
+    ASSERT_EQ( (U32)0, streamer.getRegionCount() ) << "Regions remain after clearing.";
+    ASSERT_EQ( (U32)0, streamer.getActiveRegionCount() ) << "Active regions remain after clearing.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneAssetStreamer, removeRegionTest )
+{
+    using namespace SceneAssetStreamerTests;
+
+    SceneAssetStreamer streamer;
+
+    ASSERT_EQ( (U32)0, streamer.addRegion( makeArea( 0.0f, 0.0f, 1.0f, 1.0f ), "" ) ) << "A region without assets should not be added.";
+
+    const U32 regionId = streamer.addRegion( makeArea( 0.0f, 0.0f, 10.0f, 10.0f ), sAssetIds );
+    streamer.updateView( NULL, makeArea( 0.0f, 0.0f, 10.0f, 10.0f ), 1000 );
+    ASSERT_EQ( (U32)1, streamer.getActiveRegionCount() ) << "The region in view was not activated.";
+
+    ASSERT_TRUE( streamer.removeRegion( regionId ) ) << "Failed to remove the region.";
+    ASSERT_FALSE( streamer.removeRegion( regionId ) ) << "Removed the region twice.";
+    ASSERT_EQ( (U32)0, streamer.getActiveRegionCount() ) << "The removed region is still active.";
+}
+
+#endif // TORQUE_SHIPPING
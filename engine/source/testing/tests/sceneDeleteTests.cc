@@ -0,0 +1,135 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SPRITE_H_
+#include "2d/sceneobject/Sprite.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace SceneDeleteTests
+{
+    static Scene* createScene( const U32 spriteCount, Vector<SimObjectId>& spriteIds )
+    {
+        Scene* pScene = new Scene();
+        if ( !pScene->registerObject() )
+        {
+            delete pScene;
+            return NULL;
+        }
+
+        for ( U32 n = 0; n < spriteCount; ++n )
+        {
+            Sprite* pSprite = new Sprite();
+            pSprite->registerObject();
+            pScene->addToScene( pSprite );
+            spriteIds.push_back( pSprite->getId() );
+        }
+
+        return pScene;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneDelete, batchRemoveTest )
+{
+    Vector<SimObjectId> spriteIds;
+    Scene* pScene = SceneDeleteTests::createScene( 200, spriteIds );
+    ASSERT_TRUE( pScene != NULL ) << "Failed to create a scene.";
+
+    // Remove every other sprite in a single batch.
+    typeSceneObjectVector removed;
+    for ( S32 n = 0; n < spriteIds.size(); n += 2 )
+        removed.push_back( dynamic_cast<SceneObject*>( Sim::findObject( spriteIds[n] ) ) );
+    pScene->removeFromScene( removed );
+    ASSERT_EQ( (U32)100, pScene->getSceneObjectCount() ) << "Batch removal left the wrong number of objects.";
+
+    // The remaining sprites must keep their order.
+    for ( U32 n = 0; n < pScene->getSceneObjectCount(); ++n )
+    {
+        ASSERT_EQ( spriteIds[n * 2 + 1], pScene->getSceneObject( n )->getId() ) << "Batch removal changed the object order.";
+    }
+
+    // The removed sprites must be out of the scene and removable individually afterwards.
+    for ( S32 n = 0; n < removed.size(); ++n )
+    {
+        ASSERT_TRUE( removed[n]->getScene() == NULL ) << "Removed object still references the scene.";
+        removed[n]->deleteObject();
+    }
+    pScene->removeFromScene( pScene->getSceneObject( 0 ) );
+    ASSERT_EQ( (U32)99, pScene->getSceneObjectCount() ) << "Single removal after a batch removal failed.";
+    Sim::findObject( spriteIds[1] )->deleteObject();
+
+    pScene->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneDelete, deleteBudgetTest )
+{
+    Vector<SimObjectId> spriteIds;
+    Scene* pScene = SceneDeleteTests::createScene( 256, spriteIds );
+    ASSERT_TRUE( pScene != NULL ) << "Failed to create a scene.";
+
+    // Make each safe-delete callback take a millisecond so the budget is always used up by the first batch.
+    Con::evaluate( "function SceneDeleteBudgetTest::onSafeDelete( %this, %object ) { %end = getRealTime() + 1; while ( getRealTime() < %end ) {} }" );
+    pScene->setClassNamespace( "SceneDeleteBudgetTest" );
+
+    // Safe-delete every sprite with a budget; the requests must drain over successive ticks.
+    pScene->setDeleteBudget( 1 );
+    for ( S32 n = 0; n < spriteIds.size(); ++n )
+        dynamic_cast<SceneObject*>( Sim::findObject( spriteIds[n] ) )->safeDelete();
+    ASSERT_EQ( (U32)256, pScene->getDeleteRequestCount() ) << "Safe-delete did not queue a request per object.";
+
+    U32 ticks = 0;
+    while ( pScene->getDeleteRequestCount() > 0 && ticks < 10000 )
+    {
+        pScene->processDeleteRequests( false );
+        ++ticks;
+    }
+    ASSERT_EQ( (U32)0, pScene->getDeleteRequestCount() ) << "Delete requests were not drained.";
+    ASSERT_GT( ticks, (U32)1 ) << "The delete budget did not spread the requests over several ticks.";
+    ASSERT_EQ( (U32)0, pScene->getSceneObjectCount() ) << "Deleted objects are still in the scene.";
+
+    for ( S32 n = 0; n < spriteIds.size(); ++n )
+    {
+        ASSERT_TRUE( Sim::findObject( spriteIds[n] ) == NULL ) << "A safe-deleted object still exists.";
+    }
+
+    pScene->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
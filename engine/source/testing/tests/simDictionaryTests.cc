@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMDICTIONARY_UNITTEST_OBJECTCOUNT  5000
+
+//-----------------------------------------------------------------------------
+
+TEST( SimDictionaryTests, findIdTest )
+{
+    Vector<SimObject*> objects;
+    Vector<SimObjectId> ids;
+    for( U32 index = 0; index < SIMDICTIONARY_UNITTEST_OBJECTCOUNT; ++index )
+    {
+        SimObject* pObject = new SimObject();
+        ASSERT_TRUE( pObject->registerObject() ) << "Failed to register object.";
+        objects.push_back( pObject );
+        ids.push_back( pObject->getId() );
+    }
+
+    // Delete the first half so that whole pages of ids are released.
+    const U32 halfCount = SIMDICTIONARY_UNITTEST_OBJECTCOUNT / 2;
+    for( U32 index = 0; index < halfCount; ++index )
+        objects[index]->deleteObject();
+
+    for( U32 index = 0; index < SIMDICTIONARY_UNITTEST_OBJECTCOUNT; ++index )
+    {
+        SimObject* pExpected = index < halfCount ? NULL : objects[index];
+        ASSERT_EQ( pExpected, Sim::findObject( ids[index] ) ) << "Wrong object found for id.";
+    }
+
+    // Ids outside the sequential range are looked up too.
+    SimObject* pObject = new SimObject();
+    ASSERT_TRUE( pObject->registerObject( 0x7ffffff0 ) ) << "Failed to register object with a high id.";
+    ASSERT_EQ( pObject, Sim::findObject( 0x7ffffff0 ) ) << "High id not found.";
+    pObject->deleteObject();
+    ASSERT_TRUE( Sim::findObject( 0x7ffffff0 ) == NULL ) << "Deleted high id still found.";
+
+    for( U32 index = halfCount; index < SIMDICTIONARY_UNITTEST_OBJECTCOUNT; ++index )
+        objects[index]->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimDictionaryTests, findNameTest )
+{
+    Vector<SimObject*> objects;
+    char name[32];
+    for( U32 index = 0; index < SIMDICTIONARY_UNITTEST_OBJECTCOUNT; ++index )
+    {
+        dSprintf( name, sizeof(name), "simDictionaryTest%d", index );
+        SimObject* pObject = new SimObject();
+        ASSERT_TRUE( pObject->registerObject( name ) ) << "Failed to register named object.";
+        objects.push_back( pObject );
+    }
+
+    for( U32 index = 0; index < SIMDICTIONARY_UNITTEST_OBJECTCOUNT; ++index )
+    {
+        dSprintf( name, sizeof(name), "simDictionaryTest%d", index );
+        ASSERT_EQ( objects[index], Sim::findObject( name ) ) << "Wrong object found for name.";
+    }
+
+    // Removing a name makes it unknown without affecting the others.
+    objects[0]->deleteObject();
+    ASSERT_TRUE( Sim::findObject( "simDictionaryTest0" ) == NULL ) << "Deleted object still found by name.";
+    ASSERT_EQ( objects[1], Sim::findObject( "simDictionaryTest1" ) ) << "Wrong object found for name.";
+
+    for( U32 index = 1; index < SIMDICTIONARY_UNITTEST_OBJECTCOUNT; ++index )
+        objects[index]->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
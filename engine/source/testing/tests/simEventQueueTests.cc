@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMEVENTQUEUE_UNITTEST_EVENTCOUNT   1000
+
+//-----------------------------------------------------------------------------
+
+static Vector<U32> sProcessedEvents;
+
+class SimEventQueueTestEvent : public SimEvent
+{
+public:
+    U32 mTag;
+
+    SimEventQueueTestEvent( const U32 tag ) : mTag( tag ) {}
+
+    virtual void process( SimObject* object )
+    {
+        sProcessedEvents.push_back( mTag );
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( SimEventQueueTests, postOrderTest )
+{
+    SimObject* pObject = new SimObject();
+    ASSERT_TRUE( pObject->registerObject() ) << "Failed to register object.";
+
+    sProcessedEvents.clear();
+
+    // Events due at the same time must be processed in the order they were posted.
+    const SimTime currentTime = Sim::getCurrentTime();
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; ++index )
+        Sim::postEvent( pObject, new SimEventQueueTestEvent( index ), currentTime );
+
+    Sim::advanceTime( 0 );
+
+    ASSERT_EQ( SIMEVENTQUEUE_UNITTEST_EVENTCOUNT, sProcessedEvents.size() ) << "Wrong number of events processed.";
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; ++index )
+    {
+        ASSERT_EQ( index, sProcessedEvents[index] ) << "Events processed out of order.";
+    }
+
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimEventQueueTests, cancelTest )
+{
+    SimObject* pObject = new SimObject();
+    ASSERT_TRUE( pObject->registerObject() ) << "Failed to register object.";
+
+    const U32 baseQueueSize = Sim::getEventQueueSize();
+    const SimTime currentTime = Sim::getCurrentTime();
+
+    // Post events in the future so that none are processed.
+    Vector<U32> eventIds;
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; ++index )
+        eventIds.push_back( Sim::postEvent( pObject, new SimEventQueueTestEvent( index ), currentTime + 1000 + (index % 7) ) );
+
+    ASSERT_EQ( baseQueueSize + SIMEVENTQUEUE_UNITTEST_EVENTCOUNT, Sim::getEventQueueSize() ) << "Wrong queue size after posting.";
+
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; ++index )
+    {
+        ASSERT_TRUE( Sim::isEventPending( eventIds[index] ) ) << "Posted event is not pending.";
+        ASSERT_EQ( 1000 + (index % 7), Sim::getEventTimeLeft( eventIds[index] ) ) << "Wrong time left for event.";
+    }
+
+    // Cancel every other event.
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; index += 2 )
+        Sim::cancelEvent( eventIds[index] );
+
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; ++index )
+    {
+        ASSERT_EQ( (index & 1) != 0, Sim::isEventPending( eventIds[index] ) ) << "Wrong pending state after cancelling.";
+    }
+
+    // Deleting the object cancels the rest.
+    pObject->deleteObject();
+
+    ASSERT_EQ( baseQueueSize, Sim::getEventQueueSize() ) << "Events still pending for a deleted object.";
+    for( U32 index = 0; index < SIMEVENTQUEUE_UNITTEST_EVENTCOUNT; ++index )
+    {
+        ASSERT_FALSE( Sim::isEventPending( eventIds[index] ) ) << "Event pending for a deleted object.";
+    }
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,136 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIM_OBJECT_POOL_H_
+#include "sim/simObjectPool.h"
+#endif
+
+#ifndef _SPRITE_H_
+#include "2d/sceneobject/Sprite.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace SimObjectPoolTests
+{
+    static Sprite* createSprite( void )
+    {
+        Sprite* pSprite = dynamic_cast<Sprite*>( ConsoleObject::create( "Sprite" ) );
+        if ( pSprite != NULL && !pSprite->registerObject() )
+        {
+            delete pSprite;
+            return NULL;
+        }
+
+        return pSprite;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimObjectPool, recycleTest )
+{
+    SimObjectPoolBase* pPool = SimObjectPoolBase::findPool( "Sprite" );
+    ASSERT_TRUE( pPool != NULL ) << "Sprite does not have an object pool.";
+
+    const U32 previousCapacity = pPool->getCapacity();
+    pPool->setCapacity( 0 );
+
+    // A disabled pool must not keep objects.
+    Sprite* pSprite = SimObjectPoolTests::createSprite();
+    ASSERT_TRUE( pSprite != NULL ) << "Failed to create a sprite.";
+    pSprite->recycleObject();
+    ASSERT_EQ( (U32)0, pPool->getCachedCount() ) << "Disabled pool kept an object.";
+
+    // An enabled pool must hand back the recycled object in its constructed state.
+    pPool->setCapacity( 1 );
+    pSprite = SimObjectPoolTests::createSprite();
+    ASSERT_TRUE( pSprite != NULL ) << "Failed to create a sprite.";
+    StringTableEntry testFieldName = StringTable->insert( "poolTestField" );
+    pSprite->setSize( Vector2( 5.0f, 7.0f ) );
+    pSprite->setFlip( true, true );
+    pSprite->setSceneLayer( 5 );
+    pSprite->setDataField( testFieldName, NULL, "1" );
+    const SimObjectId recycledId = pSprite->getId();
+    Sprite* pRecycledSprite = pSprite;
+    const U32 recycledSerialId = pSprite->getSerialId();
+    const U32 liveCount = SceneObject::getGlobalSceneObjectCount();
+    pSprite->recycleObject();
+    ASSERT_EQ( (U32)1, pPool->getCachedCount() ) << "Pool did not keep the recycled object.";
+    ASSERT_EQ( liveCount - 1, SceneObject::getGlobalSceneObjectCount() ) << "Idle object is still counted as a scene object.";
+
+    pSprite = SimObjectPoolTests::createSprite();
+    ASSERT_TRUE( pSprite == pRecycledSprite ) << "Pool did not reuse the recycled object.";
+    ASSERT_EQ( (U32)0, pPool->getCachedCount() ) << "Pool still holds the reused object.";
+    ASSERT_TRUE( pSprite->getSize() == Vector2::getOne() ) << "Reused object was not reset.";
+    ASSERT_FALSE( pSprite->getFlipX() || pSprite->getFlipY() ) << "Reused object kept its flipping.";
+    ASSERT_EQ( (U32)0, pSprite->getSceneLayer() ) << "Reused object kept its scene layer.";
+    ASSERT_STREQ( "", pSprite->getDataField( testFieldName, NULL ) ) << "Reused object kept its dynamic fields.";
+    ASSERT_NE( recycledId, pSprite->getId() ) << "Reused object kept its old id.";
+    ASSERT_FALSE( pSprite->isDeleted() ) << "Reused object is still flagged as deleted.";
+    ASSERT_TRUE( pSprite->getSerialId() > recycledSerialId ) << "Reused object kept its old serial id.";
+    ASSERT_EQ( liveCount, SceneObject::getGlobalSceneObjectCount() ) << "Reused object is not counted as a scene object.";
+
+    pSprite->deleteObject();
+    pPool->setCapacity( previousCapacity );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimObjectPool, capacityTest )
+{
+    SimObjectPoolBase* pPool = SimObjectPoolBase::findPool( "Sprite" );
+    ASSERT_TRUE( pPool != NULL ) << "Sprite does not have an object pool.";
+
+    const U32 previousCapacity = pPool->getCapacity();
+    pPool->setCapacity( 4 );
+
+    // Recycle more objects than the pool can hold.
+    Vector<Sprite*> sprites;
+    for ( U32 index = 0; index < 8; ++index )
+        sprites.push_back( SimObjectPoolTests::createSprite() );
+    for ( U32 index = 0; index < (U32)sprites.size(); ++index )
+        sprites[index]->recycleObject();
+
+    ASSERT_EQ( (U32)4, pPool->getCachedCount() ) << "Pool exceeded its capacity.";
+
+    // Lowering the capacity must release the excess without touching the live count.
+    const U32 liveCount = SceneObject::getGlobalSceneObjectCount();
+    pPool->setCapacity( 1 );
+    ASSERT_EQ( (U32)1, pPool->getCachedCount() ) << "Pool was not trimmed to its capacity.";
+
+    pPool->purge();
+    ASSERT_EQ( (U32)0, pPool->getCachedCount() ) << "Pool was not purged.";
+    ASSERT_EQ( liveCount, SceneObject::getGlobalSceneObjectCount() ) << "Deleting idle objects changed the scene object count.";
+
+    pPool->setCapacity( previousCapacity );
+}
+
+#endif // TORQUE_SHIPPING
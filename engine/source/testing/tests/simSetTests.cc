@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMSET_UNITTEST_OBJECTCOUNT    100
+
+//-----------------------------------------------------------------------------
+
+static void createSimSetTestObjects( SimSet* pSet, Vector<SimObject*>& objects )
+{
+    objects.clear();
+    for( U32 index = 0; index < SIMSET_UNITTEST_OBJECTCOUNT; ++index )
+    {
+        SimObject* pObject = new SimObject();
+        pObject->registerObject();
+        pSet->addObject( pObject );
+        objects.push_back( pObject );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, orderedRemoveTest )
+{
+    SimSet* pSet = new SimSet();
+    ASSERT_TRUE( pSet->registerObject() ) << "Failed to register set.";
+    ASSERT_TRUE( pSet->isOrdered() ) << "Sets should be ordered by default.";
+
+    Vector<SimObject*> objects;
+    createSimSetTestObjects( pSet, objects );
+
+    // Delete every third object.
+    Vector<SimObject*> remaining;
+    for( U32 index = 0; index < SIMSET_UNITTEST_OBJECTCOUNT; ++index )
+    {
+        if ( index % 3 == 0 )
+            objects[index]->deleteObject();
+        else
+            remaining.push_back( objects[index] );
+    }
+
+    ASSERT_EQ( remaining.size(), pSet->size() ) << "Deleted objects were not removed from the set.";
+    for( S32 index = 0; index < remaining.size(); ++index )
+    {
+        ASSERT_EQ( remaining[index], pSet->at( index ) ) << "Set order was not preserved.";
+        ASSERT_TRUE( pSet->contains( remaining[index] ) ) << "Object should be a member of the set.";
+    }
+
+    // Move the last object in front of the first.
+    ASSERT_TRUE( pSet->reOrder( remaining.last(), remaining.first() ) ) << "Failed to reorder the set.";
+    ASSERT_EQ( remaining.last(), pSet->at( 0 ) ) << "Object was not moved to the front.";
+    ASSERT_EQ( remaining.first(), pSet->at( 1 ) ) << "Target was not moved back.";
+
+    pSet->deleteObjects();
+    ASSERT_EQ( 0, pSet->size() ) << "Set should be empty.";
+    pSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, unorderedRemoveTest )
+{
+    SimSet* pSet = new SimSet();
+    ASSERT_TRUE( pSet->registerObject() ) << "Failed to register set.";
+    pSet->setOrdered( false );
+
+    SimSet* pOtherSet = new SimSet();
+    ASSERT_TRUE( pOtherSet->registerObject() ) << "Failed to register set.";
+
+    Vector<SimObject*> objects;
+    createSimSetTestObjects( pSet, objects );
+    for( S32 index = 0; index < objects.size(); ++index )
+        pOtherSet->addObject( objects[index] );
+
+    // Remove the even objects from one set only.
+    for( S32 index = 0; index < objects.size(); index += 2 )
+        pSet->removeObject( objects[index] );
+
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTCOUNT / 2, pSet->size() ) << "Wrong number of objects removed.";
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTCOUNT, pOtherSet->size() ) << "Objects were removed from the wrong set.";
+    for( S32 index = 0; index < objects.size(); ++index )
+    {
+        ASSERT_EQ( (index & 1) != 0, pSet->contains( objects[index] ) ) << "Wrong set membership.";
+        ASSERT_TRUE( pOtherSet->contains( objects[index] ) ) << "Object should be a member of the other set.";
+        if ( pSet->contains( objects[index] ) )
+        {
+            ASSERT_EQ( objects[index], *pSet->find( objects[index] ) ) << "Object index is wrong.";
+        }
+    }
+
+    // Deleting the objects removes them from both sets.
+    for( S32 index = 0; index < objects.size(); ++index )
+        objects[index]->deleteObject();
+
+    ASSERT_EQ( 0, pSet->size() ) << "Set should be empty.";
+    ASSERT_EQ( 0, pOtherSet->size() ) << "Other set should be empty.";
+
+    pSet->deleteObject();
+    pOtherSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, groupMembershipTest )
+{
+    SimGroup* pGroup = new SimGroup();
+    ASSERT_TRUE( pGroup->registerObject() ) << "Failed to register group.";
+
+    SimGroup* pOtherGroup = new SimGroup();
+    ASSERT_TRUE( pOtherGroup->registerObject() ) << "Failed to register group.";
+
+    Vector<SimObject*> objects;
+    createSimSetTestObjects( pGroup, objects );
+
+    // Moving an object to another group removes it from the first.
+    pOtherGroup->addObject( objects[0] );
+    ASSERT_FALSE( pGroup->contains( objects[0] ) ) << "Object should have left the group.";
+    ASSERT_TRUE( pOtherGroup->contains( objects[0] ) ) << "Object should have joined the other group.";
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTCOUNT - 1, pGroup->size() ) << "Wrong group size.";
+
+    // Deleting the groups deletes their objects.
+    pGroup->deleteObject();
+    pOtherGroup->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
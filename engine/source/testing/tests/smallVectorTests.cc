@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SMALL_VECTOR_H_
+#include "collection/smallVector.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace SmallVectorTests
+{
+    static S32 sgLiveCount = 0;
+
+    /// An element that owns heap memory so leaks and double destructs show up.
+    class Tracked
+    {
+    public:
+        Tracked() : mpValue( new U32( 0 ) )                       { ++sgLiveCount; }
+        Tracked( const U32 value ) : mpValue( new U32( value ) )  { ++sgLiveCount; }
+        Tracked( const Tracked& other ) : mpValue( new U32( *other.mpValue ) ) { ++sgLiveCount; }
+        ~Tracked()                                                { delete mpValue; --sgLiveCount; }
+
+        Tracked& operator=( const Tracked& other )                { *mpValue = *other.mpValue; return *this; }
+        bool operator==( const Tracked& other ) const             { return *mpValue == *other.mpValue; }
+
+        U32 getValue( void ) const                                { return *mpValue; }
+
+    private:
+        U32* mpValue;
+    };
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SmallVectorTests, inlineAndGrowTest )
+{
+    SmallVector<U32, 8> list;
+
+    // The inline storage is used until it is full.
+    for ( U32 index = 0; index < 8; ++index )
+        list.push_back( index );
+    ASSERT_TRUE( list.isInline() ) << "List left its inline storage too soon.";
+
+    // Growing moves the elements to the heap.
+    for ( U32 index = 8; index < 100; ++index )
+        list.push_back( index );
+    ASSERT_FALSE( list.isInline() ) << "List did not grow.";
+    ASSERT_EQ( 100, list.size() ) << "Wrong number of elements.";
+    for ( U32 index = 0; index < 100; ++index )
+    {
+        ASSERT_EQ( index, list[index] ) << "Element changed while growing.";
+    }
+
+    // Erase keeps the order, erase-fast moves the last element.
+    list.erase( 0 );
+    ASSERT_EQ( (U32)1, list[0] ) << "Erase did not keep the order.";
+    list.erase_fast( 0 );
+    ASSERT_EQ( (U32)99, list[0] ) << "Erase-fast did not move the last element.";
+    list.insert( 1, 1000 );
+    ASSERT_EQ( (U32)1000, list[1] ) << "Insert put the element in the wrong place.";
+    ASSERT_EQ( (U32)2, list[2] ) << "Insert did not shift the following elements.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SmallVectorTests, lifetimeTest )
+{
+    using namespace SmallVectorTests;
+
+    sgLiveCount = 0;
+    {
+        SmallVector<Tracked, 4> list;
+        for ( U32 index = 0; index < 20; ++index )
+            list.push_back( Tracked( index ) );
+
+        // Pushing an element of the list itself must survive the list growing.
+        list.push_back( list[0] );
+        ASSERT_EQ( (U32)0, list.last().getValue() ) << "Pushing an element of the list lost its value.";
+
+        SmallVector<Tracked, 4> copy( list );
+        ASSERT_EQ( list.size(), copy.size() ) << "Copy has the wrong number of elements.";
+        ASSERT_EQ( (U32)19, copy[19].getValue() ) << "Copy has the wrong elements.";
+
+        copy.setSize( 2 );
+        copy.erase( 0 );
+        list.clear();
+        ASSERT_EQ( 1, sgLiveCount ) << "Elements were not destructed when removed.";
+    }
+    ASSERT_EQ( 0, sgLiveCount ) << "Elements were not destructed with the list.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SmallVectorTests, vectorSwapTest )
+{
+    Vector<U32> first;
+    Vector<U32> second;
+    for ( U32 index = 0; index < 10; ++index )
+        first.push_back( index );
+    second.push_back( 100 );
+
+    const U32* pFirstArray = first.address();
+    first.swap( second );
+
+    ASSERT_EQ( 1, first.size() ) << "Swap did not exchange the elements.";
+    ASSERT_EQ( 10, second.size() ) << "Swap did not exchange the elements.";
+    ASSERT_EQ( pFirstArray, second.address() ) << "Swap copied the elements.";
+    ASSERT_EQ( (U32)100, first[0] ) << "Swap lost an element.";
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,145 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, insertCaseInsensitiveTest )
+{
+    // Insert without case sensitivity.
+    StringTableEntry first = StringTable->insert( "StringTableTestName" );
+    StringTableEntry second = StringTable->insert( "stringtabletestname" );
+
+    // Check both resolve to the first string inserted.
+    ASSERT_EQ( first, second ) << "Case insensitive insert returned different entries.";
+    ASSERT_STREQ( "StringTableTestName", second ) << "Case insensitive insert changed the stored string.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, insertCaseSensitiveTest )
+{
+    // Insert the same string with different case.
+    StringTableEntry insensitive = StringTable->insert( "StringTableTestCase" );
+    StringTableEntry sensitive = StringTable->insert( "stringtabletestcase", true );
+
+    // Check the case sensitive insert got its own entry.
+    ASSERT_NE( insensitive, sensitive ) << "Case sensitive insert matched a different case.";
+    ASSERT_STREQ( "stringtabletestcase", sensitive ) << "Case sensitive insert stored the wrong string.";
+
+    // Check case insensitive inserts still resolve to the first entry.
+    ASSERT_EQ( insensitive, StringTable->insert( "STRINGTABLETESTCASE" ) ) << "Case insensitive insert did not return the first entry.";
+    ASSERT_EQ( sensitive, StringTable->insert( "stringtabletestcase", true ) ) << "Case sensitive insert did not return the existing entry.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, insertnAndLookupnTest )
+{
+    // Insert part of a string.
+    StringTableEntry entry = StringTable->insertn( "StringTableTestPartial-Suffix", 22 );
+
+    // Check.
+    ASSERT_STREQ( "StringTableTestPartial", entry ) << "Explicit-length insert stored the wrong string.";
+    ASSERT_EQ( entry, StringTable->lookupn( "stringtabletestpartial.Other", 22 ) ) << "Explicit-length lookup failed.";
+    ASSERT_EQ( entry, StringTable->insert( "StringTableTestPartial" ) ) << "Explicit-length insert did not match a full insert.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, lookupTest )
+{
+    // Check a missing string is not added by a lookup.
+    ASSERT_EQ( (StringTableEntry)NULL, StringTable->lookup( "StringTableTestMissing" ) ) << "Lookup found a string never inserted.";
+    ASSERT_EQ( (StringTableEntry)NULL, StringTable->lookup( "StringTableTestMissing" ) ) << "Lookup added a string.";
+
+    // Check an inserted string is found.
+    StringTableEntry entry = StringTable->insert( "StringTableTestMissing" );
+    ASSERT_EQ( entry, StringTable->lookup( "STRINGTABLETESTMISSING" ) ) << "Lookup did not find an inserted string.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, reusedBufferTest )
+{
+    char buffer[32];
+
+    // Insert twice from the same buffer with different contents.
+    dStrcpy( buffer, "StringTableTestBufferA" );
+    StringTableEntry first = StringTable->insert( buffer );
+    dStrcpy( buffer, "StringTableTestBufferB" );
+    StringTableEntry second = StringTable->insert( buffer );
+
+    // Check the per-thread cache did not return the stale entry.
+    ASSERT_NE( first, second ) << "Reused buffer returned a stale entry.";
+    ASSERT_STREQ( "StringTableTestBufferB", second ) << "Reused buffer inserted the wrong string.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, growTest )
+{
+    char buffer[32];
+
+    // Insert enough strings to grow every shard several times.
+    StringTableEntry entries[4096];
+    for( U32 index = 0; index < 4096; ++index )
+    {
+        dSprintf( buffer, sizeof(buffer), "StringTableTestGrow%d", index );
+        entries[index] = StringTable->insert( buffer );
+    }
+
+    // Check all the strings are still found.
+    for( U32 index = 0; index < 4096; ++index )
+    {
+        dSprintf( buffer, sizeof(buffer), "StringTableTestGrow%d", index );
+        ASSERT_EQ( entries[index], StringTable->lookup( buffer ) ) << "String lost after growing the table.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, constStringTableEntryTest )
+{
+    static ConstStringTableEntry constEntry( "StringTableTestConstant" );
+
+    // Check the constant resolves to the inserted string.
+    ASSERT_EQ( StringTable->insert( "StringTableTestConstant" ), constEntry.get() ) << "Constant entry did not resolve.";
+    ASSERT_EQ( constEntry.get(), (StringTableEntry)constEntry ) << "Constant entry conversion failed.";
+}
+
+#endif // TORQUE_SHIPPING
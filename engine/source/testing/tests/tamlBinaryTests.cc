@@ -0,0 +1,204 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TAML_H_
+#include "persistence/taml/taml.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+// NOTE: The XML extension is used so that reading relies on the content to identify the format.
+#define TAML_BINARY_UNITTEST_FILE       "_unitTestTamlBinary_RemoveMe.taml"
+#define TAML_BINARY_UNITTEST_NAME       "TamlBinaryTestsNamedSet"
+
+//-----------------------------------------------------------------------------
+
+static void deleteTamlBinaryTestObjects( SimSet* pRoot )
+{
+    // The shared object is a child of both sets so delete it once.
+    SimSet* pNamed = dynamic_cast<SimSet*>( pRoot->at( 1 ) );
+    pRoot->at( 0 )->deleteObject();
+    if ( pNamed != NULL )
+        pNamed->deleteObject();
+    pRoot->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+static void roundTripBinary( const bool compressed )
+{
+    char filenameBuffer[1024];
+    Con::expandPath( filenameBuffer, sizeof(filenameBuffer), TAML_BINARY_UNITTEST_FILE );
+
+    // Create a root set holding a shared object and a named set that references the shared object again.
+    SimSet* pRoot = new SimSet();
+    ASSERT_TRUE( pRoot->registerObject() ) << "Failed to register the root set.";
+    SimObject* pShared = new SimObject();
+    ASSERT_TRUE( pShared->registerObject() ) << "Failed to register the shared object.";
+    pShared->setDataField( StringTable->insert( "Colour" ), NULL, "1 0.5 0.25 1" );
+    pShared->setDataField( StringTable->insert( "Label" ), NULL, "Colour" );
+    SimSet* pNamed = new SimSet();
+    ASSERT_TRUE( pNamed->registerObject( TAML_BINARY_UNITTEST_NAME ) ) << "Failed to register the named set.";
+    pRoot->addObject( pShared );
+    pRoot->addObject( pNamed );
+    pNamed->addObject( pShared );
+
+    // Write the binary format.
+    Taml taml;
+    taml.setAutoFormat( false );
+    taml.setFormatMode( Taml::BinaryFormat );
+    taml.setBinaryCompression( compressed );
+    ASSERT_TRUE( taml.write( pRoot, filenameBuffer ) ) << "Failed to write the binary file.";
+
+    // Delete the originals so that the name is available again.
+    deleteTamlBinaryTestObjects( pRoot );
+
+    // Read the file, identifying the format from its content.
+    taml.setAutoFormat( true );
+    taml.setFormatMode( Taml::XmlFormat );
+    SimSet* pReadRoot = dynamic_cast<SimSet*>( taml.read( filenameBuffer ) );
+    Platform::fileDelete( filenameBuffer );
+    ASSERT_TRUE( pReadRoot != NULL ) << "Failed to read the binary file.";
+    ASSERT_EQ( (U32)2, (U32)pReadRoot->size() ) << "The root set children were not read.";
+
+    SimObject* pReadShared = pReadRoot->at( 0 );
+    SimSet* pReadNamed = dynamic_cast<SimSet*>( pReadRoot->at( 1 ) );
+    ASSERT_TRUE( pReadNamed != NULL ) << "The named set was not read.";
+    ASSERT_STREQ( TAML_BINARY_UNITTEST_NAME, pReadNamed->getName() );
+    ASSERT_STREQ( "1 0.5 0.25 1", pReadShared->getDataField( StringTable->insert( "Colour" ), NULL ) );
+    ASSERT_STREQ( "Colour", pReadShared->getDataField( StringTable->insert( "Label" ), NULL ) );
+
+    // The reference should resolve to the same object.
+    ASSERT_EQ( (U32)1, (U32)pReadNamed->size() ) << "The named set children were not read.";
+    ASSERT_EQ( pReadShared, pReadNamed->at( 0 ) ) << "The shared object reference was not resolved.";
+
+    deleteTamlBinaryTestObjects( pReadRoot );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlBinaryTests, RoundTrip )
+{
+    roundTripBinary( false );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlBinaryTests, RoundTripCompressed )
+{
+    roundTripBinary( true );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Writes the start of an element as the version 2 stream format did.
+static void writeStreamElement( Stream& stream, const char* pTypeName, const char* pObjectName, const U32 tamlRefId, const U32 tamlRefToId )
+{
+    stream.writeString( pTypeName );
+    stream.writeString( pObjectName );
+    stream.write( tamlRefId );
+    stream.write( tamlRefToId );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlBinaryTests, ReadStreamVersion )
+{
+    char filenameBuffer[1024];
+    Con::expandPath( filenameBuffer, sizeof(filenameBuffer), TAML_BINARY_UNITTEST_FILE );
+
+    // Write the version 2 stream format of the same document the round trip writes.
+    FileStream stream;
+    ASSERT_TRUE( stream.open( filenameBuffer, FileStream::Write ) ) << "Failed to open the binary file for write.";
+    stream.writeString( TAML_SIGNATURE );
+    stream.write( (U32)2 );
+    stream.write( false );
+
+    // The root set with no fields and two children.
+    writeStreamElement( stream, "SimSet", "", 0, 0 );
+    stream.write( (U32)0 );
+    stream.write( (U32)2 );
+    {
+        // The shared object with two fields, no children and no custom nodes.
+        writeStreamElement( stream, "SimObject", "", 1, 0 );
+        stream.write( (U32)2 );
+        stream.writeString( "Colour" );
+        stream.writeLongString( 4096, "1 0.5 0.25 1" );
+        stream.writeString( "Label" );
+        stream.writeLongString( 4096, "Colour" );
+        stream.write( (U32)0 );
+        stream.write( (U32)0 );
+
+        // The named set with a reference to the shared object and no custom nodes.
+        writeStreamElement( stream, "SimSet", TAML_BINARY_UNITTEST_NAME, 0, 0 );
+        stream.write( (U32)0 );
+        stream.write( (U32)1 );
+        writeStreamElement( stream, "SimObject", "", 0, 1 );
+        stream.write( (U32)0 );
+    }
+    stream.write( (U32)0 );
+    stream.close();
+
+    // Read the file, identifying the format from its content.
+    Taml taml;
+    SimSet* pReadRoot = dynamic_cast<SimSet*>( taml.read( filenameBuffer ) );
+    Platform::fileDelete( filenameBuffer );
+    ASSERT_TRUE( pReadRoot != NULL ) << "Failed to read the version 2 binary file.";
+    ASSERT_EQ( (U32)2, (U32)pReadRoot->size() ) << "The root set children were not read.";
+
+    SimObject* pReadShared = pReadRoot->at( 0 );
+    SimSet* pReadNamed = dynamic_cast<SimSet*>( pReadRoot->at( 1 ) );
+    ASSERT_TRUE( pReadNamed != NULL ) << "The named set was not read.";
+    ASSERT_STREQ( TAML_BINARY_UNITTEST_NAME, pReadNamed->getName() );
+    ASSERT_STREQ( "1 0.5 0.25 1", pReadShared->getDataField( StringTable->insert( "Colour" ), NULL ) );
+    ASSERT_STREQ( "Colour", pReadShared->getDataField( StringTable->insert( "Label" ), NULL ) );
+
+    // The reference should resolve to the same object.
+    ASSERT_EQ( (U32)1, (U32)pReadNamed->size() ) << "The named set children were not read.";
+    ASSERT_EQ( pReadShared, pReadNamed->at( 0 ) ) << "The shared object reference was not resolved.";
+
+    deleteTamlBinaryTestObjects( pReadRoot );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,223 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TAML_XML_PULL_PARSER_H_
+#include "persistence/taml/tamlXmlPullParser.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef TINYXML_INCLUDED
+#include "persistence/tinyXML/tinyxml.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TAML_XML_PULL_PARSER_UNITTEST_FILE  "_unitTestTamlXmlPullParser_RemoveMe.taml"
+
+//-----------------------------------------------------------------------------
+
+static void writeTestDocument( const char* pDocument, char* pFilenameBuffer, const U32 filenameBufferSize )
+{
+    Con::expandPath( pFilenameBuffer, filenameBufferSize, TAML_XML_PULL_PARSER_UNITTEST_FILE );
+
+    FileStream stream;
+    ASSERT_TRUE( stream.open( pFilenameBuffer, FileStream::Write ) ) << "Failed to open the document for write.";
+    stream.write( dStrlen( pDocument ), pDocument );
+    stream.close();
+}
+
+//-----------------------------------------------------------------------------
+
+static void compareWithDocument( TamlXmlPullParser& xmlParser, const TiXmlElement* pXmlElement )
+{
+    // Compare the element.
+    ASSERT_STREQ( pXmlElement->Value(), xmlParser.getName() );
+
+    U32 attributeIndex = 0;
+    for ( const TiXmlAttribute* pAttribute = pXmlElement->FirstAttribute(); pAttribute; pAttribute = pAttribute->Next(), ++attributeIndex )
+    {
+        ASSERT_LT( attributeIndex, xmlParser.getAttributeCount() ) << "Too few attributes were read.";
+        ASSERT_STREQ( pAttribute->Name(), xmlParser.getAttribute( attributeIndex ).mpName );
+        ASSERT_STREQ( pAttribute->Value(), xmlParser.getAttribute( attributeIndex ).mpValue );
+    }
+    ASSERT_EQ( attributeIndex, xmlParser.getAttributeCount() ) << "Too many attributes were read.";
+
+    // Compare the children, ignoring comments.
+    for ( const TiXmlNode* pChildNode = pXmlElement->FirstChild(); pChildNode; pChildNode = pChildNode->NextSibling() )
+    {
+        if ( pChildNode->Type() == TiXmlNode::TINYXML_COMMENT )
+            continue;
+
+        const TamlXmlPullParser::TokenType tokenType = xmlParser.next();
+
+        if ( pChildNode->Type() == TiXmlNode::TINYXML_TEXT )
+        {
+            ASSERT_EQ( TamlXmlPullParser::TextToken, tokenType ) << "Expected text.";
+            ASSERT_STREQ( pChildNode->Value(), xmlParser.getText() );
+            continue;
+        }
+
+        ASSERT_EQ( TamlXmlPullParser::StartElementToken, tokenType ) << "Expected a start element.";
+        compareWithDocument( xmlParser, pChildNode->ToElement() );
+    }
+
+    ASSERT_EQ( TamlXmlPullParser::EndElementToken, xmlParser.next() ) << "Expected an end element.";
+    ASSERT_STREQ( pXmlElement->Value(), xmlParser.getName() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlXmlPullParserTests, Tokens )
+{
+    char filenameBuffer[1024];
+    writeTestDocument( "<?xml version=\"1.0\"?>\r\n<Root a=\"1\" b='two'>\r\n  <Child/>\r\n  <!-- comment -->\r\n  <Other>  some \r\n text  </Other>\r\n</Root>\r\n", filenameBuffer, sizeof(filenameBuffer) );
+
+    FileStream stream;
+    ASSERT_TRUE( stream.open( filenameBuffer, FileStream::Read ) ) << "Failed to open the document for read.";
+
+    TamlXmlPullParser xmlParser;
+    ASSERT_TRUE( xmlParser.load( stream ) ) << "Failed to load the document.";
+    stream.close();
+
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Root", xmlParser.getName() );
+    ASSERT_EQ( (U32)2, xmlParser.getAttributeCount() );
+    ASSERT_STREQ( "1", xmlParser.findAttribute( "a" ) );
+    ASSERT_STREQ( "two", xmlParser.findAttribute( "b" ) );
+    ASSERT_TRUE( xmlParser.findAttribute( "c" ) == NULL );
+    ASSERT_EQ( (U32)1, xmlParser.getDepth() );
+
+    // An empty element is read as a start and an end.
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Child", xmlParser.getName() );
+    ASSERT_EQ( (U32)2, xmlParser.getDepth() );
+    ASSERT_EQ( TamlXmlPullParser::EndElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Child", xmlParser.getName() );
+    ASSERT_EQ( (U32)1, xmlParser.getDepth() );
+
+    // Text is condensed.
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Other", xmlParser.getName() );
+    ASSERT_EQ( TamlXmlPullParser::TextToken, xmlParser.next() );
+    ASSERT_STREQ( "some text", xmlParser.getText() );
+    ASSERT_EQ( TamlXmlPullParser::EndElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Other", xmlParser.getName() );
+
+    ASSERT_EQ( TamlXmlPullParser::EndElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Root", xmlParser.getName() );
+    ASSERT_EQ( TamlXmlPullParser::EndDocumentToken, xmlParser.next() );
+    ASSERT_EQ( TamlXmlPullParser::EndDocumentToken, xmlParser.next() );
+
+    Platform::fileDelete( filenameBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlXmlPullParserTests, SkipElementAndErrors )
+{
+    char filenameBuffer[1024];
+    writeTestDocument( "<Root><Skip><A><B/></A>text</Skip><Keep/><Bad></Wrong></Root>", filenameBuffer, sizeof(filenameBuffer) );
+
+    FileStream stream;
+    ASSERT_TRUE( stream.open( filenameBuffer, FileStream::Read ) ) << "Failed to open the document for read.";
+
+    TamlXmlPullParser xmlParser;
+    ASSERT_TRUE( xmlParser.load( stream ) ) << "Failed to load the document.";
+    stream.close();
+
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Skip", xmlParser.getName() );
+    ASSERT_TRUE( xmlParser.skipElement() );
+    ASSERT_STREQ( "Skip", xmlParser.getName() );
+
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_STREQ( "Keep", xmlParser.getName() );
+    ASSERT_EQ( TamlXmlPullParser::EndElementToken, xmlParser.next() );
+
+    // A mismatched end element is an error and errors are sticky.
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    ASSERT_EQ( TamlXmlPullParser::ErrorToken, xmlParser.next() );
+    ASSERT_TRUE( xmlParser.getError() != NULL );
+    ASSERT_EQ( TamlXmlPullParser::ErrorToken, xmlParser.next() );
+
+    Platform::fileDelete( filenameBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlXmlPullParserTests, MatchesDocument )
+{
+    const char* pDocument =
+        "\xEF\xBB\xBF<Scene Name=\"A &amp; B\" Quote='&quot;&apos;&lt;&gt;' Spaced=\"  x  y  \" Unknown=\"&bogus; &#65;&#x42;&#xe9;\">\r\n"
+        "    <Sprite Position=\"1 2\" Size=\"3\r\n4\"/>\r\n"
+        "    <Sprite.Custom>\r\n"
+        "        <Node Field=\"Value\">Node  &lt;text&gt;\r\n  here</Node>\r\n"
+        "        <![CDATA[ raw <text> ]]>\r\n"
+        "    </Sprite.Custom>\r\n"
+        "    <!-- A comment -->\r\n"
+        "    <Empty></Empty>\r\n"
+        "</Scene>\r\n";
+
+    char filenameBuffer[1024];
+    writeTestDocument( pDocument, filenameBuffer, sizeof(filenameBuffer) );
+
+    // Load the document object model.
+    TiXmlDocument xmlDocument;
+    FileStream documentStream;
+    ASSERT_TRUE( documentStream.open( filenameBuffer, FileStream::Read ) ) << "Failed to open the document for read.";
+    ASSERT_TRUE( xmlDocument.LoadFile( documentStream ) ) << "Failed to load the document object model.";
+    documentStream.close();
+
+    // Stream the document.
+    FileStream stream;
+    ASSERT_TRUE( stream.open( filenameBuffer, FileStream::Read ) ) << "Failed to open the document for read.";
+
+    TamlXmlPullParser xmlParser;
+    ASSERT_TRUE( xmlParser.load( stream ) ) << "Failed to load the document.";
+    stream.close();
+
+    // The streamed tokens should match the document object model.
+    ASSERT_EQ( TamlXmlPullParser::StartElementToken, xmlParser.next() );
+    compareWithDocument( xmlParser, xmlDocument.RootElement() );
+    ASSERT_EQ( TamlXmlPullParser::EndDocumentToken, xmlParser.next() );
+
+    Platform::fileDelete( filenameBuffer );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TAML_H_
+#include "persistence/taml/taml.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+#ifndef TINYXML_INCLUDED
+#include "persistence/tinyXML/tinyxml.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TAML_XML_WRITER_UNITTEST_FILE           "_unitTestTamlXmlWriter_RemoveMe.taml"
+#define TAML_XML_WRITER_UNITTEST_DOCUMENT_FILE  "_unitTestTamlXmlWriterDocument_RemoveMe.taml"
+
+//-----------------------------------------------------------------------------
+
+static SimSet* createTamlXmlWriterTestObjects( void )
+{
+    // Create a set holding a shared object twice so that references are written.
+    SimSet* pRoot = new SimSet();
+    pRoot->registerObject();
+    pRoot->setDataField( StringTable->insert( "Title" ), NULL, "A <quoted> \"title\" & more" );
+    pRoot->setDataField( StringTable->insert( "Apostrophe" ), NULL, "it's" );
+
+    SimObject* pShared = new SimObject();
+    pShared->registerObject();
+    pShared->setDataField( StringTable->insert( "Position" ), NULL, "1 2" );
+
+    SimSet* pInner = new SimSet();
+    pInner->registerObject();
+
+    SimSet* pEmpty = new SimSet();
+    pEmpty->registerObject();
+
+    pRoot->addObject( pShared );
+    pRoot->addObject( pInner );
+    pRoot->addObject( pEmpty );
+    pInner->addObject( pShared );
+
+    return pRoot;
+}
+
+//-----------------------------------------------------------------------------
+
+static void deleteTamlXmlWriterTestObjects( SimSet* pRoot )
+{
+    // Delete the children first as sets do not own them.
+    while( pRoot->size() > 0 )
+    {
+        SimObject* pChild = pRoot->last();
+        pRoot->removeObject( pChild );
+        pChild->deleteObject();
+    }
+    pRoot->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+static void readTestFile( const char* pFilename, Vector<char>& contents )
+{
+    FileStream stream;
+    ASSERT_TRUE( stream.open( pFilename, FileStream::Read ) ) << "Failed to open the file for read.";
+    contents.setSize( stream.getStreamSize() );
+    ASSERT_TRUE( stream.read( contents.size(), contents.address() ) ) << "Failed to read the file.";
+    stream.close();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlXmlWriterTests, MatchesDocumentOutput )
+{
+    char filenameBuffer[1024];
+    char documentFilenameBuffer[1024];
+    Con::expandPath( filenameBuffer, sizeof(filenameBuffer), TAML_XML_WRITER_UNITTEST_FILE );
+    Con::expandPath( documentFilenameBuffer, sizeof(documentFilenameBuffer), TAML_XML_WRITER_UNITTEST_DOCUMENT_FILE );
+
+    // Write the objects.
+    SimSet* pRoot = createTamlXmlWriterTestObjects();
+    Taml taml;
+    taml.setAutoFormat( false );
+    taml.setFormatMode( Taml::XmlFormat );
+    ASSERT_TRUE( taml.write( pRoot, filenameBuffer ) ) << "Failed to write the file.";
+    deleteTamlXmlWriterTestObjects( pRoot );
+
+    // Load and save the file using the document object model.
+    TiXmlDocument xmlDocument;
+    FileStream documentStream;
+    ASSERT_TRUE( documentStream.open( filenameBuffer, FileStream::Read ) ) << "Failed to open the file for read.";
+    ASSERT_TRUE( xmlDocument.LoadFile( documentStream ) ) << "Failed to load the document object model.";
+    documentStream.close();
+    ASSERT_TRUE( documentStream.open( documentFilenameBuffer, FileStream::Write ) ) << "Failed to open the document for write.";
+    ASSERT_TRUE( xmlDocument.SaveFile( documentStream ) ) << "Failed to save the document object model.";
+    documentStream.close();
+
+    // The streamed output should match the document output.
+    Vector<char> contents;
+    Vector<char> documentContents;
+    readTestFile( filenameBuffer, contents );
+    readTestFile( documentFilenameBuffer, documentContents );
+    Platform::fileDelete( filenameBuffer );
+    Platform::fileDelete( documentFilenameBuffer );
+
+    ASSERT_EQ( documentContents.size(), contents.size() ) << "The streamed output differs from the document output.";
+    ASSERT_EQ( 0, dMemcmp( documentContents.address(), contents.address(), contents.size() ) ) << "The streamed output differs from the document output.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlXmlWriterTests, WriteAsync )
+{
+    char filenameBuffer[1024];
+    Con::expandPath( filenameBuffer, sizeof(filenameBuffer), TAML_XML_WRITER_UNITTEST_FILE );
+
+    // Start writing the objects then delete them straight away.
+    SimSet* pRoot = createTamlXmlWriterTestObjects();
+    Taml taml;
+    ASSERT_TRUE( taml.writeAsync( pRoot, filenameBuffer ) ) << "Failed to start the write.";
+    deleteTamlXmlWriterTestObjects( pRoot );
+
+    // Wait for the write.
+    if ( ThreadPool::getGlobal() != NULL )
+        ThreadPool::getGlobal()->flush();
+
+    // Read the objects.
+    SimSet* pReadRoot = taml.read<SimSet>( filenameBuffer );
+    Platform::fileDelete( filenameBuffer );
+    ASSERT_TRUE( pReadRoot != NULL ) << "Failed to read the file.";
+    ASSERT_STREQ( "A <quoted> \"title\" & more", pReadRoot->getDataField( StringTable->insert( "Title" ), NULL ) );
+    ASSERT_EQ( (U32)3, (U32)pReadRoot->size() ) << "The children were not read.";
+
+    SimSet* pReadInner = dynamic_cast<SimSet*>( pReadRoot->at( 1 ) );
+    ASSERT_TRUE( pReadInner != NULL ) << "The inner set was not read.";
+    ASSERT_EQ( (U32)1, (U32)pReadInner->size() ) << "The inner set children were not read.";
+    ASSERT_EQ( pReadRoot->at( 0 ), pReadInner->at( 0 ) ) << "The shared object reference was not resolved.";
+    ASSERT_STREQ( "1 2", pReadRoot->at( 0 )->getDataField( StringTable->insert( "Position" ), NULL ) );
+
+    deleteTamlXmlWriterTestObjects( pReadRoot );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TEXTURE_CACHE_H_
+#include "graphics/TextureCache.h"
+#endif
+
+#ifndef _GBITMAP_H_
+#include "graphics/gBitmap.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TEXTURE_CACHE_UNITTEST_SOURCE_FILE  "_unitTestTextureCache_RemoveMe.png"
+#define TEXTURE_CACHE_UNITTEST_CACHE_PATH   "_unitTestTextureCache_RemoveMe"
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureCacheTests, StoreLoad )
+{
+    // Write a stand-in source file.  Only its size and modified time matter to the cache.
+    char sourceFileBuffer[1024];
+    char cachePathBuffer[1024];
+    char cacheFileBuffer[1024];
+    Con::expandPath( sourceFileBuffer, sizeof(sourceFileBuffer), TEXTURE_CACHE_UNITTEST_SOURCE_FILE );
+    Con::expandPath( cachePathBuffer, sizeof(cachePathBuffer), TEXTURE_CACHE_UNITTEST_CACHE_PATH );
+
+    FileStream sourceStream;
+    ASSERT_TRUE( sourceStream.open( sourceFileBuffer, FileStream::Write ) ) << "Failed to open the source file for write.";
+    sourceStream.writeStringBuffer( "source" );
+    sourceStream.close();
+
+    const bool cacheEnabled = TextureCache::smEnabled;
+    TextureCache::smEnabled = true;
+    TextureCache::setCachePath( cachePathBuffer );
+    TextureCache::getCacheFilePath( sourceFileBuffer, cacheFileBuffer, sizeof(cacheFileBuffer) );
+
+    // Create a bitmap with distinct texels.
+    GBitmap bitmap( 5, 3, false, GBitmap::RGBA );
+    for ( U32 index = 0; index < bitmap.byteSize; ++index )
+        bitmap.getWritableBits()[index] = (U8)index;
+
+    // Store and load the bitmap.
+    ASSERT_EQ( (GBitmap*)NULL, TextureCache::load( sourceFileBuffer, cacheFileBuffer ) ) << "Loaded a bitmap that was never stored.";
+    ASSERT_TRUE( TextureCache::store( sourceFileBuffer, cacheFileBuffer, &bitmap ) ) << "Failed to store the bitmap.";
+
+    GBitmap* pLoadedBitmap = TextureCache::load( sourceFileBuffer, cacheFileBuffer );
+    ASSERT_TRUE( pLoadedBitmap != NULL ) << "Failed to load the stored bitmap.";
+    ASSERT_EQ( bitmap.getFormat(), pLoadedBitmap->getFormat() ) << "Bitmap format was not restored.";
+    ASSERT_EQ( bitmap.getWidth(), pLoadedBitmap->getWidth() ) << "Bitmap width was not restored.";
+    ASSERT_EQ( bitmap.getHeight(), pLoadedBitmap->getHeight() ) << "Bitmap height was not restored.";
+    ASSERT_EQ( bitmap.bytesPerPixel, pLoadedBitmap->bytesPerPixel ) << "Bitmap pixel size was not restored.";
+    ASSERT_EQ( bitmap.byteSize, pLoadedBitmap->byteSize ) << "Bitmap size was not restored.";
+    ASSERT_EQ( 0, dMemcmp( bitmap.getBits(), pLoadedBitmap->getBits(), bitmap.byteSize ) ) << "Bitmap texels were not restored.";
+    delete pLoadedBitmap;
+
+    // A changed source file is not loaded from the cache.
+    ASSERT_TRUE( sourceStream.open( sourceFileBuffer, FileStream::Write ) ) << "Failed to open the source file for write.";
+    sourceStream.writeStringBuffer( "changed source" );
+    sourceStream.close();
+    ASSERT_EQ( (GBitmap*)NULL, TextureCache::load( sourceFileBuffer, cacheFileBuffer ) ) << "Loaded a bitmap whose source changed.";
+
+    TextureCache::setCachePath( NULL );
+    TextureCache::smEnabled = cacheEnabled;
+
+    Platform::fileDelete( sourceFileBuffer );
+    Platform::fileDelete( cacheFileBuffer );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TEXTURE_MANAGER_H_
+#include "graphics/TextureManager.h"
+#endif
+
+#ifndef _GBITMAP_H_
+#include "graphics/gBitmap.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TEXTURE_MANAGER_UNITTEST_BUDGET     "$pref::OpenGL::textureUploadBudget"
+#define TEXTURE_MANAGER_UNITTEST_SIZE       64
+
+//-----------------------------------------------------------------------------
+
+namespace TextureManagerTests
+{
+    static Vector<StringTableEntry> sgLoadedKeys;
+
+    static void onTextureLoaded( StringTableEntry textureKey, const bool loaded, void* userData )
+    {
+        if ( loaded )
+            sgLoadedKeys.push_back( textureKey );
+    }
+
+    static void queueUpload( StringTableEntry textureKey )
+    {
+        GBitmap* pBitmap = new GBitmap( TEXTURE_MANAGER_UNITTEST_SIZE, TEXTURE_MANAGER_UNITTEST_SIZE, false, GBitmap::RGBA );
+        TextureManager::queueUpload( textureKey, pBitmap, TEXTURE_MANAGER_UNITTEST_SIZE, TEXTURE_MANAGER_UNITTEST_SIZE, false, false, onTextureLoaded, NULL );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureManagerTests, UploadBudget )
+{
+    using namespace TextureManagerTests;
+
+    // Textures can only be uploaded with a live manager.
+    if ( TextureManager::getManagerState() != TextureManager::Alive )
+        return;
+
+    TextureManager::flushUploads();
+    sgLoadedKeys.clear();
+
+    const U32 uploadSize = TEXTURE_MANAGER_UNITTEST_SIZE * TEXTURE_MANAGER_UNITTEST_SIZE * 4;
+    const S32 uploadBudget = Con::getIntVariable( TEXTURE_MANAGER_UNITTEST_BUDGET );
+
+    // Queue uploads with unique keys so none of them is already loaded.
+    StringTableEntry textureKeys[4];
+    for ( U32 index = 0; index < 4; ++index )
+    {
+        textureKeys[index] = TextureManager::getUniqueTextureKey();
+        queueUpload( textureKeys[index] );
+    }
+    ASSERT_EQ( (U32)4, TextureManager::getPendingUploadCount() ) << "Unexpected pending upload count.";
+
+    // A budget with room for two uploads uploads two.
+    Con::setIntVariable( TEXTURE_MANAGER_UNITTEST_BUDGET, uploadSize * 2 + uploadSize / 2 );
+    TextureManager::processUploads();
+    ASSERT_EQ( (U32)2, TextureManager::getPendingUploadCount() ) << "The upload budget was not used.";
+    ASSERT_EQ( uploadSize * 2, TextureManager::getFrameUploadSize() ) << "Unexpected frame upload size.";
+
+    // A budget with no room still uploads one per frame.
+    Con::setIntVariable( TEXTURE_MANAGER_UNITTEST_BUDGET, 0 );
+    TextureManager::processUploads();
+    ASSERT_EQ( (U32)1, TextureManager::getPendingUploadCount() ) << "An upload was not made with no budget.";
+    ASSERT_EQ( uploadSize, TextureManager::getFrameUploadSize() ) << "Unexpected frame upload size.";
+    TextureManager::processUploads();
+    ASSERT_EQ( (U32)0, TextureManager::getPendingUploadCount() ) << "The uploads were not drained.";
+
+    // The callbacks are called in the order the uploads were queued.
+    ASSERT_EQ( 4, sgLoadedKeys.size() ) << "Unexpected loaded callback count.";
+    for ( U32 index = 0; index < 4; ++index )
+        ASSERT_EQ( textureKeys[index], sgLoadedKeys[index] ) << "The callbacks were called out of order.";
+
+    Con::setIntVariable( TEXTURE_MANAGER_UNITTEST_BUDGET, uploadBudget );
+    sgLoadedKeys.clear();
+}
+
+#endif // TORQUE_SHIPPING
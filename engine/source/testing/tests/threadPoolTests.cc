@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace ThreadPoolTests
+{
+    class SquareWorkItem : public ThreadPool::WorkItem
+    {
+    public:
+        SquareWorkItem( U32* pResults, const U32 index, U32* pCompletedCount, ThreadPool* pChainPool = NULL ) :
+            mpResults( pResults ),
+            mIndex( index ),
+            mpCompletedCount( pCompletedCount ),
+            mpChainPool( pChainPool )
+        {
+        }
+
+        virtual void execute( void )
+        {
+            mpResults[mIndex] = mIndex * mIndex;
+        }
+
+        virtual void onCompleted( void )
+        {
+            (*mpCompletedCount)++;
+
+            // Queue follow on work from the main thread.
+            if ( mpChainPool != NULL )
+                mpChainPool->queueWorkItem( new SquareWorkItem( mpResults, mIndex + 1, mpCompletedCount ) );
+        }
+
+    private:
+        U32*        mpResults;
+        U32         mIndex;
+        U32*        mpCompletedCount;
+        ThreadPool* mpChainPool;
+    };
+
+    class FlagWorkItem : public ThreadPool::WorkItem
+    {
+    public:
+        FlagWorkItem( bool* pFlag ) : mpFlag( pFlag ) {}
+
+        virtual void execute( void ) {}
+        virtual void onCompleted( void ) { *mpFlag = true; }
+
+    private:
+        bool*       mpFlag;
+    };
+
+    static void runPool( const U32 workerCount )
+    {
+        const U32 itemCount = 256;
+        U32 results[itemCount];
+        dMemset( results, 0, sizeof(results) );
+        U32 completedCount = 0;
+
+        ThreadPool pool( workerCount );
+        ASSERT_EQ( workerCount, pool.getWorkerCount() );
+
+        for ( U32 index = 0; index < itemCount; ++index )
+            pool.queueWorkItem( new SquareWorkItem( results, index, &completedCount ) );
+
+        pool.flush();
+
+        ASSERT_EQ( 0, pool.getPendingCount() ) << "Work is still pending after a flush.";
+        ASSERT_EQ( itemCount, completedCount ) << "Not every work item was completed.";
+
+        for ( U32 index = 0; index < itemCount; ++index )
+        {
+            ASSERT_EQ( index * index, results[index] ) << "A work item was not executed.";
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ThreadPoolTests, flushTest )
+{
+    ThreadPoolTests::runPool( 4 );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ThreadPoolTests, noWorkersTest )
+{
+    ThreadPoolTests::runPool( 0 );
+
+    // Without workers the items are executed when completions are processed.
+    U32 results[1] = { 0 };
+    U32 completedCount = 0;
+
+    ThreadPool pool( 0 );
+    pool.queueWorkItem( new ThreadPoolTests::SquareWorkItem( results, 0, &completedCount ) );
+    ASSERT_EQ( 1, pool.getPendingCount() );
+    ASSERT_EQ( 1, pool.processCompleted() );
+    ASSERT_EQ( 1, completedCount );
+    ASSERT_EQ( 0, pool.getPendingCount() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ThreadPoolTests, chainedWorkTest )
+{
+    U32 results[3] = { 0, 0, 0 };
+    U32 completedCount = 0;
+
+    ThreadPool pool( 2 );
+
+    // The flush must also finish the work queued by the first completion.
+    pool.queueWorkItem( new ThreadPoolTests::SquareWorkItem( results, 1, &completedCount, &pool ) );
+    pool.flush();
+
+    ASSERT_EQ( 2, completedCount ) << "The chained work item was not completed.";
+    ASSERT_EQ( 1, results[1] );
+    ASSERT_EQ( 4, results[2] );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ThreadPoolTests, waitUntilTest )
+{
+    const U32 itemCount = 64;
+    U32 results[itemCount];
+    dMemset( results, 0, sizeof(results) );
+    U32 completedCount = 0;
+    bool flag = false;
+
+    ThreadPool pool( 2 );
+
+    for ( U32 index = 0; index < itemCount; ++index )
+        pool.queueWorkItem( new ThreadPoolTests::SquareWorkItem( results, index, &completedCount ) );
+    pool.queueWorkItem( new ThreadPoolTests::FlagWorkItem( &flag ) );
+
+    pool.waitUntil( flag );
+    ASSERT_TRUE( flag ) << "The wait returned before the flag was set.";
+
+    // A flag that is never set must not wait forever once the work runs out.
+    bool unsetFlag = false;
+    pool.waitUntil( unsetFlag );
+    ASSERT_FALSE( unsetFlag );
+    ASSERT_EQ( 0, pool.getPendingCount() ) << "Work is still pending after the wait ran out of work.";
+    ASSERT_EQ( itemCount, completedCount ) << "Not every work item was completed.";
+}
+
+#endif // TORQUE_SHIPPING
@@ -81,12 +81,17 @@
 /// its networking sub-system.
 ///
 /// 'TORQUE_GATHER_METRICS'
-/// When defined, Torque will gather additional performance metrics.
+/// When defined, Torque will gather additional performance metrics, such as the count of
+/// script instructions executed.
 ///
 /// 'TORQUE_MULTITHREAD'
 /// When defined, Torque will attempt to make select systems thread-safe.  This does not
 /// make the entire engine thread-safe nor is it a magic bullet that will make the engine
 /// perform operations in parallel and speed-up the engine.
+///
+/// 'TORQUE_SYSTEM_ALLOCATOR'
+/// When defined, the engine allocator passes every block to the C runtime heap instead of
+/// its small block allocator.  Statistics for each subsystem are still gathered.
 
 #endif
 
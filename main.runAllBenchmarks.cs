@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// Set log mode.
+setLogMode(2);
+
+// Controls whether the execution or script files or compiled DSOs are echoed to the console or not.
+// Being able to turn this off means far less spam in the console during typical development.
+setScriptExecEcho( false );
+
+// Controls whether all script execution is traced (echoed) to the console or not.
+trace( false );
+
+//-----------------------------------------------------------------------------
+
+// Always compile the benchmark scripts so that the optimizer setting takes effect.
+$Scripts::ignoreDSOs = true;
+
+$ScriptBenchmarks[0] = "scriptBenchmarkArithmetic";
+$ScriptBenchmarks[1] = "scriptBenchmarkLocalVariables";
+$ScriptBenchmarks[2] = "scriptBenchmarkBranches";
+$ScriptBenchmarks[3] = "scriptBenchmarkStrings";
+$ScriptBenchmarks[4] = "scriptBenchmarkCalls";
+$ScriptBenchmarkCount = 5;
+$ScriptBenchmarkIterations = 100000;
+
+// Engine benchmarks are console functions that only exist in non-shipping builds.
+$EngineBenchmarks[0] = "runStringTableBenchmarks";
+$EngineBenchmarks[1] = "runDictionaryBenchmarks";
+$EngineBenchmarks[2] = "runSimEventBenchmarks";
+$EngineBenchmarks[3] = "runSimSetBenchmarks";
+$EngineBenchmarks[4] = "runSimLookupBenchmarks";
+$EngineBenchmarks[5] = "runMemoryBenchmarks";
+$EngineBenchmarks[6] = "runObjectPoolBenchmarks";
+$EngineBenchmarks[7] = "runVectorBenchmarks";
+$EngineBenchmarks[8] = "runTamlXmlBenchmarks";
+$EngineBenchmarks[9] = "runTamlLoadBenchmarks";
+$EngineBenchmarkCount = 10;
+
+//-----------------------------------------------------------------------------
+
+function runScriptBenchmarkPass( %optimize )
+{
+    // Recompile the benchmarks with the requested optimizer setting.
+    $Con::optimizeBytecode = %optimize;
+    exec( "./benchmarks/scriptBenchmarks.cs" );
+
+    echo( "Bytecode optimization" SPC ( %optimize ? "enabled:" : "disabled:" ) );
+
+    for ( %index = 0; %index < $ScriptBenchmarkCount; %index++ )
+    {
+        %benchmark = $ScriptBenchmarks[%index];
+
+        %startInstructions = getScriptInstructionCount();
+        %startTime = getRealTime();
+
+        %result = call( %benchmark, $ScriptBenchmarkIterations );
+
+        %elapsedTime = getRealTime() - %startTime;
+        %instructions = getScriptInstructionCount() - %startInstructions;
+
+        echo( "   " @ %benchmark @ ": " @ %instructions SPC "instructions," SPC %elapsedTime @ "ms (result" SPC %result @ ")" );
+
+        $ScriptBenchmarkInstructions[%optimize, %index] = %instructions;
+    }
+}
+
+function runScriptBenchmarks()
+{
+    echoSeparator();
+    echo( "Script Benchmarks Starting..." );
+
+    runScriptBenchmarkPass( 0 );
+    runScriptBenchmarkPass( 1 );
+
+    echo( "Instructions executed (optimized / unoptimized):" );
+    for ( %index = 0; %index < $ScriptBenchmarkCount; %index++ )
+    {
+        %before = $ScriptBenchmarkInstructions[0, %index];
+        %after = $ScriptBenchmarkInstructions[1, %index];
+
+        // Guard against builds or benchmarks that report no instructions.
+        if ( %before == 0 )
+        {
+            echo( "   " @ $ScriptBenchmarks[%index] @ ": no instructions counted" );
+            continue;
+        }
+
+        echo( "   " @ $ScriptBenchmarks[%index] @ ": " @ mFloatLength( ( %after / %before ) * 100, 1 ) @ "%" );
+    }
+
+    // Restore the default.
+    $Con::optimizeBytecode = true;
+
+    echo( "... Script Benchmarks Ended." );
+    echoSeparator();
+}
+
+function runEngineBenchmarks()
+{
+    for ( %index = 0; %index < $EngineBenchmarkCount; %index++ )
+    {
+        %benchmark = $EngineBenchmarks[%index];
+
+        if ( isFunction( %benchmark ) )
+            call( %benchmark );
+        else
+            echo( "Skipping" SPC %benchmark @ ", it is not available in this build." );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+// Run all benchmarks.
+runScriptBenchmarks();
+runEngineBenchmarks();
+
+// Finish!
+quit();